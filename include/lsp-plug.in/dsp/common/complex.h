@@ -153,6 +153,36 @@ LSP_DSP_LIB_SYMBOL(void, complex_mod,
  */
 LSP_DSP_LIB_SYMBOL(void, complex_arg, float *dst, const float *re, const float *im, size_t count);
 
+/** Convert real+imaginary complex number to polar form with reduced precision:
+ * the module is computed with the approximate reciprocal square root and has the
+ * relative error up to 4e-4 if the squared module is not less than FLT_MIN, the module
+ * of smaller values is underestimated and flushed towards zero. The argument is computed
+ * with the polynomial approximation and has the absolute error up to 2e-5 radians.
+ * The argument of zero is 0.
+ *
+ * @param dst_mod module of the complex number
+ * @param dst_arg argument of the complex number in range of [-PI, +PI]
+ * @param src_re real part of complex number
+ * @param src_im imaginary part of complex number
+ * @param count number of elements to process
+ */
+LSP_DSP_LIB_SYMBOL(void, complex_cvt2modarg_fast,
+        float *dst_mod, float *dst_arg,
+        const float *src_re, const float *src_im,
+        size_t count
+    );
+
+/** Get argument for complex numbers in range of [-PI; +PI] with reduced precision:
+ * the argument is computed with the polynomial approximation and has the absolute
+ * error up to 2e-5 radians. The argument of zero is 0.
+ *
+ * @param dst array to store argument
+ * @param re real part of complex number
+ * @param im imaginary part of complex number
+ * @param count count number of elements to process
+ */
+LSP_DSP_LIB_SYMBOL(void, complex_arg_fast, float *dst, const float *re, const float *im, size_t count);
+
 /** Convert polar-form of complex number to real+imaginary
  *
  * @param dst_re real part of complex number
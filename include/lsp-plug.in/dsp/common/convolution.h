@@ -34,4 +34,19 @@
  */
 LSP_DSP_LIB_SYMBOL(void, convolve, float *dst, const float *src, const float *conv, size_t length, size_t count);
 
+/**
+ * Calculate convolutions of source signal with multiple convolutions of the same length
+ * and add each result to the corresponding destination buffer. The source signal is
+ * read once for all convolutions.
+ *
+ * @param dst array of n destination buffers to add results of convolution
+ * @param src source signal
+ * @param conv array of n convolutions
+ * @param length length of each convolution
+ * @param count the number of samples in source signal to process
+ * @param n number of convolutions
+ */
+LSP_DSP_LIB_SYMBOL(void, convolve_multi, float * const *dst, const float *src, const float * const *conv,
+        size_t length, size_t count, size_t n);
+
 #endif /* LSP_PLUG_IN_DSP_COMMON_CONVOLUTION_H_ */
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 1 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LSP_PLUG_IN_DSP_COMMON_CQT_H_
+#define LSP_PLUG_IN_DSP_COMMON_CQT_H_
+
+#include <lsp-plug.in/dsp/common/types.h>
+
+LSP_DSP_LIB_BEGIN_NAMESPACE
+
+#pragma pack(push, 1)
+
+/**
+ * Precomputed sparse spectral kernel of the constant-Q transform. The kernel depends
+ * only on the rank of the FFT, the number of bins per octave, the sample rate and the
+ * lowest frequency, so it can be computed once and shared between any number of
+ * channels. The kernel does not allocate memory and operates on the buffer provided
+ * to the cqt_kernel_init() function.
+ */
+typedef struct LSP_DSP_LIB_TYPE(cqt_kernel_t)
+{
+    float      *kernel;         // Packed complex non-zero elements of the kernel, stored bin by bin
+    uint32_t   *band;           // Pairs of the first FFT bin and the number of FFT bins for each bin
+    float      *freqs;          // Center frequencies of bins, in Hz
+    size_t      bins;           // Number of bins
+    size_t      nonzero;        // Total number of non-zero elements of the kernel
+    size_t      rank;           // Rank of the FFT
+    size_t      bins_per_octave;// Number of bins per octave
+    size_t      sample_rate;    // Sample rate
+    float       fmin;           // Frequency of the first bin
+} LSP_DSP_LIB_TYPE(cqt_kernel_t);
+
+#pragma pack(pop)
+
+LSP_DSP_LIB_END_NAMESPACE
+
+/**
+ * Multiply the sparse matrix with the packed complex spectrum. Each row of the matrix
+ * contains the single band of non-zero elements, elements of all rows are stored
+ * one after another:
+ *   dst[i] = sum { kernel[off[i] + j] * src[band[2*i] + j] }, j = 0 .. band[2*i+1]-1
+ *   off[i] = band[1] + band[3] + ... + band[2*i-1]
+ *
+ * @param dst destination packed complex vector, bins elements
+ * @param src source packed complex spectrum
+ * @param kernel packed complex non-zero elements of all rows stored row by row
+ * @param band array of pairs for each row: index of the first element of spectrum, number of elements
+ * @param bins number of rows
+ */
+LSP_DSP_LIB_SYMBOL(void, cqt_kernel_apply, float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins);
+
+/**
+ * Get the size of the buffer required by the constant-Q transform kernel
+ *
+ * @param rank the rank of the FFT, the length of the analyzed frame is (1 << rank)
+ * @param bins_per_octave number of bins per octave
+ * @param sample_rate sample rate
+ * @param fmin the frequency of the first bin, 0 for the lowest frequency supported by the rank
+ * @return number of floats to allocate for the buffer, 0 on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(size_t, cqt_kernel_buffer_size, size_t rank, size_t bins_per_octave, size_t sample_rate, float fmin);
+
+/**
+ * Compute the sparse spectral kernel of the constant-Q transform. Bins are placed from
+ * the lowest frequency up to the Nyquist frequency. Each bin is computed with the Hann
+ * window of Q periods of the bin frequency, windows of all bins end at the last sample
+ * of the frame, and the phase of bins is referenced to the last sample of the frame.
+ *
+ * @param k the kernel to initialize
+ * @param buf the buffer of cqt_kernel_buffer_size() floats, should be aligned to 64 bytes
+ * @param rank the rank of the FFT, the length of the analyzed frame is (1 << rank)
+ * @param bins_per_octave number of bins per octave
+ * @param sample_rate sample rate
+ * @param fmin the frequency of the first bin, 0 for the lowest frequency supported by the rank
+ * @return true on success, false on invalid parameters or if fmin is too low for the rank
+ */
+LSP_DSP_LIB_SYMBOL(bool, cqt_kernel_init, LSP_DSP_LIB_TYPE(cqt_kernel_t) *k, float *buf,
+    size_t rank, size_t bins_per_octave, size_t sample_rate, float fmin);
+
+/**
+ * Check that the precomputed kernel matches the parameters and can be used
+ * instead of computing the new one
+ *
+ * @param k the kernel
+ * @param rank the rank of the FFT
+ * @param bins_per_octave number of bins per octave
+ * @param sample_rate sample rate
+ * @param fmin the frequency of the first bin, 0 for the lowest frequency supported by the rank
+ * @return true if the kernel matches the parameters
+ */
+LSP_DSP_LIB_SYMBOL(bool, cqt_kernel_match, const LSP_DSP_LIB_TYPE(cqt_kernel_t) *k,
+    size_t rank, size_t bins_per_octave, size_t sample_rate, float fmin);
+
+/**
+ * Compute the constant-Q transform of the frame
+ *
+ * @param k the kernel
+ * @param dst packed complex spectrum, k->bins elements
+ * @param src the frame of (1 << k->rank) samples
+ * @param tmp temporary buffer of (1 << k->rank) + 2 floats, may be the same as src
+ */
+LSP_DSP_LIB_SYMBOL(void, cqt_process, const LSP_DSP_LIB_TYPE(cqt_kernel_t) *k, float *dst, const float *src, float *tmp);
+
+#endif /* LSP_PLUG_IN_DSP_COMMON_CQT_H_ */
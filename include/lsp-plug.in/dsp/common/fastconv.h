@@ -64,4 +64,18 @@ LSP_DSP_LIB_SYMBOL(void, fastconv_restore, float *dst, float *src, size_t rank);
  */
 LSP_DSP_LIB_SYMBOL(void, fastconv_apply, float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
 
+/** Multiply each fast convolution data by the corresponding kernel and
+ * store the sum of products to the destination buffer. The result can be
+ * converted to real data with the fastconv_restore() function. This is the
+ * core of the frequency-domain delay line of the partitioned convolution.
+ *
+ * @param dst destination fast convolution data of 2^(rank+1) floats
+ * @param spectra array of n pointers to fast convolution data of 2^(rank+1) floats
+ * @param kernels array of n pointers to fast convolution data of 2^(rank+1) floats
+ * @param n number of products to sum, the destination is cleared if zero
+ * @param rank the convolution rank
+ */
+LSP_DSP_LIB_SYMBOL(void, fastconv_mac_n, float *dst, const float * const *spectra, const float * const *kernels,
+        size_t n, size_t rank);
+
 #endif /* LSP_PLUG_IN_DSP_COMMON_FASTCONV_H_ */
@@ -56,6 +56,114 @@ LSP_DSP_LIB_SYMBOL(void, reverse_fft, float *dst_re, float *dst_im, const float
  */
 LSP_DSP_LIB_SYMBOL(void, packed_reverse_fft, float *dst, const float *src, size_t rank);
 
+/** Direct Fast Fourier Transform with packed complex data of the signal multiplied
+ * by the real window function. The window is applied while the first stage of the
+ * transform loads the signal, without extra pass over the memory.
+ *
+ * @param dst complex spectrum [re, im, re, im ...]
+ * @param src complex signal [re, im, re, im ...]
+ * @param window real window function, (1 << rank) elements
+ * @param rank the rank of FFT
+ */
+LSP_DSP_LIB_SYMBOL(void, packed_direct_fft_windowed, float *dst, const float *src, const float *window, size_t rank);
+
+/** Reverse Fast Fourier transform with packed complex data. The signal is multiplied
+ * by the real window function and added to the destination buffer by the last stage
+ * of the transform, which is useful for the overlap-add synthesis.
+ *
+ * @param dst complex signal to add the result [re, im, re, im ...]
+ * @param src complex spectrum [re, im, re, im ...], is used as a temporary buffer
+ *   and gets destroyed after the call
+ * @param window real window function, (1 << rank) elements
+ * @param rank the rank of FFT
+ */
+LSP_DSP_LIB_SYMBOL(void, packed_reverse_fft_add, float *dst, float *src, const float *window, size_t rank);
+
+/** Direct Fast Fourier Transform of the real signal. Only the non-negative
+ * frequencies are computed since the spectrum of the real signal is symmetric.
+ * The transform is performed by the complex FFT of the half rank and costs about
+ * half of the complex transform.
+ *
+ * @param dst_re real part of spectrum, (1 << (rank-1)) + 1 elements
+ * @param dst_im imaginary part of spectrum, (1 << (rank-1)) + 1 elements
+ * @param src real signal, (1 << rank) elements
+ * @param rank the rank of FFT
+ */
+LSP_DSP_LIB_SYMBOL(void, real_direct_fft, float *dst_re, float *dst_im, const float *src, size_t rank);
+
+/** Direct Fast Fourier Transform of the real signal with packed complex output
+ *
+ * @param dst complex spectrum [re, im, re, im ...], (1 << (rank-1)) + 1 complex elements
+ * @param src real signal, (1 << rank) elements
+ * @param rank the rank of FFT
+ */
+LSP_DSP_LIB_SYMBOL(void, packed_real_direct_fft, float *dst, const float *src, size_t rank);
+
+/** Reverse Fast Fourier Transform which produces the real signal from
+ * the non-negative part of the spectrum. Imaginary parts of the first and
+ * the last harmonics are ignored.
+ *
+ * @param dst real signal, (1 << rank) elements
+ * @param src_re real part of spectrum, (1 << (rank-1)) + 1 elements
+ * @param src_im imaginary part of spectrum, (1 << (rank-1)) + 1 elements
+ * @param rank the rank of FFT
+ */
+LSP_DSP_LIB_SYMBOL(void, real_reverse_fft, float *dst, const float *src_re, const float *src_im, size_t rank);
+
+/** Reverse Fast Fourier Transform which produces the real signal from
+ * the non-negative part of the packed complex spectrum
+ *
+ * @param dst real signal, (1 << rank) elements
+ * @param src complex spectrum [re, im, re, im ...], (1 << (rank-1)) + 1 complex elements
+ * @param rank the rank of FFT
+ */
+LSP_DSP_LIB_SYMBOL(void, packed_real_reverse_fft, float *dst, const float *src, size_t rank);
+
+/** Direct Fast Fourier Transform in double precision, the precision of the whole
+ * computation including the twiddle factors is double
+ *
+ * @param dst_re real part of spectrum
+ * @param dst_im imaginary part of spectrum
+ * @param src_re real part of signal
+ * @param src_im imaginary part of signal
+ * @param rank the rank of FFT
+ */
+LSP_DSP_LIB_SYMBOL(void, direct_fft_f64, double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+
+/** Reverse Fast Fourier Transform in double precision
+ *
+ * @param dst_re real part of signal
+ * @param dst_im imaginary part of signal
+ * @param src_re real part of spectrum
+ * @param src_im imaginary part of spectrum
+ * @param rank the rank of FFT
+ */
+LSP_DSP_LIB_SYMBOL(void, reverse_fft_f64, double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+
+/** Direct Fast Fourier Transform in mixed precision: the data is processed in float
+ * but the rotation of twiddle factors is accumulated in double. The result does not
+ * lose the precision at large ranks like direct_fft() does, while it costs more than
+ * direct_fft() but less than direct_fft_f64().
+ *
+ * @param dst_re real part of spectrum
+ * @param dst_im imaginary part of spectrum
+ * @param src_re real part of signal
+ * @param src_im imaginary part of signal
+ * @param rank the rank of FFT
+ */
+LSP_DSP_LIB_SYMBOL(void, direct_fft_mp, float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+
+/** Reverse Fast Fourier Transform in mixed precision: the data is processed in float
+ * but the rotation of twiddle factors is accumulated in double
+ *
+ * @param dst_re real part of signal
+ * @param dst_im imaginary part of signal
+ * @param src_re real part of spectrum
+ * @param src_im imaginary part of spectrum
+ * @param rank the rank of FFT
+ */
+LSP_DSP_LIB_SYMBOL(void, reverse_fft_mp, float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+
 /** Normalize FFT coefficients
  *
  * @param dst_re target array for real part of signal
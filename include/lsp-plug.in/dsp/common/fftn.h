@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 7 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_DSP_COMMON_FFTN_H_
+#define LSP_PLUG_IN_DSP_COMMON_FFTN_H_
+
+#include <lsp-plug.in/dsp/common/types.h>
+
+LSP_DSP_LIB_BEGIN_NAMESPACE
+
+#pragma pack(push, 1)
+
+/**
+ * Plan of the FFT of arbitrary size. Sizes that are products of 2, 3, 5 and 7
+ * are computed by the mixed-radix algorithm, other sizes are computed with the
+ * Bluestein algorithm on top of the power-of-two FFT. The plan does not allocate
+ * memory and operates on the buffer provided to the fftn_init() function.
+ */
+typedef struct LSP_DSP_LIB_TYPE(fftn_t)
+{
+    float      *tw;             // Twiddle factors (mixed radix) or chirp factors (Bluestein), count complex elements
+    float      *chirp;          // Spectrum of the Bluestein chirp filter, (1 << rank) complex elements, NULL for mixed radix
+    float      *tmp;            // Work buffer, max(count, 1 << rank) complex elements
+    size_t      count;          // Size of the transform
+    size_t      rank;           // Rank of the Bluestein convolution, 0 for mixed radix
+} LSP_DSP_LIB_TYPE(fftn_t);
+
+#pragma pack(pop)
+
+LSP_DSP_LIB_END_NAMESPACE
+
+/**
+ * Get the size of the buffer required by the FFT plan of specified size
+ *
+ * @param count the size of the transform
+ * @return number of floats to allocate for the buffer
+ */
+LSP_DSP_LIB_SYMBOL(size_t, fftn_buffer_size, size_t count);
+
+/**
+ * Initialize the FFT plan of arbitrary size
+ *
+ * @param plan the plan to initialize
+ * @param buf the buffer of fftn_buffer_size() floats, should be aligned to 64 bytes
+ * @param count the size of the transform, positive
+ * @return true on success, false on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(bool, fftn_init, LSP_DSP_LIB_TYPE(fftn_t) *plan, float *buf, size_t count);
+
+/**
+ * Perform direct FFT of arbitrary size on packed complex data
+ *
+ * @param plan the initialized plan, the work buffer of the plan is modified
+ * @param dst target spectrum [re, im, re, im ...], count complex elements
+ * @param src source signal [re, im, re, im ...], count complex elements, may be the same as destination
+ */
+LSP_DSP_LIB_SYMBOL(void, fftn_direct, const LSP_DSP_LIB_TYPE(fftn_t) *plan, float *dst, const float *src);
+
+/**
+ * Perform reverse FFT of arbitrary size on packed complex data, the result
+ * is normalized by the size of the transform
+ *
+ * @param plan the initialized plan, the work buffer of the plan is modified
+ * @param dst target signal [re, im, re, im ...], count complex elements
+ * @param src source spectrum [re, im, re, im ...], count complex elements, may be the same as destination
+ */
+LSP_DSP_LIB_SYMBOL(void, fftn_reverse, const LSP_DSP_LIB_TYPE(fftn_t) *plan, float *dst, const float *src);
+
+#endif /* LSP_PLUG_IN_DSP_COMMON_FFTN_H_ */
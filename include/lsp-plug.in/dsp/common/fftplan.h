@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LSP_PLUG_IN_DSP_COMMON_FFTPLAN_H_
+#define LSP_PLUG_IN_DSP_COMMON_FFTPLAN_H_
+
+#include <lsp-plug.in/dsp/common/types.h>
+
+LSP_DSP_LIB_BEGIN_NAMESPACE
+
+#pragma pack(push, 1)
+
+/**
+ * Plan of the in-place power-of-two FFT. The plan keeps the list of index pairs
+ * swapped by the bit-reversal permutation and the twiddle factors of all butterfly
+ * stages, so the transform neither computes the permutation nor rotates the twiddle
+ * factors on each call and does not require any scratch memory. The plan does not
+ * allocate memory and operates on the buffer provided to the fft_plan_init() function.
+ * The pairs are ordered by tiles so that the pairs swapped one after another touch
+ * a small set of cache lines. The twiddle factors are stored in the layout of the data
+ * the plan is initialized for, so the plan initialized for split complex data can not
+ * be used for packed complex data and vice versa. The SIMD implementations apply the
+ * permutation of the plan and compute butterflies with their own twiddle factor tables.
+ */
+typedef struct LSP_DSP_LIB_TYPE(fft_plan_t)
+{
+    float      *tw;             // Twiddle factors of stages with 4 and more butterflies, (2 << rank) - 8 floats
+    uint32_t   *swap;           // Pairs of indices swapped by the bit-reversal permutation
+    size_t      nswap;          // Number of swapped pairs
+    size_t      rank;           // Rank of the transform
+    bool        packed;         // The plan is initialized for packed complex data
+} LSP_DSP_LIB_TYPE(fft_plan_t);
+
+#pragma pack(pop)
+
+LSP_DSP_LIB_END_NAMESPACE
+
+/**
+ * Get the size of the buffer required by the in-place FFT plan of specified rank
+ *
+ * @param rank the rank of the transform
+ * @return number of floats to allocate for the buffer
+ */
+LSP_DSP_LIB_SYMBOL(size_t, fft_plan_buffer_size, size_t rank);
+
+/**
+ * Initialize the in-place FFT plan
+ *
+ * @param plan the plan to initialize
+ * @param buf the buffer of fft_plan_buffer_size() floats, should be aligned to 64 bytes
+ * @param rank the rank of the transform, not greater than 31
+ * @param packed initialize the plan for packed complex data instead of split complex data
+ * @return true on success, false on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(bool, fft_plan_init, LSP_DSP_LIB_TYPE(fft_plan_t) *plan, float *buf, size_t rank, bool packed);
+
+/**
+ * Get the memory footprint of the in-place FFT plan
+ *
+ * @param plan the initialized plan
+ * @return number of bytes occupied by the plan structure and the used part of the plan buffer
+ */
+LSP_DSP_LIB_SYMBOL(size_t, fft_plan_footprint, const LSP_DSP_LIB_TYPE(fft_plan_t) *plan);
+
+/**
+ * Perform in-place direct FFT on split complex data
+ *
+ * @param plan the plan initialized for split complex data
+ * @param re real part of the signal replaced by the real part of the spectrum, (1 << rank) elements
+ * @param im imaginary part of the signal replaced by the imaginary part of the spectrum, (1 << rank) elements
+ */
+LSP_DSP_LIB_SYMBOL(void, fft_plan_direct, const LSP_DSP_LIB_TYPE(fft_plan_t) *plan, float *re, float *im);
+
+/**
+ * Perform in-place reverse FFT on split complex data, the result is normalized
+ * by the size of the transform
+ *
+ * @param plan the plan initialized for split complex data
+ * @param re real part of the spectrum replaced by the real part of the signal, (1 << rank) elements
+ * @param im imaginary part of the spectrum replaced by the imaginary part of the signal, (1 << rank) elements
+ */
+LSP_DSP_LIB_SYMBOL(void, fft_plan_reverse, const LSP_DSP_LIB_TYPE(fft_plan_t) *plan, float *re, float *im);
+
+/**
+ * Perform in-place direct FFT on packed complex data
+ *
+ * @param plan the plan initialized for packed complex data
+ * @param data signal [re, im, re, im ...] replaced by the spectrum, (1 << rank) complex elements
+ */
+LSP_DSP_LIB_SYMBOL(void, fft_plan_packed_direct, const LSP_DSP_LIB_TYPE(fft_plan_t) *plan, float *data);
+
+/**
+ * Perform in-place reverse FFT on packed complex data, the result is normalized
+ * by the size of the transform
+ *
+ * @param plan the plan initialized for packed complex data
+ * @param data spectrum [re, im, re, im ...] replaced by the signal, (1 << rank) complex elements
+ */
+LSP_DSP_LIB_SYMBOL(void, fft_plan_packed_reverse, const LSP_DSP_LIB_TYPE(fft_plan_t) *plan, float *data);
+
+#endif /* LSP_PLUG_IN_DSP_COMMON_FFTPLAN_H_ */
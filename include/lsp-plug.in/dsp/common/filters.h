@@ -25,7 +25,9 @@
 #include <lsp-plug.in/dsp/common/types.h>
 
 #include <lsp-plug.in/dsp/common/filters/types.h>
+#include <lsp-plug.in/dsp/common/filters/block.h>
 #include <lsp-plug.in/dsp/common/filters/dynamic.h>
+#include <lsp-plug.in/dsp/common/filters/multichannel.h>
 #include <lsp-plug.in/dsp/common/filters/static.h>
 #include <lsp-plug.in/dsp/common/filters/transfer.h>
 #include <lsp-plug.in/dsp/common/filters/transform.h>
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 10 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LSP_PLUG_IN_DSP_COMMON_FILTERS_BLOCK_H_
+#define LSP_PLUG_IN_DSP_COMMON_FILTERS_BLOCK_H_
+
+#include <lsp-plug.in/dsp/common/types.h>
+#include <lsp-plug.in/dsp/common/filters/types.h>
+
+/** Convert the chain of bi-quadratic filters to the block state-space form,
+ * the memory of each converted filter is reset to zero
+ *
+ * @param dst array of n block filters to initialize
+ * @param src array of n bi-quadratic filters
+ * @param n number of filters in the chain
+ */
+LSP_DSP_LIB_SYMBOL(void, biquad_block_init, LSP_DSP_LIB_TYPE(biquad_block_t) *dst, const LSP_DSP_LIB_TYPE(biquad_x1_t) *src, size_t n);
+
+/** Process the chain of bi-quadratic filters converted to the block state-space form.
+ * The samples are processed by blocks of LSP_DSP_BIQUAD_BLOCK_SIZE samples without
+ * the serial dependency between the samples of the block, the output is the same
+ * as for the series of biquad_process_x1 calls for each filter of the chain
+ *
+ * @param dst destination samples
+ * @param src source samples, may be the same as destination
+ * @param count number of samples to process
+ * @param f array of n block filters applied in series
+ * @param n number of filters in the chain
+ */
+LSP_DSP_LIB_SYMBOL(void, biquad_block_process, float *dst, const float *src, size_t count, LSP_DSP_LIB_TYPE(biquad_block_t) *f, size_t n);
+
+#endif /* LSP_PLUG_IN_DSP_COMMON_FILTERS_BLOCK_H_ */
@@ -65,4 +65,99 @@ LSP_DSP_LIB_SYMBOL(void, dyn_biquad_process_x4, float *dst, const float *src, fl
  */
 LSP_DSP_LIB_SYMBOL(void, dyn_biquad_process_x8, float *dst, const float *src, float *d, size_t count, const LSP_DSP_LIB_TYPE(biquad_x8_t) *f);
 
+/** Process sixteen dynamic bi-quadratic filters for multiple samples
+ *
+ * @param dst array of count destination samples to emit
+ * @param src array of count source samples to process
+ * @param d pointer to filter memory (32 floats)
+ * @param count number of samples to process
+ * @param f array matrix of (count+15)*16 memory-aligned bi-quadratic filters
+ */
+LSP_DSP_LIB_SYMBOL(void, dyn_biquad_process_x16, float *dst, const float *src, float *d, size_t count, const LSP_DSP_LIB_TYPE(biquad_x16_t) *f);
+
+/** Process single bi-quadratic filter with coefficients linearly interpolated between two
+ * filters for each sample. The i'th sample is processed with the filter
+ * start + (end - start) * i / count, same to lramp functions, so the next call
+ * may continue the ramp from the end filter. The interpolated filter remains
+ * stable if both start and end filters are stable. The interpolated filters are
+ * stored in the caller-provided buffer and processed by chunks of at most
+ * LSP_DSP_RAMP_BIQUAD_CHUNK samples.
+ *
+ * @param dst array of count destination samples to emit
+ * @param src array of count source samples to process
+ * @param d pointer to filter memory (2 floats)
+ * @param count number of samples to process
+ * @param start filter at the beginning of the ramp
+ * @param end filter at the end of the ramp
+ * @param buf memory-aligned buffer of LSP_DSP_RAMP_BIQUAD_CHUNK filters
+ */
+LSP_DSP_LIB_SYMBOL(void, ramp_biquad_process_x1, float *dst, const float *src, float *d, size_t count, const LSP_DSP_LIB_TYPE(biquad_x1_t) *start, const LSP_DSP_LIB_TYPE(biquad_x1_t) *end, LSP_DSP_LIB_TYPE(biquad_x1_t) *buf);
+
+/** Process two bi-quadratic filters with coefficients linearly interpolated between two
+ * filter banks for each sample, the same way as ramp_biquad_process_x1 does
+ *
+ * @param dst array of count destination samples to emit
+ * @param src array of count source samples to process
+ * @param d pointer to filter memory (4 floats)
+ * @param count number of samples to process
+ * @param start filter at the beginning of the ramp
+ * @param end filter at the end of the ramp
+ * @param buf memory-aligned buffer of (LSP_DSP_RAMP_BIQUAD_CHUNK + 1) filters
+ */
+LSP_DSP_LIB_SYMBOL(void, ramp_biquad_process_x2, float *dst, const float *src, float *d, size_t count, const LSP_DSP_LIB_TYPE(biquad_x2_t) *start, const LSP_DSP_LIB_TYPE(biquad_x2_t) *end, LSP_DSP_LIB_TYPE(biquad_x2_t) *buf);
+
+/** Process four bi-quadratic filters with coefficients linearly interpolated between two
+ * filter banks for each sample, the same way as ramp_biquad_process_x1 does
+ *
+ * @param dst array of count destination samples to emit
+ * @param src array of count source samples to process
+ * @param d pointer to filter memory (8 floats)
+ * @param count number of samples to process
+ * @param start filter at the beginning of the ramp
+ * @param end filter at the end of the ramp
+ * @param buf memory-aligned buffer of (LSP_DSP_RAMP_BIQUAD_CHUNK + 3) filters
+ */
+LSP_DSP_LIB_SYMBOL(void, ramp_biquad_process_x4, float *dst, const float *src, float *d, size_t count, const LSP_DSP_LIB_TYPE(biquad_x4_t) *start, const LSP_DSP_LIB_TYPE(biquad_x4_t) *end, LSP_DSP_LIB_TYPE(biquad_x4_t) *buf);
+
+/** Process eight bi-quadratic filters with coefficients linearly interpolated between two
+ * filter banks for each sample, the same way as ramp_biquad_process_x1 does
+ *
+ * @param dst array of count destination samples to emit
+ * @param src array of count source samples to process
+ * @param d pointer to filter memory (16 floats)
+ * @param count number of samples to process
+ * @param start filter at the beginning of the ramp
+ * @param end filter at the end of the ramp
+ * @param buf memory-aligned buffer of (LSP_DSP_RAMP_BIQUAD_CHUNK + 7) filters
+ */
+LSP_DSP_LIB_SYMBOL(void, ramp_biquad_process_x8, float *dst, const float *src, float *d, size_t count, const LSP_DSP_LIB_TYPE(biquad_x8_t) *start, const LSP_DSP_LIB_TYPE(biquad_x8_t) *end, LSP_DSP_LIB_TYPE(biquad_x8_t) *buf);
+
+/** Process sixteen bi-quadratic filters with coefficients linearly interpolated between two
+ * filter banks for each sample, the same way as ramp_biquad_process_x1 does
+ *
+ * @param dst array of count destination samples to emit
+ * @param src array of count source samples to process
+ * @param d pointer to filter memory (32 floats)
+ * @param count number of samples to process
+ * @param start filter at the beginning of the ramp
+ * @param end filter at the end of the ramp
+ * @param buf memory-aligned buffer of (LSP_DSP_RAMP_BIQUAD_CHUNK + 15) filters
+ */
+LSP_DSP_LIB_SYMBOL(void, ramp_biquad_process_x16, float *dst, const float *src, float *d, size_t count, const LSP_DSP_LIB_TYPE(biquad_x16_t) *start, const LSP_DSP_LIB_TYPE(biquad_x16_t) *end, LSP_DSP_LIB_TYPE(biquad_x16_t) *buf);
+
+/** Perform bilinear transformation of eight filter banks and process the dynamic filters
+ * in one pass. The result is the same to the bilinear_transform_x8 called for each row
+ * of the cascade matrix with it's own frequency shift coefficient followed by the call
+ * of dyn_biquad_process_x8, but the coefficients of the filters are computed right before
+ * the processing and are not stored in memory.
+ *
+ * @param dst array of count destination samples to emit
+ * @param src array of count source samples to process
+ * @param d pointer to filter memory (16 floats)
+ * @param count number of samples to process
+ * @param bc memory-aligned source analog bilinear filter cascades matrix of (count+7) rows
+ * @param kf array of (count+7) frequency shift coefficients, one per each row of the matrix
+ */
+LSP_DSP_LIB_SYMBOL(void, dyn_bilinear_biquad_process_x8, float *dst, const float *src, float *d, size_t count, const LSP_DSP_LIB_TYPE(f_cascade_t) *bc, const float *kf);
+
 #endif /* LSP_PLUG_IN_DSP_COMMON_FILTERS_DYNAMIC_H_ */
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 7 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LSP_PLUG_IN_DSP_COMMON_FILTERS_MULTICHANNEL_H_
+#define LSP_PLUG_IN_DSP_COMMON_FILTERS_MULTICHANNEL_H_
+
+#include <lsp-plug.in/dsp/common/types.h>
+#include <lsp-plug.in/dsp/common/filters/types.h>
+
+/** Process four independent channels with the chain of bi-quadratic filter banks,
+ * i'th column of the bank is applied to the i'th channel
+ *
+ * @param dst destination buffer of count frames, each frame contains 4 interleaved samples
+ * @param src source buffer of count frames, each frame contains 4 interleaved samples
+ * @param d pointer to filter memory (8 floats per each filter bank)
+ * @param count number of frames to process
+ * @param f array of n filter banks applied in series
+ * @param n number of filter banks
+ */
+LSP_DSP_LIB_SYMBOL(void, biquad_process_mc4, float *dst, const float *src, float *d, size_t count, const LSP_DSP_LIB_TYPE(biquad_x4_t) *f, size_t n);
+
+/** Process eight independent channels with the chain of bi-quadratic filter banks,
+ * i'th column of the bank is applied to the i'th channel
+ *
+ * @param dst destination buffer of count frames, each frame contains 8 interleaved samples
+ * @param src source buffer of count frames, each frame contains 8 interleaved samples
+ * @param d pointer to filter memory (16 floats per each filter bank)
+ * @param count number of frames to process
+ * @param f array of n filter banks applied in series
+ * @param n number of filter banks
+ */
+LSP_DSP_LIB_SYMBOL(void, biquad_process_mc8, float *dst, const float *src, float *d, size_t count, const LSP_DSP_LIB_TYPE(biquad_x8_t) *f, size_t n);
+
+/** Process sixteen independent channels with the chain of bi-quadratic filter banks,
+ * i'th column of the bank is applied to the i'th channel
+ *
+ * @param dst destination buffer of count frames, each frame contains 16 interleaved samples
+ * @param src source buffer of count frames, each frame contains 16 interleaved samples
+ * @param d pointer to filter memory (32 floats per each filter bank)
+ * @param count number of frames to process
+ * @param f array of n filter banks applied in series
+ * @param n number of filter banks
+ */
+LSP_DSP_LIB_SYMBOL(void, biquad_process_mc16, float *dst, const float *src, float *d, size_t count, const LSP_DSP_LIB_TYPE(biquad_x16_t) *f, size_t n);
+
+/** Process four independent planar channels with the chain of bi-quadratic filter banks,
+ * i'th column of the bank is applied to the i'th channel
+ *
+ * @param dst array of 4 destination buffers of count samples
+ * @param src array of 4 source buffers of count samples, may be the same as destination buffers
+ * @param d pointer to filter memory (8 floats per each filter bank)
+ * @param count number of samples to process
+ * @param f array of n filter banks applied in series
+ * @param n number of filter banks
+ */
+LSP_DSP_LIB_SYMBOL(void, biquad_process_mc4_planar, float * const *dst, const float * const *src, float *d, size_t count, const LSP_DSP_LIB_TYPE(biquad_x4_t) *f, size_t n);
+
+/** Process eight independent planar channels with the chain of bi-quadratic filter banks,
+ * i'th column of the bank is applied to the i'th channel
+ *
+ * @param dst array of 8 destination buffers of count samples
+ * @param src array of 8 source buffers of count samples, may be the same as destination buffers
+ * @param d pointer to filter memory (16 floats per each filter bank)
+ * @param count number of samples to process
+ * @param f array of n filter banks applied in series
+ * @param n number of filter banks
+ */
+LSP_DSP_LIB_SYMBOL(void, biquad_process_mc8_planar, float * const *dst, const float * const *src, float *d, size_t count, const LSP_DSP_LIB_TYPE(biquad_x8_t) *f, size_t n);
+
+/** Process sixteen independent planar channels with the chain of bi-quadratic filter banks,
+ * i'th column of the bank is applied to the i'th channel
+ *
+ * @param dst array of 16 destination buffers of count samples
+ * @param src array of 16 source buffers of count samples, may be the same as destination buffers
+ * @param d pointer to filter memory (32 floats per each filter bank)
+ * @param count number of samples to process
+ * @param f array of n filter banks applied in series
+ * @param n number of filter banks
+ */
+LSP_DSP_LIB_SYMBOL(void, biquad_process_mc16_planar, float * const *dst, const float * const *src, float *d, size_t count, const LSP_DSP_LIB_TYPE(biquad_x16_t) *f, size_t n);
+
+#endif /* LSP_PLUG_IN_DSP_COMMON_FILTERS_MULTICHANNEL_H_ */
@@ -61,4 +61,13 @@ LSP_DSP_LIB_SYMBOL(void, biquad_process_x4, float *dst, const float *src, size_t
  */
 LSP_DSP_LIB_SYMBOL(void, biquad_process_x8, float *dst, const float *src, size_t count, LSP_DSP_LIB_TYPE(biquad_t) *f);
 
+/** Process sixteen bi-quadratic filters for multiple samples simultaneously
+ *
+ * @param dst destination samples
+ * @param src source samples
+ * @param count number of samples to process
+ * @param f bi-quadratic filter structure
+ */
+LSP_DSP_LIB_SYMBOL(void, biquad_process_x16, float *dst, const float *src, size_t count, LSP_DSP_LIB_TYPE(biquad16_t) *f);
+
 #endif /* LSP_PLUG_IN_DSP_COMMON_FILTERS_STATIC_H_ */
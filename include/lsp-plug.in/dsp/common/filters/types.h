@@ -123,6 +123,26 @@
 
    Then each row can be combined into single x4 filter bank same as for
    static filters and applied to the input sample in a pipeline mode.
+
+   Multi-channel filters use the same layout of x4, x8 and x16 filter banks but
+   each column of the bank is applied to its own independent channel instead of
+   the next cascade of the same channel. For example, x4 multi-channel bank
+   processes four channels at once:
+
+      Channel     0       1       2       3
+              ┌───────┬───────┬───────┬───────┐
+      Bank 0  │ f[0:0]│ f[1:0]│ f[2:0]│ f[3:0]│
+              ├───────┼───────┼───────┼───────┤
+      Bank 1  │ f[0:1]│ f[1:1]│ f[2:1]│ f[3:1]│
+              └───────┴───────┴───────┴───────┘
+
+       Each cell is one biquad filter f[i:j] where:
+         - i is the number of the channel
+         - j is the number of the filter cascade of the channel
+
+   Since channels do not depend on each other, there is no pipeline and
+   no latency between the input and the output of the bank. The memory of each
+   bank consists of d0 values of all channels followed by d1 values of all channels.
  */
 
 /*
@@ -193,6 +213,9 @@
 #define LSP_DSP_BIQUAD_XN_SOFF          "0x40"
 #define LSP_DSP_BIQUAD_ALIGN            0x40
 #define LSP_DSP_BIQUAD_D_ITEMS          16
+#define LSP_DSP_BIQUAD16_D_ITEMS        32
+#define LSP_DSP_BIQUAD_BLOCK_SIZE       8
+#define LSP_DSP_RAMP_BIQUAD_CHUNK       0x40
 
 LSP_DSP_LIB_BEGIN_NAMESPACE
 
@@ -260,6 +283,18 @@ typedef struct LSP_DSP_LIB_TYPE(biquad_x8_t)
     float   a2[8];
 } LSP_DSP_LIB_TYPE(biquad_x8_t);
 
+/**
+ * Biquad filter bank for 16 digital biquad filters
+ */
+typedef struct LSP_DSP_LIB_TYPE(biquad_x16_t)
+{
+    float   b0[16];
+    float   b1[16];
+    float   b2[16];
+    float   a1[16];
+    float   a2[16];
+} LSP_DSP_LIB_TYPE(biquad_x16_t);
+
 /**
  * This is main filter structure with memory elements
  * It should be aligned at least to 16-byte boundary due to
@@ -279,6 +314,45 @@ typedef struct LSP_DSP_LIB_TYPE(biquad_t)
     float   __pad[8];
 } __lsp_aligned(LSP_DSP_BIQUAD_ALIGN) LSP_DSP_LIB_TYPE(biquad_t);
 
+/**
+ * Filter structure with memory elements for the bank of 16 digital biquad filters.
+ * The bank needs twice more memory elements than biquad_t provides, so it is kept
+ * in the separate structure with the same alignment restrictions
+ */
+typedef struct LSP_DSP_LIB_TYPE(biquad16_t)
+{
+    float   d[LSP_DSP_BIQUAD16_D_ITEMS];
+    LSP_DSP_LIB_TYPE(biquad_x16_t) x16;
+} __lsp_aligned(LSP_DSP_BIQUAD_ALIGN) LSP_DSP_LIB_TYPE(biquad16_t);
+
+/**
+ * Block state-space form of the single biquad filter. The state of the filter is
+ * the filter memory x = { d0, d1 }, and the filter is defined as:
+ *
+ *   x[n+1] = A*x[n] + B*s[n],   A = | a1  1 |,  B = | b1 + a1*b0 |
+ *                                   | a2  0 |       | b2 + a2*b0 |
+ *
+ *   s'[n]  = C*x[n] + D*s[n],   C = | 1  0 |,   D = b0
+ *
+ * For the block of N = LSP_DSP_BIQUAD_BLOCK_SIZE samples the output samples and the
+ * next state are computed from the previous state with matrix-vector products only:
+ *
+ *   s'[k]  = C*A^k*x[0] + sum { h[k-j]*s[j] }, j = 0..k,  h[0] = D, h[m] = C*A^(m-1)*B
+ *   x[N]   = A^N*x[0] + sum { A^(N-1-j)*B*s[j] }, j = 0..N-1
+ *
+ * so there is no serial dependency between samples inside of the block.
+ * The structure should be initialized with the biquad_block_init() call.
+ */
+typedef struct LSP_DSP_LIB_TYPE(biquad_block_t)
+{
+    float   h[8][8];        // h[j][k]: response of the output sample k to the input sample j
+    float   q[8][8];        // q[j]: response of the state { d0, d1 } to the input sample j, repeated 4 times
+    float   p[2][8];        // p[i][k]: response of the output sample k to the state variable i
+    float   a[2][8];        // a[i]: response of the state { d0, d1 } to the state variable i, repeated 4 times
+    float   d[8];           // filter memory { d0, d1 }, repeated 4 times
+    LSP_DSP_LIB_TYPE(biquad_x1_t) x1;   // original filter, used for the samples that do not fill the whole block
+} __lsp_aligned(LSP_DSP_BIQUAD_ALIGN) LSP_DSP_LIB_TYPE(biquad_block_t);
+
 #pragma pack(pop)
 
 LSP_DSP_LIB_END_NAMESPACE
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LSP_PLUG_IN_DSP_COMMON_GOERTZEL_H_
+#define LSP_PLUG_IN_DSP_COMMON_GOERTZEL_H_
+
+#include <lsp-plug.in/dsp/common/types.h>
+
+LSP_DSP_LIB_BEGIN_NAMESPACE
+
+#pragma pack(push, 1)
+
+/**
+ * State of the bank of Goertzel filters which computes the spectrum of the signal
+ * at arbitrary frequencies. The bank does not allocate memory and operates on the
+ * buffer provided to the goertzel_init() function.
+ */
+typedef struct LSP_DSP_LIB_TYPE(goertzel_t)
+{
+    float      *coef;           // Feedback coefficients 2*cos(w), bins elements
+    float      *rot;            // Rotation factors cos(w), sin(w), 2*bins elements
+    float      *state;          // Last two filter outputs of each bin, 2*bins elements
+    size_t      bins;           // Number of frequency bins
+} LSP_DSP_LIB_TYPE(goertzel_t);
+
+/**
+ * State of the sliding DFT which tracks the spectrum of the last (length) samples
+ * at arbitrary frequencies, updated with each input sample. The engine does not
+ * allocate memory and operates on the buffer provided to the sdft_init() function.
+ */
+typedef struct LSP_DSP_LIB_TYPE(sdft_t)
+{
+    float      *coef;           // Rotation factors z and z^length, 4*bins elements
+    float      *state;          // Current spectrum, real parts followed by imaginary parts, 2*bins elements
+    float      *hist;           // Ring buffer of the last (length) samples
+    size_t      bins;           // Number of frequency bins
+    size_t      length;         // Length of the sliding window
+    size_t      head;           // Position of the oldest sample in the ring buffer
+} LSP_DSP_LIB_TYPE(sdft_t);
+
+#pragma pack(pop)
+
+LSP_DSP_LIB_END_NAMESPACE
+
+/**
+ * Process the signal with the bank of Goertzel filters:
+ *   s[n] = x[n] + 2*cos(w)*s[n-1] - s[n-2]
+ *
+ * @param state filter state, the array of s[n-1] of all bins followed by the array of s[n-2] of all bins
+ * @param coef feedback coefficients 2*cos(w) of all bins
+ * @param src source signal
+ * @param bins number of frequency bins
+ * @param count number of samples to process
+ */
+LSP_DSP_LIB_SYMBOL(void, goertzel_bank, float *state, const float *coef, const float *src, size_t bins, size_t count);
+
+/**
+ * Update the sliding DFT bins with the signal:
+ *   S[n] = z * (S[n-1] + x[n] - z^N * x[n-N])
+ *
+ * @param state spectrum, the array of real parts of all bins followed by the array of imaginary parts
+ * @param coef rotation factors, four arrays of all bins: re(z), im(z), re(z^N), im(z^N)
+ * @param src source signal x[n]
+ * @param old the signal leaving the sliding window x[n-N]
+ * @param bins number of frequency bins
+ * @param count number of samples to process
+ */
+LSP_DSP_LIB_SYMBOL(void, sdft_bank, float *state, const float *coef, const float *src, const float *old, size_t bins, size_t count);
+
+/**
+ * Get the size of the buffer required by the bank of Goertzel filters
+ *
+ * @param bins number of frequency bins
+ * @return number of floats to allocate for the buffer
+ */
+LSP_DSP_LIB_SYMBOL(size_t, goertzel_buffer_size, size_t bins);
+
+/**
+ * Initialize the bank of Goertzel filters and reset its state
+ *
+ * @param g the bank to initialize
+ * @param buf the buffer of goertzel_buffer_size() floats, should be aligned to 64 bytes
+ * @param freqs frequencies of bins normalized to the sample rate, from 0 to 0.5
+ * @param bins number of frequency bins, positive
+ * @return true on success, false on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(bool, goertzel_init, LSP_DSP_LIB_TYPE(goertzel_t) *g, float *buf, const float *freqs, size_t bins);
+
+/**
+ * Reset the state of the bank of Goertzel filters to start the new block of samples
+ *
+ * @param g the bank of Goertzel filters
+ */
+LSP_DSP_LIB_SYMBOL(void, goertzel_reset, LSP_DSP_LIB_TYPE(goertzel_t) *g);
+
+/**
+ * Process the block of samples with the bank of Goertzel filters, the block
+ * can be passed to the function by parts of arbitrary length
+ *
+ * @param g the bank of Goertzel filters
+ * @param src source signal
+ * @param count number of samples
+ */
+LSP_DSP_LIB_SYMBOL(void, goertzel_process, LSP_DSP_LIB_TYPE(goertzel_t) *g, const float *src, size_t count);
+
+/**
+ * Get the spectrum of the samples processed since the last reset. The phase
+ * of bins is referenced to the last processed sample:
+ *   X(w) = sum x[m] * exp(-i*w*(m - n))
+ *
+ * @param g the bank of Goertzel filters
+ * @param re real part of the spectrum, bins elements
+ * @param im imaginary part of the spectrum, bins elements
+ */
+LSP_DSP_LIB_SYMBOL(void, goertzel_spectrum, const LSP_DSP_LIB_TYPE(goertzel_t) *g, float *re, float *im);
+
+/**
+ * Get the size of the buffer required by the sliding DFT
+ *
+ * @param bins number of frequency bins
+ * @param length length of the sliding window
+ * @return number of floats to allocate for the buffer
+ */
+LSP_DSP_LIB_SYMBOL(size_t, sdft_buffer_size, size_t bins, size_t length);
+
+/**
+ * Initialize the sliding DFT and reset its state. For frequencies k/length the
+ * bins are equal to bins of the DFT of the window of the last (length) samples,
+ * for other frequencies the phase of the bin is shifted by w*length.
+ *
+ * @param s the sliding DFT to initialize
+ * @param buf the buffer of sdft_buffer_size() floats, should be aligned to 64 bytes
+ * @param freqs frequencies of bins normalized to the sample rate, from 0 to 0.5
+ * @param bins number of frequency bins, positive
+ * @param length length of the sliding window, positive
+ * @return true on success, false on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(bool, sdft_init, LSP_DSP_LIB_TYPE(sdft_t) *s, float *buf, const float *freqs, size_t bins, size_t length);
+
+/**
+ * Reset the sliding window and the spectrum of the sliding DFT
+ *
+ * @param s the sliding DFT
+ */
+LSP_DSP_LIB_SYMBOL(void, sdft_reset, LSP_DSP_LIB_TYPE(sdft_t) *s);
+
+/**
+ * Update the sliding DFT with the block of samples of arbitrary length
+ *
+ * @param s the sliding DFT
+ * @param src source signal
+ * @param count number of samples
+ */
+LSP_DSP_LIB_SYMBOL(void, sdft_process, LSP_DSP_LIB_TYPE(sdft_t) *s, const float *src, size_t count);
+
+/**
+ * Get the current spectrum of the sliding DFT
+ *
+ * @param s the sliding DFT
+ * @param re real part of the spectrum, bins elements
+ * @param im imaginary part of the spectrum, bins elements
+ */
+LSP_DSP_LIB_SYMBOL(void, sdft_spectrum, const LSP_DSP_LIB_TYPE(sdft_t) *s, float *re, float *im);
+
+#endif /* LSP_PLUG_IN_DSP_COMMON_GOERTZEL_H_ */
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 28 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_DSP_COMMON_HCONV_H_
+#define LSP_PLUG_IN_DSP_COMMON_HCONV_H_
+
+#include <lsp-plug.in/dsp/common/types.h>
+#include <lsp-plug.in/dsp/common/pconv.h>
+
+#define LSP_DSP_HCONV_RANK_MAX                      13
+#define LSP_DSP_HCONV_CALIBRATE_SIZE                (16 << (LSP_DSP_HCONV_RANK_MAX - 1))
+
+LSP_DSP_LIB_BEGIN_NAMESPACE
+
+#pragma pack(push, 1)
+
+/**
+ * Measured costs of convolution kernels on the running CPU, in nanoseconds
+ * per one sample of the processed signal. Arrays are indexed by the fast
+ * convolution rank, the head size for the rank is (1 << (rank - 1)) samples.
+ */
+typedef struct LSP_DSP_LIB_TYPE(hconv_costs_t)
+{
+    float       direct[LSP_DSP_PCONV_RANK_MAX + 1];     // Direct convolution with the head of (1 << (rank - 1)) samples
+    float       level[LSP_DSP_PCONV_RANK_MAX + 1];      // Forward and reverse transform of the partitioned convolver level
+    float       part[LSP_DSP_PCONV_RANK_MAX + 1];       // Multiplication and accumulation of one partition of the level
+} LSP_DSP_LIB_TYPE(hconv_costs_t);
+
+/**
+ * State of the zero-latency hybrid convolver. The head of the impulse response
+ * of (1 << (rank - 1)) samples is processed with the direct convolution, the
+ * rest of the impulse response is processed with the partitioned convolver
+ * which has the latency equal to the size of the head, so the output of both
+ * parts is aligned and the convolver introduces no latency.
+ *
+ * The convolver does not allocate memory and operates on the buffer provided
+ * to the hconv_init() function.
+ */
+typedef struct LSP_DSP_LIB_TYPE(hconv_t)
+{
+    LSP_DSP_LIB_TYPE(pconv_t) tail;     // Partitioned convolver of the tail, no levels if there is no tail
+    float      *head;           // The head of the impulse response, length floats
+    float      *acc;            // Accumulator of the direct convolution, 2 * block floats
+    size_t      length;         // Length of the head
+    size_t      block;          // Size of the head block, the maximum number of samples per direct convolution
+} LSP_DSP_LIB_TYPE(hconv_t);
+
+#pragma pack(pop)
+
+LSP_DSP_LIB_END_NAMESPACE
+
+/**
+ * Measure the costs of the direct and the fast convolution kernels on the running CPU.
+ * The call takes tens of milliseconds and should not be performed in the real-time thread.
+ *
+ * @param costs the structure to store the measured costs
+ * @param buf temporary buffer of LSP_DSP_HCONV_CALIBRATE_SIZE floats, should be aligned to 64 bytes
+ */
+LSP_DSP_LIB_SYMBOL(void, hconv_calibrate, LSP_DSP_LIB_TYPE(hconv_costs_t) *costs, float *buf);
+
+/**
+ * Estimate the optimal crossover between the direct and the fast convolution
+ *
+ * @param costs the measured costs of kernels
+ * @param length the length of the impulse response
+ * @param max_rank the maximum fast convolution rank of levels
+ * @return the rank which defines the head of (1 << (rank - 1)) samples with the minimum
+ *   estimated processing cost, 0 on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(size_t, hconv_rank, const LSP_DSP_LIB_TYPE(hconv_costs_t) *costs, size_t length, size_t max_rank);
+
+/**
+ * Get the size of the buffer required by the hybrid convolver
+ *
+ * @param length the length of the impulse response
+ * @param rank the rank which defines the head of (1 << (rank - 1)) samples
+ * @param max_rank the maximum fast convolution rank of levels
+ * @return number of floats to allocate for the buffer, 0 on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(size_t, hconv_buffer_size, size_t length, size_t rank, size_t max_rank);
+
+/**
+ * Initialize the hybrid convolver and compute the fast convolution data
+ * of the tail of the impulse response. The output is not delayed.
+ *
+ * @param conv the convolver to initialize
+ * @param buf the buffer of hconv_buffer_size() floats, should be aligned to 64 bytes
+ * @param ir the impulse response
+ * @param length the length of the impulse response, positive
+ * @param rank the rank which defines the head, LSP_DSP_PCONV_RANK_MIN to max_rank
+ * @param max_rank the maximum fast convolution rank of levels, rank to LSP_DSP_PCONV_RANK_MAX
+ * @return true on success, false on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(bool, hconv_init, LSP_DSP_LIB_TYPE(hconv_t) *conv, float *buf,
+        const float *ir, size_t length, size_t rank, size_t max_rank);
+
+/**
+ * Reset the input history and the output of the hybrid convolver
+ *
+ * @param conv the convolver
+ */
+LSP_DSP_LIB_SYMBOL(void, hconv_reset, LSP_DSP_LIB_TYPE(hconv_t) *conv);
+
+/**
+ * Process the block of samples of arbitrary length with the hybrid convolver
+ *
+ * @param conv the convolver
+ * @param dst destination buffer
+ * @param src source buffer, may be the same as destination
+ * @param count number of samples to process
+ */
+LSP_DSP_LIB_SYMBOL(void, hconv_process, LSP_DSP_LIB_TYPE(hconv_t) *conv, float *dst, const float *src, size_t count);
+
+#endif /* LSP_PLUG_IN_DSP_COMMON_HCONV_H_ */
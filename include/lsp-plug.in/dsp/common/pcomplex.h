@@ -134,6 +134,19 @@ LSP_DSP_LIB_SYMBOL(void, pcomplex_mod, float *dst_mod, const float *src, size_t
  */
 LSP_DSP_LIB_SYMBOL(void, pcomplex_modarg, float *mod, float *arg, const float *src, size_t count);
 
+/** Convert packed complex number to polar form with reduced precision: the module
+ * is computed with the approximate reciprocal square root and has the relative error
+ * up to 4e-4 if the squared module is not less than FLT_MIN, the module of smaller values
+ * is underestimated and flushed towards zero. The argument is computed with the polynomial
+ * approximation and has the absolute error up to 2e-5 radians. The argument of zero is 0.
+ *
+ * @param mod module of the complex number
+ * @param arg argument of the complex number in range of [-PI, +PI]
+ * @param src packed complex number data
+ * @param count number of elements to process
+ */
+LSP_DSP_LIB_SYMBOL(void, pcomplex_modarg_fast, float *mod, float *arg, const float *src, size_t count);
+
 /** Get argument for complex numbers in range of [-PI; +PI]
  *
  * @param dst array to sore argument
@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 9 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_DSP_COMMON_PCONV_H_
+#define LSP_PLUG_IN_DSP_COMMON_PCONV_H_
+
+#include <lsp-plug.in/dsp/common/types.h>
+
+#define LSP_DSP_PCONV_RANK_MIN                      4
+#define LSP_DSP_PCONV_RANK_MAX                      16
+#define LSP_DSP_PCONV_LEVELS_MAX                    (LSP_DSP_PCONV_RANK_MAX - LSP_DSP_PCONV_RANK_MIN + 1)
+#define LSP_DSP_PCONV_LEVEL_PARTS                   2
+#define LSP_DSP_PCONV_POOL_THREADS_MAX              16
+#define LSP_DSP_PCONV_POOL_JOBS_MAX                 128
+#define LSP_DSP_PCONV_POOL_ALIGN                    64
+#define LSP_DSP_PCONV_WAIT_SPINS                    64
+
+LSP_DSP_LIB_BEGIN_NAMESPACE
+
+typedef struct LSP_DSP_LIB_TYPE(pconv_job_t) LSP_DSP_LIB_TYPE(pconv_job_t);
+typedef struct LSP_DSP_LIB_TYPE(pconv_pool_t) LSP_DSP_LIB_TYPE(pconv_pool_t);
+typedef struct LSP_DSP_LIB_TYPE(pconv_swap_t) LSP_DSP_LIB_TYPE(pconv_swap_t);
+
+#pragma pack(push, 1)
+
+/**
+ * Level of the partitioned convolver: the part of the impulse response
+ * split into partitions of equal size
+ */
+typedef struct LSP_DSP_LIB_TYPE(pconv_level_t)
+{
+    float      *kernel;         // Fast convolution data of partitions, parts * (1 << (rank + 1)) floats
+    float      *fdl;            // Frequency-domain delay line: fast convolution data of last parts input blocks
+    const float **spectra;      // Pointers to the delay line, 2 * parts elements, spectra[i] = fdl block (i % parts)
+    const float **kernels;      // Pointers to fast convolution data of partitions in reverse order, parts elements
+    float      *xkernel;        // Fast convolution data of partitions of the pending impulse response, NULL if not used
+    const float **xkernels;     // Pointers to fast convolution data of the pending impulse response, NULL if not used
+    size_t      rank;           // Fast convolution rank, the partition size is (1 << (rank - 1)) samples
+    size_t      offset;         // Offset of the first partition in the impulse response
+    size_t      parts;          // Number of partitions
+    size_t      head;           // Position of the last input block in the delay line
+    LSP_DSP_LIB_TYPE(pconv_job_t) *job; // Asynchronous job of the level, NULL if the level is processed in place
+} LSP_DSP_LIB_TYPE(pconv_level_t);
+
+/**
+ * State of the partitioned convolver. The impulse response is split into levels,
+ * the partition size is doubled at each next level. Each level except the last
+ * one contains LSP_DSP_PCONV_LEVEL_PARTS partitions, the last level contains all
+ * the remaining partitions. The convolver provides the latency of one partition
+ * of the first level. If the maximum rank is the same as the rank of the first
+ * level, the impulse response is partitioned uniformly.
+ *
+ * Each level keeps the fast convolution data of the last input blocks in the
+ * frequency-domain delay line, so each input block is transformed once and the
+ * output of the level requires only one reverse transform.
+ *
+ * The convolver does not allocate memory and operates on the buffer provided
+ * to the pconv_init() function.
+ */
+typedef struct LSP_DSP_LIB_TYPE(pconv_t)
+{
+    float      *in;             // Input ring buffer, the size of the largest partition
+    float      *out;            // Output ring buffer, out_size floats
+    float      *spec;           // Accumulated fast convolution data of the level
+    float      *tmp;            // Temporary buffer for the output of the level
+    size_t      in_size;        // Size of the input ring buffer
+    size_t      out_size;       // Size of the output ring buffer, power of 2
+    size_t      head;           // Number of processed samples modulo the size of the output buffer
+    size_t      fill;           // Number of samples received since the last block
+    size_t      block;          // Size of the first level partition, the latency of the convolver
+    size_t      nlevels;        // Number of levels
+    LSP_DSP_LIB_TYPE(pconv_pool_t) *pool;  // Worker pool for asynchronous levels, NULL if not used
+    LSP_DSP_LIB_TYPE(pconv_swap_t) *swap;  // State of the impulse response replacement, NULL if not used
+    LSP_DSP_LIB_TYPE(pconv_level_t) levels[LSP_DSP_PCONV_LEVELS_MAX];
+} LSP_DSP_LIB_TYPE(pconv_t);
+
+#pragma pack(pop)
+
+/**
+ * State of the impulse response replacement. The fast convolution data of the
+ * new impulse response is prepared in the separate slot by the non-real-time
+ * thread. Then the convolver computes the output for both impulse responses
+ * from the same frequency-domain delay line. When all levels have contributed
+ * to the output of the new impulse response, the convolver performs the linear
+ * crossfade and switches to the new impulse response.
+ */
+struct LSP_DSP_LIB_TYPE(pconv_swap_t)
+{
+    volatile uint32_t   state;          // State of the replacement
+    uint32_t            reserved;       // Padding
+    float              *out;            // Output ring buffer of the pending impulse response, out_size floats
+    float              *tmp;            // Buffer to prepare partitions of the pending impulse response
+    size_t              latency;        // Number of samples between the start of computation and the crossfade
+    size_t              delay;          // Number of samples left before the crossfade
+    size_t              fade;           // Length of the crossfade
+    size_t              pos;            // Current position in the crossfade
+};
+
+LSP_DSP_LIB_END_NAMESPACE
+
+/**
+ * Get the size of the buffer required by the partitioned convolver
+ *
+ * @param length the length of the impulse response
+ * @param rank the fast convolution rank of the first level
+ * @param max_rank the maximum fast convolution rank of levels
+ * @return number of floats to allocate for the buffer, 0 on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(size_t, pconv_buffer_size, size_t length, size_t rank, size_t max_rank);
+
+/**
+ * Initialize the partitioned convolver and compute the fast convolution data
+ * of the impulse response. The output is delayed by (1 << (rank - 1)) samples.
+ *
+ * @param conv the convolver to initialize
+ * @param buf the buffer of pconv_buffer_size() floats, should be aligned to 64 bytes
+ * @param ir the impulse response
+ * @param length the length of the impulse response, positive
+ * @param rank the fast convolution rank of the first level, LSP_DSP_PCONV_RANK_MIN to LSP_DSP_PCONV_RANK_MAX
+ * @param max_rank the maximum fast convolution rank of levels, rank to LSP_DSP_PCONV_RANK_MAX
+ * @return true on success, false on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(bool, pconv_init, LSP_DSP_LIB_TYPE(pconv_t) *conv, float *buf,
+        const float *ir, size_t length, size_t rank, size_t max_rank);
+
+/**
+ * Reset the input history and the output of the partitioned convolver. The convolver
+ * with asynchronous levels waits for the jobs which are computed by worker threads.
+ *
+ * @param conv the convolver
+ */
+LSP_DSP_LIB_SYMBOL(void, pconv_reset, LSP_DSP_LIB_TYPE(pconv_t) *conv);
+
+/**
+ * Process the block of samples of arbitrary length with the partitioned convolver
+ *
+ * @param conv the convolver
+ * @param dst destination buffer
+ * @param src source buffer, may be the same as destination
+ * @param count number of samples to process
+ */
+LSP_DSP_LIB_SYMBOL(void, pconv_process, LSP_DSP_LIB_TYPE(pconv_t) *conv, float *dst, const float *src, size_t count);
+
+/**
+ * Get the size of the buffer required by the partitioned convolver with
+ * the replaceable impulse response
+ *
+ * @param length the maximum length of the impulse response
+ * @param rank the fast convolution rank of the first level
+ * @param max_rank the maximum fast convolution rank of levels
+ * @return number of floats to allocate for the buffer, 0 on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(size_t, pconv_swap_buffer_size, size_t length, size_t rank, size_t max_rank);
+
+/**
+ * Initialize the partitioned convolver with the replaceable impulse response.
+ * The output is delayed by (1 << (rank - 1)) samples.
+ *
+ * @param conv the convolver to initialize
+ * @param buf the buffer of pconv_swap_buffer_size() floats, should be aligned to 64 bytes
+ * @param ir the impulse response
+ * @param length the maximum length of the impulse response, positive
+ * @param rank the fast convolution rank of the first level, LSP_DSP_PCONV_RANK_MIN to LSP_DSP_PCONV_RANK_MAX
+ * @param max_rank the maximum fast convolution rank of levels, rank to LSP_DSP_PCONV_RANK_MAX
+ * @return true on success, false on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(bool, pconv_swap_init, LSP_DSP_LIB_TYPE(pconv_t) *conv, float *buf,
+        const float *ir, size_t length, size_t rank, size_t max_rank);
+
+/**
+ * Prepare the new impulse response of the convolver. The call does not interfere
+ * with pconv_process() and should be performed by the non-real-time thread.
+ * The convolver starts computing the output of the new impulse response at the
+ * next block boundary, after swap->latency samples it performs the crossfade of
+ * the specified length and switches to the new impulse response.
+ *
+ * @param conv the convolver initialized with pconv_swap_init()
+ * @param ir the new impulse response
+ * @param length the length of the new impulse response, not greater than the length passed to pconv_swap_init()
+ * @param fade the length of the crossfade in samples
+ * @return true on success, false if the previous replacement is not completed or on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(bool, pconv_swap_prepare, LSP_DSP_LIB_TYPE(pconv_t) *conv,
+        const float *ir, size_t length, size_t fade);
+
+/**
+ * Get the size of the memory required by the pool of worker threads. The pool
+ * is opaque since its layout depends on the threading library, the memory is
+ * allocated by the caller and should be aligned to LSP_DSP_PCONV_POOL_ALIGN bytes.
+ * One pool can serve multiple convolvers.
+ *
+ * @return number of bytes to allocate for the pool
+ */
+LSP_DSP_LIB_SYMBOL(size_t, pconv_pool_size, void);
+
+/**
+ * Start worker threads of the pool
+ *
+ * @param pool the memory of pconv_pool_size() bytes to start the pool in
+ * @param threads number of worker threads, 1 to LSP_DSP_PCONV_POOL_THREADS_MAX
+ * @return true on success, false on invalid parameters, misaligned memory or if threads can not be started
+ */
+LSP_DSP_LIB_SYMBOL(bool, pconv_pool_start, LSP_DSP_LIB_TYPE(pconv_pool_t) *pool, size_t threads);
+
+/**
+ * Stop worker threads of the pool. Convolvers which use the pool should not
+ * be processed during and after the call, they should be destroyed with the
+ * pconv_mt_destroy() function before the memory of the pool is released.
+ *
+ * @param pool the pool to stop
+ */
+LSP_DSP_LIB_SYMBOL(void, pconv_pool_stop, LSP_DSP_LIB_TYPE(pconv_pool_t) *pool);
+
+/**
+ * Get the size of the buffer required by the partitioned convolver with asynchronous levels
+ *
+ * @param length the length of the impulse response
+ * @param rank the fast convolution rank of the first level
+ * @param max_rank the maximum fast convolution rank of levels
+ * @param async_rank the minimum fast convolution rank of levels processed by the worker pool
+ * @return number of floats to allocate for the buffer, 0 on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(size_t, pconv_mt_buffer_size, size_t length, size_t rank, size_t max_rank, size_t async_rank);
+
+/**
+ * Initialize the partitioned convolver with asynchronous levels. Levels of
+ * async_rank and above, except the first level, are computed by the worker pool
+ * and picked up by pconv_process() before their output is required. If the job
+ * has not been started by the worker at that moment, it is computed in place.
+ * If the worker is still computing the job, pconv_process() yields the processor
+ * at most LSP_DSP_PCONV_WAIT_SPINS times and then drops the output of the level
+ * for this block instead of blocking the caller; the level also skips the input
+ * blocks received while the worker is busy with the dropped job.
+ * The output is delayed by (1 << (rank - 1)) samples. The convolver takes jobs
+ * from the pool and should be destroyed with the pconv_mt_destroy() function.
+ *
+ * @param conv the convolver to initialize
+ * @param buf the buffer of pconv_mt_buffer_size() floats, should be aligned to 64 bytes
+ * @param pool the started worker pool
+ * @param ir the impulse response
+ * @param length the length of the impulse response, positive
+ * @param rank the fast convolution rank of the first level, LSP_DSP_PCONV_RANK_MIN to LSP_DSP_PCONV_RANK_MAX
+ * @param max_rank the maximum fast convolution rank of levels, rank to LSP_DSP_PCONV_RANK_MAX
+ * @param async_rank the minimum fast convolution rank of levels processed by the worker pool
+ * @return true on success, false on invalid parameters or if the pool has not enough free jobs
+ */
+LSP_DSP_LIB_SYMBOL(bool, pconv_mt_init, LSP_DSP_LIB_TYPE(pconv_t) *conv, float *buf,
+        LSP_DSP_LIB_TYPE(pconv_pool_t) *pool, const float *ir, size_t length,
+        size_t rank, size_t max_rank, size_t async_rank);
+
+/**
+ * Wait for pending jobs of the partitioned convolver with asynchronous levels
+ * and return its jobs to the pool
+ *
+ * @param conv the convolver
+ */
+LSP_DSP_LIB_SYMBOL(void, pconv_mt_destroy, LSP_DSP_LIB_TYPE(pconv_t) *conv);
+
+#endif /* LSP_PLUG_IN_DSP_COMMON_PCONV_H_ */
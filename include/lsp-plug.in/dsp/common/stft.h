@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 5 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_DSP_COMMON_STFT_H_
+#define LSP_PLUG_IN_DSP_COMMON_STFT_H_
+
+#include <lsp-plug.in/dsp/common/types.h>
+
+LSP_DSP_LIB_BEGIN_NAMESPACE
+
+/**
+ * Analysis window function of the STFT engine. All windows are periodic
+ * to provide the exact overlap-add of frames.
+ */
+typedef enum LSP_DSP_LIB_TYPE(stft_window_t)
+{
+    STFT_WND_RECTANGULAR,           // Rectangular window
+    STFT_WND_HANN,                  // Hann window
+    STFT_WND_HAMMING,               // Hamming window
+    STFT_WND_BLACKMAN_HARRIS,       // 4-term Blackman-Harris window
+    STFT_WND_KAISER                 // Kaiser window, the parameter is the beta
+} LSP_DSP_LIB_TYPE(stft_window_t);
+
+/**
+ * Spectral frame processing function of the STFT engine
+ *
+ * @param arg user argument passed to the stft_process() function
+ * @param frame packed complex spectrum [re, im, re, im ...], (1 << (rank-1)) + 1 complex elements,
+ *   can be modified in place to change the resynthesised output
+ * @param rank the rank of FFT
+ */
+typedef void (* LSP_DSP_LIB_TYPE(stft_frame_t))(void *arg, float *frame, size_t rank);
+
+#pragma pack(push, 1)
+
+/**
+ * State of the streaming STFT engine. The engine does not allocate memory and
+ * operates on the buffer provided to the stft_init() function. The buffer of
+ * stft_buffer_size() floats is split into the following parts:
+ *   - the analysis window;
+ *   - the synthesis window which also compensates the gain of the overlap-add;
+ *   - the ring buffer of the last (1 << rank) input samples;
+ *   - the ring buffer for the overlap-add of the resynthesised frames;
+ *   - the spectral frame;
+ *   - the temporary buffer for the inverse transform.
+ */
+typedef struct LSP_DSP_LIB_TYPE(stft_t)
+{
+    float      *wa;             // Analysis window, (1 << rank) elements
+    float      *ws;             // Synthesis window, (1 << rank) elements
+    float      *in;             // Input ring buffer, (1 << rank) elements
+    float      *out;            // Overlap-add ring buffer, (1 << rank) elements
+    float      *frame;          // Packed complex spectrum, (1 << (rank-1)) + 1 complex elements
+    float      *tmp;            // Temporary buffer for the inverse transform, (1 << rank) elements
+    size_t      rank;           // The rank of FFT
+    size_t      hop;            // Number of samples between two frames
+    size_t      head;           // The position of the next sample in ring buffers
+    size_t      fill;           // Number of samples received since the last frame
+} LSP_DSP_LIB_TYPE(stft_t);
+
+#pragma pack(pop)
+
+LSP_DSP_LIB_END_NAMESPACE
+
+/**
+ * Compute the periodic window function
+ *
+ * @param dst destination buffer to store the window
+ * @param count the length of the window
+ * @param window the window function
+ * @param param the window parameter (beta for the Kaiser window, ignored by other windows)
+ */
+LSP_DSP_LIB_SYMBOL(void, stft_window, float *dst, size_t count,
+        LSP_DSP_LIB_TYPE(stft_window_t) window, float param);
+
+/**
+ * Get the size of the buffer required by the STFT engine
+ *
+ * @param rank the rank of FFT
+ * @return number of floats to allocate for the buffer
+ */
+LSP_DSP_LIB_SYMBOL(size_t, stft_buffer_size, size_t rank);
+
+/**
+ * Initialize the STFT engine. Frames are computed each hop samples and
+ * the resynthesised output is delayed by (1 << rank) samples.
+ *
+ * @param st the STFT engine state to initialize
+ * @param buf the buffer of stft_buffer_size() floats, should be aligned to 64 bytes
+ * @param rank the rank of FFT, at least 2
+ * @param hop the distance between frames, should be a divisor of (1 << rank)
+ * @param window the analysis window function
+ * @param param the window parameter
+ * @return true on success, false on invalid parameters
+ */
+LSP_DSP_LIB_SYMBOL(bool, stft_init, LSP_DSP_LIB_TYPE(stft_t) *st, float *buf, size_t rank, size_t hop,
+        LSP_DSP_LIB_TYPE(stft_window_t) window, float param);
+
+/**
+ * Reset the input history and the overlap-add buffer of the STFT engine
+ *
+ * @param st the STFT engine state
+ */
+LSP_DSP_LIB_SYMBOL(void, stft_reset, LSP_DSP_LIB_TYPE(stft_t) *st);
+
+/**
+ * Process the block of samples of arbitrary length with the STFT engine.
+ * Each time the hop of samples is received, the windowed spectral frame is
+ * computed and passed to the frame processing function. If the destination
+ * buffer is specified, the frame is then resynthesised and overlap-added to
+ * the output.
+ *
+ * @param st the STFT engine state
+ * @param dst destination buffer to store the resynthesised signal, may be NULL for analysis only
+ * @param src source buffer, may be the same as destination
+ * @param count number of samples to process
+ * @param func frame processing function, may be NULL
+ * @param arg argument passed to the frame processing function
+ */
+LSP_DSP_LIB_SYMBOL(void, stft_process, LSP_DSP_LIB_TYPE(stft_t) *st, float *dst, const float *src, size_t count,
+        LSP_DSP_LIB_TYPE(stft_frame_t) func, void *arg);
+
+#endif /* LSP_PLUG_IN_DSP_COMMON_STFT_H_ */
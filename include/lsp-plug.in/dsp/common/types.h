@@ -29,6 +29,10 @@
 #include <stdint.h>
 #include <limits.h>
 
+#ifndef __cplusplus
+    #include <stdbool.h>
+#endif /* __cplusplus */
+
 // Macro definitions
 #define LSP_DSP_VEC2(v)                     v, v
 #define LSP_DSP_VEC4(v)                     LSP_DSP_VEC2(v), LSP_DSP_VEC2(v)
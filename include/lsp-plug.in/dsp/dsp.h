@@ -49,20 +49,27 @@
 #include <lsp-plug.in/dsp/common/context.h>
 #include <lsp-plug.in/dsp/common/convolution.h>
 #include <lsp-plug.in/dsp/common/copy.h>
+#include <lsp-plug.in/dsp/common/cqt.h>
 #include <lsp-plug.in/dsp/common/dynamics.h>
 #include <lsp-plug.in/dsp/common/fastconv.h>
 #include <lsp-plug.in/dsp/common/fft.h>
+#include <lsp-plug.in/dsp/common/fftn.h>
+#include <lsp-plug.in/dsp/common/fftplan.h>
 #include <lsp-plug.in/dsp/common/filters.h>
 #include <lsp-plug.in/dsp/common/float.h>
+#include <lsp-plug.in/dsp/common/goertzel.h>
 #include <lsp-plug.in/dsp/common/graphics.h>
+#include <lsp-plug.in/dsp/common/hconv.h>
 #include <lsp-plug.in/dsp/common/hmath.h>
 #include <lsp-plug.in/dsp/common/mix.h>
 #include <lsp-plug.in/dsp/common/msmatrix.h>
 #include <lsp-plug.in/dsp/common/pcomplex.h>
+#include <lsp-plug.in/dsp/common/pconv.h>
 #include <lsp-plug.in/dsp/common/pmath.h>
 #include <lsp-plug.in/dsp/common/resampling.h>
 #include <lsp-plug.in/dsp/common/search.h>
 #include <lsp-plug.in/dsp/common/smath.h>
+#include <lsp-plug.in/dsp/common/stft.h>
 #include <lsp-plug.in/dsp/common/interpolation.h>
 
 #endif /* LSP_PLUG_IN_DSP_DSP_H_ */
@@ -190,8 +190,9 @@ namespace lsp
         {
             IF_ARCH_AARCH64(
                 rank -= 3;
-                const float *xfft_a = &XFFT_A[rank << 4];
-                const float *xfft_dw = &XFFT_DW[rank << 3];
+                const float *xfft_a, *xfft_dw;
+                float xw[24] __lsp_aligned16;
+                fft_twiddle_rows(xfft_a, xfft_dw, xw, rank);
                 float *b_re, *b_im;
                 size_t pairs;
             )
@@ -216,8 +217,9 @@ namespace lsp
         {
             IF_ARCH_AARCH64(
                 rank -= 3;
-                const float *xfft_a = &XFFT_A[rank << 4];
-                const float *xfft_dw = &XFFT_DW[rank << 3];
+                const float *xfft_a, *xfft_dw;
+                float xw[24] __lsp_aligned16;
+                fft_twiddle_rows(xfft_a, xfft_dw, xw, rank);
                 float *b_re, *b_im;
                 size_t pairs;
             )
@@ -172,8 +172,9 @@ namespace lsp
         void direct_butterfly_rank4p(float *dst_re, float *dst_im, size_t rank, size_t blocks) {
             IF_ARCH_ARM(
                 rank -= 3;
-                const float *xfft_a = &XFFT_A[rank << 4];
-                const float *xfft_dw = &XFFT_DW[rank << 3];
+                const float *xfft_a, *xfft_dw;
+                float xw[24] __lsp_aligned16;
+                fft_twiddle_rows(xfft_a, xfft_dw, xw, rank);
                 float *b_re, *b_im;
                 size_t pairs;
             )
@@ -194,8 +195,9 @@ namespace lsp
         void reverse_butterfly_rank4p(float *dst_re, float *dst_im, size_t rank, size_t blocks) {
             IF_ARCH_ARM(
                 rank -= 3;
-                const float *xfft_a = &XFFT_A[rank << 4];
-                const float *xfft_dw = &XFFT_DW[rank << 3];
+                const float *xfft_a, *xfft_dw;
+                float xw[24] __lsp_aligned16;
+                fft_twiddle_rows(xfft_a, xfft_dw, xw, rank);
                 float *b_re, *b_im;
                 size_t pairs;
             )
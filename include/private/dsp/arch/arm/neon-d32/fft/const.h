@@ -141,6 +141,48 @@ namespace lsp
             LSP_DSP_VEC4(0.9999999816164293), LSP_DSP_VEC4(0.0001917475973107),
             LSP_DSP_VEC4(0.9999999954041073), LSP_DSP_VEC4(0.0000958737990960),
         };
+
+        /**
+         * Number of butterfly ranks covered by the XFFT_A and XFFT_DW tables
+         */
+        static constexpr size_t XFFT_TABLE_RANKS    = sizeof(XFFT_A) / (sizeof(float) * 16);
+
+        /**
+         * Get the twiddle factors for the butterfly. If the rank is not covered by the
+         * XFFT_A and XFFT_DW tables, the factors are computed with double precision and
+         * stored in the temporary buffer.
+         *
+         * @param xfft_a pointer to store the address of the initial angle row
+         * @param xfft_dw pointer to store the address of the angle rotation row
+         * @param xw temporary buffer of 24 elements aligned to 16-byte boundary
+         * @param rank the rank of butterfly decremented by 3
+         */
+        static inline void fft_twiddle_rows(const float * &xfft_a, const float * &xfft_dw, float *xw, size_t rank)
+        {
+            if (rank < XFFT_TABLE_RANKS)
+            {
+                xfft_a          = &XFFT_A[rank << 4];
+                xfft_dw         = &XFFT_DW[rank << 3];
+                return;
+            }
+
+            double k        = M_PI / double(size_t(4) << rank);
+            double w_re     = cos(k * 8.0);
+            double w_im     = sin(k * 8.0);
+            for (size_t i=0; i<8; ++i)
+            {
+                xw[i]           = cos(k * i);
+                xw[i + 8]       = sin(k * i);
+            }
+            for (size_t i=0; i<4; ++i)
+            {
+                xw[i + 16]      = w_re;
+                xw[i + 20]      = w_im;
+            }
+
+            xfft_a          = &xw[0];
+            xfft_dw         = &xw[16];
+        }
     }
 }
 
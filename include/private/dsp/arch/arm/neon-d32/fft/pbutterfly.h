@@ -161,8 +161,9 @@ namespace lsp
         void packed_direct_butterfly_rank4p(float *dst, size_t rank, size_t blocks) {
             IF_ARCH_ARM(
                 rank -= 3;
-                const float *xfft_a = &XFFT_A[rank << 4];
-                const float *xfft_dw = &XFFT_DW[rank << 3];
+                const float *xfft_a, *xfft_dw;
+                float xw[24] __lsp_aligned16;
+                fft_twiddle_rows(xfft_a, xfft_dw, xw, rank);
                 float *b;
                 size_t pairs;
             )
@@ -182,8 +183,9 @@ namespace lsp
         void packed_reverse_butterfly_rank4p(float *dst, size_t rank, size_t blocks) {
             IF_ARCH_ARM(
                 rank -= 3;
-                const float *xfft_a = &XFFT_A[rank << 4];
-                const float *xfft_dw = &XFFT_DW[rank << 3];
+                const float *xfft_a, *xfft_dw;
+                float xw[24] __lsp_aligned16;
+                fft_twiddle_rows(xfft_a, xfft_dw, xw, rank);
                 float *b;
                 size_t pairs;
             )
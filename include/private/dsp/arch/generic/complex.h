@@ -115,6 +115,45 @@ namespace lsp
             }
         }
 
+        /**
+         * Approximation of atan2(im, re): the polynomial approximation of atan(a) for a = min/max
+         * of absolute values in the range [0, 1] followed by the octant correction. The maximum
+         * absolute error is about 1.2e-5 radians, the argument of zero is 0.
+         */
+        static inline float complex_atan2_fast(float re, float im)
+        {
+            const float ar      = fabsf(re);
+            const float ai      = fabsf(im);
+            const float a       = lsp_min(ar, ai) / lsp_max(lsp_max(ar, ai), FLT_MIN);
+            const float a2      = a * a;
+
+            float r             = a * (0.999866426f + a2 * (-0.3303065f + a2 * (0.180166528f + a2 * (-0.0851672515f + a2 * 0.0208504759f))));
+            if (ai > ar)
+                r                   = M_PI_2 - r;
+            if (re < 0.0f)
+                r                   = M_PI - r;
+
+            return copysignf(r, im);
+        }
+
+        void complex_cvt2modarg_fast(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count)
+        {
+            for (size_t i=0; i<count; ++i)
+            {
+                float r         = src_re[i];
+                float im        = src_im[i];
+
+                dst_mod[i]      = sqrtf(r * r + im * im);
+                dst_arg[i]      = complex_atan2_fast(r, im);
+            }
+        }
+
+        void complex_arg_fast(float *dst, const float *re, const float *im, size_t count)
+        {
+            for (size_t i=0; i<count; ++i)
+                dst[i]          = complex_atan2_fast(re[i], im[i]);
+        }
+
         void complex_cvt2reim(float *dst_re, float *dst_im, const float *src_mod, const float *src_arg, size_t count)
         {
             while (count--)
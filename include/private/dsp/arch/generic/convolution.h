@@ -118,6 +118,17 @@ namespace lsp
                 k++;
             }
         }
+
+        void convolve_multi(float * const *dst, const float *src, const float * const *conv, size_t length, size_t count, size_t n)
+        {
+            // Apply each block of 4 source samples to all convolutions at once
+            for (size_t off=0; off < count; off += 4)
+            {
+                size_t to_do    = lsp_min(count - off, size_t(4));
+                for (size_t i=0; i<n; ++i)
+                    dsp::convolve(&dst[i][off], &src[off], conv[i], length, to_do);
+            }
+        }
     } /* namespace generic */
 } /* namespace lsp */
 
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 1 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_CQT_H_
+#define PRIVATE_DSP_ARCH_GENERIC_CQT_H_
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_GENERIC_IMPL */
+
+// Half-width of the band of the spectral kernel in bins of the DFT of the window length:
+// the main lobe of the Hann window and two side lobes at each side
+#define CQT_KERNEL_WIDTH        4.0
+
+namespace lsp
+{
+    namespace generic
+    {
+        void cqt_kernel_apply(float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins)
+        {
+            for (size_t i=0; i<bins; ++i, band += 2, dst += 2)
+            {
+                const float *s  = &src[band[0] * 2];
+                float re        = 0.0f;
+                float im        = 0.0f;
+
+                for (size_t j=0, n=band[1]; j<n; ++j, s += 2, kernel += 2)
+                {
+                    re             += s[0] * kernel[0] - s[1] * kernel[1];
+                    im             += s[0] * kernel[1] + s[1] * kernel[0];
+                }
+
+                dst[0]          = re;
+                dst[1]          = im;
+            }
+        }
+
+        typedef struct cqt_bin_t
+        {
+            double      freq;           // Frequency of the bin, normalized to the sample rate
+            size_t      length;         // Length of the window
+            size_t      first;          // First FFT bin of the band
+            size_t      count;          // Number of FFT bins in the band
+        } cqt_bin_t;
+
+        static inline size_t cqt_align(size_t count)
+        {
+            return (count + 0x0f) & ~size_t(0x0f);
+        }
+
+        static inline double cqt_quality(size_t bins_per_octave)
+        {
+            return 1.0 / (pow(2.0, 1.0 / bins_per_octave) - 1.0);
+        }
+
+        /**
+         * Compute the normalized frequency of the first bin
+         * @return the frequency or negative value on invalid parameters
+         */
+        static double cqt_lowest(size_t rank, size_t bins_per_octave, size_t sample_rate, float fmin)
+        {
+            if ((rank < 4) || (rank > 31) || (bins_per_octave == 0) || (sample_rate == 0) || (fmin < 0.0f))
+                return -1.0;
+
+            const size_t n  = size_t(1) << rank;
+            const double q  = cqt_quality(bins_per_octave);
+            if (fmin <= 0.0f)
+                return q / n;
+
+            // The window of the first bin should fit the frame
+            const double f  = double(fmin) / sample_rate;
+            if ((f >= 0.5) || (size_t(q / f + 0.5) > n))
+                return -1.0;
+
+            return f;
+        }
+
+        static void cqt_bin(cqt_bin_t *b, size_t rank, double q, double freq)
+        {
+            const size_t n  = size_t(1) << rank;
+            const double c  = freq * n;
+            b->freq         = freq;
+            b->length       = lsp_max(size_t(q / freq + 0.5), size_t(1));
+
+            const double h  = CQT_KERNEL_WIDTH * n / b->length;
+            const ssize_t f = ceil(c - h);
+            const ssize_t l = floor(c + h);
+
+            b->first        = lsp_max(f, ssize_t(0));
+            b->count        = lsp_min(size_t(l), n >> 1) - b->first + 1;
+        }
+
+        static size_t cqt_bins(size_t *nonzero, size_t rank, size_t bins_per_octave, double fmin)
+        {
+            const double q  = cqt_quality(bins_per_octave);
+            size_t bins     = 0;
+            size_t nz       = 0;
+            cqt_bin_t b;
+
+            for ( ; ; ++bins)
+            {
+                const double f  = fmin * pow(2.0, double(bins) / bins_per_octave);
+                if (f >= 0.5)
+                    break;
+                cqt_bin(&b, rank, q, f);
+                nz             += b.count;
+            }
+
+            *nonzero        = nz;
+            return bins;
+        }
+
+        size_t cqt_kernel_buffer_size(size_t rank, size_t bins_per_octave, size_t sample_rate, float fmin)
+        {
+            const double f  = cqt_lowest(rank, bins_per_octave, sample_rate, fmin);
+            if (f <= 0.0)
+                return 0;
+
+            size_t nonzero;
+            const size_t bins = cqt_bins(&nonzero, rank, bins_per_octave, f);
+            return cqt_align(nonzero * 2) + cqt_align(bins * 2) + cqt_align(bins);
+        }
+
+        /**
+         * Sum of exp(i*t*m) for m = 0 .. n-1
+         */
+        static void cqt_dirichlet(double &re, double &im, double t, size_t n)
+        {
+            const double s  = sin(0.5 * t);
+            const double d  = (fabs(s) > 1e-12) ? sin(0.5 * t * n) / s : double(n);
+            const double a  = 0.5 * t * (n - 1);
+
+            re              = d * cos(a);
+            im              = d * sin(a);
+        }
+
+        /**
+         * Compute the element of the spectral kernel: the complex conjugate of the DFT of the
+         * windowed complex exponent divided by the length of the frame. The window of
+         * length l ends at the last sample of the frame:
+         *   t[n - l + m] = w[m] / sum(w) * exp(i*w*(m - l + 1)), w[m] = 0.5 - 0.5*cos(b*(m + 1)), b = 2*pi/(l + 1)
+         */
+        static void cqt_kernel_element(float *dst, const cqt_bin_t *b, size_t rank, size_t j)
+        {
+            const size_t n  = size_t(1) << rank;
+            const size_t l  = b->length;
+            const double w  = 2.0 * M_PI * b->freq;
+            const double t  = w - (2.0 * M_PI * j) / n;
+            const double bt = 2.0 * M_PI / (l + 1);
+
+            // Sum of w[m] * exp(i*t*m): the Hann window is the sum of three complex exponents
+            double g_re, g_im, p_re, p_im, m_re, m_im;
+            cqt_dirichlet(g_re, g_im, t, l);
+            cqt_dirichlet(p_re, p_im, t + bt, l);
+            cqt_dirichlet(m_re, m_im, t - bt, l);
+
+            const double cb = cos(bt), sb = sin(bt);
+            double h_re     = 0.5 * g_re - 0.25 * (cb * (p_re + m_re) - sb * (p_im - m_im));
+            double h_im     = 0.5 * g_im - 0.25 * (cb * (p_im + m_im) + sb * (p_re - m_re));
+
+            // Phase shift of the window position and of the reference point, normalization
+            const size_t  r = (j * (n - l)) & (n - 1);
+            const double a  = -(2.0 * M_PI * r) / n - w * (l - 1);
+            const double k  = 2.0 / ((l + 1) * double(n));
+            const double ca = cos(a), sa = sin(a);
+
+            dst[0]          = (h_re * ca - h_im * sa) * k;
+            dst[1]          = -(h_re * sa + h_im * ca) * k;
+        }
+
+        bool cqt_kernel_init(dsp::cqt_kernel_t *k, float *buf,
+            size_t rank, size_t bins_per_octave, size_t sample_rate, float fmin)
+        {
+            const double f  = cqt_lowest(rank, bins_per_octave, sample_rate, fmin);
+            if (f <= 0.0)
+                return false;
+
+            size_t nonzero;
+            const size_t bins   = cqt_bins(&nonzero, rank, bins_per_octave, f);
+            const double q      = cqt_quality(bins_per_octave);
+
+            k->kernel           = buf;
+            k->band             = reinterpret_cast<uint32_t *>(&k->kernel[cqt_align(nonzero * 2)]);
+            k->freqs            = reinterpret_cast<float *>(&k->band[cqt_align(bins * 2)]);
+            k->bins             = bins;
+            k->nonzero          = nonzero;
+            k->rank             = rank;
+            k->bins_per_octave  = bins_per_octave;
+            k->sample_rate      = sample_rate;
+            k->fmin             = f * sample_rate;
+
+            float *dst          = k->kernel;
+            cqt_bin_t b;
+
+            for (size_t i=0; i<bins; ++i)
+            {
+                cqt_bin(&b, rank, q, f * pow(2.0, double(i) / bins_per_octave));
+
+                k->band[i*2]        = b.first;
+                k->band[i*2 + 1]    = b.count;
+                k->freqs[i]         = b.freq * sample_rate;
+
+                for (size_t j=0; j<b.count; ++j, dst += 2)
+                    cqt_kernel_element(dst, &b, rank, b.first + j);
+            }
+
+            return true;
+        }
+
+        bool cqt_kernel_match(const dsp::cqt_kernel_t *k, size_t rank, size_t bins_per_octave, size_t sample_rate, float fmin)
+        {
+            if ((k->rank != rank) || (k->bins_per_octave != bins_per_octave) || (k->sample_rate != sample_rate))
+                return false;
+
+            const double f  = cqt_lowest(rank, bins_per_octave, sample_rate, fmin);
+            return (f > 0.0) && (k->fmin == float(f * sample_rate));
+        }
+
+        void cqt_process(const dsp::cqt_kernel_t *k, float *dst, const float *src, float *tmp)
+        {
+            dsp::packed_real_direct_fft(tmp, src, k->rank);
+            dsp::cqt_kernel_apply(dst, tmp, k->kernel, k->band, k->bins);
+        }
+    } /* namespace generic */
+} /* namespace lsp */
+
+#undef CQT_KERNEL_WIDTH
+
+#endif /* PRIVATE_DSP_ARCH_GENERIC_CQT_H_ */
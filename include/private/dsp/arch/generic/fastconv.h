@@ -1092,6 +1092,82 @@ namespace lsp
             // Do reverse FFT transformation
             fastconv_restore_internal(dst, tmp, rank);
         }
+
+        void fastconv_mac_n(float *dst, const float * const *spectra, const float * const *kernels, size_t n, size_t rank)
+        {
+            size_t items    = size_t(1) << (rank + 1);
+            float rx[4], ix[4];
+
+            // The partitions are processed by groups of 8 to keep the number of data
+            // streams low, the first group stores the result, the next groups add it
+            size_t g        = 0;
+            do
+            {
+                const size_t count  = lsp_min(n - g, size_t(8));
+                float *d            = dst;
+
+                // All complex numbers are stored in the following format:
+                // [r0 r1 r2 r3 i0 i1 i2 i3  r4 r5 r6 r7 i4 i5 i6 i7  ... ]
+                for (size_t off=0; off<items; off += 8)
+                {
+                    if (g > 0)
+                    {
+                        rx[0]       = d[0];
+                        rx[1]       = d[1];
+                        rx[2]       = d[2];
+                        rx[3]       = d[3];
+
+                        ix[0]       = d[4];
+                        ix[1]       = d[5];
+                        ix[2]       = d[6];
+                        ix[3]       = d[7];
+                    }
+                    else
+                    {
+                        rx[0]       = 0.0f;
+                        rx[1]       = 0.0f;
+                        rx[2]       = 0.0f;
+                        rx[3]       = 0.0f;
+
+                        ix[0]       = 0.0f;
+                        ix[1]       = 0.0f;
+                        ix[2]       = 0.0f;
+                        ix[3]       = 0.0f;
+                    }
+
+                    // Accumulate products of the group of partitions for the block
+                    for (size_t i=g; i<g+count; ++i)
+                    {
+                        const float *c1     = &spectra[i][off];
+                        const float *c2     = &kernels[i][off];
+
+                        rx[0]      += c1[0]*c2[0] - c1[4]*c2[4];
+                        rx[1]      += c1[1]*c2[1] - c1[5]*c2[5];
+                        rx[2]      += c1[2]*c2[2] - c1[6]*c2[6];
+                        rx[3]      += c1[3]*c2[3] - c1[7]*c2[7];
+
+                        ix[0]      += c1[0]*c2[4] + c1[4]*c2[0];
+                        ix[1]      += c1[1]*c2[5] + c1[5]*c2[1];
+                        ix[2]      += c1[2]*c2[6] + c1[6]*c2[2];
+                        ix[3]      += c1[3]*c2[7] + c1[7]*c2[3];
+                    }
+
+                    d[0]        = rx[0];
+                    d[1]        = rx[1];
+                    d[2]        = rx[2];
+                    d[3]        = rx[3];
+
+                    d[4]        = ix[0];
+                    d[5]        = ix[1];
+                    d[6]        = ix[2];
+                    d[7]        = ix[3];
+
+                    d          += 8;
+                }
+
+                g          += 8;
+            } while (g < n);
+        }
     }
 }
 
@@ -90,6 +90,58 @@ namespace lsp
             0.0000000000000000f, 0.0000479368996031f, 0.0000958737990960f, 0.0001438106983686f
         };
 
+        /**
+         * Number of butterfly stages covered by XFFT_A_RE, XFFT_A_IM and XFFT_DW tables
+         */
+        static constexpr size_t XFFT_STAGES     = sizeof(XFFT_A_RE) / (sizeof(float) * 4);
+
+        /**
+         * Compute the initial twiddle factors and the rotation step of the butterfly stage
+         * which is not covered by the precomputed tables
+         *
+         * @param a_re real part of initial twiddle factors, 4 elements
+         * @param a_im imaginary part of initial twiddle factors, 4 elements
+         * @param dw rotation step, 2 elements
+         * @param stage the butterfly stage, stage 0 operates 4 pairs of complex numbers
+         */
+        static void fft_stage_twiddle(float *a_re, float *a_im, float *dw, size_t stage)
+        {
+            double k        = M_PI / double(size_t(4) << stage);
+
+            for (size_t i=0; i<4; ++i)
+            {
+                a_re[i]         = cos(k * i);
+                a_im[i]         = sin(k * i);
+            }
+            dw[0]           = cos(k * 4.0);
+            dw[1]           = sin(k * 4.0);
+        }
+
+        /**
+         * Switch twiddle factors to the next butterfly stage
+         *
+         * @param iw_re pointer to real part of initial twiddle factors
+         * @param iw_im pointer to imaginary part of initial twiddle factors
+         * @param dw pointer to rotation step
+         * @param xw buffer of 10 elements to store computed twiddle factors
+         * @param stage the new butterfly stage
+         */
+        static inline void fft_next_stage(const float * &iw_re, const float * &iw_im, const float * &dw, float *xw, size_t stage)
+        {
+            if (stage < XFFT_STAGES)
+            {
+                iw_re          += 4;
+                iw_im          += 4;
+                dw             += 2;
+                return;
+            }
+
+            fft_stage_twiddle(&xw[0], &xw[4], &xw[8], stage);
+            iw_re           = &xw[0];
+            iw_im           = &xw[4];
+            dw              = &xw[8];
+        }
+
         void normalize_fft3(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
         {
             rank            = 1 << rank;
@@ -511,7 +563,8 @@ namespace lsp
             // Prepare for butterflies
             size_t items    = 1 << rank;
 
-            float c_re[4], c_im[4], w_re[4], w_im[4];
+            float c_re[4], c_im[4], w_re[4], w_im[4], xw[10];
+            size_t stage        = 0;
             const float *dw     = XFFT_DW;
             const float *iw_re  = XFFT_A_RE;
             const float *iw_im  = XFFT_A_IM;
@@ -604,9 +657,7 @@ namespace lsp
                     }
                 }
 
-                dw     += 2;
-                iw_re  += 4;
-                iw_im  += 4;
+                fft_next_stage(iw_re, iw_im, dw, xw, ++stage);
             }
         }
 
@@ -643,7 +694,8 @@ namespace lsp
             // Prepare for butterflies
             size_t items    = size_t(1) << (rank + 1);
 
-            float c_re[4], c_im[4], w_re[4], w_im[4];
+            float c_re[4], c_im[4], w_re[4], w_im[4], xw[10];
+            size_t stage        = 0;
             const float *dw     = XFFT_DW;
             const float *iw_re  = XFFT_A_RE;
             const float *iw_im  = XFFT_A_IM;
@@ -732,9 +784,7 @@ namespace lsp
                     }
                 }
 
-                dw     += 2;
-                iw_re  += 4;
-                iw_im  += 4;
+                fft_next_stage(iw_re, iw_im, dw, xw, ++stage);
             }
 
             // Fixup complex number presentation
@@ -774,7 +824,8 @@ namespace lsp
             // Prepare for butterflies
             size_t items    = 1 << rank;
 
-            float c_re[4], c_im[4], w_re[4], w_im[4];
+            float c_re[4], c_im[4], w_re[4], w_im[4], xw[10];
+            size_t stage        = 0;
             const float *dw     = XFFT_DW;
             const float *iw_re  = XFFT_A_RE;
             const float *iw_im  = XFFT_A_IM;
@@ -867,9 +918,7 @@ namespace lsp
                     }
                 }
 
-                dw     += 2;
-                iw_re  += 4;
-                iw_im  += 4;
+                fft_next_stage(iw_re, iw_im, dw, xw, ++stage);
             }
 
             // Update amplitudes
@@ -909,7 +958,8 @@ namespace lsp
             // Prepare for butterflies
             size_t items    = size_t(1) << (rank + 1);
 
-            float c_re[4], c_im[4], w_re[4], w_im[4];
+            float c_re[4], c_im[4], w_re[4], w_im[4], xw[10];
+            size_t stage        = 0;
             const float *dw     = XFFT_DW;
             const float *iw_re  = XFFT_A_RE;
             const float *iw_im  = XFFT_A_IM;
@@ -998,15 +1048,35 @@ namespace lsp
                     }
                 }
 
-                dw     += 2;
-                iw_re  += 4;
-                iw_im  += 4;
+                fft_next_stage(iw_re, iw_im, dw, xw, ++stage);
             }
 
             // Update amplitudes
             repack_normalize_fft(dst, rank);
         }
 
+        void packed_direct_fft_windowed(float *dst, const float *src, const float *window, size_t rank)
+        {
+            for (size_t i=0, n=1 << rank; i<n; ++i)
+            {
+                dst[i*2]        = src[i*2] * window[i];
+                dst[i*2 + 1]    = src[i*2 + 1] * window[i];
+            }
+
+            dsp::packed_direct_fft(dst, dst, rank);
+        }
+
+        void packed_reverse_fft_add(float *dst, float *src, const float *window, size_t rank)
+        {
+            dsp::packed_reverse_fft(src, src, rank);
+
+            for (size_t i=0, n=1 << rank; i<n; ++i)
+            {
+                dst[i*2]       += src[i*2] * window[i];
+                dst[i*2 + 1]   += src[i*2 + 1] * window[i];
+            }
+        }
+
         static void center_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
         {
             if (rank == 0)
@@ -0,0 +1,312 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_FFT64_H_
+#define PRIVATE_DSP_ARCH_GENERIC_FFT64_H_
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_GENERIC_IMPL */
+
+namespace lsp
+{
+    namespace generic
+    {
+        /**
+         * Compute the initial twiddle factors and the rotation step of the butterfly
+         * stage in double precision. Since the rotation is performed in double precision,
+         * the accumulated error stays far below the precision of float even for large ranks.
+         *
+         * @param tw destination buffer: real parts of initial twiddle factors, imaginary parts
+         *   of initial twiddle factors and the rotation step, (lanes*2 + 2) elements
+         * @param n number of butterflies in the block
+         * @param lanes number of twiddle factors processed at once
+         */
+        static inline void fft64_stage_twiddle(double *tw, size_t n, size_t lanes)
+        {
+            const double k  = M_PI / double(n);
+
+            for (size_t i=0; i<lanes; ++i)
+            {
+                tw[i]           = cos(k * i);
+                tw[i + lanes]   = sin(k * i);
+            }
+            tw[lanes*2]     = cos(k * lanes);
+            tw[lanes*2 + 1] = sin(k * lanes);
+        }
+
+        static void fft64_scramble(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank)
+        {
+            const size_t items  = size_t(1) << rank;
+
+            if ((dst_re != src_re) && (dst_im != src_im))
+            {
+                for (size_t i=0; i<items; ++i)
+                {
+                    size_t j        = reverse_bits(uint32_t(i), rank);
+                    dst_re[i]       = src_re[j];
+                    dst_im[i]       = src_im[j];
+                }
+                return;
+            }
+
+            // Copy data first and then perform swaps
+            for (size_t i=0; i<items; ++i)
+            {
+                dst_re[i]       = src_re[i];
+                dst_im[i]       = src_im[i];
+            }
+
+            for (size_t i=1; i<(items - 1); ++i)
+            {
+                size_t j        = reverse_bits(uint32_t(i), rank);
+                if (i >= j)
+                    continue;
+
+                double re       = dst_re[i];
+                double im       = dst_im[i];
+                dst_re[i]       = dst_re[j];
+                dst_im[i]       = dst_im[j];
+                dst_re[j]       = re;
+                dst_im[j]       = im;
+            }
+        }
+
+        /*
+         * The first two stages of the transform, operators select the direction:
+         *   s0' = s0 + s1
+         *   s1' = s0 - s1
+         *   s2' = s2 + s3
+         *   s3' = s2 - s3
+         *   s0'' = s0' + s2'
+         *   s1'' = s1' -+ j * s3'
+         *   s2'' = s0' - s2'
+         *   s3'' = s1' +- j * s3'
+         */
+        #define FFT64_START(name, op1, op2) \
+            static void name(double *dst_re, double *dst_im, size_t rank) \
+            { \
+                for (size_t i=0, n=size_t(1) << rank; i<n; i += 4) \
+                { \
+                    double s0_re    = dst_re[i+0] + dst_re[i+1]; \
+                    double s1_re    = dst_re[i+0] - dst_re[i+1]; \
+                    double s2_re    = dst_re[i+2] + dst_re[i+3]; \
+                    double s3_re    = dst_re[i+2] - dst_re[i+3]; \
+                    \
+                    double s0_im    = dst_im[i+0] + dst_im[i+1]; \
+                    double s1_im    = dst_im[i+0] - dst_im[i+1]; \
+                    double s2_im    = dst_im[i+2] + dst_im[i+3]; \
+                    double s3_im    = dst_im[i+2] - dst_im[i+3]; \
+                    \
+                    dst_re[i+0]     = s0_re + s2_re; \
+                    dst_re[i+1]     = s1_re op1 s3_im; \
+                    dst_re[i+2]     = s0_re - s2_re; \
+                    dst_re[i+3]     = s1_re op2 s3_im; \
+                    \
+                    dst_im[i+0]     = s0_im + s2_im; \
+                    dst_im[i+1]     = s1_im op2 s3_re; \
+                    dst_im[i+2]     = s0_im - s2_im; \
+                    dst_im[i+3]     = s1_im op1 s3_re; \
+                } \
+            }
+
+        FFT64_START(fft64_start_direct, +, -)
+        FFT64_START(fft64_start_reverse, -, +)
+
+        #undef FFT64_START
+
+        /*
+         * Butterflies of one stage with twiddle factors kept in double precision. The data
+         * is processed in the precision of 'type', the twiddle factors are converted to it
+         * before the multiplication. Operators select the direction:
+         *   c    = w * b
+         *   c_re = w_re * b_re +- w_im * b_im
+         *   c_im = w_re * b_im -+ w_im * b_re
+         *   a'   = a + c
+         *   b'   = a - c
+         */
+        #define FFT64_BUTTERFLY(name, type, op1, op2) \
+            static void name(type *dst_re, type *dst_im, const double *tw, size_t n, size_t items) \
+            { \
+                double w_re[4], w_im[4]; \
+                \
+                for (size_t p=0; p<items; p += (n << 1)) \
+                { \
+                    type *a_re          = &dst_re[p]; \
+                    type *a_im          = &dst_im[p]; \
+                    type *b_re          = &a_re[n]; \
+                    type *b_im          = &a_im[n]; \
+                    \
+                    for (size_t i=0; i<4; ++i) \
+                    { \
+                        w_re[i]             = tw[i]; \
+                        w_im[i]             = tw[i + 4]; \
+                    } \
+                    \
+                    for (size_t k=0; ;) \
+                    { \
+                        for (size_t i=0; i<4; ++i) \
+                        { \
+                            type xw_re          = type(w_re[i]); \
+                            type xw_im          = type(w_im[i]); \
+                            type c_re           = xw_re * b_re[i] op1 xw_im * b_im[i]; \
+                            type c_im           = xw_re * b_im[i] op2 xw_im * b_re[i]; \
+                            \
+                            b_re[i]             = a_re[i] - c_re; \
+                            b_im[i]             = a_im[i] - c_im; \
+                            a_re[i]             = a_re[i] + c_re; \
+                            a_im[i]             = a_im[i] + c_im; \
+                        } \
+                        \
+                        a_re               += 4; \
+                        a_im               += 4; \
+                        b_re               += 4; \
+                        b_im               += 4; \
+                        \
+                        if ((k += 4) >= n) \
+                            break; \
+                        \
+                        /* Rotate w vector */ \
+                        for (size_t i=0; i<4; ++i) \
+                        { \
+                            double r            = w_re[i]*tw[8] - w_im[i]*tw[9]; \
+                            w_im[i]             = w_re[i]*tw[9] + w_im[i]*tw[8]; \
+                            w_re[i]             = r; \
+                        } \
+                    } \
+                } \
+            }
+
+        FFT64_BUTTERFLY(fft64_butterfly_direct, double, +, -)
+        FFT64_BUTTERFLY(fft64_butterfly_reverse, double, -, +)
+        FFT64_BUTTERFLY(fft64_butterfly_direct_mp, float, +, -)
+        FFT64_BUTTERFLY(fft64_butterfly_reverse_mp, float, -, +)
+
+        #undef FFT64_BUTTERFLY
+
+        static bool fft64_small(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank, double k)
+        {
+            if (rank > 1)
+                return false;
+
+            if (rank == 1)
+            {
+                double s1_re    = src_re[1];
+                double s1_im    = src_im[1];
+                dst_re[1]       = (src_re[0] - s1_re) * k;
+                dst_im[1]       = (src_im[0] - s1_im) * k;
+                dst_re[0]       = (src_re[0] + s1_re) * k;
+                dst_im[0]       = (src_im[0] + s1_im) * k;
+            }
+            else
+            {
+                dst_re[0]       = src_re[0];
+                dst_im[0]       = src_im[0];
+            }
+
+            return true;
+        }
+
+        void direct_fft_f64(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank)
+        {
+            if (fft64_small(dst_re, dst_im, src_re, src_im, rank, 1.0))
+                return;
+
+            fft64_scramble(dst_re, dst_im, src_re, src_im, rank);
+            fft64_start_direct(dst_re, dst_im, rank);
+
+            double tw[10];
+            for (size_t n=4, items=size_t(1) << rank; n < items; n <<= 1)
+            {
+                fft64_stage_twiddle(tw, n, 4);
+                fft64_butterfly_direct(dst_re, dst_im, tw, n, items);
+            }
+        }
+
+        void reverse_fft_f64(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank)
+        {
+            if (fft64_small(dst_re, dst_im, src_re, src_im, rank, 0.5))
+                return;
+
+            fft64_scramble(dst_re, dst_im, src_re, src_im, rank);
+            fft64_start_reverse(dst_re, dst_im, rank);
+
+            double tw[10];
+            const size_t items  = size_t(1) << rank;
+            for (size_t n=4; n < items; n <<= 1)
+            {
+                fft64_stage_twiddle(tw, n, 4);
+                fft64_butterfly_reverse(dst_re, dst_im, tw, n, items);
+            }
+
+            // Update amplitudes
+            const double k      = 1.0 / double(items);
+            for (size_t i=0; i<items; ++i)
+            {
+                dst_re[i]          *= k;
+                dst_im[i]          *= k;
+            }
+        }
+
+        void direct_fft_mp(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
+        {
+            if (rank <= 2)
+            {
+                direct_fft(dst_re, dst_im, src_re, src_im, rank);
+                return;
+            }
+
+            scramble_fft(dst_re, dst_im, src_re, src_im, rank);
+            start_direct_fft(dst_re, dst_im, rank);
+
+            double tw[10];
+            for (size_t n=4, items=size_t(1) << rank; n < items; n <<= 1)
+            {
+                fft64_stage_twiddle(tw, n, 4);
+                fft64_butterfly_direct_mp(dst_re, dst_im, tw, n, items);
+            }
+        }
+
+        void reverse_fft_mp(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
+        {
+            if (rank <= 2)
+            {
+                reverse_fft(dst_re, dst_im, src_re, src_im, rank);
+                return;
+            }
+
+            scramble_fft(dst_re, dst_im, src_re, src_im, rank);
+            start_reverse_fft(dst_re, dst_im, rank);
+
+            double tw[10];
+            for (size_t n=4, items=size_t(1) << rank; n < items; n <<= 1)
+            {
+                fft64_stage_twiddle(tw, n, 4);
+                fft64_butterfly_reverse_mp(dst_re, dst_im, tw, n, items);
+            }
+
+            normalize_fft2(dst_re, dst_im, rank);
+        }
+    } /* namespace generic */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_GENERIC_FFT64_H_ */
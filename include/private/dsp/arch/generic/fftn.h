@@ -0,0 +1,444 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 7 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_FFTN_H_
+#define PRIVATE_DSP_ARCH_GENERIC_FFTN_H_
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_GENERIC_IMPL */
+
+namespace lsp
+{
+    namespace generic
+    {
+        /*
+         * The mixed-radix transform is computed with the Stockham auto-sort algorithm.
+         * Each stage of radix r reads r sequences of length m = k/r with stride s and
+         * writes the twiddled DFT of size r in the natural order, so no bit-reversal
+         * is required. The twiddle factor for the j-th output at position p of the
+         * stage is w^(s*p*j) where w = exp(-2*pi*i/N), so the single table of N
+         * factors serves all stages.
+         */
+        static inline size_t fftn_radix(size_t k)
+        {
+            if (!(k & 3))
+                return 4;
+            if (!(k & 1))
+                return 2;
+            if (!(k % 3))
+                return 3;
+            if (!(k % 5))
+                return 5;
+            if (!(k % 7))
+                return 7;
+            return 0;
+        }
+
+        static inline size_t fftn_align(size_t count)
+        {
+            return (count + 0x0f) & ~size_t(0x0f);
+        }
+
+        static size_t fftn_bluestein_rank(size_t count)
+        {
+            size_t k = count;
+            while (k > 1)
+            {
+                size_t r = fftn_radix(k);
+                if (r == 0)
+                    break;
+                k  /= r;
+            }
+            if (k <= 1)
+                return 0;
+
+            // The size of the cyclic convolution should be at least 2*N - 1
+            size_t rank = 0;
+            while ((size_t(1) << rank) < (count * 2 - 1))
+                ++rank;
+            return rank;
+        }
+
+        static inline void fftn_twiddle(float &re, float &im, const float *tw, size_t idx, float sg)
+        {
+            re          = tw[idx*2];
+            im          = tw[idx*2 + 1] * sg;
+        }
+
+        static void fftn_butterfly2(float *y, const float *x, const float *tw, size_t s, size_t m, float sg)
+        {
+            for (size_t p=0; p<m; ++p)
+            {
+                float wr, wi;
+                fftn_twiddle(wr, wi, tw, s*p, sg);
+
+                const float *a0 = &x[2*s*p];
+                const float *a1 = &x[2*s*(p + m)];
+                float *c0       = &y[2*s*(2*p)];
+                float *c1       = &c0[2*s];
+
+                for (size_t q=0; q<s*2; q += 2)
+                {
+                    float dr        = a0[q] - a1[q];
+                    float di        = a0[q+1] - a1[q+1];
+                    c0[q]           = a0[q] + a1[q];
+                    c0[q+1]         = a0[q+1] + a1[q+1];
+                    c1[q]           = dr*wr - di*wi;
+                    c1[q+1]         = dr*wi + di*wr;
+                }
+            }
+        }
+
+        static void fftn_butterfly3(float *y, const float *x, const float *tw, size_t s, size_t m, float sg)
+        {
+            const float ks  = sg * 0.866025403784438647f;   // sin(2*pi/3)
+
+            for (size_t p=0; p<m; ++p)
+            {
+                float w1r, w1i, w2r, w2i;
+                fftn_twiddle(w1r, w1i, tw, s*p, sg);
+                fftn_twiddle(w2r, w2i, tw, s*p*2, sg);
+
+                const float *a0 = &x[2*s*p];
+                const float *a1 = &x[2*s*(p + m)];
+                const float *a2 = &x[2*s*(p + 2*m)];
+                float *c0       = &y[2*s*(3*p)];
+                float *c1       = &c0[2*s];
+                float *c2       = &c1[2*s];
+
+                for (size_t q=0; q<s*2; q += 2)
+                {
+                    float tr        = a1[q] + a2[q];
+                    float ti        = a1[q+1] + a2[q+1];
+                    float ur        = a0[q] - 0.5f * tr;
+                    float ui        = a0[q+1] - 0.5f * ti;
+                    float vr        = ks * (a1[q] - a2[q]);
+                    float vi        = ks * (a1[q+1] - a2[q+1]);
+
+                    // c1 = u - i*v, c2 = u + i*v
+                    float r1        = ur + vi;
+                    float i1        = ui - vr;
+                    float r2        = ur - vi;
+                    float i2        = ui + vr;
+
+                    c0[q]           = a0[q] + tr;
+                    c0[q+1]         = a0[q+1] + ti;
+                    c1[q]           = r1*w1r - i1*w1i;
+                    c1[q+1]         = r1*w1i + i1*w1r;
+                    c2[q]           = r2*w2r - i2*w2i;
+                    c2[q+1]         = r2*w2i + i2*w2r;
+                }
+            }
+        }
+
+        static void fftn_butterfly4(float *y, const float *x, const float *tw, size_t s, size_t m, float sg)
+        {
+            for (size_t p=0; p<m; ++p)
+            {
+                float w1r, w1i, w2r, w2i, w3r, w3i;
+                fftn_twiddle(w1r, w1i, tw, s*p, sg);
+                fftn_twiddle(w2r, w2i, tw, s*p*2, sg);
+                fftn_twiddle(w3r, w3i, tw, s*p*3, sg);
+
+                const float *a0 = &x[2*s*p];
+                const float *a1 = &x[2*s*(p + m)];
+                const float *a2 = &x[2*s*(p + 2*m)];
+                const float *a3 = &x[2*s*(p + 3*m)];
+                float *c0       = &y[2*s*(4*p)];
+                float *c1       = &c0[2*s];
+                float *c2       = &c1[2*s];
+                float *c3       = &c2[2*s];
+
+                for (size_t q=0; q<s*2; q += 2)
+                {
+                    float s0r       = a0[q] + a2[q];
+                    float s0i       = a0[q+1] + a2[q+1];
+                    float d0r       = a0[q] - a2[q];
+                    float d0i       = a0[q+1] - a2[q+1];
+                    float s1r       = a1[q] + a3[q];
+                    float s1i       = a1[q+1] + a3[q+1];
+                    float d1r       = sg * (a1[q] - a3[q]);
+                    float d1i       = sg * (a1[q+1] - a3[q+1]);
+
+                    // c1 = d0 - i*d1, c2 = s0 - s1, c3 = d0 + i*d1
+                    float r1        = d0r + d1i;
+                    float i1        = d0i - d1r;
+                    float r2        = s0r - s1r;
+                    float i2        = s0i - s1i;
+                    float r3        = d0r - d1i;
+                    float i3        = d0i + d1r;
+
+                    c0[q]           = s0r + s1r;
+                    c0[q+1]         = s0i + s1i;
+                    c1[q]           = r1*w1r - i1*w1i;
+                    c1[q+1]         = r1*w1i + i1*w1r;
+                    c2[q]           = r2*w2r - i2*w2i;
+                    c2[q+1]         = r2*w2i + i2*w2r;
+                    c3[q]           = r3*w3r - i3*w3i;
+                    c3[q+1]         = r3*w3i + i3*w3r;
+                }
+            }
+        }
+
+        /*
+         * Butterfly of odd radix r = 2*h + 1:
+         *   c[j]     = a[0] + sum { cos(2*pi*j*k/r) * (a[k] + a[r-k]) } - i * sum { sin(2*pi*j*k/r) * (a[k] - a[r-k]) }
+         *   c[r-j]   = a[0] + sum { cos(2*pi*j*k/r) * (a[k] + a[r-k]) } + i * sum { sin(2*pi*j*k/r) * (a[k] - a[r-k]) }
+         * for j = 1..h, k = 1..h
+         */
+        static void fftn_butterfly_odd(float *y, const float *x, const float *tw, size_t r, size_t s, size_t m, float sg)
+        {
+            const size_t h  = r >> 1;
+            float kc[3][3], ks[3][3];
+            float sr[4], si[4], dr[4], di[4];
+            const float *a[7];
+            float *c[7];
+
+            for (size_t j=1; j<=h; ++j)
+                for (size_t k=1; k<=h; ++k)
+                {
+                    double ang          = (2.0 * M_PI * ((j * k) % r)) / r;
+                    kc[j-1][k-1]        = cos(ang);
+                    ks[j-1][k-1]        = sg * sin(ang);
+                }
+
+            for (size_t p=0; p<m; ++p)
+            {
+                for (size_t k=0; k<r; ++k)
+                {
+                    a[k]            = &x[2*s*(p + k*m)];
+                    c[k]            = &y[2*s*(r*p + k)];
+                }
+
+                for (size_t q=0; q<s*2; q += 2)
+                {
+                    float c0r       = a[0][q];
+                    float c0i       = a[0][q+1];
+                    for (size_t k=1; k<=h; ++k)
+                    {
+                        sr[k-1]         = a[k][q] + a[r-k][q];
+                        si[k-1]         = a[k][q+1] + a[r-k][q+1];
+                        dr[k-1]         = a[k][q] - a[r-k][q];
+                        di[k-1]         = a[k][q+1] - a[r-k][q+1];
+                        c0r            += sr[k-1];
+                        c0i            += si[k-1];
+                    }
+                    c[0][q]         = c0r;
+                    c[0][q+1]       = c0i;
+
+                    for (size_t j=1; j<=h; ++j)
+                    {
+                        float ur        = a[0][q];
+                        float ui        = a[0][q+1];
+                        float vr        = 0.0f;
+                        float vi        = 0.0f;
+                        for (size_t k=1; k<=h; ++k)
+                        {
+                            ur             += kc[j-1][k-1] * sr[k-1];
+                            ui             += kc[j-1][k-1] * si[k-1];
+                            vr             += ks[j-1][k-1] * dr[k-1];
+                            vi             += ks[j-1][k-1] * di[k-1];
+                        }
+
+                        // c[j] = u - i*v, c[r-j] = u + i*v
+                        float wr, wi;
+                        float xr        = ur + vi;
+                        float xi        = ui - vr;
+                        fftn_twiddle(wr, wi, tw, s*p*j, sg);
+                        c[j][q]         = xr*wr - xi*wi;
+                        c[j][q+1]       = xr*wi + xi*wr;
+
+                        xr              = ur - vi;
+                        xi              = ui + vr;
+                        fftn_twiddle(wr, wi, tw, s*p*(r-j), sg);
+                        c[r-j][q]       = xr*wr - xi*wi;
+                        c[r-j][q+1]     = xr*wi + xi*wr;
+                    }
+                }
+            }
+        }
+
+        static void fftn_mixed_radix(const dsp::fftn_t *plan, float *dst, const float *src, float sg)
+        {
+            const size_t n  = plan->count;
+            float *tmp      = plan->tmp;
+
+            // Compute the number of stages to make the last one write to the destination
+            size_t stages   = 0;
+            for (size_t k=n; k > 1; k /= fftn_radix(k))
+                ++stages;
+
+            if (stages == 0)
+            {
+                dst[0]          = src[0];
+                dst[1]          = src[1];
+                return;
+            }
+
+            float *y        = (stages & 1) ? dst : tmp;
+            const float *x  = src;
+            if (x == y)
+            {
+                dsp::copy(tmp, src, n*2);
+                x               = tmp;
+            }
+
+            for (size_t k=n, s=1; k > 1; )
+            {
+                size_t r        = fftn_radix(k);
+                size_t m        = k / r;
+
+                switch (r)
+                {
+                    case 4: fftn_butterfly4(y, x, plan->tw, s, m, sg); break;
+                    case 2: fftn_butterfly2(y, x, plan->tw, s, m, sg); break;
+                    case 3: fftn_butterfly3(y, x, plan->tw, s, m, sg); break;
+                    default: fftn_butterfly_odd(y, x, plan->tw, r, s, m, sg); break;
+                }
+
+                s              *= r;
+                k               = m;
+                x               = y;
+                y               = (y == dst) ? tmp : dst;
+            }
+        }
+
+        size_t fftn_buffer_size(size_t count)
+        {
+            size_t rank     = fftn_bluestein_rank(count);
+            if (rank == 0)
+                return fftn_align(count * 2) * 2;
+
+            return fftn_align(count * 2) + (4 << rank);
+        }
+
+        bool fftn_init(dsp::fftn_t *plan, float *buf, size_t count)
+        {
+            if (count == 0)
+                return false;
+
+            const size_t rank   = fftn_bluestein_rank(count);
+            plan->tw            = buf;
+            plan->count         = count;
+            plan->rank          = rank;
+
+            if (rank == 0)
+            {
+                plan->chirp         = NULL;
+                plan->tmp           = &buf[fftn_align(count * 2)];
+
+                const double k      = (2.0 * M_PI) / count;
+                for (size_t i=0; i<count; ++i)
+                {
+                    plan->tw[i*2]       = cos(k * i);
+                    plan->tw[i*2 + 1]   = -sin(k * i);
+                }
+
+                return true;
+            }
+
+            // Bluestein algorithm: X[k] = w[k] * sum { (x[n] * w[n]) * conj(w[k-n]) }, w[n] = exp(-i*pi*n^2/N),
+            // the sum is computed as the cyclic convolution of size 2^rank
+            const size_t m      = 1 << rank;
+            plan->chirp         = &buf[fftn_align(count * 2)];
+            plan->tmp           = &plan->chirp[m * 2];
+
+            const double k      = M_PI / count;
+            for (size_t i=0; i<count; ++i)
+            {
+                // Reduce n^2 modulo 2*N to keep the precision of the argument
+                double a            = k * double((i * i) % (count * 2));
+                plan->tw[i*2]       = cos(a);
+                plan->tw[i*2 + 1]   = -sin(a);
+            }
+
+            dsp::fill_zero(plan->chirp, m * 2);
+            plan->chirp[0]      = 1.0f;
+            for (size_t i=1; i<count; ++i)
+            {
+                plan->chirp[i*2]            = plan->tw[i*2];
+                plan->chirp[i*2 + 1]        = -plan->tw[i*2 + 1];
+                plan->chirp[(m-i)*2]        = plan->tw[i*2];
+                plan->chirp[(m-i)*2 + 1]    = -plan->tw[i*2 + 1];
+            }
+            dsp::packed_direct_fft(plan->chirp, plan->chirp, rank);
+
+            return true;
+        }
+
+        void fftn_direct(const dsp::fftn_t *plan, float *dst, const float *src)
+        {
+            if (plan->rank == 0)
+            {
+                fftn_mixed_radix(plan, dst, src, 1.0f);
+                return;
+            }
+
+            const size_t n  = plan->count;
+            float *tmp      = plan->tmp;
+
+            dsp::pcomplex_mul3(tmp, src, plan->tw, n);
+            dsp::fill_zero(&tmp[n*2], ((1 << plan->rank) - n) * 2);
+            dsp::packed_direct_fft(tmp, tmp, plan->rank);
+            dsp::pcomplex_mul2(tmp, plan->chirp, 1 << plan->rank);
+            dsp::packed_reverse_fft(tmp, tmp, plan->rank);
+            dsp::pcomplex_mul3(dst, tmp, plan->tw, n);
+        }
+
+        void fftn_reverse(const dsp::fftn_t *plan, float *dst, const float *src)
+        {
+            const size_t n  = plan->count;
+            const float k   = 1.0f / n;
+
+            if (plan->rank == 0)
+            {
+                fftn_mixed_radix(plan, dst, src, -1.0f);
+                dsp::mul_k2(dst, k, n*2);
+                return;
+            }
+
+            // The reverse transform is computed as conj(fft(conj(x))) / N
+            float *tmp      = plan->tmp;
+            const float *tw = plan->tw;
+
+            for (size_t i=0; i<n*2; i += 2)
+            {
+                tmp[i]          = src[i]*tw[i] + src[i+1]*tw[i+1];
+                tmp[i+1]        = src[i]*tw[i+1] - src[i+1]*tw[i];
+            }
+            dsp::fill_zero(&tmp[n*2], ((1 << plan->rank) - n) * 2);
+            dsp::packed_direct_fft(tmp, tmp, plan->rank);
+            dsp::pcomplex_mul2(tmp, plan->chirp, 1 << plan->rank);
+            dsp::packed_reverse_fft(tmp, tmp, plan->rank);
+
+            for (size_t i=0; i<n*2; i += 2)
+            {
+                float re        = tmp[i]*tw[i] - tmp[i+1]*tw[i+1];
+                float im        = tmp[i]*tw[i+1] + tmp[i+1]*tw[i];
+                dst[i]          = re * k;
+                dst[i+1]        = -im * k;
+            }
+        }
+    } /* namespace generic */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_GENERIC_FFTN_H_ */
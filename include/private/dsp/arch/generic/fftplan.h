@@ -0,0 +1,372 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_FFTPLAN_H_
+#define PRIVATE_DSP_ARCH_GENERIC_FFTPLAN_H_
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_GENERIC_IMPL */
+
+/* Stages with less butterflies per block are computed by the scalar code */
+#define FFT_PLAN_VECTOR_MIN         8
+/* Number of complex elements processed at once by the stages that fit into the cache */
+#define FFT_PLAN_BLOCK              0x800
+/* Number of the lowest and the highest index bits which form the tile of the bit-reversal permutation */
+#define FFT_PLAN_SWAP_TILE          3
+
+namespace lsp
+{
+    namespace generic
+    {
+        /*
+         * The transform is computed by the decimation-in-time algorithm. After the
+         * bit-reversal permutation, the first two stages are computed as the radix-4
+         * butterfly which does not need twiddle factors. Each next stage with m butterflies
+         * per block takes m twiddle factors w[k] = exp(-i*pi*k/m) from the table, the factors
+         * of the stage follow the factors of the previous stage. Stages with enough
+         * butterflies per block are computed with the SIMD-optimized complex multiplication
+         * and the add/subtract pair of the Mid/Side matrix conversion. The reverse transform
+         * of split complex data is the direct transform with swapped real and imaginary
+         * parts, the reverse transform of packed complex data conjugates the data.
+         */
+        static inline size_t fft_plan_twiddle_size(size_t rank)
+        {
+            return (rank >= 3) ? (size_t(2) << rank) - 8 : 0;
+        }
+
+        size_t fft_plan_buffer_size(size_t rank)
+        {
+            // The number of swapped pairs does not exceed (1 << (rank - 1))
+            return fft_plan_twiddle_size(rank) + (size_t(1) << rank);
+        }
+
+        bool fft_plan_init(dsp::fft_plan_t *plan, float *buf, size_t rank, bool packed)
+        {
+            if (rank > 31)
+                return false;
+
+            const size_t n  = size_t(1) << rank;
+            plan->tw        = buf;
+            plan->swap      = reinterpret_cast<uint32_t *>(&buf[fft_plan_twiddle_size(rank)]);
+            plan->nswap     = 0;
+            plan->rank      = rank;
+            plan->packed    = packed;
+
+            // Twiddle factors of stages
+            float *tw       = plan->tw;
+            for (size_t m=4; m < n; m <<= 1)
+            {
+                const double kw = M_PI / m;
+                for (size_t k=0; k<m; ++k)
+                {
+                    float w_re      = cos(kw * k);
+                    float w_im      = -sin(kw * k);
+                    if (packed)
+                    {
+                        tw[k*2]         = w_re;
+                        tw[k*2 + 1]     = w_im;
+                    }
+                    else
+                    {
+                        tw[k]           = w_re;
+                        tw[k + m]       = w_im;
+                    }
+                }
+                tw             += m * 2;
+            }
+
+            // Bit-reversal permutation. For large ranks the index is split into the
+            // [hi | mid | lo] bit fields and the pairs are enumerated for each 'mid' over
+            // all 'hi' and 'lo' values: both elements of each pair of the tile then fall
+            // into the small set of cache lines which are loaded only once.
+            uint32_t *sw    = plan->swap;
+            const size_t tb = (rank >= FFT_PLAN_SWAP_TILE * 2) ? FFT_PLAN_SWAP_TILE : 0;
+            const size_t mb = rank - tb * 2;
+            for (size_t mid=0; mid < (size_t(1) << mb); ++mid)
+                for (size_t hi=0; hi < (size_t(1) << tb); ++hi)
+                    for (size_t lo=0; lo < (size_t(1) << tb); ++lo)
+                    {
+                        size_t i        = (hi << (rank - tb)) | (mid << tb) | lo;
+                        size_t j        = reverse_bits(uint32_t(i), rank);
+                        if (i < j)
+                        {
+                            sw[0]           = uint32_t(i);
+                            sw[1]           = uint32_t(j);
+                            sw             += 2;
+                            ++plan->nswap;
+                        }
+                    }
+
+            return true;
+        }
+
+        size_t fft_plan_footprint(const dsp::fft_plan_t *plan)
+        {
+            return sizeof(dsp::fft_plan_t) +
+                fft_plan_twiddle_size(plan->rank) * sizeof(float) +
+                plan->nswap * 2 * sizeof(uint32_t);
+        }
+
+        static void fft_plan_split_start(float *re, float *im, size_t n)
+        {
+            for (size_t i=0; i<n; i += 4)
+            {
+                float s0_re     = re[i+0] + re[i+1];
+                float s1_re     = re[i+0] - re[i+1];
+                float s2_re     = re[i+2] + re[i+3];
+                float s3_re     = re[i+2] - re[i+3];
+                float s0_im     = im[i+0] + im[i+1];
+                float s1_im     = im[i+0] - im[i+1];
+                float s2_im     = im[i+2] + im[i+3];
+                float s3_im     = im[i+2] - im[i+3];
+
+                re[i+0]         = s0_re + s2_re;
+                re[i+1]         = s1_re + s3_im;
+                re[i+2]         = s0_re - s2_re;
+                re[i+3]         = s1_re - s3_im;
+                im[i+0]         = s0_im + s2_im;
+                im[i+1]         = s1_im - s3_re;
+                im[i+2]         = s0_im - s2_im;
+                im[i+3]         = s1_im + s3_re;
+            }
+        }
+
+        static void fft_plan_split_stages(const float *tw, float *re, float *im, size_t m, size_t n)
+        {
+            for ( ; m < n; m <<= 1)
+            {
+                const float *w_re   = &tw[m*2 - 8];
+                const float *w_im   = &w_re[m];
+
+                for (size_t off=0; off < n; off += m*2)
+                {
+                    float *a_re     = &re[off];
+                    float *a_im     = &im[off];
+                    float *b_re     = &a_re[m];
+                    float *b_im     = &a_im[m];
+
+                    if (m >= FFT_PLAN_VECTOR_MIN)
+                    {
+                        dsp::complex_mul3(b_re, b_im, b_re, b_im, w_re, w_im, m);
+                        dsp::ms_to_lr(a_re, b_re, a_re, b_re, m);
+                        dsp::ms_to_lr(a_im, b_im, a_im, b_im, m);
+                        continue;
+                    }
+
+                    for (size_t k=0; k<m; ++k)
+                    {
+                        float c_re      = b_re[k] * w_re[k] - b_im[k] * w_im[k];
+                        float c_im      = b_re[k] * w_im[k] + b_im[k] * w_re[k];
+                        b_re[k]         = a_re[k] - c_re;
+                        b_im[k]         = a_im[k] - c_im;
+                        a_re[k]        += c_re;
+                        a_im[k]        += c_im;
+                    }
+                }
+            }
+        }
+
+        static void fft_plan_split_transform(const dsp::fft_plan_t *plan, float *re, float *im)
+        {
+            const size_t n  = size_t(1) << plan->rank;
+            if (n < 2)
+                return;
+
+            // Bit-reversal permutation
+            const uint32_t *sw  = plan->swap;
+            for (size_t i=0; i<plan->nswap; ++i, sw += 2)
+            {
+                const size_t a  = sw[0];
+                const size_t b  = sw[1];
+                float t         = re[a];
+                re[a]           = re[b];
+                re[b]           = t;
+                t               = im[a];
+                im[a]           = im[b];
+                im[b]           = t;
+            }
+
+            if (n < 4)
+            {
+                float t         = re[0];
+                re[0]           = t + re[1];
+                re[1]           = t - re[1];
+                t               = im[0];
+                im[0]           = t + im[1];
+                im[1]           = t - im[1];
+                return;
+            }
+
+            // Stages that fit into the cache are computed block by block,
+            // then other stages are computed for the whole data
+            const size_t len    = lsp_min(n, size_t(FFT_PLAN_BLOCK));
+            for (size_t off=0; off < n; off += len)
+            {
+                fft_plan_split_start(&re[off], &im[off], len);
+                fft_plan_split_stages(plan->tw, &re[off], &im[off], 4, len);
+            }
+            fft_plan_split_stages(plan->tw, re, im, len, n);
+        }
+
+        static void fft_plan_packed_start(float *data, size_t n, float conj)
+        {
+            for (size_t i=0; i<n*2; i += 8)
+            {
+                float *d        = &data[i];
+                float s0_re     = d[0] + d[2];
+                float s1_re     = d[0] - d[2];
+                float s2_re     = d[4] + d[6];
+                float s3_re     = d[4] - d[6];
+                float s0_im     = (d[1] + d[3]) * conj;
+                float s1_im     = (d[1] - d[3]) * conj;
+                float s2_im     = (d[5] + d[7]) * conj;
+                float s3_im     = (d[5] - d[7]) * conj;
+
+                d[0]            = s0_re + s2_re;
+                d[1]            = s0_im + s2_im;
+                d[2]            = s1_re + s3_im;
+                d[3]            = s1_im - s3_re;
+                d[4]            = s0_re - s2_re;
+                d[5]            = s0_im - s2_im;
+                d[6]            = s1_re - s3_im;
+                d[7]            = s1_im + s3_re;
+            }
+        }
+
+        static void fft_plan_packed_stages(const float *tw, float *data, size_t m, size_t n)
+        {
+            for ( ; m < n; m <<= 1)
+            {
+                const float *w  = &tw[m*2 - 8];
+
+                for (size_t off=0; off < n*2; off += m*4)
+                {
+                    float *a        = &data[off];
+                    float *b        = &a[m*2];
+
+                    if (m >= FFT_PLAN_VECTOR_MIN)
+                    {
+                        dsp::pcomplex_mul3(b, b, w, m);
+                        dsp::ms_to_lr(a, b, a, b, m*2);
+                        continue;
+                    }
+
+                    for (size_t k=0; k<m*2; k += 2)
+                    {
+                        float c_re      = b[k] * w[k] - b[k+1] * w[k+1];
+                        float c_im      = b[k] * w[k+1] + b[k+1] * w[k];
+                        b[k]            = a[k] - c_re;
+                        b[k+1]          = a[k+1] - c_im;
+                        a[k]           += c_re;
+                        a[k+1]         += c_im;
+                    }
+                }
+            }
+        }
+
+        static void fft_plan_packed_transform(const dsp::fft_plan_t *plan, float *data, float conj)
+        {
+            const size_t n  = size_t(1) << plan->rank;
+
+            // Bit-reversal permutation
+            const uint32_t *sw  = plan->swap;
+            for (size_t i=0; i<plan->nswap; ++i, sw += 2)
+            {
+                float *a        = &data[sw[0] * 2];
+                float *b        = &data[sw[1] * 2];
+                float t_re      = a[0];
+                float t_im      = a[1];
+                a[0]            = b[0];
+                a[1]            = b[1];
+                b[0]            = t_re;
+                b[1]            = t_im;
+            }
+
+            if (n < 4)
+            {
+                if (n < 2)
+                {
+                    data[1]        *= conj;
+                    return;
+                }
+
+                float t         = data[0];
+                data[0]         = t + data[2];
+                data[2]         = t - data[2];
+                t               = data[1];
+                data[1]         = (t + data[3]) * conj;
+                data[3]         = (t - data[3]) * conj;
+                return;
+            }
+
+            // Stages that fit into the cache are computed block by block, the
+            // conjugation of the input is applied by the first two stages
+            const size_t len    = lsp_min(n, size_t(FFT_PLAN_BLOCK));
+            for (size_t off=0; off < n*2; off += len*2)
+            {
+                fft_plan_packed_start(&data[off], len, conj);
+                fft_plan_packed_stages(plan->tw, &data[off], 4, len);
+            }
+            fft_plan_packed_stages(plan->tw, data, len, n);
+        }
+
+        void fft_plan_direct(const dsp::fft_plan_t *plan, float *re, float *im)
+        {
+            fft_plan_split_transform(plan, re, im);
+        }
+
+        void fft_plan_reverse(const dsp::fft_plan_t *plan, float *re, float *im)
+        {
+            const size_t n  = size_t(1) << plan->rank;
+            const float k   = 1.0f / n;
+
+            fft_plan_split_transform(plan, im, re);
+            dsp::mul_k2(re, k, n);
+            dsp::mul_k2(im, k, n);
+        }
+
+        void fft_plan_packed_direct(const dsp::fft_plan_t *plan, float *data)
+        {
+            fft_plan_packed_transform(plan, data, 1.0f);
+        }
+
+        void fft_plan_packed_reverse(const dsp::fft_plan_t *plan, float *data)
+        {
+            const size_t n  = size_t(1) << plan->rank;
+            const float k   = 1.0f / n;
+
+            fft_plan_packed_transform(plan, data, -1.0f);
+            for (size_t i=0; i<n*2; i += 2)
+            {
+                data[i]        *= k;
+                data[i+1]      *= -k;
+            }
+        }
+    } /* namespace generic */
+} /* namespace lsp */
+
+#undef FFT_PLAN_VECTOR_MIN
+#undef FFT_PLAN_BLOCK
+#undef FFT_PLAN_SWAP_TILE
+
+#endif /* PRIVATE_DSP_ARCH_GENERIC_FFTPLAN_H_ */
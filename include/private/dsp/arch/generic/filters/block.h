@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 10 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_FILTERS_BLOCK_H_
+#define PRIVATE_DSP_ARCH_GENERIC_FILTERS_BLOCK_H_
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_GENERIC_IMPL */
+
+namespace lsp
+{
+    namespace generic
+    {
+        void biquad_block_init(dsp::biquad_block_t *dst, const dsp::biquad_x1_t *src, size_t n)
+        {
+            for (size_t i=0; i<n; ++i, ++dst, ++src)
+            {
+                // Compute matrices in double precision to not to accumulate the rounding error
+                const double a1 = src->a1, a2 = src->a2;
+                const double b0 = src->b0;
+                const double v0 = src->b1 + a1 * b0;    // B[0]
+                const double v1 = src->b2 + a2 * b0;    // B[1]
+                double h[LSP_DSP_BIQUAD_BLOCK_SIZE];
+                double m00 = 1.0, m01 = 0.0, m10 = 0.0, m11 = 1.0; // A^k, k = 0
+
+                h[0]                = b0;
+                for (size_t k=0; k<LSP_DSP_BIQUAD_BLOCK_SIZE; ++k)
+                {
+                    // C*A^k
+                    dst->p[0][k]        = m00;
+                    dst->p[1][k]        = m01;
+
+                    // A^k*B
+                    const double q0     = m00 * v0 + m01 * v1;
+                    const double q1     = m10 * v0 + m11 * v1;
+                    float *q            = dst->q[LSP_DSP_BIQUAD_BLOCK_SIZE - 1 - k];
+                    for (size_t l=0; l<8; l += 2)
+                    {
+                        q[l]                = q0;
+                        q[l+1]              = q1;
+                    }
+                    if ((k + 1) < LSP_DSP_BIQUAD_BLOCK_SIZE)
+                        h[k + 1]            = q0;
+
+                    // A^(k+1) = A * A^k
+                    const double t00    = a1 * m00 + m10;
+                    const double t01    = a1 * m01 + m11;
+                    m10                 = a2 * m00;
+                    m11                 = a2 * m01;
+                    m00                 = t00;
+                    m01                 = t01;
+                }
+
+                // A^N
+                for (size_t l=0; l<8; l += 2)
+                {
+                    dst->a[0][l]        = m00;
+                    dst->a[0][l+1]      = m10;
+                    dst->a[1][l]        = m01;
+                    dst->a[1][l+1]      = m11;
+                }
+
+                // Lower-triangular Toeplitz matrix of the impulse response
+                for (size_t j=0; j<LSP_DSP_BIQUAD_BLOCK_SIZE; ++j)
+                    for (size_t k=0; k<LSP_DSP_BIQUAD_BLOCK_SIZE; ++k)
+                        dst->h[j][k]        = (k >= j) ? h[k - j] : 0.0f;
+
+                for (size_t l=0; l<8; ++l)
+                    dst->d[l]           = 0.0f;
+                dst->x1             = *src;
+            }
+        }
+
+        void biquad_block_process(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n)
+        {
+            for (size_t i=0; i<n; ++i, ++f)
+            {
+                const float *s  = src;
+                float *r        = dst;
+                float x0        = f->d[0];
+                float x1        = f->d[1];
+                size_t k        = count;
+
+                // Process full blocks
+                for ( ; k >= LSP_DSP_BIQUAD_BLOCK_SIZE; k -= LSP_DSP_BIQUAD_BLOCK_SIZE)
+                {
+                    float y[LSP_DSP_BIQUAD_BLOCK_SIZE];
+                    float z0        = f->a[0][0]*x0 + f->a[1][0]*x1;
+                    float z1        = f->a[0][1]*x0 + f->a[1][1]*x1;
+
+                    for (size_t l=0; l<LSP_DSP_BIQUAD_BLOCK_SIZE; ++l)
+                        y[l]            = f->p[0][l]*x0 + f->p[1][l]*x1;
+
+                    for (size_t j=0; j<LSP_DSP_BIQUAD_BLOCK_SIZE; ++j)
+                    {
+                        const float v   = s[j];
+                        for (size_t l=0; l<LSP_DSP_BIQUAD_BLOCK_SIZE; ++l)
+                            y[l]           += f->h[j][l] * v;
+                        z0             += f->q[j][0] * v;
+                        z1             += f->q[j][1] * v;
+                    }
+
+                    for (size_t l=0; l<LSP_DSP_BIQUAD_BLOCK_SIZE; ++l)
+                        r[l]            = y[l];
+
+                    x0              = z0;
+                    x1              = z1;
+                    s              += LSP_DSP_BIQUAD_BLOCK_SIZE;
+                    r              += LSP_DSP_BIQUAD_BLOCK_SIZE;
+                }
+
+                // Process the tail
+                for ( ; k > 0; --k)
+                {
+                    float v         = *(s++);
+                    float s2        = f->x1.b0*v + x0;
+                    float p1        = f->x1.b1*v + f->x1.a1*s2;
+                    float p2        = f->x1.b2*v + f->x1.a2*s2;
+
+                    *(r++)          = s2;
+                    x0              = x1 + p1;
+                    x1              = p2;
+                }
+
+                for (size_t l=0; l<8; l += 2)
+                {
+                    f->d[l]         = x0;
+                    f->d[l+1]       = x1;
+                }
+
+                // Next filters in the chain are applied to the destination buffer
+                src             = dst;
+            }
+        }
+    } /* namespace generic */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_GENERIC_FILTERS_BLOCK_H_ */
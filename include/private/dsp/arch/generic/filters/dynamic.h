@@ -401,6 +401,182 @@ namespace lsp
                 d          += 4;   // Shift memory pointer by 4 floats
             }
         }
+
+        void dyn_biquad_process_x16(float *dst, const float *src, float *d, size_t count, const biquad_x16_t *f)
+        {
+            // The generic code processes the cascades one by one, the data of
+            // the next cascade is taken from the destination buffer. The j'th
+            // cascade takes the coefficients for the i'th sample from the (i+j)'th
+            // filter bank of the matrix
+            const float *sp = src;
+
+            for (size_t j=0; j<16; ++j)
+            {
+                const biquad_x16_t *bq  = &f[j];
+                float d0        = d[j], d1 = d[j + 16];
+
+                for (size_t i=0; i<count; ++i, ++bq)
+                {
+                    float s     = sp[i];
+                    float s2    = bq->b0[j]*s + d0;
+                    float p1    = bq->b1[j]*s + bq->a1[j]*s2;
+                    float p2    = bq->b2[j]*s + bq->a2[j]*s2;
+
+                    dst[i]      = s2;
+
+                    // Shift buffer
+                    d0          = d1 + p1;
+                    d1          = p2;
+                }
+
+                d[j]        = d0;
+                d[j + 16]   = d1;
+                sp          = dst;
+            }
+        }
+
+        /*
+         * Fill the matrix of dynamic filters for the chunk of the ramp. The ramp is
+         * applied to all filters of the bank in the pipeline, so the j'th filter in the
+         * row r processes the sample (first + r - j) of the ramp. Filters that do not
+         * process any sample of the ramp in the row are clamped to the start or end filter.
+         */
+        static inline void ramp_biquad_interpolate(float *dst, const float *start, const float *end,
+            size_t lanes, size_t stride, size_t rows, size_t first, size_t count)
+        {
+            float delta[16*5], kd[16], t[16];
+            const size_t n  = lanes * 5;
+            const float k   = 1.0f / count;
+
+            for (size_t c=0; c<n; ++c)
+                delta[c]        = end[c] - start[c];
+            for (size_t j=0; j<lanes; ++j)
+                kd[j]           = j * k;
+
+            for (size_t r=0; r<rows; ++r, dst += stride)
+            {
+                const float v   = (first + r) * k;
+                for (size_t j=0; j<lanes; ++j)
+                    t[j]            = lsp_limit(v - kd[j], 0.0f, 1.0f);
+                for (size_t c=0; c<n; c += lanes)
+                    for (size_t j=0; j<lanes; ++j)
+                        dst[c + j]      = start[c + j] + delta[c + j] * t[j];
+                for (size_t c=n; c<stride; ++c)
+                    dst[c]          = 0.0f;
+            }
+        }
+
+        void ramp_biquad_process_x1(float *dst, const float *src, float *d, size_t count, const biquad_x1_t *start, const biquad_x1_t *end, biquad_x1_t *f)
+        {
+            for (size_t off=0; off<count; )
+            {
+                size_t to_do    = lsp_min(count - off, size_t(LSP_DSP_RAMP_BIQUAD_CHUNK));
+                ramp_biquad_interpolate(&f->b0, &start->b0, &end->b0, 1, sizeof(biquad_x1_t) / sizeof(float), to_do, off, count);
+                dsp::dyn_biquad_process_x1(&dst[off], &src[off], d, to_do, f);
+                off            += to_do;
+            }
+        }
+
+        void ramp_biquad_process_x2(float *dst, const float *src, float *d, size_t count, const biquad_x2_t *start, const biquad_x2_t *end, biquad_x2_t *f)
+        {
+            for (size_t off=0; off<count; )
+            {
+                size_t to_do    = lsp_min(count - off, size_t(LSP_DSP_RAMP_BIQUAD_CHUNK));
+                ramp_biquad_interpolate(f->b0, start->b0, end->b0, 2, sizeof(biquad_x2_t) / sizeof(float), to_do + 1, off, count);
+                dsp::dyn_biquad_process_x2(&dst[off], &src[off], d, to_do, f);
+                off            += to_do;
+            }
+        }
+
+        void ramp_biquad_process_x4(float *dst, const float *src, float *d, size_t count, const biquad_x4_t *start, const biquad_x4_t *end, biquad_x4_t *f)
+        {
+            for (size_t off=0; off<count; )
+            {
+                size_t to_do    = lsp_min(count - off, size_t(LSP_DSP_RAMP_BIQUAD_CHUNK));
+                ramp_biquad_interpolate(f->b0, start->b0, end->b0, 4, sizeof(biquad_x4_t) / sizeof(float), to_do + 3, off, count);
+                dsp::dyn_biquad_process_x4(&dst[off], &src[off], d, to_do, f);
+                off            += to_do;
+            }
+        }
+
+        void ramp_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const biquad_x8_t *start, const biquad_x8_t *end, biquad_x8_t *f)
+        {
+            for (size_t off=0; off<count; )
+            {
+                size_t to_do    = lsp_min(count - off, size_t(LSP_DSP_RAMP_BIQUAD_CHUNK));
+                ramp_biquad_interpolate(f->b0, start->b0, end->b0, 8, sizeof(biquad_x8_t) / sizeof(float), to_do + 7, off, count);
+                dsp::dyn_biquad_process_x8(&dst[off], &src[off], d, to_do, f);
+                off            += to_do;
+            }
+        }
+
+        void ramp_biquad_process_x16(float *dst, const float *src, float *d, size_t count, const biquad_x16_t *start, const biquad_x16_t *end, biquad_x16_t *f)
+        {
+            for (size_t off=0; off<count; )
+            {
+                size_t to_do    = lsp_min(count - off, size_t(LSP_DSP_RAMP_BIQUAD_CHUNK));
+                ramp_biquad_interpolate(f->b0, start->b0, end->b0, 16, sizeof(biquad_x16_t) / sizeof(float), to_do + 15, off, count);
+                dsp::dyn_biquad_process_x16(&dst[off], &src[off], d, to_do, f);
+                off            += to_do;
+            }
+        }
+
+        void dyn_bilinear_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const f_cascade_t *bc, const float *kf)
+        {
+            if (count <= 0)
+                return;
+
+            float s[8], s2[8];
+            float T0, T1, T2, B0, B1, B2, N, k, k2;
+            float b0, b1, b2, a1, a2, p1, p2;
+
+            for (size_t j=0; j<8; ++j)
+                s2[j]           = 0.0f;
+
+            // The j'th filter in the row r processes the (r - j)'th sample,
+            // coefficients are computed in place for active filters only
+            for (size_t r=0, rows=count + 7; r<rows; ++r, bc += 8)
+            {
+                size_t first    = (r >= count) ? r - count + 1 : 0;
+                size_t last     = lsp_min(r, size_t(7));
+
+                // Push sample and shift buffer
+                for (size_t j=7; j>0; --j)
+                    s[j]            = s2[j-1];
+                s[0]            = (r < count) ? src[r] : 0.0f;
+
+                k               = kf[r];
+                k2              = k * k;
+
+                for (size_t j=first; j<=last; ++j)
+                {
+                    // Bilinear transform of the cascade
+                    T0              = bc[j].t[0];
+                    T1              = bc[j].t[1]*k;
+                    T2              = bc[j].t[2]*k2;
+                    B0              = bc[j].b[0];
+                    B1              = bc[j].b[1]*k;
+                    B2              = bc[j].b[2]*k2;
+
+                    N               = 1.0 / (B0 + B1 + B2);
+                    b0              = (T0 + T1 + T2) * N;
+                    b1              = 2.0 * (T0 - T2) * N;
+                    b2              = (T0 - T1 + T2) * N;
+                    a1              = 2.0 * (B2 - B0) * N;  // Sign negated
+                    a2              = (B1 - B2 - B0) * N;   // Sign negated
+
+                    // Process the filter
+                    s2[j]           = b0*s[j] + d[j];
+                    p1              = b1*s[j] + a1*s2[j];
+                    p2              = b2*s[j] + a2*s2[j];
+                    d[j]            = d[j+8] + p1;
+                    d[j+8]          = p2;
+                }
+
+                if (r >= 7)
+                    dst[r - 7]      = s2[7];
+            }
+        }
     }
 }
 
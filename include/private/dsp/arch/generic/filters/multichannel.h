@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 7 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_FILTERS_MULTICHANNEL_H_
+#define PRIVATE_DSP_ARCH_GENERIC_FILTERS_MULTICHANNEL_H_
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_GENERIC_IMPL */
+
+namespace lsp
+{
+    namespace generic
+    {
+        /*
+         * Process interleaved channels, the filter bank contains 5 rows of 'lanes' coefficients
+         * and is applied to all channels of the frame at once
+         */
+        static void biquad_process_mc_interleaved(float *dst, const float *src, float *d, size_t count, const float *f, size_t lanes, size_t n)
+        {
+            for (size_t k=0; k<n; ++k, src = dst)
+            {
+                const float *b0 = &f[0];
+                const float *b1 = &b0[lanes];
+                const float *b2 = &b1[lanes];
+                const float *a1 = &b2[lanes];
+                const float *a2 = &a1[lanes];
+                float *d0       = &d[0];
+                float *d1       = &d0[lanes];
+
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float *s  = &src[i * lanes];
+                    float *r        = &dst[i * lanes];
+
+                    for (size_t j=0; j<lanes; ++j)
+                    {
+                        float x         = s[j];
+                        float s2        = b0[j]*x + d0[j];
+                        float p1        = b1[j]*x + a1[j]*s2;
+                        float p2        = b2[j]*x + a2[j]*s2;
+
+                        r[j]            = s2;
+
+                        // Shift buffer
+                        d0[j]           = d1[j] + p1;
+                        d1[j]           = p2;
+                    }
+                }
+
+                f              += lanes * 5;
+                d              += lanes * 2;
+            }
+        }
+
+        /*
+         * Process planar channels, each channel is processed by the j'th column of all filter banks
+         */
+        static void biquad_process_mc_planar(float * const *dst, const float * const *src, float *d, size_t count, const float *f, size_t lanes, size_t n)
+        {
+            for (size_t j=0; j<lanes; ++j)
+            {
+                float *r        = dst[j];
+                const float *s  = src[j];
+                const float *fk = &f[j];
+                float *dk       = &d[j];
+
+                for (size_t k=0; k<n; ++k, s = r)
+                {
+                    float b0 = fk[0], b1 = fk[lanes], b2 = fk[lanes*2], a1 = fk[lanes*3], a2 = fk[lanes*4];
+                    float d0 = dk[0], d1 = dk[lanes];
+
+                    for (size_t i=0; i<count; ++i)
+                    {
+                        float x         = s[i];
+                        float s2        = b0*x + d0;
+                        float p1        = b1*x + a1*s2;
+                        float p2        = b2*x + a2*s2;
+
+                        r[i]            = s2;
+
+                        // Shift buffer
+                        d0              = d1 + p1;
+                        d1              = p2;
+                    }
+
+                    dk[0]           = d0;
+                    dk[lanes]       = d1;
+                    fk             += lanes * 5;
+                    dk             += lanes * 2;
+                }
+            }
+        }
+
+        void biquad_process_mc4(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n)
+        {
+            biquad_process_mc_interleaved(dst, src, d, count, f->b0, 4, n);
+        }
+
+        void biquad_process_mc8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n)
+        {
+            biquad_process_mc_interleaved(dst, src, d, count, f->b0, 8, n);
+        }
+
+        void biquad_process_mc16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n)
+        {
+            biquad_process_mc_interleaved(dst, src, d, count, f->b0, 16, n);
+        }
+
+        void biquad_process_mc4_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n)
+        {
+            biquad_process_mc_planar(dst, src, d, count, f->b0, 4, n);
+        }
+
+        void biquad_process_mc8_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n)
+        {
+            biquad_process_mc_planar(dst, src, d, count, f->b0, 8, n);
+        }
+
+        void biquad_process_mc16_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n)
+        {
+            biquad_process_mc_planar(dst, src, d, count, f->b0, 16, n);
+        }
+    } /* namespace generic */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_GENERIC_FILTERS_MULTICHANNEL_H_ */
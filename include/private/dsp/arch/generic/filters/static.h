@@ -388,6 +388,39 @@ namespace lsp
                 d          += 4;
             }
         }
+
+        void biquad_process_x16(float *dst, const float *src, size_t count, biquad16_t *f)
+        {
+            // The generic code processes the cascades one by one, the data of
+            // the next cascade is taken from the destination buffer
+            const float *sp = src;
+            float *d        = f->d;
+
+            for (size_t j=0; j<16; ++j)
+            {
+                const float b0  = f->x16.b0[j], b1  = f->x16.b1[j], b2 = f->x16.b2[j];
+                const float a1  = f->x16.a1[j], a2  = f->x16.a2[j];
+                float d0        = d[j], d1 = d[j + 16];
+
+                for (size_t i=0; i<count; ++i)
+                {
+                    float s     = sp[i];
+                    float s2    = b0*s + d0;
+                    float p1    = b1*s + a1*s2;
+                    float p2    = b2*s + a2*s2;
+
+                    dst[i]      = s2;
+
+                    // Shift buffer
+                    d0          = d1 + p1;
+                    d1          = p2;
+                }
+
+                d[j]        = d0;
+                d[j + 16]   = d1;
+                sp          = dst;
+            }
+        }
     }
 }
 
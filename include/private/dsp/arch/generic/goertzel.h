@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_GOERTZEL_H_
+#define PRIVATE_DSP_ARCH_GENERIC_GOERTZEL_H_
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_GENERIC_IMPL */
+
+namespace lsp
+{
+    namespace generic
+    {
+        void goertzel_bank(float *state, const float *coef, const float *src, size_t bins, size_t count)
+        {
+            float *s1       = state;
+            float *s2       = &state[bins];
+
+            for (size_t i=0; i<bins; ++i)
+            {
+                float a         = s1[i];
+                float b         = s2[i];
+                const float k   = coef[i];
+
+                for (size_t j=0; j<count; ++j)
+                {
+                    float c         = src[j] - b + k * a;
+                    b               = a;
+                    a               = c;
+                }
+
+                s1[i]           = a;
+                s2[i]           = b;
+            }
+        }
+
+        void sdft_bank(float *state, const float *coef, const float *src, const float *old, size_t bins, size_t count)
+        {
+            float *s_re         = state;
+            float *s_im         = &state[bins];
+            const float *z_re   = coef;
+            const float *z_im   = &coef[bins];
+            const float *zn_re  = &coef[bins*2];
+            const float *zn_im  = &coef[bins*3];
+
+            for (size_t i=0; i<bins; ++i)
+            {
+                float a_re      = s_re[i];
+                float a_im      = s_im[i];
+
+                for (size_t j=0; j<count; ++j)
+                {
+                    float t_re      = a_re + (src[j] - zn_re[i] * old[j]);
+                    float t_im      = a_im - zn_im[i] * old[j];
+                    a_re            = z_re[i] * t_re - z_im[i] * t_im;
+                    a_im            = z_re[i] * t_im + z_im[i] * t_re;
+                }
+
+                s_re[i]         = a_re;
+                s_im[i]         = a_im;
+            }
+        }
+
+        static inline size_t goertzel_align(size_t count)
+        {
+            return (count + 0x0f) & ~size_t(0x0f);
+        }
+
+        size_t goertzel_buffer_size(size_t bins)
+        {
+            return goertzel_align(bins) * 5;
+        }
+
+        bool goertzel_init(dsp::goertzel_t *g, float *buf, const float *freqs, size_t bins)
+        {
+            if (bins == 0)
+                return false;
+
+            const size_t stride = goertzel_align(bins);
+            g->coef         = buf;
+            g->rot          = &g->coef[stride];
+            g->state        = &g->rot[stride * 2];
+            g->bins         = bins;
+
+            for (size_t i=0; i<bins; ++i)
+            {
+                const double w  = 2.0 * M_PI * freqs[i];
+                g->coef[i]      = 2.0 * cos(w);
+                g->rot[i]       = cos(w);
+                g->rot[i + bins]= sin(w);
+            }
+
+            dsp::goertzel_reset(g);
+
+            return true;
+        }
+
+        void goertzel_reset(dsp::goertzel_t *g)
+        {
+            dsp::fill_zero(g->state, g->bins * 2);
+        }
+
+        void goertzel_process(dsp::goertzel_t *g, const float *src, size_t count)
+        {
+            dsp::goertzel_bank(g->state, g->coef, src, g->bins, count);
+        }
+
+        void goertzel_spectrum(const dsp::goertzel_t *g, float *re, float *im)
+        {
+            // X = s[n] - exp(-i*w) * s[n-1]
+            const size_t bins   = g->bins;
+            const float *s1     = g->state;
+            const float *s2     = &g->state[bins];
+
+            dsp::copy(re, s1, bins);
+            dsp::fmsub3(re, g->rot, s2, bins);
+            dsp::mul3(im, &g->rot[bins], s2, bins);
+        }
+
+        size_t sdft_buffer_size(size_t bins, size_t length)
+        {
+            return goertzel_align(bins) * 6 + goertzel_align(length);
+        }
+
+        bool sdft_init(dsp::sdft_t *s, float *buf, const float *freqs, size_t bins, size_t length)
+        {
+            if ((bins == 0) || (length == 0))
+                return false;
+
+            const size_t stride = goertzel_align(bins);
+            s->coef         = buf;
+            s->state        = &s->coef[stride * 4];
+            s->hist         = &s->state[stride * 2];
+            s->bins         = bins;
+            s->length       = length;
+
+            float *z_re     = s->coef;
+            float *z_im     = &z_re[bins];
+            float *zn_re    = &z_im[bins];
+            float *zn_im    = &zn_re[bins];
+
+            for (size_t i=0; i<bins; ++i)
+            {
+                // The magnitude of the rounded rotation factor should be less than 1,
+                // otherwise the rounding errors accumulated by the recursion grow
+                const double w  = 2.0 * M_PI * freqs[i];
+                double k        = 1.0;
+                float re, im;
+                while (true)
+                {
+                    re              = cos(w) * k;
+                    im              = sin(w) * k;
+                    if ((double(re) * re + double(im) * im) < 1.0)
+                        break;
+                    k              -= 1e-7;
+                }
+
+                // z^N is computed from the rounded rotation factor, so the samples
+                // leaving the window are cancelled exactly
+                double p_re = 1.0, p_im = 0.0;
+                double b_re = re, b_im = im;
+                for (size_t n = length; n > 0; n >>= 1)
+                {
+                    if (n & 1)
+                    {
+                        double t        = p_re * b_re - p_im * b_im;
+                        p_im            = p_re * b_im + p_im * b_re;
+                        p_re            = t;
+                    }
+                    double t        = b_re * b_re - b_im * b_im;
+                    b_im            = 2.0 * b_re * b_im;
+                    b_re            = t;
+                }
+
+                z_re[i]         = re;
+                z_im[i]         = im;
+                zn_re[i]        = p_re;
+                zn_im[i]        = p_im;
+            }
+
+            dsp::sdft_reset(s);
+
+            return true;
+        }
+
+        void sdft_reset(dsp::sdft_t *s)
+        {
+            dsp::fill_zero(s->state, s->bins * 2);
+            dsp::fill_zero(s->hist, s->length);
+            s->head         = 0;
+        }
+
+        void sdft_process(dsp::sdft_t *s, const float *src, size_t count)
+        {
+            while (count > 0)
+            {
+                // The oldest samples of the ring buffer leave the window
+                size_t to_do    = lsp_min(count, s->length - s->head);
+                float *old      = &s->hist[s->head];
+
+                dsp::sdft_bank(s->state, s->coef, src, old, s->bins, to_do);
+                dsp::copy(old, src, to_do);
+
+                src            += to_do;
+                count          -= to_do;
+                s->head        += to_do;
+                if (s->head >= s->length)
+                    s->head         = 0;
+            }
+        }
+
+        void sdft_spectrum(const dsp::sdft_t *s, float *re, float *im)
+        {
+            dsp::copy(re, s->state, s->bins);
+            dsp::copy(im, &s->state[s->bins], s->bins);
+        }
+    } /* namespace generic */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_GENERIC_GOERTZEL_H_ */
@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 28 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_HCONV_H_
+#define PRIVATE_DSP_ARCH_GENERIC_HCONV_H_
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_GENERIC_IMPL */
+
+#ifdef PLATFORM_WINDOWS
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif /* PLATFORM_WINDOWS */
+
+#define HCONV_MEASURE_TIME          2000000     /* Minimum time of each measurement, nanoseconds */
+
+namespace lsp
+{
+    namespace generic
+    {
+        static int64_t hconv_time()
+        {
+        #ifdef PLATFORM_WINDOWS
+            LARGE_INTEGER freq, cnt;
+            ::QueryPerformanceFrequency(&freq);
+            ::QueryPerformanceCounter(&cnt);
+            return int64_t(double(cnt.QuadPart) * 1e+9 / double(freq.QuadPart));
+        #else
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+        #endif /* PLATFORM_WINDOWS */
+        }
+
+        /*
+         * Repeat the code until the measurement time elapses and store
+         * the average time spent per one sample of the signal
+         */
+        #define HCONV_MEASURE(res, samples, ...) \
+            { \
+                size_t n        = 0; \
+                int64_t start   = hconv_time(), t; \
+                do { \
+                    __VA_ARGS__; \
+                    ++n; \
+                    t               = hconv_time() - start; \
+                } while (t < HCONV_MEASURE_TIME); \
+                res             = float(t) / float(n * (samples)); \
+            }
+
+        void hconv_calibrate(dsp::hconv_costs_t *costs, float *buf)
+        {
+            const size_t max_block  = 1 << (LSP_DSP_HCONV_RANK_MAX - 1);
+            float *src              = buf;                  // max_block floats
+            float *conv             = &src[max_block];      // 4 * max_block floats
+            float *spec             = &conv[max_block * 4]; // 4 * max_block floats
+            float *acc              = &spec[max_block * 4]; // 4 * max_block floats
+            float *tmp              = &acc[max_block * 4];  // 2 * max_block floats
+
+            for (size_t i=0; i<max_block; ++i)
+                src[i]                  = float(i & 0x0f) * 0.0625f - 0.5f;
+            dsp::fill_zero(conv, max_block * 4);
+            dsp::copy(conv, src, max_block);
+
+            for (size_t i=0; i<=LSP_DSP_PCONV_RANK_MAX; ++i)
+            {
+                costs->direct[i]        = 0.0f;
+                costs->level[i]         = 0.0f;
+                costs->part[i]          = 0.0f;
+            }
+
+            for (size_t rank=LSP_DSP_PCONV_RANK_MIN; rank <= LSP_DSP_HCONV_RANK_MAX; ++rank)
+            {
+                const size_t block      = 1 << (rank - 1);
+                const float *spectra[2] = { spec, spec };
+                const float *kernels[2] = { conv, conv };
+
+                // The direct convolution of the block of samples with the head of the same size
+                dsp::fill_zero(acc, block * 2);
+                HCONV_MEASURE(costs->direct[rank], block,
+                    dsp::convolve(acc, src, conv, block, block));
+
+                // The level of the partitioned convolver: the transform of the input block,
+                // the reverse transform of the accumulated data and the overlap-add
+                HCONV_MEASURE(costs->level[rank], block,
+                    dsp::fastconv_parse(spec, src, rank);
+                    dsp::fastconv_restore(tmp, spec, rank);
+                    dsp::add2(acc, tmp, block * 2));
+
+                // The multiplication and accumulation of partitions
+                dsp::fastconv_parse(spec, src, rank);
+                HCONV_MEASURE(costs->part[rank], block * 2,
+                    dsp::fastconv_mac_n(acc, spectra, kernels, 2, rank));
+            }
+
+            // The transform grows as N*log(N), the multiplication grows linearly
+            for (size_t rank=LSP_DSP_HCONV_RANK_MAX + 1; rank <= LSP_DSP_PCONV_RANK_MAX; ++rank)
+            {
+                costs->direct[rank]     = costs->direct[rank - 1] * 2.0f;
+                costs->level[rank]      = costs->level[rank - 1] * float(rank) / float(rank - 1);
+                costs->part[rank]       = costs->part[rank - 1];
+            }
+        }
+
+        #undef HCONV_MEASURE
+
+        static bool hconv_check(size_t length, size_t rank, size_t max_rank)
+        {
+            return (length > 0) &&
+                (rank >= LSP_DSP_PCONV_RANK_MIN) &&
+                (max_rank <= LSP_DSP_PCONV_RANK_MAX) &&
+                (rank <= max_rank);
+        }
+
+        size_t hconv_rank(const dsp::hconv_costs_t *costs, size_t length, size_t max_rank)
+        {
+            if (!hconv_check(length, LSP_DSP_PCONV_RANK_MIN, max_rank))
+                return 0;
+
+            dsp::pconv_level_t levels[LSP_DSP_PCONV_LEVELS_MAX];
+            const size_t last       = lsp_min(max_rank, size_t(LSP_DSP_HCONV_RANK_MAX));
+            size_t res              = LSP_DSP_PCONV_RANK_MIN;
+            float min_cost          = 0.0f;
+
+            for (size_t rank=LSP_DSP_PCONV_RANK_MIN; rank <= last; ++rank)
+            {
+                // The cost of the direct convolution is proportional to the length of the head
+                const size_t block      = 1 << (rank - 1);
+                float cost              = costs->direct[rank] * float(lsp_min(length, block)) / float(block);
+
+                // Each level of the tail is processed once per (1 << (rank - 1)) samples
+                const size_t nlevels    = (length > block) ? pconv_plan(levels, length - block, rank, max_rank) : 0;
+                for (size_t i=0; i<nlevels; ++i)
+                {
+                    const dsp::pconv_level_t *l = &levels[i];
+                    cost                   += costs->level[l->rank] + costs->part[l->rank] * l->parts;
+                }
+
+                if ((rank == LSP_DSP_PCONV_RANK_MIN) || (cost < min_cost))
+                {
+                    res                     = rank;
+                    min_cost                = cost;
+                }
+
+                // Larger heads can not be cheaper if the whole impulse response fits the head
+                if (length <= block)
+                    break;
+            }
+
+            return res;
+        }
+
+        size_t hconv_buffer_size(size_t length, size_t rank, size_t max_rank)
+        {
+            if (!hconv_check(length, rank, max_rank))
+                return 0;
+
+            const size_t block      = 1 << (rank - 1);
+            const size_t head       = (lsp_min(length, block) + 0x0f) & ~size_t(0x0f);
+            size_t res              = head + block * 2;
+            if (length > block)
+                res                    += dsp::pconv_buffer_size(length - block, rank, max_rank);
+
+            return res;
+        }
+
+        bool hconv_init(dsp::hconv_t *conv, float *buf, const float *ir, size_t length, size_t rank, size_t max_rank)
+        {
+            if (!hconv_check(length, rank, max_rank))
+                return false;
+
+            conv->block             = 1 << (rank - 1);
+            conv->length            = lsp_min(length, conv->block);
+            conv->head              = buf;
+            buf                    += (conv->length + 0x0f) & ~size_t(0x0f);
+            conv->acc               = buf;
+            buf                    += conv->block * 2;
+
+            dsp::copy(conv->head, ir, conv->length);
+            conv->tail.nlevels      = 0;
+            if (length > conv->block)
+            {
+                if (!dsp::pconv_init(&conv->tail, buf, &ir[conv->block], length - conv->block, rank, max_rank))
+                    return false;
+            }
+
+            dsp::hconv_reset(conv);
+
+            return true;
+        }
+
+        void hconv_reset(dsp::hconv_t *conv)
+        {
+            dsp::fill_zero(conv->acc, conv->block * 2);
+            if (conv->tail.nlevels > 0)
+                dsp::pconv_reset(&conv->tail);
+        }
+
+        void hconv_process(dsp::hconv_t *conv, float *dst, const float *src, size_t count)
+        {
+            while (count > 0)
+            {
+                size_t to_do    = lsp_min(count, conv->block);
+
+                // The output of the direct convolution is accumulated first since the
+                // source may be the same as destination
+                dsp::convolve(conv->acc, src, conv->head, conv->length, to_do);
+                if (conv->tail.nlevels > 0)
+                {
+                    dsp::pconv_process(&conv->tail, dst, src, to_do);
+                    dsp::add2(dst, conv->acc, to_do);
+                }
+                else
+                    dsp::copy(dst, conv->acc, to_do);
+
+                // Shift the accumulator
+                dsp::move(conv->acc, &conv->acc[to_do], conv->length);
+                dsp::fill_zero(&conv->acc[conv->length], to_do);
+
+                src            += to_do;
+                dst            += to_do;
+                count          -= to_do;
+            }
+        }
+    } /* namespace generic */
+} /* namespace lsp */
+
+#undef HCONV_MEASURE_TIME
+
+#endif /* PRIVATE_DSP_ARCH_GENERIC_HCONV_H_ */
@@ -242,6 +242,18 @@ namespace lsp
             }
         }
 
+        void pcomplex_modarg_fast(float *mod, float *arg, const float *src, size_t count)
+        {
+            for (size_t i=0; i<count; ++i, src += 2)
+            {
+                float r         = src[0];
+                float im        = src[1];
+
+                mod[i]          = sqrtf(r * r + im * im);
+                arg[i]          = complex_atan2_fast(r, im);
+            }
+        }
+
         void pcomplex_div2(float *dst, const float *src, size_t count)
         {
             while (count--)
@@ -0,0 +1,906 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 9 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_PCONV_H_
+#define PRIVATE_DSP_ARCH_GENERIC_PCONV_H_
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_GENERIC_IMPL */
+
+#include <lsp-plug.in/common/atomic.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#define PCONV_POOL_WAIT_TIME        1000000     /* Maximum time to wait for new jobs, nanoseconds */
+#define PCONV_POOL_QUEUE_SIZE       256         /* Size of the job queue, power of 2 */
+
+namespace lsp
+{
+    namespace dsp
+    {
+        /**
+         * Asynchronous job of the partitioned convolver level. The level of the
+         * partition size S receives the complete input block each S samples while
+         * its output is required only (S - block) samples later, so the computation
+         * can be performed by the worker thread in the meantime. Jobs are owned by
+         * the pool, so the queue never refers to the memory of the released convolver.
+         */
+        struct pconv_job_t
+        {
+            volatile uint32_t   state;          // State of the job
+            volatile uint32_t   used;           // The job is bound to the level of the convolver
+            pconv_level_t      *level;          // The level processed by the job
+            const float        *in;             // The input block of (1 << (rank - 1)) samples
+            float              *spec;           // Accumulated fast convolution data, (2 << rank) floats
+            float              *tmp;            // Output of the level, (1 << rank) floats
+            size_t              deadline;       // Position in the output buffer to add the output of the level
+        };
+
+        /**
+         * Cell of the lock-free job queue
+         */
+        typedef struct pconv_pool_cell_t
+        {
+            volatile uint32_t   seq;            // Sequence number of the cell
+            pconv_job_t        *job;            // The job
+        } pconv_pool_cell_t;
+
+        /**
+         * Pool of worker threads for asynchronous levels of partitioned convolvers.
+         * Jobs are passed to workers with the bounded lock-free queue, so submitting
+         * the job never blocks the caller.
+         */
+        struct pconv_pool_t
+        {
+            pconv_job_t         jobs[LSP_DSP_PCONV_POOL_JOBS_MAX];  // Jobs of asynchronous levels
+            pconv_pool_cell_t   queue[PCONV_POOL_QUEUE_SIZE];       // The job queue
+            volatile uint32_t   head;           // Position of the next job to take from the queue
+            volatile uint32_t   tail;           // Position of the next job to put to the queue
+            volatile uint32_t   running;        // Workers should keep running
+            size_t              nthreads;       // Number of worker threads
+            pthread_mutex_t     mutex;          // Mutex to wait for new jobs
+            pthread_cond_t      cond;           // Condition to wake up workers
+            pthread_t           threads[LSP_DSP_PCONV_POOL_THREADS_MAX]; // Worker threads
+        };
+    } /* namespace dsp */
+
+    namespace generic
+    {
+        enum pconv_job_state_t
+        {
+            PCONV_JOB_IDLE,                 // The job is not submitted
+            PCONV_JOB_QUEUED,               // The job is submitted and waits to be taken
+            PCONV_JOB_RUNNING,              // The job is computed
+            PCONV_JOB_DONE,                 // The output of the job is ready
+            PCONV_JOB_DROPPED               // The job is computed but its output is not required anymore
+        };
+
+        enum pconv_swap_state_t
+        {
+            PCONV_SWAP_IDLE,                // The slot for the new impulse response is free
+            PCONV_SWAP_BUSY,                // The new impulse response is being prepared
+            PCONV_SWAP_READY,               // The new impulse response is prepared
+            PCONV_SWAP_RUNNING              // The output of both impulse responses is computed
+        };
+
+        /**
+         * Split the impulse response into levels
+         *
+         * @param levels array of LSP_DSP_PCONV_LEVELS_MAX levels to fill
+         * @param length the length of the impulse response
+         * @param rank the fast convolution rank of the first level
+         * @param max_rank the maximum fast convolution rank
+         * @return number of levels, 0 on invalid parameters
+         */
+        static size_t pconv_plan(dsp::pconv_level_t *levels, size_t length, size_t rank, size_t max_rank)
+        {
+            if ((length <= 0) || (rank < LSP_DSP_PCONV_RANK_MIN) || (max_rank > LSP_DSP_PCONV_RANK_MAX) || (max_rank < rank))
+                return 0;
+
+            size_t n            = 0;
+            for (size_t offset = 0; offset < length; ++rank)
+            {
+                const size_t size   = 1 << (rank - 1);
+                const size_t left   = length - offset;
+                dsp::pconv_level_t *l = &levels[n++];
+
+                // Each next level should start not earlier than (size - first level size)
+                // samples after the offset to get the block of input data in time.
+                // This is always true for LSP_DSP_PCONV_LEVEL_PARTS >= 1 partitions per level.
+                l->kernel           = NULL;
+                l->rank             = rank;
+                l->offset           = offset;
+                l->parts            = ((rank >= max_rank) || (left <= size * LSP_DSP_PCONV_LEVEL_PARTS)) ?
+                                        (left + size - 1) >> (rank - 1) :
+                                        LSP_DSP_PCONV_LEVEL_PARTS;
+                offset             += l->parts * size;
+            }
+
+            return n;
+        }
+
+        static inline size_t pconv_out_size(const dsp::pconv_level_t *levels, size_t nlevels, size_t block)
+        {
+            // The farthest sample written by each level at the moment of processing
+            size_t reach        = 0;
+            for (size_t i=0; i<nlevels; ++i)
+                reach               = lsp_max(reach, levels[i].offset + (size_t(1) << (levels[i].rank - 1)) + block);
+
+            size_t res          = block;
+            while (res < reach)
+                res               <<= 1;
+            return res;
+        }
+
+        static inline size_t pconv_ptr_size(size_t parts)
+        {
+            // Pointers to the delay line and kernels, in floats, padded to keep the alignment of 64 bytes
+            const size_t bytes  = parts * 3 * sizeof(const float *);
+            return ((bytes + sizeof(float) - 1) / sizeof(float) + 0x0f) & ~size_t(0x0f);
+        }
+
+        static size_t pconv_size(const dsp::pconv_level_t *levels, size_t nlevels, size_t rank)
+        {
+            // The size of all buffers except the input ring buffer
+            const dsp::pconv_level_t *last = &levels[nlevels - 1];
+            size_t res              = 0;
+            for (size_t i=0; i<nlevels; ++i)
+                res                    += (levels[i].parts << (levels[i].rank + 2)) +    // kernel, fdl
+                                          pconv_ptr_size(levels[i].parts);              // spectra, kernels
+
+            return res +
+                pconv_out_size(levels, nlevels, 1 << (rank - 1)) +                      // out
+                (2 << last->rank) + (1 << last->rank);                                  // spec, tmp
+        }
+
+        size_t pconv_buffer_size(size_t length, size_t rank, size_t max_rank)
+        {
+            dsp::pconv_level_t levels[LSP_DSP_PCONV_LEVELS_MAX];
+            const size_t nlevels    = pconv_plan(levels, length, rank, max_rank);
+            if (nlevels <= 0)
+                return 0;
+
+            return pconv_size(levels, nlevels, rank) +
+                (1 << (levels[nlevels - 1].rank - 1));                                  // in
+        }
+
+        size_t pconv_mt_buffer_size(size_t length, size_t rank, size_t max_rank, size_t async_rank)
+        {
+            dsp::pconv_level_t levels[LSP_DSP_PCONV_LEVELS_MAX];
+            const size_t nlevels    = pconv_plan(levels, length, rank, max_rank);
+            if (nlevels <= 0)
+                return 0;
+
+            // Each asynchronous level has its own buffers for the output, the input
+            // ring buffer is doubled to keep input blocks of pending jobs
+            size_t res              = pconv_size(levels, nlevels, rank);
+            size_t in_size          = 1 << (levels[nlevels - 1].rank - 1);
+            for (size_t i=1; i<nlevels; ++i)
+            {
+                if (levels[i].rank < async_rank)
+                    continue;
+                res                    += (2 << levels[i].rank) + (1 << levels[i].rank); // spec, tmp
+                in_size                 = 2 << (levels[nlevels - 1].rank - 1);
+            }
+
+            return res + in_size;
+        }
+
+        /**
+         * Compute the fast convolution data of partitions of the level, partitions
+         * beyond the end of the impulse response are zero
+         *
+         * @param l the level
+         * @param dst destination buffer for the fast convolution data of partitions
+         * @param tmp temporary buffer of (1 << (rank - 1)) floats
+         * @param ir the impulse response
+         * @param length the length of the impulse response
+         */
+        static void pconv_parse_kernel(const dsp::pconv_level_t *l, float *dst, float *tmp, const float *ir, size_t length)
+        {
+            const size_t size       = 1 << (l->rank - 1);
+            const size_t step       = 2 << l->rank;
+
+            for (size_t j=0, offset=l->offset; j<l->parts; ++j, offset += size)
+            {
+                const size_t count      = (offset < length) ? lsp_min(size, length - offset) : 0;
+                dsp::copy(tmp, &ir[offset], count);
+                dsp::fill_zero(&tmp[count], size - count);
+                dsp::fastconv_parse(&dst[j * step], tmp, l->rank);
+            }
+        }
+
+        /**
+         * Allocate buffers and compute the fast convolution data of the planned levels
+         *
+         * @param conv the convolver with planned levels
+         * @param buf the buffer
+         * @param ir the impulse response
+         * @param length the length of the impulse response
+         * @param in_size the size of the input ring buffer
+         * @return pointer to the unused part of the buffer
+         */
+        static float *pconv_build(dsp::pconv_t *conv, float *buf, const float *ir, size_t length, size_t in_size)
+        {
+            const size_t nlevels    = conv->nlevels;
+            const dsp::pconv_level_t *last = &conv->levels[nlevels - 1];
+            conv->in_size           = in_size;
+            conv->out_size          = pconv_out_size(conv->levels, nlevels, conv->block);
+            conv->pool              = NULL;
+            conv->swap              = NULL;
+
+            // Allocate fast convolution data first to keep the alignment
+            for (size_t i=0; i<nlevels; ++i)
+            {
+                dsp::pconv_level_t *l   = &conv->levels[i];
+                const size_t size       = l->parts << (l->rank + 1);
+                l->kernel               = buf;
+                buf                    += size;
+                l->fdl                  = buf;
+                buf                    += size;
+                l->job                  = NULL;
+            }
+            conv->out               = buf;
+            buf                    += conv->out_size;
+            conv->spec              = buf;
+            buf                    += 2 << last->rank;
+            conv->tmp               = buf;
+            buf                    += 1 << last->rank;
+            conv->in                = buf;
+            buf                    += conv->in_size;
+
+            for (size_t i=0; i<nlevels; ++i)
+            {
+                dsp::pconv_level_t *l   = &conv->levels[i];
+                const size_t step       = 2 << l->rank;
+
+                // The delay line is addressed through the doubled array of pointers, so the
+                // oldest to the newest input blocks are always at consecutive positions.
+                // Kernels are stored in the reverse order to match them.
+                l->spectra              = reinterpret_cast<const float **>(buf);
+                l->kernels              = &l->spectra[l->parts * 2];
+                buf                    += pconv_ptr_size(l->parts);
+
+                l->xkernel              = NULL;
+                l->xkernels             = NULL;
+
+                for (size_t j=0; j<l->parts; ++j)
+                {
+                    l->spectra[j]           = &l->fdl[j * step];
+                    l->spectra[j + l->parts]= &l->fdl[j * step];
+                    l->kernels[l->parts - j - 1] = &l->kernel[j * step];
+                }
+
+                pconv_parse_kernel(l, l->kernel, conv->tmp, ir, length);
+            }
+
+            return buf;
+        }
+
+        bool pconv_init(dsp::pconv_t *conv, float *buf, const float *ir, size_t length, size_t rank, size_t max_rank)
+        {
+            const size_t nlevels    = pconv_plan(conv->levels, length, rank, max_rank);
+            if (nlevels <= 0)
+                return false;
+
+            conv->block             = 1 << (rank - 1);
+            conv->nlevels           = nlevels;
+            pconv_build(conv, buf, ir, length, 1 << (conv->levels[nlevels - 1].rank - 1));
+
+            dsp::pconv_reset(conv);
+
+            return true;
+        }
+
+        bool pconv_mt_init(dsp::pconv_t *conv, float *buf, dsp::pconv_pool_t *pool,
+            const float *ir, size_t length, size_t rank, size_t max_rank, size_t async_rank)
+        {
+            const size_t nlevels    = pconv_plan(conv->levels, length, rank, max_rank);
+            if ((nlevels <= 0) || (pool == NULL))
+                return false;
+
+            // Take jobs from the pool, the first level is always processed in place
+            // since its output is required immediately
+            dsp::pconv_job_t *jobs[LSP_DSP_PCONV_LEVELS_MAX];
+            size_t njobs            = 0;
+            for (size_t i=1; i<nlevels; ++i)
+            {
+                if (conv->levels[i].rank < async_rank)
+                    continue;
+
+                dsp::pconv_job_t *job   = NULL;
+                for (size_t j=0; j<LSP_DSP_PCONV_POOL_JOBS_MAX; ++j)
+                {
+                    if (atomic_cas(&pool->jobs[j].used, 0, 1))
+                    {
+                        job                     = &pool->jobs[j];
+                        break;
+                    }
+                }
+                if (job == NULL)
+                {
+                    for (size_t j=0; j<njobs; ++j)
+                        atomic_store(&jobs[j]->used, 0);
+                    return false;
+                }
+                jobs[njobs++]           = job;
+            }
+
+            // The input ring buffer is doubled to keep input blocks of pending jobs
+            const size_t in_size    = 1 << (conv->levels[nlevels - 1].rank - 1);
+            conv->block             = 1 << (rank - 1);
+            conv->nlevels           = nlevels;
+            buf                     = pconv_build(conv, buf, ir, length, (njobs > 0) ? in_size * 2 : in_size);
+            conv->pool              = pool;
+
+            for (size_t i=1, j=0; i<nlevels; ++i)
+            {
+                dsp::pconv_level_t *l   = &conv->levels[i];
+                if (l->rank < async_rank)
+                    continue;
+
+                dsp::pconv_job_t *job   = jobs[j++];
+                job->spec               = buf;
+                buf                    += 2 << l->rank;
+                job->tmp                = buf;
+                buf                    += 1 << l->rank;
+                job->level              = l;
+                job->in                 = NULL;
+                job->deadline           = 0;
+                atomic_store(&job->state, PCONV_JOB_IDLE);
+                l->job                  = job;
+            }
+
+            dsp::pconv_reset(conv);
+
+            return true;
+        }
+
+        static inline size_t pconv_swap_size()
+        {
+            // The replacement state in floats, padded to keep the alignment of 64 bytes
+            return ((sizeof(dsp::pconv_swap_t) + sizeof(float) - 1) / sizeof(float) + 0x0f) & ~size_t(0x0f);
+        }
+
+        size_t pconv_swap_buffer_size(size_t length, size_t rank, size_t max_rank)
+        {
+            dsp::pconv_level_t levels[LSP_DSP_PCONV_LEVELS_MAX];
+            const size_t nlevels    = pconv_plan(levels, length, rank, max_rank);
+            if (nlevels <= 0)
+                return 0;
+
+            // The slot for the new impulse response, the output ring buffer and
+            // the temporary buffer for the new impulse response
+            const size_t in_size    = 1 << (levels[nlevels - 1].rank - 1);
+            size_t res              = pconv_size(levels, nlevels, rank) + in_size * 2 + pconv_swap_size() +
+                                      pconv_out_size(levels, nlevels, 1 << (rank - 1));
+            for (size_t i=0; i<nlevels; ++i)
+                res                    += (levels[i].parts << (levels[i].rank + 1)) +    // xkernel
+                                          pconv_ptr_size(levels[i].parts);              // xkernels
+
+            return res;
+        }
+
+        bool pconv_swap_init(dsp::pconv_t *conv, float *buf, const float *ir, size_t length, size_t rank, size_t max_rank)
+        {
+            const size_t nlevels    = pconv_plan(conv->levels, length, rank, max_rank);
+            if (nlevels <= 0)
+                return false;
+
+            const size_t in_size    = 1 << (conv->levels[nlevels - 1].rank - 1);
+            conv->block             = 1 << (rank - 1);
+            conv->nlevels           = nlevels;
+            buf                     = pconv_build(conv, buf, ir, length, in_size);
+
+            size_t latency          = 0;
+            for (size_t i=0; i<nlevels; ++i)
+            {
+                dsp::pconv_level_t *l   = &conv->levels[i];
+                const size_t step       = 2 << l->rank;
+
+                l->xkernel              = buf;
+                buf                    += l->parts * step;
+                l->xkernels             = reinterpret_cast<const float **>(buf);
+                buf                    += pconv_ptr_size(l->parts);
+
+                for (size_t j=0; j<l->parts; ++j)
+                    l->xkernels[l->parts - j - 1] = &l->xkernel[j * step];
+
+                // The level computed at the block boundary contributes to the output
+                // at most (offset + size) samples later
+                latency                 = lsp_max(latency, l->offset + (size_t(1) << (l->rank - 1)));
+            }
+
+            dsp::pconv_swap_t *swap = reinterpret_cast<dsp::pconv_swap_t *>(buf);
+            buf                    += pconv_swap_size();
+            swap->out               = buf;
+            buf                    += conv->out_size;
+            swap->tmp               = buf;
+            buf                    += in_size;
+            swap->latency           = latency;
+            swap->delay             = 0;
+            swap->fade              = 0;
+            swap->pos               = 0;
+            swap->state             = PCONV_SWAP_IDLE;
+            conv->swap              = swap;
+
+            dsp::pconv_reset(conv);
+
+            return true;
+        }
+
+        bool pconv_swap_prepare(dsp::pconv_t *conv, const float *ir, size_t length, size_t fade)
+        {
+            dsp::pconv_swap_t *swap = conv->swap;
+            if (swap == NULL)
+                return false;
+
+            const dsp::pconv_level_t *last = &conv->levels[conv->nlevels - 1];
+            if (length > last->offset + (last->parts << (last->rank - 1)))
+                return false;
+            if (!atomic_cas(&swap->state, PCONV_SWAP_IDLE, PCONV_SWAP_BUSY))
+                return false;
+
+            // The slot is not used by the convolver until the state is changed
+            for (size_t i=0; i<conv->nlevels; ++i)
+            {
+                const dsp::pconv_level_t *l = &conv->levels[i];
+                pconv_parse_kernel(l, l->xkernel, swap->tmp, ir, length);
+            }
+            swap->fade              = fade;
+            atomic_store(&swap->state, PCONV_SWAP_READY);
+
+            return true;
+        }
+
+        static void pconv_swap_complete(dsp::pconv_t *conv)
+        {
+            dsp::pconv_swap_t *swap = conv->swap;
+
+            // The slot now keeps the previous impulse response and can be reused
+            for (size_t i=0; i<conv->nlevels; ++i)
+            {
+                dsp::pconv_level_t *l   = &conv->levels[i];
+                float *kernel           = l->kernel;
+                const float **kernels   = l->kernels;
+                l->kernel               = l->xkernel;
+                l->kernels              = l->xkernels;
+                l->xkernel              = kernel;
+                l->xkernels             = kernels;
+            }
+
+            float *out              = conv->out;
+            conv->out               = swap->out;
+            swap->out               = out;
+            atomic_store(&swap->state, PCONV_SWAP_IDLE);
+        }
+
+        static void pconv_level_apply(const dsp::pconv_level_t *l, const float * const *kernels, float *dst, float *spec)
+        {
+            // Sum products of all partitions and restore the output of the level
+            dsp::fastconv_mac_n(spec, &l->spectra[l->head + 1], kernels, l->parts, l->rank);
+            dsp::fastconv_restore(dst, spec, l->rank);
+        }
+
+        static void pconv_level_transform(dsp::pconv_level_t *l, float *dst, float *spec, const float *in)
+        {
+            // Put the fast convolution data of the just completed input block to the delay line
+            l->head             = (l->head + 1 < l->parts) ? l->head + 1 : 0;
+            dsp::fastconv_parse(const_cast<float *>(l->spectra[l->head]), in, l->rank);
+
+            pconv_level_apply(l, l->kernels, dst, spec);
+        }
+
+        static void pconv_add_output(dsp::pconv_t *conv, float *out, const float *src, size_t off, size_t count)
+        {
+            const size_t tail   = lsp_min(count, conv->out_size - off);
+            dsp::add2(&out[off], src, tail);
+            dsp::add2(out, &src[tail], count - tail);
+        }
+
+        static void pconv_job_run(dsp::pconv_job_t *job)
+        {
+            pconv_level_transform(job->level, job->tmp, job->spec, job->in);
+
+            // Nobody waits for the output of the dropped job
+            if (!atomic_cas(&job->state, PCONV_JOB_RUNNING, PCONV_JOB_DONE))
+                atomic_store(&job->state, PCONV_JOB_IDLE);
+        }
+
+        static bool pconv_pool_push(dsp::pconv_pool_t *pool, dsp::pconv_job_t *job)
+        {
+            uint32_t pos        = atomic_load(&pool->tail);
+            while (true)
+            {
+                dsp::pconv_pool_cell_t *cell = &pool->queue[pos & (PCONV_POOL_QUEUE_SIZE - 1)];
+                const int32_t dif   = int32_t(atomic_load(&cell->seq) - pos);
+                if (dif == 0)
+                {
+                    if (atomic_cas(&pool->tail, pos, pos + 1))
+                    {
+                        cell->job           = job;
+                        atomic_store(&cell->seq, pos + 1);
+                        return true;
+                    }
+                }
+                else if (dif < 0)
+                    return false;
+
+                pos                 = atomic_load(&pool->tail);
+            }
+        }
+
+        static dsp::pconv_job_t *pconv_pool_pop(dsp::pconv_pool_t *pool)
+        {
+            uint32_t pos        = atomic_load(&pool->head);
+            while (true)
+            {
+                dsp::pconv_pool_cell_t *cell = &pool->queue[pos & (PCONV_POOL_QUEUE_SIZE - 1)];
+                const int32_t dif   = int32_t(atomic_load(&cell->seq) - (pos + 1));
+                if (dif == 0)
+                {
+                    if (atomic_cas(&pool->head, pos, pos + 1))
+                    {
+                        dsp::pconv_job_t *job = cell->job;
+                        atomic_store(&cell->seq, pos + PCONV_POOL_QUEUE_SIZE);
+                        return job;
+                    }
+                }
+                else if (dif < 0)
+                    return NULL;
+
+                pos                 = atomic_load(&pool->head);
+            }
+        }
+
+        static void *pconv_pool_worker(void *arg)
+        {
+            dsp::pconv_pool_t *pool = static_cast<dsp::pconv_pool_t *>(arg);
+
+            while (atomic_load(&pool->running))
+            {
+                // The job may have already been computed by the convolver itself
+                dsp::pconv_job_t *job   = pconv_pool_pop(pool);
+                if (job != NULL)
+                {
+                    if (atomic_cas(&job->state, PCONV_JOB_QUEUED, PCONV_JOB_RUNNING))
+                        pconv_job_run(job);
+                    continue;
+                }
+
+                // The submitter does not block on the mutex, so the wake-up may be
+                // missed and the wait is limited in time
+                pthread_mutex_lock(&pool->mutex);
+                if ((atomic_load(&pool->running)) && (atomic_load(&pool->head) == atomic_load(&pool->tail)))
+                {
+                    struct timespec ts;
+                    clock_gettime(CLOCK_REALTIME, &ts);
+                    ts.tv_nsec         += PCONV_POOL_WAIT_TIME;
+                    if (ts.tv_nsec >= 1000000000)
+                    {
+                        ts.tv_nsec         -= 1000000000;
+                        ++ts.tv_sec;
+                    }
+                    pthread_cond_timedwait(&pool->cond, &pool->mutex, &ts);
+                }
+                pthread_mutex_unlock(&pool->mutex);
+            }
+
+            return NULL;
+        }
+
+        size_t pconv_pool_size()
+        {
+            return (sizeof(dsp::pconv_pool_t) + LSP_DSP_PCONV_POOL_ALIGN - 1) & ~size_t(LSP_DSP_PCONV_POOL_ALIGN - 1);
+        }
+
+        bool pconv_pool_start(dsp::pconv_pool_t *pool, size_t threads)
+        {
+            if ((threads < 1) || (threads > LSP_DSP_PCONV_POOL_THREADS_MAX))
+                return false;
+            if (uintptr_t(pool) & (LSP_DSP_PCONV_POOL_ALIGN - 1))
+                return false;
+
+            for (size_t i=0; i<PCONV_POOL_QUEUE_SIZE; ++i)
+            {
+                pool->queue[i].seq      = i;
+                pool->queue[i].job      = NULL;
+            }
+            for (size_t i=0; i<LSP_DSP_PCONV_POOL_JOBS_MAX; ++i)
+            {
+                pool->jobs[i].state     = PCONV_JOB_IDLE;
+                pool->jobs[i].used      = 0;
+            }
+            pool->head              = 0;
+            pool->tail              = 0;
+            pool->running           = 1;
+            pool->nthreads          = 0;
+
+            if (pthread_mutex_init(&pool->mutex, NULL) != 0)
+                return false;
+            if (pthread_cond_init(&pool->cond, NULL) != 0)
+            {
+                pthread_mutex_destroy(&pool->mutex);
+                return false;
+            }
+
+            for (size_t i=0; i<threads; ++i)
+            {
+                if (pthread_create(&pool->threads[i], NULL, pconv_pool_worker, pool) != 0)
+                {
+                    dsp::pconv_pool_stop(pool);
+                    return false;
+                }
+                ++pool->nthreads;
+            }
+
+            return true;
+        }
+
+        void pconv_pool_stop(dsp::pconv_pool_t *pool)
+        {
+            atomic_store(&pool->running, 0);
+
+            pthread_mutex_lock(&pool->mutex);
+            pthread_cond_broadcast(&pool->cond);
+            pthread_mutex_unlock(&pool->mutex);
+
+            for (size_t i=0; i<pool->nthreads; ++i)
+                pthread_join(pool->threads[i], NULL);
+            pool->nthreads          = 0;
+
+            pthread_cond_destroy(&pool->cond);
+            pthread_mutex_destroy(&pool->mutex);
+        }
+
+        static void pconv_job_submit(dsp::pconv_pool_t *pool, dsp::pconv_job_t *job)
+        {
+            // If the queue is full, the job remains queued and is computed in place
+            // when its output is required
+            atomic_store(&job->state, PCONV_JOB_QUEUED);
+            if (!pconv_pool_push(pool, job))
+                return;
+
+            if (pthread_mutex_trylock(&pool->mutex) == 0)
+            {
+                pthread_cond_signal(&pool->cond);
+                pthread_mutex_unlock(&pool->mutex);
+            }
+        }
+
+        static void pconv_job_wait(dsp::pconv_job_t *job, size_t spins)
+        {
+            // Compute the job in place if it has not been taken by any worker yet
+            if (atomic_cas(&job->state, PCONV_JOB_QUEUED, PCONV_JOB_RUNNING))
+            {
+                pconv_job_run(job);
+                return;
+            }
+
+            for (size_t i=0; i < spins; ++i)
+            {
+                const uint32_t state    = atomic_load(&job->state);
+                if ((state != PCONV_JOB_RUNNING) && (state != PCONV_JOB_DROPPED))
+                    break;
+                sched_yield();
+            }
+        }
+
+        static void pconv_job_finish(dsp::pconv_t *conv, dsp::pconv_job_t *job)
+        {
+            // The caller does not wait for the late worker for more than the limited
+            // number of spins, the output of the level for this block is dropped then
+            pconv_job_wait(job, LSP_DSP_PCONV_WAIT_SPINS);
+            if (atomic_cas(&job->state, PCONV_JOB_RUNNING, PCONV_JOB_DROPPED))
+                return;
+            if (atomic_load(&job->state) != PCONV_JOB_DONE)
+                return;
+
+            pconv_add_output(conv, conv->out, job->tmp, job->deadline, 2 << (job->level->rank - 1));
+            atomic_store(&job->state, PCONV_JOB_IDLE);
+        }
+
+        void pconv_reset(dsp::pconv_t *conv)
+        {
+            for (size_t i=0; i<conv->nlevels; ++i)
+            {
+                dsp::pconv_level_t *l   = &conv->levels[i];
+                if ((l->job != NULL) && (atomic_load(&l->job->state) != PCONV_JOB_IDLE))
+                {
+                    pconv_job_wait(l->job, size_t(-1));
+                    atomic_store(&l->job->state, PCONV_JOB_IDLE);
+                }
+                dsp::fill_zero(l->fdl, l->parts << (l->rank + 1));
+                l->head                 = 0;
+            }
+
+            // The replacement in progress is completed immediately since there is no history
+            dsp::pconv_swap_t *swap = conv->swap;
+            if (swap != NULL)
+            {
+                if (swap->state == PCONV_SWAP_RUNNING)
+                    pconv_swap_complete(conv);
+                dsp::fill_zero(swap->out, conv->out_size);
+            }
+
+            dsp::fill_zero(conv->in, conv->in_size);
+            dsp::fill_zero(conv->out, conv->out_size);
+            conv->head              = 0;
+            conv->fill              = 0;
+        }
+
+        void pconv_mt_destroy(dsp::pconv_t *conv)
+        {
+            dsp::pconv_reset(conv);
+
+            for (size_t i=0; i<conv->nlevels; ++i)
+            {
+                dsp::pconv_level_t *l   = &conv->levels[i];
+                if (l->job == NULL)
+                    continue;
+                atomic_store(&l->job->used, 0);
+                l->job                  = NULL;
+            }
+            conv->pool              = NULL;
+        }
+
+        static void pconv_level(dsp::pconv_t *conv, dsp::pconv_level_t *l)
+        {
+            const size_t size   = 1 << (l->rank - 1);
+            const float *in     = &conv->in[(conv->head - size) & (conv->in_size - 1)];
+            const size_t off    = (conv->head - size + l->offset + conv->block) & (conv->out_size - 1);
+            dsp::pconv_job_t *job = l->job;
+
+            if (job == NULL)
+            {
+                pconv_level_transform(l, conv->tmp, conv->spec, in);
+                pconv_add_output(conv, conv->out, conv->tmp, off, size << 1);
+
+                // The output of the pending impulse response shares the delay line
+                dsp::pconv_swap_t *swap = conv->swap;
+                if ((swap != NULL) && (swap->state == PCONV_SWAP_RUNNING))
+                {
+                    pconv_level_apply(l, l->xkernels, conv->tmp, conv->spec);
+                    pconv_add_output(conv, swap->out, conv->tmp, off, size << 1);
+                }
+                return;
+            }
+
+            // The output of the level is required (offset + block - size) samples later,
+            // the input block remains in the doubled input ring buffer until that moment
+            if (atomic_load(&job->state) != PCONV_JOB_IDLE)
+                pconv_job_finish(conv, job);
+            // The worker still computes the dropped job and owns the delay line of the level
+            if (atomic_load(&job->state) != PCONV_JOB_IDLE)
+                return;
+            job->in             = in;
+            job->deadline       = off;
+            pconv_job_submit(conv->pool, job);
+        }
+
+        static void pconv_output(dsp::pconv_t *conv, float *dst, size_t count)
+        {
+            dsp::pconv_swap_t *swap = conv->swap;
+
+            for (size_t off = conv->head; count > 0; )
+            {
+                float *out      = &conv->out[off];
+                size_t n        = count;
+
+                if ((swap == NULL) || (swap->state != PCONV_SWAP_RUNNING))
+                {
+                    dsp::copy(dst, out, n);
+                    dsp::fill_zero(out, n);
+                }
+                else
+                {
+                    float *xout     = &swap->out[off];
+                    if (swap->delay > 0)
+                    {
+                        // Not all levels have contributed to the output of the new impulse response yet
+                        n               = lsp_min(count, swap->delay);
+                        dsp::copy(dst, out, n);
+                        swap->delay    -= n;
+                    }
+                    else
+                    {
+                        // Linear crossfade: out + (xout - out) * k
+                        const float k   = 1.0f / swap->fade;
+                        n               = lsp_min(count, swap->fade - swap->pos);
+                        dsp::sub2(xout, out, n);
+                        dsp::lramp_add3(dst, out, xout, swap->pos * k, (swap->pos + n) * k, n);
+                        swap->pos      += n;
+                    }
+
+                    dsp::fill_zero(out, n);
+                    dsp::fill_zero(xout, n);
+                    if ((swap->delay == 0) && (swap->pos >= swap->fade))
+                        pconv_swap_complete(conv);
+                }
+
+                dst            += n;
+                off            += n;
+                count          -= n;
+            }
+        }
+
+        void pconv_process(dsp::pconv_t *conv, float *dst, const float *src, size_t count)
+        {
+            while (count > 0)
+            {
+                size_t to_do    = lsp_min(count, conv->block - conv->fill);
+
+                // Source should be consumed first since it may be the same as destination
+                dsp::copy(&conv->in[conv->head & (conv->in_size - 1)], src, to_do);
+                pconv_output(conv, dst, to_do);
+
+                src            += to_do;
+                dst            += to_do;
+                count          -= to_do;
+                conv->fill     += to_do;
+                conv->head      = (conv->head + to_do) & (conv->out_size - 1);
+
+                if (conv->fill < conv->block)
+                    break;
+
+                // Start computing the output of the prepared impulse response
+                dsp::pconv_swap_t *swap = conv->swap;
+                if ((swap != NULL) && (atomic_load(&swap->state) == PCONV_SWAP_READY))
+                {
+                    dsp::fill_zero(swap->out, conv->out_size);
+                    swap->delay     = swap->latency;
+                    swap->pos       = 0;
+                    atomic_store(&swap->state, PCONV_SWAP_RUNNING);
+                }
+
+                // Process all levels which have the complete block of input data
+                conv->fill      = 0;
+                for (size_t i=0; i<conv->nlevels; ++i)
+                {
+                    dsp::pconv_level_t *l = &conv->levels[i];
+                    if (conv->head & ((1 << (l->rank - 1)) - 1))
+                        break;
+                    pconv_level(conv, l);
+                }
+
+                // Pick up the output of asynchronous levels required by the next block
+                if (conv->pool == NULL)
+                    continue;
+                for (size_t i=1; i<conv->nlevels; ++i)
+                {
+                    dsp::pconv_job_t *job = conv->levels[i].job;
+                    if ((job != NULL) &&
+                        (atomic_load(&job->state) != PCONV_JOB_IDLE) &&
+                        (job->deadline == conv->head))
+                        pconv_job_finish(conv, job);
+                }
+            }
+        }
+    } /* namespace generic */
+} /* namespace lsp */
+
+#undef PCONV_POOL_WAIT_TIME
+#undef PCONV_POOL_QUEUE_SIZE
+
+#endif /* PRIVATE_DSP_ARCH_GENERIC_PCONV_H_ */
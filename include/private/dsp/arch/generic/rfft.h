@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 24 окт. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_RFFT_H_
+#define PRIVATE_DSP_ARCH_GENERIC_RFFT_H_
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_GENERIC_IMPL */
+
+namespace lsp
+{
+    namespace generic
+    {
+        // cos(2*pi*k/8), sin(2*pi*k/8)
+        static const float XRFFT_SMALL_RE[] __lsp_aligned16 =
+        {
+            1.0000000000000000f, 0.7071067811865475f, 0.0000000000000000f, -0.7071067811865475f,
+            -1.0000000000000000f, -0.7071067811865475f, 0.0000000000000000f, 0.7071067811865475f
+        };
+
+        static const float XRFFT_SMALL_IM[] __lsp_aligned16 =
+        {
+            0.0000000000000000f, 0.7071067811865475f, 1.0000000000000000f, 0.7071067811865475f,
+            0.0000000000000000f, -0.7071067811865475f, -1.0000000000000000f, -0.7071067811865475f
+        };
+
+        /**
+         * Compute the real FFT of rank 0..3 by the definition
+         */
+        static void small_real_direct_fft(float *dst_re, float *dst_im, size_t step, const float *src, size_t rank)
+        {
+            float b_re[5], b_im[5];
+            size_t items    = 1 << rank;
+            size_t half     = items >> 1;
+            size_t shift    = 3 - rank;
+
+            for (size_t k=0; k<=half; ++k)
+            {
+                float re        = 0.0f;
+                float im        = 0.0f;
+                for (size_t n=0; n<items; ++n)
+                {
+                    size_t i        = ((k * n) << shift) & 0x07;
+                    re             += src[n] * XRFFT_SMALL_RE[i];
+                    im             -= src[n] * XRFFT_SMALL_IM[i];
+                }
+                b_re[k]         = re;
+                b_im[k]         = im;
+            }
+
+            for (size_t k=0; k<=half; ++k)
+            {
+                dst_re[k*step]  = b_re[k];
+                dst_im[k*step]  = b_im[k];
+            }
+        }
+
+        /**
+         * Compute the reverse real FFT of rank 0..3 by the definition
+         */
+        static void small_real_reverse_fft(float *dst, const float *src_re, const float *src_im, size_t step, size_t rank)
+        {
+            float b[8];
+            size_t items    = 1 << rank;
+            size_t half     = items >> 1;
+            size_t shift    = 3 - rank;
+            float k         = 1.0f / items;
+
+            if (rank == 0)
+            {
+                dst[0]          = src_re[0];
+                return;
+            }
+
+            for (size_t n=0; n<items; ++n)
+            {
+                float s         = src_re[0] + ((n & 1) ? -src_re[half*step] : src_re[half*step]);
+                for (size_t i=1; i<half; ++i)
+                {
+                    size_t j        = ((i * n) << shift) & 0x07;
+                    s              += 2.0f * (src_re[i*step] * XRFFT_SMALL_RE[j] - src_im[i*step] * XRFFT_SMALL_IM[j]);
+                }
+                b[n]            = s * k;
+            }
+
+            for (size_t n=0; n<items; ++n)
+                dst[n]          = b[n];
+        }
+
+        /**
+         * Convert the complex spectrum Z[k] of the signal z[n] = x[2*n] + j*x[2*n+1] of
+         * (1 << (rank-1)) points into the non-negative part of the spectrum X[k] of real
+         * signal x[n] of (1 << rank) points:
+         *   X[k]       = Fe[k] + W^k * Fo[k]
+         *   X[N/2-k]   = conj(Fe[k] - W^k * Fo[k])
+         *   Fe[k]      = (Z[k] + conj(Z[N/2-k])) / 2
+         *   Fo[k]      = (Z[k] - conj(Z[N/2-k])) / 2j
+         *   W          = exp(-2*j*pi/N)
+         *
+         * @param re real part of spectrum
+         * @param im imaginary part of spectrum
+         * @param step distance between elements
+         * @param rank rank of the real FFT, should be at least 4
+         */
+        static void real_fft_direct_split(float *re, float *im, size_t step, size_t rank)
+        {
+            size_t half     = 1 << (rank - 2);
+            size_t items    = half << 1;
+
+            // Process the first and the middle points
+            float z_re          = re[0];
+            float z_im          = im[0];
+            re[0]               = z_re + z_im;
+            im[0]               = 0.0f;
+            re[items*step]      = z_re - z_im;
+            im[items*step]      = 0.0f;
+            im[half*step]       = -im[half*step];
+
+            // Process pairs of points
+            float w_re[4], w_im[4], xw[10], c_re, c_im;
+            const float *dw     = &XFFT_DW[(rank - 3) << 1];
+            const float *iw_re  = &XFFT_A_RE[(rank - 3) << 2];
+            const float *iw_im  = &XFFT_A_IM[(rank - 3) << 2];
+            if ((rank - 3) >= XFFT_STAGES)
+            {
+                fft_stage_twiddle(&xw[0], &xw[4], &xw[8], rank - 3);
+                iw_re               = &xw[0];
+                iw_im               = &xw[4];
+                dw                  = &xw[8];
+            }
+
+            for (size_t i=0; i<4; ++i)
+            {
+                w_re[i]             = iw_re[i] * 0.5f;
+                w_im[i]             = iw_im[i] * 0.5f;
+            }
+
+            for (size_t k=0; ; )
+            {
+                for (size_t i=0; i<4; ++i)
+                {
+                    size_t j            = k + i;
+                    if ((j == 0) || (j >= half))
+                        continue;
+
+                    float *a_re         = &re[j * step];
+                    float *a_im         = &im[j * step];
+                    float *b_re         = &re[(items - j) * step];
+                    float *b_im         = &im[(items - j) * step];
+
+                    float fe_re         = (a_re[0] + b_re[0]) * 0.5f;
+                    float fe_im         = (a_im[0] - b_im[0]) * 0.5f;
+                    float fo_re         = a_im[0] + b_im[0];
+                    float fo_im         = b_re[0] - a_re[0];
+
+                    // t = conj(w) * fo
+                    c_re                = w_re[i] * fo_re + w_im[i] * fo_im;
+                    c_im                = w_re[i] * fo_im - w_im[i] * fo_re;
+
+                    a_re[0]             = fe_re + c_re;
+                    a_im[0]             = fe_im + c_im;
+                    b_re[0]             = fe_re - c_re;
+                    b_im[0]             = c_im - fe_im;
+                }
+
+                if ((k += 4) >= half)
+                    break;
+
+                // Rotate w vector
+                for (size_t i=0; i<4; ++i)
+                {
+                    c_re                = w_re[i]*dw[0] - w_im[i]*dw[1];
+                    c_im                = w_re[i]*dw[1] + w_im[i]*dw[0];
+                    w_re[i]             = c_re;
+                    w_im[i]             = c_im;
+                }
+            }
+        }
+
+        /**
+         * Convert the non-negative part of the spectrum X[k] of real signal x[n] of
+         * (1 << rank) points into the packed complex spectrum Z[k] of the signal
+         * z[n] = x[2*n] + j*x[2*n+1] of (1 << (rank-1)) points:
+         *   Z[k]       = Fe[k] + j*Fo[k]
+         *   Z[N/2-k]   = conj(Fe[k]) + j*conj(Fo[k])
+         *   Fe[k]      = (X[k] + conj(X[N/2-k])) / 2
+         *   Fo[k]      = (X[k] - conj(X[N/2-k])) * conj(W^k) / 2
+         *   W          = exp(-2*j*pi/N)
+         *
+         * @param dst packed complex spectrum, can be the same to src_re for the packed data
+         * @param src_re real part of spectrum
+         * @param src_im imaginary part of spectrum
+         * @param step distance between source elements
+         * @param rank rank of the real FFT, should be at least 4
+         */
+        static void real_fft_reverse_split(float *dst, const float *src_re, const float *src_im, size_t step, size_t rank)
+        {
+            size_t half     = 1 << (rank - 2);
+            size_t items    = half << 1;
+
+            // Process the first and the middle points
+            float x0            = src_re[0];
+            float xn            = src_re[items*step];
+            float h_re          = src_re[half*step];
+            float h_im          = src_im[half*step];
+
+            // Process pairs of points
+            float w_re[4], w_im[4], xw[10], c_re, c_im;
+            const float *dw     = &XFFT_DW[(rank - 3) << 1];
+            const float *iw_re  = &XFFT_A_RE[(rank - 3) << 2];
+            const float *iw_im  = &XFFT_A_IM[(rank - 3) << 2];
+            if ((rank - 3) >= XFFT_STAGES)
+            {
+                fft_stage_twiddle(&xw[0], &xw[4], &xw[8], rank - 3);
+                iw_re               = &xw[0];
+                iw_im               = &xw[4];
+                dw                  = &xw[8];
+            }
+
+            for (size_t i=0; i<4; ++i)
+            {
+                w_re[i]             = iw_re[i] * 0.5f;
+                w_im[i]             = iw_im[i] * 0.5f;
+            }
+
+            for (size_t k=0; ; )
+            {
+                for (size_t i=0; i<4; ++i)
+                {
+                    size_t j            = k + i;
+                    if ((j == 0) || (j >= half))
+                        continue;
+
+                    float a_re          = src_re[j * step];
+                    float a_im          = src_im[j * step];
+                    float b_re          = src_re[(items - j) * step];
+                    float b_im          = src_im[(items - j) * step];
+
+                    float fe_re         = (a_re + b_re) * 0.5f;
+                    float fe_im         = (a_im - b_im) * 0.5f;
+                    float d_re          = a_re - b_re;
+                    float d_im          = a_im + b_im;
+
+                    // fo = d * w
+                    c_re                = w_re[i] * d_re - w_im[i] * d_im;
+                    c_im                = w_re[i] * d_im + w_im[i] * d_re;
+
+                    float *za           = &dst[j << 1];
+                    float *zb           = &dst[(items - j) << 1];
+                    za[0]               = fe_re - c_im;
+                    za[1]               = fe_im + c_re;
+                    zb[0]               = fe_re + c_im;
+                    zb[1]               = c_re - fe_im;
+                }
+
+                if ((k += 4) >= half)
+                    break;
+
+                // Rotate w vector
+                for (size_t i=0; i<4; ++i)
+                {
+                    c_re                = w_re[i]*dw[0] - w_im[i]*dw[1];
+                    c_im                = w_re[i]*dw[1] + w_im[i]*dw[0];
+                    w_re[i]             = c_re;
+                    w_im[i]             = c_im;
+                }
+            }
+
+            dst[0]              = (x0 + xn) * 0.5f;
+            dst[1]              = (x0 - xn) * 0.5f;
+            dst[half*2]         = h_re;
+            dst[half*2 + 1]     = -h_im;
+        }
+
+        void real_direct_fft(float *dst_re, float *dst_im, const float *src, size_t rank)
+        {
+            if (rank <= 3)
+            {
+                small_real_direct_fft(dst_re, dst_im, 1, src, rank);
+                return;
+            }
+
+            // Split the signal into even and odd samples
+            size_t items    = 1 << (rank - 1);
+            for (size_t i=0; i<items; ++i, src += 2)
+            {
+                dst_re[i]       = src[0];
+                dst_im[i]       = src[1];
+            }
+
+            dsp::direct_fft(dst_re, dst_im, dst_re, dst_im, rank - 1);
+            real_fft_direct_split(dst_re, dst_im, 1, rank);
+        }
+
+        void packed_real_direct_fft(float *dst, const float *src, size_t rank)
+        {
+            if (rank <= 3)
+            {
+                small_real_direct_fft(&dst[0], &dst[1], 2, src, rank);
+                return;
+            }
+
+            dsp::packed_direct_fft(dst, src, rank - 1);
+            real_fft_direct_split(&dst[0], &dst[1], 2, rank);
+        }
+
+        void real_reverse_fft(float *dst, const float *src_re, const float *src_im, size_t rank)
+        {
+            if (rank <= 3)
+            {
+                small_real_reverse_fft(dst, src_re, src_im, 1, rank);
+                return;
+            }
+
+            real_fft_reverse_split(dst, src_re, src_im, 1, rank);
+            dsp::packed_reverse_fft(dst, dst, rank - 1);
+        }
+
+        void packed_real_reverse_fft(float *dst, const float *src, size_t rank)
+        {
+            if (rank <= 3)
+            {
+                small_real_reverse_fft(dst, &src[0], &src[1], 2, rank);
+                return;
+            }
+
+            real_fft_reverse_split(dst, &src[0], &src[1], 2, rank);
+            dsp::packed_reverse_fft(dst, dst, rank - 1);
+        }
+    } /* namespace generic */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_GENERIC_RFFT_H_ */
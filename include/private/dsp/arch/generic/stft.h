@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 5 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_STFT_H_
+#define PRIVATE_DSP_ARCH_GENERIC_STFT_H_
+
+#ifndef PRIVATE_DSP_ARCH_GENERIC_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_GENERIC_IMPL */
+
+namespace lsp
+{
+    namespace generic
+    {
+        static double stft_bessel_i0(double x)
+        {
+            // Power series of the modified Bessel function of the first kind
+            double x2   = 0.25 * x * x;
+            double term = 1.0;
+            double sum  = 1.0;
+
+            for (size_t k=1; k < 64; ++k)
+            {
+                term       *= x2 / double(k * k);
+                sum        += term;
+                if (term < sum * 1e-12)
+                    break;
+            }
+
+            return sum;
+        }
+
+        void stft_window(float *dst, size_t count, dsp::stft_window_t window, float param)
+        {
+            const double kw = (2.0 * M_PI) / count;
+
+            switch (window)
+            {
+                case dsp::STFT_WND_HANN:
+                    for (size_t i=0; i<count; ++i)
+                        dst[i]  = 0.5 - 0.5 * cos(kw * i);
+                    break;
+
+                case dsp::STFT_WND_HAMMING:
+                    for (size_t i=0; i<count; ++i)
+                        dst[i]  = 0.54 - 0.46 * cos(kw * i);
+                    break;
+
+                case dsp::STFT_WND_BLACKMAN_HARRIS:
+                    for (size_t i=0; i<count; ++i)
+                    {
+                        double a    = kw * i;
+                        dst[i]      = 0.35875 - 0.48829 * cos(a) + 0.14128 * cos(2.0 * a) - 0.01168 * cos(3.0 * a);
+                    }
+                    break;
+
+                case dsp::STFT_WND_KAISER:
+                {
+                    const double beta   = param;
+                    const double norm   = 1.0 / stft_bessel_i0(beta);
+                    const double kx     = 2.0 / count;
+                    for (size_t i=0; i<count; ++i)
+                    {
+                        double x    = kx * i - 1.0;
+                        dst[i]      = stft_bessel_i0(beta * sqrt(1.0 - x * x)) * norm;
+                    }
+                    break;
+                }
+
+                case dsp::STFT_WND_RECTANGULAR:
+                default:
+                    dsp::fill_one(dst, count);
+                    break;
+            }
+        }
+
+        static inline size_t stft_frame_size(size_t rank)
+        {
+            // Packed spectrum of (N/2 + 1) complex numbers, padded to keep the alignment of 64 bytes
+            return ((1 << rank) + 2 + 0x0f) & ~size_t(0x0f);
+        }
+
+        size_t stft_buffer_size(size_t rank)
+        {
+            return (5 << rank) + stft_frame_size(rank);
+        }
+
+        bool stft_init(dsp::stft_t *st, float *buf, size_t rank, size_t hop, dsp::stft_window_t window, float param)
+        {
+            const size_t n  = 1 << rank;
+            if ((rank < 2) || (hop == 0) || (hop > n) || (n % hop))
+                return false;
+
+            st->wa          = buf;
+            st->ws          = &st->wa[n];
+            st->in          = &st->ws[n];
+            st->out         = &st->in[n];
+            st->frame       = &st->out[n];
+            st->tmp         = &st->frame[stft_frame_size(rank)];
+            st->rank        = rank;
+            st->hop         = hop;
+
+            // Compute the analysis window
+            dsp::stft_window(st->wa, n, window, param);
+
+            // The synthesis window is the analysis window normalized by the sum of
+            // squared analysis windows of all overlapping frames, so the chain
+            // of the analysis, resynthesis and the overlap-add becomes transparent
+            for (size_t i=0; i<hop; ++i)
+            {
+                float s         = 0.0f;
+                for (size_t j=i; j<n; j += hop)
+                    s              += st->wa[j] * st->wa[j];
+                s               = (s > 0.0f) ? 1.0f / s : 0.0f;
+                for (size_t j=i; j<n; j += hop)
+                    st->ws[j]       = st->wa[j] * s;
+            }
+
+            dsp::stft_reset(st);
+
+            return true;
+        }
+
+        void stft_reset(dsp::stft_t *st)
+        {
+            const size_t n  = 1 << st->rank;
+
+            dsp::fill_zero(st->in, n);
+            dsp::fill_zero(st->out, n);
+            st->head        = 0;
+            st->fill        = 0;
+        }
+
+        static void stft_frame(dsp::stft_t *st, bool synth, dsp::stft_frame_t func, void *arg)
+        {
+            const size_t n      = 1 << st->rank;
+            const size_t head   = st->head;
+            const size_t tail   = n - head;
+
+            // Unwrap the input ring buffer with the analysis window applied
+            dsp::mul3(st->frame, &st->in[head], st->wa, tail);
+            dsp::mul3(&st->frame[tail], st->in, &st->wa[tail], head);
+            dsp::packed_real_direct_fft(st->frame, st->frame, st->rank);
+
+            if (func != NULL)
+                func(arg, st->frame, st->rank);
+            if (!synth)
+                return;
+
+            // Apply the synthesis window and overlap-add the frame starting at the
+            // ring position of the next sample
+            dsp::packed_real_reverse_fft(st->tmp, st->frame, st->rank);
+            dsp::fmadd3(&st->out[head], st->tmp, st->ws, tail);
+            dsp::fmadd3(st->out, &st->tmp[tail], &st->ws[tail], head);
+        }
+
+        void stft_process(dsp::stft_t *st, float *dst, const float *src, size_t count, dsp::stft_frame_t func, void *arg)
+        {
+            const size_t n  = 1 << st->rank;
+
+            while (count > 0)
+            {
+                size_t to_do    = lsp_min(count, lsp_min(st->hop - st->fill, n - st->head));
+
+                // Source should be consumed first since it may be the same as destination
+                dsp::copy(&st->in[st->head], src, to_do);
+                if (dst != NULL)
+                {
+                    dsp::copy(dst, &st->out[st->head], to_do);
+                    dsp::fill_zero(&st->out[st->head], to_do);
+                    dst            += to_do;
+                }
+
+                src            += to_do;
+                count          -= to_do;
+                st->fill       += to_do;
+                st->head        = (st->head + to_do) & (n - 1);
+
+                if (st->fill >= st->hop)
+                {
+                    st->fill        = 0;
+                    stft_frame(st, dst != NULL, func, arg);
+                }
+            }
+        }
+    } /* namespace generic */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_GENERIC_STFT_H_ */
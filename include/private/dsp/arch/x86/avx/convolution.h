@@ -30,6 +30,175 @@ namespace lsp
 {
     namespace avx
     {
+        /*
+         * Apply 4 samples of the source signal to the whole convolution: the pointers
+         * to the convolution and the destination should be set in c and d
+         */
+        #define CONVOLVE_X4_PASS \
+            __ASM_EMIT("vxorps              %%ymm7, %%ymm7, %%ymm7")        /* ymm7 = 0 */ \
+            __ASM_EMIT("mov                 %[length], %[clen]") \
+            __ASM_EMIT("vbroadcastss        0x00(%[k]), %%ymm0")            /* ymm0 = k0 */ \
+            __ASM_EMIT("vbroadcastss        0x04(%[k]), %%ymm1")            /* ymm1 = k1 */ \
+            __ASM_EMIT("vbroadcastss        0x08(%[k]), %%ymm2")            /* ymm2 = k2 */ \
+            __ASM_EMIT("vbroadcastss        0x0c(%[k]), %%ymm3")            /* ymm3 = k3 */ \
+            /* 8x convolution */ \
+            __ASM_EMIT("sub                 $8, %[clen]") \
+            __ASM_EMIT("jb                  10f") \
+            __ASM_EMIT(".align              16") \
+            __ASM_EMIT("11:") \
+                __ASM_EMIT("vmovups             (%[c]), %%ymm5")                /* ymm5 = c0 c1 c2 c3 c4 c5 c6 c7 */ \
+                __ASM_EMIT("vinsertf128         $1, %%xmm5, %%ymm7, %%ymm4")    /* ymm4 = p0 p1 p2 p3 c0 c1 c2 c3 */ \
+                __ASM_EMIT("vmovaps             %%ymm5, %%ymm7")                /* ymm7 = c0 c1 c2 c3 c4 c5 c6 c7 */ \
+                __ASM_EMIT("vshufps             $0x4e, %%ymm5, %%ymm4, %%ymm5") /* ymm5 = p2 p3 c0 c1 c2 c3 c4 c5 */ \
+                __ASM_EMIT("vshufps             $0x99, %%ymm7, %%ymm5, %%ymm6") /* ymm6 = p3 c0 c1 c2 c3 c4 c5 c6 */ \
+                __ASM_EMIT("vshufps             $0x99, %%ymm5, %%ymm4, %%ymm4") /* ymm4 = p1 p2 p3 c0 c1 c2 c3 c4 */ \
+                __ASM_EMIT("vmulps              %%ymm3, %%ymm4, %%ymm4")        /* ymm4 = k3*p1 ... */ \
+                __ASM_EMIT("vmulps              %%ymm2, %%ymm5, %%ymm5")        /* ymm5 = k2*p2 ... */ \
+                __ASM_EMIT("vmulps              %%ymm1, %%ymm6, %%ymm6")        /* ymm6 = k1*p3 ... */ \
+                __ASM_EMIT("vaddps              %%ymm5, %%ymm4, %%ymm4")        /* ymm4 = k2*p2 + k3*p1 */ \
+                __ASM_EMIT("vaddps              (%[d]), %%ymm6, %%ymm6")        /* ymm6 = d0 + k1*p3 */ \
+                __ASM_EMIT("vmulps              %%ymm0, %%ymm7, %%ymm5")        /* ymm5 = k0*c0 ... */ \
+                __ASM_EMIT("vaddps              %%ymm6, %%ymm4, %%ymm4")        /* ymm4 = d0 + k1*p3 + k2*p2 + k3*p1 */ \
+                __ASM_EMIT("vextractf128        $1, %%ymm7, %%xmm7")            /* xmm7 = c4 c5 c6 c7 */ \
+                __ASM_EMIT("vaddps              %%ymm5, %%ymm4, %%ymm4")        /* ymm4 = d0 + k0*c0 + k1*p3 + k2*p2 + k3*p1 */ \
+                __ASM_EMIT("vmovups             %%ymm4, (%[d])") \
+                __ASM_EMIT("add                 $0x20, %[c]")                   /* c += 8 */ \
+                __ASM_EMIT("add                 $0x20, %[d]")                   /* d += 8 */ \
+                __ASM_EMIT("sub                 $8, %[clen]")                   /* clen -= 8 */ \
+                __ASM_EMIT("jae                 11b") \
+            __ASM_EMIT("10:") \
+            /* 4x convolution */ \
+            __ASM_EMIT("add                 $4, %[clen]") \
+            __ASM_EMIT("jl                  12f") \
+            __ASM_EMIT("vmovaps             %%xmm7, %%xmm4")                /* xmm4 = p0 p1 p2 p3 */ \
+            __ASM_EMIT("vmovups             (%[c]), %%xmm7")                /* xmm7 = c0 c1 c2 c3 */ \
+            __ASM_EMIT("vshufps             $0x4e, %%xmm7, %%xmm4, %%xmm5") /* xmm5 = p2 p3 c0 c1 */ \
+            __ASM_EMIT("vshufps             $0x99, %%xmm7, %%xmm5, %%xmm6") /* xmm6 = p3 c0 c1 c2 */ \
+            __ASM_EMIT("vshufps             $0x99, %%xmm5, %%xmm4, %%xmm4") /* xmm4 = p1 p2 p3 c0 */ \
+            __ASM_EMIT("vmulps              %%xmm3, %%xmm4, %%xmm4")        /* xmm4 = k3*p1 ... */ \
+            __ASM_EMIT("vmulps              %%xmm2, %%xmm5, %%xmm5")        /* xmm5 = k2*p2 ... */ \
+            __ASM_EMIT("vmulps              %%xmm1, %%xmm6, %%xmm6")        /* xmm6 = k1*p3 ... */ \
+            __ASM_EMIT("vaddps              %%xmm5, %%xmm4, %%xmm4")        /* xmm4 = k2*p2 + k3*p1 */ \
+            __ASM_EMIT("vaddps              (%[d]), %%xmm6, %%xmm6")        /* xmm6 = d0 + k1*p3 */ \
+            __ASM_EMIT("vmulps              %%xmm0, %%xmm7, %%xmm5")        /* xmm5 = k0*c0 ... */ \
+            __ASM_EMIT("vaddps              %%xmm6, %%xmm4, %%xmm4")        /* xmm4 = d0 + k1*p3 + k2*p2 + k3*p1 */ \
+            __ASM_EMIT("vaddps              %%xmm5, %%xmm4, %%xmm4")        /* xmm4 = d0 + k0*c0 + k1*p3 + k2*p2 + k3*p1 */ \
+            __ASM_EMIT("vmovups             %%xmm4, (%[d])") \
+            __ASM_EMIT("sub                 $4, %[clen]")                   /* clen -= 4 */ \
+            __ASM_EMIT("add                 $0x10, %[c]")                   /* c += 4 */ \
+            __ASM_EMIT("add                 $0x10, %[d]")                   /* d += 4 */ \
+            __ASM_EMIT("12:") \
+            /* 4x tail */ \
+            __ASM_EMIT("vmovaps             %%xmm7, %%xmm4")                /* xmm4 = p0 p1 p2 p3 */ \
+            __ASM_EMIT("vxorps              %%xmm7, %%xmm7, %%xmm7")        /* xmm7 = 0 0 0 0 */ \
+            __ASM_EMIT("vmovhlps            %%xmm4, %%xmm7, %%xmm5")        /* xmm5 = p2 p3 0 0 */ \
+            __ASM_EMIT("vshufps             $0x99, %%xmm7, %%xmm5, %%xmm6") /* xmm6 = p3 0 0 0 */ \
+            __ASM_EMIT("vshufps             $0x99, %%xmm5, %%xmm4, %%xmm4") /* xmm4 = p1 p2 p3 0 */ \
+            __ASM_EMIT("vmovlps             0x00(%[d]), %%xmm0, %%xmm0")    /* xmm0 = d0 d1 */ \
+            __ASM_EMIT("vmovss              0x08(%[d]), %%xmm7")            /* xmm7 = d2 0 */ \
+            __ASM_EMIT("vmovlhps            %%xmm7, %%xmm0, %%xmm0")        /* xmm0 = d0 d1 d2 0 */ \
+            __ASM_EMIT("vmulps              %%xmm3, %%xmm4, %%xmm4")        /* xmm4 = k3*p1 ... */ \
+            __ASM_EMIT("vmulps              %%xmm2, %%xmm5, %%xmm5")        /* xmm5 = k2*p2 ... */ \
+            __ASM_EMIT("vmulps              %%xmm1, %%xmm6, %%xmm6")        /* xmm6 = k1*p3 ... */ \
+            __ASM_EMIT("vaddps              %%xmm5, %%xmm4, %%xmm4")        /* xmm4 = k2*p2 + k3*p1 */ \
+            __ASM_EMIT("vaddps              %%xmm0, %%xmm6, %%xmm6")        /* xmm6 = d0 + k1*p3 */ \
+            __ASM_EMIT("vaddps              %%xmm4, %%xmm6, %%xmm6")        /* xmm6 = d0 + k1*p3 + k2*p2 + k3*p1 */ \
+            __ASM_EMIT("vmovhlps            %%xmm6, %%xmm7, %%xmm7") \
+            __ASM_EMIT("vmovlps             %%xmm6, 0x00(%[d])") \
+            __ASM_EMIT("vmovss              %%xmm7, 0x08(%[d])") \
+            /* 1x convolution */ \
+            __ASM_EMIT("add                 $3, %[clen]")                   /* while (clen >= 0) */ \
+            __ASM_EMIT("jl                  14f") \
+            __ASM_EMIT("vmovups             0x00(%[k]), %%xmm1")            /* xmm1 = k0 k1 k2 k3 */ \
+            __ASM_EMIT("15:") \
+                __ASM_EMIT("vbroadcastss        0x00(%[c]), %%xmm0")            /* xmm0 = c0 c0 c0 c0 */ \
+                __ASM_EMIT("vmulps              %%xmm1, %%xmm0, %%xmm0")        /* xmm0 = k0*c0 k1*c0 k2*c0 k3*c0 */ \
+                __ASM_EMIT("vaddps              0x00(%[d]), %%xmm0, %%xmm0")    /* xmm0 = d0+k0*c0 d1+k1*c0 d2+k2*c0 d3+k3*c0 */ \
+                __ASM_EMIT("vmovups             %%xmm0, 0x00(%[d])") \
+                __ASM_EMIT("add                 $0x04, %[c]")               /* c++ */ \
+                __ASM_EMIT("add                 $0x04, %[d]")               /* d++ */ \
+                __ASM_EMIT("dec                 %[clen]")                   /* clen-- */ \
+                __ASM_EMIT("jge                 15b") \
+            __ASM_EMIT("14:")
+
+        #define CONVOLVE_X4_PASS_FMA3 \
+            __ASM_EMIT("vxorps              %%ymm7, %%ymm7, %%ymm7")        /* ymm7 = 0 */ \
+            __ASM_EMIT("mov                 %[length], %[clen]") \
+            __ASM_EMIT("vbroadcastss        0x00(%[k]), %%ymm0")            /* ymm0 = k0 */ \
+            __ASM_EMIT("vbroadcastss        0x04(%[k]), %%ymm1")            /* ymm1 = k1 */ \
+            __ASM_EMIT("vbroadcastss        0x08(%[k]), %%ymm2")            /* ymm2 = k2 */ \
+            __ASM_EMIT("vbroadcastss        0x0c(%[k]), %%ymm3")            /* ymm3 = k3 */ \
+            /* 8x convolution */ \
+            __ASM_EMIT("sub                 $8, %[clen]") \
+            __ASM_EMIT("jb                  10f") \
+            __ASM_EMIT(".align              16") \
+            __ASM_EMIT("11:") \
+                __ASM_EMIT("vmovups             (%[c]), %%ymm5")                /* ymm5 = c0 c1 c2 c3 c4 c5 c6 c7 */ \
+                __ASM_EMIT("vinsertf128         $1, %%xmm5, %%ymm7, %%ymm4")    /* ymm4 = p0 p1 p2 p3 c0 c1 c2 c3 */ \
+                __ASM_EMIT("vmovaps             %%ymm5, %%ymm7")                /* ymm7 = c0 c1 c2 c3 c4 c5 c6 c7 */ \
+                __ASM_EMIT("vshufps             $0x4e, %%ymm5, %%ymm4, %%ymm5") /* ymm5 = p2 p3 c0 c1 c2 c3 c4 c5 */ \
+                __ASM_EMIT("vshufps             $0x99, %%ymm5, %%ymm4, %%ymm4") /* ymm4 = p1 p2 p3 c0 c1 c2 c3 c4 */ \
+                __ASM_EMIT("vshufps             $0x99, %%ymm7, %%ymm5, %%ymm6") /* ymm6 = p3 c0 c1 c2 c3 c4 c5 c6 */ \
+                __ASM_EMIT("vfmadd213ps         (%[d]), %%ymm3, %%ymm4")        /* ymm4 = d0 + k3*p1 ... */ \
+                __ASM_EMIT("vmulps              %%ymm2, %%ymm5, %%ymm5")        /* ymm5 = k2*p2 ... */ \
+                __ASM_EMIT("vfmadd231ps         %%ymm0, %%ymm7, %%ymm4")        /* ymm4 = d0 + k0*c0 + k3*p1 ... */ \
+                __ASM_EMIT("vfmadd213ps         %%ymm5, %%ymm1, %%ymm6")        /* ymm6 = k1*p3 + k2*p2 */ \
+                __ASM_EMIT("vextractf128        $1, %%ymm7, %%xmm7")            /* xmm7 = c4 c5 c6 c7 */ \
+                __ASM_EMIT("vaddps              %%ymm6, %%ymm4, %%ymm4")        /* ymm4 = d0 + k0*c0 + k1*p3 + k2*p2 + k3*p1 */ \
+                __ASM_EMIT("vmovups             %%ymm4, (%[d])") \
+                __ASM_EMIT("add                 $0x20, %[c]")                   /* c += 8 */ \
+                __ASM_EMIT("add                 $0x20, %[d]")                   /* d += 8 */ \
+                __ASM_EMIT("sub                 $8, %[clen]")                   /* clen -= 8 */ \
+                __ASM_EMIT("jae                 11b") \
+            __ASM_EMIT("10:") \
+            /* 4x convolution */ \
+            __ASM_EMIT("add                 $4, %[clen]") \
+            __ASM_EMIT("jl                  12f") \
+            __ASM_EMIT("vmovaps             %%xmm7, %%xmm4")                /* xmm4 = p0 p1 p2 p3 */ \
+            __ASM_EMIT("vmovups             (%[c]), %%xmm7")                /* xmm7 = c0 c1 c2 c3 */ \
+            __ASM_EMIT("vshufps             $0x4e, %%xmm7, %%xmm4, %%xmm5") /* xmm5 = p2 p3 c0 c1 */ \
+            __ASM_EMIT("vshufps             $0x99, %%xmm7, %%xmm5, %%xmm6") /* xmm6 = p3 c0 c1 c2 */ \
+            __ASM_EMIT("vshufps             $0x99, %%xmm5, %%xmm4, %%xmm4") /* xmm4 = p1 p2 p3 c0 */ \
+            __ASM_EMIT("vmulps              %%xmm2, %%xmm5, %%xmm5")        /* xmm5 = k2*p2 ... */ \
+            __ASM_EMIT("vfmadd213ps         (%[d]), %%xmm3, %%xmm4")        /* xmm4 = d0 + k3*p1 ... */ \
+            __ASM_EMIT("vfmadd213ps         %%xmm5, %%xmm1, %%xmm6")        /* xmm6 = k1*p3 + k2*p2 */ \
+            __ASM_EMIT("vfmadd231ps         %%xmm0, %%xmm7, %%xmm4")        /* xmm4 = d0 + k0*c0 + k3*p1 ... */ \
+            __ASM_EMIT("vaddps              %%xmm6, %%xmm4, %%xmm4")        /* xmm4 = d0 + k0*c0 + k1*p3 + k2*p2 + k3*p1 */ \
+            __ASM_EMIT("vmovups             %%xmm4, (%[d])") \
+            __ASM_EMIT("sub                 $4, %[clen]")                   /* clen -= 4 */ \
+            __ASM_EMIT("add                 $0x10, %[c]")                   /* c += 4 */ \
+            __ASM_EMIT("add                 $0x10, %[d]")                   /* d += 4 */ \
+            __ASM_EMIT("12:") \
+            /* 4x tail */ \
+            __ASM_EMIT("vmovaps             %%xmm7, %%xmm4")                /* xmm4 = p0 p1 p2 p3 */ \
+            __ASM_EMIT("vxorps              %%xmm7, %%xmm7, %%xmm7")        /* xmm7 = 0 0 0 0 */ \
+            __ASM_EMIT("vmovhlps            %%xmm4, %%xmm7, %%xmm5")        /* xmm5 = p2 p3 0 0 */ \
+            __ASM_EMIT("vshufps             $0x99, %%xmm7, %%xmm5, %%xmm6") /* xmm6 = p3 0 0 0 */ \
+            __ASM_EMIT("vmovlps             0x00(%[d]), %%xmm0, %%xmm0")    /* xmm0 = d0 d1 */ \
+            __ASM_EMIT("vshufps             $0x99, %%xmm5, %%xmm4, %%xmm4") /* xmm4 = p1 p2 p3 0 */ \
+            __ASM_EMIT("vmovss              0x08(%[d]), %%xmm7")            /* xmm7 = d2 0 */ \
+            __ASM_EMIT("vmovlhps            %%xmm7, %%xmm0, %%xmm0")        /* xmm0 = d0 d1 d2 0 */ \
+            __ASM_EMIT("vmulps              %%xmm3, %%xmm4, %%xmm4")        /* xmm4 = k3*p1 ... */ \
+            __ASM_EMIT("vfmadd213ps         %%xmm0, %%xmm2, %%xmm5")        /* xmm5 = d0 + k2*p2 ... */ \
+            __ASM_EMIT("vfmadd213ps         %%xmm4, %%xmm1, %%xmm6")        /* xmm6 = k1*p3 + k3*p1 ... */ \
+            __ASM_EMIT("vaddps              %%xmm5, %%xmm6, %%xmm6")        /* xmm6 = d0 + k1*p3 + k2*p2 + k3*p1 */ \
+            __ASM_EMIT("vmovhlps            %%xmm6, %%xmm7, %%xmm7") \
+            __ASM_EMIT("vmovlps             %%xmm6, 0x00(%[d])") \
+            __ASM_EMIT("vmovss              %%xmm7, 0x08(%[d])") \
+            /* 1x convolution */ \
+            __ASM_EMIT("add                 $3, %[clen]")                   /* while (clen >= 0) */ \
+            __ASM_EMIT("jl                  14f") \
+            __ASM_EMIT("vmovups             0x00(%[k]), %%xmm1")            /* xmm1 = k0 k1 k2 k3 */ \
+            __ASM_EMIT("15:") \
+                __ASM_EMIT("vbroadcastss        0x00(%[c]), %%xmm0")            /* xmm0 = c0 c0 c0 c0 */ \
+                __ASM_EMIT("vfmadd213ps         0x00(%[d]), %%xmm1, %%xmm0")    /* xmm0 = d0+k0*c0 d1+k1*c0 d2+k2*c0 d3+k3*c0 */ \
+                __ASM_EMIT("vmovups             %%xmm0, 0x00(%[d])") \
+                __ASM_EMIT("add                 $0x04, %[c]")               /* c++ */ \
+                __ASM_EMIT("add                 $0x04, %[d]")               /* d++ */ \
+                __ASM_EMIT("dec                 %[clen]")                   /* clen-- */ \
+                __ASM_EMIT("jge                 15b") \
+            __ASM_EMIT("14:")
+
         void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count)
         {
             IF_ARCH_X86(
@@ -43,94 +212,9 @@ namespace lsp
                 __ASM_EMIT("sub                 $4, %[count]")
                 __ASM_EMIT("jb                  200f")
                 __ASM_EMIT("100:")
-                    __ASM_EMIT("vxorps              %%ymm7, %%ymm7, %%ymm7")        // ymm7 = 0
-                    __ASM_EMIT("mov                 %[length], %[clen]")
                     __ASM_EMIT("mov                 %[dst], %[d]")
                     __ASM_EMIT("mov                 %[conv], %[c]")
-
-                    __ASM_EMIT("vbroadcastss        0x00(%[k]), %%ymm0")            // ymm0 = k0
-                    __ASM_EMIT("vbroadcastss        0x04(%[k]), %%ymm1")            // ymm1 = k1
-                    __ASM_EMIT("vbroadcastss        0x08(%[k]), %%ymm2")            // ymm2 = k2
-                    __ASM_EMIT("vbroadcastss        0x0c(%[k]), %%ymm3")            // ymm3 = k3
-                    // 8x convolution
-                    __ASM_EMIT("sub                 $8, %[clen]")
-                    __ASM_EMIT("jb                  10f")
-                    __ASM_EMIT(".align              16")
-                    __ASM_EMIT("11:")
-                        __ASM_EMIT("vmovups             (%[c]), %%ymm5")                // ymm5 = c0 c1 c2 c3 c4 c5 c6 c7
-                        __ASM_EMIT("vinsertf128         $1, %%xmm5, %%ymm7, %%ymm4")    // ymm4 = p0 p1 p2 p3 c0 c1 c2 c3
-                        __ASM_EMIT("vmovaps             %%ymm5, %%ymm7")                // ymm7 = c0 c1 c2 c3 c4 c5 c6 c7
-                        __ASM_EMIT("vshufps             $0x4e, %%ymm5, %%ymm4, %%ymm5") // ymm5 = p2 p3 c0 c1 c2 c3 c4 c5
-                        __ASM_EMIT("vshufps             $0x99, %%ymm7, %%ymm5, %%ymm6") // ymm6 = p3 c0 c1 c2 c3 c4 c5 c6
-                        __ASM_EMIT("vshufps             $0x99, %%ymm5, %%ymm4, %%ymm4") // ymm4 = p1 p2 p3 c0 c1 c2 c3 c4
-                        __ASM_EMIT("vmulps              %%ymm3, %%ymm4, %%ymm4")        // ymm4 = k3*p1 ...
-                        __ASM_EMIT("vmulps              %%ymm2, %%ymm5, %%ymm5")        // ymm5 = k2*p2 ...
-                        __ASM_EMIT("vmulps              %%ymm1, %%ymm6, %%ymm6")        // ymm6 = k1*p3 ...
-                        __ASM_EMIT("vaddps              %%ymm5, %%ymm4, %%ymm4")        // ymm4 = k2*p2 + k3*p1
-                        __ASM_EMIT("vaddps              (%[d]), %%ymm6, %%ymm6")        // ymm6 = d0 + k1*p3
-                        __ASM_EMIT("vmulps              %%ymm0, %%ymm7, %%ymm5")        // ymm5 = k0*c0 ...
-                        __ASM_EMIT("vaddps              %%ymm6, %%ymm4, %%ymm4")        // ymm4 = d0 + k1*p3 + k2*p2 + k3*p1
-                        __ASM_EMIT("vextractf128        $1, %%ymm7, %%xmm7")            // xmm7 = c4 c5 c6 c7
-                        __ASM_EMIT("vaddps              %%ymm5, %%ymm4, %%ymm4")        // ymm4 = d0 + k0*c0 + k1*p3 + k2*p2 + k3*p1
-                        __ASM_EMIT("vmovups             %%ymm4, (%[d])")
-                        __ASM_EMIT("add                 $0x20, %[c]")                   // c += 8
-                        __ASM_EMIT("add                 $0x20, %[d]")                   // d += 8
-                        __ASM_EMIT("sub                 $8, %[clen]")                   // clen -= 8
-                        __ASM_EMIT("jae                 11b")
-                    __ASM_EMIT("10:")
-                    // 4x convolution
-                    __ASM_EMIT("add                 $4, %[clen]")
-                    __ASM_EMIT("jl                  12f")
-                    __ASM_EMIT("vmovaps             %%xmm7, %%xmm4")                // xmm4 = p0 p1 p2 p3
-                    __ASM_EMIT("vmovups             (%[c]), %%xmm7")                // xmm7 = c0 c1 c2 c3
-                    __ASM_EMIT("vshufps             $0x4e, %%xmm7, %%xmm4, %%xmm5") // xmm5 = p2 p3 c0 c1
-                    __ASM_EMIT("vshufps             $0x99, %%xmm7, %%xmm5, %%xmm6") // xmm6 = p3 c0 c1 c2
-                    __ASM_EMIT("vshufps             $0x99, %%xmm5, %%xmm4, %%xmm4") // xmm4 = p1 p2 p3 c0
-                    __ASM_EMIT("vmulps              %%xmm3, %%xmm4, %%xmm4")        // xmm4 = k3*p1 ...
-                    __ASM_EMIT("vmulps              %%xmm2, %%xmm5, %%xmm5")        // xmm5 = k2*p2 ...
-                    __ASM_EMIT("vmulps              %%xmm1, %%xmm6, %%xmm6")        // xmm6 = k1*p3 ...
-                    __ASM_EMIT("vaddps              %%xmm5, %%xmm4, %%xmm4")        // xmm4 = k2*p2 + k3*p1
-                    __ASM_EMIT("vaddps              (%[d]), %%xmm6, %%xmm6")        // xmm6 = d0 + k1*p3
-                    __ASM_EMIT("vmulps              %%xmm0, %%xmm7, %%xmm5")        // xmm5 = k0*c0 ...
-                    __ASM_EMIT("vaddps              %%xmm6, %%xmm4, %%xmm4")        // xmm4 = d0 + k1*p3 + k2*p2 + k3*p1
-                    __ASM_EMIT("vaddps              %%xmm5, %%xmm4, %%xmm4")        // xmm4 = d0 + k0*c0 + k1*p3 + k2*p2 + k3*p1
-                    __ASM_EMIT("vmovups             %%xmm4, (%[d])")
-                    __ASM_EMIT("sub                 $4, %[clen]")                   // clen -= 4
-                    __ASM_EMIT("add                 $0x10, %[c]")                   // c += 4
-                    __ASM_EMIT("add                 $0x10, %[d]")                   // d += 4
-                    __ASM_EMIT("12:")
-                    // 4x tail
-                    __ASM_EMIT("vmovaps             %%xmm7, %%xmm4")                // xmm4 = p0 p1 p2 p3
-                    __ASM_EMIT("vxorps              %%xmm7, %%xmm7, %%xmm7")        // xmm7 = 0 0 0 0
-                    __ASM_EMIT("vmovhlps            %%xmm4, %%xmm7, %%xmm5")        // xmm5 = p2 p3 0 0
-                    __ASM_EMIT("vshufps             $0x99, %%xmm7, %%xmm5, %%xmm6") // xmm6 = p3 0 0 0
-                    __ASM_EMIT("vshufps             $0x99, %%xmm5, %%xmm4, %%xmm4") // xmm4 = p1 p2 p3 0
-                    __ASM_EMIT("vmovlps             0x00(%[d]), %%xmm0, %%xmm0")    // xmm0 = d0 d1
-                    __ASM_EMIT("vmovss              0x08(%[d]), %%xmm7")            // xmm7 = d2 0
-                    __ASM_EMIT("vmovlhps            %%xmm7, %%xmm0, %%xmm0")        // xmm0 = d0 d1 d2 0
-                    __ASM_EMIT("vmulps              %%xmm3, %%xmm4, %%xmm4")        // xmm4 = k3*p1 ...
-                    __ASM_EMIT("vmulps              %%xmm2, %%xmm5, %%xmm5")        // xmm5 = k2*p2 ...
-                    __ASM_EMIT("vmulps              %%xmm1, %%xmm6, %%xmm6")        // xmm6 = k1*p3 ...
-                    __ASM_EMIT("vaddps              %%xmm5, %%xmm4, %%xmm4")        // xmm4 = k2*p2 + k3*p1
-                    __ASM_EMIT("vaddps              %%xmm0, %%xmm6, %%xmm6")        // xmm6 = d0 + k1*p3
-                    __ASM_EMIT("vaddps              %%xmm4, %%xmm6, %%xmm6")        // xmm6 = d0 + k1*p3 + k2*p2 + k3*p1
-                    __ASM_EMIT("vmovhlps            %%xmm6, %%xmm7, %%xmm7")
-                    __ASM_EMIT("vmovlps             %%xmm6, 0x00(%[d])")
-                    __ASM_EMIT("vmovss              %%xmm7, 0x08(%[d])")
-                    // 1x convolution
-                    __ASM_EMIT("add                 $3, %[clen]")                   // while (clen >= 0)
-                    __ASM_EMIT("jl                  14f")
-                    __ASM_EMIT("vmovups             0x00(%[k]), %%xmm1")            // xmm1 = k0 k1 k2 k3
-                    __ASM_EMIT("15:")
-                        __ASM_EMIT("vbroadcastss        0x00(%[c]), %%xmm0")            // xmm0 = c0 c0 c0 c0
-                        __ASM_EMIT("vmulps              %%xmm1, %%xmm0, %%xmm0")        // xmm0 = k0*c0 k1*c0 k2*c0 k3*c0
-                        __ASM_EMIT("vaddps              0x00(%[d]), %%xmm0, %%xmm0")    // xmm0 = d0+k0*c0 d1+k1*c0 d2+k2*c0 d3+k3*c0
-                        __ASM_EMIT("vmovups             %%xmm0, 0x00(%[d])")
-                        __ASM_EMIT("add                 $0x04, %[c]")               // c++
-                        __ASM_EMIT("add                 $0x04, %[d]")               // d++
-                        __ASM_EMIT("dec                 %[clen]")                   // clen--
-                        __ASM_EMIT("jge                 15b")
-                    __ASM_EMIT("14:")
+                    CONVOLVE_X4_PASS
                 __ASM_EMIT64("add               $0x10, %[dst]")         // dst += 4
                 __ASM_EMIT32("addl              $0x10, %[dst]")
                 __ASM_EMIT("add                 $0x10, %[k]")           // k += 4
@@ -234,6 +318,62 @@ namespace lsp
             );
         }
 
+        void convolve_multi(float * const *dst, const float *src, const float * const *conv, size_t length, size_t count, size_t n)
+        {
+            const size_t head   = count & ~size_t(3);
+            size_t blocks       = count >> 2;
+            size_t off          = 0;
+            const float *k      = src;
+            IF_ARCH_X86(
+                const float *c;
+                float *d;
+                size_t clen, i;
+            );
+
+            if (n == 0)
+                return;
+
+            // Each block of 4 source samples is applied to all convolutions at once,
+            // so the destination of each convolution is updated once per block
+            if (blocks > 0)
+            {
+                ARCH_X86_ASM(
+                    __ASM_EMIT("100:")
+                        __ASM_EMIT("mov                 %[n], %[i]")
+                        __ASM_EMIT("200:")
+                            __ASM_EMIT("mov                 %[vc], %[c]")
+                            __ASM_EMIT("mov                 %[vd], %[d]")
+                            __ASM_EMIT("mov                 -%c[ptr](%[c], %[i], %c[ptr]), %[c]")     // c = conv[i-1]
+                            __ASM_EMIT("mov                 -%c[ptr](%[d], %[i], %c[ptr]), %[d]")     // d = dst[i-1]
+                            __ASM_EMIT("add                 %[off], %[d]")                          // d += off
+                            CONVOLVE_X4_PASS
+                            __ASM_EMIT("dec                 %[i]")
+                            __ASM_EMIT("jnz                 200b")
+                        __ASM_EMIT64("add               $0x10, %[off]")         // off += 4
+                        __ASM_EMIT32("addl              $0x10, %[off]")
+                        __ASM_EMIT("add                 $0x10, %[k]")           // k += 4
+                        __ASM_EMIT64("dec               %[blocks]")
+                        __ASM_EMIT32("decl              %[blocks]")
+                        __ASM_EMIT("jnz                 100b")
+                    : [k] "+r" (k), [off] X86_PGREG (off), [blocks] X86_PGREG (blocks),
+                      [c] "=&r" (c), [d] "=&r" (d), [clen] "=&r" (clen), [i] "=&r" (i)
+                    : [vc] X86_GREG (conv), [vd] X86_GREG (dst),
+                      [length] X86_GREG (length), [n] X86_GREG (n),
+                      [ptr] "i" (sizeof(float *))
+                    : "cc", "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                      "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+                );
+            }
+
+            // Apply the tail of the source signal
+            if (head < count)
+            {
+                for (size_t j=0; j<n; ++j)
+                    convolve(&dst[j][head], &src[head], conv[j], length, count - head);
+            }
+        }
+
         void convolve_fma3(float *dst, const float *src, const float *conv, size_t length, size_t count)
         {
             IF_ARCH_X86(
@@ -247,85 +387,9 @@ namespace lsp
                 __ASM_EMIT("sub                 $4, %[count]")
                 __ASM_EMIT("jb                  200f")
                 __ASM_EMIT("100:")
-                    __ASM_EMIT("vxorps              %%ymm7, %%ymm7, %%ymm7")        // ymm7 = 0
-                    __ASM_EMIT("mov                 %[length], %[clen]")
                     __ASM_EMIT("mov                 %[dst], %[d]")
                     __ASM_EMIT("mov                 %[conv], %[c]")
-
-                    __ASM_EMIT("vbroadcastss        0x00(%[k]), %%ymm0")            // ymm0 = k0
-                    __ASM_EMIT("vbroadcastss        0x04(%[k]), %%ymm1")            // ymm1 = k1
-                    __ASM_EMIT("vbroadcastss        0x08(%[k]), %%ymm2")            // ymm2 = k2
-                    __ASM_EMIT("vbroadcastss        0x0c(%[k]), %%ymm3")            // ymm3 = k3
-                    // 8x convolution
-                    __ASM_EMIT("sub                 $8, %[clen]")
-                    __ASM_EMIT("jb                  10f")
-                    __ASM_EMIT(".align              16")
-                    __ASM_EMIT("11:")
-                        __ASM_EMIT("vmovups             (%[c]), %%ymm5")                // ymm5 = c0 c1 c2 c3 c4 c5 c6 c7
-                        __ASM_EMIT("vinsertf128         $1, %%xmm5, %%ymm7, %%ymm4")    // ymm4 = p0 p1 p2 p3 c0 c1 c2 c3
-                        __ASM_EMIT("vmovaps             %%ymm5, %%ymm7")                // ymm7 = c0 c1 c2 c3 c4 c5 c6 c7
-                        __ASM_EMIT("vshufps             $0x4e, %%ymm5, %%ymm4, %%ymm5") // ymm5 = p2 p3 c0 c1 c2 c3 c4 c5
-                        __ASM_EMIT("vshufps             $0x99, %%ymm5, %%ymm4, %%ymm4") // ymm4 = p1 p2 p3 c0 c1 c2 c3 c4
-                        __ASM_EMIT("vshufps             $0x99, %%ymm7, %%ymm5, %%ymm6") // ymm6 = p3 c0 c1 c2 c3 c4 c5 c6
-                        __ASM_EMIT("vfmadd213ps         (%[d]), %%ymm3, %%ymm4")        // ymm4 = d0 + k3*p1 ...
-                        __ASM_EMIT("vmulps              %%ymm2, %%ymm5, %%ymm5")        // ymm5 = k2*p2 ...
-                        __ASM_EMIT("vfmadd231ps         %%ymm0, %%ymm7, %%ymm4")        // ymm4 = d0 + k0*c0 + k3*p1 ...
-                        __ASM_EMIT("vfmadd213ps         %%ymm5, %%ymm1, %%ymm6")        // ymm6 = k1*p3 + k2*p2
-                        __ASM_EMIT("vextractf128        $1, %%ymm7, %%xmm7")            // xmm7 = c4 c5 c6 c7
-                        __ASM_EMIT("vaddps              %%ymm6, %%ymm4, %%ymm4")        // ymm4 = d0 + k0*c0 + k1*p3 + k2*p2 + k3*p1
-                        __ASM_EMIT("vmovups             %%ymm4, (%[d])")
-                        __ASM_EMIT("add                 $0x20, %[c]")                   // c += 8
-                        __ASM_EMIT("add                 $0x20, %[d]")                   // d += 8
-                        __ASM_EMIT("sub                 $8, %[clen]")                   // clen -= 8
-                        __ASM_EMIT("jae                 11b")
-                    __ASM_EMIT("10:")
-                    // 4x convolution
-                    __ASM_EMIT("add                 $4, %[clen]")
-                    __ASM_EMIT("jl                  12f")
-                    __ASM_EMIT("vmovaps             %%xmm7, %%xmm4")                // xmm4 = p0 p1 p2 p3
-                    __ASM_EMIT("vmovups             (%[c]), %%xmm7")                // xmm7 = c0 c1 c2 c3
-                    __ASM_EMIT("vshufps             $0x4e, %%xmm7, %%xmm4, %%xmm5") // xmm5 = p2 p3 c0 c1
-                    __ASM_EMIT("vshufps             $0x99, %%xmm7, %%xmm5, %%xmm6") // xmm6 = p3 c0 c1 c2
-                    __ASM_EMIT("vshufps             $0x99, %%xmm5, %%xmm4, %%xmm4") // xmm4 = p1 p2 p3 c0
-                    __ASM_EMIT("vmulps              %%xmm2, %%xmm5, %%xmm5")        // xmm5 = k2*p2 ...
-                    __ASM_EMIT("vfmadd213ps         (%[d]), %%xmm3, %%xmm4")        // xmm4 = d0 + k3*p1 ...
-                    __ASM_EMIT("vfmadd213ps         %%xmm5, %%xmm1, %%xmm6")        // xmm6 = k1*p3 + k2*p2
-                    __ASM_EMIT("vfmadd231ps         %%xmm0, %%xmm7, %%xmm4")        // xmm4 = d0 + k0*c0 + k3*p1 ...
-                    __ASM_EMIT("vaddps              %%xmm6, %%xmm4, %%xmm4")        // xmm4 = d0 + k0*c0 + k1*p3 + k2*p2 + k3*p1
-                    __ASM_EMIT("vmovups             %%xmm4, (%[d])")
-                    __ASM_EMIT("sub                 $4, %[clen]")                   // clen -= 4
-                    __ASM_EMIT("add                 $0x10, %[c]")                   // c += 4
-                    __ASM_EMIT("add                 $0x10, %[d]")                   // d += 4
-                    __ASM_EMIT("12:")
-                    // 4x tail
-                    __ASM_EMIT("vmovaps             %%xmm7, %%xmm4")                // xmm4 = p0 p1 p2 p3
-                    __ASM_EMIT("vxorps              %%xmm7, %%xmm7, %%xmm7")        // xmm7 = 0 0 0 0
-                    __ASM_EMIT("vmovhlps            %%xmm4, %%xmm7, %%xmm5")        // xmm5 = p2 p3 0 0
-                    __ASM_EMIT("vshufps             $0x99, %%xmm7, %%xmm5, %%xmm6") // xmm6 = p3 0 0 0
-                    __ASM_EMIT("vmovlps             0x00(%[d]), %%xmm0, %%xmm0")    // xmm0 = d0 d1
-                    __ASM_EMIT("vshufps             $0x99, %%xmm5, %%xmm4, %%xmm4") // xmm4 = p1 p2 p3 0
-                    __ASM_EMIT("vmovss              0x08(%[d]), %%xmm7")            // xmm7 = d2 0
-                    __ASM_EMIT("vmovlhps            %%xmm7, %%xmm0, %%xmm0")        // xmm0 = d0 d1 d2 0
-                    __ASM_EMIT("vmulps              %%xmm3, %%xmm4, %%xmm4")        // xmm4 = k3*p1 ...
-                    __ASM_EMIT("vfmadd213ps         %%xmm0, %%xmm2, %%xmm5")        // xmm5 = d0 + k2*p2 ...
-                    __ASM_EMIT("vfmadd213ps         %%xmm4, %%xmm1, %%xmm6")        // xmm6 = k1*p3 + k3*p1 ...
-                    __ASM_EMIT("vaddps              %%xmm5, %%xmm6, %%xmm6")        // xmm6 = d0 + k1*p3 + k2*p2 + k3*p1
-                    __ASM_EMIT("vmovhlps            %%xmm6, %%xmm7, %%xmm7")
-                    __ASM_EMIT("vmovlps             %%xmm6, 0x00(%[d])")
-                    __ASM_EMIT("vmovss              %%xmm7, 0x08(%[d])")
-                    // 1x convolution
-                    __ASM_EMIT("add                 $3, %[clen]")                   // while (clen >= 0)
-                    __ASM_EMIT("jl                  14f")
-                    __ASM_EMIT("vmovups             0x00(%[k]), %%xmm1")            // xmm1 = k0 k1 k2 k3
-                    __ASM_EMIT("15:")
-                        __ASM_EMIT("vbroadcastss        0x00(%[c]), %%xmm0")            // xmm0 = c0 c0 c0 c0
-                        __ASM_EMIT("vfmadd213ps         0x00(%[d]), %%xmm1, %%xmm0")    // xmm0 = d0+k0*c0 d1+k1*c0 d2+k2*c0 d3+k3*c0
-                        __ASM_EMIT("vmovups             %%xmm0, 0x00(%[d])")
-                        __ASM_EMIT("add                 $0x04, %[c]")               // c++
-                        __ASM_EMIT("add                 $0x04, %[d]")               // d++
-                        __ASM_EMIT("dec                 %[clen]")                   // clen--
-                        __ASM_EMIT("jge                 15b")
-                    __ASM_EMIT("14:")
+                    CONVOLVE_X4_PASS_FMA3
                 __ASM_EMIT64("add               $0x10, %[dst]")         // dst += 4
                 __ASM_EMIT32("addl              $0x10, %[dst]")
                 __ASM_EMIT("add                 $0x10, %[k]")           // k += 4
@@ -428,6 +492,65 @@ namespace lsp
                   "%xmm4", "%xmm5", "%xmm6", "%xmm7"
             );
         }
+
+        void convolve_multi_fma3(float * const *dst, const float *src, const float * const *conv, size_t length, size_t count, size_t n)
+        {
+            const size_t head   = count & ~size_t(3);
+            size_t blocks       = count >> 2;
+            size_t off          = 0;
+            const float *k      = src;
+            IF_ARCH_X86(
+                const float *c;
+                float *d;
+                size_t clen, i;
+            );
+
+            if (n == 0)
+                return;
+
+            // Each block of 4 source samples is applied to all convolutions at once,
+            // so the destination of each convolution is updated once per block
+            if (blocks > 0)
+            {
+                ARCH_X86_ASM(
+                    __ASM_EMIT("100:")
+                        __ASM_EMIT("mov                 %[n], %[i]")
+                        __ASM_EMIT("200:")
+                            __ASM_EMIT("mov                 %[vc], %[c]")
+                            __ASM_EMIT("mov                 %[vd], %[d]")
+                            __ASM_EMIT("mov                 -%c[ptr](%[c], %[i], %c[ptr]), %[c]")     // c = conv[i-1]
+                            __ASM_EMIT("mov                 -%c[ptr](%[d], %[i], %c[ptr]), %[d]")     // d = dst[i-1]
+                            __ASM_EMIT("add                 %[off], %[d]")                          // d += off
+                            CONVOLVE_X4_PASS_FMA3
+                            __ASM_EMIT("dec                 %[i]")
+                            __ASM_EMIT("jnz                 200b")
+                        __ASM_EMIT64("add               $0x10, %[off]")         // off += 4
+                        __ASM_EMIT32("addl              $0x10, %[off]")
+                        __ASM_EMIT("add                 $0x10, %[k]")           // k += 4
+                        __ASM_EMIT64("dec               %[blocks]")
+                        __ASM_EMIT32("decl              %[blocks]")
+                        __ASM_EMIT("jnz                 100b")
+                    : [k] "+r" (k), [off] X86_PGREG (off), [blocks] X86_PGREG (blocks),
+                      [c] "=&r" (c), [d] "=&r" (d), [clen] "=&r" (clen), [i] "=&r" (i)
+                    : [vc] X86_GREG (conv), [vd] X86_GREG (dst),
+                      [length] X86_GREG (length), [n] X86_GREG (n),
+                      [ptr] "i" (sizeof(float *))
+                    : "cc", "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                      "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+                );
+            }
+
+            // Apply the tail of the source signal
+            if (head < count)
+            {
+                for (size_t j=0; j<n; ++j)
+                    convolve_fma3(&dst[j][head], &src[head], conv[j], length, count - head);
+            }
+        }
+
+        #undef CONVOLVE_X4_PASS_FMA3
+        #undef CONVOLVE_X4_PASS
     } /* namespace avx */
 } /* namespace lsp */
 
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 1 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_CQT_H_
+#define PRIVATE_DSP_ARCH_X86_AVX_CQT_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_IMPL */
+
+namespace lsp
+{
+    namespace avx
+    {
+        #define FMA_OFF(a, b)       a
+        #define FMA_ON(a, b)        b
+
+        /*
+         * The products of the spectrum and the kernel are accumulated in two vectors:
+         *   P = sum { sr*kr, si*ki }, Q = sum { sr*ki, si*kr }
+         * and reduced at the end of the row: re = P[0] - P[1], im = Q[0] + Q[1]
+         */
+        #define CQT_KERNEL_MAC(R, OFF, P, Q, SEL) \
+            __ASM_EMIT("vmovups         " OFF "(%[s]), %%" R "4")                               /* R4 = sr si */ \
+            __ASM_EMIT("vpermilps       $0xb1, " OFF "(%[k]), %%" R "5")                        /* R5 = ki kr */ \
+            __ASM_EMIT(SEL("vmulps      " OFF "(%[k]), %%" R "4, %%" R "6", ""))                /* R6 = sr*kr si*ki */ \
+            __ASM_EMIT(SEL("vmulps      %%" R "5, %%" R "4, %%" R "5", ""))                     /* R5 = sr*ki si*kr */ \
+            __ASM_EMIT(SEL("vaddps      %%" R "6, %%" P ", %%" P, "vfmadd231ps " OFF "(%[k]), %%" R "4, %%" P)) \
+            __ASM_EMIT(SEL("vaddps      %%" R "5, %%" Q ", %%" Q, "vfmadd231ps %%" R "5, %%" R "4, %%" Q))
+
+        #define CQT_KERNEL_APPLY_BODY(SEL) \
+            for (size_t i=0; i<bins; ++i, band += 2, dst += 2) \
+            { \
+                const float *s  = &src[band[0] * 2]; \
+                size_t n        = band[1]; \
+                \
+                ARCH_X86_ASM \
+                ( \
+                    __ASM_EMIT("vxorps          %%ymm0, %%ymm0, %%ymm0")            /* ymm0 = P */ \
+                    __ASM_EMIT("vxorps          %%ymm1, %%ymm1, %%ymm1")            /* ymm1 = Q */ \
+                    __ASM_EMIT("vxorps          %%ymm2, %%ymm2, %%ymm2") \
+                    __ASM_EMIT("vxorps          %%ymm3, %%ymm3, %%ymm3") \
+                    /* x8 blocks */ \
+                    __ASM_EMIT("sub             $8, %[n]") \
+                    __ASM_EMIT("jb              2f") \
+                    __ASM_EMIT("1:") \
+                    CQT_KERNEL_MAC("ymm", "0x00", "ymm0", "ymm1", SEL) \
+                    CQT_KERNEL_MAC("ymm", "0x20", "ymm2", "ymm3", SEL) \
+                    __ASM_EMIT("add             $0x40, %[s]") \
+                    __ASM_EMIT("add             $0x40, %[k]") \
+                    __ASM_EMIT("sub             $8, %[n]") \
+                    __ASM_EMIT("jae             1b") \
+                    __ASM_EMIT("2:") \
+                    /* x4 block */ \
+                    __ASM_EMIT("add             $4, %[n]") \
+                    __ASM_EMIT("jl              4f") \
+                    CQT_KERNEL_MAC("ymm", "0x00", "ymm0", "ymm1", SEL) \
+                    __ASM_EMIT("add             $0x20, %[s]") \
+                    __ASM_EMIT("add             $0x20, %[k]") \
+                    __ASM_EMIT("sub             $4, %[n]") \
+                    __ASM_EMIT("4:") \
+                    __ASM_EMIT("vaddps          %%ymm2, %%ymm0, %%ymm0") \
+                    __ASM_EMIT("vaddps          %%ymm3, %%ymm1, %%ymm1") \
+                    __ASM_EMIT("vextractf128    $1, %%ymm0, %%xmm2") \
+                    __ASM_EMIT("vextractf128    $1, %%ymm1, %%xmm3") \
+                    __ASM_EMIT("vaddps          %%xmm2, %%xmm0, %%xmm0") \
+                    __ASM_EMIT("vaddps          %%xmm3, %%xmm1, %%xmm1") \
+                    /* x2 block */ \
+                    __ASM_EMIT("add             $2, %[n]") \
+                    __ASM_EMIT("jl              6f") \
+                    CQT_KERNEL_MAC("xmm", "0x00", "xmm0", "xmm1", SEL) \
+                    __ASM_EMIT("add             $0x10, %[s]") \
+                    __ASM_EMIT("add             $0x10, %[k]") \
+                    __ASM_EMIT("sub             $2, %[n]") \
+                    __ASM_EMIT("6:") \
+                    /* x1 block */ \
+                    __ASM_EMIT("add             $1, %[n]") \
+                    __ASM_EMIT("jl              8f") \
+                    __ASM_EMIT("vmovsd          0x00(%[s]), %%xmm4")                /* xmm4 = sr si 0 0 */ \
+                    __ASM_EMIT("vmovsd          0x00(%[k]), %%xmm7")                /* xmm7 = kr ki 0 0 */ \
+                    __ASM_EMIT("vpermilps       $0xb1, %%xmm7, %%xmm5")             /* xmm5 = ki kr 0 0 */ \
+                    __ASM_EMIT(SEL("vmulps      %%xmm7, %%xmm4, %%xmm6", ""))       /* xmm6 = sr*kr si*ki */ \
+                    __ASM_EMIT(SEL("vmulps      %%xmm5, %%xmm4, %%xmm5", ""))       /* xmm5 = sr*ki si*kr */ \
+                    __ASM_EMIT(SEL("vaddps      %%xmm6, %%xmm0, %%xmm0", "vfmadd231ps %%xmm7, %%xmm4, %%xmm0")) \
+                    __ASM_EMIT(SEL("vaddps      %%xmm5, %%xmm1, %%xmm1", "vfmadd231ps %%xmm5, %%xmm4, %%xmm1")) \
+                    __ASM_EMIT("add             $0x08, %[s]") \
+                    __ASM_EMIT("add             $0x08, %[k]") \
+                    __ASM_EMIT("8:") \
+                    /* Reduce and store */ \
+                    __ASM_EMIT("vmovhlps        %%xmm0, %%xmm0, %%xmm2")            /* xmm2 = P2 P3 */ \
+                    __ASM_EMIT("vmovhlps        %%xmm1, %%xmm1, %%xmm3")            /* xmm3 = Q2 Q3 */ \
+                    __ASM_EMIT("vaddps          %%xmm2, %%xmm0, %%xmm0")            /* xmm0 = P0+P2 P1+P3 */ \
+                    __ASM_EMIT("vaddps          %%xmm3, %%xmm1, %%xmm1")            /* xmm1 = Q0+Q2 Q1+Q3 */ \
+                    __ASM_EMIT("vmovshdup       %%xmm0, %%xmm2")                    /* xmm2 = P1+P3 */ \
+                    __ASM_EMIT("vmovshdup       %%xmm1, %%xmm3")                    /* xmm3 = Q1+Q3 */ \
+                    __ASM_EMIT("vsubss          %%xmm2, %%xmm0, %%xmm0")            /* xmm0 = re */ \
+                    __ASM_EMIT("vaddss          %%xmm3, %%xmm1, %%xmm1")            /* xmm1 = im */ \
+                    __ASM_EMIT("vmovss          %%xmm0, 0x00(%[dst])") \
+                    __ASM_EMIT("vmovss          %%xmm1, 0x04(%[dst])") \
+                    : [s] "+r" (s), [k] "+r" (kernel), [n] X86_PGREG (n) \
+                    : [dst] "r" (dst) \
+                    : "cc", "memory", \
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                      "%xmm4", "%xmm5", "%xmm6", "%xmm7" \
+                ); \
+            }
+
+        void cqt_kernel_apply(float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins)
+        {
+            CQT_KERNEL_APPLY_BODY(FMA_OFF);
+        }
+
+        void cqt_kernel_apply_fma3(float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins)
+        {
+            CQT_KERNEL_APPLY_BODY(FMA_ON);
+        }
+
+        #undef CQT_KERNEL_APPLY_BODY
+        #undef CQT_KERNEL_MAC
+        #undef FMA_ON
+        #undef FMA_OFF
+    } /* namespace avx */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_CQT_H_ */
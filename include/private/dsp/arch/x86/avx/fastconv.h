@@ -29,6 +29,7 @@
 #include <private/dsp/arch/x86/avx/fastconv/prepare.h>
 #include <private/dsp/arch/x86/avx/fastconv/butterfly.h>
 #include <private/dsp/arch/x86/avx/fastconv/apply.h>
+#include <private/dsp/arch/x86/avx/fastconv/mac.h>
 
 namespace lsp
 {
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 10 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_FASTCONV_MAC_H_
+#define PRIVATE_DSP_ARCH_X86_AVX_FASTCONV_MAC_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_IMPL */
+
+namespace lsp
+{
+    namespace avx
+    {
+        #define FMA_OFF(a, b)       a
+        #define FMA_ON(a, b)        b
+
+        /*
+         * Number of partitions processed at once: the spectra of partitions are read by
+         * a few sequential streams which keeps the hardware prefetcher efficient for
+         * long delay lines.
+         */
+        static constexpr size_t FASTCONV_MAC_GROUP  = 8;
+
+        /*
+         * Each block of 64 bytes (one cache line) holds 8 real parts followed by 8 imaginary parts.
+         * The products of the group of partitions are accumulated in registers, the real and imaginary
+         * parts are split into two accumulators each to shorten the dependency chains. The first group
+         * stores the result, the next groups add the result to the destination.
+         */
+        #define FASTCONV_MAC_N_CORE(FMA_SEL) \
+            const size_t bytes  = size_t(4) << (rank + 1); \
+            const float * const *sp, * const *kp; \
+            const float *s, *k; \
+            size_t i; \
+            size_t g            = 0; \
+            \
+            do \
+            { \
+                const size_t count  = lsp_min(n - g, FASTCONV_MAC_GROUP); \
+                const float * const *vs = &spectra[g]; \
+                const float * const *vk = &kernels[g]; \
+                \
+                for (size_t off=0; off < bytes; off += 0x40) \
+                { \
+                    float *d            = &dst[off >> 2]; \
+                    ARCH_X86_ASM( \
+                        __ASM_EMIT("vxorps          %%ymm0, %%ymm0, %%ymm0")            /* ymm0 = re1 */ \
+                        __ASM_EMIT("vxorps          %%ymm1, %%ymm1, %%ymm1")            /* ymm1 = re2 */ \
+                        __ASM_EMIT("vxorps          %%ymm2, %%ymm2, %%ymm2")            /* ymm2 = im1 */ \
+                        __ASM_EMIT("vxorps          %%ymm3, %%ymm3, %%ymm3")            /* ymm3 = im2 */ \
+                        __ASM_EMIT("mov             %[d], %[s]") \
+                        __ASM_EMIT("mov             %[g], %[i]") \
+                        __ASM_EMIT("test            %[i], %[i]") \
+                        __ASM_EMIT("jz              1f") \
+                        __ASM_EMIT("vmovups         0x00(%[s]), %%ymm0")                /* ymm0 = re1 = dr */ \
+                        __ASM_EMIT("vmovups         0x20(%[s]), %%ymm2")                /* ymm2 = im1 = di */ \
+                        __ASM_EMIT("1:") \
+                        __ASM_EMIT("mov             %[vs], %[sp]") \
+                        __ASM_EMIT("mov             %[vk], %[kp]") \
+                        __ASM_EMIT("mov             %[count], %[i]") \
+                        __ASM_EMIT("test            %[i], %[i]") \
+                        __ASM_EMIT("jz              3f") \
+                        __ASM_EMIT("2:") \
+                            __ASM_EMIT("mov             (%[sp]), %[s]") \
+                            __ASM_EMIT("mov             (%[kp]), %[k]") \
+                            __ASM_EMIT("add             %[off], %[s]") \
+                            __ASM_EMIT("add             %[off], %[k]") \
+                            __ASM_EMIT("vmovups         0x00(%[s]), %%ymm4")            /* ymm4 = ar */ \
+                            __ASM_EMIT("vmovups         0x20(%[s]), %%ymm5")            /* ymm5 = ai */ \
+                            __ASM_EMIT(FMA_SEL("vmulps  0x00(%[k]), %%ymm4, %%ymm6", "vfmadd231ps 0x00(%[k]), %%ymm4, %%ymm0")) /* ymm6 = ar*br */ \
+                            __ASM_EMIT(FMA_SEL("vmulps  0x20(%[k]), %%ymm5, %%ymm7", "vfmadd231ps 0x20(%[k]), %%ymm5, %%ymm1")) /* ymm7 = ai*bi */ \
+                            __ASM_EMIT(FMA_SEL("vmulps  0x20(%[k]), %%ymm4, %%ymm4", "vfmadd231ps 0x20(%[k]), %%ymm4, %%ymm2")) /* ymm4 = ar*bi */ \
+                            __ASM_EMIT(FMA_SEL("vmulps  0x00(%[k]), %%ymm5, %%ymm5", "vfmadd231ps 0x00(%[k]), %%ymm5, %%ymm3")) /* ymm5 = ai*br */ \
+                            __ASM_EMIT(FMA_SEL("vaddps  %%ymm6, %%ymm0, %%ymm0", ""))   /* ymm0 = re1 + ar*br */ \
+                            __ASM_EMIT(FMA_SEL("vaddps  %%ymm7, %%ymm1, %%ymm1", ""))   /* ymm1 = re2 + ai*bi */ \
+                            __ASM_EMIT(FMA_SEL("vaddps  %%ymm4, %%ymm2, %%ymm2", ""))   /* ymm2 = im1 + ar*bi */ \
+                            __ASM_EMIT(FMA_SEL("vaddps  %%ymm5, %%ymm3, %%ymm3", ""))   /* ymm3 = im2 + ai*br */ \
+                            __ASM_EMIT("add             %[ptr], %[sp]") \
+                            __ASM_EMIT("add             %[ptr], %[kp]") \
+                            __ASM_EMIT("dec             %[i]") \
+                            __ASM_EMIT("jnz             2b") \
+                        __ASM_EMIT("3:") \
+                        __ASM_EMIT("vsubps          %%ymm1, %%ymm0, %%ymm0")            /* ymm0 = re1 - re2 */ \
+                        __ASM_EMIT("vaddps          %%ymm3, %%ymm2, %%ymm2")            /* ymm2 = im1 + im2 */ \
+                        __ASM_EMIT("mov             %[d], %[s]") \
+                        __ASM_EMIT("vmovups         %%ymm0, 0x00(%[s])") \
+                        __ASM_EMIT("vmovups         %%ymm2, 0x20(%[s])") \
+                        : [sp] "=&r" (sp), [kp] "=&r" (kp), [i] "=&r" (i), \
+                          [s] "=&r" (s), [k] "=&r" (k) \
+                        : [vs] "m" (vs), [vk] "m" (vk), [count] "m" (count), \
+                          [off] "m" (off), [d] "m" (d), [g] "m" (g), \
+                          [ptr] "i" (sizeof(const float *)) \
+                        : "cc", "memory", \
+                          "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                          "%xmm4", "%xmm5", "%xmm6", "%xmm7" \
+                    ); \
+                } \
+                \
+                g                  += FASTCONV_MAC_GROUP; \
+            } while (g < n);
+
+        void fastconv_mac_n(float *dst, const float * const *spectra, const float * const *kernels, size_t n, size_t rank)
+        {
+            FASTCONV_MAC_N_CORE(FMA_OFF);
+        }
+
+        void fastconv_mac_n_fma3(float *dst, const float * const *spectra, const float * const *kernels, size_t n, size_t rank)
+        {
+            FASTCONV_MAC_N_CORE(FMA_ON);
+        }
+
+        #undef FASTCONV_MAC_N_CORE
+        #undef FMA_ON
+        #undef FMA_OFF
+    } /* namespace avx */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_FASTCONV_MAC_H_ */
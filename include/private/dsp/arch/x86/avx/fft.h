@@ -25,8 +25,19 @@
 
 #include <private/dsp/arch/x86/avx/fft/const.h>
 #include <private/dsp/arch/x86/avx/fft/butterfly.h>
+#include <private/dsp/arch/x86/avx/fft/blocked.h>
 #include <private/dsp/arch/x86/avx/fft/normalize.h>
 
+#define FFT_START_DIRECT_NAME           fft_start_direct
+#define FFT_START_REVERSE_NAME          fft_start_reverse
+#define FFT_FMA(a, b)                   a
+#include <private/dsp/arch/x86/avx/fft/start.h>
+
+#define FFT_START_DIRECT_NAME           fft_start_direct_fma3
+#define FFT_START_REVERSE_NAME          fft_start_reverse_fma3
+#define FFT_FMA(a, b)                   b
+#include <private/dsp/arch/x86/avx/fft/start.h>
+
 #define FFT_SCRAMBLE_SELF_DIRECT_NAME   scramble_self_direct8
 #define FFT_SCRAMBLE_SELF_REVERSE_NAME  scramble_self_reverse8
 #define FFT_SCRAMBLE_COPY_DIRECT_NAME   scramble_copy_direct8
@@ -43,6 +54,14 @@
 #define FFT_FMA(a, b)                   a
 #include <private/dsp/arch/x86/avx/fft/scramble.h>
 
+#define FFT_SCRAMBLE_SELF_DIRECT_NAME   scramble_self_direct32
+#define FFT_SCRAMBLE_SELF_REVERSE_NAME  scramble_self_reverse32
+#define FFT_SCRAMBLE_COPY_DIRECT_NAME   scramble_copy_direct32
+#define FFT_SCRAMBLE_COPY_REVERSE_NAME  scramble_copy_reverse32
+#define FFT_TYPE                        uint32_t
+#define FFT_FMA(a, b)                   a
+#include <private/dsp/arch/x86/avx/fft/scramble.h>
+
 #define FFT_SCRAMBLE_SELF_DIRECT_NAME   scramble_self_direct8_fma3
 #define FFT_SCRAMBLE_SELF_REVERSE_NAME  scramble_self_reverse8_fma3
 #define FFT_SCRAMBLE_COPY_DIRECT_NAME   scramble_copy_direct8_fma3
@@ -59,6 +78,14 @@
 #define FFT_FMA(a, b)                   b
 #include <private/dsp/arch/x86/avx/fft/scramble.h>
 
+#define FFT_SCRAMBLE_SELF_DIRECT_NAME   scramble_self_direct32_fma3
+#define FFT_SCRAMBLE_SELF_REVERSE_NAME  scramble_self_reverse32_fma3
+#define FFT_SCRAMBLE_COPY_DIRECT_NAME   scramble_copy_direct32_fma3
+#define FFT_SCRAMBLE_COPY_REVERSE_NAME  scramble_copy_reverse32_fma3
+#define FFT_TYPE                        uint32_t
+#define FFT_FMA(a, b)                   b
+#include <private/dsp/arch/x86/avx/fft/scramble.h>
+
 namespace lsp
 {
     namespace avx
@@ -162,8 +189,15 @@ namespace lsp
                 dsp::move(dst_im, src_im, 1 << rank);
                 if (rank <= 8)
                     scramble_self_direct8(dst_re, dst_im, rank);
-                else
+                else if (rank <= 16)
                     scramble_self_direct16(dst_re, dst_im, rank);
+                else
+                    scramble_self_direct32(dst_re, dst_im, rank);
+            }
+            else if (rank > FFT_LARGE_RANK)
+            {
+                fft_large_transform(dst_re, dst_im, src_re, src_im, rank, scramble_self_direct16, butterfly_direct8p, butterfly_direct8p_x2);
+                return;
             }
             else
             {
@@ -173,8 +207,7 @@ namespace lsp
                     scramble_copy_direct16(dst_re, dst_im, src_re, src_im, rank-4);
             }
 
-            for (size_t i=3; i < rank; ++i)
-                butterfly_direct8p(dst_re, dst_im, i, 1 << (rank - i - 1));
+            fft_butterfly_blocked(dst_re, dst_im, 3, rank, butterfly_direct8p, butterfly_direct8p_x2);
         }
 
         void direct_fft_fma3(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
@@ -192,8 +225,15 @@ namespace lsp
                 dsp::move(dst_im, src_im, 1 << rank);
                 if (rank <= 8)
                     scramble_self_direct8_fma3(dst_re, dst_im, rank);
-                else
+                else if (rank <= 16)
                     scramble_self_direct16_fma3(dst_re, dst_im, rank);
+                else
+                    scramble_self_direct32_fma3(dst_re, dst_im, rank);
+            }
+            else if (rank > FFT_LARGE_RANK)
+            {
+                fft_large_transform(dst_re, dst_im, src_re, src_im, rank, scramble_self_direct16_fma3, butterfly_direct8p_fma3, butterfly_direct8p_x2_fma3);
+                return;
             }
             else
             {
@@ -203,8 +243,7 @@ namespace lsp
                     scramble_copy_direct16_fma3(dst_re, dst_im, src_re, src_im, rank-4);
             }
 
-            for (size_t i=3; i < rank; ++i)
-                butterfly_direct8p_fma3(dst_re, dst_im, i, 1 << (rank - i - 1));
+            fft_butterfly_blocked(dst_re, dst_im, 3, rank, butterfly_direct8p_fma3, butterfly_direct8p_x2_fma3);
         }
 
         void reverse_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
@@ -222,8 +261,16 @@ namespace lsp
                 dsp::move(dst_im, src_im, 1 << rank);
                 if (rank <= 8)
                     scramble_self_reverse8(dst_re, dst_im, rank);
-                else
+                else if (rank <= 16)
                     scramble_self_reverse16(dst_re, dst_im, rank);
+                else
+                    scramble_self_reverse32(dst_re, dst_im, rank);
+            }
+            else if (rank > FFT_LARGE_RANK)
+            {
+                fft_large_transform(dst_re, dst_im, src_re, src_im, rank, scramble_self_reverse16, butterfly_reverse8p, butterfly_reverse8p_x2);
+                dsp::normalize_fft2(dst_re, dst_im, rank);
+                return;
             }
             else
             {
@@ -233,8 +280,7 @@ namespace lsp
                     scramble_copy_reverse16(dst_re, dst_im, src_re, src_im, rank-4);
             }
 
-            for (size_t i=3; i < rank; ++i)
-                butterfly_reverse8p(dst_re, dst_im, i, 1 << (rank - i - 1));
+            fft_butterfly_blocked(dst_re, dst_im, 3, rank, butterfly_reverse8p, butterfly_reverse8p_x2);
 
             dsp::normalize_fft2(dst_re, dst_im, rank);
         }
@@ -254,8 +300,16 @@ namespace lsp
                 dsp::move(dst_im, src_im, 1 << rank);
                 if (rank <= 8)
                     scramble_self_reverse8_fma3(dst_re, dst_im, rank);
-                else
+                else if (rank <= 16)
                     scramble_self_reverse16_fma3(dst_re, dst_im, rank);
+                else
+                    scramble_self_reverse32_fma3(dst_re, dst_im, rank);
+            }
+            else if (rank > FFT_LARGE_RANK)
+            {
+                fft_large_transform(dst_re, dst_im, src_re, src_im, rank, scramble_self_reverse16_fma3, butterfly_reverse8p_fma3, butterfly_reverse8p_x2_fma3);
+                dsp::normalize_fft2(dst_re, dst_im, rank);
+                return;
             }
             else
             {
@@ -265,8 +319,7 @@ namespace lsp
                     scramble_copy_reverse16_fma3(dst_re, dst_im, src_re, src_im, rank-4);
             }
 
-            for (size_t i=3; i < rank; ++i)
-                butterfly_reverse8p_fma3(dst_re, dst_im, i, 1 << (rank - i - 1));
+            fft_butterfly_blocked(dst_re, dst_im, 3, rank, butterfly_reverse8p_fma3, butterfly_reverse8p_x2_fma3);
 
             dsp::normalize_fft2(dst_re, dst_im, rank);
         }
@@ -102,6 +102,46 @@ namespace lsp
             LSP_DSP_VEC8(0.9999999816164293), LSP_DSP_VEC8(0.0001917475973107), // rank = 17
             LSP_DSP_VEC8(0.9999999954041073), LSP_DSP_VEC8(0.0000958737990960), // rank = 18
         };
+
+        /**
+         * Number of butterfly ranks covered by the FFT_A and FFT_DW tables
+         */
+        static constexpr size_t FFT_TABLE_RANKS     = sizeof(FFT_A) / (sizeof(float) * 16);
+
+        /**
+         * Get the twiddle factors for the butterfly of the specified rank. If the rank
+         * is not covered by the FFT_A and FFT_DW tables, the factors are computed with
+         * double precision and stored in the temporary buffer.
+         *
+         * @param fft_a pointer to store the address of the initial angle row
+         * @param fft_w pointer to store the address of the angle rotation row
+         * @param xw temporary buffer of 32 elements aligned to 32-byte boundary
+         * @param rank the rank of butterfly, should be at least 2
+         */
+        static inline void fft_twiddle_rows(const float * &fft_a, const float * &fft_w, float *xw, size_t rank)
+        {
+            size_t row      = rank - 2;
+            if (row < FFT_TABLE_RANKS)
+            {
+                fft_a           = &FFT_A[row << 4];
+                fft_w           = &FFT_DW[row << 4];
+                return;
+            }
+
+            double k        = M_PI / double(size_t(1) << rank);
+            double w_re     = cos(k * 8.0);
+            double w_im     = sin(k * 8.0);
+            for (size_t i=0; i<8; ++i)
+            {
+                xw[i]           = cos(k * i);
+                xw[i + 8]       = sin(k * i);
+                xw[i + 16]      = w_re;
+                xw[i + 24]      = w_im;
+            }
+
+            fft_a           = &xw[0];
+            fft_w           = &xw[16];
+        }
     }
 }
 
@@ -84,6 +84,123 @@ namespace lsp
                 "%xmm4", "%xmm5", "%xmm6", "%xmm7"  \
             );
 
+        /*
+         * Radix-4 butterfly which performs two adjacent radix-2 stages of the transform in one pass:
+         *   a' = a + w*b, b' = a - w*b, c' = c + w*d, d' = c - w*d      (stage rank, w = W[k])
+         *   a" = a' + v*c', c" = a' - v*c'                              (stage rank+1, v = V[k])
+         *   b" = b' -+ j*v*d', d" = b' +- j*v*d'                        (v*W[k + pairs] = -+ j*v)
+         * Uses 16 registers, so it is available for x86_64 only
+         */
+        #define FFT_BUTTERFLY_X2_BODY8(add_b, add_a, op_b, op_a, FMA_SEL) \
+            ARCH_X86_64_ASM \
+            ( \
+                /* Prepare angles */ \
+                __ASM_EMIT("vmovaps         0x00(%[fft_a1]), %%ymm12")          /* ymm12 = w_re */ \
+                __ASM_EMIT("vmovaps         0x20(%[fft_a1]), %%ymm13")          /* ymm13 = w_im */ \
+                __ASM_EMIT("vmovaps         0x00(%[fft_a2]), %%ymm14")          /* ymm14 = v_re */ \
+                __ASM_EMIT("vmovaps         0x20(%[fft_a2]), %%ymm15")          /* ymm15 = v_im */ \
+                /* Start loop */ \
+                __ASM_EMIT("1:") \
+                    __ASM_EMIT("vmovups         0x00(%[dst], %[off2]), %%ymm2")     /* ymm2 = b_re */ \
+                    __ASM_EMIT("vmovups         0x20(%[dst], %[off2]), %%ymm3")     /* ymm3 = b_im */ \
+                    __ASM_EMIT("vmovups         0x00(%[dst], %[off4]), %%ymm6")     /* ymm6 = d_re */ \
+                    __ASM_EMIT("vmovups         0x20(%[dst], %[off4]), %%ymm7")     /* ymm7 = d_im */ \
+                    /* 1st stage: calculate complex multiplications */ \
+                    __ASM_EMIT("vmulps          %%ymm13, %%ymm2, %%ymm8")           /* ymm8 = w_im * b_re */ \
+                    __ASM_EMIT("vmulps          %%ymm13, %%ymm3, %%ymm9")           /* ymm9 = w_im * b_im */ \
+                    __ASM_EMIT("vmulps          %%ymm13, %%ymm6, %%ymm10")          /* ymm10 = w_im * d_re */ \
+                    __ASM_EMIT("vmulps          %%ymm13, %%ymm7, %%ymm11")          /* ymm11 = w_im * d_im */ \
+                    __ASM_EMIT(FMA_SEL("vmulps  %%ymm12, %%ymm2, %%ymm2", ""))      /* ymm2 = w_re * b_re */ \
+                    __ASM_EMIT(FMA_SEL("vmulps  %%ymm12, %%ymm3, %%ymm3", ""))      /* ymm3 = w_re * b_im */ \
+                    __ASM_EMIT(FMA_SEL("vmulps  %%ymm12, %%ymm6, %%ymm6", ""))      /* ymm6 = w_re * d_re */ \
+                    __ASM_EMIT(FMA_SEL("vmulps  %%ymm12, %%ymm7, %%ymm7", ""))      /* ymm7 = w_re * d_im */ \
+                    __ASM_EMIT(FMA_SEL(add_b "  %%ymm9, %%ymm2, %%ymm9", add_b " %%ymm12, %%ymm2, %%ymm9"))     /* ymm9 = wb_re = w_re * b_re +- w_im * b_im */ \
+                    __ASM_EMIT(FMA_SEL(add_a "  %%ymm8, %%ymm3, %%ymm8", add_a " %%ymm12, %%ymm3, %%ymm8"))     /* ymm8 = wb_im = w_re * b_im -+ w_im * b_re */ \
+                    __ASM_EMIT(FMA_SEL(add_b "  %%ymm11, %%ymm6, %%ymm11", add_b " %%ymm12, %%ymm6, %%ymm11"))  /* ymm11 = wd_re = w_re * d_re +- w_im * d_im */ \
+                    __ASM_EMIT(FMA_SEL(add_a "  %%ymm10, %%ymm7, %%ymm10", add_a " %%ymm12, %%ymm7, %%ymm10"))  /* ymm10 = wd_im = w_re * d_im -+ w_im * d_re */ \
+                    /* 1st stage: perform butterflies */ \
+                    __ASM_EMIT("vmovups         0x00(%[dst], %[off1]), %%ymm0")     /* ymm0 = a_re */ \
+                    __ASM_EMIT("vmovups         0x20(%[dst], %[off1]), %%ymm1")     /* ymm1 = a_im */ \
+                    __ASM_EMIT("vmovups         0x00(%[dst], %[off3]), %%ymm4")     /* ymm4 = c_re */ \
+                    __ASM_EMIT("vmovups         0x20(%[dst], %[off3]), %%ymm5")     /* ymm5 = c_im */ \
+                    __ASM_EMIT("vsubps          %%ymm9, %%ymm0, %%ymm2")            /* ymm2 = b_re' = a_re - wb_re */ \
+                    __ASM_EMIT("vsubps          %%ymm8, %%ymm1, %%ymm3")            /* ymm3 = b_im' = a_im - wb_im */ \
+                    __ASM_EMIT("vaddps          %%ymm9, %%ymm0, %%ymm0")            /* ymm0 = a_re' = a_re + wb_re */ \
+                    __ASM_EMIT("vaddps          %%ymm8, %%ymm1, %%ymm1")            /* ymm1 = a_im' = a_im + wb_im */ \
+                    __ASM_EMIT("vsubps          %%ymm11, %%ymm4, %%ymm6")           /* ymm6 = d_re' = c_re - wd_re */ \
+                    __ASM_EMIT("vsubps          %%ymm10, %%ymm5, %%ymm7")           /* ymm7 = d_im' = c_im - wd_im */ \
+                    __ASM_EMIT("vaddps          %%ymm11, %%ymm4, %%ymm4")           /* ymm4 = c_re' = c_re + wd_re */ \
+                    __ASM_EMIT("vaddps          %%ymm10, %%ymm5, %%ymm5")           /* ymm5 = c_im' = c_im + wd_im */ \
+                    /* 2nd stage: calculate complex multiplications */ \
+                    __ASM_EMIT("vmulps          %%ymm15, %%ymm4, %%ymm8")           /* ymm8 = v_im * c_re' */ \
+                    __ASM_EMIT("vmulps          %%ymm15, %%ymm5, %%ymm9")           /* ymm9 = v_im * c_im' */ \
+                    __ASM_EMIT("vmulps          %%ymm15, %%ymm6, %%ymm10")          /* ymm10 = v_im * d_re' */ \
+                    __ASM_EMIT("vmulps          %%ymm15, %%ymm7, %%ymm11")          /* ymm11 = v_im * d_im' */ \
+                    __ASM_EMIT(FMA_SEL("vmulps  %%ymm14, %%ymm4, %%ymm4", ""))      /* ymm4 = v_re * c_re' */ \
+                    __ASM_EMIT(FMA_SEL("vmulps  %%ymm14, %%ymm5, %%ymm5", ""))      /* ymm5 = v_re * c_im' */ \
+                    __ASM_EMIT(FMA_SEL("vmulps  %%ymm14, %%ymm6, %%ymm6", ""))      /* ymm6 = v_re * d_re' */ \
+                    __ASM_EMIT(FMA_SEL("vmulps  %%ymm14, %%ymm7, %%ymm7", ""))      /* ymm7 = v_re * d_im' */ \
+                    __ASM_EMIT(FMA_SEL(add_b "  %%ymm9, %%ymm4, %%ymm9", add_b " %%ymm14, %%ymm4, %%ymm9"))     /* ymm9 = vc_re = v_re * c_re' +- v_im * c_im' */ \
+                    __ASM_EMIT(FMA_SEL(add_a "  %%ymm8, %%ymm5, %%ymm8", add_a " %%ymm14, %%ymm5, %%ymm8"))     /* ymm8 = vc_im = v_re * c_im' -+ v_im * c_re' */ \
+                    __ASM_EMIT(FMA_SEL(add_b "  %%ymm11, %%ymm6, %%ymm11", add_b " %%ymm14, %%ymm6, %%ymm11"))  /* ymm11 = vd_re = v_re * d_re' +- v_im * d_im' */ \
+                    __ASM_EMIT(FMA_SEL(add_a "  %%ymm10, %%ymm7, %%ymm10", add_a " %%ymm14, %%ymm7, %%ymm10"))  /* ymm10 = vd_im = v_re * d_im' -+ v_im * d_re' */ \
+                    /* 2nd stage: perform butterflies */ \
+                    __ASM_EMIT("vsubps          %%ymm9, %%ymm0, %%ymm4")            /* ymm4 = c_re" = a_re' - vc_re */ \
+                    __ASM_EMIT("vsubps          %%ymm8, %%ymm1, %%ymm5")            /* ymm5 = c_im" = a_im' - vc_im */ \
+                    __ASM_EMIT("vaddps          %%ymm9, %%ymm0, %%ymm0")            /* ymm0 = a_re" = a_re' + vc_re */ \
+                    __ASM_EMIT("vaddps          %%ymm8, %%ymm1, %%ymm1")            /* ymm1 = a_im" = a_im' + vc_im */ \
+                    __ASM_EMIT(op_a "           %%ymm10, %%ymm2, %%ymm6")           /* ymm6 = d_re" = b_re' -+ vd_im */ \
+                    __ASM_EMIT(op_b "           %%ymm11, %%ymm3, %%ymm7")           /* ymm7 = d_im" = b_im' +- vd_re */ \
+                    __ASM_EMIT(op_b "           %%ymm10, %%ymm2, %%ymm2")           /* ymm2 = b_re" = b_re' +- vd_im */ \
+                    __ASM_EMIT(op_a "           %%ymm11, %%ymm3, %%ymm3")           /* ymm3 = b_im" = b_im' -+ vd_re */ \
+                    /* Store values */ \
+                    __ASM_EMIT("vmovups         %%ymm0, 0x00(%[dst], %[off1])") \
+                    __ASM_EMIT("vmovups         %%ymm1, 0x20(%[dst], %[off1])") \
+                    __ASM_EMIT("vmovups         %%ymm2, 0x00(%[dst], %[off2])") \
+                    __ASM_EMIT("vmovups         %%ymm3, 0x20(%[dst], %[off2])") \
+                    __ASM_EMIT("vmovups         %%ymm4, 0x00(%[dst], %[off3])") \
+                    __ASM_EMIT("vmovups         %%ymm5, 0x20(%[dst], %[off3])") \
+                    __ASM_EMIT("vmovups         %%ymm6, 0x00(%[dst], %[off4])") \
+                    __ASM_EMIT("vmovups         %%ymm7, 0x20(%[dst], %[off4])") \
+                    __ASM_EMIT("add             $0x40, %[off1]") \
+                    __ASM_EMIT("add             $0x40, %[off2]") \
+                    __ASM_EMIT("add             $0x40, %[off3]") \
+                    __ASM_EMIT("add             $0x40, %[off4]") \
+                    __ASM_EMIT("sub             $8, %[np]") \
+                    __ASM_EMIT("jz              2f") \
+                    /* Rotate angles */ \
+                    __ASM_EMIT("vmovaps         0x00(%[fft_w1]), %%ymm0")           /* ymm0 = dw_re */ \
+                    __ASM_EMIT("vmovaps         0x20(%[fft_w1]), %%ymm1")           /* ymm1 = dw_im */ \
+                    __ASM_EMIT("vmovaps         0x00(%[fft_w2]), %%ymm4")           /* ymm4 = dv_re */ \
+                    __ASM_EMIT("vmovaps         0x20(%[fft_w2]), %%ymm5")           /* ymm5 = dv_im */ \
+                    __ASM_EMIT("vmulps          %%ymm1, %%ymm12, %%ymm2")           /* ymm2 = dw_im * w_re */ \
+                    __ASM_EMIT("vmulps          %%ymm1, %%ymm13, %%ymm3")           /* ymm3 = dw_im * w_im */ \
+                    __ASM_EMIT("vmulps          %%ymm5, %%ymm14, %%ymm6")           /* ymm6 = dv_im * v_re */ \
+                    __ASM_EMIT("vmulps          %%ymm5, %%ymm15, %%ymm7")           /* ymm7 = dv_im * v_im */ \
+                    __ASM_EMIT(FMA_SEL("vmulps  %%ymm0, %%ymm12, %%ymm12", ""))     /* ymm12 = dw_re * w_re */ \
+                    __ASM_EMIT(FMA_SEL("vmulps  %%ymm0, %%ymm13, %%ymm13", ""))     /* ymm13 = dw_re * w_im */ \
+                    __ASM_EMIT(FMA_SEL("vmulps  %%ymm4, %%ymm14, %%ymm14", ""))     /* ymm14 = dv_re * v_re */ \
+                    __ASM_EMIT(FMA_SEL("vmulps  %%ymm4, %%ymm15, %%ymm15", ""))     /* ymm15 = dv_re * v_im */ \
+                    __ASM_EMIT(FMA_SEL("vsubps  %%ymm3, %%ymm12, %%ymm12", "vfmsub132ps %%ymm0, %%ymm3, %%ymm12"))  /* ymm12 = w_re' = dw_re * w_re - dw_im * w_im */ \
+                    __ASM_EMIT(FMA_SEL("vaddps  %%ymm2, %%ymm13, %%ymm13", "vfmadd132ps %%ymm0, %%ymm2, %%ymm13"))  /* ymm13 = w_im' = dw_re * w_im + dw_im * w_re */ \
+                    __ASM_EMIT(FMA_SEL("vsubps  %%ymm7, %%ymm14, %%ymm14", "vfmsub132ps %%ymm4, %%ymm7, %%ymm14"))  /* ymm14 = v_re' = dv_re * v_re - dv_im * v_im */ \
+                    __ASM_EMIT(FMA_SEL("vaddps  %%ymm6, %%ymm15, %%ymm15", "vfmadd132ps %%ymm4, %%ymm6, %%ymm15"))  /* ymm15 = v_im' = dv_re * v_im + dv_im * v_re */ \
+                    /* Repeat loop */ \
+                __ASM_EMIT("jmp             1b") \
+                __ASM_EMIT("2:") \
+                \
+                : [off1] "+r" (off1), [off2] "+r" (off2), [off3] "+r" (off3), [off4] "+r" (off4), \
+                  [np] "+r" (np) \
+                : [dst] "r" (dst), \
+                  [fft_a1] "r" (fft_a1), [fft_w1] "r" (fft_w1), \
+                  [fft_a2] "r" (fft_a2), [fft_w2] "r" (fft_w2) \
+                : "cc", "memory",  \
+                "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                "%xmm4", "%xmm5", "%xmm6", "%xmm7", \
+                "%xmm8", "%xmm9", "%xmm10", "%xmm11", \
+                "%xmm12", "%xmm13", "%xmm14", "%xmm15" \
+            );
+
     #define FMA_OFF(a, b)       a
     #define FMA_ON(a, b)        b
 
@@ -91,8 +208,9 @@ namespace lsp
         {
             size_t pairs = 1 << rank;
             size_t off1 = 0, shift = 8 << rank; //1 << (rank + 3);
-            const float *fft_a = &FFT_A[(rank - 2) << 4];
-            const float *fft_w = &FFT_DW[(rank - 2) << 4];
+            const float *fft_a, *fft_w;
+            float xw[32] __lsp_aligned32;
+            fft_twiddle_rows(fft_a, fft_w, xw, rank);
 
             for (size_t b=0; b<blocks; ++b)
             {
@@ -109,8 +227,9 @@ namespace lsp
         {
             size_t pairs = 1 << rank;
             size_t off1 = 0, shift = 8 << rank; // 1 << (rank + 3);
-            const float *fft_a = &FFT_A[(rank - 2) << 4];
-            const float *fft_w = &FFT_DW[(rank - 2) << 4];
+            const float *fft_a, *fft_w;
+            float xw[32] __lsp_aligned32;
+            fft_twiddle_rows(fft_a, fft_w, xw, rank);
 
             for (size_t b=0; b<blocks; ++b)
             {
@@ -127,8 +246,9 @@ namespace lsp
         {
             size_t pairs = 1 << rank;
             size_t off1 = 0, shift = 8 << rank; // 1 << (rank + 3);
-            const float *fft_a = &FFT_A[(rank - 2) << 4];
-            const float *fft_w = &FFT_DW[(rank - 2) << 4];
+            const float *fft_a, *fft_w;
+            float xw[32] __lsp_aligned32;
+            fft_twiddle_rows(fft_a, fft_w, xw, rank);
 
             for (size_t b=0; b<blocks; ++b)
             {
@@ -145,8 +265,9 @@ namespace lsp
         {
             size_t pairs = 1 << rank;
             size_t off1 = 0, shift = 8 << rank; // 1 << (rank + 3);
-            const float *fft_a = &FFT_A[(rank - 2) << 4];
-            const float *fft_w = &FFT_DW[(rank - 2) << 4];
+            const float *fft_a, *fft_w;
+            float xw[32] __lsp_aligned32;
+            fft_twiddle_rows(fft_a, fft_w, xw, rank);
 
             for (size_t b=0; b<blocks; ++b)
             {
@@ -159,9 +280,118 @@ namespace lsp
             }
         }
 
+        static inline void packed_butterfly_direct8p_x2(float *dst, size_t rank, size_t blocks)
+        {
+        #ifdef ARCH_X86_64
+            size_t pairs = 1 << rank;
+            size_t shift = 8 << rank; // 1 << (rank + 3);
+            const float *fft_a1, *fft_w1, *fft_a2, *fft_w2;
+            float xw1[32] __lsp_aligned32;
+            float xw2[32] __lsp_aligned32;
+            fft_twiddle_rows(fft_a1, fft_w1, xw1, rank);
+            fft_twiddle_rows(fft_a2, fft_w2, xw2, rank + 1);
+
+            for (size_t b=0; b<blocks; ++b)
+            {
+                size_t off1  = b * (shift << 2);
+                size_t off2  = off1 + shift;
+                size_t off3  = off2 + shift;
+                size_t off4  = off3 + shift;
+                size_t np    = pairs;
+
+                FFT_BUTTERFLY_X2_BODY8("vaddps", "vsubps", "vaddps", "vsubps", FMA_OFF);
+            }
+        #else
+            packed_butterfly_direct8p(dst, rank, blocks << 1);
+            packed_butterfly_direct8p(dst, rank + 1, blocks);
+        #endif /* ARCH_X86_64 */
+        }
+
+        static inline void packed_butterfly_reverse8p_x2(float *dst, size_t rank, size_t blocks)
+        {
+        #ifdef ARCH_X86_64
+            size_t pairs = 1 << rank;
+            size_t shift = 8 << rank; // 1 << (rank + 3);
+            const float *fft_a1, *fft_w1, *fft_a2, *fft_w2;
+            float xw1[32] __lsp_aligned32;
+            float xw2[32] __lsp_aligned32;
+            fft_twiddle_rows(fft_a1, fft_w1, xw1, rank);
+            fft_twiddle_rows(fft_a2, fft_w2, xw2, rank + 1);
+
+            for (size_t b=0; b<blocks; ++b)
+            {
+                size_t off1  = b * (shift << 2);
+                size_t off2  = off1 + shift;
+                size_t off3  = off2 + shift;
+                size_t off4  = off3 + shift;
+                size_t np    = pairs;
+
+                FFT_BUTTERFLY_X2_BODY8("vsubps", "vaddps", "vsubps", "vaddps", FMA_OFF);
+            }
+        #else
+            packed_butterfly_reverse8p(dst, rank, blocks << 1);
+            packed_butterfly_reverse8p(dst, rank + 1, blocks);
+        #endif /* ARCH_X86_64 */
+        }
+
+        static inline void packed_butterfly_direct8p_x2_fma3(float *dst, size_t rank, size_t blocks)
+        {
+        #ifdef ARCH_X86_64
+            size_t pairs = 1 << rank;
+            size_t shift = 8 << rank; // 1 << (rank + 3);
+            const float *fft_a1, *fft_w1, *fft_a2, *fft_w2;
+            float xw1[32] __lsp_aligned32;
+            float xw2[32] __lsp_aligned32;
+            fft_twiddle_rows(fft_a1, fft_w1, xw1, rank);
+            fft_twiddle_rows(fft_a2, fft_w2, xw2, rank + 1);
+
+            for (size_t b=0; b<blocks; ++b)
+            {
+                size_t off1  = b * (shift << 2);
+                size_t off2  = off1 + shift;
+                size_t off3  = off2 + shift;
+                size_t off4  = off3 + shift;
+                size_t np    = pairs;
+
+                FFT_BUTTERFLY_X2_BODY8("vfmadd231ps", "vfmsub231ps", "vaddps", "vsubps", FMA_ON);
+            }
+        #else
+            packed_butterfly_direct8p_fma3(dst, rank, blocks << 1);
+            packed_butterfly_direct8p_fma3(dst, rank + 1, blocks);
+        #endif /* ARCH_X86_64 */
+        }
+
+        static inline void packed_butterfly_reverse8p_x2_fma3(float *dst, size_t rank, size_t blocks)
+        {
+        #ifdef ARCH_X86_64
+            size_t pairs = 1 << rank;
+            size_t shift = 8 << rank; // 1 << (rank + 3);
+            const float *fft_a1, *fft_w1, *fft_a2, *fft_w2;
+            float xw1[32] __lsp_aligned32;
+            float xw2[32] __lsp_aligned32;
+            fft_twiddle_rows(fft_a1, fft_w1, xw1, rank);
+            fft_twiddle_rows(fft_a2, fft_w2, xw2, rank + 1);
+
+            for (size_t b=0; b<blocks; ++b)
+            {
+                size_t off1  = b * (shift << 2);
+                size_t off2  = off1 + shift;
+                size_t off3  = off2 + shift;
+                size_t off4  = off3 + shift;
+                size_t np    = pairs;
+
+                FFT_BUTTERFLY_X2_BODY8("vfmsub231ps", "vfmadd231ps", "vsubps", "vaddps", FMA_ON);
+            }
+        #else
+            packed_butterfly_reverse8p_fma3(dst, rank, blocks << 1);
+            packed_butterfly_reverse8p_fma3(dst, rank + 1, blocks);
+        #endif /* ARCH_X86_64 */
+        }
+
     #undef FMA_OFF
     #undef FMA_ON
     #undef FFT_BUTTERFLY_BODY8
+    #undef FFT_BUTTERFLY_X2_BODY8
     }
 }
 
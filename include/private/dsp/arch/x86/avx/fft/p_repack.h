@@ -136,6 +136,72 @@ namespace lsp
                   "%xmm4", "%xmm5", "%xmm6", "%xmm7"
             );
         }
+
+        static inline void packed_fft_repack_normalize_add(float *dst, const float *src, const float *wnd, size_t rank)
+        {
+            size_t blocks = 1 << rank;
+            float norm = 1.0f / float(blocks);
+
+            // Repack, apply normalization and window and add to the destination
+            ARCH_X86_ASM
+            (
+                __ASM_EMIT("vbroadcastss    %[norm], %%ymm7")
+                // 16x blocks
+                __ASM_EMIT("sub             $16, %[blocks]")
+                __ASM_EMIT("jb              2f")
+                __ASM_EMIT("1:")
+                __ASM_EMIT("vmulps          0x00(%[wnd]), %%ymm7, %%ymm6")      /* ymm6 = k*w0 ... k*w7 */
+                __ASM_EMIT("vmulps          0x20(%[wnd]), %%ymm7, %%ymm5")      /* ymm5 = k*w8 ... k*w15 */
+                __ASM_EMIT("vmulps          0x00(%[src]), %%ymm6, %%ymm0")      /* ymm0 = r0  r1  r2  r3  r4  r5  r6  r7  */
+                __ASM_EMIT("vmulps          0x20(%[src]), %%ymm6, %%ymm1")      /* ymm1 = i0  i1  i2  i3  i4  i5  i6  i7  */
+                __ASM_EMIT("vmulps          0x40(%[src]), %%ymm5, %%ymm2")      /* ymm2 = r8  r9  r10 r11 r12 r13 r14 r15 */
+                __ASM_EMIT("vmulps          0x60(%[src]), %%ymm5, %%ymm3")      /* ymm3 = i8  i9  i10 i11 i12 i13 i14 i15 */
+                __ASM_EMIT("vunpcklps       %%ymm1, %%ymm0, %%ymm4")            /* ymm4 = r0  i0  r1  i1  r4  i4  r5  i5  */
+                __ASM_EMIT("vunpckhps       %%ymm1, %%ymm0, %%ymm5")            /* ymm5 = r2  i2  r3  i3  r6  i6  r7  i7  */
+                __ASM_EMIT("vunpcklps       %%ymm3, %%ymm2, %%ymm6")            /* ymm6 = r8  i8  r9  i9  r12 i12 r13 i13 */
+                __ASM_EMIT("vunpckhps       %%ymm3, %%ymm2, %%ymm3")            /* ymm3 = r10 i10 r11 i11 r14 i14 r15 i15 */
+                __ASM_EMIT("vperm2f128      $0x20, %%ymm5, %%ymm4, %%ymm0")     /* ymm0 = r0  i0  r1  i1  r2  i2  r3  i3  */
+                __ASM_EMIT("vperm2f128      $0x31, %%ymm5, %%ymm4, %%ymm1")     /* ymm1 = r4  i4  r5  i5  r6  i6  r7  i7  */
+                __ASM_EMIT("vperm2f128      $0x20, %%ymm3, %%ymm6, %%ymm2")     /* ymm2 = r8  i8  r9  i9  r10 i10 r11 i11 */
+                __ASM_EMIT("vperm2f128      $0x31, %%ymm3, %%ymm6, %%ymm3")     /* ymm3 = r12 i12 r13 i13 r14 i14 r15 i15 */
+                __ASM_EMIT("vaddps          0x00(%[dst]), %%ymm0, %%ymm0")
+                __ASM_EMIT("vaddps          0x20(%[dst]), %%ymm1, %%ymm1")
+                __ASM_EMIT("vaddps          0x40(%[dst]), %%ymm2, %%ymm2")
+                __ASM_EMIT("vaddps          0x60(%[dst]), %%ymm3, %%ymm3")
+                __ASM_EMIT("vmovups         %%ymm0, 0x00(%[dst])")
+                __ASM_EMIT("vmovups         %%ymm1, 0x20(%[dst])")
+                __ASM_EMIT("vmovups         %%ymm2, 0x40(%[dst])")
+                __ASM_EMIT("vmovups         %%ymm3, 0x60(%[dst])")
+                __ASM_EMIT("add             $0x80, %[src]")
+                __ASM_EMIT("add             $0x80, %[dst]")
+                __ASM_EMIT("add             $0x40, %[wnd]")
+                __ASM_EMIT("sub             $16, %[blocks]")
+                __ASM_EMIT("jae             1b")
+                __ASM_EMIT("2:")
+                // 8x block
+                __ASM_EMIT("add             $8, %[blocks]")
+                __ASM_EMIT("jl              4f")
+                __ASM_EMIT("vmulps          0x00(%[wnd]), %%ymm7, %%ymm6")      /* ymm6 = k*w0 ... k*w7 */
+                __ASM_EMIT("vmulps          0x00(%[src]), %%ymm6, %%ymm0")      /* ymm0 = r0  r1  r2  r3  r4  r5  r6  r7  */
+                __ASM_EMIT("vmulps          0x20(%[src]), %%ymm6, %%ymm1")      /* ymm1 = i0  i1  i2  i3  i4  i5  i6  i7  */
+                __ASM_EMIT("vunpcklps       %%ymm1, %%ymm0, %%ymm4")            /* ymm4 = r0  i0  r1  i1  r4  i4  r5  i5  */
+                __ASM_EMIT("vunpckhps       %%ymm1, %%ymm0, %%ymm5")            /* ymm5 = r2  i2  r3  i3  r6  i6  r7  i7  */
+                __ASM_EMIT("vperm2f128      $0x20, %%ymm5, %%ymm4, %%ymm0")     /* ymm0 = r0  i0  r1  i1  r2  i2  r3  i3  */
+                __ASM_EMIT("vperm2f128      $0x31, %%ymm5, %%ymm4, %%ymm1")     /* ymm1 = r4  i4  r5  i5  r6  i6  r7  i7  */
+                __ASM_EMIT("vaddps          0x00(%[dst]), %%ymm0, %%ymm0")
+                __ASM_EMIT("vaddps          0x20(%[dst]), %%ymm1, %%ymm1")
+                __ASM_EMIT("vmovups         %%ymm0, 0x00(%[dst])")
+                __ASM_EMIT("vmovups         %%ymm1, 0x20(%[dst])")
+                __ASM_EMIT("4:")
+
+                : [dst] "+r"(dst), [src] "+r"(src), [wnd] "+r"(wnd),
+                  [blocks] "+r" (blocks)
+                : [norm] "m" (norm)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+            );
+        }
     }
 }
 
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 25 окт. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_IMPL */
+
+/*
+ * Bit-reversal copy of the real signal x[n] treated as the complex signal
+ * z[n] = x[2*n] + j*x[2*n+1], the output is stored in the split form
+ */
+namespace lsp
+{
+    namespace avx
+    {
+        static inline void FFT_RSCRAMBLE_COPY_DIRECT_NAME(float *dst_re, float *dst_im, const float *src, size_t rank)
+        {
+            size_t regs     = 1 << rank;
+
+            for (size_t i=0; i<regs; ++i)
+            {
+                size_t index    = reverse_bits(FFT_TYPE(i), rank);
+
+                ARCH_X86_ASM
+                (
+                    /* Load scalar values */
+                    __ASM_EMIT("vinsertps       $0x00, 0x00(%[src], %[index], 8), %%xmm0, %%xmm0")       /* xmm0 = r0  x x x         */
+                    __ASM_EMIT("vinsertps       $0x00, 0x04(%[src], %[index], 8), %%xmm2, %%xmm2")       /* xmm2 = i0  x x x         */
+                    __ASM_EMIT("add             %[regs], %[index]")
+                    __ASM_EMIT("vinsertps       $0x00, 0x00(%[src], %[index], 8), %%xmm1, %%xmm1")       /* xmm1 = r8  x x x         */
+                    __ASM_EMIT("vinsertps       $0x00, 0x04(%[src], %[index], 8), %%xmm3, %%xmm3")       /* xmm3 = i8  x x x         */
+                    __ASM_EMIT("add             %[regs], %[index]")
+                    __ASM_EMIT("vinsertps       $0x00, 0x00(%[src], %[index], 8), %%xmm4, %%xmm4")       /* xmm4 = r4  x x x         */
+                    __ASM_EMIT("vinsertps       $0x00, 0x04(%[src], %[index], 8), %%xmm6, %%xmm6")       /* xmm6 = i4  x x x         */
+                    __ASM_EMIT("add             %[regs], %[index]")
+                    __ASM_EMIT("vinsertps       $0x00, 0x00(%[src], %[index], 8), %%xmm5, %%xmm5")       /* xmm5 = r12 x x x         */
+                    __ASM_EMIT("vinsertps       $0x00, 0x04(%[src], %[index], 8), %%xmm7, %%xmm7")       /* xmm7 = i12 x x x         */
+                    __ASM_EMIT("add             %[regs], %[index]")
+
+                    __ASM_EMIT("vinsertps       $0x20, 0x00(%[src], %[index], 8), %%xmm0, %%xmm0")       /* xmm0 = r0  x r2  x       */
+                    __ASM_EMIT("vinsertps       $0x20, 0x04(%[src], %[index], 8), %%xmm2, %%xmm2")       /* xmm2 = i0  x i2  x       */
+                    __ASM_EMIT("add             %[regs], %[index]")
+                    __ASM_EMIT("vinsertps       $0x20, 0x00(%[src], %[index], 8), %%xmm1, %%xmm1")       /* xmm1 = r8  x r10 x       */
+                    __ASM_EMIT("vinsertps       $0x20, 0x04(%[src], %[index], 8), %%xmm3, %%xmm3")       /* xmm3 = i8  x i10 x       */
+                    __ASM_EMIT("add             %[regs], %[index]")
+                    __ASM_EMIT("vinsertps       $0x20, 0x00(%[src], %[index], 8), %%xmm4, %%xmm4")       /* xmm4 = r4  x r6  x       */
+                    __ASM_EMIT("vinsertps       $0x20, 0x04(%[src], %[index], 8), %%xmm6, %%xmm6")       /* xmm6 = i4  x i6  x       */
+                    __ASM_EMIT("add             %[regs], %[index]")
+                    __ASM_EMIT("vinsertps       $0x20, 0x00(%[src], %[index], 8), %%xmm5, %%xmm5")       /* xmm5 = r12 x r14 x       */
+                    __ASM_EMIT("vinsertps       $0x20, 0x04(%[src], %[index], 8), %%xmm7, %%xmm7")       /* xmm7 = i12 x i14 x       */
+                    __ASM_EMIT("add             %[regs], %[index]")
+
+                    __ASM_EMIT("vinsertps       $0x10, 0x00(%[src], %[index], 8), %%xmm0, %%xmm0")       /* xmm0 = r0  r1  r2  x     */
+                    __ASM_EMIT("vinsertps       $0x10, 0x04(%[src], %[index], 8), %%xmm2, %%xmm2")       /* xmm2 = i0  i1  i2  x     */
+                    __ASM_EMIT("add             %[regs], %[index]")
+                    __ASM_EMIT("vinsertps       $0x10, 0x00(%[src], %[index], 8), %%xmm1, %%xmm1")       /* xmm1 = r8  r9  r10 x     */
+                    __ASM_EMIT("vinsertps       $0x10, 0x04(%[src], %[index], 8), %%xmm3, %%xmm3")       /* xmm3 = i8  i9  i10 x     */
+                    __ASM_EMIT("add             %[regs], %[index]")
+                    __ASM_EMIT("vinsertps       $0x10, 0x00(%[src], %[index], 8), %%xmm4, %%xmm4")       /* xmm4 = r4  r5  r6  x     */
+                    __ASM_EMIT("vinsertps       $0x10, 0x04(%[src], %[index], 8), %%xmm6, %%xmm6")       /* xmm6 = i4  i5  i6  x     */
+                    __ASM_EMIT("add             %[regs], %[index]")
+                    __ASM_EMIT("vinsertps       $0x10, 0x00(%[src], %[index], 8), %%xmm5, %%xmm5")       /* xmm5 = r12 r13 r14 x     */
+                    __ASM_EMIT("vinsertps       $0x10, 0x04(%[src], %[index], 8), %%xmm7, %%xmm7")       /* xmm7 = i12 i13 i14 x     */
+                    __ASM_EMIT("add             %[regs], %[index]")
+
+                    __ASM_EMIT("vinsertps       $0x30, 0x00(%[src], %[index], 8), %%xmm0, %%xmm0")       /* xmm0 = r0  r1  r2  r3    */
+                    __ASM_EMIT("vinsertps       $0x30, 0x04(%[src], %[index], 8), %%xmm2, %%xmm2")       /* xmm2 = i0  i1  i2  i3    */
+                    __ASM_EMIT("add             %[regs], %[index]")
+                    __ASM_EMIT("vinsertps       $0x30, 0x00(%[src], %[index], 8), %%xmm1, %%xmm1")       /* xmm1 = r8  r9  r10 r11   */
+                    __ASM_EMIT("vinsertps       $0x30, 0x04(%[src], %[index], 8), %%xmm3, %%xmm3")       /* xmm3 = i8  i9  i10 i11   */
+                    __ASM_EMIT("add             %[regs], %[index]")
+                    __ASM_EMIT("vinsertps       $0x30, 0x00(%[src], %[index], 8), %%xmm4, %%xmm4")       /* xmm4 = r4  r5  r6  r7    */
+                    __ASM_EMIT("vinsertps       $0x30, 0x04(%[src], %[index], 8), %%xmm6, %%xmm6")       /* xmm6 = i4  i5  i6  i7    */
+                    __ASM_EMIT("add             %[regs], %[index]")
+                    __ASM_EMIT("vinsertps       $0x30, 0x00(%[src], %[index], 8), %%xmm5, %%xmm5")       /* xmm5 = r12 r13 r14 r15   */
+                    __ASM_EMIT("vinsertps       $0x30, 0x04(%[src], %[index], 8), %%xmm7, %%xmm7")       /* xmm7 = i12 i13 i14 i15   */
+                    __ASM_EMIT("add             %[regs], %[index]")
+
+                    __ASM_EMIT("vinsertf128     $1, %%xmm1, %%ymm0, %%ymm0")                    /* ymm0 = r0 r1 r2 r3 ...   */
+                    __ASM_EMIT("vinsertf128     $1, %%xmm3, %%ymm2, %%ymm2")                    /* ymm2 = i0 i1 i2 i3 ...   */
+                    __ASM_EMIT("vinsertf128     $1, %%xmm5, %%ymm4, %%ymm4")                    /* ymm4 = r4 r5 r6 r7 ...   */
+                    __ASM_EMIT("vinsertf128     $1, %%xmm7, %%ymm6, %%ymm6")                    /* ymm0 = i4 i5 i6 i7 ...   */
+                    /* 1st-order 4x butterfly */
+                    __ASM_EMIT("vhsubps         %%ymm4, %%ymm0, %%ymm1")                /* ymm1 = r0-r1 r2-r3 r4-r5 r6-r7 = r1' r3' r5' r7' */
+                    __ASM_EMIT("vhsubps         %%ymm6, %%ymm2, %%ymm3")                /* ymm3 = i0-i1 i2-i3 i4-i5 i6-i7 = i1' i3' i5' i7' */
+                    __ASM_EMIT("vhaddps         %%ymm4, %%ymm0, %%ymm0")                /* ymm0 = r0+r1 r2+r3 r4+r5 r6+r7 = r0' r2' r4' r6' */
+                    __ASM_EMIT("vhaddps         %%ymm6, %%ymm2, %%ymm2")                /* ymm2 = i0+i1 i2+i3 i4+i5 i6+i7 = i0' i2' i4' i6' */
+                    /* 2nd-order 4x butterfly */
+                    __ASM_EMIT("vblendps        $0xaa, %%ymm3, %%ymm1, %%ymm4")         /* ymm4 = r1' i3' r5' i7' */
+                    __ASM_EMIT("vblendps        $0xaa, %%ymm1, %%ymm3, %%ymm5")         /* ymm5 = i1' r3' i5' r7' */
+                    __ASM_EMIT("vhsubps         %%ymm4, %%ymm0, %%ymm1")                /* ymm1 = r0'-r2' r4'-r6' r1'-i3' r5'-i7' = r2" r6" r3" r7" */
+                    __ASM_EMIT("vhsubps         %%ymm5, %%ymm2, %%ymm3")                /* ymm3 = i0'-i2' i4'-i6' i1'-r3' i5'-r7' = i2" i6" i1" i5" */
+                    __ASM_EMIT("vhaddps         %%ymm4, %%ymm0, %%ymm0")                /* ymm0 = r0'+r2' r4'+r6' r1'+i3' r5'+i7' = r0" r4" r1" r5" */
+                    __ASM_EMIT("vhaddps         %%ymm5, %%ymm2, %%ymm2")                /* ymm2 = i0'+i2' i4'+i6' i1'+r3' i5'+r7' = i0" i4" i3" i7" */
+                    __ASM_EMIT("vblendps        $0xcc, %%ymm3, %%ymm2, %%ymm4")         /* ymm4 = i0" i4" i1" i5" */
+                    __ASM_EMIT("vblendps        $0xcc, %%ymm2, %%ymm3, %%ymm5")         /* ymm5 = i2" i6" i3" i7" */
+                    __ASM_EMIT("vshufps         $0x88, %%ymm1, %%ymm0, %%ymm2")         /* ymm2 = r0" r1" r2" r3" */
+                    __ASM_EMIT("vshufps         $0xdd, %%ymm1, %%ymm0, %%ymm3")         /* ymm3 = r4" r5" r6" r7" */
+                    __ASM_EMIT("vshufps         $0x88, %%ymm5, %%ymm4, %%ymm6")         /* ymm6 = i0" i1" i2" i3" */
+                    __ASM_EMIT("vshufps         $0xdd, %%ymm5, %%ymm4, %%ymm7")         /* ymm7 = i4" i5" i6" i7" */
+                    /* 3rd-order 8x butterfly */
+                    __ASM_EMIT("vmulps          0x20 + %[FFT_A], %%ymm3, %%ymm4")       /* ymm4 = x_im * b_re */ \
+                    __ASM_EMIT("vmulps          0x20 + %[FFT_A], %%ymm7, %%ymm5")       /* ymm5 = x_im * b_im */ \
+                    __ASM_EMIT(FFT_FMA("vmulps  0x00 + %[FFT_A], %%ymm3, %%ymm3", ""))  /* ymm3 = x_re * b_re */ \
+                    __ASM_EMIT(FFT_FMA("vmulps  0x00 + %[FFT_A], %%ymm7, %%ymm7", ""))  /* ymm7 = x_re * b_im */ \
+                    __ASM_EMIT(FFT_FMA("vaddps  %%ymm5, %%ymm3, %%ymm5", "vfmadd231ps  0x00 + %[FFT_A], %%ymm3, %%ymm5"))       /* ymm5 = c_re = x_re * b_re + x_im * b_im */ \
+                    __ASM_EMIT(FFT_FMA("vsubps  %%ymm4, %%ymm7, %%ymm4", "vfmsub231ps  0x00 + %[FFT_A], %%ymm7, %%ymm4"))       /* ymm4 = c_im = x_re * b_im - x_im * b_re */ \
+                    __ASM_EMIT("vsubps          %%ymm5, %%ymm2, %%ymm0")                /* ymm0 = a_re - c_re */ \
+                    __ASM_EMIT("vsubps          %%ymm4, %%ymm6, %%ymm1")                /* ymm1 = a_im - c_im */ \
+                    __ASM_EMIT("vaddps          %%ymm5, %%ymm2, %%ymm2")                /* ymm2 = a_re + c_re */ \
+                    __ASM_EMIT("vaddps          %%ymm4, %%ymm6, %%ymm3")                /* ymm3 = a_im + c_im */ \
+                    /* Store */
+                    __ASM_EMIT("vmovups         %%xmm2, 0x00(%[dst_re])")
+                    __ASM_EMIT("vmovups         %%xmm0, 0x10(%[dst_re])")
+                    __ASM_EMIT("vextractf128    $1, %%ymm2, 0x20(%[dst_re])")
+                    __ASM_EMIT("vextractf128    $1, %%ymm0, 0x30(%[dst_re])")
+                    __ASM_EMIT("vmovups         %%xmm3, 0x00(%[dst_im])")
+                    __ASM_EMIT("vmovups         %%xmm1, 0x10(%[dst_im])")
+                    __ASM_EMIT("vextractf128    $1, %%ymm3, 0x20(%[dst_im])")
+                    __ASM_EMIT("vextractf128    $1, %%ymm1, 0x30(%[dst_im])")
+                    __ASM_EMIT("add             $0x40, %[dst_re]")
+                    __ASM_EMIT("add             $0x40, %[dst_im]")
+
+                    : [dst_re] "+r" (dst_re), [dst_im] "+r"(dst_im), [index] "+r"(index)
+                    : [src] "r" (src),
+                      [regs] X86_GREG (regs),
+                      [FFT_A] "o" (FFT_A)
+                    : "cc", "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                      "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+                );
+            }
+        }
+    } /* namespace avx */
+} /* namespace lsp */
+
+#undef FFT_RSCRAMBLE_COPY_DIRECT_NAME
+#undef FFT_TYPE
+#undef FFT_FMA
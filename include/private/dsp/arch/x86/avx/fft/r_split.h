@@ -0,0 +1,365 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 24 окт. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_FFT_R_SPLIT_H_
+#define PRIVATE_DSP_ARCH_X86_AVX_FFT_R_SPLIT_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_IMPL */
+
+/*
+ * The real FFT of N points is computed as the complex FFT of N/2 points of the signal
+ * z[n] = x[2*n] + j*x[2*n+1] with further splitting of the spectrum Z[k] into the
+ * spectrum X[k]. Each iteration processes 8 points k = i+1 .. i+8 in the lower half
+ * and 8 points N/2-k in the upper half of the spectrum.
+ *
+ * The twiddle buffer 'w' has the following layout:
+ *   0x00: w_re[8]  - 0.5 * cos(pi*k/(N/2)) for the first 8 points
+ *   0x20: w_im[8]  - 0.5 * sin(pi*k/(N/2)) for the first 8 points
+ *   0x40: dw_re[8] - real part of the rotation step
+ *   0x60: dw_im[8] - imaginary part of the rotation step
+ *   0x80: 0.5[8]   - the scaling constant
+ *
+ * For the packed data the elements of the w_re and w_im vectors are stored in the order
+ * [0 1 4 5 2 3 6 7] which matches the order of elements after the de-interleaving.
+ */
+
+namespace lsp
+{
+    namespace avx
+    {
+        #define FFT_ROTATE_ANGLE8(FMA_SEL) \
+            __ASM_EMIT("vmovaps         0x40(%[w]), %%ymm4")                                /* ymm4 = dw_re */ \
+            __ASM_EMIT("vmovaps         0x60(%[w]), %%ymm5")                                /* ymm5 = dw_im */ \
+            __ASM_EMIT("vmulps          %%ymm5, %%ymm6, %%ymm2")                            /* ymm2 = dw_im * w_re */ \
+            __ASM_EMIT("vmulps          %%ymm5, %%ymm7, %%ymm3")                            /* ymm3 = dw_im * w_im */ \
+            __ASM_EMIT(FMA_SEL("vmulps  %%ymm4, %%ymm6, %%ymm6", ""))                       /* ymm6 = dw_re * w_re */ \
+            __ASM_EMIT(FMA_SEL("vmulps  %%ymm4, %%ymm7, %%ymm7", ""))                       /* ymm7 = dw_re * w_im */ \
+            __ASM_EMIT(FMA_SEL("vsubps  %%ymm3, %%ymm6, %%ymm6", "vfmsub132ps %%ymm4, %%ymm3, %%ymm6")) /* ymm6 = w_re' = dw_re * w_re - dw_im * w_im */ \
+            __ASM_EMIT(FMA_SEL("vaddps  %%ymm2, %%ymm7, %%ymm7", "vfmadd132ps %%ymm4, %%ymm2, %%ymm7")) /* ymm7 = w_im' = dw_re * w_im + dw_im * w_re */
+
+        /* Input:  ymm0 = a_re, ymm1 = a_im, ymm2 = b_re, ymm3 = b_im
+         * Output: ymm0 = a_re', ymm1 = a_im', ymm4 = b_re', ymm5 = b_im'
+         */
+        #define RFFT_DIRECT_SPLIT8(FMA_SEL) \
+            __ASM_EMIT("vaddps          %%ymm2, %%ymm0, %%ymm4")                            /* ymm4 = a_re + b_re */ \
+            __ASM_EMIT("vsubps          %%ymm0, %%ymm2, %%ymm2")                            /* ymm2 = fo_im = b_re - a_re */ \
+            __ASM_EMIT("vsubps          %%ymm3, %%ymm1, %%ymm5")                            /* ymm5 = a_im - b_im */ \
+            __ASM_EMIT("vaddps          %%ymm3, %%ymm1, %%ymm1")                            /* ymm1 = fo_re = a_im + b_im */ \
+            __ASM_EMIT("vmulps          0x80(%[w]), %%ymm4, %%ymm4")                        /* ymm4 = fe_re = (a_re + b_re)/2 */ \
+            __ASM_EMIT("vmulps          0x80(%[w]), %%ymm5, %%ymm5")                        /* ymm5 = fe_im = (a_im - b_im)/2 */ \
+            /* Calculate t = conj(w) * fo */ \
+            __ASM_EMIT("vmulps          %%ymm7, %%ymm1, %%ymm0")                            /* ymm0 = w_im * fo_re */ \
+            __ASM_EMIT("vmulps          %%ymm7, %%ymm2, %%ymm3")                            /* ymm3 = w_im * fo_im */ \
+            __ASM_EMIT(FMA_SEL("vmulps  %%ymm6, %%ymm1, %%ymm1", ""))                       /* ymm1 = w_re * fo_re */ \
+            __ASM_EMIT(FMA_SEL("vmulps  %%ymm6, %%ymm2, %%ymm2", ""))                       /* ymm2 = w_re * fo_im */ \
+            __ASM_EMIT(FMA_SEL("vaddps  %%ymm3, %%ymm1, %%ymm1", "vfmadd132ps %%ymm6, %%ymm3, %%ymm1")) /* ymm1 = t_re = w_re * fo_re + w_im * fo_im */ \
+            __ASM_EMIT(FMA_SEL("vsubps  %%ymm0, %%ymm2, %%ymm2", "vfmsub132ps %%ymm6, %%ymm0, %%ymm2")) /* ymm2 = t_im = w_re * fo_im - w_im * fo_re */ \
+            /* Calculate a' = fe + t, b' = conj(fe - t) */ \
+            __ASM_EMIT("vaddps          %%ymm1, %%ymm4, %%ymm0")                            /* ymm0 = a_re' = fe_re + t_re */ \
+            __ASM_EMIT("vsubps          %%ymm1, %%ymm4, %%ymm4")                            /* ymm4 = b_re' = fe_re - t_re */ \
+            __ASM_EMIT("vaddps          %%ymm2, %%ymm5, %%ymm1")                            /* ymm1 = a_im' = fe_im + t_im */ \
+            __ASM_EMIT("vsubps          %%ymm5, %%ymm2, %%ymm5")                            /* ymm5 = b_im' = t_im - fe_im */
+
+        /* Input:  ymm0 = a_re, ymm1 = a_im, ymm2 = b_re, ymm3 = b_im
+         * Output: ymm0 = za_re, ymm1 = za_im, ymm4 = zb_re, ymm5 = zb_im
+         */
+        #define RFFT_REVERSE_SPLIT8(FMA_SEL) \
+            __ASM_EMIT("vaddps          %%ymm2, %%ymm0, %%ymm4")                            /* ymm4 = a_re + b_re */ \
+            __ASM_EMIT("vsubps          %%ymm2, %%ymm0, %%ymm0")                            /* ymm0 = d_re = a_re - b_re */ \
+            __ASM_EMIT("vsubps          %%ymm3, %%ymm1, %%ymm5")                            /* ymm5 = a_im - b_im */ \
+            __ASM_EMIT("vaddps          %%ymm3, %%ymm1, %%ymm1")                            /* ymm1 = d_im = a_im + b_im */ \
+            __ASM_EMIT("vmulps          0x80(%[w]), %%ymm4, %%ymm4")                        /* ymm4 = fe_re = (a_re + b_re)/2 */ \
+            __ASM_EMIT("vmulps          0x80(%[w]), %%ymm5, %%ymm5")                        /* ymm5 = fe_im = (a_im - b_im)/2 */ \
+            /* Calculate fo = w * d */ \
+            __ASM_EMIT("vmulps          %%ymm7, %%ymm0, %%ymm2")                            /* ymm2 = w_im * d_re */ \
+            __ASM_EMIT("vmulps          %%ymm7, %%ymm1, %%ymm3")                            /* ymm3 = w_im * d_im */ \
+            __ASM_EMIT(FMA_SEL("vmulps  %%ymm6, %%ymm0, %%ymm0", ""))                       /* ymm0 = w_re * d_re */ \
+            __ASM_EMIT(FMA_SEL("vmulps  %%ymm6, %%ymm1, %%ymm1", ""))                       /* ymm1 = w_re * d_im */ \
+            __ASM_EMIT(FMA_SEL("vsubps  %%ymm3, %%ymm0, %%ymm0", "vfmsub132ps %%ymm6, %%ymm3, %%ymm0")) /* ymm0 = fo_re = w_re * d_re - w_im * d_im */ \
+            __ASM_EMIT(FMA_SEL("vaddps  %%ymm2, %%ymm1, %%ymm1", "vfmadd132ps %%ymm6, %%ymm2, %%ymm1")) /* ymm1 = fo_im = w_re * d_im + w_im * d_re */ \
+            /* Calculate za = fe + j*fo, zb = conj(fe) + j*conj(fo) */ \
+            __ASM_EMIT("vsubps          %%ymm1, %%ymm4, %%ymm2")                            /* ymm2 = za_re = fe_re - fo_im */ \
+            __ASM_EMIT("vaddps          %%ymm1, %%ymm4, %%ymm4")                            /* ymm4 = zb_re = fe_re + fo_im */ \
+            __ASM_EMIT("vaddps          %%ymm0, %%ymm5, %%ymm1")                            /* ymm1 = za_im = fe_im + fo_re */ \
+            __ASM_EMIT("vsubps          %%ymm5, %%ymm0, %%ymm5")                            /* ymm5 = zb_im = fo_re - fe_im */ \
+            __ASM_EMIT("vmovaps         %%ymm2, %%ymm0")                                    /* ymm0 = za_re */
+
+        /* Load split data: ymm0 = a_re, ymm1 = a_im, ymm2 = b_re, ymm3 = b_im */
+        #define RFFT_LOAD_SPLIT8(re, im) \
+            __ASM_EMIT("vmovups         0x00(%[" re "], %[off2]), %%ymm2")                  /* ymm2 = b_re in reverse order */ \
+            __ASM_EMIT("vmovups         0x00(%[" im "], %[off2]), %%ymm3")                  /* ymm3 = b_im in reverse order */ \
+            __ASM_EMIT("vmovups         0x00(%[" re "], %[off1]), %%ymm0")                  /* ymm0 = a_re */ \
+            __ASM_EMIT("vmovups         0x00(%[" im "], %[off1]), %%ymm1")                  /* ymm1 = a_im */ \
+            __ASM_EMIT("vperm2f128      $0x01, %%ymm2, %%ymm2, %%ymm2") \
+            __ASM_EMIT("vperm2f128      $0x01, %%ymm3, %%ymm3, %%ymm3") \
+            __ASM_EMIT("vpermilps       $0x1b, %%ymm2, %%ymm2")                             /* ymm2 = b_re */ \
+            __ASM_EMIT("vpermilps       $0x1b, %%ymm3, %%ymm3")                             /* ymm3 = b_im */
+
+        /* Load packed data: ymm0 = a_re, ymm1 = a_im, ymm2 = b_re, ymm3 = b_im
+         * in the order of elements [0 1 4 5 2 3 6 7]
+         */
+        #define RFFT_LOAD_PACKED8(src) \
+            __ASM_EMIT("vmovups         0x00(%[" src "], %[off1]), %%ymm4")                 /* ymm4 = a0 a1 a2 a3 */ \
+            __ASM_EMIT("vmovups         0x20(%[" src "], %[off1]), %%ymm5")                 /* ymm5 = a4 a5 a6 a7 */ \
+            __ASM_EMIT("vmovups         0x00(%[" src "], %[off2]), %%ymm2")                 /* ymm2 = b7 b6 b5 b4 */ \
+            __ASM_EMIT("vmovups         0x20(%[" src "], %[off2]), %%ymm3")                 /* ymm3 = b3 b2 b1 b0 */ \
+            __ASM_EMIT("vshufps         $0x88, %%ymm5, %%ymm4, %%ymm0")                     /* ymm0 = a_re */ \
+            __ASM_EMIT("vshufps         $0xdd, %%ymm5, %%ymm4, %%ymm1")                     /* ymm1 = a_im */ \
+            __ASM_EMIT("vperm2f128      $0x01, %%ymm2, %%ymm2, %%ymm2")                     /* ymm2 = b5 b4 b7 b6 */ \
+            __ASM_EMIT("vperm2f128      $0x01, %%ymm3, %%ymm3, %%ymm3")                     /* ymm3 = b1 b0 b3 b2 */ \
+            __ASM_EMIT("vshufps         $0x22, %%ymm2, %%ymm3, %%ymm4")                     /* ymm4 = b_re */ \
+            __ASM_EMIT("vshufps         $0x77, %%ymm2, %%ymm3, %%ymm3")                     /* ymm3 = b_im */ \
+            __ASM_EMIT("vmovaps         %%ymm4, %%ymm2")                                    /* ymm2 = b_re */
+
+        /* Store packed data: ymm0 = a_re, ymm1 = a_im, ymm4 = b_re, ymm5 = b_im
+         * in the order of elements [0 1 4 5 2 3 6 7]
+         */
+        #define RFFT_STORE_PACKED8(dst, scale) \
+            __ASM_EMIT("vunpcklps       %%ymm1, %%ymm0, %%ymm2")                            /* ymm2 = a0 a1 a2 a3 */ \
+            __ASM_EMIT("vunpckhps       %%ymm1, %%ymm0, %%ymm3")                            /* ymm3 = a4 a5 a6 a7 */ \
+            __ASM_EMIT("vunpcklps       %%ymm5, %%ymm4, %%ymm0")                            /* ymm0 = b0 b1 b2 b3 */ \
+            __ASM_EMIT("vunpckhps       %%ymm5, %%ymm4, %%ymm1")                            /* ymm1 = b4 b5 b6 b7 */ \
+            __ASM_EMIT("vpermilps       $0x4e, %%ymm0, %%ymm0")                             /* ymm0 = b1 b0 b3 b2 */ \
+            __ASM_EMIT("vpermilps       $0x4e, %%ymm1, %%ymm1")                             /* ymm1 = b5 b4 b7 b6 */ \
+            __ASM_EMIT("vperm2f128      $0x01, %%ymm0, %%ymm0, %%ymm0")                     /* ymm0 = b3 b2 b1 b0 */ \
+            __ASM_EMIT("vperm2f128      $0x01, %%ymm1, %%ymm1, %%ymm1")                     /* ymm1 = b7 b6 b5 b4 */ \
+            __ASM_EMIT("vmovups         %%ymm2, 0x00(%[" dst "], %[off1], " scale ")") \
+            __ASM_EMIT("vmovups         %%ymm3, 0x20(%[" dst "], %[off1], " scale ")") \
+            __ASM_EMIT("vmovups         %%ymm1, 0x00(%[" dst "], %[off2], " scale ")") \
+            __ASM_EMIT("vmovups         %%ymm0, 0x20(%[" dst "], %[off2], " scale ")")
+
+        #define RFFT_LOOP_END(step) \
+            __ASM_EMIT("add             $" step ", %[off1]") \
+            __ASM_EMIT("sub             $" step ", %[off2]") \
+            __ASM_EMIT32("subl          $8, %[np]") \
+            __ASM_EMIT64("subq          $8, %[np]") \
+            __ASM_EMIT("jz              2f")
+
+        #define RFFT_DIRECT_SPLIT_BODY8(FMA_SEL) \
+            ARCH_X86_ASM \
+            ( \
+                __ASM_EMIT("vmovaps         0x00(%[w]), %%ymm6")                            /* ymm6 = w_re */ \
+                __ASM_EMIT("vmovaps         0x20(%[w]), %%ymm7")                            /* ymm7 = w_im */ \
+                __ASM_EMIT("1:") \
+                    RFFT_LOAD_SPLIT8("dst_re", "dst_im") \
+                    RFFT_DIRECT_SPLIT8(FMA_SEL) \
+                    __ASM_EMIT("vperm2f128      $0x01, %%ymm4, %%ymm4, %%ymm4") \
+                    __ASM_EMIT("vperm2f128      $0x01, %%ymm5, %%ymm5, %%ymm5") \
+                    __ASM_EMIT("vpermilps       $0x1b, %%ymm4, %%ymm4")                     /* ymm4 = b_re' in reverse order */ \
+                    __ASM_EMIT("vpermilps       $0x1b, %%ymm5, %%ymm5")                     /* ymm5 = b_im' in reverse order */ \
+                    __ASM_EMIT("vmovups         %%ymm0, 0x00(%[dst_re], %[off1])") \
+                    __ASM_EMIT("vmovups         %%ymm1, 0x00(%[dst_im], %[off1])") \
+                    __ASM_EMIT("vmovups         %%ymm4, 0x00(%[dst_re], %[off2])") \
+                    __ASM_EMIT("vmovups         %%ymm5, 0x00(%[dst_im], %[off2])") \
+                    RFFT_LOOP_END("0x20") \
+                    FFT_ROTATE_ANGLE8(FMA_SEL) \
+                __ASM_EMIT("jmp             1b") \
+                __ASM_EMIT("2:") \
+                \
+                : [off1] "+r" (off1), [off2] "+r" (off2), \
+                  [np] X86_PGREG (np) \
+                : [dst_re] "r" (dst_re), [dst_im] "r" (dst_im), \
+                  [w] "r" (w) \
+                : "cc", "memory",  \
+                "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                "%xmm4", "%xmm5", "%xmm6", "%xmm7"  \
+            );
+
+        #define RFFT_PACKED_DIRECT_SPLIT_BODY8(FMA_SEL) \
+            ARCH_X86_ASM \
+            ( \
+                __ASM_EMIT("vmovaps         0x00(%[w]), %%ymm6")                            /* ymm6 = w_re */ \
+                __ASM_EMIT("vmovaps         0x20(%[w]), %%ymm7")                            /* ymm7 = w_im */ \
+                __ASM_EMIT("1:") \
+                    RFFT_LOAD_PACKED8("dst") \
+                    RFFT_DIRECT_SPLIT8(FMA_SEL) \
+                    RFFT_STORE_PACKED8("dst", "1") \
+                    RFFT_LOOP_END("0x40") \
+                    FFT_ROTATE_ANGLE8(FMA_SEL) \
+                __ASM_EMIT("jmp             1b") \
+                __ASM_EMIT("2:") \
+                \
+                : [off1] "+r" (off1), [off2] "+r" (off2), \
+                  [np] X86_PGREG (np) \
+                : [dst] "r" (dst), \
+                  [w] "r" (w) \
+                : "cc", "memory",  \
+                "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                "%xmm4", "%xmm5", "%xmm6", "%xmm7"  \
+            );
+
+        #define RFFT_REVERSE_SPLIT_BODY8(FMA_SEL) \
+            ARCH_X86_ASM \
+            ( \
+                __ASM_EMIT("vmovaps         0x00(%[w]), %%ymm6")                            /* ymm6 = w_re */ \
+                __ASM_EMIT("vmovaps         0x20(%[w]), %%ymm7")                            /* ymm7 = w_im */ \
+                __ASM_EMIT("1:") \
+                    RFFT_LOAD_SPLIT8("src_re", "src_im") \
+                    RFFT_REVERSE_SPLIT8(FMA_SEL) \
+                    /* Pack and store za */ \
+                    __ASM_EMIT("vunpcklps       %%ymm1, %%ymm0, %%ymm2")                    /* ymm2 = a0 a1 a4 a5 */ \
+                    __ASM_EMIT("vunpckhps       %%ymm1, %%ymm0, %%ymm3")                    /* ymm3 = a2 a3 a6 a7 */ \
+                    __ASM_EMIT("vperm2f128      $0x20, %%ymm3, %%ymm2, %%ymm0")             /* ymm0 = a0 a1 a2 a3 */ \
+                    __ASM_EMIT("vperm2f128      $0x31, %%ymm3, %%ymm2, %%ymm1")             /* ymm1 = a4 a5 a6 a7 */ \
+                    __ASM_EMIT("vmovups         %%ymm0, 0x00(%[dst], %[off1], 2)") \
+                    __ASM_EMIT("vmovups         %%ymm1, 0x20(%[dst], %[off1], 2)") \
+                    /* Pack and store zb */ \
+                    __ASM_EMIT("vunpcklps       %%ymm5, %%ymm4, %%ymm2")                    /* ymm2 = b0 b1 b4 b5 */ \
+                    __ASM_EMIT("vunpckhps       %%ymm5, %%ymm4, %%ymm3")                    /* ymm3 = b2 b3 b6 b7 */ \
+                    __ASM_EMIT("vperm2f128      $0x13, %%ymm3, %%ymm2, %%ymm0")             /* ymm0 = b6 b7 b4 b5 */ \
+                    __ASM_EMIT("vperm2f128      $0x02, %%ymm3, %%ymm2, %%ymm1")             /* ymm1 = b2 b3 b0 b1 */ \
+                    __ASM_EMIT("vpermilps       $0x4e, %%ymm0, %%ymm0")                     /* ymm0 = b7 b6 b5 b4 */ \
+                    __ASM_EMIT("vpermilps       $0x4e, %%ymm1, %%ymm1")                     /* ymm1 = b3 b2 b1 b0 */ \
+                    __ASM_EMIT("vmovups         %%ymm0, 0x00(%[dst], %[off2], 2)") \
+                    __ASM_EMIT("vmovups         %%ymm1, 0x20(%[dst], %[off2], 2)") \
+                    RFFT_LOOP_END("0x20") \
+                    FFT_ROTATE_ANGLE8(FMA_SEL) \
+                __ASM_EMIT("jmp             1b") \
+                __ASM_EMIT("2:") \
+                \
+                : [off1] "+r" (off1), [off2] "+r" (off2), \
+                  [np] X86_PGREG (np) \
+                : [dst] "r" (dst), \
+                  [src_re] "r" (src_re), [src_im] "r" (src_im), \
+                  [w] "r" (w) \
+                : "cc", "memory",  \
+                "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                "%xmm4", "%xmm5", "%xmm6", "%xmm7"  \
+            );
+
+        #define RFFT_PACKED_REVERSE_SPLIT_BODY8(FMA_SEL) \
+            ARCH_X86_ASM \
+            ( \
+                __ASM_EMIT("vmovaps         0x00(%[w]), %%ymm6")                            /* ymm6 = w_re */ \
+                __ASM_EMIT("vmovaps         0x20(%[w]), %%ymm7")                            /* ymm7 = w_im */ \
+                __ASM_EMIT("1:") \
+                    RFFT_LOAD_PACKED8("src") \
+                    RFFT_REVERSE_SPLIT8(FMA_SEL) \
+                    RFFT_STORE_PACKED8("dst", "1") \
+                    RFFT_LOOP_END("0x40") \
+                    FFT_ROTATE_ANGLE8(FMA_SEL) \
+                __ASM_EMIT("jmp             1b") \
+                __ASM_EMIT("2:") \
+                \
+                : [off1] "+r" (off1), [off2] "+r" (off2), \
+                  [np] X86_PGREG (np) \
+                : [dst] "r" (dst), [src] "r" (src), \
+                  [w] "r" (w) \
+                : "cc", "memory",  \
+                "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                "%xmm4", "%xmm5", "%xmm6", "%xmm7"  \
+            );
+
+    #define FMA_OFF(a, b)       a
+    #define FMA_ON(a, b)        b
+
+        static inline void real_fft_direct_split8(float *dst_re, float *dst_im, const float *w, size_t rank)
+        {
+            size_t np       = 1 << (rank - 2);
+            size_t off1     = sizeof(float);
+            size_t off2     = ((np << 1) - 8) * sizeof(float);
+
+            RFFT_DIRECT_SPLIT_BODY8(FMA_OFF);
+        }
+
+        static inline void packed_real_fft_direct_split8(float *dst, const float *w, size_t rank)
+        {
+            size_t np       = 1 << (rank - 2);
+            size_t off1     = 2 * sizeof(float);
+            size_t off2     = ((np << 1) - 8) * 2 * sizeof(float);
+
+            RFFT_PACKED_DIRECT_SPLIT_BODY8(FMA_OFF);
+        }
+
+        static inline void real_fft_reverse_split8(float *dst, const float *src_re, const float *src_im, const float *w, size_t rank)
+        {
+            size_t np       = 1 << (rank - 2);
+            size_t off1     = sizeof(float);
+            size_t off2     = ((np << 1) - 8) * sizeof(float);
+
+            RFFT_REVERSE_SPLIT_BODY8(FMA_OFF);
+        }
+
+        static inline void packed_real_fft_reverse_split8(float *dst, const float *src, const float *w, size_t rank)
+        {
+            size_t np       = 1 << (rank - 2);
+            size_t off1     = 2 * sizeof(float);
+            size_t off2     = ((np << 1) - 8) * 2 * sizeof(float);
+
+            RFFT_PACKED_REVERSE_SPLIT_BODY8(FMA_OFF);
+        }
+
+        static inline void real_fft_direct_split8_fma3(float *dst_re, float *dst_im, const float *w, size_t rank)
+        {
+            size_t np       = 1 << (rank - 2);
+            size_t off1     = sizeof(float);
+            size_t off2     = ((np << 1) - 8) * sizeof(float);
+
+            RFFT_DIRECT_SPLIT_BODY8(FMA_ON);
+        }
+
+        static inline void packed_real_fft_direct_split8_fma3(float *dst, const float *w, size_t rank)
+        {
+            size_t np       = 1 << (rank - 2);
+            size_t off1     = 2 * sizeof(float);
+            size_t off2     = ((np << 1) - 8) * 2 * sizeof(float);
+
+            RFFT_PACKED_DIRECT_SPLIT_BODY8(FMA_ON);
+        }
+
+        static inline void real_fft_reverse_split8_fma3(float *dst, const float *src_re, const float *src_im, const float *w, size_t rank)
+        {
+            size_t np       = 1 << (rank - 2);
+            size_t off1     = sizeof(float);
+            size_t off2     = ((np << 1) - 8) * sizeof(float);
+
+            RFFT_REVERSE_SPLIT_BODY8(FMA_ON);
+        }
+
+        static inline void packed_real_fft_reverse_split8_fma3(float *dst, const float *src, const float *w, size_t rank)
+        {
+            size_t np       = 1 << (rank - 2);
+            size_t off1     = 2 * sizeof(float);
+            size_t off2     = ((np << 1) - 8) * 2 * sizeof(float);
+
+            RFFT_PACKED_REVERSE_SPLIT_BODY8(FMA_ON);
+        }
+
+    #undef FMA_OFF
+    #undef FMA_ON
+
+    #undef RFFT_PACKED_REVERSE_SPLIT_BODY8
+    #undef RFFT_REVERSE_SPLIT_BODY8
+    #undef RFFT_PACKED_DIRECT_SPLIT_BODY8
+    #undef RFFT_DIRECT_SPLIT_BODY8
+    #undef RFFT_LOOP_END
+    #undef RFFT_STORE_PACKED8
+    #undef RFFT_LOAD_PACKED8
+    #undef RFFT_LOAD_SPLIT8
+    #undef RFFT_REVERSE_SPLIT8
+    #undef RFFT_DIRECT_SPLIT8
+    #undef FFT_ROTATE_ANGLE8
+    } /* namespace avx */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_FFT_R_SPLIT_H_ */
@@ -0,0 +1,378 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_FFT64_H_
+#define PRIVATE_DSP_ARCH_X86_AVX_FFT64_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_IMPL */
+
+namespace lsp
+{
+    namespace avx
+    {
+        #define FFT64_SCRAMBLE(name, type) \
+            static void name(type *dst_re, type *dst_im, const type *src_re, const type *src_im, size_t rank) \
+            { \
+                const size_t items  = size_t(1) << rank; \
+                \
+                if ((dst_re != src_re) && (dst_im != src_im)) \
+                { \
+                    for (size_t i=0; i<items; ++i) \
+                    { \
+                        size_t j        = reverse_bits(uint32_t(i), rank); \
+                        dst_re[i]       = src_re[j]; \
+                        dst_im[i]       = src_im[j]; \
+                    } \
+                    return; \
+                } \
+                \
+                /* Copy data first and then perform swaps */ \
+                for (size_t i=0; i<items; ++i) \
+                { \
+                    dst_re[i]       = src_re[i]; \
+                    dst_im[i]       = src_im[i]; \
+                } \
+                \
+                for (size_t i=1; i<(items - 1); ++i) \
+                { \
+                    size_t j        = reverse_bits(uint32_t(i), rank); \
+                    if (i >= j) \
+                        continue; \
+                    \
+                    type re         = dst_re[i]; \
+                    type im         = dst_im[i]; \
+                    dst_re[i]       = dst_re[j]; \
+                    dst_im[i]       = dst_im[j]; \
+                    dst_re[j]       = re; \
+                    dst_im[j]       = im; \
+                } \
+            }
+
+        #define FFT64_START(name, type, op1, op2) \
+            static void name(type *dst_re, type *dst_im, size_t rank) \
+            { \
+                for (size_t i=0, n=size_t(1) << rank; i<n; i += 4) \
+                { \
+                    type s0_re      = dst_re[i+0] + dst_re[i+1]; \
+                    type s1_re      = dst_re[i+0] - dst_re[i+1]; \
+                    type s2_re      = dst_re[i+2] + dst_re[i+3]; \
+                    type s3_re      = dst_re[i+2] - dst_re[i+3]; \
+                    \
+                    type s0_im      = dst_im[i+0] + dst_im[i+1]; \
+                    type s1_im      = dst_im[i+0] - dst_im[i+1]; \
+                    type s2_im      = dst_im[i+2] + dst_im[i+3]; \
+                    type s3_im      = dst_im[i+2] - dst_im[i+3]; \
+                    \
+                    dst_re[i+0]     = s0_re + s2_re; \
+                    dst_re[i+1]     = s1_re op1 s3_im; \
+                    dst_re[i+2]     = s0_re - s2_re; \
+                    dst_re[i+3]     = s1_re op2 s3_im; \
+                    \
+                    dst_im[i+0]     = s0_im + s2_im; \
+                    dst_im[i+1]     = s1_im op2 s3_re; \
+                    dst_im[i+2]     = s0_im - s2_im; \
+                    dst_im[i+3]     = s1_im op1 s3_re; \
+                } \
+            }
+
+        FFT64_SCRAMBLE(fft64_scramble, double)
+        FFT64_SCRAMBLE(fft64_scramble_mp, float)
+        FFT64_START(fft64_start_direct, double, +, -)
+        FFT64_START(fft64_start_reverse, double, -, +)
+        FFT64_START(fft64_start_direct_mp, float, +, -)
+        FFT64_START(fft64_start_reverse_mp, float, -, +)
+
+        #undef FFT64_SCRAMBLE
+        #undef FFT64_START
+
+        /*
+         * Transforms of rank 1 and less, the 'type' is float or double
+         */
+        #define FFT64_SMALL(name, type) \
+            static bool name(type *dst_re, type *dst_im, const type *src_re, const type *src_im, size_t rank, type k) \
+            { \
+                if (rank > 1) \
+                    return false; \
+                \
+                if (rank == 1) \
+                { \
+                    type s1_re      = src_re[1]; \
+                    type s1_im      = src_im[1]; \
+                    dst_re[1]       = (src_re[0] - s1_re) * k; \
+                    dst_im[1]       = (src_im[0] - s1_im) * k; \
+                    dst_re[0]       = (src_re[0] + s1_re) * k; \
+                    dst_im[0]       = (src_im[0] + s1_im) * k; \
+                } \
+                else \
+                { \
+                    dst_re[0]       = src_re[0]; \
+                    dst_im[0]       = src_im[0]; \
+                } \
+                \
+                return true; \
+            }
+
+        FFT64_SMALL(fft64_small, double)
+        FFT64_SMALL(fft64_small_mp, float)
+
+        #undef FFT64_SMALL
+
+        /**
+         * Compute the initial twiddle factors and the rotation step of the butterfly
+         * stage in double precision
+         *
+         * @param tw destination buffer: real parts of initial twiddle factors, imaginary parts
+         *   of initial twiddle factors, the real part of the rotation step twice and the imaginary
+         *   part of the rotation step twice, (lanes*2 + 4) elements
+         * @param n number of butterflies in the block
+         * @param lanes number of twiddle factors processed at once
+         */
+        static inline void fft64_stage_twiddle(double *tw, size_t n, size_t lanes)
+        {
+            const double k  = M_PI / double(n);
+
+            for (size_t i=0; i<lanes; ++i)
+            {
+                tw[i]           = cos(k * i);
+                tw[i + lanes]   = sin(k * i);
+            }
+            tw[lanes*2]     = cos(k * lanes);
+            tw[lanes*2 + 1] = tw[lanes*2];
+            tw[lanes*2 + 2] = sin(k * lanes);
+            tw[lanes*2 + 3] = tw[lanes*2 + 2];
+        }
+
+    /*
+     * Complex multiplication c = w * b where ymm6 = w_re, ymm7 = w_im,
+     * ymm2 = b_re, ymm3 = b_im, the result is ymm0 = c_re, ymm1 = c_im:
+     *   c_re = w_re * b_re +- w_im * b_im
+     *   c_im = w_re * b_im -+ w_im * b_re
+     * The SEL macro selects between the AVX and the FMA3 code
+     */
+    #define FFT64_CMUL(W_RE, W_IM, R, S, op1, op2, SEL) \
+        __ASM_EMIT(SEL("vmul" S "      %%" W_RE ", %%" R "2, %%" R "0", "vmul" S "      %%" W_IM ", %%" R "3, %%" R "0"))  /* r0 = w_re * b_re | w_im * b_im */ \
+        __ASM_EMIT(SEL("vmul" S "      %%" W_RE ", %%" R "3, %%" R "1", "vmul" S "      %%" W_IM ", %%" R "2, %%" R "1"))  /* r1 = w_re * b_im | w_im * b_re */ \
+        __ASM_EMIT(SEL("vmul" S "      %%" W_IM ", %%" R "2, %%" R "2", ""))                                              /* r2 = w_im * b_re */ \
+        __ASM_EMIT(SEL("vmul" S "      %%" W_IM ", %%" R "3, %%" R "3", ""))                                              /* r3 = w_im * b_im */ \
+        __ASM_EMIT(SEL(op1 "      %%" R "3, %%" R "0, %%" R "0", op1 "  %%" W_RE ", %%" R "2, %%" R "0"))                /* r0 = c_re = w_re * b_re +- w_im * b_im */ \
+        __ASM_EMIT(SEL(op2 "      %%" R "2, %%" R "1, %%" R "1", op2 "  %%" W_RE ", %%" R "3, %%" R "1"))                /* r1 = c_im = w_re * b_im -+ w_im * b_re */
+
+    /*
+     * Butterfly a' = a + c, b' = a - c and advance pointers
+     */
+    #define FFT64_APPLY(R, S, STEP) \
+        __ASM_EMIT("vmovu" S "     (%[a_re]), %%" R "2")                         /* r2 = a_re */ \
+        __ASM_EMIT("vmovu" S "     (%[a_im]), %%" R "3")                         /* r3 = a_im */ \
+        __ASM_EMIT("vsub" S "      %%" R "0, %%" R "2, %%" R "4")                /* r4 = a_re - c_re */ \
+        __ASM_EMIT("vsub" S "      %%" R "1, %%" R "3, %%" R "5")                /* r5 = a_im - c_im */ \
+        __ASM_EMIT("vadd" S "      %%" R "0, %%" R "2, %%" R "2")                /* r2 = a_re + c_re */ \
+        __ASM_EMIT("vadd" S "      %%" R "1, %%" R "3, %%" R "3")                /* r3 = a_im + c_im */ \
+        __ASM_EMIT("vmovu" S "     %%" R "2, (%[a_re])") \
+        __ASM_EMIT("vmovu" S "     %%" R "3, (%[a_im])") \
+        __ASM_EMIT("vmovu" S "     %%" R "4, (%[a_re], %[nb])") \
+        __ASM_EMIT("vmovu" S "     %%" R "5, (%[a_im], %[nb])") \
+        __ASM_EMIT("add         $" STEP ", %[a_re]") \
+        __ASM_EMIT("add         $" STEP ", %[a_im]")
+
+    /*
+     * Rotation of the twiddle factors in double precision: ymm6 = w_re, ymm7 = w_im
+     */
+    #define FFT64_ROTATE(SEL) \
+        __ASM_EMIT("vbroadcastsd 0x40 + %[tw], %%ymm4")                          /* ymm4 = dw_re */ \
+        __ASM_EMIT("vbroadcastsd 0x50 + %[tw], %%ymm5")                          /* ymm5 = dw_im */ \
+        __ASM_EMIT(SEL("vmulpd      %%ymm4, %%ymm6, %%ymm0", "vmulpd      %%ymm5, %%ymm7, %%ymm0"))          /* ymm0 = w_re * dw_re | w_im * dw_im */ \
+        __ASM_EMIT(SEL("vmulpd      %%ymm5, %%ymm7, %%ymm1", "vmulpd      %%ymm4, %%ymm7, %%ymm1"))          /* ymm1 = w_im * dw_im | w_im * dw_re */ \
+        __ASM_EMIT(SEL("vmulpd      %%ymm5, %%ymm6, %%ymm2", ""))                                            /* ymm2 = w_re * dw_im */ \
+        __ASM_EMIT(SEL("vmulpd      %%ymm4, %%ymm7, %%ymm3", ""))                                            /* ymm3 = w_im * dw_re */ \
+        __ASM_EMIT(SEL("vsubpd      %%ymm1, %%ymm0, %%ymm6", "vfmsub231pd %%ymm4, %%ymm6, %%ymm0"))          /* w_re' = w_re * dw_re - w_im * dw_im */ \
+        __ASM_EMIT(SEL("vaddpd      %%ymm3, %%ymm2, %%ymm7", "vfmadd231pd %%ymm5, %%ymm6, %%ymm1"))          /* w_im' = w_re * dw_im + w_im * dw_re */ \
+        __ASM_EMIT(SEL("", "vmovapd     %%ymm0, %%ymm6")) \
+        __ASM_EMIT(SEL("", "vmovapd     %%ymm1, %%ymm7"))
+
+    /*
+     * Butterflies of one stage in double precision, 4 butterflies per iteration
+     */
+    #define FFT64_BUTTERFLY_F64(op1, op2, SEL) \
+        __ASM_EMIT("1:") \
+        __ASM_EMIT("vmovapd     0x00 + %[tw], %%ymm6")                      /* ymm6 = w_re */ \
+        __ASM_EMIT("vmovapd     0x20 + %[tw], %%ymm7")                      /* ymm7 = w_im */ \
+        __ASM_EMIT("mov         %[n], %[k]") \
+        __ASM_EMIT("2:") \
+        __ASM_EMIT("vmovupd     (%[a_re], %[nb]), %%ymm2")                  /* ymm2 = b_re */ \
+        __ASM_EMIT("vmovupd     (%[a_im], %[nb]), %%ymm3")                  /* ymm3 = b_im */ \
+        FFT64_CMUL("ymm6", "ymm7", "ymm", "pd", op1, op2, SEL) \
+        FFT64_APPLY("ymm", "pd", "0x20") \
+        __ASM_EMIT("sub         $4, %[k]") \
+        __ASM_EMIT("jz          3f") \
+        FFT64_ROTATE(SEL) \
+        __ASM_EMIT("jmp         2b") \
+        /* Skip the second half of the block */ \
+        __ASM_EMIT("3:") \
+        __ASM_EMIT("add         %[nb], %[a_re]") \
+        __ASM_EMIT("add         %[nb], %[a_im]") \
+        __ASM_EMIT("cmp         %[a_end], %[a_re]") \
+        __ASM_EMIT("jb          1b")
+
+    /*
+     * Butterflies of one stage in mixed precision, 4 butterflies per iteration,
+     * the twiddle factors are converted to float before the multiplication
+     */
+    #define FFT64_BUTTERFLY_MP(op1, op2, SEL) \
+        __ASM_EMIT("1:") \
+        __ASM_EMIT("vmovapd     0x00 + %[tw], %%ymm6")                      /* ymm6 = w_re */ \
+        __ASM_EMIT("vmovapd     0x20 + %[tw], %%ymm7")                      /* ymm7 = w_im */ \
+        __ASM_EMIT("mov         %[n], %[k]") \
+        __ASM_EMIT("2:") \
+        __ASM_EMIT("vcvtpd2ps   %%ymm6, %%xmm4")                            /* xmm4 = float(w_re) */ \
+        __ASM_EMIT("vcvtpd2ps   %%ymm7, %%xmm5")                            /* xmm5 = float(w_im) */ \
+        __ASM_EMIT("vmovups     (%[a_re], %[nb]), %%xmm2")                  /* xmm2 = b_re */ \
+        __ASM_EMIT("vmovups     (%[a_im], %[nb]), %%xmm3")                  /* xmm3 = b_im */ \
+        FFT64_CMUL("xmm4", "xmm5", "xmm", "ps", op1, op2, SEL) \
+        FFT64_APPLY("xmm", "ps", "0x10") \
+        __ASM_EMIT("sub         $4, %[k]") \
+        __ASM_EMIT("jz          3f") \
+        FFT64_ROTATE(SEL) \
+        __ASM_EMIT("jmp         2b") \
+        /* Skip the second half of the block */ \
+        __ASM_EMIT("3:") \
+        __ASM_EMIT("add         %[nb], %[a_re]") \
+        __ASM_EMIT("add         %[nb], %[a_im]") \
+        __ASM_EMIT("cmp         %[a_end], %[a_re]") \
+        __ASM_EMIT("jb          1b")
+
+    #define FFT64_AVX(a, b)     a
+    #define FFT64_FMA3(a, b)    b
+
+    #define FFT64_BUTTERFLY_FUNC(name, type, BODY, op1, op2, SEL) \
+        static void name(type *dst_re, type *dst_im, size_t rank) \
+        { \
+            double tw[12] __lsp_aligned32; \
+            const size_t items  = size_t(1) << rank; \
+            const type *a_end   = &dst_re[items]; \
+            \
+            for (size_t n=4; n < items; n <<= 1) \
+            { \
+                fft64_stage_twiddle(tw, n, 4); \
+                type *a_re          = dst_re; \
+                type *a_im          = dst_im; \
+                size_t nb           = n * sizeof(type); \
+                size_t k; \
+                \
+                ARCH_X86_ASM \
+                ( \
+                    BODY(op1, op2, SEL) \
+                    : [a_re] "+r" (a_re), [a_im] "+r" (a_im), \
+                      [k] "=&r" (k) \
+                    : [nb] "r" (nb), [n] X86_GREG (n), \
+                      [a_end] X86_GREG (a_end), \
+                      [tw] "o" (tw) \
+                    : "cc", "memory", \
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                      "%xmm4", "%xmm5", "%xmm6", "%xmm7" \
+                ); \
+            } \
+        }
+
+        FFT64_BUTTERFLY_FUNC(fft64_butterfly_direct, double, FFT64_BUTTERFLY_F64, "vaddpd", "vsubpd", FFT64_AVX)
+        FFT64_BUTTERFLY_FUNC(fft64_butterfly_reverse, double, FFT64_BUTTERFLY_F64, "vsubpd", "vaddpd", FFT64_AVX)
+        FFT64_BUTTERFLY_FUNC(fft64_butterfly_direct_mp, float, FFT64_BUTTERFLY_MP, "vaddps", "vsubps", FFT64_AVX)
+        FFT64_BUTTERFLY_FUNC(fft64_butterfly_reverse_mp, float, FFT64_BUTTERFLY_MP, "vsubps", "vaddps", FFT64_AVX)
+
+        FFT64_BUTTERFLY_FUNC(fft64_butterfly_direct_fma3, double, FFT64_BUTTERFLY_F64, "vfmadd231pd", "vfmsub231pd", FFT64_FMA3)
+        FFT64_BUTTERFLY_FUNC(fft64_butterfly_reverse_fma3, double, FFT64_BUTTERFLY_F64, "vfmsub231pd", "vfmadd231pd", FFT64_FMA3)
+        FFT64_BUTTERFLY_FUNC(fft64_butterfly_direct_mp_fma3, float, FFT64_BUTTERFLY_MP, "vfmadd231ps", "vfmsub231ps", FFT64_FMA3)
+        FFT64_BUTTERFLY_FUNC(fft64_butterfly_reverse_mp_fma3, float, FFT64_BUTTERFLY_MP, "vfmsub231ps", "vfmadd231ps", FFT64_FMA3)
+
+    #undef FFT64_BUTTERFLY_FUNC
+    #undef FFT64_FMA3
+    #undef FFT64_AVX
+    #undef FFT64_BUTTERFLY_MP
+    #undef FFT64_BUTTERFLY_F64
+    #undef FFT64_ROTATE
+    #undef FFT64_APPLY
+    #undef FFT64_CMUL
+
+    #define FFT64_FUNCTIONS(suffix) \
+        void direct_fft_f64 ## suffix(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank) \
+        { \
+            if (fft64_small(dst_re, dst_im, src_re, src_im, rank, 1.0)) \
+                return; \
+            \
+            fft64_scramble(dst_re, dst_im, src_re, src_im, rank); \
+            fft64_start_direct(dst_re, dst_im, rank); \
+            fft64_butterfly_direct ## suffix(dst_re, dst_im, rank); \
+        } \
+        \
+        void reverse_fft_f64 ## suffix(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank) \
+        { \
+            if (fft64_small(dst_re, dst_im, src_re, src_im, rank, 0.5)) \
+                return; \
+            \
+            fft64_scramble(dst_re, dst_im, src_re, src_im, rank); \
+            fft64_start_reverse(dst_re, dst_im, rank); \
+            fft64_butterfly_reverse ## suffix(dst_re, dst_im, rank); \
+            \
+            /* Update amplitudes */ \
+            const size_t items  = size_t(1) << rank; \
+            const double k      = 1.0 / double(items); \
+            for (size_t i=0; i<items; ++i) \
+            { \
+                dst_re[i]          *= k; \
+                dst_im[i]          *= k; \
+            } \
+        } \
+        \
+        void direct_fft_mp ## suffix(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank) \
+        { \
+            if (fft64_small_mp(dst_re, dst_im, src_re, src_im, rank, 1.0f)) \
+                return; \
+            \
+            fft64_scramble_mp(dst_re, dst_im, src_re, src_im, rank); \
+            fft64_start_direct_mp(dst_re, dst_im, rank); \
+            fft64_butterfly_direct_mp ## suffix(dst_re, dst_im, rank); \
+        } \
+        \
+        void reverse_fft_mp ## suffix(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank) \
+        { \
+            if (fft64_small_mp(dst_re, dst_im, src_re, src_im, rank, 0.5f)) \
+                return; \
+            \
+            fft64_scramble_mp(dst_re, dst_im, src_re, src_im, rank); \
+            fft64_start_reverse_mp(dst_re, dst_im, rank); \
+            fft64_butterfly_reverse_mp ## suffix(dst_re, dst_im, rank); \
+            \
+            /* Update amplitudes */ \
+            const float k       = 1.0f / float(size_t(1) << rank); \
+            dsp::mul_k2(dst_re, k, size_t(1) << rank); \
+            dsp::mul_k2(dst_im, k, size_t(1) << rank); \
+        }
+
+        FFT64_FUNCTIONS()
+        FFT64_FUNCTIONS(_fma3)
+
+    #undef FFT64_FUNCTIONS
+    } /* namespace avx */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_FFT64_H_ */
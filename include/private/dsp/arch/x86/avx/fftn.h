@@ -0,0 +1,612 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 8 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_FFTN_H_
+#define PRIVATE_DSP_ARCH_X86_AVX_FFTN_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_IMPL */
+
+namespace lsp
+{
+    namespace avx
+    {
+    #ifdef ARCH_X86_64
+        /*
+         * Stages of the Stockham transform (see generic implementation) with the stride
+         * multiple of 4 process 4 complex numbers per register with the same twiddle
+         * factor. Other stages are computed with scalar code.
+         */
+
+        // X = X * (WR + i*WI), T is the temporary register
+        #define FFTN_CMUL(X, T, WR, WI) \
+            __ASM_EMIT("vpermilps       $0xb1, %%" X ", %%" T)          /* T    = xi xr */ \
+            __ASM_EMIT("vmulps          %%" WR ", %%" X ", %%" X)       /* X    = xr*wr xi*wr */ \
+            __ASM_EMIT("vmulps          %%" WI ", %%" T ", %%" T)       /* T    = xi*wi xr*wi */ \
+            __ASM_EMIT("vaddsubps       %%" T ", %%" X ", %%" X)        /* X    = xr*wr-xi*wi xi*wr+xr*wi */
+
+        static inline void fftn_twiddle(float *w, const float *tw, size_t idx, float sg)
+        {
+            w[0]            = tw[idx*2];
+            w[1]            = tw[idx*2 + 1] * sg;
+        }
+
+        static void fftn_butterfly2(float *y, const float *x, const float *tw, size_t s, size_t m, float sg)
+        {
+            float w[2];
+            size_t off, count;
+
+            for (size_t p=0; p<m; ++p)
+            {
+                fftn_twiddle(&w[0], tw, s*p, sg);
+
+                const float *a0 = &x[2*s*p];
+                const float *a1 = &x[2*s*(p + m)];
+                float *c0       = &y[2*s*(2*p)];
+                float *c1       = &c0[2*s];
+                count           = s;
+
+                ARCH_X86_64_ASM(
+                    __ASM_EMIT("vbroadcastss    0x00(%[w]), %%ymm6")            // ymm6 = w1r
+                    __ASM_EMIT("vbroadcastss    0x04(%[w]), %%ymm7")            // ymm7 = w1i
+                    __ASM_EMIT("xor             %[off], %[off]")
+                    __ASM_EMIT("1:")
+                    __ASM_EMIT("vmovups         (%[a0], %[off]), %%ymm0")       // ymm0 = a0
+                    __ASM_EMIT("vmovups         (%[a1], %[off]), %%ymm1")       // ymm1 = a1
+                    __ASM_EMIT("vaddps          %%ymm1, %%ymm0, %%ymm2")        // ymm2 = a0 + a1
+                    __ASM_EMIT("vsubps          %%ymm1, %%ymm0, %%ymm0")        // ymm0 = a0 - a1
+                    FFTN_CMUL("ymm0", "ymm1", "ymm6", "ymm7")
+                    __ASM_EMIT("vmovups         %%ymm2, (%[c0], %[off])")
+                    __ASM_EMIT("vmovups         %%ymm0, (%[c1], %[off])")
+                    __ASM_EMIT("add             $0x20, %[off]")
+                    __ASM_EMIT("sub             $4, %[count]")
+                    __ASM_EMIT("jnz             1b")
+                    : [off] "=&r" (off), [count] "+r" (count)
+                    : [a0] "r" (a0), [a1] "r" (a1),
+                      [c0] "r" (c0), [c1] "r" (c1),
+                      [w] "r" (w)
+                    : "cc", "memory",
+                      "%xmm0", "%xmm1", "%xmm2",
+                      "%xmm6", "%xmm7"
+                );
+            }
+        }
+
+        static void fftn_butterfly3(float *y, const float *x, const float *tw, size_t s, size_t m, float sg)
+        {
+            float w[6];
+            size_t off, count;
+            const float ks  = sg * 0.866025403784438647f;       // sin(2*pi/3)
+            w[4]            = 0.5f;
+            w[5]            = ks;
+
+            for (size_t p=0; p<m; ++p)
+            {
+                fftn_twiddle(&w[0], tw, s*p, sg);
+                fftn_twiddle(&w[2], tw, s*p*2, sg);
+
+                const float *a0 = &x[2*s*p];
+                const float *a1 = &x[2*s*(p + m)];
+                const float *a2 = &x[2*s*(p + 2*m)];
+                float *c0       = &y[2*s*(3*p)];
+                float *c1       = &c0[2*s];
+                float *c2       = &c1[2*s];
+                count           = s;
+
+                ARCH_X86_64_ASM(
+                    __ASM_EMIT("vbroadcastss    0x00(%[w]), %%ymm8")            // ymm8 = w1r
+                    __ASM_EMIT("vbroadcastss    0x04(%[w]), %%ymm9")            // ymm9 = w1i
+                    __ASM_EMIT("vbroadcastss    0x08(%[w]), %%ymm10")           // ymm10= w2r
+                    __ASM_EMIT("vbroadcastss    0x0c(%[w]), %%ymm11")           // ymm11= w2i
+                    __ASM_EMIT("vbroadcastss    0x10(%[w]), %%ymm12")           // ymm12= 0.5
+                    __ASM_EMIT("vbroadcastss    0x14(%[w]), %%ymm13")           // ymm13= ks
+                    __ASM_EMIT("vxorps          %%ymm14, %%ymm14, %%ymm14")     // ymm14= 0
+                    __ASM_EMIT("vsubps          %%ymm13, %%ymm14, %%ymm14")     // ymm14= -ks
+                    __ASM_EMIT("vunpcklps       %%ymm14, %%ymm13, %%ymm13")     // ymm13= ks -ks ks -ks ...
+                    __ASM_EMIT("xor             %[off], %[off]")
+                    __ASM_EMIT("1:")
+                    __ASM_EMIT("vmovups         (%[a0], %[off]), %%ymm0")       // ymm0 = a0
+                    __ASM_EMIT("vmovups         (%[a1], %[off]), %%ymm1")       // ymm1 = a1
+                    __ASM_EMIT("vmovups         (%[a2], %[off]), %%ymm2")       // ymm2 = a2
+                    __ASM_EMIT("vaddps          %%ymm2, %%ymm1, %%ymm3")        // ymm3 = t = a1 + a2
+                    __ASM_EMIT("vsubps          %%ymm2, %%ymm1, %%ymm1")        // ymm1 = a1 - a2
+                    __ASM_EMIT("vmulps          %%ymm12, %%ymm3, %%ymm4")       // ymm4 = t/2
+                    __ASM_EMIT("vpermilps       $0xb1, %%ymm1, %%ymm1")         // ymm1 = swap(a1 - a2)
+                    __ASM_EMIT("vaddps          %%ymm3, %%ymm0, %%ymm2")        // ymm2 = c0 = a0 + t
+                    __ASM_EMIT("vsubps          %%ymm4, %%ymm0, %%ymm0")        // ymm0 = u = a0 - t/2
+                    __ASM_EMIT("vmulps          %%ymm13, %%ymm1, %%ymm1")       // ymm1 = v = vi -vr
+                    __ASM_EMIT("vaddps          %%ymm1, %%ymm0, %%ymm3")        // ymm3 = u - i*v
+                    __ASM_EMIT("vsubps          %%ymm1, %%ymm0, %%ymm0")        // ymm0 = u + i*v
+                    FFTN_CMUL("ymm3", "ymm4", "ymm8", "ymm9")
+                    FFTN_CMUL("ymm0", "ymm5", "ymm10", "ymm11")
+                    __ASM_EMIT("vmovups         %%ymm2, (%[c0], %[off])")
+                    __ASM_EMIT("vmovups         %%ymm3, (%[c1], %[off])")
+                    __ASM_EMIT("vmovups         %%ymm0, (%[c2], %[off])")
+                    __ASM_EMIT("add             $0x20, %[off]")
+                    __ASM_EMIT("sub             $4, %[count]")
+                    __ASM_EMIT("jnz             1b")
+                    : [off] "=&r" (off), [count] "+r" (count)
+                    : [a0] "r" (a0), [a1] "r" (a1), [a2] "r" (a2),
+                      [c0] "r" (c0), [c1] "r" (c1), [c2] "r" (c2),
+                      [w] "r" (w)
+                    : "cc", "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                      "%xmm4", "%xmm5",
+                      "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+                      "%xmm12", "%xmm13", "%xmm14"
+                );
+            }
+        }
+
+        static void fftn_butterfly4(float *y, const float *x, const float *tw, size_t s, size_t m, float sg)
+        {
+            float w[8];
+            size_t off, count;
+            w[6]            = sg;
+
+            for (size_t p=0; p<m; ++p)
+            {
+                fftn_twiddle(&w[0], tw, s*p, sg);
+                fftn_twiddle(&w[2], tw, s*p*2, sg);
+                fftn_twiddle(&w[4], tw, s*p*3, sg);
+
+                const float *a0 = &x[2*s*p];
+                const float *a1 = &x[2*s*(p + m)];
+                const float *a2 = &x[2*s*(p + 2*m)];
+                const float *a3 = &x[2*s*(p + 3*m)];
+                float *c0       = &y[2*s*(4*p)];
+                float *c1       = &c0[2*s];
+                float *c2       = &c1[2*s];
+                float *c3       = &c2[2*s];
+                count           = s;
+
+                ARCH_X86_64_ASM(
+                    __ASM_EMIT("vbroadcastss    0x00(%[w]), %%ymm8")            // ymm8 = w1r
+                    __ASM_EMIT("vbroadcastss    0x04(%[w]), %%ymm9")            // ymm9 = w1i
+                    __ASM_EMIT("vbroadcastss    0x08(%[w]), %%ymm10")           // ymm10= w2r
+                    __ASM_EMIT("vbroadcastss    0x0c(%[w]), %%ymm11")           // ymm11= w2i
+                    __ASM_EMIT("vbroadcastss    0x10(%[w]), %%ymm12")           // ymm12= w3r
+                    __ASM_EMIT("vbroadcastss    0x14(%[w]), %%ymm13")           // ymm13= w3i
+                    __ASM_EMIT("vbroadcastss    0x18(%[w]), %%ymm14")           // ymm14= sg
+                    __ASM_EMIT("vxorps          %%ymm15, %%ymm15, %%ymm15")     // ymm15= 0
+                    __ASM_EMIT("vsubps          %%ymm14, %%ymm15, %%ymm15")     // ymm15= -sg
+                    __ASM_EMIT("vunpcklps       %%ymm15, %%ymm14, %%ymm14")     // ymm14= sg -sg sg -sg ...
+                    __ASM_EMIT("xor             %[off], %[off]")
+                    __ASM_EMIT("1:")
+                    __ASM_EMIT("vmovups         (%[a0], %[off]), %%ymm0")       // ymm0 = a0
+                    __ASM_EMIT("vmovups         (%[a1], %[off]), %%ymm1")       // ymm1 = a1
+                    __ASM_EMIT("vmovups         (%[a2], %[off]), %%ymm2")       // ymm2 = a2
+                    __ASM_EMIT("vmovups         (%[a3], %[off]), %%ymm3")       // ymm3 = a3
+                    __ASM_EMIT("vaddps          %%ymm2, %%ymm0, %%ymm4")        // ymm4 = s0 = a0 + a2
+                    __ASM_EMIT("vsubps          %%ymm2, %%ymm0, %%ymm0")        // ymm0 = d0 = a0 - a2
+                    __ASM_EMIT("vaddps          %%ymm3, %%ymm1, %%ymm5")        // ymm5 = s1 = a1 + a3
+                    __ASM_EMIT("vsubps          %%ymm3, %%ymm1, %%ymm1")        // ymm1 = a1 - a3
+                    __ASM_EMIT("vpermilps       $0xb1, %%ymm1, %%ymm1")         // ymm1 = swap(a1 - a3)
+                    __ASM_EMIT("vaddps          %%ymm5, %%ymm4, %%ymm2")        // ymm2 = c0 = s0 + s1
+                    __ASM_EMIT("vsubps          %%ymm5, %%ymm4, %%ymm4")        // ymm4 = s0 - s1
+                    __ASM_EMIT("vmulps          %%ymm14, %%ymm1, %%ymm1")       // ymm1 = d1 = d1i -d1r
+                    __ASM_EMIT("vaddps          %%ymm1, %%ymm0, %%ymm3")        // ymm3 = d0 - i*d1
+                    __ASM_EMIT("vsubps          %%ymm1, %%ymm0, %%ymm0")        // ymm0 = d0 + i*d1
+                    FFTN_CMUL("ymm3", "ymm5", "ymm8", "ymm9")
+                    FFTN_CMUL("ymm4", "ymm6", "ymm10", "ymm11")
+                    FFTN_CMUL("ymm0", "ymm7", "ymm12", "ymm13")
+                    __ASM_EMIT("vmovups         %%ymm2, (%[c0], %[off])")
+                    __ASM_EMIT("vmovups         %%ymm3, (%[c1], %[off])")
+                    __ASM_EMIT("vmovups         %%ymm4, (%[c2], %[off])")
+                    __ASM_EMIT("vmovups         %%ymm0, (%[c3], %[off])")
+                    __ASM_EMIT("add             $0x20, %[off]")
+                    __ASM_EMIT("sub             $4, %[count]")
+                    __ASM_EMIT("jnz             1b")
+                    : [off] "=&r" (off), [count] "+r" (count)
+                    : [a0] "r" (a0), [a1] "r" (a1), [a2] "r" (a2), [a3] "r" (a3),
+                      [c0] "r" (c0), [c1] "r" (c1), [c2] "r" (c2), [c3] "r" (c3),
+                      [w] "r" (w)
+                    : "cc", "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                      "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+                      "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+                      "%xmm12", "%xmm13", "%xmm14", "%xmm15"
+                );
+            }
+        }
+
+        static void fftn_butterfly5(float *y, const float *x, const float *tw, size_t s, size_t m, float sg)
+        {
+            float w[12];
+            size_t off, count;
+            w[8]            = 0.309016994374947424f;            // cos(2*pi/5)
+            w[9]            = -0.809016994374947424f;           // cos(4*pi/5)
+            w[10]           = sg * 0.951056516295153572f;       // sin(2*pi/5)
+            w[11]           = sg * 0.587785252292473129f;       // sin(4*pi/5)
+
+            for (size_t p=0; p<m; ++p)
+            {
+                fftn_twiddle(&w[0], tw, s*p, sg);
+                fftn_twiddle(&w[2], tw, s*p*2, sg);
+                fftn_twiddle(&w[4], tw, s*p*3, sg);
+                fftn_twiddle(&w[6], tw, s*p*4, sg);
+
+                const float *a0 = &x[2*s*p];
+                const float *a1 = &x[2*s*(p + m)];
+                const float *a2 = &x[2*s*(p + 2*m)];
+                const float *a3 = &x[2*s*(p + 3*m)];
+                const float *a4 = &x[2*s*(p + 4*m)];
+                float *c0       = &y[2*s*(5*p)];
+                float *c1       = &c0[2*s];
+                float *c2       = &c1[2*s];
+                float *c3       = &c2[2*s];
+                float *c4       = &c3[2*s];
+                count           = s;
+
+                ARCH_X86_64_ASM(
+                    __ASM_EMIT("vbroadcastss    0x20(%[w]), %%ymm12")           // ymm12= c1
+                    __ASM_EMIT("vbroadcastss    0x24(%[w]), %%ymm13")           // ymm13= c2
+                    __ASM_EMIT("vbroadcastss    0x28(%[w]), %%ymm14")           // ymm14= s1
+                    __ASM_EMIT("vbroadcastss    0x2c(%[w]), %%ymm15")           // ymm15= s2
+                    __ASM_EMIT("vxorps          %%ymm8, %%ymm8, %%ymm8")        // ymm8 = 0
+                    __ASM_EMIT("vsubps          %%ymm14, %%ymm8, %%ymm9")       // ymm9 = -s1
+                    __ASM_EMIT("vsubps          %%ymm15, %%ymm8, %%ymm10")      // ymm10= -s2
+                    __ASM_EMIT("vunpcklps       %%ymm9, %%ymm14, %%ymm14")      // ymm14= s1 -s1 s1 -s1 ...
+                    __ASM_EMIT("vunpcklps       %%ymm10, %%ymm15, %%ymm15")     // ymm15= s2 -s2 s2 -s2 ...
+                    __ASM_EMIT("xor             %[off], %[off]")
+                    __ASM_EMIT("1:")
+                    __ASM_EMIT("vmovups         (%[a1], %[off]), %%ymm1")       // ymm1 = a1
+                    __ASM_EMIT("vmovups         (%[a4], %[off]), %%ymm4")       // ymm4 = a4
+                    __ASM_EMIT("vmovups         (%[a2], %[off]), %%ymm2")       // ymm2 = a2
+                    __ASM_EMIT("vmovups         (%[a3], %[off]), %%ymm3")       // ymm3 = a3
+                    __ASM_EMIT("vmovups         (%[a0], %[off]), %%ymm0")       // ymm0 = a0
+                    __ASM_EMIT("vaddps          %%ymm4, %%ymm1, %%ymm5")        // ymm5 = s1 = a1 + a4
+                    __ASM_EMIT("vsubps          %%ymm4, %%ymm1, %%ymm1")        // ymm1 = d1 = a1 - a4
+                    __ASM_EMIT("vaddps          %%ymm3, %%ymm2, %%ymm6")        // ymm6 = s2 = a2 + a3
+                    __ASM_EMIT("vsubps          %%ymm3, %%ymm2, %%ymm2")        // ymm2 = d2 = a2 - a3
+                    __ASM_EMIT("vpermilps       $0xb1, %%ymm1, %%ymm1")         // ymm1 = swap(d1)
+                    __ASM_EMIT("vpermilps       $0xb1, %%ymm2, %%ymm2")         // ymm2 = swap(d2)
+                    __ASM_EMIT("vaddps          %%ymm6, %%ymm5, %%ymm7")        // ymm7 = s1 + s2
+                    __ASM_EMIT("vmulps          %%ymm12, %%ymm5, %%ymm3")       // ymm3 = c1*s1
+                    __ASM_EMIT("vmulps          %%ymm13, %%ymm6, %%ymm4")       // ymm4 = c2*s2
+                    __ASM_EMIT("vaddps          %%ymm0, %%ymm7, %%ymm7")        // ymm7 = c0 = a0 + s1 + s2
+                    __ASM_EMIT("vmulps          %%ymm13, %%ymm5, %%ymm5")       // ymm5 = c2*s1
+                    __ASM_EMIT("vmulps          %%ymm12, %%ymm6, %%ymm6")       // ymm6 = c1*s2
+                    __ASM_EMIT("vmovups         %%ymm7, (%[c0], %[off])")
+                    __ASM_EMIT("vaddps          %%ymm0, %%ymm3, %%ymm3")        // ymm3 = a0 + c1*s1
+                    __ASM_EMIT("vaddps          %%ymm0, %%ymm5, %%ymm5")        // ymm5 = a0 + c2*s1
+                    __ASM_EMIT("vaddps          %%ymm4, %%ymm3, %%ymm3")        // ymm3 = u1 = a0 + c1*s1 + c2*s2
+                    __ASM_EMIT("vaddps          %%ymm6, %%ymm5, %%ymm5")        // ymm5 = u2 = a0 + c2*s1 + c1*s2
+                    __ASM_EMIT("vmulps          %%ymm14, %%ymm1, %%ymm0")       // ymm0 = s1*d1
+                    __ASM_EMIT("vmulps          %%ymm15, %%ymm2, %%ymm4")       // ymm4 = s2*d2
+                    __ASM_EMIT("vmulps          %%ymm15, %%ymm1, %%ymm1")       // ymm1 = s2*d1
+                    __ASM_EMIT("vmulps          %%ymm14, %%ymm2, %%ymm2")       // ymm2 = s1*d2
+                    __ASM_EMIT("vaddps          %%ymm4, %%ymm0, %%ymm0")        // ymm0 = v1 = s1*d1 + s2*d2
+                    __ASM_EMIT("vsubps          %%ymm2, %%ymm1, %%ymm1")        // ymm1 = v2 = s2*d1 - s1*d2
+                    __ASM_EMIT("vaddps          %%ymm0, %%ymm3, %%ymm2")        // ymm2 = u1 - i*v1
+                    __ASM_EMIT("vsubps          %%ymm0, %%ymm3, %%ymm3")        // ymm3 = u1 + i*v1
+                    __ASM_EMIT("vaddps          %%ymm1, %%ymm5, %%ymm0")        // ymm0 = u2 - i*v2
+                    __ASM_EMIT("vsubps          %%ymm1, %%ymm5, %%ymm5")        // ymm5 = u2 + i*v2
+                    __ASM_EMIT("vbroadcastss    0x00(%[w]), %%ymm8")            // ymm8 = w1r
+                    __ASM_EMIT("vbroadcastss    0x04(%[w]), %%ymm9")            // ymm9 = w1i
+                    __ASM_EMIT("vbroadcastss    0x08(%[w]), %%ymm10")           // ymm10= w2r
+                    __ASM_EMIT("vbroadcastss    0x0c(%[w]), %%ymm11")           // ymm11= w2i
+                    FFTN_CMUL("ymm2", "ymm6", "ymm8", "ymm9")
+                    FFTN_CMUL("ymm0", "ymm7", "ymm10", "ymm11")
+                    __ASM_EMIT("vbroadcastss    0x10(%[w]), %%ymm8")            // ymm8 = w3r
+                    __ASM_EMIT("vbroadcastss    0x14(%[w]), %%ymm9")            // ymm9 = w3i
+                    __ASM_EMIT("vbroadcastss    0x18(%[w]), %%ymm10")           // ymm10= w4r
+                    __ASM_EMIT("vbroadcastss    0x1c(%[w]), %%ymm11")           // ymm11= w4i
+                    FFTN_CMUL("ymm5", "ymm6", "ymm8", "ymm9")
+                    FFTN_CMUL("ymm3", "ymm7", "ymm10", "ymm11")
+                    __ASM_EMIT("vmovups         %%ymm2, (%[c1], %[off])")
+                    __ASM_EMIT("vmovups         %%ymm0, (%[c2], %[off])")
+                    __ASM_EMIT("vmovups         %%ymm5, (%[c3], %[off])")
+                    __ASM_EMIT("vmovups         %%ymm3, (%[c4], %[off])")
+                    __ASM_EMIT("add             $0x20, %[off]")
+                    __ASM_EMIT("sub             $4, %[count]")
+                    __ASM_EMIT("jnz             1b")
+                    : [off] "=&r" (off), [count] "+r" (count)
+                    : [a0] "r" (a0), [a1] "r" (a1), [a2] "r" (a2), [a3] "r" (a3), [a4] "r" (a4),
+                      [c0] "r" (c0), [c1] "r" (c1), [c2] "r" (c2), [c3] "r" (c3), [c4] "r" (c4),
+                      [w] "r" (w)
+                    : "cc", "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                      "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+                      "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+                      "%xmm12", "%xmm13", "%xmm14", "%xmm15"
+                );
+            }
+        }
+
+        #undef FFTN_CMUL
+
+        /*
+         * Scalar butterfly of any radix for positions p0..m-1, computes the DFT of size r directly:
+         *   c[j] = w^(s*p*j) * sum { a[k] * w^(N*j*k/r) }
+         */
+        static void fftn_butterfly_scalar(float *y, const float *x, const float *tw, size_t n, size_t r, size_t s, size_t m, size_t p0, float sg)
+        {
+            float kr[7*7*2];
+            for (size_t j=0; j<r; ++j)
+                for (size_t k=0; k<r; ++k)
+                {
+                    const float *w  = &tw[2*(n/r)*((j*k) % r)];
+                    kr[(j*r + k)*2]     = w[0];
+                    kr[(j*r + k)*2 + 1] = w[1] * sg;
+                }
+
+            for (size_t p=p0; p<m; ++p)
+            {
+                for (size_t q=0; q<s*2; q += 2)
+                {
+                    for (size_t j=0; j<r; ++j)
+                    {
+                        float re        = 0.0f;
+                        float im        = 0.0f;
+                        for (size_t k=0; k<r; ++k)
+                        {
+                            const float *a  = &x[2*s*(p + k*m) + q];
+                            const float *w  = &kr[(j*r + k)*2];
+                            re             += a[0]*w[0] - a[1]*w[1];
+                            im             += a[0]*w[1] + a[1]*w[0];
+                        }
+
+                        const float *w  = &tw[2*s*p*j];
+                        float wi        = w[1] * sg;
+                        float *c        = &y[2*s*(r*p + j) + q];
+                        c[0]            = re*w[0] - im*wi;
+                        c[1]            = re*wi + im*w[0];
+                    }
+                }
+            }
+        }
+
+        /*
+         * The first radix-4 stage with the stride 1 is vectorized over the position p,
+         * the twiddle factors w^(2p) and w^(3p) are computed from w^p, the result is
+         * transposed to store 4 outputs of each position sequentially
+         */
+        static void fftn_butterfly4_first(float *y, const float *x, const float *tw, size_t n, size_t m, float sg)
+        {
+            float k[2];
+            size_t blocks   = m >> 2;
+            k[0]            = sg;
+            k[1]            = 1.0f;
+
+            if (blocks > 0)
+            {
+                const float *a0 = x;
+                const float *a1 = &x[2*m];
+                const float *a2 = &x[4*m];
+                const float *a3 = &x[6*m];
+                float *c        = y;
+                size_t off;
+
+                ARCH_X86_64_ASM(
+                    __ASM_EMIT("vbroadcastss    0x00(%[k]), %%ymm14")           // ymm14= sg
+                    __ASM_EMIT("vbroadcastss    0x04(%[k]), %%ymm12")           // ymm12= 1
+                    __ASM_EMIT("vxorps          %%ymm15, %%ymm15, %%ymm15")     // ymm15= 0
+                    __ASM_EMIT("vsubps          %%ymm14, %%ymm15, %%ymm13")     // ymm13= -sg
+                    __ASM_EMIT("vunpcklps       %%ymm14, %%ymm12, %%ymm15")     // ymm15= 1 sg 1 sg ...
+                    __ASM_EMIT("vunpcklps       %%ymm13, %%ymm14, %%ymm14")     // ymm14= sg -sg sg -sg ...
+                    __ASM_EMIT("xor             %[off], %[off]")
+                    __ASM_EMIT("1:")
+                    // Butterfly
+                    __ASM_EMIT("vmovups         (%[a0], %[off]), %%ymm0")       // ymm0 = a0
+                    __ASM_EMIT("vmovups         (%[a1], %[off]), %%ymm1")       // ymm1 = a1
+                    __ASM_EMIT("vmovups         (%[a2], %[off]), %%ymm2")       // ymm2 = a2
+                    __ASM_EMIT("vmovups         (%[a3], %[off]), %%ymm3")       // ymm3 = a3
+                    __ASM_EMIT("vaddps          %%ymm2, %%ymm0, %%ymm4")        // ymm4 = s0 = a0 + a2
+                    __ASM_EMIT("vsubps          %%ymm2, %%ymm0, %%ymm0")        // ymm0 = d0 = a0 - a2
+                    __ASM_EMIT("vaddps          %%ymm3, %%ymm1, %%ymm5")        // ymm5 = s1 = a1 + a3
+                    __ASM_EMIT("vsubps          %%ymm3, %%ymm1, %%ymm1")        // ymm1 = a1 - a3
+                    __ASM_EMIT("vpermilps       $0xb1, %%ymm1, %%ymm1")         // ymm1 = swap(a1 - a3)
+                    __ASM_EMIT("vaddps          %%ymm5, %%ymm4, %%ymm6")        // ymm6 = x0 = s0 + s1
+                    __ASM_EMIT("vsubps          %%ymm5, %%ymm4, %%ymm4")        // ymm4 = x2 = s0 - s1
+                    __ASM_EMIT("vmulps          %%ymm14, %%ymm1, %%ymm1")       // ymm1 = d1 = d1i -d1r
+                    __ASM_EMIT("vaddps          %%ymm1, %%ymm0, %%ymm7")        // ymm7 = x1 = d0 - i*d1
+                    __ASM_EMIT("vsubps          %%ymm1, %%ymm0, %%ymm0")        // ymm0 = x3 = d0 + i*d1
+                    // Twiddle factors
+                    __ASM_EMIT("vmulps          (%[tw], %[off]), %%ymm15, %%ymm8")  // ymm8 = w1 = w^p
+                    __ASM_EMIT("vmovsldup       %%ymm8, %%ymm10")               // ymm10= w1r w1r
+                    __ASM_EMIT("vmovshdup       %%ymm8, %%ymm11")               // ymm11= w1i w1i
+                    __ASM_EMIT("vpermilps       $0xb1, %%ymm8, %%ymm9")         // ymm9 = w1i w1r
+                    __ASM_EMIT("vmulps          %%ymm10, %%ymm8, %%ymm12")      // ymm12= w1r*w1r w1i*w1r
+                    __ASM_EMIT("vmulps          %%ymm11, %%ymm9, %%ymm9")       // ymm9 = w1i*w1i w1r*w1i
+                    __ASM_EMIT("vaddsubps       %%ymm9, %%ymm12, %%ymm9")       // ymm9 = w2 = w1 * w1
+                    __ASM_EMIT("vpermilps       $0xb1, %%ymm9, %%ymm13")        // ymm13= w2i w2r
+                    __ASM_EMIT("vmulps          %%ymm10, %%ymm9, %%ymm12")      // ymm12= w2r*w1r w2i*w1r
+                    __ASM_EMIT("vmulps          %%ymm11, %%ymm13, %%ymm13")     // ymm13= w2i*w1i w2r*w1i
+                    __ASM_EMIT("vaddsubps       %%ymm13, %%ymm12, %%ymm10")     // ymm10= w3 = w2 * w1
+                    // Apply twiddle factors
+                    __ASM_EMIT("vmovsldup       %%ymm8, %%ymm12")
+                    __ASM_EMIT("vmovshdup       %%ymm8, %%ymm13")
+                    __ASM_EMIT("vmulps          %%ymm12, %%ymm7, %%ymm12")
+                    __ASM_EMIT("vpermilps       $0xb1, %%ymm7, %%ymm7")
+                    __ASM_EMIT("vmulps          %%ymm13, %%ymm7, %%ymm7")
+                    __ASM_EMIT("vaddsubps       %%ymm7, %%ymm12, %%ymm7")       // ymm7 = x1 * w1
+                    __ASM_EMIT("vmovsldup       %%ymm9, %%ymm12")
+                    __ASM_EMIT("vmovshdup       %%ymm9, %%ymm13")
+                    __ASM_EMIT("vmulps          %%ymm12, %%ymm4, %%ymm12")
+                    __ASM_EMIT("vpermilps       $0xb1, %%ymm4, %%ymm4")
+                    __ASM_EMIT("vmulps          %%ymm13, %%ymm4, %%ymm4")
+                    __ASM_EMIT("vaddsubps       %%ymm4, %%ymm12, %%ymm4")       // ymm4 = x2 * w2
+                    __ASM_EMIT("vmovsldup       %%ymm10, %%ymm12")
+                    __ASM_EMIT("vmovshdup       %%ymm10, %%ymm13")
+                    __ASM_EMIT("vmulps          %%ymm12, %%ymm0, %%ymm12")
+                    __ASM_EMIT("vpermilps       $0xb1, %%ymm0, %%ymm0")
+                    __ASM_EMIT("vmulps          %%ymm13, %%ymm0, %%ymm0")
+                    __ASM_EMIT("vaddsubps       %%ymm0, %%ymm12, %%ymm0")       // ymm0 = x3 * w3
+                    // Transpose and store
+                    __ASM_EMIT("vunpcklpd       %%ymm7, %%ymm6, %%ymm1")        // ymm1 = x0[0] x1[0] x0[2] x1[2]
+                    __ASM_EMIT("vunpckhpd       %%ymm7, %%ymm6, %%ymm2")        // ymm2 = x0[1] x1[1] x0[3] x1[3]
+                    __ASM_EMIT("vunpcklpd       %%ymm0, %%ymm4, %%ymm3")        // ymm3 = x2[0] x3[0] x2[2] x3[2]
+                    __ASM_EMIT("vunpckhpd       %%ymm0, %%ymm4, %%ymm5")        // ymm5 = x2[1] x3[1] x2[3] x3[3]
+                    __ASM_EMIT("vperm2f128      $0x20, %%ymm3, %%ymm1, %%ymm0") // ymm0 = x0[0] x1[0] x2[0] x3[0]
+                    __ASM_EMIT("vperm2f128      $0x20, %%ymm5, %%ymm2, %%ymm4") // ymm4 = x0[1] x1[1] x2[1] x3[1]
+                    __ASM_EMIT("vperm2f128      $0x31, %%ymm3, %%ymm1, %%ymm6") // ymm6 = x0[2] x1[2] x2[2] x3[2]
+                    __ASM_EMIT("vperm2f128      $0x31, %%ymm5, %%ymm2, %%ymm7") // ymm7 = x0[3] x1[3] x2[3] x3[3]
+                    __ASM_EMIT("vmovups         %%ymm0, 0x00(%[c])")
+                    __ASM_EMIT("vmovups         %%ymm4, 0x20(%[c])")
+                    __ASM_EMIT("vmovups         %%ymm6, 0x40(%[c])")
+                    __ASM_EMIT("vmovups         %%ymm7, 0x60(%[c])")
+                    __ASM_EMIT("add             $0x20, %[off]")
+                    __ASM_EMIT("add             $0x80, %[c]")
+                    __ASM_EMIT("dec             %[blocks]")
+                    __ASM_EMIT("jnz             1b")
+                    : [off] "=&r" (off), [c] "+r" (c), [blocks] "+r" (blocks)
+                    : [a0] "r" (a0), [a1] "r" (a1), [a2] "r" (a2), [a3] "r" (a3),
+                      [tw] "r" (tw), [k] "r" (k)
+                    : "cc", "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                      "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+                      "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+                      "%xmm12", "%xmm13", "%xmm14", "%xmm15"
+                );
+            }
+
+            fftn_butterfly_scalar(y, x, tw, n, 4, 1, m, m & ~size_t(3), sg);
+        }
+
+        static inline size_t fftn_radix(size_t k)
+        {
+            if (!(k & 3))
+                return 4;
+            if (!(k & 1))
+                return 2;
+            if (!(k % 3))
+                return 3;
+            if (!(k % 5))
+                return 5;
+            if (!(k % 7))
+                return 7;
+            return 0;
+        }
+
+        static void fftn_mixed_radix(const dsp::fftn_t *plan, float *dst, const float *src, float sg)
+        {
+            const size_t n  = plan->count;
+            float *tmp      = plan->tmp;
+
+            // Compute the number of stages to make the last one write to the destination
+            size_t stages   = 0;
+            for (size_t k=n; k > 1; k /= fftn_radix(k))
+                ++stages;
+
+            if (stages == 0)
+            {
+                dst[0]          = src[0];
+                dst[1]          = src[1];
+                return;
+            }
+
+            float *y        = (stages & 1) ? dst : tmp;
+            const float *x  = src;
+            if (x == y)
+            {
+                dsp::copy(tmp, src, n*2);
+                x               = tmp;
+            }
+
+            for (size_t k=n, s=1; k > 1; )
+            {
+                size_t r        = fftn_radix(k);
+                size_t m        = k / r;
+
+                if ((s == 1) && (r == 4))
+                    fftn_butterfly4_first(y, x, plan->tw, n, m, sg);
+                else if (s & 3)
+                    fftn_butterfly_scalar(y, x, plan->tw, n, r, s, m, 0, sg);
+                else
+                {
+                    switch (r)
+                    {
+                        case 4: fftn_butterfly4(y, x, plan->tw, s, m, sg); break;
+                        case 2: fftn_butterfly2(y, x, plan->tw, s, m, sg); break;
+                        case 3: fftn_butterfly3(y, x, plan->tw, s, m, sg); break;
+                        case 5: fftn_butterfly5(y, x, plan->tw, s, m, sg); break;
+                        default: fftn_butterfly_scalar(y, x, plan->tw, n, r, s, m, 0, sg); break;
+                    }
+                }
+
+                s              *= r;
+                k               = m;
+                x               = y;
+                y               = (y == dst) ? tmp : dst;
+            }
+        }
+
+        void x64_fftn_direct(const dsp::fftn_t *plan, float *dst, const float *src)
+        {
+            if (plan->rank == 0)
+            {
+                fftn_mixed_radix(plan, dst, src, 1.0f);
+                return;
+            }
+
+            // Bluestein algorithm relies on the power-of-two FFT
+            const size_t n  = plan->count;
+            float *tmp      = plan->tmp;
+
+            dsp::pcomplex_mul3(tmp, src, plan->tw, n);
+            dsp::fill_zero(&tmp[n*2], ((1 << plan->rank) - n) * 2);
+            dsp::packed_direct_fft(tmp, tmp, plan->rank);
+            dsp::pcomplex_mul2(tmp, plan->chirp, 1 << plan->rank);
+            dsp::packed_reverse_fft(tmp, tmp, plan->rank);
+            dsp::pcomplex_mul3(dst, tmp, plan->tw, n);
+        }
+
+        void x64_fftn_reverse(const dsp::fftn_t *plan, float *dst, const float *src)
+        {
+            const size_t n  = plan->count;
+            const float k   = 1.0f / n;
+
+            if (plan->rank == 0)
+            {
+                fftn_mixed_radix(plan, dst, src, -1.0f);
+                dsp::mul_k2(dst, k, n*2);
+                return;
+            }
+
+            // The reverse transform is computed as conj(fft(conj(x))) / N
+            float *tmp      = plan->tmp;
+            const float *tw = plan->tw;
+
+            for (size_t i=0; i<n*2; i += 2)
+            {
+                tmp[i]          = src[i]*tw[i] + src[i+1]*tw[i+1];
+                tmp[i+1]        = src[i]*tw[i+1] - src[i+1]*tw[i];
+            }
+            dsp::fill_zero(&tmp[n*2], ((1 << plan->rank) - n) * 2);
+            dsp::packed_direct_fft(tmp, tmp, plan->rank);
+            dsp::pcomplex_mul2(tmp, plan->chirp, 1 << plan->rank);
+            dsp::packed_reverse_fft(tmp, tmp, plan->rank);
+
+            for (size_t i=0; i<n*2; i += 2)
+            {
+                float re        = tmp[i]*tw[i] - tmp[i+1]*tw[i+1];
+                float im        = tmp[i]*tw[i+1] + tmp[i+1]*tw[i];
+                dst[i]          = re * k;
+                dst[i+1]        = -im * k;
+            }
+        }
+    #endif /* ARCH_X86_64 */
+    } /* namespace avx */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_FFTN_H_ */
@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_FFTPLAN_H_
+#define PRIVATE_DSP_ARCH_X86_AVX_FFTPLAN_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_IMPL */
+
+namespace lsp
+{
+    namespace avx
+    {
+        /*
+         * The plan replaces the bit-reversal part of the in-place scramble with the
+         * precomputed list of swapped pairs, the rest of the transform is performed
+         * by the same kernels as the in-place direct_fft() and reverse_fft(), including
+         * the cache-oblivious order of butterfly stages. These kernels use their own
+         * twiddle factor tables, so the twiddle factors stored in the plan are not used.
+         * Transforms of rank below 3 are computed by the scalar code on the scrambled data.
+         */
+        static inline void fft_plan_swap(const dsp::fft_plan_t *plan, float *re, float *im)
+        {
+            const uint32_t *sw  = plan->swap;
+            for (size_t i=0; i<plan->nswap; ++i, sw += 2)
+            {
+                const size_t a  = sw[0];
+                const size_t b  = sw[1];
+                float t         = re[a];
+                re[a]           = re[b];
+                re[b]           = t;
+                t               = im[a];
+                im[a]           = im[b];
+                im[b]           = t;
+            }
+        }
+
+        static inline void fft_plan_packed_swap(const dsp::fft_plan_t *plan, float *data)
+        {
+            const uint32_t *sw  = plan->swap;
+            for (size_t i=0; i<plan->nswap; ++i, sw += 2)
+            {
+                float *a        = &data[sw[0] * 2];
+                float *b        = &data[sw[1] * 2];
+                float t_re      = a[0];
+                float t_im      = a[1];
+                a[0]            = b[0];
+                a[1]            = b[1];
+                b[0]            = t_re;
+                b[1]            = t_im;
+            }
+        }
+
+        static inline void fft_plan_packed_conj(float *data, size_t count, float k)
+        {
+            for (size_t i=0; i<count*2; i += 2)
+            {
+                data[i]        *= k;
+                data[i+1]      *= -k;
+            }
+        }
+
+        void fft_plan_direct(const dsp::fft_plan_t *plan, float *re, float *im)
+        {
+            const size_t rank   = plan->rank;
+            fft_plan_swap(plan, re, im);
+
+            if (rank < 3)
+            {
+                small_direct_fft(re, im, re, im, rank);
+                return;
+            }
+
+            fft_start_direct(re, im, rank);
+            fft_butterfly_blocked(re, im, 3, rank, butterfly_direct8p, butterfly_direct8p_x2);
+        }
+
+        void fft_plan_reverse(const dsp::fft_plan_t *plan, float *re, float *im)
+        {
+            const size_t rank   = plan->rank;
+            fft_plan_swap(plan, re, im);
+
+            if (rank < 3)
+            {
+                const float k   = 1.0f / (1 << rank);
+                small_direct_fft(im, re, im, re, rank);
+                dsp::mul_k2(re, k, 1 << rank);
+                dsp::mul_k2(im, k, 1 << rank);
+                return;
+            }
+
+            fft_start_reverse(re, im, rank);
+            fft_butterfly_blocked(re, im, 3, rank, butterfly_reverse8p, butterfly_reverse8p_x2);
+            dsp::normalize_fft2(re, im, rank);
+        }
+
+        void fft_plan_packed_direct(const dsp::fft_plan_t *plan, float *data)
+        {
+            const size_t rank   = plan->rank;
+            fft_plan_packed_swap(plan, data);
+
+            if (rank < 3)
+            {
+                packed_small_direct_fft(data, data, rank);
+                return;
+            }
+
+            packed_fft_start_direct(data, rank);
+            packed_fft_butterfly_blocked(data, 3, rank, packed_butterfly_direct8p, packed_butterfly_direct8p_x2);
+            packed_fft_repack(data, rank);
+        }
+
+        void fft_plan_packed_reverse(const dsp::fft_plan_t *plan, float *data)
+        {
+            const size_t rank   = plan->rank;
+            fft_plan_packed_swap(plan, data);
+
+            if (rank < 3)
+            {
+                fft_plan_packed_conj(data, 1 << rank, 1.0f);
+                packed_small_direct_fft(data, data, rank);
+                fft_plan_packed_conj(data, 1 << rank, 1.0f / (1 << rank));
+                return;
+            }
+
+            packed_fft_start_reverse(data, rank);
+            packed_fft_butterfly_blocked(data, 3, rank, packed_butterfly_reverse8p, packed_butterfly_reverse8p_x2);
+            packed_fft_repack_normalize(data, rank);
+        }
+
+        void fft_plan_direct_fma3(const dsp::fft_plan_t *plan, float *re, float *im)
+        {
+            const size_t rank   = plan->rank;
+            fft_plan_swap(plan, re, im);
+
+            if (rank < 3)
+            {
+                small_direct_fft(re, im, re, im, rank);
+                return;
+            }
+
+            fft_start_direct_fma3(re, im, rank);
+            fft_butterfly_blocked(re, im, 3, rank, butterfly_direct8p_fma3, butterfly_direct8p_x2_fma3);
+        }
+
+        void fft_plan_reverse_fma3(const dsp::fft_plan_t *plan, float *re, float *im)
+        {
+            const size_t rank   = plan->rank;
+            fft_plan_swap(plan, re, im);
+
+            if (rank < 3)
+            {
+                const float k   = 1.0f / (1 << rank);
+                small_direct_fft(im, re, im, re, rank);
+                dsp::mul_k2(re, k, 1 << rank);
+                dsp::mul_k2(im, k, 1 << rank);
+                return;
+            }
+
+            fft_start_reverse_fma3(re, im, rank);
+            fft_butterfly_blocked(re, im, 3, rank, butterfly_reverse8p_fma3, butterfly_reverse8p_x2_fma3);
+            dsp::normalize_fft2(re, im, rank);
+        }
+
+        void fft_plan_packed_direct_fma3(const dsp::fft_plan_t *plan, float *data)
+        {
+            const size_t rank   = plan->rank;
+            fft_plan_packed_swap(plan, data);
+
+            if (rank < 3)
+            {
+                packed_small_direct_fft(data, data, rank);
+                return;
+            }
+
+            packed_fft_start_direct_fma3(data, rank);
+            packed_fft_butterfly_blocked(data, 3, rank, packed_butterfly_direct8p_fma3, packed_butterfly_direct8p_x2_fma3);
+            packed_fft_repack(data, rank);
+        }
+
+        void fft_plan_packed_reverse_fma3(const dsp::fft_plan_t *plan, float *data)
+        {
+            const size_t rank   = plan->rank;
+            fft_plan_packed_swap(plan, data);
+
+            if (rank < 3)
+            {
+                fft_plan_packed_conj(data, 1 << rank, 1.0f);
+                packed_small_direct_fft(data, data, rank);
+                fft_plan_packed_conj(data, 1 << rank, 1.0f / (1 << rank));
+                return;
+            }
+
+            packed_fft_start_reverse_fma3(data, rank);
+            packed_fft_butterfly_blocked(data, 3, rank, packed_butterfly_reverse8p_fma3, packed_butterfly_reverse8p_x2_fma3);
+            packed_fft_repack_normalize(data, rank);
+        }
+    } /* namespace avx */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_FFTPLAN_H_ */
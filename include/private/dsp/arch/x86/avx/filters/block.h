@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 10 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_FILTERS_BLOCK_H_
+#define PRIVATE_DSP_ARCH_X86_AVX_FILTERS_BLOCK_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_IMPL */
+
+namespace lsp
+{
+    namespace avx
+    {
+        /*
+         * Layout of the biquad_block_t structure:
+         *   +0x000  h[8][8]
+         *   +0x100  q[8][8]
+         *   +0x200  p[2][8]
+         *   +0x240  a[2][8]
+         *   +0x280  d[8]
+         *   +0x2a0  x1
+         *
+         * Even and odd input samples are accumulated separately to shorten the dependency chain
+         */
+        #define FMA_OFF(a, b)       a
+        #define FMA_ON(a, b)        b
+
+        #define BIQUAD_BLOCK_MAC(SEL, j, S, Y, Z) \
+            __ASM_EMIT("vbroadcastss    " #j "*4(%[src]), %%" S)                                                                /* S    = s[j] */ \
+            __ASM_EMIT(SEL("vmulps      " #j "*0x20+0x000(%[f]), %%" S ", %%ymm6", "vfmadd231ps " #j "*0x20+0x000(%[f]), %%" S ", %%" Y))  /* Y    = y + h[j]*s[j] */ \
+            __ASM_EMIT(SEL("vaddps      %%ymm6, %%" Y ", %%" Y, "")) \
+            __ASM_EMIT(SEL("vmulps      " #j "*0x20+0x100(%[f]), %%" S ", %%ymm6", "vfmadd231ps " #j "*0x20+0x100(%[f]), %%" S ", %%" Z))  /* Z    = z + q[j]*s[j] */ \
+            __ASM_EMIT(SEL("vaddps      %%ymm6, %%" Z ", %%" Z, ""))
+
+        #define BIQUAD_BLOCK_CORE(SEL) \
+            __ASM_EMIT("vmovaps         0x280(%[f]), %%ymm7")                   /* ymm7     = d0 d1 d0 d1 ... */ \
+            __ASM_EMIT("1:") \
+            /* Contribution of input samples */ \
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%ymm3")                  /* ymm3     = s[0] */ \
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%ymm4")                  /* ymm4     = s[1] */ \
+            __ASM_EMIT("vmulps          0x000(%[f]), %%ymm3, %%ymm0")           /* ymm0     = h[0]*s[0] */ \
+            __ASM_EMIT("vmulps          0x100(%[f]), %%ymm3, %%ymm2")           /* ymm2     = q[0]*s[0] */ \
+            __ASM_EMIT("vmulps          0x020(%[f]), %%ymm4, %%ymm1")           /* ymm1     = h[1]*s[1] */ \
+            __ASM_EMIT("vmulps          0x120(%[f]), %%ymm4, %%ymm5")           /* ymm5     = q[1]*s[1] */ \
+            BIQUAD_BLOCK_MAC(SEL, 2, "ymm3", "ymm0", "ymm2") \
+            BIQUAD_BLOCK_MAC(SEL, 3, "ymm4", "ymm1", "ymm5") \
+            BIQUAD_BLOCK_MAC(SEL, 4, "ymm3", "ymm0", "ymm2") \
+            BIQUAD_BLOCK_MAC(SEL, 5, "ymm4", "ymm1", "ymm5") \
+            BIQUAD_BLOCK_MAC(SEL, 6, "ymm3", "ymm0", "ymm2") \
+            BIQUAD_BLOCK_MAC(SEL, 7, "ymm4", "ymm1", "ymm5") \
+            /* Contribution of the state */ \
+            __ASM_EMIT("vpermilps       $0x00, %%ymm7, %%ymm3")                 /* ymm3     = d0 */ \
+            __ASM_EMIT("vpermilps       $0x55, %%ymm7, %%ymm4")                 /* ymm4     = d1 */ \
+            __ASM_EMIT(SEL("vmulps      0x200(%[f]), %%ymm3, %%ymm6", "vfmadd231ps 0x200(%[f]), %%ymm3, %%ymm0"))  /* ymm0 = y + p[0]*d0 */ \
+            __ASM_EMIT(SEL("vaddps      %%ymm6, %%ymm0, %%ymm0", "")) \
+            __ASM_EMIT(SEL("vmulps      0x220(%[f]), %%ymm4, %%ymm6", "vfmadd231ps 0x220(%[f]), %%ymm4, %%ymm1"))  /* ymm1 = y + p[1]*d1 */ \
+            __ASM_EMIT(SEL("vaddps      %%ymm6, %%ymm1, %%ymm1", "")) \
+            __ASM_EMIT(SEL("vmulps      0x240(%[f]), %%ymm3, %%ymm6", "vfmadd231ps 0x240(%[f]), %%ymm3, %%ymm2"))  /* ymm2 = z + a[0]*d0 */ \
+            __ASM_EMIT(SEL("vaddps      %%ymm6, %%ymm2, %%ymm2", "")) \
+            __ASM_EMIT(SEL("vmulps      0x260(%[f]), %%ymm4, %%ymm6", "vfmadd231ps 0x260(%[f]), %%ymm4, %%ymm5"))  /* ymm5 = z + a[1]*d1 */ \
+            __ASM_EMIT(SEL("vaddps      %%ymm6, %%ymm5, %%ymm5", "")) \
+            __ASM_EMIT("vaddps          %%ymm1, %%ymm0, %%ymm0")                /* ymm0     = y[0:7] */ \
+            __ASM_EMIT("vaddps          %%ymm5, %%ymm2, %%ymm7")                /* ymm7     = d0' d1' d0' d1' ... */ \
+            __ASM_EMIT("vmovups         %%ymm0, 0x00(%[dst])") \
+            __ASM_EMIT("add             $0x20, %[src]") \
+            __ASM_EMIT("add             $0x20, %[dst]") \
+            __ASM_EMIT64("dec           %[count]") \
+            __ASM_EMIT32("decl          %[count]") \
+            __ASM_EMIT("jnz             1b") \
+            __ASM_EMIT("vmovaps         %%ymm7, 0x280(%[f])")
+
+        static void biquad_block_core(float *dst, const float *src, size_t blocks, dsp::biquad_block_t *f)
+        {
+            ARCH_X86_ASM
+            (
+                BIQUAD_BLOCK_CORE(FMA_OFF)
+                : [dst] "+r" (dst), [src] "+r" (src),
+                  [count] X86_PGREG (blocks)
+                : [f] "r" (f)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+            );
+        }
+
+        static void biquad_block_core_fma3(float *dst, const float *src, size_t blocks, dsp::biquad_block_t *f)
+        {
+            ARCH_X86_ASM
+            (
+                BIQUAD_BLOCK_CORE(FMA_ON)
+                : [dst] "+r" (dst), [src] "+r" (src),
+                  [count] X86_PGREG (blocks)
+                : [f] "r" (f)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+            );
+        }
+
+        #undef BIQUAD_BLOCK_CORE
+        #undef BIQUAD_BLOCK_MAC
+        #undef FMA_OFF
+        #undef FMA_ON
+
+        static void biquad_block_tail(float *dst, const float *src, size_t count, dsp::biquad_block_t *f)
+        {
+            float d0        = f->d[0];
+            float d1        = f->d[1];
+
+            for (size_t i=0; i<count; ++i)
+            {
+                float s         = src[i];
+                float s2        = f->x1.b0*s + d0;
+                float p1        = f->x1.b1*s + f->x1.a1*s2;
+                float p2        = f->x1.b2*s + f->x1.a2*s2;
+
+                dst[i]          = s2;
+                d0              = d1 + p1;
+                d1              = p2;
+            }
+
+            for (size_t i=0; i<8; i += 2)
+            {
+                f->d[i]         = d0;
+                f->d[i+1]       = d1;
+            }
+        }
+
+        typedef void (* biquad_block_core_t)(float *dst, const float *src, size_t blocks, dsp::biquad_block_t *f);
+
+        static inline void biquad_block_process_chain(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n, biquad_block_core_t core)
+        {
+            const size_t blocks = count / LSP_DSP_BIQUAD_BLOCK_SIZE;
+            const size_t off    = blocks * LSP_DSP_BIQUAD_BLOCK_SIZE;
+
+            for (size_t i=0; i<n; ++i, ++f)
+            {
+                if (blocks > 0)
+                    core(dst, src, blocks, f);
+                if (off < count)
+                    biquad_block_tail(&dst[off], &src[off], count - off, f);
+
+                // Next filters in the chain are applied to the destination buffer
+                src             = dst;
+            }
+        }
+
+        void biquad_block_process(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n)
+        {
+            biquad_block_process_chain(dst, src, count, f, n, biquad_block_core);
+        }
+
+        void biquad_block_process_fma3(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n)
+        {
+            biquad_block_process_chain(dst, src, count, f, n, biquad_block_core_fma3);
+        }
+    } /* namespace avx */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_FILTERS_BLOCK_H_ */
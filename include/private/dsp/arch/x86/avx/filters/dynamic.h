@@ -818,6 +818,199 @@ namespace lsp
             );
         }
 
+        void dyn_biquad_process_x16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f)
+        {
+            // Process as two x8 filter banks, the second one takes the output of the first one.
+            // The i'th sample of the second bank is processed with the (i+8)'th filter bank
+            biquad_process_x16_half(dst, src, count, &d[0], &f[0].b0[0], sizeof(dsp::biquad_x16_t));
+            biquad_process_x16_half(dst, dst, count, &d[8], &f[8].b0[8], sizeof(dsp::biquad_x16_t));
+        }
+
+        void dyn_biquad_process_x16_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f)
+        {
+            // Process as two x8 filter banks, the second one takes the output of the first one.
+            // The i'th sample of the second bank is processed with the (i+8)'th filter bank
+            biquad_process_x16_half_fma3(dst, src, count, &d[0], &f[0].b0[0], sizeof(dsp::biquad_x16_t));
+            biquad_process_x16_half_fma3(dst, dst, count, &d[8], &f[8].b0[8], sizeof(dsp::biquad_x16_t));
+        }
+
+        IF_ARCH_X86_64(
+            static const float dyn_bilinear_const[] __lsp_aligned32 =
+            {
+                LSP_DSP_VEC8(1.0f)
+            };
+        )
+
+        #define FMA_OFF(a, b)       a
+        #define FMA_ON(a, b)        b
+
+        /*
+         * Compute the row of 8 filters from the row of 8 cascades and apply it:
+         * ymm12 = s, ymm13 = d0, ymm14 = d1, ymm15 = mask of active filters
+         */
+        #define DYN_BILINEAR_X8_STEP(SEL) \
+            /* Load and transpose the row of cascades */ \
+            __ASM_EMIT("vmovups         0x00(%[bc]), %%ymm2")                           /* ymm2  = t0[0] t1[0] t2[0]   ?   b0[0] b1[0] b2[0]   ? */ \
+            __ASM_EMIT("vmovups         0x20(%[bc]), %%ymm3")                           /* ymm3  = t0[1] t1[1] t2[1]   ?   b0[1] b1[1] b2[1]   ? */ \
+            __ASM_EMIT("vmovups         0x40(%[bc]), %%ymm4")                           /* ymm4  = t0[2] t1[2] t2[2]   ?   b0[2] b1[2] b2[2]   ? */ \
+            __ASM_EMIT("vmovups         0x60(%[bc]), %%ymm5")                           /* ymm5  = t0[3] t1[3] t2[3]   ?   b0[3] b1[3] b2[3]   ? */ \
+            __ASM_EMIT("vmovups         0x80(%[bc]), %%ymm6")                           /* ymm6  = t0[4] t1[4] t2[4]   ?   b0[4] b1[4] b2[4]   ? */ \
+            __ASM_EMIT("vmovups         0xa0(%[bc]), %%ymm7")                           /* ymm7  = t0[5] t1[5] t2[5]   ?   b0[5] b1[5] b2[5]   ? */ \
+            __ASM_EMIT("vmovups         0xc0(%[bc]), %%ymm8")                           /* ymm8  = t0[6] t1[6] t2[6]   ?   b0[6] b1[6] b2[6]   ? */ \
+            __ASM_EMIT("vmovups         0xe0(%[bc]), %%ymm9")                           /* ymm9  = t0[7] t1[7] t2[7]   ?   b0[7] b1[7] b2[7]   ? */ \
+            __ASM_EMIT("vunpcklps       %%ymm3, %%ymm2, %%ymm0")                        /* ymm0  = t0[0] t0[1] t1[0] t1[1] b0[0] b0[1] b1[0] b1[1] */ \
+            __ASM_EMIT("vunpcklps       %%ymm5, %%ymm4, %%ymm1")                        /* ymm1  = t0[2] t0[3] t1[2] t1[3] b0[2] b0[3] b1[2] b1[3] */ \
+            __ASM_EMIT("vunpcklps       %%ymm7, %%ymm6, %%ymm10")                       /* ymm10 = t0[4] t0[5] t1[4] t1[5] b0[4] b0[5] b1[4] b1[5] */ \
+            __ASM_EMIT("vunpcklps       %%ymm9, %%ymm8, %%ymm11")                       /* ymm11 = t0[6] t0[7] t1[6] t1[7] b0[6] b0[7] b1[6] b1[7] */ \
+            __ASM_EMIT("vunpckhps       %%ymm3, %%ymm2, %%ymm2")                        /* ymm2  = t2[0] t2[1]   ?     ?   b2[0] b2[1]   ?     ? */ \
+            __ASM_EMIT("vunpckhps       %%ymm5, %%ymm4, %%ymm4")                        /* ymm4  = t2[2] t2[3]   ?     ?   b2[2] b2[3]   ?     ? */ \
+            __ASM_EMIT("vunpckhps       %%ymm7, %%ymm6, %%ymm6")                        /* ymm6  = t2[4] t2[5]   ?     ?   b2[4] b2[5]   ?     ? */ \
+            __ASM_EMIT("vunpckhps       %%ymm9, %%ymm8, %%ymm8")                        /* ymm8  = t2[6] t2[7]   ?     ?   b2[6] b2[7]   ?     ? */ \
+            __ASM_EMIT("vshufps         $0x44, %%ymm1, %%ymm0, %%ymm3")                 /* ymm3  = t0[0] t0[1] t0[2] t0[3] b0[0] b0[1] b0[2] b0[3] */ \
+            __ASM_EMIT("vshufps         $0x44, %%ymm11, %%ymm10, %%ymm5")               /* ymm5  = t0[4] t0[5] t0[6] t0[7] b0[4] b0[5] b0[6] b0[7] */ \
+            __ASM_EMIT("vshufps         $0x44, %%ymm4, %%ymm2, %%ymm2")                 /* ymm2  = t2[0] t2[1] t2[2] t2[3] b2[0] b2[1] b2[2] b2[3] */ \
+            __ASM_EMIT("vshufps         $0x44, %%ymm8, %%ymm6, %%ymm6")                 /* ymm6  = t2[4] t2[5] t2[6] t2[7] b2[4] b2[5] b2[6] b2[7] */ \
+            __ASM_EMIT("vshufps         $0xee, %%ymm1, %%ymm0, %%ymm4")                 /* ymm4  = t1[0] t1[1] t1[2] t1[3] b1[0] b1[1] b1[2] b1[3] */ \
+            __ASM_EMIT("vshufps         $0xee, %%ymm11, %%ymm10, %%ymm7")               /* ymm7  = t1[4] t1[5] t1[6] t1[7] b1[4] b1[5] b1[6] b1[7] */ \
+            __ASM_EMIT("vextractf128    $1, %%ymm3, %%xmm8")                            /* xmm8  = b0[0] b0[1] b0[2] b0[3] */ \
+            __ASM_EMIT("vextractf128    $1, %%ymm2, %%xmm9")                            /* xmm9  = b2[0] b2[1] b2[2] b2[3] */ \
+            __ASM_EMIT("vextractf128    $1, %%ymm4, %%xmm10")                           /* xmm10 = b1[0] b1[1] b1[2] b1[3] */ \
+            __ASM_EMIT("vinsertf128     $1, %%xmm5, %%ymm3, %%ymm3")                    /* ymm3  = T0 */ \
+            __ASM_EMIT("vinsertf128     $1, %%xmm6, %%ymm2, %%ymm2")                    /* ymm2  = t2 */ \
+            __ASM_EMIT("vinsertf128     $1, %%xmm7, %%ymm4, %%ymm4")                    /* ymm4  = t1 */ \
+            __ASM_EMIT("vinsertf128     $0, %%xmm8, %%ymm5, %%ymm5")                    /* ymm5  = B0 */ \
+            __ASM_EMIT("vinsertf128     $0, %%xmm9, %%ymm6, %%ymm6")                    /* ymm6  = b2 */ \
+            __ASM_EMIT("vinsertf128     $0, %%xmm10, %%ymm7, %%ymm7")                   /* ymm7  = b1 */ \
+            /* Compute coefficients of filters */ \
+            __ASM_EMIT("vbroadcastss    (%[kf]), %%ymm0")                               /* ymm0  = kf */ \
+            __ASM_EMIT("vmulps          %%ymm0, %%ymm0, %%ymm1")                        /* ymm1  = kf*kf = kf2 */ \
+            __ASM_EMIT("vmulps          %%ymm0, %%ymm4, %%ymm4")                        /* ymm4  = T1 = t1 * kf */ \
+            __ASM_EMIT("vmulps          %%ymm1, %%ymm2, %%ymm2")                        /* ymm2  = T2 = t2 * kf2 */ \
+            __ASM_EMIT("vmulps          %%ymm0, %%ymm7, %%ymm7")                        /* ymm7  = B1 = b1 * kf */ \
+            __ASM_EMIT("vmulps          %%ymm1, %%ymm6, %%ymm6")                        /* ymm6  = B2 = b2 * kf2 */ \
+            __ASM_EMIT("vaddps          %%ymm2, %%ymm3, %%ymm10")                       /* ymm10 = T0 + T2 */ \
+            __ASM_EMIT("vsubps          %%ymm5, %%ymm6, %%ymm8")                        /* ymm8  = B2 - B0 */ \
+            __ASM_EMIT("vsubps          %%ymm2, %%ymm3, %%ymm3")                        /* ymm3  = T0 - T2 */ \
+            __ASM_EMIT("vaddps          %%ymm5, %%ymm6, %%ymm5")                        /* ymm5  = B2 + B0 */ \
+            __ASM_EMIT("vaddps          %%ymm4, %%ymm10, %%ymm11")                      /* ymm11 = T0 + T1 + T2 */ \
+            __ASM_EMIT("vaddps          %%ymm8, %%ymm8, %%ymm8")                        /* ymm8  = 2 * (B2 - B0) */ \
+            __ASM_EMIT("vaddps          %%ymm3, %%ymm3, %%ymm3")                        /* ymm3  = 2 * (T0 - T2) */ \
+            __ASM_EMIT("vaddps          %%ymm5, %%ymm7, %%ymm9")                        /* ymm9  = B0 + B1 + B2 */ \
+            __ASM_EMIT("vsubps          %%ymm4, %%ymm10, %%ymm4")                       /* ymm4  = T0 - T1 + T2 */ \
+            __ASM_EMIT("vmovaps         %[ONE], %%ymm0")                                /* ymm0  = 1 */ \
+            __ASM_EMIT("vdivps          %%ymm9, %%ymm0, %%ymm9")                        /* ymm9  = N = 1 / (B0 + B1 + B2) */ \
+            __ASM_EMIT("vsubps          %%ymm5, %%ymm7, %%ymm5")                        /* ymm5  = B1 - B2 - B0 */ \
+            __ASM_EMIT("vmulps          %%ymm9, %%ymm11, %%ymm11")                      /* ymm11 = a0 = (T0 + T1 + T2) * N */ \
+            __ASM_EMIT("vmulps          %%ymm9, %%ymm3, %%ymm3")                        /* ymm3  = a1 = 2 * (T0 - T2) * N */ \
+            __ASM_EMIT("vmulps          %%ymm9, %%ymm4, %%ymm4")                        /* ymm4  = a2 = (T0 - T1 + T2) * N */ \
+            __ASM_EMIT("vmulps          %%ymm9, %%ymm8, %%ymm8")                        /* ymm8  = b1 = 2 * (B2 - B0) * N */ \
+            __ASM_EMIT("vmulps          %%ymm9, %%ymm5, %%ymm5")                        /* ymm5  = b2 = (B1 - B2 - B0) * N */ \
+            /* Process filters */ \
+            __ASM_EMIT("vmulps          %%ymm12, %%ymm3, %%ymm3")                       /* ymm3  = s*a1 */ \
+            __ASM_EMIT("vmulps          %%ymm12, %%ymm4, %%ymm4")                       /* ymm4  = s*a2 */ \
+            __ASM_EMIT(SEL("vmulps      %%ymm11, %%ymm12, %%ymm12", "vfmadd132ps %%ymm11, %%ymm13, %%ymm12"))   /* ymm12 = s*a0+d0 = s2 */ \
+            __ASM_EMIT(SEL("vaddps      %%ymm13, %%ymm12, %%ymm12", "")) \
+            __ASM_EMIT(SEL("vmulps      %%ymm12, %%ymm8, %%ymm8", "vfmadd231ps %%ymm8, %%ymm12, %%ymm3"))      /* ymm3  = s*a1 + s2*b1 = p1 */ \
+            __ASM_EMIT(SEL("vaddps      %%ymm8, %%ymm3, %%ymm3", "")) \
+            __ASM_EMIT(SEL("vmulps      %%ymm12, %%ymm5, %%ymm5", "vfmadd231ps %%ymm5, %%ymm12, %%ymm4"))      /* ymm4  = s*a2 + s2*b2 = p2 */ \
+            __ASM_EMIT(SEL("vaddps      %%ymm5, %%ymm4, %%ymm4", "")) \
+            __ASM_EMIT("vaddps          %%ymm14, %%ymm3, %%ymm3")                       /* ymm3  = p1 + d1 */ \
+            /* Update delay only by mask */ \
+            __ASM_EMIT("vblendvps       %%ymm15, %%ymm3, %%ymm13, %%ymm13")             /* ymm13 = (p1 + d1) & MASK | (d0 & ~MASK) */ \
+            __ASM_EMIT("vblendvps       %%ymm15, %%ymm4, %%ymm14, %%ymm14")             /* ymm14 = (p2 & MASK) | (d1 & ~MASK) */ \
+            /* Rotate buffer and mask */ \
+            __ASM_EMIT("vpermilps       $0x93, %%ymm12, %%ymm12")                       /* ymm12 = s2[3] s2[0] s2[1] s2[2] s2[7] s2[4] s2[5] s2[6] */ \
+            __ASM_EMIT("vpermilps       $0x93, %%ymm15, %%ymm15")                       /* ymm15 =  m[3]  m[0]  m[1]  m[2]  m[7]  m[4]  m[5]  m[6] */ \
+            __ASM_EMIT("vperm2f128      $0x01, %%ymm12, %%ymm12, %%ymm0")               /* ymm0  = s2[7] s2[4] s2[5] s2[6] s2[3] s2[0] s2[1] s2[2] */ \
+            __ASM_EMIT("vperm2f128      $0x01, %%ymm15, %%ymm15, %%ymm1")               /* ymm1  =  m[7]  m[4]  m[5]  m[6]  m[3]  m[0]  m[1]  m[2] */ \
+            __ASM_EMIT("vblendps        $0x11, %%ymm0, %%ymm12, %%ymm12")               /* ymm12 = s2[7] s2[0] s2[1] s2[2] s2[3] s2[4] s2[5] s2[6] */ \
+            __ASM_EMIT("vblendps        $0x11, %%ymm1, %%ymm15, %%ymm15")               /* ymm15 =  m[7]  m[0]  m[1]  m[2]  m[3]  m[4]  m[5]  m[6] */ \
+            __ASM_EMIT("add             $0x100, %[bc]")                                 /* bc   += 8 */ \
+            __ASM_EMIT("add             $4, %[kf]")                                     /* kf   ++ */
+
+        #define DYN_BILINEAR_X8_PROCESS(SEL) \
+            IF_ARCH_X86_64(size_t skip); \
+            ARCH_X86_64_ASM \
+            ( \
+                /* Check count */ \
+                __ASM_EMIT("test            %[count], %[count]") \
+                __ASM_EMIT("jz              8f") \
+                \
+                /* Initialize state */ \
+                __ASM_EMIT("vxorps          %%ymm12, %%ymm12, %%ymm12")                 /* ymm12 = s = 0 */ \
+                __ASM_EMIT("vxorps          %%ymm15, %%ymm15, %%ymm15")                 /* ymm15 = mask = 0 */ \
+                __ASM_EMIT("vmovups         0x00(%[d]), %%ymm13")                       /* ymm13 = d0 */ \
+                __ASM_EMIT("vmovups         0x20(%[d]), %%ymm14")                       /* ymm14 = d1 */ \
+                __ASM_EMIT("mov             $7, %[skip]")                               /* skip  = 7 */ \
+                \
+                /* Push samples to the pipeline */ \
+                __ASM_EMIT(".align 16") \
+                __ASM_EMIT("1:") \
+                __ASM_EMIT("vmovss          (%[src]), %%xmm0")                          /* xmm0  = *src */ \
+                __ASM_EMIT("add             $4, %[src]")                                /* src   ++ */ \
+                __ASM_EMIT("vblendps        $0x01, %%ymm0, %%ymm12, %%ymm12")           /* ymm12 = s */ \
+                __ASM_EMIT("vblendps        $0x01, %[X_MASK], %%ymm15, %%ymm15")        /* ymm15 = m[0] = 1 */ \
+                DYN_BILINEAR_X8_STEP(SEL) \
+                __ASM_EMIT("test            %[skip], %[skip]") \
+                __ASM_EMIT("jz              2f") \
+                __ASM_EMIT("dec             %[skip]")                                   /* skip  -- */ \
+                __ASM_EMIT("jmp             3f") \
+                __ASM_EMIT("2:") \
+                __ASM_EMIT("vmovss          %%xmm12, (%[dst])")                         /* *dst  = s2[7] */ \
+                __ASM_EMIT("add             $4, %[dst]")                                /* dst   ++ */ \
+                __ASM_EMIT("3:") \
+                __ASM_EMIT("dec             %[count]") \
+                __ASM_EMIT("jnz             1b") \
+                \
+                /* Flush the pipeline */ \
+                __ASM_EMIT("mov             $7, %[count]") \
+                __ASM_EMIT("4:") \
+                __ASM_EMIT("vxorps          %%ymm0, %%ymm0, %%ymm0")                    /* ymm0  = 0 */ \
+                __ASM_EMIT("vblendps        $0x01, %%ymm0, %%ymm12, %%ymm12")           /* ymm12 = s */ \
+                __ASM_EMIT("vblendps        $0x01, %%ymm0, %%ymm15, %%ymm15")           /* ymm15 = m[0] = 0 */ \
+                DYN_BILINEAR_X8_STEP(SEL) \
+                __ASM_EMIT("test            %[skip], %[skip]") \
+                __ASM_EMIT("jz              5f") \
+                __ASM_EMIT("dec             %[skip]")                                   /* skip  -- */ \
+                __ASM_EMIT("jmp             6f") \
+                __ASM_EMIT("5:") \
+                __ASM_EMIT("vmovss          %%xmm12, (%[dst])")                         /* *dst  = s2[7] */ \
+                __ASM_EMIT("add             $4, %[dst]")                                /* dst   ++ */ \
+                __ASM_EMIT("6:") \
+                __ASM_EMIT("dec             %[count]") \
+                __ASM_EMIT("jnz             4b") \
+                \
+                /* Store delay buffer */ \
+                __ASM_EMIT("vmovups         %%ymm13, 0x00(%[d])")                       /* *d0   = ymm13 */ \
+                __ASM_EMIT("vmovups         %%ymm14, 0x20(%[d])")                       /* *d1   = ymm14 */ \
+                __ASM_EMIT("8:") \
+                \
+                : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count), \
+                  [bc] "+r" (bc), [kf] "+r" (kf), [skip] "=&r" (skip) \
+                : [d] "r" (d), \
+                  [X_MASK] "m" (dyn_biquad_x8_mask), \
+                  [ONE] "m" (dyn_bilinear_const) \
+                : "cc", "memory", \
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7", \
+                  "%xmm8", "%xmm9", "%xmm10", "%xmm11", \
+                  "%xmm12", "%xmm13", "%xmm14", "%xmm15" \
+            );
+
+        void x64_dyn_bilinear_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::f_cascade_t *bc, const float *kf)
+        {
+            DYN_BILINEAR_X8_PROCESS(FMA_OFF);
+        }
+
+        void x64_dyn_bilinear_biquad_process_x8_fma3(float *dst, const float *src, float *d, size_t count, const dsp::f_cascade_t *bc, const float *kf)
+        {
+            DYN_BILINEAR_X8_PROCESS(FMA_ON);
+        }
+
+        #undef DYN_BILINEAR_X8_PROCESS
+        #undef DYN_BILINEAR_X8_STEP
+        #undef FMA_OFF
+        #undef FMA_ON
     } /* namespace avx */
 } /* namespace lsp */
 
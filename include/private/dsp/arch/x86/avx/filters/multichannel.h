@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 7 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_FILTERS_MULTICHANNEL_H_
+#define PRIVATE_DSP_ARCH_X86_AVX_FILTERS_MULTICHANNEL_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_IMPL */
+
+namespace lsp
+{
+    namespace avx
+    {
+        /*
+         * The context of the 8-lane filter:
+         *   +0x00  b0[8]
+         *   +0x20  b1[8]
+         *   +0x40  b2[8]
+         *   +0x60  a1[8]
+         *   +0x80  a2[8]
+         *   +0xa0  d0[8]
+         *   +0xc0  d1[8]
+         */
+        #define BIQUAD_MC8_CTX_SIZE     56
+
+        #define FMA_OFF(a, b)       a
+        #define FMA_ON(a, b)        b
+
+        #define BIQUAD_MC8_STEP(SEL) \
+            __ASM_EMIT("vmulps          0x20(%[ctx]), %%ymm0, %%ymm1")      /* ymm1     = b1*s */ \
+            __ASM_EMIT("vmulps          0x40(%[ctx]), %%ymm0, %%ymm2")      /* ymm2     = b2*s */ \
+            __ASM_EMIT(SEL("vmulps      0x00(%[ctx]), %%ymm0, %%ymm0", "vfmadd132ps 0x00(%[ctx]), %%ymm6, %%ymm0"))    /* ymm0 = b0*s + d0 = s2 */ \
+            __ASM_EMIT(SEL("vaddps      %%ymm6, %%ymm0, %%ymm0", "")) \
+            __ASM_EMIT("vaddps          %%ymm7, %%ymm1, %%ymm6")            /* ymm6     = b1*s + d1 */ \
+            __ASM_EMIT("vmovaps         %%ymm2, %%ymm7")                    /* ymm7     = b2*s */ \
+            __ASM_EMIT(SEL("vmulps      0x60(%[ctx]), %%ymm0, %%ymm1", "vfmadd231ps 0x60(%[ctx]), %%ymm0, %%ymm6"))    /* ymm6 = b1*s + a1*s2 + d1 = d0' */ \
+            __ASM_EMIT(SEL("vmulps      0x80(%[ctx]), %%ymm0, %%ymm2", "vfmadd231ps 0x80(%[ctx]), %%ymm0, %%ymm7"))    /* ymm7 = b2*s + a2*s2 = d1' */ \
+            __ASM_EMIT(SEL("vaddps      %%ymm1, %%ymm6, %%ymm6", "")) \
+            __ASM_EMIT(SEL("vaddps      %%ymm2, %%ymm7, %%ymm7", ""))
+
+        #define BIQUAD_MC_LOAD_PTR(idx, array) \
+            __ASM_EMIT32("mov           " #idx "*4(%[" array "]), %[ptr]") \
+            __ASM_EMIT64("mov           " #idx "*8(%[" array "]), %[ptr]")
+
+        /*
+         * Process 8 interleaved channels, the distance between frames is stride bytes
+         */
+        #define BIQUAD_MC8_CORE(SEL) \
+            __ASM_EMIT64("test          %[count], %[count]") \
+            __ASM_EMIT32("cmpl          $0, %[count]") \
+            __ASM_EMIT("jz              2f") \
+            __ASM_EMIT("vmovaps         0xa0(%[ctx]), %%ymm6")              /* ymm6     = d0 */ \
+            __ASM_EMIT("vmovaps         0xc0(%[ctx]), %%ymm7")              /* ymm7     = d1 */ \
+            \
+            __ASM_EMIT("1:") \
+            __ASM_EMIT("vmovups         (%[src]), %%ymm0")                  /* ymm0     = s */ \
+            BIQUAD_MC8_STEP(SEL) \
+            __ASM_EMIT("vmovups         %%ymm0, (%[dst])")                  /* *dst     = s2 */ \
+            __ASM_EMIT("add             %[stride], %[src]") \
+            __ASM_EMIT("add             %[stride], %[dst]") \
+            __ASM_EMIT64("dec           %[count]") \
+            __ASM_EMIT32("decl          %[count]") \
+            __ASM_EMIT("jnz             1b") \
+            \
+            __ASM_EMIT("vmovaps         %%ymm6, 0xa0(%[ctx])") \
+            __ASM_EMIT("vmovaps         %%ymm7, 0xc0(%[ctx])") \
+            __ASM_EMIT("2:")
+
+        /*
+         * Process 8 planar channels
+         */
+        #define BIQUAD_MC8_PLANAR_CORE(SEL) \
+            __ASM_EMIT64("test          %[count], %[count]") \
+            __ASM_EMIT32("cmpl          $0, %[count]") \
+            __ASM_EMIT("jz              2f") \
+            __ASM_EMIT("xor             %[off], %[off]") \
+            __ASM_EMIT("vmovaps         0xa0(%[ctx]), %%ymm6")              /* ymm6     = d0 */ \
+            __ASM_EMIT("vmovaps         0xc0(%[ctx]), %%ymm7")              /* ymm7     = d1 */ \
+            \
+            __ASM_EMIT("1:") \
+            /* Gather samples of all channels */ \
+            BIQUAD_MC_LOAD_PTR(0, "src") \
+            __ASM_EMIT("vmovss          (%[ptr], %[off]), %%xmm0")                      /* xmm0     = s0 0 0 0 */ \
+            BIQUAD_MC_LOAD_PTR(4, "src") \
+            __ASM_EMIT("vmovss          (%[ptr], %[off]), %%xmm1")                      /* xmm1     = s4 0 0 0 */ \
+            BIQUAD_MC_LOAD_PTR(1, "src") \
+            __ASM_EMIT("vinsertps       $0x10, (%[ptr], %[off]), %%xmm0, %%xmm0")       /* xmm0     = s0 s1 0 0 */ \
+            BIQUAD_MC_LOAD_PTR(5, "src") \
+            __ASM_EMIT("vinsertps       $0x10, (%[ptr], %[off]), %%xmm1, %%xmm1")       /* xmm1     = s4 s5 0 0 */ \
+            BIQUAD_MC_LOAD_PTR(2, "src") \
+            __ASM_EMIT("vinsertps       $0x20, (%[ptr], %[off]), %%xmm0, %%xmm0")       /* xmm0     = s0 s1 s2 0 */ \
+            BIQUAD_MC_LOAD_PTR(6, "src") \
+            __ASM_EMIT("vinsertps       $0x20, (%[ptr], %[off]), %%xmm1, %%xmm1")       /* xmm1     = s4 s5 s6 0 */ \
+            BIQUAD_MC_LOAD_PTR(3, "src") \
+            __ASM_EMIT("vinsertps       $0x30, (%[ptr], %[off]), %%xmm0, %%xmm0")       /* xmm0     = s0 s1 s2 s3 */ \
+            BIQUAD_MC_LOAD_PTR(7, "src") \
+            __ASM_EMIT("vinsertps       $0x30, (%[ptr], %[off]), %%xmm1, %%xmm1")       /* xmm1     = s4 s5 s6 s7 */ \
+            __ASM_EMIT("vinsertf128     $1, %%xmm1, %%ymm0, %%ymm0")                    /* ymm0     = s0 s1 s2 s3 s4 s5 s6 s7 */ \
+            BIQUAD_MC8_STEP(SEL) \
+            /* Scatter samples to all channels */ \
+            __ASM_EMIT("vextractf128    $1, %%ymm0, %%xmm1")                            /* xmm1     = r4 r5 r6 r7 */ \
+            BIQUAD_MC_LOAD_PTR(0, "dst") \
+            __ASM_EMIT("vmovss          %%xmm0, (%[ptr], %[off])") \
+            BIQUAD_MC_LOAD_PTR(4, "dst") \
+            __ASM_EMIT("vmovss          %%xmm1, (%[ptr], %[off])") \
+            BIQUAD_MC_LOAD_PTR(1, "dst") \
+            __ASM_EMIT("vextractps      $1, %%xmm0, (%[ptr], %[off])") \
+            BIQUAD_MC_LOAD_PTR(5, "dst") \
+            __ASM_EMIT("vextractps      $1, %%xmm1, (%[ptr], %[off])") \
+            BIQUAD_MC_LOAD_PTR(2, "dst") \
+            __ASM_EMIT("vextractps      $2, %%xmm0, (%[ptr], %[off])") \
+            BIQUAD_MC_LOAD_PTR(6, "dst") \
+            __ASM_EMIT("vextractps      $2, %%xmm1, (%[ptr], %[off])") \
+            BIQUAD_MC_LOAD_PTR(3, "dst") \
+            __ASM_EMIT("vextractps      $3, %%xmm0, (%[ptr], %[off])") \
+            BIQUAD_MC_LOAD_PTR(7, "dst") \
+            __ASM_EMIT("vextractps      $3, %%xmm1, (%[ptr], %[off])") \
+            __ASM_EMIT("add             $4, %[off]") \
+            __ASM_EMIT64("dec           %[count]") \
+            __ASM_EMIT32("decl          %[count]") \
+            __ASM_EMIT("jnz             1b") \
+            \
+            __ASM_EMIT("vmovaps         %%ymm6, 0xa0(%[ctx])") \
+            __ASM_EMIT("vmovaps         %%ymm7, 0xc0(%[ctx])") \
+            __ASM_EMIT("2:")
+
+        static void biquad_mc8_core(float *dst, const float *src, size_t count, size_t stride, float *ctx)
+        {
+            ARCH_X86_ASM
+            (
+                BIQUAD_MC8_CORE(FMA_OFF)
+                : [dst] "+r" (dst), [src] "+r" (src),
+                  [count] X86_PGREG (count)
+                : [ctx] "r" (ctx), [stride] "r" (stride)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2",
+                  "%xmm6", "%xmm7"
+            );
+        }
+
+        static void biquad_mc8_core_fma3(float *dst, const float *src, size_t count, size_t stride, float *ctx)
+        {
+            ARCH_X86_ASM
+            (
+                BIQUAD_MC8_CORE(FMA_ON)
+                : [dst] "+r" (dst), [src] "+r" (src),
+                  [count] X86_PGREG (count)
+                : [ctx] "r" (ctx), [stride] "r" (stride)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2",
+                  "%xmm6", "%xmm7"
+            );
+        }
+
+        static void biquad_mc8_planar_core(float * const *dst, const float * const *src, size_t count, float *ctx)
+        {
+            IF_ARCH_X86(
+                size_t off;
+                float *ptr;
+            );
+
+            ARCH_X86_ASM
+            (
+                BIQUAD_MC8_PLANAR_CORE(FMA_OFF)
+                : [off] "=&r" (off), [ptr] "=&r" (ptr),
+                  [count] X86_PGREG (count)
+                : [dst] "r" (dst), [src] "r" (src), [ctx] "r" (ctx)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2",
+                  "%xmm6", "%xmm7"
+            );
+        }
+
+        static void biquad_mc8_planar_core_fma3(float * const *dst, const float * const *src, size_t count, float *ctx)
+        {
+            IF_ARCH_X86(
+                size_t off;
+                float *ptr;
+            );
+
+            ARCH_X86_ASM
+            (
+                BIQUAD_MC8_PLANAR_CORE(FMA_ON)
+                : [off] "=&r" (off), [ptr] "=&r" (ptr),
+                  [count] X86_PGREG (count)
+                : [dst] "r" (dst), [src] "r" (src), [ctx] "r" (ctx)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2",
+                  "%xmm6", "%xmm7"
+            );
+        }
+
+        #undef BIQUAD_MC8_PLANAR_CORE
+        #undef BIQUAD_MC8_CORE
+        #undef BIQUAD_MC_LOAD_PTR
+        #undef BIQUAD_MC8_STEP
+        #undef FMA_OFF
+        #undef FMA_ON
+
+        static inline void biquad_mc8_ctx_load(float *ctx, const float *f, const float *d, size_t lanes)
+        {
+            for (size_t i=0; i<5; ++i, f += lanes)
+                for (size_t j=0; j<8; ++j)
+                    *(ctx++)        = f[j];
+            for (size_t j=0; j<8; ++j)
+            {
+                ctx[j]          = d[j];
+                ctx[j + 8]      = d[j + lanes];
+            }
+        }
+
+        static inline void biquad_mc8_ctx_store(float *d, const float *ctx, size_t lanes)
+        {
+            for (size_t j=0; j<8; ++j)
+            {
+                d[j]            = ctx[j + 40];
+                d[j + lanes]    = ctx[j + 48];
+            }
+        }
+
+        typedef void (* biquad_mc8_core_t)(float *dst, const float *src, size_t count, size_t stride, float *ctx);
+        typedef void (* biquad_mc8_planar_core_t)(float * const *dst, const float * const *src, size_t count, float *ctx);
+
+        static inline void biquad_process_mc_interleaved(float *dst, const float *src, float *d, size_t count, const float *f, size_t lanes, size_t n,
+            biquad_mc8_core_t core)
+        {
+            float ctx[BIQUAD_MC8_CTX_SIZE] __lsp_aligned32;
+
+            for (size_t k=0; k<n; ++k, src = dst)
+            {
+                for (size_t j=0; j<lanes; j += 8)
+                {
+                    biquad_mc8_ctx_load(ctx, &f[j], &d[j], lanes);
+                    core(&dst[j], &src[j], count, lanes * sizeof(float), ctx);
+                    biquad_mc8_ctx_store(&d[j], ctx, lanes);
+                }
+
+                f              += lanes * 5;
+                d              += lanes * 2;
+            }
+        }
+
+        static inline void biquad_process_mc_planar(float * const *dst, const float * const *src, float *d, size_t count, const float *f, size_t lanes, size_t n,
+            biquad_mc8_planar_core_t core)
+        {
+            float ctx[BIQUAD_MC8_CTX_SIZE] __lsp_aligned32;
+
+            for (size_t k=0; k<n; ++k, src = dst)
+            {
+                for (size_t j=0; j<lanes; j += 8)
+                {
+                    biquad_mc8_ctx_load(ctx, &f[j], &d[j], lanes);
+                    core(&dst[j], &src[j], count, ctx);
+                    biquad_mc8_ctx_store(&d[j], ctx, lanes);
+                }
+
+                f              += lanes * 5;
+                d              += lanes * 2;
+            }
+        }
+
+        void biquad_process_mc8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n)
+        {
+            biquad_process_mc_interleaved(dst, src, d, count, f->b0, 8, n, biquad_mc8_core);
+        }
+
+        void biquad_process_mc8_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n)
+        {
+            biquad_process_mc_interleaved(dst, src, d, count, f->b0, 8, n, biquad_mc8_core_fma3);
+        }
+
+        void biquad_process_mc16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n)
+        {
+            biquad_process_mc_interleaved(dst, src, d, count, f->b0, 16, n, biquad_mc8_core);
+        }
+
+        void biquad_process_mc16_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n)
+        {
+            biquad_process_mc_interleaved(dst, src, d, count, f->b0, 16, n, biquad_mc8_core_fma3);
+        }
+
+        void biquad_process_mc8_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n)
+        {
+            biquad_process_mc_planar(dst, src, d, count, f->b0, 8, n, biquad_mc8_planar_core);
+        }
+
+        void biquad_process_mc8_planar_fma3(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n)
+        {
+            biquad_process_mc_planar(dst, src, d, count, f->b0, 8, n, biquad_mc8_planar_core_fma3);
+        }
+
+        void biquad_process_mc16_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n)
+        {
+            biquad_process_mc_planar(dst, src, d, count, f->b0, 16, n, biquad_mc8_planar_core);
+        }
+
+        void biquad_process_mc16_planar_fma3(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n)
+        {
+            biquad_process_mc_planar(dst, src, d, count, f->b0, 16, n, biquad_mc8_planar_core_fma3);
+        }
+    } /* namespace avx */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_FILTERS_MULTICHANNEL_H_ */
@@ -778,6 +778,185 @@ namespace lsp
                   "%xmm4", "%xmm5", "%xmm6", "%xmm7"
             );
         }
+
+        #define FMA_OFF(a, b)       a
+        #define FMA_ON(a, b)        b
+
+        /*
+         * The half of x16 filter bank is processed as x8 filter bank with
+         * the stride of coefficients equal to 16 floats:
+         *   d      - delay buffer of the half (d0 at +0x00, d1 at +0x40)
+         *   f      - coefficients of the half (b0 at +0x00, b1 at +0x40, b2 at +0x80, a1 at +0xc0, a2 at +0x100)
+         *   step   - the step of the coefficient pointer after each processed sample
+         *            (0 for static filters, the size of x16 filter bank for dynamic filters)
+         */
+        #define BIQUAD_X16_HALF_STEP(SEL) \
+            __ASM_EMIT("vmulps              0x40(%[f]), %%ymm1, %%ymm2")                                    /* ymm2     = s*a1 */ \
+            __ASM_EMIT("vmulps              0x80(%[f]), %%ymm1, %%ymm3")                                    /* ymm3     = s*a2 */ \
+            __ASM_EMIT(SEL("vmulps          0x00(%[f]), %%ymm1, %%ymm1", "vfmadd132ps 0x00(%[f]), %%ymm6, %%ymm1"))    /* ymm1     = s*a0+d0 = s2 */ \
+            __ASM_EMIT(SEL("vaddps          %%ymm6, %%ymm1, %%ymm1", "")) \
+            __ASM_EMIT(SEL("vmulps          0xc0(%[f]), %%ymm1, %%ymm4", "vfmadd231ps 0xc0(%[f]), %%ymm1, %%ymm2"))    /* ymm2     = s*a1 + s2*b1 = p1 */ \
+            __ASM_EMIT(SEL("vaddps          %%ymm4, %%ymm2, %%ymm2", "")) \
+            __ASM_EMIT(SEL("vmulps          0x100(%[f]), %%ymm1, %%ymm4", "vfmadd231ps 0x100(%[f]), %%ymm1, %%ymm3"))  /* ymm3     = s*a2 + s2*b2 = p2 */ \
+            __ASM_EMIT(SEL("vaddps          %%ymm4, %%ymm3, %%ymm3", ""))
+
+        #define BIQUAD_X16_HALF_CORE(SEL) \
+            /* Check count */ \
+            __ASM_EMIT64("test              %[count], %[count]") \
+            __ASM_EMIT32("cmpl              $0, %[count]") \
+            __ASM_EMIT("jz                  8f") \
+            \
+            /* Initialize mask */ \
+            /* ymm0=tmp, ymm1={s,s2[8]}, ymm2=p1[8], ymm3=p2[8], ymm6=d0[8], ymm7=d1[8], ymm5=mask[8] */ \
+            __ASM_EMIT("mov                 $1, %[mask]") \
+            __ASM_EMIT("vmovaps             %[X_MASK], %%ymm5")                                 /* ymm5     = m */ \
+            __ASM_EMIT("vxorps              %%ymm1, %%ymm1, %%ymm1")                            /* ymm1     = 0 */ \
+            \
+            /* Load delay buffer */ \
+            __ASM_EMIT("vmovups             0x00(%[d]), %%ymm6")                                /* ymm6     = d0 */ \
+            __ASM_EMIT("vmovups             0x40(%[d]), %%ymm7")                                /* ymm7     = d1 */ \
+            \
+            /* Process first 7 steps */ \
+            __ASM_EMIT("1:") \
+            __ASM_EMIT("vmovss              (%[src]), %%xmm0")                                  /* xmm0     = *src */ \
+            __ASM_EMIT("add                 $4, %[src]")                                        /* src      ++ */ \
+            __ASM_EMIT("vblendps            $0x01, %%ymm0, %%ymm1, %%ymm1")                     /* ymm1     = s */ \
+            BIQUAD_X16_HALF_STEP(SEL) \
+            __ASM_EMIT("vaddps              %%ymm7, %%ymm2, %%ymm2")                            /* ymm2     = p1 + d1 */ \
+            /* Update delay only by mask */ \
+            __ASM_EMIT("vblendvps           %%ymm5, %%ymm2, %%ymm6, %%ymm6")                    /* ymm6     = (p1 + d1) & MASK | (d0 & ~MASK) */ \
+            __ASM_EMIT("vblendvps           %%ymm5, %%ymm3, %%ymm7, %%ymm7")                    /* ymm7     = (p2 & MASK) | (d1 & ~MASK) */ \
+            /* Rotate buffer */ \
+            __ASM_EMIT("vpermilps           $0x93, %%ymm1, %%ymm1")                             /* ymm1     = s2[3] s2[0] s2[1] s2[2] s2[7] s2[4] s2[5] s2[6] */ \
+            __ASM_EMIT("vperm2f128          $0x01, %%ymm1, %%ymm1, %%ymm0")                     /* ymm0     = s2[7] s2[4] s2[5] s2[6] s2[3] s2[0] s2[1] s2[2] */ \
+            __ASM_EMIT("vblendps            $0x11, %%ymm0, %%ymm1, %%ymm1")                     /* ymm1     = s2[7] s2[0] s2[1] s2[2] s2[3] s2[4] s2[5] s2[6] */ \
+            /* Repeat loop */ \
+            __ASM_EMIT("add                 %[step], %[f]")                                     /* f       += step */ \
+            __ASM_EMIT64("dec               %[count]") \
+            __ASM_EMIT32("decl              %[count]") \
+            __ASM_EMIT("jz                  4f")                                                /* jump to completion */ \
+            __ASM_EMIT("lea                 0x01(,%[mask], 2), %[mask]")                        /* mask     = (mask << 1) | 1 */ \
+            __ASM_EMIT("vpermilps           $0x93, %%ymm5, %%ymm5")                             /* ymm5     =  m[3]  m[0]  m[1]  m[2]  m[7]  m[4]  m[5]  m[6] */ \
+            __ASM_EMIT("vperm2f128          $0x01, %%ymm5, %%ymm5, %%ymm3")                     /* ymm3     =  m[7]  m[4]  m[5]  m[6]  m[3]  m[0]  m[1]  m[2] */ \
+            __ASM_EMIT("vblendps            $0x11, %%ymm3, %%ymm5, %%ymm5")                     /* ymm5     =  m[7]  m[0]  m[1]  m[2]  m[3]  m[4]  m[5]  m[6] */ \
+            __ASM_EMIT("vorps               %[X_MASK], %%ymm5, %%ymm5")                         /* ymm5     =  m[0]  m[0]  m[1]  m[2]  m[3]  m[4]  m[5]  m[6] */ \
+            __ASM_EMIT("cmp                 $0xff, %[mask]") \
+            __ASM_EMIT("jne                 1b") \
+            \
+            /* 8x filter processing without mask */ \
+            __ASM_EMIT(".align 16") \
+            __ASM_EMIT("3:") \
+            __ASM_EMIT("vmovss              (%[src]), %%xmm0")                                  /* xmm0     = *src */ \
+            __ASM_EMIT("add                 $4, %[src]")                                        /* src      ++ */ \
+            __ASM_EMIT("vblendps            $0x01, %%ymm0, %%ymm1, %%ymm1")                     /* ymm1     = s */ \
+            BIQUAD_X16_HALF_STEP(SEL) \
+            __ASM_EMIT("vaddps              %%ymm7, %%ymm2, %%ymm6")                            /* ymm6     = p1 + d1 */ \
+            __ASM_EMIT("vmovaps             %%ymm3, %%ymm7")                                    /* ymm7     = p2 */ \
+            /* Rotate buffer */ \
+            __ASM_EMIT("vpermilps           $0x93, %%ymm1, %%ymm1")                             /* ymm1     = s2[3] s2[0] s2[1] s2[2] s2[7] s2[4] s2[5] s2[6] */ \
+            __ASM_EMIT("vperm2f128          $0x01, %%ymm1, %%ymm1, %%ymm0")                     /* ymm0     = s2[7] s2[4] s2[5] s2[6] s2[3] s2[0] s2[1] s2[2] */ \
+            __ASM_EMIT("vblendps            $0x11, %%ymm0, %%ymm1, %%ymm1")                     /* ymm1     = s2[7] s2[0] s2[1] s2[2] s2[3] s2[4] s2[5] s2[6] */ \
+            __ASM_EMIT("vmovss              %%xmm1, (%[dst])")                                  /* *dst     = s2[7] */ \
+            /* Repeat loop */ \
+            __ASM_EMIT("add                 %[step], %[f]")                                     /* f       += step */ \
+            __ASM_EMIT("add                 $4, %[dst]")                                        /* dst      ++ */ \
+            __ASM_EMIT64("dec               %[count]") \
+            __ASM_EMIT32("decl              %[count]") \
+            __ASM_EMIT("jnz                 3b") \
+            \
+            /* Prepare last loop, shift mask */ \
+            __ASM_EMIT("4:") \
+            __ASM_EMIT("vxorps              %%ymm2, %%ymm2, %%ymm2")                            /* ymm2     =  0 */ \
+            __ASM_EMIT("vpermilps           $0x93, %%ymm5, %%ymm5")                             /* ymm5     =  m[3]  m[0]  m[1]  m[2]  m[7]  m[4]  m[5]  m[6] */ \
+            __ASM_EMIT("vinsertf128         $0x01, %%xmm5, %%ymm2, %%ymm2")                     /* ymm2     =  0     0     0     0     m[3]  m[0]  m[1]  m[2] */ \
+            __ASM_EMIT("vblendps            $0x11, %%ymm2, %%ymm5, %%ymm5")                     /* ymm5     =  0     m[0]  m[1]  m[2]  m[3]  m[4]  m[5]  m[6] */ \
+            __ASM_EMIT("shl                 $1, %[mask]")                                       /* mask     = mask << 1 */ \
+            \
+            /* Process steps */ \
+            __ASM_EMIT("5:") \
+            BIQUAD_X16_HALF_STEP(SEL) \
+            __ASM_EMIT("vaddps              %%ymm7, %%ymm2, %%ymm2")                            /* ymm2     = p1 + d1 */ \
+            /* Update delay only by mask */ \
+            __ASM_EMIT("vblendvps           %%ymm5, %%ymm2, %%ymm6, %%ymm6")                    /* ymm6     = (p1 + d1) & MASK | (d0 & ~MASK) */ \
+            __ASM_EMIT("vblendvps           %%ymm5, %%ymm3, %%ymm7, %%ymm7")                    /* ymm7     = (p2 & MASK) | (d1 & ~MASK) */ \
+            /* Rotate buffer and mask */ \
+            __ASM_EMIT("add                 %[step], %[f]")                                     /* f       += step */ \
+            __ASM_EMIT("vpermilps           $0x93, %%ymm1, %%ymm1")                             /* ymm1     = s2[3] s2[0] s2[1] s2[2] s2[7] s2[4] s2[5] s2[6] */ \
+            __ASM_EMIT("vpermilps           $0x93, %%ymm5, %%ymm5")                             /* ymm5     =  m[3]  m[0]  m[1]  m[2]  m[7]  m[4]  m[5]  m[6] */ \
+            __ASM_EMIT("vperm2f128          $0x01, %%ymm1, %%ymm1, %%ymm0")                     /* ymm0     = s2[7] s2[4] s2[5] s2[6] s2[3] s2[0] s2[1] s2[2] */ \
+            __ASM_EMIT("vxorps              %%ymm2, %%ymm2, %%ymm2")                            /* ymm2     =  0 */ \
+            __ASM_EMIT("vblendps            $0x11, %%ymm0, %%ymm1, %%ymm1")                     /* ymm1     = s2[7] s2[0] s2[1] s2[2] s2[3] s2[4] s2[5] s2[6] */ \
+            __ASM_EMIT("vinsertf128         $0x01, %%xmm5, %%ymm2, %%ymm2")                     /* ymm2     =  0     0     0     0     m[3]  m[0]  m[1]  m[2] */ \
+            __ASM_EMIT("vblendps            $0x11, %%ymm2, %%ymm5, %%ymm5")                     /* ymm5     =  0     m[0]  m[1]  m[2]  m[3]  m[4]  m[5]  m[6] */ \
+            __ASM_EMIT("test                $0x80, %[mask]") \
+            __ASM_EMIT("jz                  6f") \
+            __ASM_EMIT("vmovss              %%xmm1, (%[dst])")                                  /* *dst     = s2[7] */ \
+            __ASM_EMIT("add                 $4, %[dst]")                                        /* dst      ++ */ \
+            __ASM_EMIT("6:") \
+            /* Repeat loop */ \
+            __ASM_EMIT("shl                 $1, %[mask]")                                       /* mask     = mask << 1 */ \
+            __ASM_EMIT("and                 $0xff, %[mask]")                                    /* mask     = (mask << 1) & 0xff */ \
+            __ASM_EMIT("jnz                 5b")                                                /* check that mask is not zero */ \
+            \
+            /* Store delay buffer */ \
+            __ASM_EMIT("vmovups             %%ymm6, 0x00(%[d])")                                /* *d0      = %%ymm6 */ \
+            __ASM_EMIT("vmovups             %%ymm7, 0x40(%[d])")                                /* *d1      = %%ymm7 */ \
+            \
+            /* Exit label */ \
+            __ASM_EMIT("8:")
+
+        static void biquad_process_x16_half(float *dst, const float *src, size_t count, float *d, const float *f, size_t step)
+        {
+            IF_ARCH_X86(size_t mask);
+            ARCH_X86_ASM
+            (
+                BIQUAD_X16_HALF_CORE(FMA_OFF)
+                : [dst] "+r" (dst), [src] "+r" (src), [f] "+r" (f),
+                  [mask] "=&r"(mask),
+                  [count] X86_PGREG (count)
+                : [d] "r" (d), [step] "m" (step),
+                  [X_MASK] "m" (biquad_x8_mask)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+            );
+        }
+
+        static void biquad_process_x16_half_fma3(float *dst, const float *src, size_t count, float *d, const float *f, size_t step)
+        {
+            IF_ARCH_X86(size_t mask);
+            ARCH_X86_ASM
+            (
+                BIQUAD_X16_HALF_CORE(FMA_ON)
+                : [dst] "+r" (dst), [src] "+r" (src), [f] "+r" (f),
+                  [mask] "=&r"(mask),
+                  [count] X86_PGREG (count)
+                : [d] "r" (d), [step] "m" (step),
+                  [X_MASK] "m" (biquad_x8_mask)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+            );
+        }
+
+        #undef BIQUAD_X16_HALF_CORE
+        #undef BIQUAD_X16_HALF_STEP
+        #undef FMA_OFF
+        #undef FMA_ON
+
+        void biquad_process_x16(float *dst, const float *src, size_t count, dsp::biquad16_t *f)
+        {
+            // Process as two x8 filter banks, the second one takes the output of the first one
+            biquad_process_x16_half(dst, src, count, &f->d[0], &f->x16.b0[0], 0);
+            biquad_process_x16_half(dst, dst, count, &f->d[8], &f->x16.b0[8], 0);
+        }
+
+        void biquad_process_x16_fma3(float *dst, const float *src, size_t count, dsp::biquad16_t *f)
+        {
+            // Process as two x8 filter banks, the second one takes the output of the first one
+            biquad_process_x16_half_fma3(dst, src, count, &f->d[0], &f->x16.b0[0], 0);
+            biquad_process_x16_half_fma3(dst, dst, count, &f->d[8], &f->x16.b0[8], 0);
+        }
     }
 }
 
@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_GOERTZEL_H_
+#define PRIVATE_DSP_ARCH_X86_AVX_GOERTZEL_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_IMPL */
+
+namespace lsp
+{
+    namespace avx
+    {
+        /*
+         * The bins are processed by groups, the state of the group is kept in registers
+         * while all samples are processed. The sample is broadcasted to all lanes.
+         */
+        void goertzel_bank(float *state, const float *coef, const float *src, size_t bins, size_t count)
+        {
+            float *s1       = state;
+            float *s2       = &state[bins];
+            size_t i        = 0;
+
+            if (count == 0)
+                return;
+
+            // 16 bins
+            for ( ; (i + 16) <= bins; i += 16)
+            {
+                const float *x  = src;
+                size_t n        = count;
+
+                ARCH_X86_ASM
+                (
+                    __ASM_EMIT("vmovups         0x00(%[s1]), %%ymm0")               // ymm0 = a
+                    __ASM_EMIT("vmovups         0x20(%[s1]), %%ymm1")
+                    __ASM_EMIT("vmovups         0x00(%[s2]), %%ymm2")               // ymm2 = b
+                    __ASM_EMIT("vmovups         0x20(%[s2]), %%ymm3")
+                    __ASM_EMIT("vmovups         0x00(%[k]), %%ymm4")                // ymm4 = k
+                    __ASM_EMIT("vmovups         0x20(%[k]), %%ymm5")
+                    __ASM_EMIT("1:")
+                    __ASM_EMIT("vbroadcastss    (%[x]), %%ymm7")                    // ymm7 = x
+                    __ASM_EMIT("vsubps          %%ymm2, %%ymm7, %%ymm6")            // ymm6 = x - b
+                    __ASM_EMIT("vsubps          %%ymm3, %%ymm7, %%ymm7")
+                    __ASM_EMIT("vmovaps         %%ymm0, %%ymm2")                    // ymm2 = b' = a
+                    __ASM_EMIT("vmovaps         %%ymm1, %%ymm3")
+                    __ASM_EMIT("vmulps          %%ymm4, %%ymm0, %%ymm0")            // ymm0 = k*a
+                    __ASM_EMIT("vmulps          %%ymm5, %%ymm1, %%ymm1")
+                    __ASM_EMIT("add             $0x04, %[x]")
+                    __ASM_EMIT("vaddps          %%ymm6, %%ymm0, %%ymm0")            // ymm0 = a' = x - b + k*a
+                    __ASM_EMIT("vaddps          %%ymm7, %%ymm1, %%ymm1")
+                    __ASM_EMIT32("decl          %[n]")
+                    __ASM_EMIT64("dec           %[n]")
+                    __ASM_EMIT("jnz             1b")
+                    __ASM_EMIT("vmovups         %%ymm0, 0x00(%[s1])")
+                    __ASM_EMIT("vmovups         %%ymm1, 0x20(%[s1])")
+                    __ASM_EMIT("vmovups         %%ymm2, 0x00(%[s2])")
+                    __ASM_EMIT("vmovups         %%ymm3, 0x20(%[s2])")
+                    : [x] "+r" (x), [n] X86_PGREG (n)
+                    : [s1] "r" (&s1[i]), [s2] "r" (&s2[i]), [k] "r" (&coef[i])
+                    : "cc", "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                      "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+                );
+            }
+
+            // 8 bins
+            if ((i + 8) <= bins)
+            {
+                const float *x  = src;
+                size_t n        = count;
+
+                ARCH_X86_ASM
+                (
+                    __ASM_EMIT("vmovups         0x00(%[s1]), %%ymm0")               // ymm0 = a
+                    __ASM_EMIT("vmovups         0x00(%[s2]), %%ymm2")               // ymm2 = b
+                    __ASM_EMIT("vmovups         0x00(%[k]), %%ymm4")                // ymm4 = k
+                    __ASM_EMIT("1:")
+                    __ASM_EMIT("vbroadcastss    (%[x]), %%ymm6")                    // ymm6 = x
+                    __ASM_EMIT("vsubps          %%ymm2, %%ymm6, %%ymm6")            // ymm6 = x - b
+                    __ASM_EMIT("vmovaps         %%ymm0, %%ymm2")                    // ymm2 = b' = a
+                    __ASM_EMIT("vmulps          %%ymm4, %%ymm0, %%ymm0")            // ymm0 = k*a
+                    __ASM_EMIT("add             $0x04, %[x]")
+                    __ASM_EMIT("vaddps          %%ymm6, %%ymm0, %%ymm0")            // ymm0 = a' = x - b + k*a
+                    __ASM_EMIT32("decl          %[n]")
+                    __ASM_EMIT64("dec           %[n]")
+                    __ASM_EMIT("jnz             1b")
+                    __ASM_EMIT("vmovups         %%ymm0, 0x00(%[s1])")
+                    __ASM_EMIT("vmovups         %%ymm2, 0x00(%[s2])")
+                    : [x] "+r" (x), [n] X86_PGREG (n)
+                    : [s1] "r" (&s1[i]), [s2] "r" (&s2[i]), [k] "r" (&coef[i])
+                    : "cc", "memory",
+                      "%xmm0", "%xmm2", "%xmm4", "%xmm6"
+                );
+                i += 8;
+            }
+
+            // 4 bins
+            if ((i + 4) <= bins)
+            {
+                const float *x  = src;
+                size_t n        = count;
+
+                ARCH_X86_ASM
+                (
+                    __ASM_EMIT("vmovups         0x00(%[s1]), %%xmm0")               // xmm0 = a
+                    __ASM_EMIT("vmovups         0x00(%[s2]), %%xmm2")               // xmm2 = b
+                    __ASM_EMIT("vmovups         0x00(%[k]), %%xmm4")                // xmm4 = k
+                    __ASM_EMIT("1:")
+                    __ASM_EMIT("vbroadcastss    (%[x]), %%xmm6")                    // xmm6 = x
+                    __ASM_EMIT("vsubps          %%xmm2, %%xmm6, %%xmm6")            // xmm6 = x - b
+                    __ASM_EMIT("vmovaps         %%xmm0, %%xmm2")                    // xmm2 = b' = a
+                    __ASM_EMIT("vmulps          %%xmm4, %%xmm0, %%xmm0")            // xmm0 = k*a
+                    __ASM_EMIT("add             $0x04, %[x]")
+                    __ASM_EMIT("vaddps          %%xmm6, %%xmm0, %%xmm0")            // xmm0 = a' = x - b + k*a
+                    __ASM_EMIT32("decl          %[n]")
+                    __ASM_EMIT64("dec           %[n]")
+                    __ASM_EMIT("jnz             1b")
+                    __ASM_EMIT("vmovups         %%xmm0, 0x00(%[s1])")
+                    __ASM_EMIT("vmovups         %%xmm2, 0x00(%[s2])")
+                    : [x] "+r" (x), [n] X86_PGREG (n)
+                    : [s1] "r" (&s1[i]), [s2] "r" (&s2[i]), [k] "r" (&coef[i])
+                    : "cc", "memory",
+                      "%xmm0", "%xmm2", "%xmm4", "%xmm6"
+                );
+                i += 4;
+            }
+
+            // Remaining bins
+            for ( ; i < bins; ++i)
+            {
+                float a         = s1[i];
+                float b         = s2[i];
+                const float k   = coef[i];
+
+                for (size_t j=0; j<count; ++j)
+                {
+                    float c         = src[j] - b + k * a;
+                    b               = a;
+                    a               = c;
+                }
+
+                s1[i]           = a;
+                s2[i]           = b;
+            }
+        }
+
+        #define SDFT_BANK_BODY(R) \
+            __ASM_EMIT("vmovaps         0x00(%[c]), %%" R "0")                      /* r0 = sr */ \
+            __ASM_EMIT("vmovaps         0x20(%[c]), %%" R "1")                      /* r1 = si */ \
+            __ASM_EMIT("1:") \
+            __ASM_EMIT("vbroadcastss    (%[o]), %%" R "2")                          /* r2 = o */ \
+            __ASM_EMIT("vbroadcastss    (%[x]), %%" R "3")                          /* r3 = x */ \
+            __ASM_EMIT("vmulps          0x80(%[c]), %%" R "2, %%" R "4")            /* r4 = znr*o */ \
+            __ASM_EMIT("vmulps          0xa0(%[c]), %%" R "2, %%" R "5")            /* r5 = zni*o */ \
+            __ASM_EMIT("vsubps          %%" R "4, %%" R "3, %%" R "3")              /* r3 = x - znr*o */ \
+            __ASM_EMIT("vsubps          %%" R "5, %%" R "1, %%" R "1")              /* r1 = ti = si - zni*o */ \
+            __ASM_EMIT("vaddps          %%" R "3, %%" R "0, %%" R "0")              /* r0 = tr = sr + x - znr*o */ \
+            __ASM_EMIT("vmulps          0x40(%[c]), %%" R "0, %%" R "2")            /* r2 = zr*tr */ \
+            __ASM_EMIT("vmulps          0x60(%[c]), %%" R "1, %%" R "3")            /* r3 = zi*ti */ \
+            __ASM_EMIT("vmulps          0x60(%[c]), %%" R "0, %%" R "4")            /* r4 = zi*tr */ \
+            __ASM_EMIT("vmulps          0x40(%[c]), %%" R "1, %%" R "5")            /* r5 = zr*ti */ \
+            __ASM_EMIT("add             $0x04, %[x]") \
+            __ASM_EMIT("add             $0x04, %[o]") \
+            __ASM_EMIT("vsubps          %%" R "3, %%" R "2, %%" R "0")              /* r0 = sr' = zr*tr - zi*ti */ \
+            __ASM_EMIT("vaddps          %%" R "4, %%" R "5, %%" R "1")              /* r1 = si' = zr*ti + zi*tr */ \
+            __ASM_EMIT32("decl          %[n]") \
+            __ASM_EMIT64("dec           %[n]") \
+            __ASM_EMIT("jnz             1b") \
+            __ASM_EMIT("vmovaps         %%" R "0, 0x00(%[c])") \
+            __ASM_EMIT("vmovaps         %%" R "1, 0x20(%[c])")
+
+        /*
+         * The group of 8 or 4 bins is kept in registers, the rotation factors are
+         * copied to the aligned buffer and used as memory operands.
+         */
+        void sdft_bank(float *state, const float *coef, const float *src, const float *old, size_t bins, size_t count)
+        {
+            float c[48] __lsp_aligned32;
+            float *s_re         = state;
+            float *s_im         = &state[bins];
+            const float *z_re   = coef;
+            const float *z_im   = &coef[bins];
+            const float *zn_re  = &coef[bins*2];
+            const float *zn_im  = &coef[bins*3];
+            size_t i            = 0;
+
+            if (count == 0)
+                return;
+
+            for ( ; i < bins; )
+            {
+                const size_t lanes  = ((i + 8) <= bins) ? 8 : 4;
+                if ((i + lanes) > bins)
+                    break;
+
+                for (size_t j=0; j<lanes; ++j)
+                {
+                    c[j]            = s_re[i + j];
+                    c[j + 8]        = s_im[i + j];
+                    c[j + 16]       = z_re[i + j];
+                    c[j + 24]       = z_im[i + j];
+                    c[j + 32]       = zn_re[i + j];
+                    c[j + 40]       = zn_im[i + j];
+                }
+
+                const float *x  = src;
+                const float *o  = old;
+                size_t n        = count;
+
+                if (lanes == 8)
+                {
+                    ARCH_X86_ASM
+                    (
+                        SDFT_BANK_BODY("ymm")
+                        : [x] "+r" (x), [o] "+r" (o), [n] X86_PGREG (n)
+                        : [c] "r" (c)
+                        : "cc", "memory",
+                          "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                          "%xmm4", "%xmm5"
+                    );
+                }
+                else
+                {
+                    ARCH_X86_ASM
+                    (
+                        SDFT_BANK_BODY("xmm")
+                        : [x] "+r" (x), [o] "+r" (o), [n] X86_PGREG (n)
+                        : [c] "r" (c)
+                        : "cc", "memory",
+                          "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                          "%xmm4", "%xmm5"
+                    );
+                }
+
+                for (size_t j=0; j<lanes; ++j)
+                {
+                    s_re[i + j]     = c[j];
+                    s_im[i + j]     = c[j + 8];
+                }
+                i              += lanes;
+            }
+
+            // Remaining bins
+            for ( ; i < bins; ++i)
+            {
+                float a_re      = s_re[i];
+                float a_im      = s_im[i];
+
+                for (size_t j=0; j<count; ++j)
+                {
+                    float t_re      = a_re + (src[j] - zn_re[i] * old[j]);
+                    float t_im      = a_im - zn_im[i] * old[j];
+                    a_re            = z_re[i] * t_re - z_im[i] * t_im;
+                    a_im            = z_re[i] * t_im + z_im[i] * t_re;
+                }
+
+                s_re[i]         = a_re;
+                s_im[i]         = a_im;
+            }
+        }
+
+        #undef SDFT_BANK_BODY
+    } /* namespace avx */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_GOERTZEL_H_ */
@@ -91,8 +91,8 @@ namespace lsp
                 __ASM_EMIT("vmovups         %%xmm0, 0x00(%[mid], %[off])")
                 __ASM_EMIT("vmovups         %%xmm2, 0x00(%[side], %[off])")
                 __ASM_EMIT("add             $0x10, %[off]")
-                __ASM_EMIT32("subl          $8, %[count]")
-                __ASM_EMIT64("sub           $8, %[count]")
+                __ASM_EMIT32("subl          $4, %[count]")
+                __ASM_EMIT64("sub           $4, %[count]")
                 __ASM_EMIT("6:")
                 // 1x blocks
                 __ASM_EMIT32("addl          $3, %[count]")
@@ -633,6 +633,96 @@ namespace lsp
 
         #undef PCOMPLEX_RCP_CORE
 
+        #define PCOMPLEX_MODARG_FAST_CORE(SEL) \
+            /* x8 blocks */ \
+            __ASM_EMIT32("subl          $8, %[count]") \
+            __ASM_EMIT64("sub           $8, %[count]") \
+            __ASM_EMIT  ("jb            2f") \
+            __ASM_EMIT  ("1:") \
+            __ASM_EMIT  ("vmovups       0x00(%[src]), %%xmm0")                              /* xmm0 = r0 i0 r1 i1 */ \
+            __ASM_EMIT  ("vmovups       0x10(%[src]), %%xmm2")                              /* xmm2 = r2 i2 r3 i3 */ \
+            __ASM_EMIT  ("vinsertf128   $1, 0x20(%[src]), %%ymm0, %%ymm0")                  /* ymm0 = r0 i0 r1 i1 r4 i4 r5 i5 */ \
+            __ASM_EMIT  ("vinsertf128   $1, 0x30(%[src]), %%ymm2, %%ymm2")                  /* ymm2 = r2 i2 r3 i3 r6 i6 r7 i7 */ \
+            __ASM_EMIT  ("vshufps       $0xdd, %%ymm2, %%ymm0, %%ymm1")                     /* ymm1 = i0 i1 i2 i3 i4 i5 i6 i7 */ \
+            __ASM_EMIT  ("vshufps       $0x88, %%ymm2, %%ymm0, %%ymm0")                     /* ymm0 = r0 r1 r2 r3 r4 r5 r6 r7 */ \
+            COMPLEX_MOD_FAST_CORE("ymm", SEL) \
+            COMPLEX_ATAN2_FAST_CORE("ymm", SEL) \
+            __ASM_EMIT  ("vmovups       %%ymm6, 0x00(%[mod])") \
+            __ASM_EMIT  ("vmovups       %%ymm0, 0x00(%[arg])") \
+            __ASM_EMIT  ("add           $0x40, %[src]") \
+            __ASM_EMIT  ("add           $0x20, %[mod]") \
+            __ASM_EMIT  ("add           $0x20, %[arg]") \
+            __ASM_EMIT32("subl          $8, %[count]") \
+            __ASM_EMIT64("sub           $8, %[count]") \
+            __ASM_EMIT  ("jae           1b") \
+            __ASM_EMIT  ("2:") \
+            /* x4 block */ \
+            __ASM_EMIT32("addl          $4, %[count]") \
+            __ASM_EMIT64("add           $4, %[count]") \
+            __ASM_EMIT  ("jl            4f") \
+            __ASM_EMIT  ("vmovups       0x00(%[src]), %%xmm0")                              /* xmm0 = r0 i0 r1 i1 */ \
+            __ASM_EMIT  ("vmovups       0x10(%[src]), %%xmm2")                              /* xmm2 = r2 i2 r3 i3 */ \
+            __ASM_EMIT  ("vshufps       $0xdd, %%xmm2, %%xmm0, %%xmm1")                     /* xmm1 = i0 i1 i2 i3 */ \
+            __ASM_EMIT  ("vshufps       $0x88, %%xmm2, %%xmm0, %%xmm0")                     /* xmm0 = r0 r1 r2 r3 */ \
+            COMPLEX_MOD_FAST_CORE("xmm", SEL) \
+            COMPLEX_ATAN2_FAST_CORE("xmm", SEL) \
+            __ASM_EMIT  ("vmovups       %%xmm6, 0x00(%[mod])") \
+            __ASM_EMIT  ("vmovups       %%xmm0, 0x00(%[arg])") \
+            __ASM_EMIT  ("add           $0x20, %[src]") \
+            __ASM_EMIT  ("add           $0x10, %[mod]") \
+            __ASM_EMIT  ("add           $0x10, %[arg]") \
+            __ASM_EMIT32("subl          $4, %[count]") \
+            __ASM_EMIT64("sub           $4, %[count]") \
+            __ASM_EMIT  ("4:") \
+            /* x1 blocks */ \
+            __ASM_EMIT32("addl          $3, %[count]") \
+            __ASM_EMIT64("add           $3, %[count]") \
+            __ASM_EMIT  ("jl            6f") \
+            __ASM_EMIT  ("5:") \
+            __ASM_EMIT  ("vmovss        0x00(%[src]), %%xmm0")                              /* xmm0 = r */ \
+            __ASM_EMIT  ("vmovss        0x04(%[src]), %%xmm1")                              /* xmm1 = i */ \
+            COMPLEX_MOD_FAST_CORE("xmm", SEL) \
+            COMPLEX_ATAN2_FAST_CORE("xmm", SEL) \
+            __ASM_EMIT  ("vmovss        %%xmm6, 0x00(%[mod])") \
+            __ASM_EMIT  ("vmovss        %%xmm0, 0x00(%[arg])") \
+            __ASM_EMIT  ("add           $0x08, %[src]") \
+            __ASM_EMIT  ("add           $0x04, %[mod]") \
+            __ASM_EMIT  ("add           $0x04, %[arg]") \
+            __ASM_EMIT32("decl          %[count]") \
+            __ASM_EMIT64("dec           %[count]") \
+            __ASM_EMIT  ("jge           5b") \
+            __ASM_EMIT  ("6:")
+
+        void pcomplex_modarg_fast(float *mod, float *arg, const float *src, size_t count)
+        {
+            ARCH_X86_ASM
+            (
+                PCOMPLEX_MODARG_FAST_CORE(FMA_OFF)
+                : [mod] "+r" (mod), [arg] "+r" (arg), [src] "+r" (src),
+                  [count] X86_PGREG (count)
+                : [CC] "o" (complex_atan2_const)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+            );
+        }
+
+        void pcomplex_modarg_fast_fma3(float *mod, float *arg, const float *src, size_t count)
+        {
+            ARCH_X86_ASM
+            (
+                PCOMPLEX_MODARG_FAST_CORE(FMA_ON)
+                : [mod] "+r" (mod), [arg] "+r" (arg), [src] "+r" (src),
+                  [count] X86_PGREG (count)
+                : [CC] "o" (complex_atan2_const)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+            );
+        }
+
+        #undef PCOMPLEX_MODARG_FAST_CORE
+
         #undef FMA_OFF
         #undef FMA_ON
 
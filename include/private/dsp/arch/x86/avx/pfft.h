@@ -29,11 +29,23 @@
 #include <private/dsp/arch/x86/avx/fft/const.h>
 #include <private/dsp/arch/x86/avx/fft/p_repack.h>
 #include <private/dsp/arch/x86/avx/fft/p_butterfly.h>
+#include <private/dsp/arch/x86/avx/fft/blocked.h>
 
 // Scrambling functions
+#define FFT_PSTART_DIRECT_NAME              packed_fft_start_direct
+#define FFT_PSTART_REVERSE_NAME             packed_fft_start_reverse
+#define FFT_FMA(a, b)                       a
+#include <private/dsp/arch/x86/avx/fft/p_start.h>
+
+#define FFT_PSTART_DIRECT_NAME              packed_fft_start_direct_fma3
+#define FFT_PSTART_REVERSE_NAME             packed_fft_start_reverse_fma3
+#define FFT_FMA(a, b)                       b
+#include <private/dsp/arch/x86/avx/fft/p_start.h>
+
 #define FFT_PSCRAMBLE_SELF_DIRECT_NAME      packed_scramble_self_direct8
 #define FFT_PSCRAMBLE_SELF_REVERSE_NAME     packed_scramble_self_reverse8
 #define FFT_PSCRAMBLE_COPY_DIRECT_NAME      packed_scramble_copy_direct8
+#define FFT_PSCRAMBLE_COPY_DIRECT_WINDOWED_NAME packed_scramble_copy_direct_windowed8
 #define FFT_PSCRAMBLE_COPY_REVERSE_NAME     packed_scramble_copy_reverse8
 #define FFT_TYPE                            uint8_t
 #define FFT_FMA(a, b)                       a
@@ -42,14 +54,25 @@
 #define FFT_PSCRAMBLE_SELF_DIRECT_NAME      packed_scramble_self_direct16
 #define FFT_PSCRAMBLE_SELF_REVERSE_NAME     packed_scramble_self_reverse16
 #define FFT_PSCRAMBLE_COPY_DIRECT_NAME      packed_scramble_copy_direct16
+#define FFT_PSCRAMBLE_COPY_DIRECT_WINDOWED_NAME packed_scramble_copy_direct_windowed16
 #define FFT_PSCRAMBLE_COPY_REVERSE_NAME     packed_scramble_copy_reverse16
 #define FFT_TYPE                            uint16_t
 #define FFT_FMA(a, b)                       a
 #include <private/dsp/arch/x86/avx/fft/p_scramble.h>
 
+#define FFT_PSCRAMBLE_SELF_DIRECT_NAME      packed_scramble_self_direct32
+#define FFT_PSCRAMBLE_SELF_REVERSE_NAME     packed_scramble_self_reverse32
+#define FFT_PSCRAMBLE_COPY_DIRECT_NAME      packed_scramble_copy_direct32
+#define FFT_PSCRAMBLE_COPY_DIRECT_WINDOWED_NAME packed_scramble_copy_direct_windowed32
+#define FFT_PSCRAMBLE_COPY_REVERSE_NAME     packed_scramble_copy_reverse32
+#define FFT_TYPE                            uint32_t
+#define FFT_FMA(a, b)                       a
+#include <private/dsp/arch/x86/avx/fft/p_scramble.h>
+
 #define FFT_PSCRAMBLE_SELF_DIRECT_NAME      packed_scramble_self_direct8_fma3
 #define FFT_PSCRAMBLE_SELF_REVERSE_NAME     packed_scramble_self_reverse8_fma3
 #define FFT_PSCRAMBLE_COPY_DIRECT_NAME      packed_scramble_copy_direct8_fma3
+#define FFT_PSCRAMBLE_COPY_DIRECT_WINDOWED_NAME packed_scramble_copy_direct_windowed8_fma3
 #define FFT_PSCRAMBLE_COPY_REVERSE_NAME     packed_scramble_copy_reverse8_fma3
 #define FFT_TYPE                            uint8_t
 #define FFT_FMA(a, b)                       b
@@ -58,11 +81,21 @@
 #define FFT_PSCRAMBLE_SELF_DIRECT_NAME      packed_scramble_self_direct16_fma3
 #define FFT_PSCRAMBLE_SELF_REVERSE_NAME     packed_scramble_self_reverse16_fma3
 #define FFT_PSCRAMBLE_COPY_DIRECT_NAME      packed_scramble_copy_direct16_fma3
+#define FFT_PSCRAMBLE_COPY_DIRECT_WINDOWED_NAME packed_scramble_copy_direct_windowed16_fma3
 #define FFT_PSCRAMBLE_COPY_REVERSE_NAME     packed_scramble_copy_reverse16_fma3
 #define FFT_TYPE                            uint16_t
 #define FFT_FMA(a, b)                       b
 #include <private/dsp/arch/x86/avx/fft/p_scramble.h>
 
+#define FFT_PSCRAMBLE_SELF_DIRECT_NAME      packed_scramble_self_direct32_fma3
+#define FFT_PSCRAMBLE_SELF_REVERSE_NAME     packed_scramble_self_reverse32_fma3
+#define FFT_PSCRAMBLE_COPY_DIRECT_NAME      packed_scramble_copy_direct32_fma3
+#define FFT_PSCRAMBLE_COPY_DIRECT_WINDOWED_NAME packed_scramble_copy_direct_windowed32_fma3
+#define FFT_PSCRAMBLE_COPY_REVERSE_NAME     packed_scramble_copy_reverse32_fma3
+#define FFT_TYPE                            uint32_t
+#define FFT_FMA(a, b)                       b
+#include <private/dsp/arch/x86/avx/fft/p_scramble.h>
+
 namespace lsp
 {
     namespace avx
@@ -165,8 +198,16 @@ namespace lsp
                 dsp::move(dst, src, 2 << rank); // 1 << rank + 1
                 if (rank <= 8)
                     packed_scramble_self_direct8(dst, rank);
-                else
+                else if (rank <= 16)
                     packed_scramble_self_direct16(dst, rank);
+                else
+                    packed_scramble_self_direct32(dst, rank);
+            }
+            else if (rank > FFT_LARGE_RANK)
+            {
+                packed_fft_large_transform(dst, src, rank, packed_scramble_self_direct16, packed_butterfly_direct8p, packed_butterfly_direct8p_x2);
+                packed_fft_repack(dst, rank);
+                return;
             }
             else
             {
@@ -176,8 +217,7 @@ namespace lsp
                     packed_scramble_copy_direct16(dst, src, rank-4);
             }
 
-            for (size_t i=3; i < rank; ++i)
-                packed_butterfly_direct8p(dst, i, 1 << (rank - i - 1));
+            packed_fft_butterfly_blocked(dst, 3, rank, packed_butterfly_direct8p, packed_butterfly_direct8p_x2);
 
             packed_fft_repack(dst, rank);
         }
@@ -195,8 +235,16 @@ namespace lsp
                 dsp::move(dst, src, 2 << rank); // 1 << rank + 1
                 if (rank <= 8)
                     packed_scramble_self_reverse8(dst, rank);
-                else
+                else if (rank <= 16)
                     packed_scramble_self_reverse16(dst, rank);
+                else
+                    packed_scramble_self_reverse32(dst, rank);
+            }
+            else if (rank > FFT_LARGE_RANK)
+            {
+                packed_fft_large_transform(dst, src, rank, packed_scramble_self_reverse16, packed_butterfly_reverse8p, packed_butterfly_reverse8p_x2);
+                packed_fft_repack_normalize(dst, rank);
+                return;
             }
             else
             {
@@ -206,12 +254,67 @@ namespace lsp
                     packed_scramble_copy_reverse16(dst, src, rank-4);
             }
 
-            for (size_t i=3; i < rank; ++i)
-                packed_butterfly_reverse8p(dst, i, 1 << (rank - i - 1));
+            packed_fft_butterfly_blocked(dst, 3, rank, packed_butterfly_reverse8p, packed_butterfly_reverse8p_x2);
 
             packed_fft_repack_normalize(dst, rank);
         }
 
+        void packed_direct_fft_windowed(float *dst, const float *src, const float *window, size_t rank)
+        {
+            // The in-place scramble swaps samples, so the window is applied by the separate pass
+            if ((dst == src) || (rank < 4))
+            {
+                if (dst != src)
+                    dsp::copy(dst, src, 2 << rank);
+                dsp::pcomplex_r2c_mul2(dst, window, 1 << rank);
+                packed_direct_fft(dst, dst, rank);
+                return;
+            }
+            else if (rank > FFT_LARGE_RANK)
+            {
+                packed_fft_large_transform_windowed(dst, src, window, rank, packed_scramble_self_direct16, packed_butterfly_direct8p, packed_butterfly_direct8p_x2);
+                packed_fft_repack(dst, rank);
+                return;
+            }
+            else
+            {
+                if (rank <= 12)
+                    packed_scramble_copy_direct_windowed8(dst, src, window, rank-4);
+                else
+                    packed_scramble_copy_direct_windowed16(dst, src, window, rank-4);
+            }
+
+            packed_fft_butterfly_blocked(dst, 3, rank, packed_butterfly_direct8p, packed_butterfly_direct8p_x2);
+
+            packed_fft_repack(dst, rank);
+        }
+
+        void packed_reverse_fft_add(float *dst, float *src, const float *window, size_t rank)
+        {
+            if (rank <= 2)
+            {
+                packed_small_reverse_fft(src, src, rank);
+                for (size_t i=0, n=1 << rank; i<n; ++i)
+                {
+                    dst[i*2]       += src[i*2] * window[i];
+                    dst[i*2 + 1]   += src[i*2 + 1] * window[i];
+                }
+                return;
+            }
+
+            // Perform the transform in the source buffer
+            if (rank <= 8)
+                packed_scramble_self_reverse8(src, rank);
+            else if (rank <= 16)
+                packed_scramble_self_reverse16(src, rank);
+            else
+                packed_scramble_self_reverse32(src, rank);
+
+            packed_fft_butterfly_blocked(src, 3, rank, packed_butterfly_reverse8p, packed_butterfly_reverse8p_x2);
+
+            packed_fft_repack_normalize_add(dst, src, window, rank);
+        }
+
         void packed_direct_fft_fma3(float *dst, const float *src, size_t rank)
         {
             if (rank <= 2)
@@ -225,8 +328,16 @@ namespace lsp
                 dsp::move(dst, src, 2 << rank); // 1 << rank + 1
                 if (rank <= 8)
                     packed_scramble_self_direct8_fma3(dst, rank);
-                else
+                else if (rank <= 16)
                     packed_scramble_self_direct16_fma3(dst, rank);
+                else
+                    packed_scramble_self_direct32_fma3(dst, rank);
+            }
+            else if (rank > FFT_LARGE_RANK)
+            {
+                packed_fft_large_transform(dst, src, rank, packed_scramble_self_direct16_fma3, packed_butterfly_direct8p_fma3, packed_butterfly_direct8p_x2_fma3);
+                packed_fft_repack(dst, rank);
+                return;
             }
             else
             {
@@ -236,8 +347,7 @@ namespace lsp
                     packed_scramble_copy_direct16_fma3(dst, src, rank-4);
             }
 
-            for (size_t i=3; i < rank; ++i)
-                packed_butterfly_direct8p_fma3(dst, i, 1 << (rank - i - 1));
+            packed_fft_butterfly_blocked(dst, 3, rank, packed_butterfly_direct8p_fma3, packed_butterfly_direct8p_x2_fma3);
 
             packed_fft_repack(dst, rank);
         }
@@ -255,8 +365,16 @@ namespace lsp
                 dsp::move(dst, src, 2 << rank); // 1 << rank + 1
                 if (rank <= 8)
                     packed_scramble_self_reverse8_fma3(dst, rank);
-                else
+                else if (rank <= 16)
                     packed_scramble_self_reverse16_fma3(dst, rank);
+                else
+                    packed_scramble_self_reverse32_fma3(dst, rank);
+            }
+            else if (rank > FFT_LARGE_RANK)
+            {
+                packed_fft_large_transform(dst, src, rank, packed_scramble_self_reverse16_fma3, packed_butterfly_reverse8p_fma3, packed_butterfly_reverse8p_x2_fma3);
+                packed_fft_repack_normalize(dst, rank);
+                return;
             }
             else
             {
@@ -266,11 +384,66 @@ namespace lsp
                     packed_scramble_copy_reverse16_fma3(dst, src, rank-4);
             }
 
-            for (size_t i=3; i < rank; ++i)
-                packed_butterfly_reverse8p_fma3(dst, i, 1 << (rank - i - 1));
+            packed_fft_butterfly_blocked(dst, 3, rank, packed_butterfly_reverse8p_fma3, packed_butterfly_reverse8p_x2_fma3);
 
             packed_fft_repack_normalize(dst, rank);
         }
+
+        void packed_direct_fft_windowed_fma3(float *dst, const float *src, const float *window, size_t rank)
+        {
+            // The in-place scramble swaps samples, so the window is applied by the separate pass
+            if ((dst == src) || (rank < 4))
+            {
+                if (dst != src)
+                    dsp::copy(dst, src, 2 << rank);
+                dsp::pcomplex_r2c_mul2(dst, window, 1 << rank);
+                packed_direct_fft_fma3(dst, dst, rank);
+                return;
+            }
+            else if (rank > FFT_LARGE_RANK)
+            {
+                packed_fft_large_transform_windowed(dst, src, window, rank, packed_scramble_self_direct16_fma3, packed_butterfly_direct8p_fma3, packed_butterfly_direct8p_x2_fma3);
+                packed_fft_repack(dst, rank);
+                return;
+            }
+            else
+            {
+                if (rank <= 12)
+                    packed_scramble_copy_direct_windowed8_fma3(dst, src, window, rank-4);
+                else
+                    packed_scramble_copy_direct_windowed16_fma3(dst, src, window, rank-4);
+            }
+
+            packed_fft_butterfly_blocked(dst, 3, rank, packed_butterfly_direct8p_fma3, packed_butterfly_direct8p_x2_fma3);
+
+            packed_fft_repack(dst, rank);
+        }
+
+        void packed_reverse_fft_add_fma3(float *dst, float *src, const float *window, size_t rank)
+        {
+            if (rank <= 2)
+            {
+                packed_small_reverse_fft(src, src, rank);
+                for (size_t i=0, n=1 << rank; i<n; ++i)
+                {
+                    dst[i*2]       += src[i*2] * window[i];
+                    dst[i*2 + 1]   += src[i*2 + 1] * window[i];
+                }
+                return;
+            }
+
+            // Perform the transform in the source buffer
+            if (rank <= 8)
+                packed_scramble_self_reverse8_fma3(src, rank);
+            else if (rank <= 16)
+                packed_scramble_self_reverse16_fma3(src, rank);
+            else
+                packed_scramble_self_reverse32_fma3(src, rank);
+
+            packed_fft_butterfly_blocked(src, 3, rank, packed_butterfly_reverse8p_fma3, packed_butterfly_reverse8p_x2_fma3);
+
+            packed_fft_repack_normalize_add(dst, src, window, rank);
+        }
     }
 }
 
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 24 окт. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_RFFT_H_
+#define PRIVATE_DSP_ARCH_X86_AVX_RFFT_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_IMPL */
+
+#include <private/dsp/arch/x86/avx/fft/const.h>
+#include <private/dsp/arch/x86/avx/fft/butterfly.h>
+#include <private/dsp/arch/x86/avx/fft/blocked.h>
+#include <private/dsp/arch/x86/avx/fft/r_split.h>
+
+// Scrambling functions
+#define FFT_RSCRAMBLE_COPY_DIRECT_NAME  real_scramble_copy_direct8
+#define FFT_TYPE                        uint8_t
+#define FFT_FMA(a, b)                   a
+#include <private/dsp/arch/x86/avx/fft/r_scramble.h>
+
+#define FFT_RSCRAMBLE_COPY_DIRECT_NAME  real_scramble_copy_direct16
+#define FFT_TYPE                        uint16_t
+#define FFT_FMA(a, b)                   a
+#include <private/dsp/arch/x86/avx/fft/r_scramble.h>
+
+#define FFT_RSCRAMBLE_COPY_DIRECT_NAME  real_scramble_copy_direct32
+#define FFT_TYPE                        uint32_t
+#define FFT_FMA(a, b)                   a
+#include <private/dsp/arch/x86/avx/fft/r_scramble.h>
+
+#define FFT_RSCRAMBLE_COPY_DIRECT_NAME  real_scramble_copy_direct8_fma3
+#define FFT_TYPE                        uint8_t
+#define FFT_FMA(a, b)                   b
+#include <private/dsp/arch/x86/avx/fft/r_scramble.h>
+
+#define FFT_RSCRAMBLE_COPY_DIRECT_NAME  real_scramble_copy_direct16_fma3
+#define FFT_TYPE                        uint16_t
+#define FFT_FMA(a, b)                   b
+#include <private/dsp/arch/x86/avx/fft/r_scramble.h>
+
+#define FFT_RSCRAMBLE_COPY_DIRECT_NAME  real_scramble_copy_direct32_fma3
+#define FFT_TYPE                        uint32_t
+#define FFT_FMA(a, b)                   b
+#include <private/dsp/arch/x86/avx/fft/r_scramble.h>
+
+namespace lsp
+{
+    namespace avx
+    {
+        // cos(2*pi*k/16), sin(2*pi*k/16)
+        static const float RFFT_SMALL_RE[] __lsp_aligned16 =
+        {
+            1.0000000000000000f, 0.9238795325112867f, 0.7071067811865476f, 0.3826834323650898f,
+            0.0000000000000000f, -0.3826834323650897f, -0.7071067811865475f, -0.9238795325112867f,
+            -1.0000000000000000f, -0.9238795325112867f, -0.7071067811865475f, -0.3826834323650898f,
+            0.0000000000000000f, 0.3826834323650898f, 0.7071067811865475f, 0.9238795325112867f
+        };
+
+        static const float RFFT_SMALL_IM[] __lsp_aligned16 =
+        {
+            0.0000000000000000f, 0.3826834323650898f, 0.7071067811865475f, 0.9238795325112867f,
+            1.0000000000000000f, 0.9238795325112867f, 0.7071067811865476f, 0.3826834323650899f,
+            0.0000000000000000f, -0.3826834323650897f, -0.7071067811865475f, -0.9238795325112867f,
+            -1.0000000000000000f, -0.9238795325112867f, -0.7071067811865476f, -0.3826834323650898f
+        };
+
+        static void small_real_direct_fft(float *dst_re, float *dst_im, size_t step, const float *src, size_t rank)
+        {
+            float b_re[9], b_im[9];
+            size_t items    = 1 << rank;
+            size_t half     = items >> 1;
+            size_t shift    = 4 - rank;
+
+            for (size_t k=0; k<=half; ++k)
+            {
+                float re        = 0.0f;
+                float im        = 0.0f;
+                for (size_t n=0; n<items; ++n)
+                {
+                    size_t i        = ((k * n) << shift) & 0x0f;
+                    re             += src[n] * RFFT_SMALL_RE[i];
+                    im             -= src[n] * RFFT_SMALL_IM[i];
+                }
+                b_re[k]         = re;
+                b_im[k]         = im;
+            }
+
+            for (size_t k=0; k<=half; ++k)
+            {
+                dst_re[k*step]  = b_re[k];
+                dst_im[k*step]  = b_im[k];
+            }
+        }
+
+        static void small_real_reverse_fft(float *dst, const float *src_re, const float *src_im, size_t step, size_t rank)
+        {
+            float b[16];
+            size_t items    = 1 << rank;
+            size_t half     = items >> 1;
+            size_t shift    = 4 - rank;
+            float k         = 1.0f / items;
+
+            if (rank == 0)
+            {
+                dst[0]          = src_re[0];
+                return;
+            }
+
+            for (size_t n=0; n<items; ++n)
+            {
+                float s         = src_re[0] + ((n & 1) ? -src_re[half*step] : src_re[half*step]);
+                for (size_t i=1; i<half; ++i)
+                {
+                    size_t j        = ((i * n) << shift) & 0x0f;
+                    s              += 2.0f * (src_re[i*step] * RFFT_SMALL_RE[j] - src_im[i*step] * RFFT_SMALL_IM[j]);
+                }
+                b[n]            = s * k;
+            }
+
+            for (size_t n=0; n<items; ++n)
+                dst[n]          = b[n];
+        }
+
+        /**
+         * Prepare twiddle factors for the split kernels, see r_split.h for the layout
+         *
+         * @param w buffer to store twiddle factors, 40 elements
+         * @param rank rank of the real FFT, should be at least 5
+         * @param packed use the order of elements for the packed data
+         */
+        static inline void real_fft_twiddle(float *w, size_t rank, bool packed)
+        {
+            const float *fa, *fw;
+            float xw[32] __lsp_aligned32;
+            fft_twiddle_rows(fa, fw, xw, rank - 1);
+
+            for (size_t i=0; i<8; ++i)
+            {
+                // Element i contains the twiddle factor for the point k = j + 1
+                size_t j            = (packed) ? ((i & 0x01) | ((i & 0x02) << 1) | ((i & 0x04) >> 1)) : i;
+                w[i]                = 0.5f * ((j < 7) ? fa[j + 1] : fw[0]);
+                w[i + 8]            = 0.5f * ((j < 7) ? fa[j + 9] : fw[8]);
+                w[i + 16]           = fw[i];
+                w[i + 24]           = fw[i + 8];
+                w[i + 32]           = 0.5f;
+            }
+        }
+
+    #define RFFT_DIRECT_IMPL(SPLIT, SCRAMBLE8, SCRAMBLE16, SCRAMBLE32, BUTTERFLY, BUTTERFLY2) \
+        if (rank <= 4) \
+        { \
+            small_real_direct_fft(dst_re, dst_im, 1, src, rank); \
+            return; \
+        } \
+        \
+        float w[40] __lsp_aligned32; \
+        size_t items    = 1 << (rank - 1); \
+        \
+        if (rank <= 13) \
+            SCRAMBLE8(dst_re, dst_im, src, rank - 5); \
+        else if (rank <= 21) \
+            SCRAMBLE16(dst_re, dst_im, src, rank - 5); \
+        else \
+            SCRAMBLE32(dst_re, dst_im, src, rank - 5); \
+        fft_butterfly_blocked(dst_re, dst_im, 3, rank - 1, BUTTERFLY, BUTTERFLY2); \
+        real_fft_twiddle(w, rank, false); \
+        SPLIT(dst_re, dst_im, w, rank); \
+        \
+        float z_re      = dst_re[0]; \
+        float z_im      = dst_im[0]; \
+        dst_re[0]       = z_re + z_im; \
+        dst_im[0]       = 0.0f; \
+        dst_re[items]   = z_re - z_im; \
+        dst_im[items]   = 0.0f;
+
+    #define RFFT_PACKED_DIRECT_IMPL(SPLIT, FFT) \
+        if (rank <= 4) \
+        { \
+            small_real_direct_fft(&dst[0], &dst[1], 2, src, rank); \
+            return; \
+        } \
+        \
+        float w[40] __lsp_aligned32; \
+        size_t items    = 1 << (rank - 1); \
+        \
+        FFT(dst, src, rank - 1); \
+        real_fft_twiddle(w, rank, true); \
+        SPLIT(dst, w, rank); \
+        \
+        float z_re      = dst[0]; \
+        float z_im      = dst[1]; \
+        dst[0]          = z_re + z_im; \
+        dst[1]          = 0.0f; \
+        dst[items*2]    = z_re - z_im; \
+        dst[items*2+1]  = 0.0f;
+
+    #define RFFT_REVERSE_IMPL(SPLIT, FFT) \
+        if (rank <= 4) \
+        { \
+            small_real_reverse_fft(dst, src_re, src_im, 1, rank); \
+            return; \
+        } \
+        \
+        float w[40] __lsp_aligned32; \
+        size_t items    = 1 << (rank - 1); \
+        float x0        = src_re[0]; \
+        float xn        = src_re[items]; \
+        \
+        real_fft_twiddle(w, rank, false); \
+        SPLIT(dst, src_re, src_im, w, rank); \
+        dst[0]          = (x0 + xn) * 0.5f; \
+        dst[1]          = (x0 - xn) * 0.5f; \
+        FFT(dst, dst, rank - 1);
+
+    #define RFFT_PACKED_REVERSE_IMPL(SPLIT, FFT) \
+        if (rank <= 4) \
+        { \
+            small_real_reverse_fft(dst, &src[0], &src[1], 2, rank); \
+            return; \
+        } \
+        \
+        float w[40] __lsp_aligned32; \
+        size_t items    = 1 << (rank - 1); \
+        float x0        = src[0]; \
+        float xn        = src[items*2]; \
+        \
+        real_fft_twiddle(w, rank, true); \
+        SPLIT(dst, src, w, rank); \
+        dst[0]          = (x0 + xn) * 0.5f; \
+        dst[1]          = (x0 - xn) * 0.5f; \
+        FFT(dst, dst, rank - 1);
+
+        void real_direct_fft(float *dst_re, float *dst_im, const float *src, size_t rank)
+        {
+            RFFT_DIRECT_IMPL(real_fft_direct_split8, real_scramble_copy_direct8, real_scramble_copy_direct16, real_scramble_copy_direct32, butterfly_direct8p, butterfly_direct8p_x2);
+        }
+
+        void packed_real_direct_fft(float *dst, const float *src, size_t rank)
+        {
+            RFFT_PACKED_DIRECT_IMPL(packed_real_fft_direct_split8, packed_direct_fft);
+        }
+
+        void real_reverse_fft(float *dst, const float *src_re, const float *src_im, size_t rank)
+        {
+            RFFT_REVERSE_IMPL(real_fft_reverse_split8, packed_reverse_fft);
+        }
+
+        void packed_real_reverse_fft(float *dst, const float *src, size_t rank)
+        {
+            RFFT_PACKED_REVERSE_IMPL(packed_real_fft_reverse_split8, packed_reverse_fft);
+        }
+
+        void real_direct_fft_fma3(float *dst_re, float *dst_im, const float *src, size_t rank)
+        {
+            RFFT_DIRECT_IMPL(real_fft_direct_split8_fma3, real_scramble_copy_direct8_fma3, real_scramble_copy_direct16_fma3, real_scramble_copy_direct32_fma3, butterfly_direct8p_fma3, butterfly_direct8p_x2_fma3);
+        }
+
+        void packed_real_direct_fft_fma3(float *dst, const float *src, size_t rank)
+        {
+            RFFT_PACKED_DIRECT_IMPL(packed_real_fft_direct_split8_fma3, packed_direct_fft_fma3);
+        }
+
+        void real_reverse_fft_fma3(float *dst, const float *src_re, const float *src_im, size_t rank)
+        {
+            RFFT_REVERSE_IMPL(real_fft_reverse_split8_fma3, packed_reverse_fft_fma3);
+        }
+
+        void packed_real_reverse_fft_fma3(float *dst, const float *src, size_t rank)
+        {
+            RFFT_PACKED_REVERSE_IMPL(packed_real_fft_reverse_split8_fma3, packed_reverse_fft_fma3);
+        }
+
+    #undef RFFT_PACKED_REVERSE_IMPL
+    #undef RFFT_REVERSE_IMPL
+    #undef RFFT_PACKED_DIRECT_IMPL
+    #undef RFFT_DIRECT_IMPL
+    } /* namespace avx */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX_RFFT_H_ */
@@ -851,6 +851,225 @@ namespace lsp
 
     #undef COMPLEX_RCP_CORE
 
+    IF_ARCH_X86(
+        static const uint32_t complex_atan2_const[] __lsp_aligned64 =
+        {
+            LSP_DSP_VEC16(0x7fffffff),      // abs mask
+            LSP_DSP_VEC16(0x80000000),      // sign bit
+            LSP_DSP_VEC16(0x00800000),      // FLT_MIN
+            LSP_DSP_VEC16(0x3fc90fdb),      // PI/2
+            LSP_DSP_VEC16(0x40490fdb),      // PI
+            LSP_DSP_VEC16(0x3caace9e),      // C4 = 0.0208504759
+            LSP_DSP_VEC16(0xbdae6c2b),      // C3 = -0.0851672515
+            LSP_DSP_VEC16(0x3e387d93),      // C2 = 0.180166528
+            LSP_DSP_VEC16(0xbea91def),      // C1 = -0.3303065
+            LSP_DSP_VEC16(0x3f7ff73f)       // C0 = 0.999866426
+        };
+    )
+
+    /*
+     * Fast module: mod = s * rsqrt14(max(s, FLT_MIN)), s = re*re + im*im
+     * Input: V0 = re, V1 = im, output: V6 = mod
+     */
+    #define COMPLEX_MOD_FAST_CORE(V) \
+        __ASM_EMIT  ("vmulps        %%" V "0, %%" V "0, %%" V "6")                      /* v6 = re*re */ \
+        __ASM_EMIT  ("vfmadd231ps   %%" V "1, %%" V "1, %%" V "6")                      /* v6 = s = re*re + im*im */ \
+        __ASM_EMIT  ("vmaxps        0x80 + %[CC], %%" V "6, %%" V "7")                  /* v7 = max(s, FLT_MIN) */ \
+        __ASM_EMIT  ("vrsqrt14ps    %%" V "7, %%" V "7")                                /* v7 = 1/sqrt(s) */ \
+        __ASM_EMIT  ("vmulps        %%" V "7, %%" V "6, %%" V "6")                      /* v6 = mod = s/sqrt(s) */
+
+    /*
+     * Fast argument: polynomial approximation of atan(a), a = min(|re|,|im|)/max(|re|,|im|)
+     * followed by the octant correction
+     * Input: V0 = re, V1 = im, output: V5 = arg
+     */
+    #define COMPLEX_ATAN2_FAST_CORE(V) \
+        __ASM_EMIT  ("vpandd        0x00 + %[CC], %%" V "0, %%" V "2")                  /* v2 = ar = |re| */ \
+        __ASM_EMIT  ("vpandd        0x00 + %[CC], %%" V "1, %%" V "3")                  /* v3 = ai = |im| */ \
+        __ASM_EMIT  ("vminps        %%" V "3, %%" V "2, %%" V "4")                      /* v4 = min(ar, ai) */ \
+        __ASM_EMIT  ("vmaxps        %%" V "3, %%" V "2, %%" V "5")                      /* v5 = max(ar, ai) */ \
+        __ASM_EMIT  ("vcmpps        $1, %%" V "3, %%" V "2, %%k4")                      /* k4 = [ar < ai] */ \
+        __ASM_EMIT  ("vmaxps        0x80 + %[CC], %%" V "5, %%" V "5")                  /* v5 = max(ar, ai, FLT_MIN) */ \
+        __ASM_EMIT  ("vdivps        %%" V "5, %%" V "4, %%" V "4")                      /* v4 = a = min/max */ \
+        __ASM_EMIT  ("vmulps        %%" V "4, %%" V "4, %%" V "3")                      /* v3 = A = a*a */ \
+        __ASM_EMIT  ("vmovaps       0x140 + %[CC], %%" V "5")                           /* v5 = C4 */ \
+        __ASM_EMIT  ("vfmadd213ps   0x180 + %[CC], %%" V "3, %%" V "5")                 /* v5 = C3+A*C4 */ \
+        __ASM_EMIT  ("vfmadd213ps   0x1c0 + %[CC], %%" V "3, %%" V "5")                 /* v5 = C2+A*(C3+A*C4) */ \
+        __ASM_EMIT  ("vfmadd213ps   0x200 + %[CC], %%" V "3, %%" V "5")                 /* v5 = C1+A*(C2+A*(C3+A*C4)) */ \
+        __ASM_EMIT  ("vfmadd213ps   0x240 + %[CC], %%" V "3, %%" V "5")                 /* v5 = C0+A*(C1+A*(C2+A*(C3+A*C4))) */ \
+        __ASM_EMIT  ("vmulps        %%" V "4, %%" V "5, %%" V "5")                      /* v5 = r */ \
+        __ASM_EMIT  ("vmovaps       0xc0 + %[CC], %%" V "3")                            /* v3 = PI/2 */ \
+        __ASM_EMIT  ("vsubps        %%" V "5, %%" V "3, %%" V "5 %{%%k4%}")             /* v5 = r = (ar < ai) ? PI/2 - r : r */ \
+        __ASM_EMIT  ("vpxord        %%" V "4, %%" V "4, %%" V "4")                      /* v4 = 0 */ \
+        __ASM_EMIT  ("vcmpps        $1, %%" V "4, %%" V "0, %%k5")                      /* k5 = [re < 0] */ \
+        __ASM_EMIT  ("vmovaps       0x100 + %[CC], %%" V "3")                           /* v3 = PI */ \
+        __ASM_EMIT  ("vsubps        %%" V "5, %%" V "3, %%" V "5 %{%%k5%}")             /* v5 = r = (re < 0) ? PI - r : r */ \
+        __ASM_EMIT  ("vpternlogd    $0xf8, 0x40 + %[CC], %%" V "1, %%" V "5")           /* v5 = arg = r | (im & sign) */
+
+    #define COMPLEX_CVT2MODARG_FAST_CORE \
+        /* x16 blocks */ \
+        __ASM_EMIT32("subl          $16, %[count]") \
+        __ASM_EMIT64("sub           $16, %[count]") \
+        __ASM_EMIT  ("jb            2f") \
+        __ASM_EMIT  ("1:") \
+        __ASM_EMIT  ("vmovups       0x00(%[src_re]), %%zmm0") \
+        __ASM_EMIT  ("vmovups       0x00(%[src_im]), %%zmm1") \
+        COMPLEX_MOD_FAST_CORE("zmm") \
+        COMPLEX_ATAN2_FAST_CORE("zmm") \
+        __ASM_EMIT  ("vmovups       %%zmm6, 0x00(%[dst_mod])") \
+        __ASM_EMIT  ("vmovups       %%zmm5, 0x00(%[dst_arg])") \
+        __ASM_EMIT  ("add           $0x40, %[src_re]") \
+        __ASM_EMIT  ("add           $0x40, %[src_im]") \
+        __ASM_EMIT  ("add           $0x40, %[dst_mod]") \
+        __ASM_EMIT  ("add           $0x40, %[dst_arg]") \
+        __ASM_EMIT32("subl          $16, %[count]") \
+        __ASM_EMIT64("sub           $16, %[count]") \
+        __ASM_EMIT  ("jae           1b") \
+        __ASM_EMIT  ("2:") \
+        /* x8 block */ \
+        __ASM_EMIT32("addl          $8, %[count]") \
+        __ASM_EMIT64("add           $8, %[count]") \
+        __ASM_EMIT  ("jl            4f") \
+        __ASM_EMIT  ("vmovups       0x00(%[src_re]), %%ymm0") \
+        __ASM_EMIT  ("vmovups       0x00(%[src_im]), %%ymm1") \
+        COMPLEX_MOD_FAST_CORE("ymm") \
+        COMPLEX_ATAN2_FAST_CORE("ymm") \
+        __ASM_EMIT  ("vmovups       %%ymm6, 0x00(%[dst_mod])") \
+        __ASM_EMIT  ("vmovups       %%ymm5, 0x00(%[dst_arg])") \
+        __ASM_EMIT  ("add           $0x20, %[src_re]") \
+        __ASM_EMIT  ("add           $0x20, %[src_im]") \
+        __ASM_EMIT  ("add           $0x20, %[dst_mod]") \
+        __ASM_EMIT  ("add           $0x20, %[dst_arg]") \
+        __ASM_EMIT32("subl          $8, %[count]") \
+        __ASM_EMIT64("sub           $8, %[count]") \
+        __ASM_EMIT  ("4:") \
+        /* x4 block */ \
+        __ASM_EMIT32("addl          $4, %[count]") \
+        __ASM_EMIT64("add           $4, %[count]") \
+        __ASM_EMIT  ("jl            6f") \
+        __ASM_EMIT  ("vmovups       0x00(%[src_re]), %%xmm0") \
+        __ASM_EMIT  ("vmovups       0x00(%[src_im]), %%xmm1") \
+        COMPLEX_MOD_FAST_CORE("xmm") \
+        COMPLEX_ATAN2_FAST_CORE("xmm") \
+        __ASM_EMIT  ("vmovups       %%xmm6, 0x00(%[dst_mod])") \
+        __ASM_EMIT  ("vmovups       %%xmm5, 0x00(%[dst_arg])") \
+        __ASM_EMIT  ("add           $0x10, %[src_re]") \
+        __ASM_EMIT  ("add           $0x10, %[src_im]") \
+        __ASM_EMIT  ("add           $0x10, %[dst_mod]") \
+        __ASM_EMIT  ("add           $0x10, %[dst_arg]") \
+        __ASM_EMIT32("subl          $4, %[count]") \
+        __ASM_EMIT64("sub           $4, %[count]") \
+        __ASM_EMIT  ("6:") \
+        /* x1 blocks */ \
+        __ASM_EMIT32("addl          $3, %[count]") \
+        __ASM_EMIT64("add           $3, %[count]") \
+        __ASM_EMIT  ("jl            8f") \
+        __ASM_EMIT  ("7:") \
+        __ASM_EMIT  ("vmovss        0x00(%[src_re]), %%xmm0") \
+        __ASM_EMIT  ("vmovss        0x00(%[src_im]), %%xmm1") \
+        COMPLEX_MOD_FAST_CORE("xmm") \
+        COMPLEX_ATAN2_FAST_CORE("xmm") \
+        __ASM_EMIT  ("vmovss        %%xmm6, 0x00(%[dst_mod])") \
+        __ASM_EMIT  ("vmovss        %%xmm5, 0x00(%[dst_arg])") \
+        __ASM_EMIT  ("add           $0x04, %[src_re]") \
+        __ASM_EMIT  ("add           $0x04, %[src_im]") \
+        __ASM_EMIT  ("add           $0x04, %[dst_mod]") \
+        __ASM_EMIT  ("add           $0x04, %[dst_arg]") \
+        __ASM_EMIT32("decl          %[count]") \
+        __ASM_EMIT64("dec           %[count]") \
+        __ASM_EMIT  ("jge           7b") \
+        __ASM_EMIT  ("8:")
+
+        void complex_cvt2modarg_fast(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count)
+        {
+            ARCH_X86_ASM
+            (
+                COMPLEX_CVT2MODARG_FAST_CORE
+                : [dst_mod] "+r" (dst_mod), [dst_arg] "+r" (dst_arg),
+                  [src_re] "+r" (src_re), [src_im] "+r" (src_im),
+                  [count] X86_PGREG (count)
+                : [CC] "o" (complex_atan2_const)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+                  "%k4", "%k5"
+            );
+        }
+
+    #undef COMPLEX_CVT2MODARG_FAST_CORE
+
+    #define COMPLEX_ARG_FAST_CORE \
+        /* x16 blocks */ \
+        __ASM_EMIT  ("sub           $16, %[count]") \
+        __ASM_EMIT  ("jb            2f") \
+        __ASM_EMIT  ("1:") \
+        __ASM_EMIT  ("vmovups       0x00(%[re]), %%zmm0") \
+        __ASM_EMIT  ("vmovups       0x00(%[im]), %%zmm1") \
+        COMPLEX_ATAN2_FAST_CORE("zmm") \
+        __ASM_EMIT  ("vmovups       %%zmm5, 0x00(%[dst])") \
+        __ASM_EMIT  ("add           $0x40, %[re]") \
+        __ASM_EMIT  ("add           $0x40, %[im]") \
+        __ASM_EMIT  ("add           $0x40, %[dst]") \
+        __ASM_EMIT  ("sub           $16, %[count]") \
+        __ASM_EMIT  ("jae           1b") \
+        __ASM_EMIT  ("2:") \
+        /* x8 block */ \
+        __ASM_EMIT  ("add           $8, %[count]") \
+        __ASM_EMIT  ("jl            4f") \
+        __ASM_EMIT  ("vmovups       0x00(%[re]), %%ymm0") \
+        __ASM_EMIT  ("vmovups       0x00(%[im]), %%ymm1") \
+        COMPLEX_ATAN2_FAST_CORE("ymm") \
+        __ASM_EMIT  ("vmovups       %%ymm5, 0x00(%[dst])") \
+        __ASM_EMIT  ("add           $0x20, %[re]") \
+        __ASM_EMIT  ("add           $0x20, %[im]") \
+        __ASM_EMIT  ("add           $0x20, %[dst]") \
+        __ASM_EMIT  ("sub           $8, %[count]") \
+        __ASM_EMIT  ("4:") \
+        /* x4 block */ \
+        __ASM_EMIT  ("add           $4, %[count]") \
+        __ASM_EMIT  ("jl            6f") \
+        __ASM_EMIT  ("vmovups       0x00(%[re]), %%xmm0") \
+        __ASM_EMIT  ("vmovups       0x00(%[im]), %%xmm1") \
+        COMPLEX_ATAN2_FAST_CORE("xmm") \
+        __ASM_EMIT  ("vmovups       %%xmm5, 0x00(%[dst])") \
+        __ASM_EMIT  ("add           $0x10, %[re]") \
+        __ASM_EMIT  ("add           $0x10, %[im]") \
+        __ASM_EMIT  ("add           $0x10, %[dst]") \
+        __ASM_EMIT  ("sub           $4, %[count]") \
+        __ASM_EMIT  ("6:") \
+        /* x1 blocks */ \
+        __ASM_EMIT  ("add           $3, %[count]") \
+        __ASM_EMIT  ("jl            8f") \
+        __ASM_EMIT  ("7:") \
+        __ASM_EMIT  ("vmovss        0x00(%[re]), %%xmm0") \
+        __ASM_EMIT  ("vmovss        0x00(%[im]), %%xmm1") \
+        COMPLEX_ATAN2_FAST_CORE("xmm") \
+        __ASM_EMIT  ("vmovss        %%xmm5, 0x00(%[dst])") \
+        __ASM_EMIT  ("add           $0x04, %[re]") \
+        __ASM_EMIT  ("add           $0x04, %[im]") \
+        __ASM_EMIT  ("add           $0x04, %[dst]") \
+        __ASM_EMIT  ("dec           %[count]") \
+        __ASM_EMIT  ("jge           7b") \
+        __ASM_EMIT  ("8:")
+
+        void complex_arg_fast(float *dst, const float *re, const float *im, size_t count)
+        {
+            ARCH_X86_ASM
+            (
+                COMPLEX_ARG_FAST_CORE
+                : [dst] "+r" (dst), [re] "+r" (re), [im] "+r" (im),
+                  [count] "+r" (count)
+                : [CC] "o" (complex_atan2_const)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5",
+                  "%k4", "%k5"
+            );
+        }
+
+    #undef COMPLEX_ARG_FAST_CORE
+
+
 
     } /* namespace avx512 */
 } /* namespace lsp */
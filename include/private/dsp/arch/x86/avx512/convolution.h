@@ -0,0 +1,537 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 26 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_CONVOLUTION_H_
+#define PRIVATE_DSP_ARCH_X86_AVX512_CONVOLUTION_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_IMPL */
+
+namespace lsp
+{
+    namespace avx512
+    {
+        void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count)
+        {
+            IF_ARCH_X86(
+                const float *c;
+                float *d;
+                size_t clen;
+            );
+
+            ARCH_X86_ASM(
+                __ASM_EMIT("mov                 $0x07, %k[clen]")
+                __ASM_EMIT("kmovw               %k[clen], %%k1")                // k1 = mask of 3 elements
+                // 4x blocks
+                __ASM_EMIT("sub                 $4, %[count]")
+                __ASM_EMIT("jb                  200f")
+                __ASM_EMIT("100:")
+                    __ASM_EMIT("vxorps              %%zmm7, %%zmm7, %%zmm7")        // zmm7 = 0
+                    __ASM_EMIT("mov                 %[length], %[clen]")
+                    __ASM_EMIT("mov                 %[dst], %[d]")
+                    __ASM_EMIT("mov                 %[conv], %[c]")
+
+                    __ASM_EMIT("vbroadcastss        0x00(%[k]), %%zmm0")            // zmm0 = k0
+                    __ASM_EMIT("vbroadcastss        0x04(%[k]), %%zmm1")            // zmm1 = k1
+                    __ASM_EMIT("vbroadcastss        0x08(%[k]), %%zmm2")            // zmm2 = k2
+                    __ASM_EMIT("vbroadcastss        0x0c(%[k]), %%zmm3")            // zmm3 = k3
+                    // 16x convolution
+                    __ASM_EMIT("sub                 $16, %[clen]")
+                    __ASM_EMIT("jb                  10f")
+                    __ASM_EMIT(".align              16")
+                    __ASM_EMIT("11:")
+                        __ASM_EMIT("vmovups             (%[c]), %%zmm4")                        // zmm4 = c0 c1 ... c15
+                        __ASM_EMIT("valignd             $13, %%zmm7, %%zmm4, %%zmm6")           // zmm6 = p13 p14 p15 c0 ... c12
+                        __ASM_EMIT("valignd             $14, %%zmm7, %%zmm4, %%zmm5")           // zmm5 = p14 p15 c0 ... c13
+                        __ASM_EMIT("vmulps              %%zmm3, %%zmm6, %%zmm6")                // zmm6 = k3*p13 ...
+                        __ASM_EMIT("vfmadd231ps         %%zmm2, %%zmm5, %%zmm6")                // zmm6 = k2*p14 + k3*p13 ...
+                        __ASM_EMIT("valignd             $15, %%zmm7, %%zmm4, %%zmm5")           // zmm5 = p15 c0 ... c14
+                        __ASM_EMIT("vmovaps             %%zmm4, %%zmm7")                        // zmm7 = c0 c1 ... c15
+                        __ASM_EMIT("vfmadd231ps         %%zmm1, %%zmm5, %%zmm6")                // zmm6 = k1*p15 + k2*p14 + k3*p13 ...
+                        __ASM_EMIT("vfmadd213ps         (%[d]), %%zmm0, %%zmm4")                // zmm4 = d0 + k0*c0 ...
+                        __ASM_EMIT("vaddps              %%zmm6, %%zmm4, %%zmm4")                // zmm4 = d0 + k0*c0 + k1*p15 + k2*p14 + k3*p13 ...
+                        __ASM_EMIT("vmovups             %%zmm4, (%[d])")
+                        __ASM_EMIT("add                 $0x40, %[c]")                           // c += 16
+                        __ASM_EMIT("add                 $0x40, %[d]")                           // d += 16
+                        __ASM_EMIT("sub                 $16, %[clen]")                          // clen -= 16
+                        __ASM_EMIT("jae                 11b")
+                    __ASM_EMIT("10:")
+                    // 8x convolution
+                    __ASM_EMIT("add                 $8, %[clen]")
+                    __ASM_EMIT("jl                  12f")
+                    __ASM_EMIT("vmovups             (%[c]), %%ymm4")                        // zmm4 = c0 c1 ... c7 0 ... 0
+                    __ASM_EMIT("valignd             $13, %%zmm7, %%zmm4, %%zmm6")           // ymm6 = p13 p14 p15 c0 ... c4
+                    __ASM_EMIT("valignd             $14, %%zmm7, %%zmm4, %%zmm5")           // ymm5 = p14 p15 c0 ... c5
+                    __ASM_EMIT("vmulps              %%ymm3, %%ymm6, %%ymm6")                // ymm6 = k3*p13 ...
+                    __ASM_EMIT("vfmadd231ps         %%ymm2, %%ymm5, %%ymm6")                // ymm6 = k2*p14 + k3*p13 ...
+                    __ASM_EMIT("valignd             $15, %%zmm7, %%zmm4, %%zmm5")           // ymm5 = p15 c0 ... c6
+                    __ASM_EMIT("valignd             $8, %%zmm7, %%zmm4, %%zmm7")            // zmm7 = p8 ... p15 c0 ... c7
+                    __ASM_EMIT("vfmadd231ps         %%ymm1, %%ymm5, %%ymm6")                // ymm6 = k1*p15 + k2*p14 + k3*p13 ...
+                    __ASM_EMIT("vfmadd213ps         (%[d]), %%ymm0, %%ymm4")                // ymm4 = d0 + k0*c0 ...
+                    __ASM_EMIT("vaddps              %%ymm6, %%ymm4, %%ymm4")                // ymm4 = d0 + k0*c0 + k1*p15 + k2*p14 + k3*p13 ...
+                    __ASM_EMIT("vmovups             %%ymm4, (%[d])")
+                    __ASM_EMIT("sub                 $8, %[clen]")                           // clen -= 8
+                    __ASM_EMIT("add                 $0x20, %[c]")                           // c += 8
+                    __ASM_EMIT("add                 $0x20, %[d]")                           // d += 8
+                    __ASM_EMIT("12:")
+                    // 4x convolution
+                    __ASM_EMIT("add                 $4, %[clen]")
+                    __ASM_EMIT("jl                  14f")
+                    __ASM_EMIT("vmovups             (%[c]), %%xmm4")                        // zmm4 = c0 c1 c2 c3 0 ... 0
+                    __ASM_EMIT("valignd             $13, %%zmm7, %%zmm4, %%zmm6")           // xmm6 = p13 p14 p15 c0
+                    __ASM_EMIT("valignd             $14, %%zmm7, %%zmm4, %%zmm5")           // xmm5 = p14 p15 c0 c1
+                    __ASM_EMIT("vmulps              %%xmm3, %%xmm6, %%xmm6")                // xmm6 = k3*p13 ...
+                    __ASM_EMIT("vfmadd231ps         %%xmm2, %%xmm5, %%xmm6")                // xmm6 = k2*p14 + k3*p13 ...
+                    __ASM_EMIT("valignd             $15, %%zmm7, %%zmm4, %%zmm5")           // xmm5 = p15 c0 c1 c2
+                    __ASM_EMIT("valignd             $4, %%zmm7, %%zmm4, %%zmm7")            // zmm7 = p4 ... p15 c0 ... c3
+                    __ASM_EMIT("vfmadd231ps         %%xmm1, %%xmm5, %%xmm6")                // xmm6 = k1*p15 + k2*p14 + k3*p13 ...
+                    __ASM_EMIT("vfmadd213ps         (%[d]), %%xmm0, %%xmm4")                // xmm4 = d0 + k0*c0 ...
+                    __ASM_EMIT("vaddps              %%xmm6, %%xmm4, %%xmm4")                // xmm4 = d0 + k0*c0 + k1*p15 + k2*p14 + k3*p13 ...
+                    __ASM_EMIT("vmovups             %%xmm4, (%[d])")
+                    __ASM_EMIT("sub                 $4, %[clen]")                           // clen -= 4
+                    __ASM_EMIT("add                 $0x10, %[c]")                           // c += 4
+                    __ASM_EMIT("add                 $0x10, %[d]")                           // d += 4
+                    __ASM_EMIT("14:")
+                    // 1x convolution
+                    __ASM_EMIT("add                 $3, %[clen]")
+                    __ASM_EMIT("jl                  16f")
+                    __ASM_EMIT("15:")
+                        __ASM_EMIT("vmovss              (%[c]), %%xmm4")                        // zmm4 = c0 0 ... 0
+                        __ASM_EMIT("valignd             $13, %%zmm7, %%zmm4, %%zmm6")           // xmm6 = p13
+                        __ASM_EMIT("valignd             $14, %%zmm7, %%zmm4, %%zmm5")           // xmm5 = p14
+                        __ASM_EMIT("vmulss              %%xmm3, %%xmm6, %%xmm6")                // xmm6 = k3*p13
+                        __ASM_EMIT("vfmadd231ss         %%xmm2, %%xmm5, %%xmm6")                // xmm6 = k2*p14 + k3*p13
+                        __ASM_EMIT("valignd             $15, %%zmm7, %%zmm4, %%zmm5")           // xmm5 = p15
+                        __ASM_EMIT("valignd             $1, %%zmm7, %%zmm4, %%zmm7")            // zmm7 = p1 ... p15 c0
+                        __ASM_EMIT("vfmadd231ss         %%xmm1, %%xmm5, %%xmm6")                // xmm6 = k1*p15 + k2*p14 + k3*p13
+                        __ASM_EMIT("vfmadd213ss         (%[d]), %%xmm0, %%xmm4")                // xmm4 = d0 + k0*c0
+                        __ASM_EMIT("vaddss              %%xmm6, %%xmm4, %%xmm4")                // xmm4 = d0 + k0*c0 + k1*p15 + k2*p14 + k3*p13
+                        __ASM_EMIT("vmovss              %%xmm4, (%[d])")
+                        __ASM_EMIT("add                 $0x04, %[c]")                           // c++
+                        __ASM_EMIT("add                 $0x04, %[d]")                           // d++
+                        __ASM_EMIT("dec                 %[clen]")                               // clen--
+                        __ASM_EMIT("jge                 15b")
+                    __ASM_EMIT("16:")
+                    // 3x tail
+                    __ASM_EMIT("vxorps              %%xmm4, %%xmm4, %%xmm4")                // zmm4 = 0
+                    __ASM_EMIT("valignd             $13, %%zmm7, %%zmm4, %%zmm6")           // xmm6 = p13 p14 p15 0
+                    __ASM_EMIT("valignd             $14, %%zmm7, %%zmm4, %%zmm5")           // xmm5 = p14 p15 0 0
+                    __ASM_EMIT("vmulps              %%xmm3, %%xmm6, %%xmm6")                // xmm6 = k3*p13 ...
+                    __ASM_EMIT("vfmadd231ps         %%xmm2, %%xmm5, %%xmm6")                // xmm6 = k2*p14 + k3*p13 ...
+                    __ASM_EMIT("valignd             $15, %%zmm7, %%zmm4, %%zmm5")           // xmm5 = p15 0 0 0
+                    __ASM_EMIT("vfmadd231ps         %%xmm1, %%xmm5, %%xmm6")                // xmm6 = k1*p15 + k2*p14 + k3*p13 ...
+                    __ASM_EMIT("vmovups             (%[d]), %%xmm4 %{%%k1%}%{z%}")          // xmm4 = d0 d1 d2 0
+                    __ASM_EMIT("vaddps              %%xmm6, %%xmm4, %%xmm4")                // xmm4 = d0 + k1*p15 + k2*p14 + k3*p13 ...
+                    __ASM_EMIT("vmovups             %%xmm4, (%[d]) %{%%k1%}")
+                __ASM_EMIT64("add               $0x10, %[dst]")         // dst += 4
+                __ASM_EMIT32("addl              $0x10, %[dst]")
+                __ASM_EMIT("add                 $0x10, %[k]")           // k += 4
+                __ASM_EMIT("sub                 $0x04, %[count]")       // count -= 4
+                __ASM_EMIT("jge                 100b")
+
+                // 1x blocks
+                __ASM_EMIT("200:")
+                __ASM_EMIT("add                 $3, %[count]")
+                __ASM_EMIT("jl                  400f")
+                __ASM_EMIT("300:")
+                    __ASM_EMIT("mov                 %[length], %[clen]")
+                    __ASM_EMIT("mov                 %[dst], %[d]")
+                    __ASM_EMIT("vbroadcastss        0x00(%[k]), %%zmm0")            // zmm0 = k0
+                    __ASM_EMIT("mov                 %[conv], %[c]")
+                    // 64x convolution
+                    __ASM_EMIT("sub                 $64, %[clen]")
+                    __ASM_EMIT("jb                  20f")
+                    __ASM_EMIT(".align              16")
+                    __ASM_EMIT("21:")
+                        __ASM_EMIT("vmovups             0x00(%[c]), %%zmm2")                // zmm2 = c0 c1 ...
+                        __ASM_EMIT("vmovups             0x40(%[c]), %%zmm3")
+                        __ASM_EMIT("vmovups             0x80(%[c]), %%zmm4")
+                        __ASM_EMIT("vmovups             0xc0(%[c]), %%zmm5")
+                        __ASM_EMIT("vfmadd213ps         0x00(%[d]), %%zmm0, %%zmm2")        // zmm2 = d0+k0*c0 d1+k0*c1 ...
+                        __ASM_EMIT("vfmadd213ps         0x40(%[d]), %%zmm0, %%zmm3")
+                        __ASM_EMIT("vfmadd213ps         0x80(%[d]), %%zmm0, %%zmm4")
+                        __ASM_EMIT("vfmadd213ps         0xc0(%[d]), %%zmm0, %%zmm5")
+                        __ASM_EMIT("vmovups             %%zmm2, 0x00(%[d])")
+                        __ASM_EMIT("vmovups             %%zmm3, 0x40(%[d])")
+                        __ASM_EMIT("vmovups             %%zmm4, 0x80(%[d])")
+                        __ASM_EMIT("vmovups             %%zmm5, 0xc0(%[d])")
+                        __ASM_EMIT("add                 $0x100, %[c]")                      // c += 64
+                        __ASM_EMIT("add                 $0x100, %[d]")                      // d += 64
+                        __ASM_EMIT("sub                 $64, %[clen]")                      // clen -= 64
+                        __ASM_EMIT("jae                 21b")
+                    __ASM_EMIT("20:")
+                    // 32x convolution
+                    __ASM_EMIT("add                 $32, %[clen]")
+                    __ASM_EMIT("jl                  22f")
+                    __ASM_EMIT("vmovups             0x00(%[c]), %%zmm2")                // zmm2 = c0 c1 ...
+                    __ASM_EMIT("vmovups             0x40(%[c]), %%zmm3")
+                    __ASM_EMIT("vfmadd213ps         0x00(%[d]), %%zmm0, %%zmm2")        // zmm2 = d0+k0*c0 d1+k0*c1 ...
+                    __ASM_EMIT("vfmadd213ps         0x40(%[d]), %%zmm0, %%zmm3")
+                    __ASM_EMIT("vmovups             %%zmm2, 0x00(%[d])")
+                    __ASM_EMIT("vmovups             %%zmm3, 0x40(%[d])")
+                    __ASM_EMIT("sub                 $32, %[clen]")                      // clen -= 32
+                    __ASM_EMIT("add                 $0x80, %[c]")                       // c += 32
+                    __ASM_EMIT("add                 $0x80, %[d]")                       // d += 32
+                    __ASM_EMIT("22:")
+                    // 16x convolution
+                    __ASM_EMIT("add                 $16, %[clen]")
+                    __ASM_EMIT("jl                  24f")
+                    __ASM_EMIT("vmovups             0x00(%[c]), %%zmm2")                // zmm2 = c0 c1 ...
+                    __ASM_EMIT("vfmadd213ps         0x00(%[d]), %%zmm0, %%zmm2")        // zmm2 = d0+k0*c0 d1+k0*c1 ...
+                    __ASM_EMIT("vmovups             %%zmm2, 0x00(%[d])")
+                    __ASM_EMIT("sub                 $16, %[clen]")                      // clen -= 16
+                    __ASM_EMIT("add                 $0x40, %[c]")                       // c += 16
+                    __ASM_EMIT("add                 $0x40, %[d]")                       // d += 16
+                    __ASM_EMIT("24:")
+                    // 8x convolution
+                    __ASM_EMIT("add                 $8, %[clen]")
+                    __ASM_EMIT("jl                  26f")
+                    __ASM_EMIT("vmovups             0x00(%[c]), %%ymm2")                // ymm2 = c0 c1 ...
+                    __ASM_EMIT("vfmadd213ps         0x00(%[d]), %%ymm0, %%ymm2")        // ymm2 = d0+k0*c0 d1+k0*c1 ...
+                    __ASM_EMIT("vmovups             %%ymm2, 0x00(%[d])")
+                    __ASM_EMIT("sub                 $8, %[clen]")                       // clen -= 8
+                    __ASM_EMIT("add                 $0x20, %[c]")                       // c += 8
+                    __ASM_EMIT("add                 $0x20, %[d]")                       // d += 8
+                    __ASM_EMIT("26:")
+                    // 4x convolution
+                    __ASM_EMIT("add                 $4, %[clen]")
+                    __ASM_EMIT("jl                  28f")
+                    __ASM_EMIT("vmovups             0x00(%[c]), %%xmm2")                // xmm2 = c0 c1 ...
+                    __ASM_EMIT("vfmadd213ps         0x00(%[d]), %%xmm0, %%xmm2")        // xmm2 = d0+k0*c0 d1+k0*c1 ...
+                    __ASM_EMIT("vmovups             %%xmm2, 0x00(%[d])")
+                    __ASM_EMIT("sub                 $4, %[clen]")                       // clen -= 4
+                    __ASM_EMIT("add                 $0x10, %[c]")                       // c += 4
+                    __ASM_EMIT("add                 $0x10, %[d]")                       // d += 4
+                    __ASM_EMIT("28:")
+                    // 1x convolution
+                    __ASM_EMIT("add                 $3, %[clen]")
+                    __ASM_EMIT("jl                  30f")
+                    __ASM_EMIT("29:")
+                        __ASM_EMIT("vmovss              0x00(%[c]), %%xmm2")                // xmm2 = c0
+                        __ASM_EMIT("vfmadd213ss         0x00(%[d]), %%xmm0, %%xmm2")        // xmm2 = d0+k0*c0
+                        __ASM_EMIT("vmovss              %%xmm2, 0x00(%[d])")
+                        __ASM_EMIT("add                 $0x04, %[c]")                       // c ++
+                        __ASM_EMIT("add                 $0x04, %[d]")                       // d ++
+                        __ASM_EMIT("dec                 %[clen]")
+                        __ASM_EMIT("jge                 29b")
+                    __ASM_EMIT("30:")
+                __ASM_EMIT("add         $0x04, %[k]")
+                __ASM_EMIT64("add       $0x04, %[dst]")             // dst++
+                __ASM_EMIT32("addl      $0x04, %[dst]")
+                __ASM_EMIT("dec         %[count]")
+                __ASM_EMIT("jge         300b")
+
+                __ASM_EMIT("400:")
+                : [dst] __ASM_ARG_RW(dst),
+                  [k] "+r" (src), [count] "+r" (count),
+                  [c] "=&r" (c), [d] "=&r" (d), [clen] "=&r" (clen)
+                : [conv] X86_GREG (conv), [length] X86_GREG (length)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+                  "%k1"
+            );
+        }
+
+    #ifdef ARCH_X86_64
+        /*
+         * The fixed-length kernels keep the sums of 16 output samples per each block of 16
+         * elements of the convolution in registers. Each source sample is multiplied by the
+         * precomputed copy of the convolution shifted by the position of the sample within
+         * the block of 16 source samples, so the destination buffer is updated once per 16 samples.
+         * Even and odd source samples use separate accumulators to shorten dependency chains.
+         */
+        static constexpr size_t CONVOLVE_FIXED_MIN      = 16;
+
+        #define CONVOLVE_X64_CLEAR(A, B) \
+            __ASM_EMIT("vxorps          %%zmm" A ", %%zmm" A ", %%zmm" A) \
+            __ASM_EMIT("vxorps          %%zmm" B ", %%zmm" B ", %%zmm" B)
+
+        #define CONVOLVE_X64_FMA(OFF, A, B) \
+            __ASM_EMIT("vfmadd231ps     " OFF "(%[sh]), %%zmm0, %%zmm" A) \
+            __ASM_EMIT("vfmadd231ps     0x40+" OFF "(%[sh]), %%zmm1, %%zmm" B)
+
+        #define CONVOLVE_X64_MOVE(A0, B0, A1, B1) \
+            __ASM_EMIT("vaddps          %%zmm" B1 ", %%zmm" A1 ", %%zmm" A0) \
+            __ASM_EMIT("vxorps          %%zmm" B0 ", %%zmm" B0 ", %%zmm" B0)
+
+        #define CONVOLVE_X64_STORE(OFF, A) \
+            __ASM_EMIT("vaddps          " OFF "(%[dst]), %%zmm" A ", %%zmm" A) \
+            __ASM_EMIT("vmovups         %%zmm" A ", " OFF "(%[dst])")
+
+        #define CONVOLVE_X64_STORE_LAST(OFF, A) \
+            __ASM_EMIT("vmovups         " OFF "(%[dst]), %%zmm2 %{%%k1%}%{z%}") \
+            __ASM_EMIT("vaddps          %%zmm2, %%zmm" A ", %%zmm" A) \
+            __ASM_EMIT("vmovups         %%zmm" A ", " OFF "(%[dst]) %{%%k1%}")
+
+        #define CONVOLVE_X64_KERNEL(CLEAR, FMA, SHIFT, FLUSH) \
+            ARCH_X86_64_ASM( \
+                __ASM_EMIT("mov             $0x7fff, %k[i]") \
+                __ASM_EMIT("kmovw           %k[i], %%k1")                   /* k1 = mask of 15 elements */ \
+                CLEAR \
+                __ASM_EMIT("1:") \
+                    __ASM_EMIT("mov             %[shb], %[sh]") \
+                    __ASM_EMIT("mov             $8, %[i]") \
+                    __ASM_EMIT("2:") \
+                        __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")  /* zmm0 = k0 */ \
+                        __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")  /* zmm1 = k1 */ \
+                        FMA \
+                        __ASM_EMIT("add             $0x80, %[sh]") \
+                        __ASM_EMIT("add             $0x08, %[src]") \
+                        __ASM_EMIT("dec             %[i]") \
+                        __ASM_EMIT("jnz             2b") \
+                    __ASM_EMIT("vaddps          %%zmm17, %%zmm8, %%zmm2") \
+                    __ASM_EMIT("vaddps          0x00(%[dst]), %%zmm2, %%zmm2") \
+                    __ASM_EMIT("vmovups         %%zmm2, 0x00(%[dst])") \
+                    SHIFT \
+                    __ASM_EMIT("add             $0x40, %[dst]") \
+                    __ASM_EMIT("dec             %[blocks]") \
+                    __ASM_EMIT("jnz             1b") \
+                FLUSH \
+                : [dst] "+r" (dst), [src] "+r" (src), [blocks] "+r" (blocks), \
+                  [sh] "=&r" (sh), [i] "=&r" (i) \
+                : [shb] "r" (shb) \
+                : "cc", "memory", \
+                  "%xmm0", "%xmm1", "%xmm2", \
+                  "%xmm8", "%xmm9", "%xmm10", "%xmm11", \
+                  "%xmm12", "%xmm13", "%xmm14", "%xmm15", \
+                  "%xmm16", "%xmm17", "%xmm18", "%xmm19", \
+                  "%xmm20", "%xmm21", "%xmm22", "%xmm23", \
+                  "%xmm24", "%xmm25", \
+                  "%k1" \
+            )
+
+        /**
+         * Prepare the shifted copies of the convolution for the fixed-length kernel
+         *
+         * @param sh destination buffer of (blocks + 1) * 256 elements
+         * @param zp temporary buffer of blocks * 16 + 32 elements
+         * @param conv convolution of blocks * 16 elements
+         * @param blocks number of blocks of 16 elements in the convolution
+         */
+        static void x64_convolve_prepare(float *sh, float *zp, const float *conv, size_t blocks)
+        {
+            float *p;
+            size_t i;
+
+            ARCH_X86_64_ASM(
+                // Copy the convolution with 16 zeros before and after
+                __ASM_EMIT("vxorps          %%zmm0, %%zmm0, %%zmm0")
+                __ASM_EMIT("mov             %[zp], %[p]")
+                __ASM_EMIT("mov             %[blocks], %[i]")
+                __ASM_EMIT("vmovaps         %%zmm0, 0x00(%[p])")
+                __ASM_EMIT("1:")
+                    __ASM_EMIT("vmovups         0x00(%[conv]), %%zmm1")
+                    __ASM_EMIT("vmovaps         %%zmm1, 0x40(%[p])")
+                    __ASM_EMIT("add             $0x40, %[conv]")
+                    __ASM_EMIT("add             $0x40, %[p]")
+                    __ASM_EMIT("dec             %[i]")
+                    __ASM_EMIT("jnz             1b")
+                __ASM_EMIT("vmovaps         %%zmm0, 0x40(%[p])")
+                // Store the block b shifted by i elements: sh[b][i][j] = conv[b*16 + j - i]
+                __ASM_EMIT("mov             %[zp], %[p]")
+                __ASM_EMIT("inc             %[blocks]")
+                __ASM_EMIT("2:")
+                    __ASM_EMIT("mov             $16, %[i]")
+                    __ASM_EMIT("3:")
+                        __ASM_EMIT("vmovups         0x40(%[p]), %%zmm0")
+                        __ASM_EMIT("vmovaps         %%zmm0, 0x00(%[sh])")
+                        __ASM_EMIT("sub             $0x04, %[p]")
+                        __ASM_EMIT("add             $0x40, %[sh]")
+                        __ASM_EMIT("dec             %[i]")
+                        __ASM_EMIT("jnz             3b")
+                    __ASM_EMIT("add             $0x80, %[p]")
+                    __ASM_EMIT("dec             %[blocks]")
+                    __ASM_EMIT("jnz             2b")
+                : [sh] "+r" (sh), [conv] "+r" (conv), [blocks] "+r" (blocks),
+                  [p] "=&r" (p), [i] "=&r" (i)
+                : [zp] "r" (zp)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1"
+            );
+        }
+
+        static void x64_convolve16(float *dst, const float *src, const float *conv, size_t count)
+        {
+            float shb[0x200] __lsp_aligned64;
+            float zp[0x30] __lsp_aligned64;
+            size_t blocks   = count >> 4;
+            float *sh;
+            size_t i;
+
+            x64_convolve_prepare(shb, zp, conv, 1);
+            CONVOLVE_X64_KERNEL(
+                CONVOLVE_X64_CLEAR("8", "17")
+                CONVOLVE_X64_CLEAR("9", "18"),
+                CONVOLVE_X64_FMA("0x0000", "8", "17")
+                CONVOLVE_X64_FMA("0x0400", "9", "18"),
+                CONVOLVE_X64_MOVE("8", "17", "9", "18")
+                CONVOLVE_X64_CLEAR("9", "18"),
+                CONVOLVE_X64_STORE_LAST("0x00", "8")
+            );
+
+            if (count & 0x0f)
+                convolve(dst, src, conv, 16, count & 0x0f);
+        }
+
+        static void x64_convolve32(float *dst, const float *src, const float *conv, size_t count)
+        {
+            float shb[0x300] __lsp_aligned64;
+            float zp[0x40] __lsp_aligned64;
+            size_t blocks   = count >> 4;
+            float *sh;
+            size_t i;
+
+            x64_convolve_prepare(shb, zp, conv, 2);
+            CONVOLVE_X64_KERNEL(
+                CONVOLVE_X64_CLEAR("8", "17")
+                CONVOLVE_X64_CLEAR("9", "18")
+                CONVOLVE_X64_CLEAR("10", "19"),
+                CONVOLVE_X64_FMA("0x0000", "8", "17")
+                CONVOLVE_X64_FMA("0x0400", "9", "18")
+                CONVOLVE_X64_FMA("0x0800", "10", "19"),
+                CONVOLVE_X64_MOVE("8", "17", "9", "18")
+                CONVOLVE_X64_MOVE("9", "18", "10", "19")
+                CONVOLVE_X64_CLEAR("10", "19"),
+                CONVOLVE_X64_STORE("0x00", "8")
+                CONVOLVE_X64_STORE_LAST("0x40", "9")
+            );
+
+            if (count & 0x0f)
+                convolve(dst, src, conv, 32, count & 0x0f);
+        }
+
+        static void x64_convolve64(float *dst, const float *src, const float *conv, size_t count)
+        {
+            float shb[0x500] __lsp_aligned64;
+            float zp[0x60] __lsp_aligned64;
+            size_t blocks   = count >> 4;
+            float *sh;
+            size_t i;
+
+            x64_convolve_prepare(shb, zp, conv, 4);
+            CONVOLVE_X64_KERNEL(
+                CONVOLVE_X64_CLEAR("8", "17")
+                CONVOLVE_X64_CLEAR("9", "18")
+                CONVOLVE_X64_CLEAR("10", "19")
+                CONVOLVE_X64_CLEAR("11", "20")
+                CONVOLVE_X64_CLEAR("12", "21"),
+                CONVOLVE_X64_FMA("0x0000", "8", "17")
+                CONVOLVE_X64_FMA("0x0400", "9", "18")
+                CONVOLVE_X64_FMA("0x0800", "10", "19")
+                CONVOLVE_X64_FMA("0x0c00", "11", "20")
+                CONVOLVE_X64_FMA("0x1000", "12", "21"),
+                CONVOLVE_X64_MOVE("8", "17", "9", "18")
+                CONVOLVE_X64_MOVE("9", "18", "10", "19")
+                CONVOLVE_X64_MOVE("10", "19", "11", "20")
+                CONVOLVE_X64_MOVE("11", "20", "12", "21")
+                CONVOLVE_X64_CLEAR("12", "21"),
+                CONVOLVE_X64_STORE("0x00", "8")
+                CONVOLVE_X64_STORE("0x40", "9")
+                CONVOLVE_X64_STORE("0x80", "10")
+                CONVOLVE_X64_STORE_LAST("0xc0", "11")
+            );
+
+            if (count & 0x0f)
+                convolve(dst, src, conv, 64, count & 0x0f);
+        }
+
+        static void x64_convolve128(float *dst, const float *src, const float *conv, size_t count)
+        {
+            float shb[0x900] __lsp_aligned64;
+            float zp[0xa0] __lsp_aligned64;
+            size_t blocks   = count >> 4;
+            float *sh;
+            size_t i;
+
+            x64_convolve_prepare(shb, zp, conv, 8);
+            CONVOLVE_X64_KERNEL(
+                CONVOLVE_X64_CLEAR("8", "17")
+                CONVOLVE_X64_CLEAR("9", "18")
+                CONVOLVE_X64_CLEAR("10", "19")
+                CONVOLVE_X64_CLEAR("11", "20")
+                CONVOLVE_X64_CLEAR("12", "21")
+                CONVOLVE_X64_CLEAR("13", "22")
+                CONVOLVE_X64_CLEAR("14", "23")
+                CONVOLVE_X64_CLEAR("15", "24")
+                CONVOLVE_X64_CLEAR("16", "25"),
+                CONVOLVE_X64_FMA("0x0000", "8", "17")
+                CONVOLVE_X64_FMA("0x0400", "9", "18")
+                CONVOLVE_X64_FMA("0x0800", "10", "19")
+                CONVOLVE_X64_FMA("0x0c00", "11", "20")
+                CONVOLVE_X64_FMA("0x1000", "12", "21")
+                CONVOLVE_X64_FMA("0x1400", "13", "22")
+                CONVOLVE_X64_FMA("0x1800", "14", "23")
+                CONVOLVE_X64_FMA("0x1c00", "15", "24")
+                CONVOLVE_X64_FMA("0x2000", "16", "25"),
+                CONVOLVE_X64_MOVE("8", "17", "9", "18")
+                CONVOLVE_X64_MOVE("9", "18", "10", "19")
+                CONVOLVE_X64_MOVE("10", "19", "11", "20")
+                CONVOLVE_X64_MOVE("11", "20", "12", "21")
+                CONVOLVE_X64_MOVE("12", "21", "13", "22")
+                CONVOLVE_X64_MOVE("13", "22", "14", "23")
+                CONVOLVE_X64_MOVE("14", "23", "15", "24")
+                CONVOLVE_X64_MOVE("15", "24", "16", "25")
+                CONVOLVE_X64_CLEAR("16", "25"),
+                CONVOLVE_X64_STORE("0x000", "8")
+                CONVOLVE_X64_STORE("0x040", "9")
+                CONVOLVE_X64_STORE("0x080", "10")
+                CONVOLVE_X64_STORE("0x0c0", "11")
+                CONVOLVE_X64_STORE("0x100", "12")
+                CONVOLVE_X64_STORE("0x140", "13")
+                CONVOLVE_X64_STORE("0x180", "14")
+                CONVOLVE_X64_STORE_LAST("0x1c0", "15")
+            );
+
+            if (count & 0x0f)
+                convolve(dst, src, conv, 128, count & 0x0f);
+        }
+
+        #undef CONVOLVE_X64_KERNEL
+        #undef CONVOLVE_X64_STORE_LAST
+        #undef CONVOLVE_X64_STORE
+        #undef CONVOLVE_X64_MOVE
+        #undef CONVOLVE_X64_FMA
+        #undef CONVOLVE_X64_CLEAR
+
+        void x64_convolve(float *dst, const float *src, const float *conv, size_t length, size_t count)
+        {
+            // Short convolutions of fixed length are processed by specialized kernels
+            if (count >= CONVOLVE_FIXED_MIN)
+            {
+                switch (length)
+                {
+                    case 16: x64_convolve16(dst, src, conv, count); return;
+                    case 32: x64_convolve32(dst, src, conv, count); return;
+                    case 64: x64_convolve64(dst, src, conv, count); return;
+                    case 128: x64_convolve128(dst, src, conv, count); return;
+                    default: break;
+                }
+            }
+
+            convolve(dst, src, conv, length, count);
+        }
+    #endif /* ARCH_X86_64 */
+    } /* namespace avx512 */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_CONVOLUTION_H_ */
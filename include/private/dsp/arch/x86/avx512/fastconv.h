@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 окт. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_H_
+#define PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_IMPL */
+
+#include <private/dsp/arch/x86/avx512/fft.h>
+#include <private/dsp/arch/x86/avx512/fastconv/prepare.h>
+#include <private/dsp/arch/x86/avx512/fastconv/butterfly.h>
+#include <private/dsp/arch/x86/avx512/fastconv/apply.h>
+#include <private/dsp/arch/x86/avx512/fastconv/mac.h>
+
+namespace lsp
+{
+    namespace avx512
+    {
+        /*
+         * Transforms of rank 3 do not fill the whole register and are computed
+         * directly with the natural order of 8 real parts followed by 8 imaginary parts
+         */
+        static void fastconv_small_parse(float *dst, const float *src)
+        {
+            float x_re[8], x_im[8];
+            for (size_t i=0; i<4; ++i)
+            {
+                x_re[i]         = src[i];
+                x_re[i + 4]     = 0.0f;
+            }
+            for (size_t i=0; i<8; ++i)
+                x_im[i]         = 0.0f;
+
+            small_fft(&dst[0], &dst[8], x_re, x_im, 3, 1.0f);
+        }
+
+        static void fastconv_small_restore(float *dst, const float *src, bool add)
+        {
+            float x_re[8], x_im[8];
+            small_fft(x_re, x_im, &src[0], &src[8], 3, -1.0f);
+
+            if (add)
+            {
+                for (size_t i=0; i<8; ++i)
+                    dst[i]         += x_re[i];
+            }
+            else
+            {
+                for (size_t i=0; i<8; ++i)
+                    dst[i]          = x_re[i];
+            }
+        }
+
+        static void fastconv_small_apply(float *dst, const float *c1, const float *c2)
+        {
+            for (size_t i=0; i<8; ++i)
+            {
+                float re        = c1[i] * c2[i] - c1[i + 8] * c2[i + 8];
+                float im        = c1[i] * c2[i + 8] + c1[i + 8] * c2[i];
+                dst[i]          = re;
+                dst[i + 8]      = im;
+            }
+        }
+
+        /**
+         * Perform the direct butterflies of the fast convolution down to the block of 16 elements
+         *
+         * @param dst destination buffer
+         * @param src source real data, 1 << (rank - 1) samples
+         * @param rank the rank of the transform
+         * @return number of blocks of 16 complex numbers
+         */
+        static size_t fastconv_direct_transform(float *dst, const float *src, size_t rank)
+        {
+            float xw[64] __lsp_aligned64;
+            const float *ak, *wk;
+            size_t np       = 1 << (rank - 1);
+            size_t nb       = 1;
+
+            if (np <= 8)
+            {
+                fastconv_direct_unpack(dst, src);
+                return nb;
+            }
+
+            fft_twiddle_rows(ak, wk, xw, rank - 1);
+            fastconv_direct_prepare(dst, src, ak, wk, np);
+            np        >>= 1;
+            nb        <<= 1;
+
+            for (size_t r = rank - 2; np >= 16; --r)
+            {
+                fft_twiddle_rows(ak, wk, xw, r);
+                fastconv_direct_butterfly(dst, ak, wk, np, nb);
+                np        >>= 1;
+                nb        <<= 1;
+            }
+
+            return nb;
+        }
+
+        /**
+         * Perform the reverse butterflies of the fast convolution starting from the
+         * block of 16 elements and store the real part of the result
+         *
+         * @param dst destination buffer
+         * @param tmp temporary buffer with the bit-reversed spectrum
+         * @param rank the rank of the transform
+         * @param add add the result to the destination buffer instead of storing it
+         */
+        static void fastconv_reverse_transform(float *dst, float *tmp, size_t rank, bool add)
+        {
+            float xw[64] __lsp_aligned64;
+            const float *ak, *wk;
+            size_t nb       = 1 << (rank - 4);
+            size_t np       = 16;
+
+            if (nb <= 1)
+            {
+                if (add)
+                    fastconv_reverse_unpack_adding(dst, tmp);
+                else
+                    fastconv_reverse_unpack(dst, tmp);
+                return;
+            }
+
+            size_t r        = 4;
+            for (nb >>= 1; nb > 1; nb >>= 1, np <<= 1, ++r)
+            {
+                fft_twiddle_rows(ak, wk, xw, r);
+                fastconv_reverse_butterfly(tmp, ak, wk, np, nb);
+            }
+
+            fft_twiddle_rows(ak, wk, xw, r);
+            if (add)
+                fastconv_reverse_butterfly_last_adding(dst, tmp, ak, wk, np);
+            else
+                fastconv_reverse_butterfly_last(dst, tmp, ak, wk, np);
+        }
+
+        void fastconv_parse(float *dst, const float *src, size_t rank)
+        {
+            if (rank < 4)
+            {
+                fastconv_small_parse(dst, src);
+                return;
+            }
+
+            size_t nb = fastconv_direct_transform(dst, src, rank);
+            fastconv_direct_butterfly_last(dst, nb);
+        }
+
+        void fastconv_restore(float *dst, float *tmp, size_t rank)
+        {
+            if (rank < 4)
+            {
+                fastconv_small_restore(dst, tmp, false);
+                return;
+            }
+
+            fastconv_reverse_prepare(tmp, 1 << (rank - 4));
+            fastconv_reverse_transform(dst, tmp, rank, false);
+        }
+
+        void fastconv_apply(float *dst, float *tmp, const float *c1, const float *c2, size_t rank)
+        {
+            if (rank < 4)
+            {
+                fastconv_small_apply(tmp, c1, c2);
+                fastconv_small_restore(dst, tmp, true);
+                return;
+            }
+
+            fastconv_apply_prepare(tmp, c1, c2, 1 << (rank - 4));
+            fastconv_reverse_transform(dst, tmp, rank, true);
+        }
+
+        void fastconv_parse_apply(float *dst, float *tmp, const float *c, const float *src, size_t rank)
+        {
+            if (rank < 4)
+            {
+                fastconv_small_parse(tmp, src);
+                fastconv_small_apply(tmp, tmp, c);
+                fastconv_small_restore(dst, tmp, true);
+                return;
+            }
+
+            size_t nb = fastconv_direct_transform(tmp, src, rank);
+            fastconv_apply_internal(tmp, c, nb);
+            fastconv_reverse_transform(dst, tmp, rank, true);
+        }
+    } /* namespace avx512 */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_H_ */
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 окт. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_APPLY_H_
+#define PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_APPLY_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_IMPL */
+
+namespace lsp
+{
+    namespace avx512
+    {
+        /*
+         * Perform the last four decimation-in-frequency stages for the block of 16 complex
+         * numbers stored in zmm0 (real part) and zmm1 (imaginary part). The result is
+         * stored in zmm2 and zmm3 in the bit-reversed order.
+         */
+        #define FASTCONV_X16_DIRECT_BODY \
+            /* 1st stage: p = 8 */ \
+            __ASM_EMIT("vshuff32x4      $0x44, %%zmm0, %%zmm0, %%zmm2")             /* a_re = x_re[i & ~8] */ \
+            __ASM_EMIT("vshuff32x4      $0xee, %%zmm0, %%zmm0, %%zmm4")             /* b_re = x_re[i | 8] */ \
+            __ASM_EMIT("vshuff32x4      $0x44, %%zmm1, %%zmm1, %%zmm3")             /* a_im = x_im[i & ~8] */ \
+            __ASM_EMIT("vshuff32x4      $0xee, %%zmm1, %%zmm1, %%zmm5")             /* b_im = x_im[i | 8] */ \
+            __ASM_EMIT("vfmadd231ps     0x1c0 + %[FFT_DIF], %%zmm4, %%zmm2")        /* s_re = a_re +- b_re */ \
+            __ASM_EMIT("vfmadd231ps     0x1c0 + %[FFT_DIF], %%zmm5, %%zmm3")        /* s_im = a_im +- b_im */ \
+            __ASM_EMIT("vmulps          0x200 + %[FFT_DIF], %%zmm2, %%zmm0")        /* x_re = t_re * s_re */ \
+            __ASM_EMIT("vmulps          0x200 + %[FFT_DIF], %%zmm3, %%zmm1")        /* x_im = t_re * s_im */ \
+            __ASM_EMIT("vfmadd231ps     0x240 + %[FFT_DIF], %%zmm3, %%zmm0")        /* x_re += t_im * s_im */ \
+            __ASM_EMIT("vfnmadd231ps    0x240 + %[FFT_DIF], %%zmm2, %%zmm1")        /* x_im -= t_im * s_re */ \
+            /* 2nd stage: p = 4 */ \
+            __ASM_EMIT("vshuff32x4      $0xa0, %%zmm0, %%zmm0, %%zmm2")             /* a_re = x_re[i & ~4] */ \
+            __ASM_EMIT("vshuff32x4      $0xf5, %%zmm0, %%zmm0, %%zmm4")             /* b_re = x_re[i | 4] */ \
+            __ASM_EMIT("vshuff32x4      $0xa0, %%zmm1, %%zmm1, %%zmm3")             /* a_im = x_im[i & ~4] */ \
+            __ASM_EMIT("vshuff32x4      $0xf5, %%zmm1, %%zmm1, %%zmm5")             /* b_im = x_im[i | 4] */ \
+            __ASM_EMIT("vfmadd231ps     0x100 + %[FFT_DIF], %%zmm4, %%zmm2")        /* s_re = a_re +- b_re */ \
+            __ASM_EMIT("vfmadd231ps     0x100 + %[FFT_DIF], %%zmm5, %%zmm3")        /* s_im = a_im +- b_im */ \
+            __ASM_EMIT("vmulps          0x140 + %[FFT_DIF], %%zmm2, %%zmm0")        /* x_re = t_re * s_re */ \
+            __ASM_EMIT("vmulps          0x140 + %[FFT_DIF], %%zmm3, %%zmm1")        /* x_im = t_re * s_im */ \
+            __ASM_EMIT("vfmadd231ps     0x180 + %[FFT_DIF], %%zmm3, %%zmm0")        /* x_re += t_im * s_im */ \
+            __ASM_EMIT("vfnmadd231ps    0x180 + %[FFT_DIF], %%zmm2, %%zmm1")        /* x_im -= t_im * s_re */ \
+            /* 3rd stage: p = 2 */ \
+            __ASM_EMIT("vpermilps       $0x44, %%zmm0, %%zmm2")                     /* a_re = x_re[i & ~2] */ \
+            __ASM_EMIT("vpermilps       $0xee, %%zmm0, %%zmm4")                     /* b_re = x_re[i | 2] */ \
+            __ASM_EMIT("vpermilps       $0x44, %%zmm1, %%zmm3")                     /* a_im = x_im[i & ~2] */ \
+            __ASM_EMIT("vpermilps       $0xee, %%zmm1, %%zmm5")                     /* b_im = x_im[i | 2] */ \
+            __ASM_EMIT("vfmadd231ps     0x040 + %[FFT_DIF], %%zmm4, %%zmm2")        /* s_re = a_re +- b_re */ \
+            __ASM_EMIT("vfmadd231ps     0x040 + %[FFT_DIF], %%zmm5, %%zmm3")        /* s_im = a_im +- b_im */ \
+            __ASM_EMIT("vmulps          0x080 + %[FFT_DIF], %%zmm2, %%zmm0")        /* x_re = t_re * s_re */ \
+            __ASM_EMIT("vmulps          0x080 + %[FFT_DIF], %%zmm3, %%zmm1")        /* x_im = t_re * s_im */ \
+            __ASM_EMIT("vfmadd231ps     0x0c0 + %[FFT_DIF], %%zmm3, %%zmm0")        /* x_re += t_im * s_im */ \
+            __ASM_EMIT("vfnmadd231ps    0x0c0 + %[FFT_DIF], %%zmm2, %%zmm1")        /* x_im -= t_im * s_re */ \
+            /* 4th stage: p = 1 */ \
+            __ASM_EMIT("vmovsldup       %%zmm0, %%zmm2")                            /* a_re = r0 r0 r2 r2 ... */ \
+            __ASM_EMIT("vmovshdup       %%zmm0, %%zmm4")                            /* b_re = r1 r1 r3 r3 ... */ \
+            __ASM_EMIT("vmovsldup       %%zmm1, %%zmm3")                            /* a_im */ \
+            __ASM_EMIT("vmovshdup       %%zmm1, %%zmm5")                            /* b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x000 + %[FFT_DIF], %%zmm4, %%zmm2")        /* zmm2 = a_re +- b_re */ \
+            __ASM_EMIT("vfmadd231ps     0x000 + %[FFT_DIF], %%zmm5, %%zmm3")        /* zmm3 = a_im +- b_im */
+
+        /*
+         * Perform the first four decimation-in-time stages for the block of 16 complex
+         * numbers stored in zmm0 (real part) and zmm1 (imaginary part) in the bit-reversed
+         * order. The result is stored in zmm0 and zmm1.
+         */
+        #define FASTCONV_X16_REVERSE_BODY \
+            /* 1st stage: p = 1 */ \
+            __ASM_EMIT("vmovsldup       %%zmm0, %%zmm2")                            /* zmm2 = a_re = r0 r0 r2 r2 ... */ \
+            __ASM_EMIT("vmovshdup       %%zmm0, %%zmm4")                            /* zmm4 = b_re = r1 r1 r3 r3 ... */ \
+            __ASM_EMIT("vmovsldup       %%zmm1, %%zmm3")                            /* zmm3 = a_im */ \
+            __ASM_EMIT("vmovshdup       %%zmm1, %%zmm5")                            /* zmm5 = b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x000 + %[FFT_DIT], %%zmm4, %%zmm2")        /* zmm2 = a_re +- b_re */ \
+            __ASM_EMIT("vfmadd231ps     0x000 + %[FFT_DIT], %%zmm5, %%zmm3")        /* zmm3 = a_im +- b_im */ \
+            /* 2nd stage: p = 2 */ \
+            __ASM_EMIT("vpermilps       $0x44, %%zmm2, %%zmm0")                     /* a_re = x_re[i & ~2] */ \
+            __ASM_EMIT("vpermilps       $0xee, %%zmm2, %%zmm4")                     /* b_re = x_re[i | 2] */ \
+            __ASM_EMIT("vpermilps       $0x44, %%zmm3, %%zmm1")                     /* a_im = x_im[i & ~2] */ \
+            __ASM_EMIT("vpermilps       $0xee, %%zmm3, %%zmm5")                     /* b_im = x_im[i | 2] */ \
+            __ASM_EMIT("vfmadd231ps     0x040 + %[FFT_DIT], %%zmm4, %%zmm0")        /* a_re += w_re * b_re */ \
+            __ASM_EMIT("vfnmadd231ps    0x080 + %[FFT_DIT], %%zmm5, %%zmm0")        /* a_re -= w_im * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x040 + %[FFT_DIT], %%zmm5, %%zmm1")        /* a_im += w_re * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x080 + %[FFT_DIT], %%zmm4, %%zmm1")        /* a_im += w_im * b_re */ \
+            /* 3rd stage: p = 4 */ \
+            __ASM_EMIT("vshuff32x4      $0xa0, %%zmm0, %%zmm0, %%zmm2")             /* a_re = x_re[i & ~4] */ \
+            __ASM_EMIT("vshuff32x4      $0xf5, %%zmm0, %%zmm0, %%zmm4")             /* b_re = x_re[i | 4] */ \
+            __ASM_EMIT("vshuff32x4      $0xa0, %%zmm1, %%zmm1, %%zmm3")             /* a_im = x_im[i & ~4] */ \
+            __ASM_EMIT("vshuff32x4      $0xf5, %%zmm1, %%zmm1, %%zmm5")             /* b_im = x_im[i | 4] */ \
+            __ASM_EMIT("vfmadd231ps     0x0c0 + %[FFT_DIT], %%zmm4, %%zmm2")        /* a_re += w_re * b_re */ \
+            __ASM_EMIT("vfnmadd231ps    0x100 + %[FFT_DIT], %%zmm5, %%zmm2")        /* a_re -= w_im * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x0c0 + %[FFT_DIT], %%zmm5, %%zmm3")        /* a_im += w_re * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x100 + %[FFT_DIT], %%zmm4, %%zmm3")        /* a_im += w_im * b_re */ \
+            /* 4th stage: p = 8 */ \
+            __ASM_EMIT("vshuff32x4      $0x44, %%zmm2, %%zmm2, %%zmm0")             /* a_re = x_re[i & ~8] */ \
+            __ASM_EMIT("vshuff32x4      $0xee, %%zmm2, %%zmm2, %%zmm4")             /* b_re = x_re[i | 8] */ \
+            __ASM_EMIT("vshuff32x4      $0x44, %%zmm3, %%zmm3, %%zmm1")             /* a_im = x_im[i & ~8] */ \
+            __ASM_EMIT("vshuff32x4      $0xee, %%zmm3, %%zmm3, %%zmm5")             /* b_im = x_im[i | 8] */ \
+            __ASM_EMIT("vfmadd231ps     0x140 + %[FFT_DIT], %%zmm4, %%zmm0")        /* a_re += w_re * b_re */ \
+            __ASM_EMIT("vfnmadd231ps    0x180 + %[FFT_DIT], %%zmm5, %%zmm0")        /* a_re -= w_im * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x140 + %[FFT_DIT], %%zmm5, %%zmm1")        /* a_im += w_re * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x180 + %[FFT_DIT], %%zmm4, %%zmm1")        /* a_im += w_im * b_re */
+
+        static inline void fastconv_direct_butterfly_last(float *dst, size_t nb)
+        {
+            ARCH_X86_ASM
+            (
+                __ASM_EMIT("1:")
+                    __ASM_EMIT("vmovups         0x00(%[dst]), %%zmm0")
+                    __ASM_EMIT("vmovups         0x40(%[dst]), %%zmm1")
+                    FASTCONV_X16_DIRECT_BODY
+                    __ASM_EMIT("vmovups         %%zmm2, 0x00(%[dst])")
+                    __ASM_EMIT("vmovups         %%zmm3, 0x40(%[dst])")
+                __ASM_EMIT("add             $0x80, %[dst]")
+                __ASM_EMIT("dec             %[nb]")
+                __ASM_EMIT("jnz             1b")
+                : [dst] "+r" (dst), [nb] "+r" (nb)
+                : [FFT_DIF] "o" (FFT_X16_DIF)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5"
+            );
+        }
+
+        static inline void fastconv_reverse_prepare(float *dst, size_t nb)
+        {
+            ARCH_X86_ASM
+            (
+                __ASM_EMIT("1:")
+                    __ASM_EMIT("vmovups         0x00(%[dst]), %%zmm0")
+                    __ASM_EMIT("vmovups         0x40(%[dst]), %%zmm1")
+                    FASTCONV_X16_REVERSE_BODY
+                    __ASM_EMIT("vmovups         %%zmm0, 0x00(%[dst])")
+                    __ASM_EMIT("vmovups         %%zmm1, 0x40(%[dst])")
+                __ASM_EMIT("add             $0x80, %[dst]")
+                __ASM_EMIT("dec             %[nb]")
+                __ASM_EMIT("jnz             1b")
+                : [dst] "+r" (dst), [nb] "+r" (nb)
+                : [FFT_DIT] "o" (FFT_X16_DIT)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5"
+            );
+        }
+
+        static inline void fastconv_apply_prepare(float *dst, const float *c1, const float *c2, size_t nb)
+        {
+            size_t off = 0;
+
+            ARCH_X86_ASM
+            (
+                __ASM_EMIT("1:")
+                    /* Apply convolution */
+                    __ASM_EMIT("vmovups         0x00(%[c1], %[off]), %%zmm2")       /* zmm2 = a_re */
+                    __ASM_EMIT("vmovups         0x40(%[c1], %[off]), %%zmm3")       /* zmm3 = a_im */
+                    __ASM_EMIT("vmulps          0x40(%[c2], %[off]), %%zmm3, %%zmm0")   /* zmm0 = a_im * b_im */
+                    __ASM_EMIT("vmulps          0x40(%[c2], %[off]), %%zmm2, %%zmm1")   /* zmm1 = a_re * b_im */
+                    __ASM_EMIT("vfmsub231ps     0x00(%[c2], %[off]), %%zmm2, %%zmm0")   /* zmm0 = a_re * b_re - a_im * b_im */
+                    __ASM_EMIT("vfmadd231ps     0x00(%[c2], %[off]), %%zmm3, %%zmm1")   /* zmm1 = a_re * b_im + a_im * b_re */
+                    FASTCONV_X16_REVERSE_BODY
+                    __ASM_EMIT("vmovups         %%zmm0, 0x00(%[dst], %[off])")
+                    __ASM_EMIT("vmovups         %%zmm1, 0x40(%[dst], %[off])")
+                __ASM_EMIT("add             $0x80, %[off]")
+                __ASM_EMIT("dec             %[nb]")
+                __ASM_EMIT("jnz             1b")
+                : [off] "+r" (off), [nb] "+r" (nb)
+                : [dst] "r" (dst), [c1] "r" (c1), [c2] "r" (c2),
+                  [FFT_DIT] "o" (FFT_X16_DIT)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5"
+            );
+        }
+
+        static inline void fastconv_apply_internal(float *dst, const float *c, size_t nb)
+        {
+            ARCH_X86_ASM
+            (
+                __ASM_EMIT("1:")
+                    __ASM_EMIT("vmovups         0x00(%[dst]), %%zmm0")
+                    __ASM_EMIT("vmovups         0x40(%[dst]), %%zmm1")
+                    FASTCONV_X16_DIRECT_BODY
+                    /* Apply convolution */
+                    __ASM_EMIT("vmulps          0x40(%[c]), %%zmm3, %%zmm0")        /* zmm0 = a_im * b_im */
+                    __ASM_EMIT("vmulps          0x40(%[c]), %%zmm2, %%zmm1")        /* zmm1 = a_re * b_im */
+                    __ASM_EMIT("vfmsub231ps     0x00(%[c]), %%zmm2, %%zmm0")        /* zmm0 = a_re * b_re - a_im * b_im */
+                    __ASM_EMIT("vfmadd231ps     0x00(%[c]), %%zmm3, %%zmm1")        /* zmm1 = a_re * b_im + a_im * b_re */
+                    FASTCONV_X16_REVERSE_BODY
+                    __ASM_EMIT("vmovups         %%zmm0, 0x00(%[dst])")
+                    __ASM_EMIT("vmovups         %%zmm1, 0x40(%[dst])")
+                __ASM_EMIT("add             $0x80, %[dst]")
+                __ASM_EMIT("add             $0x80, %[c]")
+                __ASM_EMIT("dec             %[nb]")
+                __ASM_EMIT("jnz             1b")
+                : [dst] "+r" (dst), [c] "+r" (c), [nb] "+r" (nb)
+                : [FFT_DIF] "o" (FFT_X16_DIF), [FFT_DIT] "o" (FFT_X16_DIT)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5"
+            );
+        }
+
+        #undef FASTCONV_X16_DIRECT_BODY
+        #undef FASTCONV_X16_REVERSE_BODY
+    } /* namespace avx512 */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_APPLY_H_ */
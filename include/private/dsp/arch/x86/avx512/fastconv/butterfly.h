@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 окт. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_BUTTERFLY_H_
+#define PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_BUTTERFLY_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_IMPL */
+
+namespace lsp
+{
+    namespace avx512
+    {
+        #define FASTCONV_DIRECT_BUTTERFLY_BODY16 \
+            ARCH_X86_ASM \
+            ( \
+                /* Prepare angle */ \
+                __ASM_EMIT("vmovaps         0x00(%[ak]), %%zmm6")               /* zmm6 = x_re */ \
+                __ASM_EMIT("vmovaps         0x40(%[ak]), %%zmm7")               /* zmm7 = x_im */ \
+                /* Start loop */ \
+                __ASM_EMIT("1:") \
+                    __ASM_EMIT("vmovups         0x00(%[dst], %[off1]), %%zmm0")     /* zmm0 = a_re */ \
+                    __ASM_EMIT("vmovups         0x40(%[dst], %[off1]), %%zmm1")     /* zmm1 = a_im */ \
+                    __ASM_EMIT("vmovups         0x00(%[dst], %[off2]), %%zmm2")     /* zmm2 = b_re */ \
+                    __ASM_EMIT("vmovups         0x40(%[dst], %[off2]), %%zmm3")     /* zmm3 = b_im */ \
+                    /* Perform butterfly */ \
+                    __ASM_EMIT("vsubps          %%zmm2, %%zmm0, %%zmm4")            /* zmm4 = c_re = a_re - b_re */ \
+                    __ASM_EMIT("vsubps          %%zmm3, %%zmm1, %%zmm5")            /* zmm5 = c_im = a_im - b_im */ \
+                    __ASM_EMIT("vaddps          %%zmm2, %%zmm0, %%zmm0")            /* zmm0 = a_re + b_re */ \
+                    __ASM_EMIT("vaddps          %%zmm3, %%zmm1, %%zmm1")            /* zmm1 = a_im + b_im */ \
+                    /* Calculate complex multiplication */ \
+                    __ASM_EMIT("vmulps          %%zmm7, %%zmm5, %%zmm2")            /* zmm2 = x_im * c_im */ \
+                    __ASM_EMIT("vmulps          %%zmm7, %%zmm4, %%zmm3")            /* zmm3 = x_im * c_re */ \
+                    __ASM_EMIT("vfmadd231ps     %%zmm6, %%zmm4, %%zmm2")            /* zmm2 = x_re * c_re + x_im * c_im */ \
+                    __ASM_EMIT("vfmsub231ps     %%zmm6, %%zmm5, %%zmm3")            /* zmm3 = x_re * c_im - x_im * c_re */ \
+                    /* Store values */ \
+                    __ASM_EMIT("vmovups         %%zmm0, 0x00(%[dst], %[off1])") \
+                    __ASM_EMIT("vmovups         %%zmm1, 0x40(%[dst], %[off1])") \
+                    __ASM_EMIT("vmovups         %%zmm2, 0x00(%[dst], %[off2])") \
+                    __ASM_EMIT("vmovups         %%zmm3, 0x40(%[dst], %[off2])") \
+                    __ASM_EMIT("add             $0x80, %[off1]") \
+                    __ASM_EMIT("add             $0x80, %[off2]") \
+                    __ASM_EMIT32("subl          $16, %[np]") \
+                    __ASM_EMIT64("subq          $16, %[np]") \
+                    __ASM_EMIT("jz              2f") \
+                    /* Rotate angle */ \
+                    __ASM_EMIT("vmulps          0x40(%[wk]), %%zmm6, %%zmm2")       /* zmm2 = w_im * x_re */ \
+                    __ASM_EMIT("vmulps          0x40(%[wk]), %%zmm7, %%zmm3")       /* zmm3 = w_im * x_im */ \
+                    __ASM_EMIT("vfmsub132ps     0x00(%[wk]), %%zmm3, %%zmm6")       /* zmm6 = x_re' = w_re * x_re - w_im * x_im */ \
+                    __ASM_EMIT("vfmadd132ps     0x00(%[wk]), %%zmm2, %%zmm7")       /* zmm7 = x_im' = w_re * x_im + w_im * x_re */ \
+                    /* Repeat loop */ \
+                __ASM_EMIT("jmp             1b") \
+                __ASM_EMIT("2:") \
+                \
+                : [off1] "+r" (off1), [off2] "+r" (off2), [np] __ASM_ARG_RW(np) \
+                : [dst] "r" (dst), [ak] "r" (ak), [wk] "r" (wk) \
+                : "cc", "memory",  \
+                "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                "%xmm4", "%xmm5", "%xmm6", "%xmm7"  \
+            );
+
+        #define FASTCONV_REVERSE_BUTTERFLY_BODY16 \
+            ARCH_X86_ASM \
+            ( \
+                /* Prepare angle */ \
+                __ASM_EMIT("vmovaps         0x00(%[ak]), %%zmm6")               /* zmm6 = x_re */ \
+                __ASM_EMIT("vmovaps         0x40(%[ak]), %%zmm7")               /* zmm7 = x_im */ \
+                /* Start loop */ \
+                __ASM_EMIT("1:") \
+                    __ASM_EMIT("vmovups         0x00(%[dst], %[off1]), %%zmm0")     /* zmm0 = a_re */ \
+                    __ASM_EMIT("vmovups         0x40(%[dst], %[off1]), %%zmm1")     /* zmm1 = a_im */ \
+                    __ASM_EMIT("vmovups         0x00(%[dst], %[off2]), %%zmm2")     /* zmm2 = b_re */ \
+                    __ASM_EMIT("vmovups         0x40(%[dst], %[off2]), %%zmm3")     /* zmm3 = b_im */ \
+                    /* Calculate complex multiplication */ \
+                    __ASM_EMIT("vmulps          %%zmm7, %%zmm3, %%zmm4")            /* zmm4 = x_im * b_im */ \
+                    __ASM_EMIT("vmulps          %%zmm7, %%zmm2, %%zmm5")            /* zmm5 = x_im * b_re */ \
+                    __ASM_EMIT("vfmsub231ps     %%zmm6, %%zmm2, %%zmm4")            /* zmm4 = c_re = x_re * b_re - x_im * b_im */ \
+                    __ASM_EMIT("vfmadd231ps     %%zmm6, %%zmm3, %%zmm5")            /* zmm5 = c_im = x_re * b_im + x_im * b_re */ \
+                    /* Perform butterfly */ \
+                    __ASM_EMIT("vsubps          %%zmm4, %%zmm0, %%zmm2")            /* zmm2 = a_re - c_re */ \
+                    __ASM_EMIT("vsubps          %%zmm5, %%zmm1, %%zmm3")            /* zmm3 = a_im - c_im */ \
+                    __ASM_EMIT("vaddps          %%zmm4, %%zmm0, %%zmm0")            /* zmm0 = a_re + c_re */ \
+                    __ASM_EMIT("vaddps          %%zmm5, %%zmm1, %%zmm1")            /* zmm1 = a_im + c_im */ \
+                    /* Store values */ \
+                    __ASM_EMIT("vmovups         %%zmm0, 0x00(%[dst], %[off1])") \
+                    __ASM_EMIT("vmovups         %%zmm1, 0x40(%[dst], %[off1])") \
+                    __ASM_EMIT("vmovups         %%zmm2, 0x00(%[dst], %[off2])") \
+                    __ASM_EMIT("vmovups         %%zmm3, 0x40(%[dst], %[off2])") \
+                    __ASM_EMIT("add             $0x80, %[off1]") \
+                    __ASM_EMIT("add             $0x80, %[off2]") \
+                    __ASM_EMIT32("subl          $16, %[np]") \
+                    __ASM_EMIT64("subq          $16, %[np]") \
+                    __ASM_EMIT("jz              2f") \
+                    /* Rotate angle */ \
+                    __ASM_EMIT("vmulps          0x40(%[wk]), %%zmm6, %%zmm2")       /* zmm2 = w_im * x_re */ \
+                    __ASM_EMIT("vmulps          0x40(%[wk]), %%zmm7, %%zmm3")       /* zmm3 = w_im * x_im */ \
+                    __ASM_EMIT("vfmsub132ps     0x00(%[wk]), %%zmm3, %%zmm6")       /* zmm6 = x_re' = w_re * x_re - w_im * x_im */ \
+                    __ASM_EMIT("vfmadd132ps     0x00(%[wk]), %%zmm2, %%zmm7")       /* zmm7 = x_im' = w_re * x_im + w_im * x_re */ \
+                    /* Repeat loop */ \
+                __ASM_EMIT("jmp             1b") \
+                __ASM_EMIT("2:") \
+                \
+                : [off1] "+r" (off1), [off2] "+r" (off2), [np] __ASM_ARG_RW(np) \
+                : [dst] "r" (dst), [ak] "r" (ak), [wk] "r" (wk) \
+                : "cc", "memory",  \
+                "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                "%xmm4", "%xmm5", "%xmm6", "%xmm7"  \
+            );
+
+        #define FASTCONV_REVERSE_BUTTERFLY_BODY_LAST(IF_ADD) \
+            size_t off; \
+            float norm = 0.5f / np; \
+            ARCH_X86_ASM \
+            ( \
+                /* Prepare angle */ \
+                __ASM_EMIT("vbroadcastss    %[norm], %%zmm1")                   /* zmm1 = k */ \
+                __ASM_EMIT("lea             (,%[np], 4), %[off]")               /* off  = np * 4 */ \
+                __ASM_EMIT("vmovaps         0x00(%[ak]), %%zmm6")               /* zmm6 = x_re */ \
+                __ASM_EMIT("vmovaps         0x40(%[ak]), %%zmm7")               /* zmm7 = x_im */ \
+                __ASM_EMIT("vmovaps         0x00(%[wk]), %%zmm4")               /* zmm4 = w_re */ \
+                __ASM_EMIT("vmovaps         0x40(%[wk]), %%zmm5")               /* zmm5 = w_im */ \
+                /* Start loop */ \
+                __ASM_EMIT("1:") \
+                    __ASM_EMIT("vmovups         0x00(%[src]), %%zmm0")              /* zmm0 = a_re */ \
+                    __ASM_EMIT("vmovups         0x00(%[src], %[off], 2), %%zmm2")   /* zmm2 = b_re */ \
+                    __ASM_EMIT("vmovups         0x40(%[src], %[off], 2), %%zmm3")   /* zmm3 = b_im */ \
+                    /* Calculate complex multiplication */ \
+                    __ASM_EMIT("vmulps          %%zmm7, %%zmm3, %%zmm3")            /* zmm3 = x_im * b_im */ \
+                    __ASM_EMIT("vfmsub231ps     %%zmm6, %%zmm2, %%zmm3")            /* zmm3 = c_re = x_re * b_re - x_im * b_im */ \
+                    /* Perform butterfly */ \
+                    __ASM_EMIT("vsubps          %%zmm3, %%zmm0, %%zmm2")            /* zmm2 = a_re - c_re */ \
+                    __ASM_EMIT("vaddps          %%zmm3, %%zmm0, %%zmm0")            /* zmm0 = a_re + c_re */ \
+                    /* Store values */ \
+                    __ASM_EMIT(IF_ADD("vfmadd213ps  0x00(%[dst]), %%zmm1, %%zmm0", "vmulps  %%zmm1, %%zmm0, %%zmm0")) \
+                    __ASM_EMIT(IF_ADD("vfmadd213ps  0x00(%[dst], %[off]), %%zmm1, %%zmm2", "vmulps  %%zmm1, %%zmm2, %%zmm2")) \
+                    __ASM_EMIT("vmovups         %%zmm0, 0x00(%[dst])") \
+                    __ASM_EMIT("vmovups         %%zmm2, 0x00(%[dst], %[off])") \
+                    __ASM_EMIT("add             $0x80, %[src]") \
+                    __ASM_EMIT("add             $0x40, %[dst]") \
+                    __ASM_EMIT32("subl          $16, %[np]") \
+                    __ASM_EMIT64("subq          $16, %[np]") \
+                    __ASM_EMIT("jbe             2f") \
+                    /* Rotate angle */ \
+                    __ASM_EMIT("vmulps          %%zmm5, %%zmm6, %%zmm2")            /* zmm2 = w_im * x_re */ \
+                    __ASM_EMIT("vmulps          %%zmm5, %%zmm7, %%zmm3")            /* zmm3 = w_im * x_im */ \
+                    __ASM_EMIT("vfmsub132ps     %%zmm4, %%zmm3, %%zmm6")            /* zmm6 = x_re' = w_re * x_re - w_im * x_im */ \
+                    __ASM_EMIT("vfmadd132ps     %%zmm4, %%zmm2, %%zmm7")            /* zmm7 = x_im' = w_re * x_im + w_im * x_re */ \
+                    /* Repeat loop */ \
+                __ASM_EMIT("jmp             1b") \
+                __ASM_EMIT("2:") \
+                \
+                : [dst] "+r" (dst), [src] "+r" (src), \
+                  [off] "=&r" (off), [np] __ASM_ARG_RW(np) \
+                : [ak] "r" (ak), [wk] "r" (wk), \
+                  [norm] "o" (norm) \
+                : "cc", "memory",  \
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7"  \
+            );
+
+        #define FASTCONV_SET(a, b)  b
+        #define FASTCONV_ADD(a, b)  a
+
+        static inline void fastconv_direct_butterfly(float *dst, const float *ak, const float *wk, size_t pairs, size_t nb)
+        {
+            size_t off1, off2, np;
+            off1        = 0;
+            size_t step = pairs << 3;
+            for (size_t i=0; i<nb; ++i)
+            {
+                off2        = off1 + step;
+                np          = pairs;
+
+                FASTCONV_DIRECT_BUTTERFLY_BODY16;
+
+                off1        = off2;
+            }
+        }
+
+        static inline void fastconv_reverse_butterfly(float *dst, const float *ak, const float *wk, size_t pairs, size_t nb)
+        {
+            size_t off1, off2, np;
+            off1        = 0;
+            size_t step = pairs << 3;
+            for (size_t i=0; i<nb; ++i)
+            {
+                off2        = off1 + step;
+                np          = pairs;
+
+                FASTCONV_REVERSE_BUTTERFLY_BODY16;
+
+                off1        = off2;
+            }
+        }
+
+        static inline void fastconv_reverse_butterfly_last(float *dst, const float *src, const float *ak, const float *wk, size_t np)
+        {
+            FASTCONV_REVERSE_BUTTERFLY_BODY_LAST(FASTCONV_SET);
+        }
+
+        static inline void fastconv_reverse_butterfly_last_adding(float *dst, const float *src, const float *ak, const float *wk, size_t np)
+        {
+            FASTCONV_REVERSE_BUTTERFLY_BODY_LAST(FASTCONV_ADD);
+        }
+
+        #undef FASTCONV_DIRECT_BUTTERFLY_BODY16
+        #undef FASTCONV_REVERSE_BUTTERFLY_BODY16
+        #undef FASTCONV_REVERSE_BUTTERFLY_BODY_LAST
+        #undef FASTCONV_SET
+        #undef FASTCONV_ADD
+    } /* namespace avx512 */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_BUTTERFLY_H_ */
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 10 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_MAC_H_
+#define PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_MAC_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_IMPL */
+
+namespace lsp
+{
+    namespace avx512
+    {
+        /*
+         * Number of partitions processed at once: the spectra of partitions are read by
+         * a few sequential streams which keeps the hardware prefetcher efficient for
+         * long delay lines.
+         */
+        static constexpr size_t FASTCONV_MAC_GROUP  = 8;
+
+        /*
+         * Sum of products of the block of 16 complex numbers stored as 16 real parts followed
+         * by 16 imaginary parts (zmm), or the block of 8 complex numbers for the rank 3 (ymm).
+         * The real and imaginary parts are split into two accumulators each to shorten
+         * the dependency chains. The first group stores the result, the next groups add
+         * the result to the destination.
+         */
+        #define FASTCONV_MAC_N_BLOCK(R, IM) \
+            ARCH_X86_ASM( \
+                __ASM_EMIT("vxorps          %%" R "0, %%" R "0, %%" R "0")      /* re1 */ \
+                __ASM_EMIT("vxorps          %%" R "1, %%" R "1, %%" R "1")      /* re2 */ \
+                __ASM_EMIT("vxorps          %%" R "2, %%" R "2, %%" R "2")      /* im1 */ \
+                __ASM_EMIT("vxorps          %%" R "3, %%" R "3, %%" R "3")      /* im2 */ \
+                __ASM_EMIT("mov             %[d], %[s]") \
+                __ASM_EMIT("mov             %[g], %[i]") \
+                __ASM_EMIT("test            %[i], %[i]") \
+                __ASM_EMIT("jz              1f") \
+                __ASM_EMIT("vmovups         0x00(%[s]), %%" R "0")              /* re1 = dr */ \
+                __ASM_EMIT("vmovups         " IM "(%[s]), %%" R "2")            /* im1 = di */ \
+                __ASM_EMIT("1:") \
+                __ASM_EMIT("mov             %[vs], %[sp]") \
+                __ASM_EMIT("mov             %[vk], %[kp]") \
+                __ASM_EMIT("mov             %[count], %[i]") \
+                __ASM_EMIT("test            %[i], %[i]") \
+                __ASM_EMIT("jz              3f") \
+                __ASM_EMIT("2:") \
+                    __ASM_EMIT("mov             (%[sp]), %[s]") \
+                    __ASM_EMIT("mov             (%[kp]), %[k]") \
+                    __ASM_EMIT("add             %[off], %[s]") \
+                    __ASM_EMIT("add             %[off], %[k]") \
+                    __ASM_EMIT("vmovups         0x00(%[s]), %%" R "4")                          /* ar */ \
+                    __ASM_EMIT("vmovups         " IM "(%[s]), %%" R "5")                        /* ai */ \
+                    __ASM_EMIT("vfmadd231ps     0x00(%[k]), %%" R "4, %%" R "0")                /* re1 += ar*br */ \
+                    __ASM_EMIT("vfmadd231ps     " IM "(%[k]), %%" R "5, %%" R "1")              /* re2 += ai*bi */ \
+                    __ASM_EMIT("vfmadd231ps     " IM "(%[k]), %%" R "4, %%" R "2")              /* im1 += ar*bi */ \
+                    __ASM_EMIT("vfmadd231ps     0x00(%[k]), %%" R "5, %%" R "3")                /* im2 += ai*br */ \
+                    __ASM_EMIT("add             %[ptr], %[sp]") \
+                    __ASM_EMIT("add             %[ptr], %[kp]") \
+                    __ASM_EMIT("dec             %[i]") \
+                    __ASM_EMIT("jnz             2b") \
+                __ASM_EMIT("3:") \
+                __ASM_EMIT("vsubps          %%" R "1, %%" R "0, %%" R "0")      /* re1 - re2 */ \
+                __ASM_EMIT("vaddps          %%" R "3, %%" R "2, %%" R "2")      /* im1 + im2 */ \
+                __ASM_EMIT("mov             %[d], %[s]") \
+                __ASM_EMIT("vmovups         %%" R "0, 0x00(%[s])") \
+                __ASM_EMIT("vmovups         %%" R "2, " IM "(%[s])") \
+                : [sp] "=&r" (sp), [kp] "=&r" (kp), [i] "=&r" (i), \
+                  [s] "=&r" (s), [k] "=&r" (k) \
+                : [vs] "m" (vs), [vk] "m" (vk), [count] "m" (count), \
+                  [off] "m" (off), [d] "m" (d), [g] "m" (g), \
+                  [ptr] "i" (sizeof(const float *)) \
+                : "cc", "memory", \
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                  "%xmm4", "%xmm5" \
+            );
+
+        void fastconv_mac_n(float *dst, const float * const *spectra, const float * const *kernels, size_t n, size_t rank)
+        {
+            const float * const *sp, * const *kp;
+            const float *s, *k;
+            size_t i;
+            size_t g            = 0;
+
+            do
+            {
+                const size_t count  = lsp_min(n - g, FASTCONV_MAC_GROUP);
+                const float * const *vs = &spectra[g];
+                const float * const *vk = &kernels[g];
+
+                if (rank < 4)
+                {
+                    const size_t off    = 0;
+                    float *d            = dst;
+                    FASTCONV_MAC_N_BLOCK("ymm", "0x20");
+                }
+                else
+                {
+                    const size_t bytes  = size_t(4) << (rank + 1);
+                    for (size_t off=0; off < bytes; off += 0x80)
+                    {
+                        float *d            = &dst[off >> 2];
+                        FASTCONV_MAC_N_BLOCK("zmm", "0x40");
+                    }
+                }
+
+                g                  += FASTCONV_MAC_GROUP;
+            } while (g < n);
+        }
+
+        #undef FASTCONV_MAC_N_BLOCK
+    } /* namespace avx512 */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_MAC_H_ */
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 окт. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_PREPARE_H_
+#define PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_PREPARE_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_IMPL */
+
+namespace lsp
+{
+    namespace avx512
+    {
+        /*
+         * The fast convolution stores complex numbers as blocks of 16 real parts
+         * followed by 16 imaginary parts, so each block occupies 0x80 bytes
+         */
+        static inline void fastconv_direct_prepare(float *dst, const float *src, const float *ak, const float *wk, size_t np)
+        {
+            size_t off;
+
+            ARCH_X86_ASM(
+                __ASM_EMIT("lea                 (,%[np], 8), %[off]")
+                __ASM_EMIT("vmovaps             0x00(%[ak]), %%zmm6")               /* zmm6 = x_re */
+                __ASM_EMIT("vmovaps             0x40(%[ak]), %%zmm7")               /* zmm7 = x_im */
+                __ASM_EMIT("vmovaps             0x00(%[wk]), %%zmm4")               /* zmm4 = w_re */
+                __ASM_EMIT("vmovaps             0x40(%[wk]), %%zmm5")               /* zmm5 = w_im */
+                __ASM_EMIT("vxorps              %%zmm1, %%zmm1, %%zmm1")            /* zmm1 = a_im = 0 */
+                __ASM_EMIT("1:")
+                    __ASM_EMIT("vmovups             0x00(%[src]), %%zmm0")              /* zmm0 = a_re = re */
+                    __ASM_EMIT("vmulps              %%zmm0, %%zmm7, %%zmm3")            /* zmm3 = x_im * re */
+                    __ASM_EMIT("vmulps              %%zmm0, %%zmm6, %%zmm2")            /* zmm2 = b_re = x_re * re */
+                    __ASM_EMIT("vsubps              %%zmm3, %%zmm1, %%zmm3")            /* zmm3 = b_im = -x_im * re */
+                    __ASM_EMIT("vmovups             %%zmm0, 0x00(%[dst])")
+                    __ASM_EMIT("vmovups             %%zmm1, 0x40(%[dst])")
+                    __ASM_EMIT("vmovups             %%zmm2, 0x00(%[dst], %[off])")
+                    __ASM_EMIT("vmovups             %%zmm3, 0x40(%[dst], %[off])")
+                    __ASM_EMIT("add                 $0x40, %[src]")
+                    __ASM_EMIT("add                 $0x80, %[dst]")
+                    __ASM_EMIT32("subl              $16, %[np]")
+                    __ASM_EMIT64("sub               $16, %[np]")
+                    __ASM_EMIT("jz                  2f")
+                    /* Rotate angle */
+                    __ASM_EMIT("vmulps              %%zmm5, %%zmm6, %%zmm2")            /* zmm2 = w_im * x_re */
+                    __ASM_EMIT("vmulps              %%zmm5, %%zmm7, %%zmm3")            /* zmm3 = w_im * x_im */
+                    __ASM_EMIT("vfmsub132ps         %%zmm4, %%zmm3, %%zmm6")            /* zmm6 = x_re' = w_re * x_re - w_im * x_im */
+                    __ASM_EMIT("vfmadd132ps         %%zmm4, %%zmm2, %%zmm7")            /* zmm7 = x_im' = w_re * x_im + w_im * x_re */
+                __ASM_EMIT("jmp                 1b")
+                __ASM_EMIT("2:")
+                : [dst] "+r" (dst), [src] "+r" (src),
+                  [off] "=&r" (off), [np] __ASM_ARG_RW(np)
+                : [ak] "r" (ak), [wk] "r" (wk)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+            );
+        }
+
+        static inline void fastconv_direct_unpack(float *dst, const float *src)
+        {
+            // Unpack 8 real samples into the block of 16 complex numbers
+            ARCH_X86_ASM(
+                __ASM_EMIT("vxorps              %%ymm1, %%ymm1, %%ymm1")            /* zmm1 = 0 */
+                __ASM_EMIT("vmovups             0x00(%[src]), %%ymm0")              /* zmm0 = s0 ... s7 0 ... 0 */
+                __ASM_EMIT("vmovups             %%zmm0, 0x00(%[dst])")
+                __ASM_EMIT("vmovups             %%zmm1, 0x40(%[dst])")
+                :
+                : [dst] "r" (dst), [src] "r" (src)
+                : "memory",
+                  "%xmm0", "%xmm1"
+            );
+        }
+
+        static inline void fastconv_reverse_unpack(float *dst, const float *src)
+        {
+            float norm = 1.0f / 16.0f;
+
+            ARCH_X86_ASM(
+                __ASM_EMIT("vbroadcastss        %[norm], %%zmm0")
+                __ASM_EMIT("vmulps              0x00(%[src]), %%zmm0, %%zmm1")
+                __ASM_EMIT("vmovups             %%zmm1, 0x00(%[dst])")
+                :
+                : [dst] "r" (dst), [src] "r" (src),
+                  [norm] "m" (norm)
+                : "memory",
+                  "%xmm0", "%xmm1"
+            );
+        }
+
+        static inline void fastconv_reverse_unpack_adding(float *dst, const float *src)
+        {
+            float norm = 1.0f / 16.0f;
+
+            ARCH_X86_ASM(
+                __ASM_EMIT("vbroadcastss        %[norm], %%zmm0")
+                __ASM_EMIT("vmovups             0x00(%[dst]), %%zmm1")
+                __ASM_EMIT("vfmadd231ps         0x00(%[src]), %%zmm0, %%zmm1")
+                __ASM_EMIT("vmovups             %%zmm1, 0x00(%[dst])")
+                :
+                : [dst] "r" (dst), [src] "r" (src),
+                  [norm] "m" (norm)
+                : "memory",
+                  "%xmm0", "%xmm1"
+            );
+        }
+    } /* namespace avx512 */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_FASTCONV_PREPARE_H_ */
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 28 окт. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_FFT_H_
+#define PRIVATE_DSP_ARCH_X86_AVX512_FFT_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_IMPL */
+
+#include <private/dsp/arch/x86/avx512/fft/const.h>
+#include <private/dsp/arch/x86/avx512/fft/scramble.h>
+#include <private/dsp/arch/x86/avx512/fft/butterfly.h>
+#include <private/dsp/arch/x86/avx512/fft/blocked.h>
+
+namespace lsp
+{
+    namespace avx512
+    {
+        /**
+         * Transform of rank below 4 which does not fill the whole register,
+         * computed directly from the definition of DFT
+         *
+         * @param dst_re real part of the spectrum
+         * @param dst_im imaginary part of the spectrum
+         * @param src_re real part of the signal
+         * @param src_im imaginary part of the signal
+         * @param rank the rank of the transform
+         * @param dir the direction: 1 for direct and -1 for reverse transform
+         */
+        static void small_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank, float dir)
+        {
+            // cos(k*pi/4), sin(k*pi/4)
+            static const float w_re[] = { 1.0f, M_SQRT1_2, 0.0f, -M_SQRT1_2, -1.0f, -M_SQRT1_2, 0.0f, M_SQRT1_2 };
+            static const float w_im[] = { 0.0f, M_SQRT1_2, 1.0f, M_SQRT1_2, 0.0f, -M_SQRT1_2, -1.0f, -M_SQRT1_2 };
+
+            float x_re[8], x_im[8];
+            size_t n        = 1 << rank;
+            size_t step     = 8 >> rank;
+            float k         = (dir > 0.0f) ? 1.0f : 1.0f / n;
+
+            for (size_t i=0; i<n; ++i)
+            {
+                float s_re      = 0.0f;
+                float s_im      = 0.0f;
+                for (size_t j=0; j<n; ++j)
+                {
+                    size_t a        = (i * j * step) & 0x07;
+                    s_re           += src_re[j] * w_re[a] + dir * src_im[j] * w_im[a];
+                    s_im           += src_im[j] * w_re[a] - dir * src_re[j] * w_im[a];
+                }
+                x_re[i]         = s_re * k;
+                x_im[i]         = s_im * k;
+            }
+
+            for (size_t i=0; i<n; ++i)
+            {
+                dst_re[i]       = x_re[i];
+                dst_im[i]       = x_im[i];
+            }
+        }
+
+        void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
+        {
+            // Check bounds
+            if (rank < 4)
+            {
+                small_fft(dst_re, dst_im, src_re, src_im, rank, 1.0f);
+                return;
+            }
+
+            if ((dst_re == src_re) || (dst_im == src_im))
+            {
+                dsp::move(dst_re, src_re, 1 << rank);
+                dsp::move(dst_im, src_im, 1 << rank);
+                scramble_self_direct16(dst_re, dst_im, rank);
+            }
+            else if (rank > FFT_LARGE_RANK)
+            {
+                fft_large_transform(dst_re, dst_im, src_re, src_im, rank, scramble_self_direct16, butterfly_direct16p, butterfly_direct16p_x2);
+                return;
+            }
+            else
+                scramble_copy_direct16(dst_re, dst_im, src_re, src_im, rank);
+
+            fft_butterfly_blocked(dst_re, dst_im, 4, rank, butterfly_direct16p, butterfly_direct16p_x2);
+        }
+
+        void reverse_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
+        {
+            // Check bounds
+            if (rank < 4)
+            {
+                small_fft(dst_re, dst_im, src_re, src_im, rank, -1.0f);
+                return;
+            }
+
+            if ((dst_re == src_re) || (dst_im == src_im))
+            {
+                dsp::move(dst_re, src_re, 1 << rank);
+                dsp::move(dst_im, src_im, 1 << rank);
+                scramble_self_reverse16(dst_re, dst_im, rank);
+            }
+            else if (rank > FFT_LARGE_RANK)
+            {
+                fft_large_transform(dst_re, dst_im, src_re, src_im, rank, scramble_self_reverse16, butterfly_reverse16p, butterfly_reverse16p_x2);
+                dsp::normalize_fft2(dst_re, dst_im, rank);
+                return;
+            }
+            else
+                scramble_copy_reverse16(dst_re, dst_im, src_re, src_im, rank);
+
+            fft_butterfly_blocked(dst_re, dst_im, 4, rank, butterfly_reverse16p, butterfly_reverse16p_x2);
+            dsp::normalize_fft2(dst_re, dst_im, rank);
+        }
+    } /* namespace avx512 */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_FFT_H_ */
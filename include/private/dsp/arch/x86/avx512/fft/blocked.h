@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 28 окт. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_FFT_BLOCKED_H_
+#define PRIVATE_DSP_ARCH_X86_AVX512_FFT_BLOCKED_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_IMPL */
+
+namespace lsp
+{
+    namespace avx512
+    {
+        /**
+         * The maximum rank of the sub-transform which is processed with plain
+         * iterative butterflies, 4096 complex numbers (32 KB) fit L1 cache
+         */
+        static constexpr size_t FFT_BLOCK_RANK      = 12;
+
+        /**
+         * The maximum rank of the out-of-place transform which is scrambled directly,
+         * bit-reversal permutation of larger transforms misses cache almost at each sample
+         */
+        static constexpr size_t FFT_LARGE_RANK      = 17;
+
+        typedef void (* fft_butterfly_t)(float *dst_re, float *dst_im, size_t rank, size_t blocks);
+        typedef void (* fft_scramble_t)(float *dst_re, float *dst_im, size_t rank);
+
+        /**
+         * Perform butterfly stages [first, rank) of the transform in cache-oblivious order:
+         * all quarters of the buffer are transformed recursively before the two final stages
+         * are applied, so each sub-transform stays in the nearest cache level that is
+         * able to hold it instead of streaming the whole buffer once per stage. Pairs of
+         * adjacent stages are performed by the radix-4 butterfly in one pass.
+         *
+         * @param dst_re real part of the data
+         * @param dst_im imaginary part of the data
+         * @param first the first butterfly stage to perform
+         * @param rank the rank of the transform
+         * @param butterfly radix-2 butterfly function
+         * @param butterfly2 radix-4 butterfly function
+         */
+        static void fft_butterfly_blocked(float *dst_re, float *dst_im, size_t first, size_t rank,
+            fft_butterfly_t butterfly, fft_butterfly_t butterfly2)
+        {
+            if (rank <= FFT_BLOCK_RANK)
+            {
+                size_t i = first;
+                for ( ; (i + 1) < rank; i += 2)
+                    butterfly2(dst_re, dst_im, i, 1 << (rank - i - 2));
+                if (i < rank)
+                    butterfly(dst_re, dst_im, i, 1 << (rank - i - 1));
+                return;
+            }
+
+            if ((rank - 2) < first)
+            {
+                size_t half = 1 << (rank - 1);
+                fft_butterfly_blocked(dst_re, dst_im, first, rank - 1, butterfly, butterfly2);
+                fft_butterfly_blocked(&dst_re[half], &dst_im[half], first, rank - 1, butterfly, butterfly2);
+                butterfly(dst_re, dst_im, rank - 1, 1);
+                return;
+            }
+
+            size_t quarter = 1 << (rank - 2);
+            for (size_t i=0; i<4; ++i)
+                fft_butterfly_blocked(&dst_re[i * quarter], &dst_im[i * quarter], first, rank - 2, butterfly, butterfly2);
+            butterfly2(dst_re, dst_im, rank - 2, 1);
+        }
+
+        /**
+         * Gather the samples of the signal into the sub-transforms of rank FFT_BLOCK_RANK.
+         * The signal is considered as a matrix of (1 << FFT_BLOCK_RANK) rows and (1 << stages)
+         * columns which is transposed by tiles of 16x16 elements, the rows of the transposed
+         * matrix are placed in the bit-reversed order. After that the bit-reversal permutation
+         * of the whole signal is obtained by local bit-reversal of each sub-transform.
+         *
+         * @param dst destination buffer
+         * @param src source buffer
+         * @param stages number of stages above FFT_BLOCK_RANK
+         */
+        static void fft_gather_blocks(float *dst, const float *src, size_t stages)
+        {
+            size_t cols     = 1 << stages;
+
+            for (size_t m=0; m < (1 << FFT_BLOCK_RANK); m += 16)
+            {
+                for (size_t j=0; j < cols; j += 16)
+                {
+                    const float *s  = &src[m * cols + j];
+                    for (size_t k=0; k < 16; ++k, ++s)
+                    {
+                        float *d        = &dst[(reverse_bits(uint32_t(j + k), stages) << FFT_BLOCK_RANK) + m];
+                        for (size_t i=0; i<16; ++i)
+                            d[i]            = s[i * cols];
+                    }
+                }
+            }
+        }
+
+        /**
+         * Perform out-of-place transform of rank above FFT_LARGE_RANK. Instead of the bit-reversal
+         * permutation of the whole buffer, the signal is gathered into cache-sized sub-transforms,
+         * each sub-transform is scrambled and processed while it stays in cache, and the remaining
+         * stages are performed in cache-oblivious order.
+         *
+         * @param dst_re real part of the spectrum
+         * @param dst_im imaginary part of the spectrum
+         * @param src_re real part of the signal
+         * @param src_im imaginary part of the signal
+         * @param rank the rank of the transform
+         * @param scramble self-scramble function for the sub-transform
+         * @param butterfly radix-2 butterfly function
+         * @param butterfly2 radix-4 butterfly function
+         */
+        static void fft_large_transform(float *dst_re, float *dst_im, const float *src_re, const float *src_im,
+            size_t rank, fft_scramble_t scramble, fft_butterfly_t butterfly, fft_butterfly_t butterfly2)
+        {
+            size_t stages   = rank - FFT_BLOCK_RANK;
+            fft_gather_blocks(dst_re, src_re, stages);
+            fft_gather_blocks(dst_im, src_im, stages);
+
+            for (size_t off=0, n=1 << rank; off < n; off += (1 << FFT_BLOCK_RANK))
+            {
+                scramble(&dst_re[off], &dst_im[off], FFT_BLOCK_RANK);
+                fft_butterfly_blocked(&dst_re[off], &dst_im[off], 4, FFT_BLOCK_RANK, butterfly, butterfly2);
+            }
+
+            fft_butterfly_blocked(dst_re, dst_im, FFT_BLOCK_RANK, rank, butterfly, butterfly2);
+        }
+    } /* namespace avx512 */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_FFT_BLOCKED_H_ */
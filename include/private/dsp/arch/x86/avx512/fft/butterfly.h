@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 28 окт. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_FFT_BUTTERFLY_H_
+#define PRIVATE_DSP_ARCH_X86_AVX512_FFT_BUTTERFLY_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_IMPL */
+
+namespace lsp
+{
+    namespace avx512
+    {
+        #define FFT_BUTTERFLY_BODY16(add_b, add_a) \
+            __IF_32(float *ptr1, *ptr2);\
+            \
+            ARCH_X86_ASM \
+            ( \
+                /* Prepare angle */ \
+                __ASM_EMIT32("mov           %[fft_a], %[ptr2]") \
+                __ASM_EMIT32("mov           %[dst_re], %[ptr1]") \
+                __ASM_EMIT("vmovaps         0x00(%[" __IF_32_64("ptr2", "fft_a") "]), %%zmm6")        /* zmm6 = x_re */ \
+                __ASM_EMIT("vmovaps         0x40(%[" __IF_32_64("ptr2", "fft_a") "]), %%zmm7")        /* zmm7 = x_im */ \
+                __ASM_EMIT32("mov           %[dst_im], %[ptr2]") \
+                /* Start loop */ \
+                __ASM_EMIT("1:") \
+                    __ASM_EMIT("vmovups         0x00(%[" __IF_32_64("ptr1", "dst_re") "], %[off1]), %%zmm0")    /* zmm0 = a_re */ \
+                    __ASM_EMIT("vmovups         0x00(%[" __IF_32_64("ptr1", "dst_re") "], %[off2]), %%zmm2")    /* zmm2 = b_re */ \
+                    __ASM_EMIT("vmovups         0x00(%[" __IF_32_64("ptr2", "dst_im") "], %[off1]), %%zmm1")    /* zmm1 = a_im */ \
+                    __ASM_EMIT("vmovups         0x00(%[" __IF_32_64("ptr2", "dst_im") "], %[off2]), %%zmm3")    /* zmm3 = b_im */ \
+                    /* Calculate complex multiplication */ \
+                    __ASM_EMIT("vmulps          %%zmm7, %%zmm2, %%zmm4")            /* zmm4 = x_im * b_re */ \
+                    __ASM_EMIT("vmulps          %%zmm7, %%zmm3, %%zmm5")            /* zmm5 = x_im * b_im */ \
+                    __ASM_EMIT(add_b " %%zmm6, %%zmm2, %%zmm5")                 /* zmm5 = c_re = x_re * b_re +- x_im * b_im */ \
+                    __ASM_EMIT(add_a " %%zmm6, %%zmm3, %%zmm4")                 /* zmm4 = c_im = x_re * b_im -+ x_im * b_re */ \
+                    /* Perform butterfly */ \
+                    __ASM_EMIT("vsubps          %%zmm5, %%zmm0, %%zmm2")            /* zmm2 = a_re - c_re */ \
+                    __ASM_EMIT("vsubps          %%zmm4, %%zmm1, %%zmm3")            /* zmm3 = a_im - c_im */ \
+                    __ASM_EMIT("vaddps          %%zmm5, %%zmm0, %%zmm0")            /* zmm0 = a_re + c_re */ \
+                    __ASM_EMIT("vaddps          %%zmm4, %%zmm1, %%zmm1")            /* zmm1 = a_im + c_im */ \
+                    /* Store values */ \
+                    __ASM_EMIT("vmovups         %%zmm0, 0x00(%[" __IF_32_64("ptr1", "dst_re") "], %[off1])") \
+                    __ASM_EMIT("vmovups         %%zmm2, 0x00(%[" __IF_32_64("ptr1", "dst_re") "], %[off2])") \
+                    __ASM_EMIT("vmovups         %%zmm1, 0x00(%[" __IF_32_64("ptr2", "dst_im") "], %[off1])") \
+                    __ASM_EMIT("vmovups         %%zmm3, 0x00(%[" __IF_32_64("ptr2", "dst_im") "], %[off2])") \
+                    __ASM_EMIT("add             $0x40, %[off1]") \
+                    __ASM_EMIT("add             $0x40, %[off2]") \
+                    __ASM_EMIT32("subl          $16, %[np]") \
+                    __ASM_EMIT64("subq          $16, %[np]") \
+                    __ASM_EMIT("jz              2f") \
+                    /* Rotate angle */ \
+                    __ASM_EMIT32("mov           %[fft_w], %[ptr2]") \
+                    __ASM_EMIT("vmovaps         0x00(%[" __IF_32_64("ptr2", "fft_w") "]), %%zmm4")        /* zmm4 = w_re */ \
+                    __ASM_EMIT("vmovaps         0x40(%[" __IF_32_64("ptr2", "fft_w") "]), %%zmm5")        /* zmm5 = w_im */ \
+                    __ASM_EMIT32("mov           %[dst_im], %[ptr2]") \
+                    __ASM_EMIT("vmulps          %%zmm5, %%zmm6, %%zmm2")            /* zmm2 = w_im * x_re */ \
+                    __ASM_EMIT("vmulps          %%zmm5, %%zmm7, %%zmm3")            /* zmm3 = w_im * x_im */ \
+                    __ASM_EMIT("vfmsub132ps     %%zmm4, %%zmm3, %%zmm6")        /* zmm6 = x_re' = w_re * x_re - w_im * x_im */ \
+                    __ASM_EMIT("vfmadd132ps     %%zmm4, %%zmm2, %%zmm7")        /* zmm7 = x_im' = w_re * x_im + w_im * x_re */ \
+                    /* Repeat loop */ \
+                __ASM_EMIT("jmp             1b") \
+                __ASM_EMIT("2:") \
+                \
+                : __IF_32([ptr1] "=&r" (ptr1), [ptr2] "=&r" (ptr2), ) \
+                  [off1] "+r" (off1), [off2] "+r" (off2), \
+                  [np] X86_PGREG (np) \
+                : [dst_re] X86_GREG (dst_re), [dst_im] X86_GREG (dst_im), [fft_a] X86_GREG (fft_a), [fft_w] X86_GREG (fft_w) \
+                : "cc", "memory",  \
+                "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                "%xmm4", "%xmm5", "%xmm6", "%xmm7"  \
+            );
+
+        /*
+         * Radix-4 butterfly which performs two adjacent radix-2 stages of the transform in one pass:
+         *   a' = a + w*b, b' = a - w*b, c' = c + w*d, d' = c - w*d      (stage rank, w = W[k])
+         *   a" = a' + v*c', c" = a' - v*c'                              (stage rank+1, v = V[k])
+         *   b" = b' -+ j*v*d', d" = b' +- j*v*d'                        (v*W[k + pairs] = -+ j*v)
+         * Uses 16 registers, so it is available for x86_64 only
+         */
+        #define FFT_BUTTERFLY_X2_BODY16(add_b, add_a, op_b, op_a) \
+            ARCH_X86_64_ASM \
+            ( \
+                /* Prepare angles */ \
+                __ASM_EMIT("vmovaps         0x00(%[fft_a1]), %%zmm12")          /* zmm12 = w_re */ \
+                __ASM_EMIT("vmovaps         0x40(%[fft_a1]), %%zmm13")          /* zmm13 = w_im */ \
+                __ASM_EMIT("vmovaps         0x00(%[fft_a2]), %%zmm14")          /* zmm14 = v_re */ \
+                __ASM_EMIT("vmovaps         0x40(%[fft_a2]), %%zmm15")          /* zmm15 = v_im */ \
+                /* Start loop */ \
+                __ASM_EMIT("1:") \
+                    __ASM_EMIT("vmovups         0x00(%[dst_re], %[off2]), %%zmm2")  /* zmm2 = b_re */ \
+                    __ASM_EMIT("vmovups         0x00(%[dst_im], %[off2]), %%zmm3")  /* zmm3 = b_im */ \
+                    __ASM_EMIT("vmovups         0x00(%[dst_re], %[off4]), %%zmm6")  /* zmm6 = d_re */ \
+                    __ASM_EMIT("vmovups         0x00(%[dst_im], %[off4]), %%zmm7")  /* zmm7 = d_im */ \
+                    /* 1st stage: calculate complex multiplications */ \
+                    __ASM_EMIT("vmulps          %%zmm13, %%zmm2, %%zmm8")           /* zmm8 = w_im * b_re */ \
+                    __ASM_EMIT("vmulps          %%zmm13, %%zmm3, %%zmm9")           /* zmm9 = w_im * b_im */ \
+                    __ASM_EMIT("vmulps          %%zmm13, %%zmm6, %%zmm10")          /* zmm10 = w_im * d_re */ \
+                    __ASM_EMIT("vmulps          %%zmm13, %%zmm7, %%zmm11")          /* zmm11 = w_im * d_im */ \
+                    __ASM_EMIT(add_b " %%zmm12, %%zmm2, %%zmm9")                /* zmm9 = wb_re = w_re * b_re +- w_im * b_im */ \
+                    __ASM_EMIT(add_a " %%zmm12, %%zmm3, %%zmm8")                /* zmm8 = wb_im = w_re * b_im -+ w_im * b_re */ \
+                    __ASM_EMIT(add_b " %%zmm12, %%zmm6, %%zmm11")               /* zmm11 = wd_re = w_re * d_re +- w_im * d_im */ \
+                    __ASM_EMIT(add_a " %%zmm12, %%zmm7, %%zmm10")               /* zmm10 = wd_im = w_re * d_im -+ w_im * d_re */ \
+                    /* 1st stage: perform butterflies */ \
+                    __ASM_EMIT("vmovups         0x00(%[dst_re], %[off1]), %%zmm0")  /* zmm0 = a_re */ \
+                    __ASM_EMIT("vmovups         0x00(%[dst_im], %[off1]), %%zmm1")  /* zmm1 = a_im */ \
+                    __ASM_EMIT("vmovups         0x00(%[dst_re], %[off3]), %%zmm4")  /* zmm4 = c_re */ \
+                    __ASM_EMIT("vmovups         0x00(%[dst_im], %[off3]), %%zmm5")  /* zmm5 = c_im */ \
+                    __ASM_EMIT("vsubps          %%zmm9, %%zmm0, %%zmm2")            /* zmm2 = b_re' = a_re - wb_re */ \
+                    __ASM_EMIT("vsubps          %%zmm8, %%zmm1, %%zmm3")            /* zmm3 = b_im' = a_im - wb_im */ \
+                    __ASM_EMIT("vaddps          %%zmm9, %%zmm0, %%zmm0")            /* zmm0 = a_re' = a_re + wb_re */ \
+                    __ASM_EMIT("vaddps          %%zmm8, %%zmm1, %%zmm1")            /* zmm1 = a_im' = a_im + wb_im */ \
+                    __ASM_EMIT("vsubps          %%zmm11, %%zmm4, %%zmm6")           /* zmm6 = d_re' = c_re - wd_re */ \
+                    __ASM_EMIT("vsubps          %%zmm10, %%zmm5, %%zmm7")           /* zmm7 = d_im' = c_im - wd_im */ \
+                    __ASM_EMIT("vaddps          %%zmm11, %%zmm4, %%zmm4")           /* zmm4 = c_re' = c_re + wd_re */ \
+                    __ASM_EMIT("vaddps          %%zmm10, %%zmm5, %%zmm5")           /* zmm5 = c_im' = c_im + wd_im */ \
+                    /* 2nd stage: calculate complex multiplications */ \
+                    __ASM_EMIT("vmulps          %%zmm15, %%zmm4, %%zmm8")           /* zmm8 = v_im * c_re' */ \
+                    __ASM_EMIT("vmulps          %%zmm15, %%zmm5, %%zmm9")           /* zmm9 = v_im * c_im' */ \
+                    __ASM_EMIT("vmulps          %%zmm15, %%zmm6, %%zmm10")          /* zmm10 = v_im * d_re' */ \
+                    __ASM_EMIT("vmulps          %%zmm15, %%zmm7, %%zmm11")          /* zmm11 = v_im * d_im' */ \
+                    __ASM_EMIT(add_b " %%zmm14, %%zmm4, %%zmm9")                /* zmm9 = vc_re = v_re * c_re' +- v_im * c_im' */ \
+                    __ASM_EMIT(add_a " %%zmm14, %%zmm5, %%zmm8")                /* zmm8 = vc_im = v_re * c_im' -+ v_im * c_re' */ \
+                    __ASM_EMIT(add_b " %%zmm14, %%zmm6, %%zmm11")               /* zmm11 = vd_re = v_re * d_re' +- v_im * d_im' */ \
+                    __ASM_EMIT(add_a " %%zmm14, %%zmm7, %%zmm10")               /* zmm10 = vd_im = v_re * d_im' -+ v_im * d_re' */ \
+                    /* 2nd stage: perform butterflies */ \
+                    __ASM_EMIT("vsubps          %%zmm9, %%zmm0, %%zmm4")            /* zmm4 = c_re" = a_re' - vc_re */ \
+                    __ASM_EMIT("vsubps          %%zmm8, %%zmm1, %%zmm5")            /* zmm5 = c_im" = a_im' - vc_im */ \
+                    __ASM_EMIT("vaddps          %%zmm9, %%zmm0, %%zmm0")            /* zmm0 = a_re" = a_re' + vc_re */ \
+                    __ASM_EMIT("vaddps          %%zmm8, %%zmm1, %%zmm1")            /* zmm1 = a_im" = a_im' + vc_im */ \
+                    __ASM_EMIT(op_a "           %%zmm10, %%zmm2, %%zmm6")           /* zmm6 = d_re" = b_re' -+ vd_im */ \
+                    __ASM_EMIT(op_b "           %%zmm11, %%zmm3, %%zmm7")           /* zmm7 = d_im" = b_im' +- vd_re */ \
+                    __ASM_EMIT(op_b "           %%zmm10, %%zmm2, %%zmm2")           /* zmm2 = b_re" = b_re' +- vd_im */ \
+                    __ASM_EMIT(op_a "           %%zmm11, %%zmm3, %%zmm3")           /* zmm3 = b_im" = b_im' -+ vd_re */ \
+                    /* Store values */ \
+                    __ASM_EMIT("vmovups         %%zmm0, 0x00(%[dst_re], %[off1])") \
+                    __ASM_EMIT("vmovups         %%zmm1, 0x00(%[dst_im], %[off1])") \
+                    __ASM_EMIT("vmovups         %%zmm2, 0x00(%[dst_re], %[off2])") \
+                    __ASM_EMIT("vmovups         %%zmm3, 0x00(%[dst_im], %[off2])") \
+                    __ASM_EMIT("vmovups         %%zmm4, 0x00(%[dst_re], %[off3])") \
+                    __ASM_EMIT("vmovups         %%zmm5, 0x00(%[dst_im], %[off3])") \
+                    __ASM_EMIT("vmovups         %%zmm6, 0x00(%[dst_re], %[off4])") \
+                    __ASM_EMIT("vmovups         %%zmm7, 0x00(%[dst_im], %[off4])") \
+                    __ASM_EMIT("add             $0x40, %[off1]") \
+                    __ASM_EMIT("add             $0x40, %[off2]") \
+                    __ASM_EMIT("add             $0x40, %[off3]") \
+                    __ASM_EMIT("add             $0x40, %[off4]") \
+                    __ASM_EMIT("sub             $16, %[np]") \
+                    __ASM_EMIT("jz              2f") \
+                    /* Rotate angles */ \
+                    __ASM_EMIT("vmovaps         0x00(%[fft_w1]), %%zmm0")           /* zmm0 = dw_re */ \
+                    __ASM_EMIT("vmovaps         0x40(%[fft_w1]), %%zmm1")           /* zmm1 = dw_im */ \
+                    __ASM_EMIT("vmovaps         0x00(%[fft_w2]), %%zmm4")           /* zmm4 = dv_re */ \
+                    __ASM_EMIT("vmovaps         0x40(%[fft_w2]), %%zmm5")           /* zmm5 = dv_im */ \
+                    __ASM_EMIT("vmulps          %%zmm1, %%zmm12, %%zmm2")           /* zmm2 = dw_im * w_re */ \
+                    __ASM_EMIT("vmulps          %%zmm1, %%zmm13, %%zmm3")           /* zmm3 = dw_im * w_im */ \
+                    __ASM_EMIT("vmulps          %%zmm5, %%zmm14, %%zmm6")           /* zmm6 = dv_im * v_re */ \
+                    __ASM_EMIT("vmulps          %%zmm5, %%zmm15, %%zmm7")           /* zmm7 = dv_im * v_im */ \
+                    __ASM_EMIT("vfmsub132ps     %%zmm0, %%zmm3, %%zmm12")       /* zmm12 = w_re' = dw_re * w_re - dw_im * w_im */ \
+                    __ASM_EMIT("vfmadd132ps     %%zmm0, %%zmm2, %%zmm13")       /* zmm13 = w_im' = dw_re * w_im + dw_im * w_re */ \
+                    __ASM_EMIT("vfmsub132ps     %%zmm4, %%zmm7, %%zmm14")       /* zmm14 = v_re' = dv_re * v_re - dv_im * v_im */ \
+                    __ASM_EMIT("vfmadd132ps     %%zmm4, %%zmm6, %%zmm15")       /* zmm15 = v_im' = dv_re * v_im + dv_im * v_re */ \
+                    /* Repeat loop */ \
+                __ASM_EMIT("jmp             1b") \
+                __ASM_EMIT("2:") \
+                \
+                : [off1] "+r" (off1), [off2] "+r" (off2), [off3] "+r" (off3), [off4] "+r" (off4), \
+                  [np] "+r" (np) \
+                : [dst_re] "r" (dst_re), [dst_im] "r" (dst_im), \
+                  [fft_a1] "r" (fft_a1), [fft_w1] "r" (fft_w1), \
+                  [fft_a2] "r" (fft_a2), [fft_w2] "r" (fft_w2) \
+                : "cc", "memory",  \
+                "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                "%xmm4", "%xmm5", "%xmm6", "%xmm7", \
+                "%xmm8", "%xmm9", "%xmm10", "%xmm11", \
+                "%xmm12", "%xmm13", "%xmm14", "%xmm15" \
+            );
+
+        static inline void butterfly_direct16p(float *dst_re, float *dst_im, size_t rank, size_t blocks)
+        {
+            size_t pairs = 1 << rank;
+            size_t off1 = 0, shift = 4 << rank; // 1 << (rank + 2);
+            const float *fft_a, *fft_w;
+            float xw[64] __lsp_aligned64;
+            fft_twiddle_rows(fft_a, fft_w, xw, rank);
+
+            for (size_t b=0; b<blocks; ++b)
+            {
+                size_t off2  = off1 + shift;
+                size_t np    = pairs;
+
+                FFT_BUTTERFLY_BODY16("vfmadd231ps", "vfmsub231ps");
+
+                off1        = off2;
+            }
+        }
+
+        static inline void butterfly_reverse16p(float *dst_re, float *dst_im, size_t rank, size_t blocks)
+        {
+            size_t pairs = 1 << rank;
+            size_t off1 = 0, shift = 4 << rank; // 1 << (rank + 2);
+            const float *fft_a, *fft_w;
+            float xw[64] __lsp_aligned64;
+            fft_twiddle_rows(fft_a, fft_w, xw, rank);
+
+            for (size_t b=0; b<blocks; ++b)
+            {
+                size_t off2  = off1 + shift;
+                size_t np    = pairs;
+
+                FFT_BUTTERFLY_BODY16("vfmsub231ps", "vfmadd231ps");
+
+                off1        = off2;
+            }
+        }
+
+        static inline void butterfly_direct16p_x2(float *dst_re, float *dst_im, size_t rank, size_t blocks)
+        {
+        #ifdef ARCH_X86_64
+            size_t pairs = 1 << rank;
+            size_t shift = 4 << rank; // 1 << (rank + 2);
+            const float *fft_a1, *fft_w1, *fft_a2, *fft_w2;
+            float xw1[64] __lsp_aligned64;
+            float xw2[64] __lsp_aligned64;
+            fft_twiddle_rows(fft_a1, fft_w1, xw1, rank);
+            fft_twiddle_rows(fft_a2, fft_w2, xw2, rank + 1);
+
+            for (size_t b=0; b<blocks; ++b)
+            {
+                size_t off1  = b * (shift << 2);
+                size_t off2  = off1 + shift;
+                size_t off3  = off2 + shift;
+                size_t off4  = off3 + shift;
+                size_t np    = pairs;
+
+                FFT_BUTTERFLY_X2_BODY16("vfmadd231ps", "vfmsub231ps", "vaddps", "vsubps");
+            }
+        #else
+            butterfly_direct16p(dst_re, dst_im, rank, blocks << 1);
+            butterfly_direct16p(dst_re, dst_im, rank + 1, blocks);
+        #endif /* ARCH_X86_64 */
+        }
+
+        static inline void butterfly_reverse16p_x2(float *dst_re, float *dst_im, size_t rank, size_t blocks)
+        {
+        #ifdef ARCH_X86_64
+            size_t pairs = 1 << rank;
+            size_t shift = 4 << rank; // 1 << (rank + 2);
+            const float *fft_a1, *fft_w1, *fft_a2, *fft_w2;
+            float xw1[64] __lsp_aligned64;
+            float xw2[64] __lsp_aligned64;
+            fft_twiddle_rows(fft_a1, fft_w1, xw1, rank);
+            fft_twiddle_rows(fft_a2, fft_w2, xw2, rank + 1);
+
+            for (size_t b=0; b<blocks; ++b)
+            {
+                size_t off1  = b * (shift << 2);
+                size_t off2  = off1 + shift;
+                size_t off3  = off2 + shift;
+                size_t off4  = off3 + shift;
+                size_t np    = pairs;
+
+                FFT_BUTTERFLY_X2_BODY16("vfmsub231ps", "vfmadd231ps", "vsubps", "vaddps");
+            }
+        #else
+            butterfly_reverse16p(dst_re, dst_im, rank, blocks << 1);
+            butterfly_reverse16p(dst_re, dst_im, rank + 1, blocks);
+        #endif /* ARCH_X86_64 */
+        }
+
+        #undef FFT_BUTTERFLY_BODY16
+        #undef FFT_BUTTERFLY_X2_BODY16
+    } /* namespace avx512 */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_FFT_BUTTERFLY_H_ */
@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 28 окт. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_FFT_SCRAMBLE_H_
+#define PRIVATE_DSP_ARCH_X86_AVX512_FFT_SCRAMBLE_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_IMPL */
+
+namespace lsp
+{
+    namespace avx512
+    {
+        /*
+         * Perform the first four stages of the transform for the block of 16 complex
+         * numbers stored in zmm0 (real part) and zmm1 (imaginary part). Each stage takes
+         * the pair of lanes with permutations and computes a + w*b with per-lane factors
+         * of the FFT_X16_DIT table. The result is stored in zmm0 and zmm1.
+         */
+        #define FFT_X16_DIRECT_BODY \
+            /* 1st stage: p = 1 */ \
+            __ASM_EMIT("vmovsldup       %%zmm0, %%zmm2")                            /* zmm2 = a_re = r0 r0 r2 r2 ... */ \
+            __ASM_EMIT("vmovshdup       %%zmm0, %%zmm4")                            /* zmm4 = b_re = r1 r1 r3 r3 ... */ \
+            __ASM_EMIT("vmovsldup       %%zmm1, %%zmm3")                            /* zmm3 = a_im */ \
+            __ASM_EMIT("vmovshdup       %%zmm1, %%zmm5")                            /* zmm5 = b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x000 + %[FFT_X16], %%zmm4, %%zmm2")        /* zmm2 = a_re +- b_re */ \
+            __ASM_EMIT("vfmadd231ps     0x000 + %[FFT_X16], %%zmm5, %%zmm3")        /* zmm3 = a_im +- b_im */ \
+            /* 2nd stage: p = 2 */ \
+            __ASM_EMIT("vpermilps       $0x44, %%zmm2, %%zmm0")                     /* a_re = x_re[i & ~2] */ \
+            __ASM_EMIT("vpermilps       $0xee, %%zmm2, %%zmm4")                     /* b_re = x_re[i | 2] */ \
+            __ASM_EMIT("vpermilps       $0x44, %%zmm3, %%zmm1")                     /* a_im = x_im[i & ~2] */ \
+            __ASM_EMIT("vpermilps       $0xee, %%zmm3, %%zmm5")                     /* b_im = x_im[i | 2] */ \
+            __ASM_EMIT("vfmadd231ps     0x040 + %[FFT_X16], %%zmm4, %%zmm0")        /* a_re += w_re * b_re */ \
+            __ASM_EMIT("vfmadd231ps     0x080 + %[FFT_X16], %%zmm5, %%zmm0")        /* a_re += w_im * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x040 + %[FFT_X16], %%zmm5, %%zmm1")        /* a_im += w_re * b_im */ \
+            __ASM_EMIT("vfnmadd231ps    0x080 + %[FFT_X16], %%zmm4, %%zmm1")        /* a_im -= w_im * b_re */ \
+            /* 3rd stage: p = 4 */ \
+            __ASM_EMIT("vshuff32x4      $0xa0, %%zmm0, %%zmm0, %%zmm2")             /* a_re = x_re[i & ~4] */ \
+            __ASM_EMIT("vshuff32x4      $0xf5, %%zmm0, %%zmm0, %%zmm4")             /* b_re = x_re[i | 4] */ \
+            __ASM_EMIT("vshuff32x4      $0xa0, %%zmm1, %%zmm1, %%zmm3")             /* a_im = x_im[i & ~4] */ \
+            __ASM_EMIT("vshuff32x4      $0xf5, %%zmm1, %%zmm1, %%zmm5")             /* b_im = x_im[i | 4] */ \
+            __ASM_EMIT("vfmadd231ps     0x0c0 + %[FFT_X16], %%zmm4, %%zmm2")        /* a_re += w_re * b_re */ \
+            __ASM_EMIT("vfmadd231ps     0x100 + %[FFT_X16], %%zmm5, %%zmm2")        /* a_re += w_im * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x0c0 + %[FFT_X16], %%zmm5, %%zmm3")        /* a_im += w_re * b_im */ \
+            __ASM_EMIT("vfnmadd231ps    0x100 + %[FFT_X16], %%zmm4, %%zmm3")        /* a_im -= w_im * b_re */ \
+            /* 4th stage: p = 8 */ \
+            __ASM_EMIT("vshuff32x4      $0x44, %%zmm2, %%zmm2, %%zmm0")             /* a_re = x_re[i & ~8] */ \
+            __ASM_EMIT("vshuff32x4      $0xee, %%zmm2, %%zmm2, %%zmm4")             /* b_re = x_re[i | 8] */ \
+            __ASM_EMIT("vshuff32x4      $0x44, %%zmm3, %%zmm3, %%zmm1")             /* a_im = x_im[i & ~8] */ \
+            __ASM_EMIT("vshuff32x4      $0xee, %%zmm3, %%zmm3, %%zmm5")             /* b_im = x_im[i | 8] */ \
+            __ASM_EMIT("vfmadd231ps     0x140 + %[FFT_X16], %%zmm4, %%zmm0")        /* a_re += w_re * b_re */ \
+            __ASM_EMIT("vfmadd231ps     0x180 + %[FFT_X16], %%zmm5, %%zmm0")        /* a_re += w_im * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x140 + %[FFT_X16], %%zmm5, %%zmm1")        /* a_im += w_re * b_im */ \
+            __ASM_EMIT("vfnmadd231ps    0x180 + %[FFT_X16], %%zmm4, %%zmm1")        /* a_im -= w_im * b_re */
+
+        #define FFT_X16_REVERSE_BODY \
+            /* 1st stage: p = 1 */ \
+            __ASM_EMIT("vmovsldup       %%zmm0, %%zmm2")                            /* zmm2 = a_re = r0 r0 r2 r2 ... */ \
+            __ASM_EMIT("vmovshdup       %%zmm0, %%zmm4")                            /* zmm4 = b_re = r1 r1 r3 r3 ... */ \
+            __ASM_EMIT("vmovsldup       %%zmm1, %%zmm3")                            /* zmm3 = a_im */ \
+            __ASM_EMIT("vmovshdup       %%zmm1, %%zmm5")                            /* zmm5 = b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x000 + %[FFT_X16], %%zmm4, %%zmm2")        /* zmm2 = a_re +- b_re */ \
+            __ASM_EMIT("vfmadd231ps     0x000 + %[FFT_X16], %%zmm5, %%zmm3")        /* zmm3 = a_im +- b_im */ \
+            /* 2nd stage: p = 2 */ \
+            __ASM_EMIT("vpermilps       $0x44, %%zmm2, %%zmm0")                     /* a_re = x_re[i & ~2] */ \
+            __ASM_EMIT("vpermilps       $0xee, %%zmm2, %%zmm4")                     /* b_re = x_re[i | 2] */ \
+            __ASM_EMIT("vpermilps       $0x44, %%zmm3, %%zmm1")                     /* a_im = x_im[i & ~2] */ \
+            __ASM_EMIT("vpermilps       $0xee, %%zmm3, %%zmm5")                     /* b_im = x_im[i | 2] */ \
+            __ASM_EMIT("vfmadd231ps     0x040 + %[FFT_X16], %%zmm4, %%zmm0")        /* a_re += w_re * b_re */ \
+            __ASM_EMIT("vfnmadd231ps    0x080 + %[FFT_X16], %%zmm5, %%zmm0")        /* a_re -= w_im * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x040 + %[FFT_X16], %%zmm5, %%zmm1")        /* a_im += w_re * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x080 + %[FFT_X16], %%zmm4, %%zmm1")        /* a_im += w_im * b_re */ \
+            /* 3rd stage: p = 4 */ \
+            __ASM_EMIT("vshuff32x4      $0xa0, %%zmm0, %%zmm0, %%zmm2")             /* a_re = x_re[i & ~4] */ \
+            __ASM_EMIT("vshuff32x4      $0xf5, %%zmm0, %%zmm0, %%zmm4")             /* b_re = x_re[i | 4] */ \
+            __ASM_EMIT("vshuff32x4      $0xa0, %%zmm1, %%zmm1, %%zmm3")             /* a_im = x_im[i & ~4] */ \
+            __ASM_EMIT("vshuff32x4      $0xf5, %%zmm1, %%zmm1, %%zmm5")             /* b_im = x_im[i | 4] */ \
+            __ASM_EMIT("vfmadd231ps     0x0c0 + %[FFT_X16], %%zmm4, %%zmm2")        /* a_re += w_re * b_re */ \
+            __ASM_EMIT("vfnmadd231ps    0x100 + %[FFT_X16], %%zmm5, %%zmm2")        /* a_re -= w_im * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x0c0 + %[FFT_X16], %%zmm5, %%zmm3")        /* a_im += w_re * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x100 + %[FFT_X16], %%zmm4, %%zmm3")        /* a_im += w_im * b_re */ \
+            /* 4th stage: p = 8 */ \
+            __ASM_EMIT("vshuff32x4      $0x44, %%zmm2, %%zmm2, %%zmm0")             /* a_re = x_re[i & ~8] */ \
+            __ASM_EMIT("vshuff32x4      $0xee, %%zmm2, %%zmm2, %%zmm4")             /* b_re = x_re[i | 8] */ \
+            __ASM_EMIT("vshuff32x4      $0x44, %%zmm3, %%zmm3, %%zmm1")             /* a_im = x_im[i & ~8] */ \
+            __ASM_EMIT("vshuff32x4      $0xee, %%zmm3, %%zmm3, %%zmm5")             /* b_im = x_im[i | 8] */ \
+            __ASM_EMIT("vfmadd231ps     0x140 + %[FFT_X16], %%zmm4, %%zmm0")        /* a_re += w_re * b_re */ \
+            __ASM_EMIT("vfnmadd231ps    0x180 + %[FFT_X16], %%zmm5, %%zmm0")        /* a_re -= w_im * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x140 + %[FFT_X16], %%zmm5, %%zmm1")        /* a_im += w_re * b_im */ \
+            __ASM_EMIT("vfmadd231ps     0x180 + %[FFT_X16], %%zmm4, %%zmm1")        /* a_im += w_im * b_re */
+
+        /*
+         * The first four stages of the transform performed on the data which has
+         * already been scrambled in-place, the rank should be at least 4
+         */
+        static inline void fft_start_direct(float *dst_re, float *dst_im, size_t rank)
+        {
+            size_t off      = 0;
+            size_t items    = 1 << (rank - 4);
+
+            ARCH_X86_ASM
+            (
+                __ASM_EMIT("1:")
+                    __ASM_EMIT("vmovups         0x00(%[dst_re], %[off]), %%zmm0")
+                    __ASM_EMIT("vmovups         0x00(%[dst_im], %[off]), %%zmm1")
+                    FFT_X16_DIRECT_BODY
+                    __ASM_EMIT("vmovups         %%zmm0, 0x00(%[dst_re], %[off])")
+                    __ASM_EMIT("vmovups         %%zmm1, 0x00(%[dst_im], %[off])")
+                    __ASM_EMIT("add             $0x40, %[off]")
+                    __ASM_EMIT("dec             %[items]")
+                    __ASM_EMIT("jnz             1b")
+                : [off] "+r" (off), [items] "+r" (items)
+                : [dst_re] "r" (dst_re), [dst_im] "r" (dst_im),
+                  [FFT_X16] "o" (FFT_X16_DIT)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5"
+            );
+        }
+
+        static inline void fft_start_reverse(float *dst_re, float *dst_im, size_t rank)
+        {
+            size_t off      = 0;
+            size_t items    = 1 << (rank - 4);
+
+            ARCH_X86_ASM
+            (
+                __ASM_EMIT("1:")
+                    __ASM_EMIT("vmovups         0x00(%[dst_re], %[off]), %%zmm0")
+                    __ASM_EMIT("vmovups         0x00(%[dst_im], %[off]), %%zmm1")
+                    FFT_X16_REVERSE_BODY
+                    __ASM_EMIT("vmovups         %%zmm0, 0x00(%[dst_re], %[off])")
+                    __ASM_EMIT("vmovups         %%zmm1, 0x00(%[dst_im], %[off])")
+                    __ASM_EMIT("add             $0x40, %[off]")
+                    __ASM_EMIT("dec             %[items]")
+                    __ASM_EMIT("jnz             1b")
+                : [off] "+r" (off), [items] "+r" (items)
+                : [dst_re] "r" (dst_re), [dst_im] "r" (dst_im),
+                  [FFT_X16] "o" (FFT_X16_DIT)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5"
+            );
+        }
+
+        static inline void scramble_self_direct16(float *dst_re, float *dst_im, size_t rank)
+        {
+            // Perform bit-reversal permutation
+            size_t items    = (1 << rank) - 1;
+            for (size_t i = 1; i < items; ++i)
+            {
+                size_t j = reverse_bits(uint32_t(i), rank);
+                if (i >= j)
+                    continue;
+
+                float re        = dst_re[i];
+                float im        = dst_im[i];
+                dst_re[i]       = dst_re[j];
+                dst_im[i]       = dst_im[j];
+                dst_re[j]       = re;
+                dst_im[j]       = im;
+            }
+
+            // Perform first four stages
+            fft_start_direct(dst_re, dst_im, rank);
+        }
+
+        static inline void scramble_copy_direct16(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
+        {
+            // Element k of the block j is read from position rev(k) << (rank - 4) | rev(j)
+            uint32_t step[16] __lsp_aligned64;
+            size_t shift    = rank - 4;
+            for (size_t k=0; k<16; ++k)
+                step[k]         = reverse_bits(uint32_t(k), 4) << shift;
+
+            for (size_t j=0, items = 1 << shift; j < items; ++j)
+            {
+                uint32_t base   = reverse_bits(uint32_t(j), shift);
+
+                ARCH_X86_ASM
+                (
+                    __ASM_EMIT("vpbroadcastd    %[base], %%zmm6")
+                    __ASM_EMIT("vpaddd          %[step], %%zmm6, %%zmm6")                /* zmm6 = indices of the block */
+                    __ASM_EMIT("kxnorw          %%k0, %%k0, %%k1")
+                    __ASM_EMIT("kxnorw          %%k0, %%k0, %%k2")
+                    __ASM_EMIT("vgatherdps      (%[src_re], %%zmm6, 4), %%zmm0 %{%%k1%}")
+                    __ASM_EMIT("vgatherdps      (%[src_im], %%zmm6, 4), %%zmm1 %{%%k2%}")
+                    FFT_X16_DIRECT_BODY
+                    __ASM_EMIT("vmovups         %%zmm0, 0x00(%[dst_re])")
+                    __ASM_EMIT("vmovups         %%zmm1, 0x00(%[dst_im])")
+                    :
+                    : [dst_re] "r" (dst_re), [dst_im] "r" (dst_im),
+                      [src_re] "r" (src_re), [src_im] "r" (src_im),
+                      [base] "m" (base), [step] "m" (step),
+                      [FFT_X16] "o" (FFT_X16_DIT)
+                    : "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                      "%xmm4", "%xmm5", "%xmm6",
+                      "%k1", "%k2"
+                );
+
+                dst_re         += 16;
+                dst_im         += 16;
+            }
+        }
+
+        static inline void scramble_self_reverse16(float *dst_re, float *dst_im, size_t rank)
+        {
+            // Perform bit-reversal permutation
+            size_t items    = (1 << rank) - 1;
+            for (size_t i = 1; i < items; ++i)
+            {
+                size_t j = reverse_bits(uint32_t(i), rank);
+                if (i >= j)
+                    continue;
+
+                float re        = dst_re[i];
+                float im        = dst_im[i];
+                dst_re[i]       = dst_re[j];
+                dst_im[i]       = dst_im[j];
+                dst_re[j]       = re;
+                dst_im[j]       = im;
+            }
+
+            // Perform first four stages
+            fft_start_reverse(dst_re, dst_im, rank);
+        }
+
+        static inline void scramble_copy_reverse16(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
+        {
+            // Element k of the block j is read from position rev(k) << (rank - 4) | rev(j)
+            uint32_t step[16] __lsp_aligned64;
+            size_t shift    = rank - 4;
+            for (size_t k=0; k<16; ++k)
+                step[k]         = reverse_bits(uint32_t(k), 4) << shift;
+
+            for (size_t j=0, items = 1 << shift; j < items; ++j)
+            {
+                uint32_t base   = reverse_bits(uint32_t(j), shift);
+
+                ARCH_X86_ASM
+                (
+                    __ASM_EMIT("vpbroadcastd    %[base], %%zmm6")
+                    __ASM_EMIT("vpaddd          %[step], %%zmm6, %%zmm6")                /* zmm6 = indices of the block */
+                    __ASM_EMIT("kxnorw          %%k0, %%k0, %%k1")
+                    __ASM_EMIT("kxnorw          %%k0, %%k0, %%k2")
+                    __ASM_EMIT("vgatherdps      (%[src_re], %%zmm6, 4), %%zmm0 %{%%k1%}")
+                    __ASM_EMIT("vgatherdps      (%[src_im], %%zmm6, 4), %%zmm1 %{%%k2%}")
+                    FFT_X16_REVERSE_BODY
+                    __ASM_EMIT("vmovups         %%zmm0, 0x00(%[dst_re])")
+                    __ASM_EMIT("vmovups         %%zmm1, 0x00(%[dst_im])")
+                    :
+                    : [dst_re] "r" (dst_re), [dst_im] "r" (dst_im),
+                      [src_re] "r" (src_re), [src_im] "r" (src_im),
+                      [base] "m" (base), [step] "m" (step),
+                      [FFT_X16] "o" (FFT_X16_DIT)
+                    : "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                      "%xmm4", "%xmm5", "%xmm6",
+                      "%k1", "%k2"
+                );
+
+                dst_re         += 16;
+                dst_im         += 16;
+            }
+        }
+
+        #undef FFT_X16_DIRECT_BODY
+        #undef FFT_X16_REVERSE_BODY
+    } /* namespace avx512 */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_FFT_SCRAMBLE_H_ */
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_FFTPLAN_H_
+#define PRIVATE_DSP_ARCH_X86_AVX512_FFTPLAN_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_IMPL */
+
+namespace lsp
+{
+    namespace avx512
+    {
+        /*
+         * The plan replaces the bit-reversal part of the in-place scramble with the
+         * precomputed list of swapped pairs, the rest of the transform is performed
+         * by the same kernels as the in-place direct_fft() and reverse_fft().
+         * The transform of packed complex data is left to the AVX implementation.
+         */
+        static inline void fft_plan_swap(const dsp::fft_plan_t *plan, float *re, float *im)
+        {
+            const uint32_t *sw  = plan->swap;
+            for (size_t i=0; i<plan->nswap; ++i, sw += 2)
+            {
+                const size_t a  = sw[0];
+                const size_t b  = sw[1];
+                float t         = re[a];
+                re[a]           = re[b];
+                re[b]           = t;
+                t               = im[a];
+                im[a]           = im[b];
+                im[b]           = t;
+            }
+        }
+
+        void fft_plan_direct(const dsp::fft_plan_t *plan, float *re, float *im)
+        {
+            const size_t rank   = plan->rank;
+            if (rank < 4)
+            {
+                small_fft(re, im, re, im, rank, 1.0f);
+                return;
+            }
+
+            fft_plan_swap(plan, re, im);
+            fft_start_direct(re, im, rank);
+            fft_butterfly_blocked(re, im, 4, rank, butterfly_direct16p, butterfly_direct16p_x2);
+        }
+
+        void fft_plan_reverse(const dsp::fft_plan_t *plan, float *re, float *im)
+        {
+            const size_t rank   = plan->rank;
+            if (rank < 4)
+            {
+                small_fft(re, im, re, im, rank, -1.0f);
+                return;
+            }
+
+            fft_plan_swap(plan, re, im);
+            fft_start_reverse(re, im, rank);
+            fft_butterfly_blocked(re, im, 4, rank, butterfly_reverse16p, butterfly_reverse16p_x2);
+            dsp::normalize_fft2(re, im, rank);
+        }
+    } /* namespace avx512 */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_FFTPLAN_H_ */
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 7 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_FILTERS_MULTICHANNEL_H_
+#define PRIVATE_DSP_ARCH_X86_AVX512_FILTERS_MULTICHANNEL_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_IMPL */
+
+namespace lsp
+{
+    namespace avx512
+    {
+        /*
+         * The context of the 16-lane filter:
+         *   +0x000 b0[16]
+         *   +0x040 b1[16]
+         *   +0x080 b2[16]
+         *   +0x0c0 a1[16]
+         *   +0x100 a2[16]
+         *   +0x140 d0[16]
+         *   +0x180 d1[16]
+         */
+        #define BIQUAD_MC16_CTX_SIZE    112
+
+        /*
+         * Process 16 interleaved channels, the distance between frames is stride bytes
+         */
+        static void biquad_mc16_core(float *dst, const float *src, size_t count, size_t stride, float *ctx)
+        {
+            ARCH_X86_ASM
+            (
+                __ASM_EMIT64("test          %[count], %[count]")
+                __ASM_EMIT32("cmpl          $0, %[count]")
+                __ASM_EMIT("jz              2f")
+                __ASM_EMIT("vmovaps         0x140(%[ctx]), %%zmm6")             /* zmm6     = d0 */
+                __ASM_EMIT("vmovaps         0x180(%[ctx]), %%zmm7")             /* zmm7     = d1 */
+
+                __ASM_EMIT("1:")
+                __ASM_EMIT("vmovups         (%[src]), %%zmm0")                  /* zmm0     = s */
+                __ASM_EMIT("vmulps          0x040(%[ctx]), %%zmm0, %%zmm1")     /* zmm1     = b1*s */
+                __ASM_EMIT("vmulps          0x080(%[ctx]), %%zmm0, %%zmm2")     /* zmm2     = b2*s */
+                __ASM_EMIT("vfmadd132ps     0x000(%[ctx]), %%zmm6, %%zmm0")     /* zmm0     = b0*s + d0 = s2 */
+                __ASM_EMIT("vaddps          %%zmm7, %%zmm1, %%zmm6")            /* zmm6     = b1*s + d1 */
+                __ASM_EMIT("vmovaps         %%zmm2, %%zmm7")                    /* zmm7     = b2*s */
+                __ASM_EMIT("vfmadd231ps     0x0c0(%[ctx]), %%zmm0, %%zmm6")     /* zmm6     = b1*s + a1*s2 + d1 = d0' */
+                __ASM_EMIT("vfmadd231ps     0x100(%[ctx]), %%zmm0, %%zmm7")     /* zmm7     = b2*s + a2*s2 = d1' */
+                __ASM_EMIT("vmovups         %%zmm0, (%[dst])")                  /* *dst     = s2 */
+                __ASM_EMIT("add             %[stride], %[src]")
+                __ASM_EMIT("add             %[stride], %[dst]")
+                __ASM_EMIT64("dec           %[count]")
+                __ASM_EMIT32("decl          %[count]")
+                __ASM_EMIT("jnz             1b")
+
+                __ASM_EMIT("vmovaps         %%zmm6, 0x140(%[ctx])")
+                __ASM_EMIT("vmovaps         %%zmm7, 0x180(%[ctx])")
+                __ASM_EMIT("2:")
+
+                : [dst] "+r" (dst), [src] "+r" (src),
+                  [count] X86_PGREG (count)
+                : [ctx] "r" (ctx), [stride] "r" (stride)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2",
+                  "%xmm6", "%xmm7"
+            );
+        }
+
+        void biquad_process_mc16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n)
+        {
+            float ctx[BIQUAD_MC16_CTX_SIZE] __lsp_aligned64;
+
+            for (size_t k=0; k<n; ++k, src = dst)
+            {
+                const float *fk = f[k].b0;
+                for (size_t i=0; i<80; ++i)
+                    ctx[i]          = fk[i];
+                for (size_t i=0; i<32; ++i)
+                    ctx[i + 80]     = d[i];
+
+                biquad_mc16_core(dst, src, count, 16 * sizeof(float), ctx);
+
+                for (size_t i=0; i<32; ++i)
+                    d[i]            = ctx[i + 80];
+                d              += 32;
+            }
+        }
+    } /* namespace avx512 */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_FILTERS_MULTICHANNEL_H_ */
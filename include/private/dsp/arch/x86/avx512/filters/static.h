@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 5 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_FILTERS_STATIC_H_
+#define PRIVATE_DSP_ARCH_X86_AVX512_FILTERS_STATIC_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_IMPL */
+
+namespace lsp
+{
+    namespace avx512
+    {
+        /*
+         * The x16 filter bank keeps 16 cascades in lanes of single register:
+         *   d      - delay buffer (d0 at +0x00, d1 at +0x40)
+         *   f      - coefficients (b0 at +0x00, b1 at +0x40, b2 at +0x80, a1 at +0xc0, a2 at +0x100)
+         *   step   - the step of the coefficient pointer after each processed sample
+         *            (0 for static filters, the size of x16 filter bank for dynamic filters)
+         */
+        #define BIQUAD_X16_STEP \
+            __ASM_EMIT("vmulps              0x40(%[f]), %%zmm1, %%zmm2")                        /* zmm2     = s*a1 */ \
+            __ASM_EMIT("vmulps              0x80(%[f]), %%zmm1, %%zmm3")                        /* zmm3     = s*a2 */ \
+            __ASM_EMIT("vfmadd132ps         0x00(%[f]), %%zmm6, %%zmm1")                        /* zmm1     = s*a0+d0 = s2 */ \
+            __ASM_EMIT("vfmadd231ps         0xc0(%[f]), %%zmm1, %%zmm2")                        /* zmm2     = s*a1 + s2*b1 = p1 */ \
+            __ASM_EMIT("vfmadd231ps         0x100(%[f]), %%zmm1, %%zmm3")                       /* zmm3     = s*a2 + s2*b2 = p2 */
+
+        static void biquad_process_x16_core(float *dst, const float *src, size_t count, float *d, const float *f, size_t step)
+        {
+            IF_ARCH_X86(size_t mask);
+            ARCH_X86_ASM
+            (
+                /* Check count */
+                __ASM_EMIT64("test              %[count], %[count]")
+                __ASM_EMIT32("cmpl              $0, %[count]")
+                __ASM_EMIT("jz                  8f")
+
+                /* Initialize masks */
+                /* zmm1={s,s2[16]}, zmm2=p1[16], zmm3=p2[16], zmm6=d0[16], zmm7=d1[16], k1=active lanes, k2=input lane */
+                __ASM_EMIT("mov                 $1, %[mask]")
+                __ASM_EMIT("kmovw               %k[mask], %%k2")                                    /* k2       = 1 */
+                __ASM_EMIT("kmovw               %k[mask], %%k1")                                    /* k1       = mask */
+                __ASM_EMIT("vxorps              %%zmm1, %%zmm1, %%zmm1")                            /* zmm1     = 0 */
+
+                /* Load delay buffer */
+                __ASM_EMIT("vmovups             0x00(%[d]), %%zmm6")                                /* zmm6     = d0 */
+                __ASM_EMIT("vmovups             0x40(%[d]), %%zmm7")                                /* zmm7     = d1 */
+
+                /* Process first 15 steps */
+                __ASM_EMIT("1:")
+                __ASM_EMIT("vbroadcastss        (%[src]), %%zmm1 %{%%k2%}")                         /* zmm1[0]  = *src */
+                __ASM_EMIT("add                 $4, %[src]")                                        /* src      ++ */
+                BIQUAD_X16_STEP
+                /* Update delay only by mask */
+                __ASM_EMIT("vaddps              %%zmm7, %%zmm2, %%zmm6 %{%%k1%}")                   /* zmm6     = (p1 + d1) & MASK | (d0 & ~MASK) */
+                __ASM_EMIT("vmovaps             %%zmm3, %%zmm7 %{%%k1%}")                           /* zmm7     = (p2 & MASK) | (d1 & ~MASK) */
+                /* Rotate buffer */
+                __ASM_EMIT("valignd             $15, %%zmm1, %%zmm1, %%zmm1")                       /* zmm1     = s2[15] s2[0] ... s2[14] */
+                /* Repeat loop */
+                __ASM_EMIT("add                 %[step], %[f]")                                     /* f       += step */
+                __ASM_EMIT64("dec               %[count]")
+                __ASM_EMIT32("decl              %[count]")
+                __ASM_EMIT("jz                  4f")                                                /* jump to completion */
+                __ASM_EMIT("lea                 0x01(,%[mask], 2), %[mask]")                        /* mask     = (mask << 1) | 1 */
+                __ASM_EMIT("kmovw               %k[mask], %%k1")                                    /* k1       = mask */
+                __ASM_EMIT("cmp                 $0xffff, %[mask]")
+                __ASM_EMIT("jne                 1b")
+
+                /* 16x filter processing without mask */
+                __ASM_EMIT(".align 16")
+                __ASM_EMIT("3:")
+                __ASM_EMIT("vbroadcastss        (%[src]), %%zmm1 %{%%k2%}")                         /* zmm1[0]  = *src */
+                __ASM_EMIT("add                 $4, %[src]")                                        /* src      ++ */
+                BIQUAD_X16_STEP
+                __ASM_EMIT("vaddps              %%zmm7, %%zmm2, %%zmm6")                            /* zmm6     = p1 + d1 */
+                __ASM_EMIT("vmovaps             %%zmm3, %%zmm7")                                    /* zmm7     = p2 */
+                /* Rotate buffer */
+                __ASM_EMIT("valignd             $15, %%zmm1, %%zmm1, %%zmm1")                       /* zmm1     = s2[15] s2[0] ... s2[14] */
+                __ASM_EMIT("vmovss              %%xmm1, (%[dst])")                                  /* *dst     = s2[15] */
+                /* Repeat loop */
+                __ASM_EMIT("add                 %[step], %[f]")                                     /* f       += step */
+                __ASM_EMIT("add                 $4, %[dst]")                                        /* dst      ++ */
+                __ASM_EMIT64("dec               %[count]")
+                __ASM_EMIT32("decl              %[count]")
+                __ASM_EMIT("jnz                 3b")
+
+                /* Prepare last loop, shift mask */
+                __ASM_EMIT("4:")
+                __ASM_EMIT("shl                 $1, %[mask]")                                       /* mask     = mask << 1 */
+                __ASM_EMIT("and                 $0xffff, %[mask]")                                  /* mask     = (mask << 1) & 0xffff */
+                __ASM_EMIT("kmovw               %k[mask], %%k1")                                    /* k1       = mask */
+
+                /* Process steps */
+                __ASM_EMIT("5:")
+                BIQUAD_X16_STEP
+                /* Update delay only by mask */
+                __ASM_EMIT("vaddps              %%zmm7, %%zmm2, %%zmm6 %{%%k1%}")                   /* zmm6     = (p1 + d1) & MASK | (d0 & ~MASK) */
+                __ASM_EMIT("vmovaps             %%zmm3, %%zmm7 %{%%k1%}")                           /* zmm7     = (p2 & MASK) | (d1 & ~MASK) */
+                /* Rotate buffer */
+                __ASM_EMIT("valignd             $15, %%zmm1, %%zmm1, %%zmm1")                       /* zmm1     = s2[15] s2[0] ... s2[14] */
+                __ASM_EMIT("add                 %[step], %[f]")                                     /* f       += step */
+                __ASM_EMIT("test                $0x8000, %[mask]")
+                __ASM_EMIT("jz                  6f")
+                __ASM_EMIT("vmovss              %%xmm1, (%[dst])")                                  /* *dst     = s2[15] */
+                __ASM_EMIT("add                 $4, %[dst]")                                        /* dst      ++ */
+                __ASM_EMIT("6:")
+                /* Repeat loop */
+                __ASM_EMIT("shl                 $1, %[mask]")                                       /* mask     = mask << 1 */
+                __ASM_EMIT("and                 $0xffff, %[mask]")                                  /* mask     = (mask << 1) & 0xffff */
+                __ASM_EMIT("kmovw               %k[mask], %%k1")                                    /* k1       = mask */
+                __ASM_EMIT("jnz                 5b")                                                /* check that mask is not zero */
+
+                /* Store delay buffer */
+                __ASM_EMIT("vmovups             %%zmm6, 0x00(%[d])")                                /* *d0      = %%zmm6 */
+                __ASM_EMIT("vmovups             %%zmm7, 0x40(%[d])")                                /* *d1      = %%zmm7 */
+
+                /* Exit label */
+                __ASM_EMIT("8:")
+
+                : [dst] "+r" (dst), [src] "+r" (src), [f] "+r" (f),
+                  [mask] "=&r"(mask),
+                  [count] X86_PGREG (count)
+                : [d] "r" (d), [step] "m" (step)
+                : "cc", "memory",
+                  "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm6", "%xmm7",
+                  "%k1", "%k2"
+            );
+        }
+
+        #undef BIQUAD_X16_STEP
+
+        void biquad_process_x16(float *dst, const float *src, size_t count, dsp::biquad16_t *f)
+        {
+            biquad_process_x16_core(dst, src, count, f->d, f->x16.b0, 0);
+        }
+    } /* namespace avx512 */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_AVX512_FILTERS_STATIC_H_ */
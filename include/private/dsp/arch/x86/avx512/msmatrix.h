@@ -107,8 +107,8 @@ namespace lsp
                 __ASM_EMIT("vmovups         %%xmm0, 0x00(%[mid], %[off])")
                 __ASM_EMIT("vmovups         %%xmm2, 0x00(%[side], %[off])")
                 __ASM_EMIT("add             $0x10, %[off]")
-                __ASM_EMIT32("subl          $8, %[count]")
-                __ASM_EMIT64("sub           $8, %[count]")
+                __ASM_EMIT32("subl          $4, %[count]")
+                __ASM_EMIT64("sub           $4, %[count]")
                 __ASM_EMIT("8:")
                 // 1x blocks
                 __ASM_EMIT32("addl          $3, %[count]")
@@ -273,8 +273,8 @@ namespace lsp
             ARCH_X86_ASM(
                 __ASM_EMIT("xor             %[off], %[off]")
                 // 64x blocks
-                __ASM_EMIT32("subl          $32, %[count]")
-                __ASM_EMIT64("sub           $32, %[count]")
+                __ASM_EMIT32("subl          $64, %[count]")
+                __ASM_EMIT64("sub           $64, %[count]")
                 __ASM_EMIT("jb              2f")
                 __ASM_EMIT("1:")
                 __ASM_EMIT("vmovups         0x00(%[mid], %[off]), %%zmm0")              // zmm0 = m
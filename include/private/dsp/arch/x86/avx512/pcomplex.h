@@ -1326,6 +1326,116 @@ namespace lsp
             );
         }
 
+        IF_ARCH_X86(
+            static const uint32_t pcomplex_modarg_idx[] __lsp_aligned64 =
+            {
+                0x00, 0x02, 0x04, 0x06, 0x08, 0x0a, 0x0c, 0x0e,     // real parts
+                0x10, 0x12, 0x14, 0x16, 0x18, 0x1a, 0x1c, 0x1e,
+                0x01, 0x03, 0x05, 0x07, 0x09, 0x0b, 0x0d, 0x0f,     // imaginary parts
+                0x11, 0x13, 0x15, 0x17, 0x19, 0x1b, 0x1d, 0x1f
+            };
+        )
+
+        #define PCOMPLEX_MODARG_FAST_CORE \
+            /* x16 blocks */ \
+            __ASM_EMIT32("subl          $16, %[count]") \
+            __ASM_EMIT64("sub           $16, %[count]") \
+            __ASM_EMIT  ("jb            2f") \
+            __ASM_EMIT  ("1:") \
+            __ASM_EMIT  ("vmovups       0x00(%[src]), %%zmm2") \
+            __ASM_EMIT  ("vmovups       0x40(%[src]), %%zmm3") \
+            __ASM_EMIT  ("vmovaps       0x00 + %[IDX], %%zmm0") \
+            __ASM_EMIT  ("vmovaps       0x40 + %[IDX], %%zmm1") \
+            __ASM_EMIT  ("vpermi2ps     %%zmm3, %%zmm2, %%zmm0") \
+            __ASM_EMIT  ("vpermi2ps     %%zmm3, %%zmm2, %%zmm1") \
+            COMPLEX_MOD_FAST_CORE("zmm") \
+            COMPLEX_ATAN2_FAST_CORE("zmm") \
+            __ASM_EMIT  ("vmovups       %%zmm6, 0x00(%[mod])") \
+            __ASM_EMIT  ("vmovups       %%zmm5, 0x00(%[arg])") \
+            __ASM_EMIT  ("add           $0x80, %[src]") \
+            __ASM_EMIT  ("add           $0x40, %[mod]") \
+            __ASM_EMIT  ("add           $0x40, %[arg]") \
+            __ASM_EMIT32("subl          $16, %[count]") \
+            __ASM_EMIT64("sub           $16, %[count]") \
+            __ASM_EMIT  ("jae           1b") \
+            __ASM_EMIT  ("2:") \
+            /* x8 block */ \
+            __ASM_EMIT32("addl          $8, %[count]") \
+            __ASM_EMIT64("add           $8, %[count]") \
+            __ASM_EMIT  ("jl            4f") \
+            __ASM_EMIT  ("vmovups       0x00(%[src]), %%ymm2") \
+            __ASM_EMIT  ("vmovups       0x20(%[src]), %%ymm3") \
+            __ASM_EMIT  ("vmovaps       0x00 + %[IDX], %%ymm0") \
+            __ASM_EMIT  ("vmovaps       0x40 + %[IDX], %%ymm1") \
+            __ASM_EMIT  ("vpermi2ps     %%ymm3, %%ymm2, %%ymm0") \
+            __ASM_EMIT  ("vpermi2ps     %%ymm3, %%ymm2, %%ymm1") \
+            COMPLEX_MOD_FAST_CORE("ymm") \
+            COMPLEX_ATAN2_FAST_CORE("ymm") \
+            __ASM_EMIT  ("vmovups       %%ymm6, 0x00(%[mod])") \
+            __ASM_EMIT  ("vmovups       %%ymm5, 0x00(%[arg])") \
+            __ASM_EMIT  ("add           $0x40, %[src]") \
+            __ASM_EMIT  ("add           $0x20, %[mod]") \
+            __ASM_EMIT  ("add           $0x20, %[arg]") \
+            __ASM_EMIT32("subl          $8, %[count]") \
+            __ASM_EMIT64("sub           $8, %[count]") \
+            __ASM_EMIT  ("4:") \
+            /* x4 block */ \
+            __ASM_EMIT32("addl          $4, %[count]") \
+            __ASM_EMIT64("add           $4, %[count]") \
+            __ASM_EMIT  ("jl            6f") \
+            __ASM_EMIT  ("vmovups       0x00(%[src]), %%xmm2") \
+            __ASM_EMIT  ("vmovups       0x10(%[src]), %%xmm3") \
+            __ASM_EMIT  ("vmovaps       0x00 + %[IDX], %%xmm0") \
+            __ASM_EMIT  ("vmovaps       0x40 + %[IDX], %%xmm1") \
+            __ASM_EMIT  ("vpermi2ps     %%xmm3, %%xmm2, %%xmm0") \
+            __ASM_EMIT  ("vpermi2ps     %%xmm3, %%xmm2, %%xmm1") \
+            COMPLEX_MOD_FAST_CORE("xmm") \
+            COMPLEX_ATAN2_FAST_CORE("xmm") \
+            __ASM_EMIT  ("vmovups       %%xmm6, 0x00(%[mod])") \
+            __ASM_EMIT  ("vmovups       %%xmm5, 0x00(%[arg])") \
+            __ASM_EMIT  ("add           $0x20, %[src]") \
+            __ASM_EMIT  ("add           $0x10, %[mod]") \
+            __ASM_EMIT  ("add           $0x10, %[arg]") \
+            __ASM_EMIT32("subl          $4, %[count]") \
+            __ASM_EMIT64("sub           $4, %[count]") \
+            __ASM_EMIT  ("6:") \
+            /* x1 blocks */ \
+            __ASM_EMIT32("addl          $3, %[count]") \
+            __ASM_EMIT64("add           $3, %[count]") \
+            __ASM_EMIT  ("jl            8f") \
+            __ASM_EMIT  ("7:") \
+            __ASM_EMIT  ("vmovss        0x00(%[src]), %%xmm0") \
+            __ASM_EMIT  ("vmovss        0x04(%[src]), %%xmm1") \
+            COMPLEX_MOD_FAST_CORE("xmm") \
+            COMPLEX_ATAN2_FAST_CORE("xmm") \
+            __ASM_EMIT  ("vmovss        %%xmm6, 0x00(%[mod])") \
+            __ASM_EMIT  ("vmovss        %%xmm5, 0x00(%[arg])") \
+            __ASM_EMIT  ("add           $0x08, %[src]") \
+            __ASM_EMIT  ("add           $0x04, %[mod]") \
+            __ASM_EMIT  ("add           $0x04, %[arg]") \
+            __ASM_EMIT32("decl          %[count]") \
+            __ASM_EMIT64("dec           %[count]") \
+            __ASM_EMIT  ("jge           7b") \
+            __ASM_EMIT  ("8:")
+
+        void pcomplex_modarg_fast(float *mod, float *arg, const float *src, size_t count)
+        {
+            ARCH_X86_ASM
+            (
+                PCOMPLEX_MODARG_FAST_CORE
+                : [mod] "+r" (mod), [arg] "+r" (arg), [src] "+r" (src),
+                  [count] X86_PGREG (count)
+                : [CC] "o" (complex_atan2_const),
+                  [IDX] "o" (pcomplex_modarg_idx)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+                  "%k4", "%k5"
+            );
+        }
+
+        #undef PCOMPLEX_MODARG_FAST_CORE
+
     } /* namespace avx512 */
 } /* namespace lsp */
 
@@ -705,6 +705,208 @@ namespace lsp
                   "%xmm4", "%xmm5", "%xmm6", "%xmm7"
             );
         }
+
+        IF_ARCH_X86(
+            static const uint32_t complex_atan2_const[] __lsp_aligned16 =
+            {
+                LSP_DSP_VEC4(0x7fffffff),       /* abs mask */
+                LSP_DSP_VEC4(0x80000000),       /* sign bit */
+                LSP_DSP_VEC4(0x00800000),       /* FLT_MIN */
+                LSP_DSP_VEC4(0x3fc90fdb),       /* PI/2 */
+                LSP_DSP_VEC4(0x40490fdb),       /* PI */
+                LSP_DSP_VEC4(0x3caace9e),       /* C4 = 0.0208504759 */
+                LSP_DSP_VEC4(0xbdae6c2b),       /* C3 = -0.0851672515 */
+                LSP_DSP_VEC4(0x3e387d93),       /* C2 = 0.180166528 */
+                LSP_DSP_VEC4(0xbea91def),       /* C1 = -0.3303065 */
+                LSP_DSP_VEC4(0x3f7ff73f)        /* C0 = 0.999866426 */
+            };
+        );
+
+    /*
+     * Module computed with the approximate reciprocal square root:
+     *   mod = s * rsqrt(max(s, FLT_MIN)), s = re*re + im*im
+     * The result is underestimated for s < FLT_MIN and is 0 for s = 0
+     */
+    #define COMPLEX_MOD_FAST_X4 \
+        /* xmm0 = re, xmm1 = im */ \
+        __ASM_EMIT("movaps      %%xmm0, %%xmm6") \
+        __ASM_EMIT("movaps      %%xmm1, %%xmm7") \
+        __ASM_EMIT("mulps       %%xmm6, %%xmm6")                /* xmm6 = re*re */ \
+        __ASM_EMIT("mulps       %%xmm7, %%xmm7")                /* xmm7 = im*im */ \
+        __ASM_EMIT("addps       %%xmm7, %%xmm6")                /* xmm6 = s = re*re + im*im */ \
+        __ASM_EMIT("movaps      0x20 + %[CC], %%xmm7")          /* xmm7 = FLT_MIN */ \
+        __ASM_EMIT("maxps       %%xmm6, %%xmm7")                /* xmm7 = max(s, FLT_MIN) */ \
+        __ASM_EMIT("rsqrtps     %%xmm7, %%xmm7")                /* xmm7 = 1/sqrt(s) */ \
+        __ASM_EMIT("mulps       %%xmm7, %%xmm6")                /* xmm6 = mod = s/sqrt(s) */
+
+    /*
+     * Argument computed with the polynomial approximation of atan(a) for a = min/max of
+     * absolute values of real and imaginary parts, followed by the octant correction:
+     *   r = a * (C0 + A*(C1 + A*(C2 + A*(C3 + A*C4)))), A = a*a
+     *   r = (|re| < |im|) ? PI/2 - r : r
+     *   r = (re < 0) ? PI - r : r
+     *   arg = (im < 0) ? -r : r
+     */
+    #define COMPLEX_ATAN2_FAST_X4 \
+        /* xmm0 = re, xmm1 = im */ \
+        __ASM_EMIT("movaps      0x00 + %[CC], %%xmm2")          /* xmm2 = abs mask */ \
+        __ASM_EMIT("movaps      %%xmm2, %%xmm3") \
+        __ASM_EMIT("andps       %%xmm0, %%xmm2")                /* xmm2 = ar = |re| */ \
+        __ASM_EMIT("andps       %%xmm1, %%xmm3")                /* xmm3 = ai = |im| */ \
+        __ASM_EMIT("movaps      %%xmm2, %%xmm4") \
+        __ASM_EMIT("movaps      %%xmm2, %%xmm5") \
+        __ASM_EMIT("minps       %%xmm3, %%xmm4")                /* xmm4 = min(ar, ai) */ \
+        __ASM_EMIT("maxps       %%xmm3, %%xmm5")                /* xmm5 = max(ar, ai) */ \
+        __ASM_EMIT("cmpltps     %%xmm3, %%xmm2")                /* xmm2 = [ar < ai] */ \
+        __ASM_EMIT("maxps       0x20 + %[CC], %%xmm5")          /* xmm5 = max(ar, ai, FLT_MIN) */ \
+        __ASM_EMIT("divps       %%xmm5, %%xmm4")                /* xmm4 = a = min/max */ \
+        __ASM_EMIT("movaps      %%xmm4, %%xmm3") \
+        __ASM_EMIT("movaps      0x50 + %[CC], %%xmm5")          /* xmm5 = C4 */ \
+        __ASM_EMIT("mulps       %%xmm3, %%xmm3")                /* xmm3 = A = a*a */ \
+        __ASM_EMIT("mulps       %%xmm3, %%xmm5")                /* xmm5 = A*C4 */ \
+        __ASM_EMIT("addps       0x60 + %[CC], %%xmm5")          /* xmm5 = C3+A*C4 */ \
+        __ASM_EMIT("mulps       %%xmm3, %%xmm5")                /* xmm5 = A*(C3+A*C4) */ \
+        __ASM_EMIT("addps       0x70 + %[CC], %%xmm5")          /* xmm5 = C2+A*(C3+A*C4) */ \
+        __ASM_EMIT("mulps       %%xmm3, %%xmm5")                /* xmm5 = A*(C2+A*(C3+A*C4)) */ \
+        __ASM_EMIT("addps       0x80 + %[CC], %%xmm5")          /* xmm5 = C1+A*(C2+A*(C3+A*C4)) */ \
+        __ASM_EMIT("mulps       %%xmm3, %%xmm5")                /* xmm5 = A*(C1+A*(C2+A*(C3+A*C4))) */ \
+        __ASM_EMIT("addps       0x90 + %[CC], %%xmm5")          /* xmm5 = C0+A*(C1+A*(C2+A*(C3+A*C4))) */ \
+        __ASM_EMIT("mulps       %%xmm4, %%xmm5")                /* xmm5 = r */ \
+        __ASM_EMIT("movaps      0x30 + %[CC], %%xmm3")          /* xmm3 = PI/2 */ \
+        __ASM_EMIT("subps       %%xmm5, %%xmm3")                /* xmm3 = PI/2 - r */ \
+        __ASM_EMIT("andps       %%xmm2, %%xmm3") \
+        __ASM_EMIT("andnps      %%xmm5, %%xmm2") \
+        __ASM_EMIT("orps        %%xmm3, %%xmm2")                /* xmm2 = r = (ar < ai) ? PI/2 - r : r */ \
+        __ASM_EMIT("xorps       %%xmm4, %%xmm4")                /* xmm4 = 0 */ \
+        __ASM_EMIT("cmpltps     %%xmm4, %%xmm0")                /* xmm0 = [re < 0] */ \
+        __ASM_EMIT("movaps      0x40 + %[CC], %%xmm3")          /* xmm3 = PI */ \
+        __ASM_EMIT("subps       %%xmm2, %%xmm3")                /* xmm3 = PI - r */ \
+        __ASM_EMIT("andps       %%xmm0, %%xmm3") \
+        __ASM_EMIT("andnps      %%xmm2, %%xmm0") \
+        __ASM_EMIT("orps        %%xmm3, %%xmm0")                /* xmm0 = r = (re < 0) ? PI - r : r */ \
+        __ASM_EMIT("andps       0x10 + %[CC], %%xmm1")          /* xmm1 = sign(im) */ \
+        __ASM_EMIT("xorps       %%xmm1, %%xmm0")                /* xmm0 = arg */
+
+        void complex_cvt2modarg_fast(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count)
+        {
+            ARCH_X86_ASM
+            (
+                // x4 blocks
+                __ASM_EMIT32("subl          $4, %[count]")
+                __ASM_EMIT64("sub           $4, %[count]")
+                __ASM_EMIT  ("jb            2f")
+                __ASM_EMIT  ("1:")
+                __ASM_EMIT  ("movups        0x00(%[src_re]), %%xmm0")
+                __ASM_EMIT  ("movups        0x00(%[src_im]), %%xmm1")
+                COMPLEX_MOD_FAST_X4
+                COMPLEX_ATAN2_FAST_X4
+                __ASM_EMIT  ("movups        %%xmm6, 0x00(%[dst_mod])")
+                __ASM_EMIT  ("movups        %%xmm0, 0x00(%[dst_arg])")
+                __ASM_EMIT  ("add           $0x10, %[src_re]")
+                __ASM_EMIT  ("add           $0x10, %[src_im]")
+                __ASM_EMIT  ("add           $0x10, %[dst_mod]")
+                __ASM_EMIT  ("add           $0x10, %[dst_arg]")
+                __ASM_EMIT32("subl          $4, %[count]")
+                __ASM_EMIT64("sub           $4, %[count]")
+                __ASM_EMIT  ("jae           1b")
+                __ASM_EMIT  ("2:")
+                // Tail: 1x-3x block
+                __ASM_EMIT32("addl          $4, %[count]")
+                __ASM_EMIT64("add           $4, %[count]")
+                __ASM_EMIT  ("jle           10f")
+                __ASM_EMIT32("testl         $1, %[count]")
+                __ASM_EMIT64("test          $1, %[count]")
+                __ASM_EMIT  ("jz            4f")
+                __ASM_EMIT  ("movss         0x00(%[src_re]), %%xmm0")
+                __ASM_EMIT  ("movss         0x00(%[src_im]), %%xmm1")
+                __ASM_EMIT  ("add           $4, %[src_re]")
+                __ASM_EMIT  ("add           $4, %[src_im]")
+                __ASM_EMIT  ("4:")
+                __ASM_EMIT32("testl         $2, %[count]")
+                __ASM_EMIT64("test          $2, %[count]")
+                __ASM_EMIT  ("jz            6f")
+                __ASM_EMIT  ("movhps        0x00(%[src_re]), %%xmm0")
+                __ASM_EMIT  ("movhps        0x00(%[src_im]), %%xmm1")
+                __ASM_EMIT  ("6:")
+                COMPLEX_MOD_FAST_X4
+                COMPLEX_ATAN2_FAST_X4
+                __ASM_EMIT32("testl         $1, %[count]")
+                __ASM_EMIT64("test          $1, %[count]")
+                __ASM_EMIT  ("jz            8f")
+                __ASM_EMIT  ("movss         %%xmm6, 0x00(%[dst_mod])")
+                __ASM_EMIT  ("movss         %%xmm0, 0x00(%[dst_arg])")
+                __ASM_EMIT  ("add           $4, %[dst_mod]")
+                __ASM_EMIT  ("add           $4, %[dst_arg]")
+                __ASM_EMIT  ("8:")
+                __ASM_EMIT32("testl         $2, %[count]")
+                __ASM_EMIT64("test          $2, %[count]")
+                __ASM_EMIT  ("jz            10f")
+                __ASM_EMIT  ("movhps        %%xmm6, 0x00(%[dst_mod])")
+                __ASM_EMIT  ("movhps        %%xmm0, 0x00(%[dst_arg])")
+                __ASM_EMIT  ("10:")
+
+                : [dst_mod] "+r" (dst_mod), [dst_arg] "+r" (dst_arg),
+                  [src_re] "+r" (src_re), [src_im] "+r" (src_im),
+                  [count] X86_PGREG (count)
+                : [CC] "o" (complex_atan2_const)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+            );
+        }
+
+        void complex_arg_fast(float *dst, const float *re, const float *im, size_t count)
+        {
+            ARCH_X86_ASM
+            (
+                // x4 blocks
+                __ASM_EMIT("sub             $4, %[count]")
+                __ASM_EMIT("jb              2f")
+                __ASM_EMIT("1:")
+                __ASM_EMIT("movups          0x00(%[re]), %%xmm0")
+                __ASM_EMIT("movups          0x00(%[im]), %%xmm1")
+                COMPLEX_ATAN2_FAST_X4
+                __ASM_EMIT("movups          %%xmm0, 0x00(%[dst])")
+                __ASM_EMIT("add             $0x10, %[re]")
+                __ASM_EMIT("add             $0x10, %[im]")
+                __ASM_EMIT("add             $0x10, %[dst]")
+                __ASM_EMIT("sub             $4, %[count]")
+                __ASM_EMIT("jae             1b")
+                __ASM_EMIT("2:")
+                // Tail: 1x-3x block
+                __ASM_EMIT("add             $4, %[count]")
+                __ASM_EMIT("jle             10f")
+                __ASM_EMIT("test            $1, %[count]")
+                __ASM_EMIT("jz              4f")
+                __ASM_EMIT("movss           0x00(%[re]), %%xmm0")
+                __ASM_EMIT("movss           0x00(%[im]), %%xmm1")
+                __ASM_EMIT("add             $4, %[re]")
+                __ASM_EMIT("add             $4, %[im]")
+                __ASM_EMIT("4:")
+                __ASM_EMIT("test            $2, %[count]")
+                __ASM_EMIT("jz              6f")
+                __ASM_EMIT("movhps          0x00(%[re]), %%xmm0")
+                __ASM_EMIT("movhps          0x00(%[im]), %%xmm1")
+                __ASM_EMIT("6:")
+                COMPLEX_ATAN2_FAST_X4
+                __ASM_EMIT("test            $1, %[count]")
+                __ASM_EMIT("jz              8f")
+                __ASM_EMIT("movss           %%xmm0, 0x00(%[dst])")
+                __ASM_EMIT("add             $4, %[dst]")
+                __ASM_EMIT("8:")
+                __ASM_EMIT("test            $2, %[count]")
+                __ASM_EMIT("jz              10f")
+                __ASM_EMIT("movhps          %%xmm0, 0x00(%[dst])")
+                __ASM_EMIT("10:")
+
+                : [dst] "+r" (dst), [re] "+r" (re), [im] "+r" (im),
+                  [count] "+r" (count)
+                : [CC] "o" (complex_atan2_const)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5"
+            );
+        }
     } /* namespace sse */
 } /* namespace lsp */
 
@@ -30,6 +30,94 @@ namespace lsp
 {
     namespace sse
     {
+        /*
+         * Apply 4 samples of the source signal to the whole convolution: the pointers
+         * to the convolution and the destination should be set in c and d
+         */
+        #define CONVOLVE_X4_PASS \
+            __ASM_EMIT("xorps       %%xmm7, %%xmm7")            /* xmm7 = 0 */ \
+            __ASM_EMIT("mov         %[length], %[clen]") \
+            __ASM_EMIT("sub         $4, %[clen]") \
+            __ASM_EMIT("jb          12f") \
+            /* Load convolution kernel */ \
+            __ASM_EMIT("movups      (%[k]), %%xmm0")            /* xmm0 = k0 k1 k2 k3 */ \
+            __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = k0 k1 k2 k3 */ \
+            __ASM_EMIT("movaps      %%xmm0, %%xmm2")            /* xmm2 = k0 k1 k2 k3 */ \
+            __ASM_EMIT("movaps      %%xmm1, %%xmm3")            /* xmm3 = k0 k1 k2 k3 */ \
+            __ASM_EMIT("shufps      $0x00, %%xmm0, %%xmm0")     /* xmm0 = k0 k0 k0 k0 */ \
+            __ASM_EMIT("shufps      $0x55, %%xmm1, %%xmm1")     /* xmm1 = k1 k1 k1 k1 */ \
+            __ASM_EMIT("shufps      $0xaa, %%xmm2, %%xmm2")     /* xmm2 = k2 k2 k2 k2 */ \
+            __ASM_EMIT("shufps      $0xff, %%xmm3, %%xmm3")     /* xmm3 = k2 k2 k2 k2 */ \
+            __ASM_EMIT("11:") \
+                __ASM_EMIT("movaps      %%xmm7, %%xmm4")            /* xmm4 = p0 p1 p2 p3 */ \
+                __ASM_EMIT("movups      (%[c]), %%xmm7")            /* xmm7 = c0 c1 c2 c3 */ \
+                __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = p0 p1 p2 p3 */ \
+                __ASM_EMIT("shufps      $0x4e, %%xmm7, %%xmm5")     /* xmm5 = p2 p3 c0 c1 (+) */ \
+                __ASM_EMIT("movaps      %%xmm5, %%xmm6")            /* xmm6 = p2 p3 c0 c1 */ \
+                __ASM_EMIT("shufps      $0x99, %%xmm7, %%xmm6")     /* xmm6 = p3 c0 c1 c2 (+) */ \
+                __ASM_EMIT("shufps      $0x99, %%xmm5, %%xmm4")     /* xmm4 = p1 p2 p3 c0 */ \
+                /* Untouchable: xmm0, xmm1, xmm2, xmm3, xmm7 */ \
+                __ASM_EMIT("mulps       %%xmm2, %%xmm5")            /* xmm5 = V2 = k2*p2 k2*p3 k2*c0 k2*c1 */ \
+                __ASM_EMIT("mulps       %%xmm1, %%xmm6")            /* xmm6 = V3 = k1*p3 k1*c0 k1*c1 k1*c2 */ \
+                __ASM_EMIT("mulps       %%xmm3, %%xmm4")            /* xmm4 = V1 = k3*p1 k3*p2 k3*p3 k3*c0 */ \
+                __ASM_EMIT("addps       %%xmm6, %%xmm5")            /* xmm5 = V2 + V3 */ \
+                __ASM_EMIT("movaps      %%xmm7, %%xmm6")            /* xmm6 = c0 c1 c2 c3 */ \
+                __ASM_EMIT("addps       %%xmm5, %%xmm4")            /* xmm4 = V1 + V2 + V3 */ \
+                __ASM_EMIT("mulps       %%xmm0, %%xmm6")            /* xmm6 = V0 = k0*c0 k0*c1 k0*c2 k0*c3 */ \
+                __ASM_EMIT("movups      (%[d]), %%xmm5")            /* xmm5 = D + d0 d1 d2 d3 */ \
+                __ASM_EMIT("addps       %%xmm6, %%xmm4")            /* xmm4 = V0 + V1 + V2 + V3 */ \
+                __ASM_EMIT("addps       %%xmm5, %%xmm4")            /* xmm4 = D + V0 + V1 + V2 + V3 */ \
+                __ASM_EMIT("movups      %%xmm4, (%[d])") \
+                __ASM_EMIT("add         $0x10, %[c]")               /* c += 4 */ \
+                __ASM_EMIT("add         $0x10, %[d]")               /* d += 4 */ \
+                __ASM_EMIT("sub         $4, %[clen]")               /* clen -= 4 */ \
+                __ASM_EMIT("jae         11b") \
+            /* Apply tail: xmm7 =  p0 p1 p2 p3 */ \
+            __ASM_EMIT("movaps      %%xmm7, %%xmm5")            /* xmm5 = p0 p1 p2 p3 */ \
+            __ASM_EMIT("movhlps     %%xmm7, %%xmm6")            /* xmm6 = p2 */ \
+            __ASM_EMIT("shufps      $0xff, %%xmm5, %%xmm5")     /* xmm5 = p3 */ \
+            __ASM_EMIT("shufps      $0x55, %%xmm7, %%xmm7")     /* xmm7 = p1 */ \
+            __ASM_EMIT("movss       0x04(%[k]), %%xmm0")        /* xmm0 = k1 */ \
+            __ASM_EMIT("movss       0x08(%[k]), %%xmm1")        /* xmm1 = k2 */ \
+            __ASM_EMIT("movss       0x0c(%[k]), %%xmm2")        /* xmm2 = k3 */ \
+            __ASM_EMIT("movaps      %%xmm0, %%xmm3")            /* xmm3 = k1 */ \
+            __ASM_EMIT("movaps      %%xmm1, %%xmm4")            /* xmm4 = k2 */ \
+            __ASM_EMIT("mulss       %%xmm2, %%xmm7")            /* xmm7 = k3*p1 */ \
+            __ASM_EMIT("mulss       %%xmm5, %%xmm3")            /* xmm3 = k1*p3 */ \
+            __ASM_EMIT("mulss       %%xmm6, %%xmm4")            /* xmm4 = k2*p2 */ \
+            __ASM_EMIT("addss       %%xmm7, %%xmm3")            /* xmm3 = k1*p3 + k3*p1 */ \
+            __ASM_EMIT("addss       %%xmm4, %%xmm3")            /* xmm3 = k1*p3 + k2*p2 + k3*p1 */ \
+            __ASM_EMIT("movss       0x00(%[d]), %%xmm7")        /* xmm7 = d0 */ \
+            __ASM_EMIT("addss       %%xmm3, %%xmm7")            /* xmm7 = d0 + k1*p3 + k2*p2 + k3*p1 */ \
+            __ASM_EMIT("movss       %%xmm7, 0x00(%[d])")        /* xmm7 = d0 */ \
+            __ASM_EMIT("movss       0x04(%[d]), %%xmm7")        /* xmm4 = d1 */ \
+            __ASM_EMIT("mulss       %%xmm2, %%xmm6")            /* xmm6 = k3*p2 */ \
+            __ASM_EMIT("mulss       %%xmm5, %%xmm1")            /* xmm1 = k2*p3 */ \
+            __ASM_EMIT("addss       %%xmm6, %%xmm7")            /* xmm7 = d1 + k3*p2 */ \
+            __ASM_EMIT("addss       %%xmm1, %%xmm7")            /* xmm7 = d1 + k3*p2 + k2*p3 */ \
+            __ASM_EMIT("movss       %%xmm7, 0x04(%[d])") \
+            __ASM_EMIT("movss       0x08(%[d]), %%xmm7")        /* xmm7 = d2 */ \
+            __ASM_EMIT("mulss       %%xmm5, %%xmm2")            /* xmm2 = k3*p3 */ \
+            __ASM_EMIT("addss       %%xmm2, %%xmm7")            /* xmm7 = d2 + k3*p3 */ \
+            __ASM_EMIT("movss       %%xmm7, 0x08(%[d])") \
+            /* Apply tail */ \
+            __ASM_EMIT("12:") \
+                __ASM_EMIT("add         $3, %[clen]")       /* while (clen >= 0) */ \
+                __ASM_EMIT("jl          14f") \
+                __ASM_EMIT("movups      0x00(%[k]), %%xmm1")    /* xmm1 = k0 k1 k2 k3 */ \
+                __ASM_EMIT("15:") \
+                    __ASM_EMIT("movss       0x00(%[c]), %%xmm0")    /* xmm0 = c0 */ \
+                    __ASM_EMIT("shufps      $0x00, %%xmm0, %%xmm0") /* xmm0 = c0 c0 c0 c0 */ \
+                    __ASM_EMIT("movups      0x00(%[d]), %%xmm2")    /* xmm2 = d0 d1 d2 d3 */ \
+                    __ASM_EMIT("mulps       %%xmm1, %%xmm0")        /* xmm0 = k0*c0 k1*c0 k2*c0 k3*c0 */ \
+                    __ASM_EMIT("addps       %%xmm2, %%xmm0")        /* xmm0 = d0+k0*c0 d1+k1*c0 d2+k2*c0 d3+k3*c0 */ \
+                    __ASM_EMIT("movups      %%xmm0, 0x00(%[d])") \
+                    __ASM_EMIT("add         $0x04, %[c]")           /* c++ */ \
+                    __ASM_EMIT("add         $0x04, %[d]")           /* d++ */ \
+                    __ASM_EMIT("dec         %[clen]") \
+                    __ASM_EMIT("jge         15b") \
+            __ASM_EMIT("14:")
+
         void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count)
         {
             const float *c;
@@ -41,100 +129,9 @@ namespace lsp
                 __ASM_EMIT("jb          20f")
 
                 __ASM_EMIT("10:")
-                    __ASM_EMIT("xorps       %%xmm7, %%xmm7")            // xmm7 = 0
-                    __ASM_EMIT("mov         %[length], %[clen]")
                     __ASM_EMIT("mov         %[dst], %[d]")
                     __ASM_EMIT("mov         %[conv], %[c]")
-
-                    __ASM_EMIT("sub         $4, %[clen]")
-                    __ASM_EMIT("jb          12f")
-                    // Load convolution kernel
-                    __ASM_EMIT("movups      (%[k]), %%xmm0")            // xmm0 = k0 k1 k2 k3
-                    __ASM_EMIT("movaps      %%xmm0, %%xmm1")            // xmm1 = k0 k1 k2 k3
-                    __ASM_EMIT("movaps      %%xmm0, %%xmm2")            // xmm2 = k0 k1 k2 k3
-                    __ASM_EMIT("movaps      %%xmm1, %%xmm3")            // xmm3 = k0 k1 k2 k3
-                    __ASM_EMIT("shufps      $0x00, %%xmm0, %%xmm0")     // xmm0 = k0 k0 k0 k0
-                    __ASM_EMIT("shufps      $0x55, %%xmm1, %%xmm1")     // xmm1 = k1 k1 k1 k1
-                    __ASM_EMIT("shufps      $0xaa, %%xmm2, %%xmm2")     // xmm2 = k2 k2 k2 k2
-                    __ASM_EMIT("shufps      $0xff, %%xmm3, %%xmm3")     // xmm3 = k2 k2 k2 k2
-
-                    __ASM_EMIT("11:")
-                        __ASM_EMIT("movaps      %%xmm7, %%xmm4")            // xmm4 = p0 p1 p2 p3
-                        __ASM_EMIT("movups      (%[c]), %%xmm7")            // xmm7 = c0 c1 c2 c3
-                        __ASM_EMIT("movaps      %%xmm4, %%xmm5")            // xmm5 = p0 p1 p2 p3
-                        __ASM_EMIT("shufps      $0x4e, %%xmm7, %%xmm5")     // xmm5 = p2 p3 c0 c1 (+)
-                        __ASM_EMIT("movaps      %%xmm5, %%xmm6")            // xmm6 = p2 p3 c0 c1
-                        __ASM_EMIT("shufps      $0x99, %%xmm7, %%xmm6")     // xmm6 = p3 c0 c1 c2 (+)
-                        __ASM_EMIT("shufps      $0x99, %%xmm5, %%xmm4")     // xmm4 = p1 p2 p3 c0
-
-                        // Untouchable: xmm0, xmm1, xmm2, xmm3, xmm7
-                        __ASM_EMIT("mulps       %%xmm2, %%xmm5")            // xmm5 = V2 = k2*p2 k2*p3 k2*c0 k2*c1
-                        __ASM_EMIT("mulps       %%xmm1, %%xmm6")            // xmm6 = V3 = k1*p3 k1*c0 k1*c1 k1*c2
-                        __ASM_EMIT("mulps       %%xmm3, %%xmm4")            // xmm4 = V1 = k3*p1 k3*p2 k3*p3 k3*c0
-                        __ASM_EMIT("addps       %%xmm6, %%xmm5")            // xmm5 = V2 + V3
-                        __ASM_EMIT("movaps      %%xmm7, %%xmm6")            // xmm6 = c0 c1 c2 c3
-                        __ASM_EMIT("addps       %%xmm5, %%xmm4")            // xmm4 = V1 + V2 + V3
-                        __ASM_EMIT("mulps       %%xmm0, %%xmm6")            // xmm6 = V0 = k0*c0 k0*c1 k0*c2 k0*c3
-                        __ASM_EMIT("movups      (%[d]), %%xmm5")            // xmm5 = D + d0 d1 d2 d3
-                        __ASM_EMIT("addps       %%xmm6, %%xmm4")            // xmm4 = V0 + V1 + V2 + V3
-                        __ASM_EMIT("addps       %%xmm5, %%xmm4")            // xmm4 = D + V0 + V1 + V2 + V3
-                        __ASM_EMIT("movups      %%xmm4, (%[d])")
-                        __ASM_EMIT("add         $0x10, %[c]")               // c += 4
-                        __ASM_EMIT("add         $0x10, %[d]")               // d += 4
-                        __ASM_EMIT("sub         $4, %[clen]")               // clen -= 4
-                        __ASM_EMIT("jae         11b")
-
-                    // Apply tail: xmm7 =  p0 p1 p2 p3
-                    __ASM_EMIT("movaps      %%xmm7, %%xmm5")            // xmm5 = p0 p1 p2 p3
-                    __ASM_EMIT("movhlps     %%xmm7, %%xmm6")            // xmm6 = p2
-                    __ASM_EMIT("shufps      $0xff, %%xmm5, %%xmm5")     // xmm5 = p3
-                    __ASM_EMIT("shufps      $0x55, %%xmm7, %%xmm7")     // xmm7 = p1
-                    __ASM_EMIT("movss       0x04(%[k]), %%xmm0")        // xmm0 = k1
-                    __ASM_EMIT("movss       0x08(%[k]), %%xmm1")        // xmm1 = k2
-                    __ASM_EMIT("movss       0x0c(%[k]), %%xmm2")        // xmm2 = k3
-
-                    __ASM_EMIT("movaps      %%xmm0, %%xmm3")            // xmm3 = k1
-                    __ASM_EMIT("movaps      %%xmm1, %%xmm4")            // xmm4 = k2
-                    __ASM_EMIT("mulss       %%xmm2, %%xmm7")            // xmm7 = k3*p1
-                    __ASM_EMIT("mulss       %%xmm5, %%xmm3")            // xmm3 = k1*p3
-                    __ASM_EMIT("mulss       %%xmm6, %%xmm4")            // xmm4 = k2*p2
-                    __ASM_EMIT("addss       %%xmm7, %%xmm3")            // xmm3 = k1*p3 + k3*p1
-                    __ASM_EMIT("addss       %%xmm4, %%xmm3")            // xmm3 = k1*p3 + k2*p2 + k3*p1
-                    __ASM_EMIT("movss       0x00(%[d]), %%xmm7")        // xmm7 = d0
-                    __ASM_EMIT("addss       %%xmm3, %%xmm7")            // xmm7 = d0 + k1*p3 + k2*p2 + k3*p1
-                    __ASM_EMIT("movss       %%xmm7, 0x00(%[d])")        // xmm7 = d0
-
-                    __ASM_EMIT("movss       0x04(%[d]), %%xmm7")        // xmm4 = d1
-                    __ASM_EMIT("mulss       %%xmm2, %%xmm6")            // xmm6 = k3*p2
-                    __ASM_EMIT("mulss       %%xmm5, %%xmm1")            // xmm1 = k2*p3
-                    __ASM_EMIT("addss       %%xmm6, %%xmm7")            // xmm7 = d1 + k3*p2
-                    __ASM_EMIT("addss       %%xmm1, %%xmm7")            // xmm7 = d1 + k3*p2 + k2*p3
-                    __ASM_EMIT("movss       %%xmm7, 0x04(%[d])")
-
-                    __ASM_EMIT("movss       0x08(%[d]), %%xmm7")        // xmm7 = d2
-                    __ASM_EMIT("mulss       %%xmm5, %%xmm2")            // xmm2 = k3*p3
-                    __ASM_EMIT("addss       %%xmm2, %%xmm7")            // xmm7 = d2 + k3*p3
-                    __ASM_EMIT("movss       %%xmm7, 0x08(%[d])")
-
-                    // Apply tail
-                    __ASM_EMIT("12:")
-                        __ASM_EMIT("add         $3, %[clen]")       // while (clen >= 0)
-                        __ASM_EMIT("jl          14f")
-                        __ASM_EMIT("movups      0x00(%[k]), %%xmm1")    // xmm1 = k0 k1 k2 k3
-
-                        __ASM_EMIT("15:")
-                            __ASM_EMIT("movss       0x00(%[c]), %%xmm0")    // xmm0 = c0
-                            __ASM_EMIT("shufps      $0x00, %%xmm0, %%xmm0") // xmm0 = c0 c0 c0 c0
-                            __ASM_EMIT("movups      0x00(%[d]), %%xmm2")    // xmm2 = d0 d1 d2 d3
-                            __ASM_EMIT("mulps       %%xmm1, %%xmm0")        // xmm0 = k0*c0 k1*c0 k2*c0 k3*c0
-                            __ASM_EMIT("addps       %%xmm2, %%xmm0")        // xmm0 = d0+k0*c0 d1+k1*c0 d2+k2*c0 d3+k3*c0
-                            __ASM_EMIT("movups      %%xmm0, 0x00(%[d])")
-                            __ASM_EMIT("add         $0x04, %[c]")           // c++
-                            __ASM_EMIT("add         $0x04, %[d]")           // d++
-                            __ASM_EMIT("dec         %[clen]")
-                            __ASM_EMIT("jge         15b")
-
-                    __ASM_EMIT("14:")
+                    CONVOLVE_X4_PASS
                     __ASM_EMIT64("add       $0x10, %[dst]")         // dst += 4
                     __ASM_EMIT32("addl      $0x10, %[dst]")
                     __ASM_EMIT("add         $0x10, %[k]")           // k += 4
@@ -213,6 +210,61 @@ namespace lsp
                   "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7"
             );
         }
+
+        void convolve_multi(float * const *dst, const float *src, const float * const *conv, size_t length, size_t count, size_t n)
+        {
+            const size_t head   = count & ~size_t(3);
+            size_t blocks       = count >> 2;
+            size_t off          = 0;
+            const float *k      = src;
+            const float *c;
+            float *d;
+            size_t clen, i;
+
+            if (n == 0)
+                return;
+
+            // Each block of 4 source samples is applied to all convolutions at once,
+            // so the destination of each convolution is updated once per block
+            if (blocks > 0)
+            {
+                ARCH_X86_ASM(
+                    __ASM_EMIT("100:")
+                        __ASM_EMIT("mov         %[n], %[i]")
+                        __ASM_EMIT("200:")
+                            __ASM_EMIT("mov         %[vc], %[c]")
+                            __ASM_EMIT("mov         %[vd], %[d]")
+                            __ASM_EMIT("mov         -%c[ptr](%[c], %[i], %c[ptr]), %[c]")     // c = conv[i-1]
+                            __ASM_EMIT("mov         -%c[ptr](%[d], %[i], %c[ptr]), %[d]")     // d = dst[i-1]
+                            __ASM_EMIT("add         %[off], %[d]")                          // d += off
+                            CONVOLVE_X4_PASS
+                            __ASM_EMIT("dec         %[i]")
+                            __ASM_EMIT("jnz         200b")
+                        __ASM_EMIT64("add       $0x10, %[off]")         // off += 4
+                        __ASM_EMIT32("addl      $0x10, %[off]")
+                        __ASM_EMIT("add         $0x10, %[k]")           // k += 4
+                        __ASM_EMIT64("dec       %[blocks]")
+                        __ASM_EMIT32("decl      %[blocks]")
+                        __ASM_EMIT("jnz         100b")
+                    : [k] "+r" (k), [off] X86_PGREG (off), [blocks] X86_PGREG (blocks),
+                      [c] "=&r" (c), [d] "=&r" (d), [clen] "=&r" (clen), [i] "=&r" (i)
+                    : [vc] X86_GREG (conv), [vd] X86_GREG (dst),
+                      [length] X86_GREG (length), [n] X86_GREG (n),
+                      [ptr] "i" (sizeof(float *))
+                    : "cc", "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+                );
+            }
+
+            // Apply the tail of the source signal
+            if (head < count)
+            {
+                for (size_t j=0; j<n; ++j)
+                    convolve(&dst[j][head], &src[head], conv[j], length, count - head);
+            }
+        }
+
+        #undef CONVOLVE_X4_PASS
     } /* namespace sse */
 } /* namespace lsp */
 
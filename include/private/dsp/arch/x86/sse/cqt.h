@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 1 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_X86_SSE_CQT_H_
+#define PRIVATE_DSP_ARCH_X86_SSE_CQT_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_SSE_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_SSE_IMPL */
+
+namespace lsp
+{
+    namespace sse
+    {
+        /*
+         * The products of the spectrum and the kernel are accumulated in two vectors:
+         *   P = sum { sr*kr, si*ki }, Q = sum { sr*ki, si*kr }
+         * and reduced at the end of the row: re = P[0] - P[1], im = Q[0] + Q[1]
+         */
+        void cqt_kernel_apply(float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins)
+        {
+            for (size_t i=0; i<bins; ++i, band += 2, dst += 2)
+            {
+                const float *s  = &src[band[0] * 2];
+                size_t n        = band[1];
+
+                ARCH_X86_ASM
+                (
+                    __ASM_EMIT("xorps           %%xmm0, %%xmm0")            // xmm0 = P
+                    __ASM_EMIT("xorps           %%xmm1, %%xmm1")            // xmm1 = Q
+                    __ASM_EMIT("xorps           %%xmm2, %%xmm2")
+                    __ASM_EMIT("xorps           %%xmm3, %%xmm3")
+                    // x4 blocks
+                    __ASM_EMIT("sub             $4, %[n]")
+                    __ASM_EMIT("jb              2f")
+                    __ASM_EMIT("1:")
+                    __ASM_EMIT("movups          0x00(%[s]), %%xmm4")        // xmm4 = sr si
+                    __ASM_EMIT("movups          0x00(%[k]), %%xmm6")        // xmm6 = kr ki
+                    __ASM_EMIT("movaps          %%xmm4, %%xmm5")
+                    __ASM_EMIT("mulps           %%xmm6, %%xmm4")            // xmm4 = sr*kr si*ki
+                    __ASM_EMIT("shufps          $0xb1, %%xmm6, %%xmm6")     // xmm6 = ki kr
+                    __ASM_EMIT("mulps           %%xmm6, %%xmm5")            // xmm5 = sr*ki si*kr
+                    __ASM_EMIT("addps           %%xmm4, %%xmm0")
+                    __ASM_EMIT("addps           %%xmm5, %%xmm1")
+                    __ASM_EMIT("movups          0x10(%[s]), %%xmm4")
+                    __ASM_EMIT("movups          0x10(%[k]), %%xmm6")
+                    __ASM_EMIT("movaps          %%xmm4, %%xmm5")
+                    __ASM_EMIT("mulps           %%xmm6, %%xmm4")
+                    __ASM_EMIT("shufps          $0xb1, %%xmm6, %%xmm6")
+                    __ASM_EMIT("mulps           %%xmm6, %%xmm5")
+                    __ASM_EMIT("addps           %%xmm4, %%xmm2")
+                    __ASM_EMIT("addps           %%xmm5, %%xmm3")
+                    __ASM_EMIT("add             $0x20, %[s]")
+                    __ASM_EMIT("add             $0x20, %[k]")
+                    __ASM_EMIT("sub             $4, %[n]")
+                    __ASM_EMIT("jae             1b")
+                    __ASM_EMIT("2:")
+                    __ASM_EMIT("addps           %%xmm2, %%xmm0")
+                    __ASM_EMIT("addps           %%xmm3, %%xmm1")
+                    // x2 block
+                    __ASM_EMIT("add             $2, %[n]")
+                    __ASM_EMIT("jl              4f")
+                    __ASM_EMIT("movups          0x00(%[s]), %%xmm4")        // xmm4 = sr si
+                    __ASM_EMIT("movups          0x00(%[k]), %%xmm6")        // xmm6 = kr ki
+                    __ASM_EMIT("movaps          %%xmm4, %%xmm5")
+                    __ASM_EMIT("mulps           %%xmm6, %%xmm4")            // xmm4 = sr*kr si*ki
+                    __ASM_EMIT("shufps          $0xb1, %%xmm6, %%xmm6")     // xmm6 = ki kr
+                    __ASM_EMIT("mulps           %%xmm6, %%xmm5")            // xmm5 = sr*ki si*kr
+                    __ASM_EMIT("addps           %%xmm4, %%xmm0")
+                    __ASM_EMIT("addps           %%xmm5, %%xmm1")
+                    __ASM_EMIT("add             $0x10, %[s]")
+                    __ASM_EMIT("add             $0x10, %[k]")
+                    __ASM_EMIT("sub             $2, %[n]")
+                    __ASM_EMIT("4:")
+                    // x1 block
+                    __ASM_EMIT("add             $1, %[n]")
+                    __ASM_EMIT("jl              6f")
+                    __ASM_EMIT("xorps           %%xmm4, %%xmm4")
+                    __ASM_EMIT("xorps           %%xmm6, %%xmm6")
+                    __ASM_EMIT("movlps          0x00(%[s]), %%xmm4")        // xmm4 = sr si 0 0
+                    __ASM_EMIT("movlps          0x00(%[k]), %%xmm6")        // xmm6 = kr ki 0 0
+                    __ASM_EMIT("movaps          %%xmm4, %%xmm5")
+                    __ASM_EMIT("mulps           %%xmm6, %%xmm4")            // xmm4 = sr*kr si*ki
+                    __ASM_EMIT("shufps          $0xb1, %%xmm6, %%xmm6")     // xmm6 = ki kr
+                    __ASM_EMIT("mulps           %%xmm6, %%xmm5")            // xmm5 = sr*ki si*kr
+                    __ASM_EMIT("addps           %%xmm4, %%xmm0")
+                    __ASM_EMIT("addps           %%xmm5, %%xmm1")
+                    __ASM_EMIT("add             $0x08, %[s]")
+                    __ASM_EMIT("add             $0x08, %[k]")
+                    __ASM_EMIT("6:")
+                    // Reduce and store
+                    __ASM_EMIT("movhlps         %%xmm0, %%xmm2")            // xmm2 = P2 P3
+                    __ASM_EMIT("movhlps         %%xmm1, %%xmm3")            // xmm3 = Q2 Q3
+                    __ASM_EMIT("addps           %%xmm2, %%xmm0")            // xmm0 = P0+P2 P1+P3
+                    __ASM_EMIT("addps           %%xmm3, %%xmm1")            // xmm1 = Q0+Q2 Q1+Q3
+                    __ASM_EMIT("movaps          %%xmm0, %%xmm2")
+                    __ASM_EMIT("movaps          %%xmm1, %%xmm3")
+                    __ASM_EMIT("shufps          $0x55, %%xmm2, %%xmm2")     // xmm2 = P1+P3
+                    __ASM_EMIT("shufps          $0x55, %%xmm3, %%xmm3")     // xmm3 = Q1+Q3
+                    __ASM_EMIT("subss           %%xmm2, %%xmm0")            // xmm0 = re
+                    __ASM_EMIT("addss           %%xmm3, %%xmm1")            // xmm1 = im
+                    __ASM_EMIT("movss           %%xmm0, 0x00(%[dst])")
+                    __ASM_EMIT("movss           %%xmm1, 0x04(%[dst])")
+                    : [s] "+r" (s), [k] "+r" (kernel), [n] X86_PGREG (n)
+                    : [dst] "r" (dst)
+                    : "cc", "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                      "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+                );
+            }
+        }
+    } /* namespace sse */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_SSE_CQT_H_ */
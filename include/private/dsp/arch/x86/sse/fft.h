@@ -30,6 +30,7 @@
 #include <private/dsp/arch/x86/sse/fft/butterfly.h>
 #include <private/dsp/arch/x86/sse/fft/p_butterfly.h>
 #include <private/dsp/arch/x86/sse/fft/normalize.h>
+#include <private/dsp/arch/x86/sse/fft/start.h>
 
 // Use 8-bit-reverse algorithm
 #define FFT_SCRAMBLE_SELF_DIRECT_NAME   scramble_self_direct8
@@ -42,6 +43,7 @@
 #define FFT_SCRAMBLE_SELF_DIRECT_NAME   packed_scramble_self_direct8
 #define FFT_SCRAMBLE_SELF_REVERSE_NAME  packed_scramble_self_reverse8
 #define FFT_SCRAMBLE_COPY_DIRECT_NAME   packed_scramble_copy_direct8
+#define FFT_SCRAMBLE_COPY_DIRECT_WINDOWED_NAME packed_scramble_copy_direct_windowed8
 #define FFT_SCRAMBLE_COPY_REVERSE_NAME  packed_scramble_copy_reverse8
 #define FFT_TYPE                        uint8_t
 #include <private/dsp/arch/x86/sse/fft/p_scramble.h>
@@ -57,10 +59,27 @@
 #define FFT_SCRAMBLE_SELF_DIRECT_NAME   packed_scramble_self_direct16
 #define FFT_SCRAMBLE_SELF_REVERSE_NAME  packed_scramble_self_reverse16
 #define FFT_SCRAMBLE_COPY_DIRECT_NAME   packed_scramble_copy_direct16
+#define FFT_SCRAMBLE_COPY_DIRECT_WINDOWED_NAME packed_scramble_copy_direct_windowed16
 #define FFT_SCRAMBLE_COPY_REVERSE_NAME  packed_scramble_copy_reverse16
 #define FFT_TYPE                        uint16_t
 #include <private/dsp/arch/x86/sse/fft/p_scramble.h>
 
+// Use 32-bit-reverse algorithm
+#define FFT_SCRAMBLE_SELF_DIRECT_NAME   scramble_self_direct32
+#define FFT_SCRAMBLE_SELF_REVERSE_NAME  scramble_self_reverse32
+#define FFT_SCRAMBLE_COPY_DIRECT_NAME   scramble_copy_direct32
+#define FFT_SCRAMBLE_COPY_REVERSE_NAME  scramble_copy_reverse32
+#define FFT_TYPE                        uint32_t
+#include <private/dsp/arch/x86/sse/fft/scramble.h>
+
+#define FFT_SCRAMBLE_SELF_DIRECT_NAME   packed_scramble_self_direct32
+#define FFT_SCRAMBLE_SELF_REVERSE_NAME  packed_scramble_self_reverse32
+#define FFT_SCRAMBLE_COPY_DIRECT_NAME   packed_scramble_copy_direct32
+#define FFT_SCRAMBLE_COPY_DIRECT_WINDOWED_NAME packed_scramble_copy_direct_windowed32
+#define FFT_SCRAMBLE_COPY_REVERSE_NAME  packed_scramble_copy_reverse32
+#define FFT_TYPE                        uint32_t
+#include <private/dsp/arch/x86/sse/fft/p_scramble.h>
+
 // Make set of scramble-switch implementations
 #define FFT_SCRAMBLE_SELF_DIRECT_NAME       scramble_self_direct
 #define FFT_SCRAMBLE_COPY_DIRECT_NAME       scramble_copy_direct
@@ -78,6 +97,7 @@
 #define FFT_SCRAMBLE_REVERSE_NAME           packed_scramble_reverse
 #define FFT_REPACK                          packed_fft_repack
 #define FFT_REPACK_NORMALIZE                packed_fft_repack_normalize
+#define FFT_REPACK_NORMALIZE_ADD            packed_fft_repack_normalize_add
 #include <private/dsp/arch/x86/sse/fft/p_switch.h>
 
 namespace lsp
@@ -301,6 +321,55 @@ namespace lsp
 
             packed_fft_repack_normalize(dst, rank);
         }
+
+        void packed_direct_fft_windowed(float *dst, const float *src, const float *window, size_t rank)
+        {
+            // The in-place scramble swaps samples, so the window is applied by the separate pass
+            if ((rank <= 2) || (dst == src))
+            {
+                if (dst != src)
+                    dsp::copy(dst, src, 2 << rank);
+                dsp::pcomplex_r2c_mul2(dst, window, 1 << rank);
+                packed_direct_fft(dst, dst, rank);
+                return;
+            }
+
+            // Apply the window while scrambling the order of samples
+            size_t srank = rank - 3;
+            if (srank <= 8)
+                packed_scramble_copy_direct_windowed8(dst, src, window, srank);
+            else if (srank <= 16)
+                packed_scramble_copy_direct_windowed16(dst, src, window, srank);
+            else
+                packed_scramble_copy_direct_windowed32(dst, src, window, srank);
+
+            for (size_t i=2; i < rank; ++i)
+                packed_butterfly_direct(dst, i, 1 << (rank - i - 1));
+
+            packed_fft_repack(dst, rank);
+        }
+
+        void packed_reverse_fft_add(float *dst, float *src, const float *window, size_t rank)
+        {
+            if (rank <= 2)
+            {
+                packed_reverse_fft(src, src, rank);
+                for (size_t i=0, n=1 << rank; i<n; ++i)
+                {
+                    dst[i*2]       += src[i*2] * window[i];
+                    dst[i*2 + 1]   += src[i*2 + 1] * window[i];
+                }
+                return;
+            }
+
+            // Perform the transform in the source buffer
+            packed_scramble_reverse(src, src, rank);
+
+            for (size_t i=2; i < rank; ++i)
+                packed_butterfly_reverse(src, i, 1 << (rank - i - 1));
+
+            packed_fft_repack_normalize_add(dst, src, window, rank);
+        }
     }
 }
 
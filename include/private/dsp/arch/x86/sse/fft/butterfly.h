@@ -197,8 +197,8 @@ namespace lsp
                 : [rank] "r" (rank), \
                   [a_re] "m" (a_re), [a_im] "m" (a_im), \
                   [b_re] "m" (b_re), [b_im] "m" (b_im), \
-                  [XFFT_A_RE] "g" (&XFFT_A_RE[0]), [XFFT_A_IM] "g" (&XFFT_A_IM[0]), \
-                  [XFFT_W_RE] "g" (&XFFT_W_RE[0]), [XFFT_W_IM] "g" (&XFFT_W_IM[0]) \
+                  [XFFT_A_RE] "g" (xa_re), [XFFT_A_IM] "g" (xa_im), \
+                  [XFFT_W_RE] "g" (xw_re), [XFFT_W_IM] "g" (xw_im) \
                 : "cc", "memory",  \
                   "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
                   "%xmm4", "%xmm5", "%xmm6", "%xmm7" \
@@ -280,8 +280,8 @@ namespace lsp
                 : [a_re] "r"(a_re), [a_im] "r"(a_im), \
                   [b_re] "r"(b_re), [b_im] "r"(b_im), \
                   [rank] "r" (rank), \
-                  [XFFT_A_RE] "r" (XFFT_A_RE), [XFFT_A_IM] "r" (XFFT_A_IM), \
-                  [XFFT_W_RE] "r" (XFFT_W_RE), [XFFT_W_IM] "r"(XFFT_W_IM) \
+                  [XFFT_A_RE] "r" (xa_re), [XFFT_A_IM] "r" (xa_im), \
+                  [XFFT_W_RE] "r" (xw_re), [XFFT_W_IM] "r"(xw_im) \
                 : "cc", "memory", \
                   "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
                   "%xmm4", "%xmm5", "%xmm6", "%xmm7" \
@@ -331,7 +331,9 @@ namespace lsp
         static inline void butterfly_direct(float *dst_re, float *dst_im, size_t rank, size_t blocks)
         {
             size_t pairs = 1 << rank;
-            rank = (rank - 2) << 4;
+            const float *xa_re, *xa_im, *xw_re, *xw_im;
+            float xw[16] __lsp_aligned16;
+            rank = fft_twiddle_rows(xa_re, xa_im, xw_re, xw_im, xw, rank);
 
             for (size_t b=0; b<blocks; ++b)
             {
@@ -342,7 +344,9 @@ namespace lsp
         static inline void butterfly_reverse(float *dst_re, float *dst_im, size_t rank, size_t blocks)
         {
             size_t pairs = 1 << rank;
-            rank = (rank - 2) << 4;
+            const float *xa_re, *xa_im, *xw_re, *xw_im;
+            float xw[16] __lsp_aligned16;
+            rank = fft_twiddle_rows(xa_re, xa_im, xw_re, xw_im, xw, rank);
 
             for (size_t b=0; b<blocks; ++b)
             {
@@ -150,6 +150,94 @@ namespace lsp
             1.0000000000000000f, 0.9999999954041073f, 0.9999999816164293f, 0.9999999586369661f, 0.0000000000000000f, 0.0000958737990960f, 0.0001917475973107f, 0.0002876213937629f,
             1.0000000000000000f, 0.9999999988510268f, 0.9999999954041073f, 0.9999999896592415f, 0.0000000000000000f, 0.0000479368996031f, 0.0000958737990960f, 0.0001438106983686f
         };
+
+        /**
+         * Number of butterfly ranks covered by the XFFT_A_RE, XFFT_A_IM and XFFT_A tables
+         */
+        static constexpr size_t XFFT_TABLE_RANKS    = sizeof(XFFT_A_RE) / (sizeof(float) * 4);
+
+        /**
+         * Compute the twiddle factors for the butterfly of the rank not covered by
+         * the tables with double precision
+         *
+         * @param a_re real part of the initial angle, 4 elements
+         * @param a_im imaginary part of the initial angle, 4 elements
+         * @param w_re real part of the angle rotation, 4 elements
+         * @param w_im imaginary part of the angle rotation, 4 elements
+         * @param rank the rank of butterfly
+         */
+        static void fft_twiddle_compute(float *a_re, float *a_im, float *w_re, float *w_im, size_t rank)
+        {
+            double k        = M_PI / double(size_t(1) << rank);
+            double r_re     = cos(k * 4.0);
+            double r_im     = sin(k * 4.0);
+            for (size_t i=0; i<4; ++i)
+            {
+                a_re[i]         = cos(k * i);
+                a_im[i]         = sin(k * i);
+                w_re[i]         = r_re;
+                w_im[i]         = r_im;
+            }
+        }
+
+        /**
+         * Get the twiddle factors for the butterfly of the specified rank
+         *
+         * @param a_re pointer to store the address of the XFFT_A_RE table or its replacement
+         * @param a_im pointer to store the address of the XFFT_A_IM table or its replacement
+         * @param w_re pointer to store the address of the XFFT_W_RE table or its replacement
+         * @param w_im pointer to store the address of the XFFT_W_IM table or its replacement
+         * @param xw temporary buffer of 16 elements aligned to 16-byte boundary
+         * @param rank the rank of butterfly, should be at least 2
+         * @return the byte offset of the twiddle factors relative to the returned addresses
+         */
+        static inline size_t fft_twiddle_rows(
+            const float * &a_re, const float * &a_im,
+            const float * &w_re, const float * &w_im,
+            float *xw, size_t rank)
+        {
+            size_t row      = rank - 2;
+            if (row < XFFT_TABLE_RANKS)
+            {
+                a_re            = XFFT_A_RE;
+                a_im            = XFFT_A_IM;
+                w_re            = XFFT_W_RE;
+                w_im            = XFFT_W_IM;
+                return row << 4;
+            }
+
+            fft_twiddle_compute(&xw[0], &xw[4], &xw[8], &xw[12], rank);
+            a_re            = &xw[0];
+            a_im            = &xw[4];
+            w_re            = &xw[8];
+            w_im            = &xw[12];
+            return 0;
+        }
+
+        /**
+         * Get the twiddle factors for the packed butterfly of the specified rank
+         *
+         * @param a pointer to store the address of the XFFT_A table or its replacement
+         * @param w pointer to store the address of the XFFT_W table or its replacement
+         * @param xw temporary buffer of 16 elements aligned to 16-byte boundary
+         * @param rank the rank of butterfly, should be at least 2
+         * @return the byte offset of the twiddle factors relative to the returned addresses
+         */
+        static inline size_t packed_fft_twiddle_rows(const float * &a, const float * &w, float *xw, size_t rank)
+        {
+            size_t row      = rank - 2;
+            if (row < XFFT_TABLE_RANKS)
+            {
+                a               = XFFT_A;
+                w               = XFFT_W;
+                return row << 5;
+            }
+
+            fft_twiddle_compute(&xw[0], &xw[4], &xw[8], &xw[12], rank);
+            a               = &xw[0];
+            w               = &xw[8];
+            return 0;
+        }
     }
 }
 
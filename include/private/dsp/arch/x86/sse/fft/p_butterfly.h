@@ -110,9 +110,9 @@ namespace lsp
                 __ASM_EMIT("2:") \
                 \
                 : [a] "+r" (a), [b] "+r"(b), [p] "+r" (p) \
-                : [rank] "r" (rank), [XFFT_W] "r"(XFFT_W), \
-                  __IF_64([XFFT_A] "r" (XFFT_A)) \
-                  __IF_32([XFFT_A] "g" (&XFFT_A[0]), [tmp1] "g" (&tmp1)) \
+                : [rank] "r" (rank), [XFFT_W] "r"(xw_ptr), \
+                  __IF_64([XFFT_A] "r" (xa_ptr)) \
+                  __IF_32([XFFT_A] "g" (xa_ptr), [tmp1] "g" (&tmp1)) \
                 : "cc", "memory",  \
                 "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
                 "%xmm4", "%xmm5", "%xmm6", "%xmm7" \
@@ -121,7 +121,9 @@ namespace lsp
         static inline void packed_butterfly_direct(float *dst, size_t rank, size_t blocks)
         {
             size_t pairs = 1 << (rank + 1);
-            rank = (rank - 2) << 5;
+            const float *xa_ptr, *xw_ptr;
+            float xw[16] __lsp_aligned16;
+            rank = packed_fft_twiddle_rows(xa_ptr, xw_ptr, xw, rank);
 
             for (size_t blk=0; blk<blocks; ++blk)
             {
@@ -132,7 +134,9 @@ namespace lsp
         static inline void packed_butterfly_reverse(float *dst, size_t rank, size_t blocks)
         {
             size_t pairs = 1 << (rank + 1);
-            rank = (rank - 2) << 5;
+            const float *xa_ptr, *xw_ptr;
+            float xw[16] __lsp_aligned16;
+            rank = packed_fft_twiddle_rows(xa_ptr, xw_ptr, xw, rank);
 
             for (size_t blk=0; blk<blocks; ++blk)
             {
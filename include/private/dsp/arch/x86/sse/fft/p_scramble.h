@@ -54,76 +54,7 @@ namespace lsp
             }
 
             // Perform butterfly 8x
-            items = 1 << (rank - 3);
-
-            // Perform 4-element butterflies
-            ARCH_X86_ASM
-            (
-                /* Loop */
-                __ASM_EMIT(".align 16")
-                __ASM_EMIT("1:")
-
-                /* Load data to registers */
-                __ASM_EMIT("movups      0x00(%[dst]), %%xmm0")      /* xmm0 = r0 i0 r1 i1 */
-                __ASM_EMIT("movups      0x10(%[dst]), %%xmm2")      /* xmm2 = r2 i2 r3 i3 */
-                __ASM_EMIT("movups      0x20(%[dst]), %%xmm4")      /* xmm4 = r4 i4 r5 i5 */
-                __ASM_EMIT("movups      0x30(%[dst]), %%xmm6")      /* xmm6 = r6 i6 r7 i7 */
-
-                /* 1st-order 4x butterfly */
-                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0 i0 r1 i1 */
-                __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = r4 i4 r5 i5 */
-                __ASM_EMIT("shufps      $0x44, %%xmm2, %%xmm0")     /* xmm0 = r0 i0 r2 i2 */
-                __ASM_EMIT("shufps      $0x44, %%xmm6, %%xmm4")     /* xmm4 = r4 i4 r6 i6 */
-                __ASM_EMIT("shufps      $0xee, %%xmm2, %%xmm1")     /* xmm1 = r1 i1 r3 i3 */
-                __ASM_EMIT("shufps      $0xee, %%xmm6, %%xmm5")     /* xmm5 = r5 i5 r7 i7 */
-
-                __ASM_EMIT("movaps      %%xmm0, %%xmm2")            /* xmm2 = r0 i0 r2 i2 */
-                __ASM_EMIT("movaps      %%xmm4, %%xmm6")            /* xmm6 = r4 i4 r6 i6 */
-                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0+r1 i0+i1 r2+r3 i2+i3 = r0' i0' r2' i2' */
-                __ASM_EMIT("addps       %%xmm5, %%xmm4")            /* xmm4 = r4+r5 i4+i5 r6+r7 i6+i7 = r4' i4' r6' i6' */
-                __ASM_EMIT("subps       %%xmm1, %%xmm2")            /* xmm2 = r0-r1 i0-i1 r2-r3 i2-i3 = r1' i1' r3' i3' */
-                __ASM_EMIT("subps       %%xmm5, %%xmm6")            /* xmm6 = r4-r5 i4-i5 r6-r7 i6-i7 = r5' i5' r7' i7' */
-
-                /* 2nd-order 4x butterfly */
-                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0' i0' r2' i2' */
-                __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = r4' i4' r6' i6' */
-                __ASM_EMIT("shufps      $0x44, %%xmm2, %%xmm0")     /* xmm0 = r0' i0' r1' i1' */
-                __ASM_EMIT("shufps      $0x44, %%xmm6, %%xmm4")     /* xmm4 = r4' i4' r5' i5' */
-                __ASM_EMIT("shufps      $0xbe, %%xmm2, %%xmm1")     /* xmm1 = r2' i2' i3' r3' */
-                __ASM_EMIT("shufps      $0xbe, %%xmm6, %%xmm5")     /* xmm5 = r6' i6' i7' r7' */
-
-                __ASM_EMIT("movaps      %%xmm0, %%xmm2")            /* xmm2 = r0' i0' r1' i1' */
-                __ASM_EMIT("movaps      %%xmm4, %%xmm6")            /* xmm6 = r4' i4' r5' i5' */
-                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0'+r2' i0'+i2' r1'+i3' i1'+r3' = r0" i0" r1" i3" */
-                __ASM_EMIT("addps       %%xmm5, %%xmm4")            /* xmm4 = r4'+r6' i4'+i6' r5'+i7' i5'+r7' = r4" i4" r5" i7" */
-                __ASM_EMIT("subps       %%xmm1, %%xmm2")            /* xmm2 = r0'-r2' i0'-i2' r1'-i3' i1'-r3' = r2" i2" r3" i1" */
-                __ASM_EMIT("subps       %%xmm5, %%xmm6")            /* xmm6 = r4'-r6' i4'-i6' r5'-i7' i5'-r7' = r6" i6" r7" i5" */
-
-                /* Reorder and store */
-                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0" i0" r1" i3" */
-                __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = r4" i4" r5" i7" */
-                __ASM_EMIT("shufps      $0x88, %%xmm2, %%xmm0")     /* xmm0 = r0" r1" r2" r3" */
-                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm4")     /* xmm4 = r4" r5" r6" r7" */
-                __ASM_EMIT("shufps      $0xdd, %%xmm2, %%xmm1")     /* xmm1 = i0" i3" i2" i1" */
-                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm5")     /* xmm5 = i4" i7" i6" i5" */
-                __ASM_EMIT("shufps      $0x6c, %%xmm1, %%xmm1")     /* xmm1 = i0" i1" i2" i3" */
-                __ASM_EMIT("shufps      $0x6c, %%xmm5, %%xmm5")     /* xmm5 = i4" i5" i6" i7" */
-
-                __ASM_EMIT("movups      %%xmm0, 0x00(%[dst])")
-                __ASM_EMIT("movups      %%xmm1, 0x10(%[dst])")
-                __ASM_EMIT("movups      %%xmm4, 0x20(%[dst])")
-                __ASM_EMIT("movups      %%xmm5, 0x30(%[dst])")
-
-                /* Move pointers and repeat cycle */
-                __ASM_EMIT("add         $0x40, %[dst]")
-                __ASM_EMIT("dec         %[items]")
-                __ASM_EMIT("jnz         1b")
-
-                : [dst] "+r"(dst), [items] "+r"(items)
-                :
-                : "cc", "memory",
-                  "%xmm0", "%xmm1", "%xmm2", "%xmm4", "%xmm5", "%xmm6"
-            );
+            packed_fft_start_direct(dst, rank);
         }
 
         static inline void FFT_SCRAMBLE_SELF_REVERSE_NAME(float *dst, const float *src, size_t rank)
@@ -152,76 +83,7 @@ namespace lsp
             }
 
             // Perform butterfly 8x
-            items = 1 << (rank - 3);
-
-            // Perform 4-element butterflies
-            ARCH_X86_ASM
-            (
-                /* Loop */
-                __ASM_EMIT(".align 16")
-                __ASM_EMIT("1:")
-
-                /* Load data to registers */
-                __ASM_EMIT("movups      0x00(%[dst]), %%xmm0")      /* xmm0 = r0 i0 r1 i1 */
-                __ASM_EMIT("movups      0x10(%[dst]), %%xmm2")      /* xmm2 = r2 i2 r3 i3 */
-                __ASM_EMIT("movups      0x20(%[dst]), %%xmm4")      /* xmm4 = r4 i4 r5 i5 */
-                __ASM_EMIT("movups      0x30(%[dst]), %%xmm6")      /* xmm6 = r6 i6 r7 i7 */
-
-                /* 1st-order 4x butterfly */
-                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0 i0 r1 i1 */
-                __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = r4 i4 r5 i5 */
-                __ASM_EMIT("shufps      $0x44, %%xmm2, %%xmm0")     /* xmm0 = r0 i0 r2 i2 */
-                __ASM_EMIT("shufps      $0x44, %%xmm6, %%xmm4")     /* xmm4 = r4 i4 r6 i6 */
-                __ASM_EMIT("shufps      $0xee, %%xmm2, %%xmm1")     /* xmm1 = r1 i1 r3 i3 */
-                __ASM_EMIT("shufps      $0xee, %%xmm6, %%xmm5")     /* xmm5 = r5 i5 r7 i7 */
-
-                __ASM_EMIT("movaps      %%xmm0, %%xmm2")            /* xmm2 = r0 i0 r2 i2 */
-                __ASM_EMIT("movaps      %%xmm4, %%xmm6")            /* xmm6 = r4 i4 r6 i6 */
-                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0+r1 i0+i1 r2+r3 i2+i3 = r0' i0' r2' i2' */
-                __ASM_EMIT("addps       %%xmm5, %%xmm4")            /* xmm4 = r4+r5 i4+i5 r6+r7 i6+i7 = r4' i4' r6' i6' */
-                __ASM_EMIT("subps       %%xmm1, %%xmm2")            /* xmm2 = r0-r1 i0-i1 r2-r3 i2-i3 = r1' i1' r3' i3' */
-                __ASM_EMIT("subps       %%xmm5, %%xmm6")            /* xmm6 = r4-r5 i4-i5 r6-r7 i6-i7 = r5' i5' r7' i7' */
-
-                /* 2nd-order 4x butterfly */
-                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0' i0' r2' i2' */
-                __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = r4' i4' r6' i6' */
-                __ASM_EMIT("shufps      $0x44, %%xmm2, %%xmm0")     /* xmm0 = r0' i0' r1' i1' */
-                __ASM_EMIT("shufps      $0xbe, %%xmm2, %%xmm1")     /* xmm1 = r2' i2' i3' r3' */
-                __ASM_EMIT("shufps      $0x44, %%xmm6, %%xmm4")     /* xmm4 = r4' i4' r5' i5' */
-                __ASM_EMIT("shufps      $0xbe, %%xmm6, %%xmm5")     /* xmm5 = r6' i6' i7' r7' */
-
-                __ASM_EMIT("movaps      %%xmm0, %%xmm2")            /* xmm2 = r0' i0' r1' i1' */
-                __ASM_EMIT("movaps      %%xmm4, %%xmm6")            /* xmm6 = r4' i4' r5' i5' */
-                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0'+r2' i0'+i2' r1'+i3' i1'+r3' = r0" i0" r3" i1" */
-                __ASM_EMIT("addps       %%xmm5, %%xmm4")            /* xmm4 = r4'+r6' i4'+i6' r5'+i7' i5'+r7' = r4" i4" r7" i5" */
-                __ASM_EMIT("subps       %%xmm1, %%xmm2")            /* xmm2 = r0'-r2' i0'-i2' r1'-i3' i1'-r3' = r2" i2" r1" i3" */
-                __ASM_EMIT("subps       %%xmm5, %%xmm6")            /* xmm6 = r4'-r6' i4'-i6' r5'-i7' i5'-r7' = r6" i6" r5" i7" */
-
-                /* Reorder and store */
-                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0" i0" r3" i1" */
-                __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = r4" i4" r7" i5" */
-                __ASM_EMIT("shufps      $0x88, %%xmm2, %%xmm0")     /* xmm0 = r0" r3" r2" r1" */
-                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm4")     /* xmm4 = r4" r7" r6" r5" */
-                __ASM_EMIT("shufps      $0xdd, %%xmm2, %%xmm1")     /* xmm1 = i0" i1" i2" i3" */
-                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm5")     /* xmm5 = i4" i5" i6" i7" */
-                __ASM_EMIT("shufps      $0x6c, %%xmm0, %%xmm0")     /* xmm0 = r0" r1" r2" r3" */
-                __ASM_EMIT("shufps      $0x6c, %%xmm4, %%xmm4")     /* xmm4 = r4" r5" r6" r7" */
-
-                __ASM_EMIT("movups      %%xmm0, 0x00(%[dst])")
-                __ASM_EMIT("movups      %%xmm1, 0x10(%[dst])")
-                __ASM_EMIT("movups      %%xmm4, 0x20(%[dst])")
-                __ASM_EMIT("movups      %%xmm5, 0x30(%[dst])")
-
-                /* Move pointers and repeat cycle */
-                __ASM_EMIT("add         $0x40, %[dst]")
-                __ASM_EMIT("dec         %[items]")
-                __ASM_EMIT("jnz         1b")
-
-                : [dst] "+r"(dst), [items] "+r"(items)
-                :
-                : "cc", "memory",
-                  "%xmm0", "%xmm1", "%xmm2", "%xmm4", "%xmm5", "%xmm6"
-            );
+            packed_fft_start_reverse(dst, rank);
         }
 
         static inline void FFT_SCRAMBLE_COPY_DIRECT_NAME(float *dst, const float *src, size_t rank)
@@ -316,6 +178,110 @@ namespace lsp
             }
         }
 
+        static inline void FFT_SCRAMBLE_COPY_DIRECT_WINDOWED_NAME(float *dst, const float *src, const float *wnd, size_t rank)
+        {
+            size_t regs     = 1 << rank;
+
+            for (size_t i=0; i<regs; ++i)
+            {
+                size_t index    = reverse_bits(FFT_TYPE(i), rank);
+
+                // Perform 4-element butterflies, the window is applied to samples at load
+                ARCH_X86_ASM
+                (
+                    /* Load data and window to registers */
+                    __ASM_EMIT("movlps      (%[src], %[index], 8), %%xmm0") /* xmm0 = r0 i0 x x     */
+                    __ASM_EMIT("movss       (%[wnd], %[index], 4), %%xmm6") /* xmm6 = w0 0 0 0      */
+                    __ASM_EMIT("add         %[regs], %[index]")
+                    __ASM_EMIT("movlps      (%[src], %[index], 8), %%xmm4") /* xmm4 = r4 i4 x x     */
+                    __ASM_EMIT("movss       (%[wnd], %[index], 4), %%xmm7") /* xmm7 = w4 0 0 0      */
+                    __ASM_EMIT("add         %[regs], %[index]")
+                    __ASM_EMIT("movlps      (%[src], %[index], 8), %%xmm2") /* xmm2 = r2 i2 x x     */
+                    __ASM_EMIT("movss       (%[wnd], %[index], 4), %%xmm3") /* xmm3 = w2 0 0 0      */
+                    __ASM_EMIT("add         %[regs], %[index]")
+                    __ASM_EMIT("movlhps     %%xmm2, %%xmm0")                /* xmm0 = r0 i0 r2 i2   */
+                    __ASM_EMIT("unpcklps    %%xmm3, %%xmm6")                /* xmm6 = w0 w2 0 0     */
+                    __ASM_EMIT("movlps      (%[src], %[index], 8), %%xmm2") /* xmm2 = r6 i6 x x     */
+                    __ASM_EMIT("movss       (%[wnd], %[index], 4), %%xmm3") /* xmm3 = w6 0 0 0      */
+                    __ASM_EMIT("add         %[regs], %[index]")
+                    __ASM_EMIT("movlhps     %%xmm2, %%xmm4")                /* xmm4 = r4 i4 r6 i6   */
+                    __ASM_EMIT("unpcklps    %%xmm3, %%xmm7")                /* xmm7 = w4 w6 0 0     */
+                    __ASM_EMIT("unpcklps    %%xmm6, %%xmm6")                /* xmm6 = w0 w0 w2 w2   */
+                    __ASM_EMIT("unpcklps    %%xmm7, %%xmm7")                /* xmm7 = w4 w4 w6 w6   */
+                    __ASM_EMIT("mulps       %%xmm6, %%xmm0")                /* xmm0 = r0 i0 r2 i2   */
+                    __ASM_EMIT("mulps       %%xmm7, %%xmm4")                /* xmm4 = r4 i4 r6 i6   */
+
+                    __ASM_EMIT("movlps      (%[src], %[index], 8), %%xmm1") /* xmm1 = r1 i1 x x     */
+                    __ASM_EMIT("movss       (%[wnd], %[index], 4), %%xmm6") /* xmm6 = w1 0 0 0      */
+                    __ASM_EMIT("add         %[regs], %[index]")
+                    __ASM_EMIT("movlps      (%[src], %[index], 8), %%xmm5") /* xmm5 = r5 i5 x x     */
+                    __ASM_EMIT("movss       (%[wnd], %[index], 4), %%xmm7") /* xmm7 = w5 0 0 0      */
+                    __ASM_EMIT("add         %[regs], %[index]")
+                    __ASM_EMIT("movlps      (%[src], %[index], 8), %%xmm2") /* xmm2 = r3 i3 x x     */
+                    __ASM_EMIT("movss       (%[wnd], %[index], 4), %%xmm3") /* xmm3 = w3 0 0 0      */
+                    __ASM_EMIT("add         %[regs], %[index]")
+                    __ASM_EMIT("movlhps     %%xmm2, %%xmm1")                /* xmm1 = r1 i1 r3 i3   */
+                    __ASM_EMIT("unpcklps    %%xmm3, %%xmm6")                /* xmm6 = w1 w3 0 0     */
+                    __ASM_EMIT("movlps      (%[src], %[index], 8), %%xmm2") /* xmm2 = r7 i7 x x     */
+                    __ASM_EMIT("movss       (%[wnd], %[index], 4), %%xmm3") /* xmm3 = w7 0 0 0      */
+                    __ASM_EMIT("add         %[regs], %[index]")
+                    __ASM_EMIT("movlhps     %%xmm2, %%xmm5")                /* xmm5 = r5 i5 r7 i7   */
+                    __ASM_EMIT("unpcklps    %%xmm3, %%xmm7")                /* xmm7 = w5 w7 0 0     */
+                    __ASM_EMIT("unpcklps    %%xmm6, %%xmm6")                /* xmm6 = w1 w1 w3 w3   */
+                    __ASM_EMIT("unpcklps    %%xmm7, %%xmm7")                /* xmm7 = w5 w5 w7 w7   */
+                    __ASM_EMIT("mulps       %%xmm6, %%xmm1")                /* xmm1 = r1 i1 r3 i3   */
+                    __ASM_EMIT("mulps       %%xmm7, %%xmm5")                /* xmm5 = r5 i5 r7 i7   */
+
+                    /* 1st-order 4x butterfly */
+                    __ASM_EMIT("movaps      %%xmm0, %%xmm2")            /* xmm2 = r0 i0 r2 i2 */
+                    __ASM_EMIT("movaps      %%xmm4, %%xmm6")            /* xmm6 = r4 i4 r6 i6 */
+                    __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0+r1 i0+i1 r2+r3 i2+i3 = r0' i0' r2' i2' */
+                    __ASM_EMIT("subps       %%xmm1, %%xmm2")            /* xmm2 = r0-r1 i0-i1 r2-r3 i2-i3 = r1' i1' r3' i3' */
+                    __ASM_EMIT("addps       %%xmm5, %%xmm4")            /* xmm4 = r4+r5 i4+i5 r6+r7 i6+i7 = r4' i4' r6' i6' */
+                    __ASM_EMIT("subps       %%xmm5, %%xmm6")            /* xmm6 = r4-r5 i4-i5 r6-r7 i6-i7 = r5' i5' r7' i7' */
+
+                    /* 2nd-order 4x butterfly */
+                    __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0' i0' r2' i2' */
+                    __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = r4' i4' r6' i6' */
+                    __ASM_EMIT("shufps      $0x44, %%xmm2, %%xmm0")     /* xmm0 = r0' i0' r1' i1' */
+                    __ASM_EMIT("shufps      $0xbe, %%xmm2, %%xmm1")     /* xmm1 = r2' i2' i3' r3' */
+                    __ASM_EMIT("shufps      $0x44, %%xmm6, %%xmm4")     /* xmm4 = r4' i4' r5' i5' */
+                    __ASM_EMIT("shufps      $0xbe, %%xmm6, %%xmm5")     /* xmm5 = r6' i6' i7' r7' */
+
+                    __ASM_EMIT("movaps      %%xmm0, %%xmm2")            /* xmm2 = r0' i0' r1' i1' */
+                    __ASM_EMIT("movaps      %%xmm4, %%xmm6")            /* xmm6 = r4' i4' r5' i5' */
+                    __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0'+r2' i0'+i2' r1'+i3' i1'+r3' = r0" i0" r1" i3" */
+                    __ASM_EMIT("addps       %%xmm5, %%xmm4")            /* xmm4 = r4'+r6' i4'+i6' r5'+i7' i5'+r7' = r4" i4" r5" i7" */
+                    __ASM_EMIT("subps       %%xmm1, %%xmm2")            /* xmm2 = r0'-r2' i0'-i2' r1'-i3' i1'-r3' = r2" i2" r3" i1" */
+                    __ASM_EMIT("subps       %%xmm5, %%xmm6")            /* xmm6 = r4'-r6' i4'-i6' r5'-i7' i5'-r7' = r6" i6" r7" i5" */
+
+                    /* Reorder and store */
+                    __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0" i0" r1" i3" */
+                    __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = r4" i4" r5" i7" */
+                    __ASM_EMIT("shufps      $0x88, %%xmm2, %%xmm0")     /* xmm0 = r0" r1" r2" r3" */
+                    __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm4")     /* xmm4 = r4" r5" r6" r7" */
+                    __ASM_EMIT("shufps      $0xdd, %%xmm2, %%xmm1")     /* xmm1 = i0" i3" i2" i1" */
+                    __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm5")     /* xmm5 = i4" i7" i6" i5" */
+                    __ASM_EMIT("shufps      $0x6c, %%xmm1, %%xmm1")     /* xmm1 = i0" i1" i2" i3" */
+                    __ASM_EMIT("shufps      $0x6c, %%xmm5, %%xmm5")     /* xmm5 = i4" i5" i6" i7" */
+
+                    __ASM_EMIT("movups      %%xmm0, 0x00(%[dst])")
+                    __ASM_EMIT("movups      %%xmm1, 0x10(%[dst])")
+                    __ASM_EMIT("movups      %%xmm4, 0x20(%[dst])")
+                    __ASM_EMIT("movups      %%xmm5, 0x30(%[dst])")
+
+                    /* Move pointers and repeat cycle */
+                    __ASM_EMIT("add         $0x40, %[dst]")
+
+                    : [dst] "+r"(dst), [index] "+r"(index)
+                    : [src] "r" (src), [wnd] "r" (wnd), [regs] "r" (regs)
+                    : "cc", "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                      "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+                );
+            }
+        }
+
         static inline void FFT_SCRAMBLE_COPY_REVERSE_NAME(float *dst, const float *src, size_t rank)
         {
             size_t regs     = 1 << rank;
@@ -413,6 +379,7 @@ namespace lsp
 
 #undef FFT_SCRAMBLE_SELF_DIRECT_NAME
 #undef FFT_SCRAMBLE_COPY_DIRECT_NAME
+#undef FFT_SCRAMBLE_COPY_DIRECT_WINDOWED_NAME
 #undef FFT_SCRAMBLE_SELF_REVERSE_NAME
 #undef FFT_SCRAMBLE_COPY_REVERSE_NAME
 #undef FFT_REPACK
@@ -40,8 +40,10 @@ namespace lsp
             {
                 if (rank <= 8)
                     SSE_CALL_NAME(FFT_SCRAMBLE_SELF_DIRECT_NAME, 8);
-                else //if (rank <= 16)
+                else if (rank <= 16)
                     SSE_CALL_NAME(FFT_SCRAMBLE_SELF_DIRECT_NAME, 16);
+                else
+                    SSE_CALL_NAME(FFT_SCRAMBLE_SELF_DIRECT_NAME, 32);
             }
             else
             {
@@ -49,8 +51,10 @@ namespace lsp
 
                 if (rank <= 8)
                     SSE_CALL_NAME(FFT_SCRAMBLE_COPY_DIRECT_NAME, 8);
-                else //if (rank <= 16)
+                else if (rank <= 16)
                     SSE_CALL_NAME(FFT_SCRAMBLE_COPY_DIRECT_NAME, 16);
+                else
+                    SSE_CALL_NAME(FFT_SCRAMBLE_COPY_DIRECT_NAME, 32);
             }
         }
 
@@ -61,8 +65,10 @@ namespace lsp
             {
                 if (rank <= 8)
                     SSE_CALL_NAME(FFT_SCRAMBLE_SELF_REVERSE_NAME, 8);
-                else //if (rank <= 16)
+                else if (rank <= 16)
                     SSE_CALL_NAME(FFT_SCRAMBLE_SELF_REVERSE_NAME, 16);
+                else
+                    SSE_CALL_NAME(FFT_SCRAMBLE_SELF_REVERSE_NAME, 32);
             }
             else
             {
@@ -70,8 +76,10 @@ namespace lsp
 
                 if (rank <= 8)
                     SSE_CALL_NAME(FFT_SCRAMBLE_COPY_REVERSE_NAME, 8);
-                else //if (rank <= 16)
+                else if (rank <= 16)
                     SSE_CALL_NAME(FFT_SCRAMBLE_COPY_REVERSE_NAME, 16);
+                else
+                    SSE_CALL_NAME(FFT_SCRAMBLE_COPY_REVERSE_NAME, 32);
             }
         }
 
@@ -169,6 +177,74 @@ namespace lsp
                   "%xmm4", "%xmm5", "%xmm6", "%xmm7"
             );
         }
+
+        static inline void SSE_FFT_NAME(FFT_REPACK_NORMALIZE_ADD)(float *dst, const float *src, const float *wnd, size_t rank)
+        {
+            size_t blocks       = 1 << (rank-3);
+            float k             = 0.125f/blocks;
+
+            // Repack, apply normalization and window and add to the destination
+            ARCH_X86_ASM
+            (
+                __ASM_EMIT("shufps      $0x00, %%xmm0, %%xmm0")     /* xmm0 = k  k  k  k  */
+                __ASM_EMIT(".align 16")
+                __ASM_EMIT("1:")
+
+                /* Load data and window */
+                __ASM_EMIT("movups      0x00(%[wnd]), %%xmm1")      /* xmm1 = w0 w1 w2 w3 */
+                __ASM_EMIT("movups      0x10(%[wnd]), %%xmm5")      /* xmm5 = w4 w5 w6 w7 */
+                __ASM_EMIT("movups      0x00(%[src]), %%xmm2")      /* xmm2 = r0 r1 r2 r3 */
+                __ASM_EMIT("movups      0x10(%[src]), %%xmm3")      /* xmm3 = i0 i1 i2 i3 */
+                __ASM_EMIT("movups      0x20(%[src]), %%xmm6")      /* xmm6 = r4 r5 r6 r7 */
+                __ASM_EMIT("movups      0x30(%[src]), %%xmm7")      /* xmm7 = i4 i5 i6 i7 */
+
+                /* 1st step: apply normalization and window */
+                __ASM_EMIT("mulps       %%xmm0, %%xmm1")            /* xmm1 = k*w0 k*w1 k*w2 k*w3 */
+                __ASM_EMIT("mulps       %%xmm0, %%xmm5")            /* xmm5 = k*w4 k*w5 k*w6 k*w7 */
+                __ASM_EMIT("mulps       %%xmm1, %%xmm2")
+                __ASM_EMIT("mulps       %%xmm1, %%xmm3")
+                __ASM_EMIT("mulps       %%xmm5, %%xmm6")
+                __ASM_EMIT("mulps       %%xmm5, %%xmm7")
+
+                /* 2nd step: repack pairs */
+                __ASM_EMIT("movaps      %%xmm2, %%xmm4")            /* xmm4 = r0 r1 r2 r3 */
+                __ASM_EMIT("movaps      %%xmm6, %%xmm1")            /* xmm1 = r4 r5 r6 r7 */
+                __ASM_EMIT("unpcklps    %%xmm3, %%xmm2")            /* xmm2 = r0 i0 r1 i1 */
+                __ASM_EMIT("unpckhps    %%xmm3, %%xmm4")            /* xmm4 = r2 i2 r3 i3 */
+                __ASM_EMIT("unpcklps    %%xmm7, %%xmm6")            /* xmm6 = r4 i4 r5 i5 */
+                __ASM_EMIT("unpckhps    %%xmm7, %%xmm1")            /* xmm1 = r6 i6 r7 i7 */
+
+                /* 3rd step: add to the destination */
+                __ASM_EMIT("movups      0x00(%[dst]), %%xmm3")
+                __ASM_EMIT("movups      0x10(%[dst]), %%xmm5")
+                __ASM_EMIT("movups      0x20(%[dst]), %%xmm7")
+                __ASM_EMIT("addps       %%xmm3, %%xmm2")
+                __ASM_EMIT("addps       %%xmm5, %%xmm4")
+                __ASM_EMIT("addps       %%xmm7, %%xmm6")
+                __ASM_EMIT("movups      0x30(%[dst]), %%xmm3")
+                __ASM_EMIT("addps       %%xmm3, %%xmm1")
+
+                /* Store data */
+                __ASM_EMIT("movups      %%xmm2, 0x00(%[dst])")
+                __ASM_EMIT("movups      %%xmm4, 0x10(%[dst])")
+                __ASM_EMIT("movups      %%xmm6, 0x20(%[dst])")
+                __ASM_EMIT("movups      %%xmm1, 0x30(%[dst])")
+
+                /* Move pointers and repeat cycle */
+                __ASM_EMIT("add         $0x40, %[dst]")
+                __ASM_EMIT("add         $0x40, %[src]")
+                __ASM_EMIT("add         $0x20, %[wnd]")
+                __ASM_EMIT("dec         %[blocks]")
+                __ASM_EMIT("jnz         1b")
+
+                : [dst] "+r"(dst), [src] "+r"(src), [wnd] "+r"(wnd),
+                  [blocks] "+r"(blocks), "+Yz"(k)
+                :
+                : "cc", "memory",
+                  "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+            );
+        }
     }
 }
 
@@ -187,5 +263,6 @@ namespace lsp
 #undef FFT_SCRAMBLE_REVERSE_NAME
 #undef FFT_REPACK
 #undef FFT_REPACK_NORMALIZED
+#undef FFT_REPACK_NORMALIZE_ADD
 #undef FFT_MODE
 
@@ -57,79 +57,7 @@ namespace lsp
             }
 
             // Perform butterfly 8x
-            items = 1 << (rank - 3);
-
-            // Perform 4-element butterflies
-            ARCH_X86_ASM
-            (
-                /* Loop */
-                __ASM_EMIT(".align 16")
-                __ASM_EMIT("1:")
-
-                /* Load data to registers */
-                __ASM_EMIT("movups      0x00(%[dst_re]), %%xmm0")   /* xmm0 = r0 r1 r2 r3 */
-                __ASM_EMIT("movups      0x10(%[dst_re]), %%xmm4")   /* xmm4 = r4 r5 r6 r7 */
-                __ASM_EMIT("movups      0x00(%[dst_im]), %%xmm2")   /* xmm2 = i0 i1 i2 i3 */
-                __ASM_EMIT("movups      0x10(%[dst_im]), %%xmm6")   /* xmm6 = i4 i5 i6 i7 */
-
-                /* 1st-order 4x butterfly */
-                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0 r1 r2 r3 */
-                __ASM_EMIT("movaps      %%xmm2, %%xmm3")            /* xmm3 = i0 i1 i2 i3 */
-                __ASM_EMIT("shufps      $0x88, %%xmm4, %%xmm0")     /* xmm0 = r0 r2 r4 r6 */
-                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm2")     /* xmm2 = i0 i2 i4 i6 */
-                __ASM_EMIT("shufps      $0xdd, %%xmm4, %%xmm1")     /* xmm1 = r1 r3 r5 r7 */
-                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm3")     /* xmm3 = i1 i3 i5 i7 */
-
-                __ASM_EMIT("movaps      %%xmm0, %%xmm4")            /* xmm4 = r0 r2 r4 r6 */
-                __ASM_EMIT("movaps      %%xmm2, %%xmm6")            /* xmm5 = i0 i2 i4 i6 */
-                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0+r1 r2+r3 r4+r5 r6+r7 = r0' r2' r4' r6' */
-                __ASM_EMIT("addps       %%xmm3, %%xmm2")            /* xmm2 = i0+i1 i2+i3 i4+i5 i6+i7 = i0' i2' i4' i6' */
-                __ASM_EMIT("subps       %%xmm1, %%xmm4")            /* xmm4 = r0-r1 r2-r3 r4-r5 r6-r7 = r1' r3' r5' r7' */
-                __ASM_EMIT("subps       %%xmm3, %%xmm6")            /* xmm6 = i0-i1 i2-i3 i4-i5 i6-i7 = i1' i3' i5' i7' */
-
-                /* 2nd-order 4x butterfly */
-                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0' r2' r4' r6' */
-                __ASM_EMIT("movaps      %%xmm2, %%xmm3")            /* xmm3 = i0' i2' i4' i6' */
-                __ASM_EMIT("shufps      $0x88, %%xmm4, %%xmm0")     /* xmm0 = r0' r4' r1' r5' */
-                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm1")     /* xmm1 = r2' r6' i3' i7' */
-                __ASM_EMIT("shufps      $0xdd, %%xmm4, %%xmm3")     /* xmm3 = i2' i6' r3' r7' */
-                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm2")     /* xmm2 = i0' i4' i1' i5' */
-
-                __ASM_EMIT("movaps      %%xmm0, %%xmm4")            /* xmm4 = r0' r4' r1' r5' */
-                __ASM_EMIT("movaps      %%xmm2, %%xmm6")            /* xmm5 = i0' i4' i1' i5' */
-                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0'+r2' r4'+r6' r1'+i3' r5'+i7' = r0" r4" r1" r5" */
-                __ASM_EMIT("addps       %%xmm3, %%xmm2")            /* xmm2 = i0'+i2' i4'+i6' i1'+r3' i5'+r7' = i0" i4" i3" i7" */
-                __ASM_EMIT("subps       %%xmm1, %%xmm4")            /* xmm4 = r0'-r2' r4'-r6' r1'-i3' r5'-i7' = r2" r6" r3" r7" */
-                __ASM_EMIT("subps       %%xmm3, %%xmm6")            /* xmm6 = i0'-i2' i4'-i6' i1'-r3' i5'-r7' = i2" i6" i1" i5" */
-
-                /* Reorder and store */
-                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0" r4" r1" r5" */
-                __ASM_EMIT("movaps      %%xmm2, %%xmm3")            /* xmm3 = i0" i4" i3" i7" */
-                __ASM_EMIT("shufps      $0x88, %%xmm4, %%xmm0")     /* xmm0 = r0" r1" r2" r3" */
-                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm2")     /* xmm2 = i0" i3" i2" i1" */
-                __ASM_EMIT("shufps      $0xdd, %%xmm4, %%xmm1")     /* xmm1 = r4" r5" r6" r7" */
-                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm3")     /* xmm3 = i4" i7" i6" i5" */
-                __ASM_EMIT("shufps      $0x6c, %%xmm2, %%xmm2")     /* xmm2 = i0" i1" i2" i3" */
-                __ASM_EMIT("shufps      $0x6c, %%xmm3, %%xmm3")     /* xmm3 = i4" i5" i6" i7" */
-
-                __ASM_EMIT("movups      %%xmm0, 0x00(%[dst_re])")
-                __ASM_EMIT("movups      %%xmm1, 0x10(%[dst_re])")
-                __ASM_EMIT("movups      %%xmm2, 0x00(%[dst_im])")
-                __ASM_EMIT("movups      %%xmm3, 0x10(%[dst_im])")
-
-                /* Move pointers */
-                __ASM_EMIT("add     $0x20, %[dst_re]")
-                __ASM_EMIT("add     $0x20, %[dst_im]")
-
-                /* Repeat cycle */
-                __ASM_EMIT("dec     %[items]")
-                __ASM_EMIT("jnz     1b")
-                __ASM_EMIT("2:")
-                : [dst_re] "+r"(dst_re), [dst_im] "+r"(dst_im), [items] "+r"(items)
-                :
-                : "cc", "memory",
-                  "%xmm0", "%xmm1", "%xmm2"
-            );
+            fft_start_direct(dst_re, dst_im, rank);
         }
 
         static inline void FFT_SCRAMBLE_COPY_DIRECT_NAME(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
@@ -272,79 +200,7 @@ namespace lsp
             }
 
             // Perform butterfly 4x
-            items = 1 << (rank - 3);
-
-            // Perform 4-element butterflies
-            ARCH_X86_ASM
-            (
-                /* Loop */
-                __ASM_EMIT(".align 16")
-                __ASM_EMIT("1:")
-
-                /* Load data to registers */
-                __ASM_EMIT("movups      0x00(%[dst_re]), %%xmm0")   /* xmm0 = r0 r1 r2 r3 */
-                __ASM_EMIT("movups      0x10(%[dst_re]), %%xmm4")   /* xmm4 = r4 r5 r6 r7 */
-                __ASM_EMIT("movups      0x00(%[dst_im]), %%xmm2")   /* xmm2 = i0 i1 i2 i3 */
-                __ASM_EMIT("movups      0x10(%[dst_im]), %%xmm6")   /* xmm6 = i4 i5 i6 i7 */
-
-                /* 1st-order 4x butterfly */
-                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0 r1 r2 r3 */
-                __ASM_EMIT("movaps      %%xmm2, %%xmm3")            /* xmm3 = i0 i1 i2 i3 */
-                __ASM_EMIT("shufps      $0x88, %%xmm4, %%xmm0")     /* xmm0 = r0 r2 r4 r6 */
-                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm2")     /* xmm2 = i0 i2 i4 i6 */
-                __ASM_EMIT("shufps      $0xdd, %%xmm4, %%xmm1")     /* xmm1 = r1 r3 r5 r7 */
-                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm3")     /* xmm3 = i1 i3 i5 i7 */
-
-                __ASM_EMIT("movaps      %%xmm0, %%xmm4")            /* xmm4 = r0 r2 r4 r6 */
-                __ASM_EMIT("movaps      %%xmm2, %%xmm6")            /* xmm5 = i0 i2 i4 i6 */
-                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0+r1 r2+r3 r4+r5 r6+r7 = r0' r2' r4' r6' */
-                __ASM_EMIT("addps       %%xmm3, %%xmm2")            /* xmm2 = i0+i1 i2+i3 i4+i5 i6+i7 = i0' i2' i4' i6' */
-                __ASM_EMIT("subps       %%xmm1, %%xmm4")            /* xmm4 = r0-r1 r2-r3 r4-r5 r6-r7 = r1' r3' r5' r7' */
-                __ASM_EMIT("subps       %%xmm3, %%xmm6")            /* xmm6 = i0-i1 i2-i3 i4-i5 i6-i7 = i1' i3' i5' i7' */
-
-                /* 2nd-order 4x butterfly */
-                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0' r2' r4' r6' */
-                __ASM_EMIT("movaps      %%xmm2, %%xmm3")            /* xmm3 = i0' i2' i4' i6' */
-                __ASM_EMIT("shufps      $0x88, %%xmm4, %%xmm0")     /* xmm0 = r0' r4' r1' r5' */
-                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm1")     /* xmm1 = r2' r6' i3' i7' */
-                __ASM_EMIT("shufps      $0xdd, %%xmm4, %%xmm3")     /* xmm3 = i2' i6' r3' r7' */
-                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm2")     /* xmm2 = i0' i4' i1' i5' */
-
-                __ASM_EMIT("movaps      %%xmm0, %%xmm4")            /* xmm4 = r0' r4' r1' r5' */
-                __ASM_EMIT("movaps      %%xmm2, %%xmm6")            /* xmm5 = i0' i4' i1' i5' */
-                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0'+r2' r4'+r6' r1'+i3' r5'+i7' = r0" r4" r3" r7" */
-                __ASM_EMIT("addps       %%xmm3, %%xmm2")            /* xmm2 = i0'+i2' i4'+i6' i1'+i3' i5'+i7' = i0" i4" i1" i5" */
-                __ASM_EMIT("subps       %%xmm1, %%xmm4")            /* xmm4 = r0'-r2' r4'-r6' r1'-i3' r5'-i7' = r2" r6" r1" r5" */
-                __ASM_EMIT("subps       %%xmm3, %%xmm6")            /* xmm6 = i0'-i2' i4'-i6' i1'-i3' i5'-i7' = i2" i6" i3" i7" */
-
-                /* Reorder and store */
-                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0" r4" r3" r7" */
-                __ASM_EMIT("movaps      %%xmm2, %%xmm3")            /* xmm3 = i0" i4" i1" i5" */
-                __ASM_EMIT("shufps      $0x88, %%xmm4, %%xmm0")     /* xmm0 = r0" r3" r2" r1" */
-                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm2")     /* xmm2 = i0" i1" i2" i3" */
-                __ASM_EMIT("shufps      $0xdd, %%xmm4, %%xmm1")     /* xmm1 = r4" r7" r6" r5" */
-                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm3")     /* xmm3 = i4" i5" i6" i7" */
-                __ASM_EMIT("shufps      $0x6c, %%xmm0, %%xmm0")     /* xmm0 = r0" r1" r2" r3" */
-                __ASM_EMIT("shufps      $0x6c, %%xmm1, %%xmm1")     /* xmm1 = r4" r5" r6" r7" */
-
-                __ASM_EMIT("movups      %%xmm0, 0x00(%[dst_re])")
-                __ASM_EMIT("movups      %%xmm1, 0x10(%[dst_re])")
-                __ASM_EMIT("movups      %%xmm2, 0x00(%[dst_im])")
-                __ASM_EMIT("movups      %%xmm3, 0x10(%[dst_im])")
-
-                /* Move pointers */
-                __ASM_EMIT("add     $0x20, %[dst_re]")
-                __ASM_EMIT("add     $0x20, %[dst_im]")
-
-                /* Repeat cycle */
-                __ASM_EMIT("dec     %[items]")
-                __ASM_EMIT("jnz     1b")
-                __ASM_EMIT("2:")
-                : [dst_re] "+r"(dst_re), [dst_im] "+r"(dst_im), [items] "+r"(items)
-                :
-                : "cc", "memory",
-                  "%xmm0", "%xmm1", "%xmm2"
-            );
+            fft_start_reverse(dst_re, dst_im, rank);
         }
 
         static inline void FFT_SCRAMBLE_COPY_REVERSE_NAME(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
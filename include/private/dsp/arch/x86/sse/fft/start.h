@@ -0,0 +1,341 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_SSE_FFT_START_H_
+#define PRIVATE_DSP_ARCH_X86_SSE_FFT_START_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_SSE_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_SSE_IMPL */
+
+namespace lsp
+{
+    namespace sse
+    {
+        /*
+         * The first two stages of the transform performed on the data which has
+         * already been scrambled in-place, the rank should be at least 3
+         */
+        static inline void fft_start_direct(float *dst_re, float *dst_im, size_t rank)
+        {
+            size_t items    = 1 << (rank - 3);
+
+            // Perform 4-element butterflies
+            ARCH_X86_ASM
+            (
+                /* Loop */
+                __ASM_EMIT(".align 16")
+                __ASM_EMIT("1:")
+
+                /* Load data to registers */
+                __ASM_EMIT("movups      0x00(%[dst_re]), %%xmm0")   /* xmm0 = r0 r1 r2 r3 */
+                __ASM_EMIT("movups      0x10(%[dst_re]), %%xmm4")   /* xmm4 = r4 r5 r6 r7 */
+                __ASM_EMIT("movups      0x00(%[dst_im]), %%xmm2")   /* xmm2 = i0 i1 i2 i3 */
+                __ASM_EMIT("movups      0x10(%[dst_im]), %%xmm6")   /* xmm6 = i4 i5 i6 i7 */
+
+                /* 1st-order 4x butterfly */
+                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0 r1 r2 r3 */
+                __ASM_EMIT("movaps      %%xmm2, %%xmm3")            /* xmm3 = i0 i1 i2 i3 */
+                __ASM_EMIT("shufps      $0x88, %%xmm4, %%xmm0")     /* xmm0 = r0 r2 r4 r6 */
+                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm2")     /* xmm2 = i0 i2 i4 i6 */
+                __ASM_EMIT("shufps      $0xdd, %%xmm4, %%xmm1")     /* xmm1 = r1 r3 r5 r7 */
+                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm3")     /* xmm3 = i1 i3 i5 i7 */
+
+                __ASM_EMIT("movaps      %%xmm0, %%xmm4")            /* xmm4 = r0 r2 r4 r6 */
+                __ASM_EMIT("movaps      %%xmm2, %%xmm6")            /* xmm5 = i0 i2 i4 i6 */
+                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0+r1 r2+r3 r4+r5 r6+r7 = r0' r2' r4' r6' */
+                __ASM_EMIT("addps       %%xmm3, %%xmm2")            /* xmm2 = i0+i1 i2+i3 i4+i5 i6+i7 = i0' i2' i4' i6' */
+                __ASM_EMIT("subps       %%xmm1, %%xmm4")            /* xmm4 = r0-r1 r2-r3 r4-r5 r6-r7 = r1' r3' r5' r7' */
+                __ASM_EMIT("subps       %%xmm3, %%xmm6")            /* xmm6 = i0-i1 i2-i3 i4-i5 i6-i7 = i1' i3' i5' i7' */
+
+                /* 2nd-order 4x butterfly */
+                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0' r2' r4' r6' */
+                __ASM_EMIT("movaps      %%xmm2, %%xmm3")            /* xmm3 = i0' i2' i4' i6' */
+                __ASM_EMIT("shufps      $0x88, %%xmm4, %%xmm0")     /* xmm0 = r0' r4' r1' r5' */
+                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm1")     /* xmm1 = r2' r6' i3' i7' */
+                __ASM_EMIT("shufps      $0xdd, %%xmm4, %%xmm3")     /* xmm3 = i2' i6' r3' r7' */
+                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm2")     /* xmm2 = i0' i4' i1' i5' */
+
+                __ASM_EMIT("movaps      %%xmm0, %%xmm4")            /* xmm4 = r0' r4' r1' r5' */
+                __ASM_EMIT("movaps      %%xmm2, %%xmm6")            /* xmm5 = i0' i4' i1' i5' */
+                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0'+r2' r4'+r6' r1'+i3' r5'+i7' = r0" r4" r1" r5" */
+                __ASM_EMIT("addps       %%xmm3, %%xmm2")            /* xmm2 = i0'+i2' i4'+i6' i1'+r3' i5'+r7' = i0" i4" i3" i7" */
+                __ASM_EMIT("subps       %%xmm1, %%xmm4")            /* xmm4 = r0'-r2' r4'-r6' r1'-i3' r5'-i7' = r2" r6" r3" r7" */
+                __ASM_EMIT("subps       %%xmm3, %%xmm6")            /* xmm6 = i0'-i2' i4'-i6' i1'-r3' i5'-r7' = i2" i6" i1" i5" */
+
+                /* Reorder and store */
+                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0" r4" r1" r5" */
+                __ASM_EMIT("movaps      %%xmm2, %%xmm3")            /* xmm3 = i0" i4" i3" i7" */
+                __ASM_EMIT("shufps      $0x88, %%xmm4, %%xmm0")     /* xmm0 = r0" r1" r2" r3" */
+                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm2")     /* xmm2 = i0" i3" i2" i1" */
+                __ASM_EMIT("shufps      $0xdd, %%xmm4, %%xmm1")     /* xmm1 = r4" r5" r6" r7" */
+                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm3")     /* xmm3 = i4" i7" i6" i5" */
+                __ASM_EMIT("shufps      $0x6c, %%xmm2, %%xmm2")     /* xmm2 = i0" i1" i2" i3" */
+                __ASM_EMIT("shufps      $0x6c, %%xmm3, %%xmm3")     /* xmm3 = i4" i5" i6" i7" */
+
+                __ASM_EMIT("movups      %%xmm0, 0x00(%[dst_re])")
+                __ASM_EMIT("movups      %%xmm1, 0x10(%[dst_re])")
+                __ASM_EMIT("movups      %%xmm2, 0x00(%[dst_im])")
+                __ASM_EMIT("movups      %%xmm3, 0x10(%[dst_im])")
+
+                /* Move pointers */
+                __ASM_EMIT("add     $0x20, %[dst_re]")
+                __ASM_EMIT("add     $0x20, %[dst_im]")
+
+                /* Repeat cycle */
+                __ASM_EMIT("dec     %[items]")
+                __ASM_EMIT("jnz     1b")
+                __ASM_EMIT("2:")
+                : [dst_re] "+r"(dst_re), [dst_im] "+r"(dst_im), [items] "+r"(items)
+                :
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2"
+            );
+        }
+
+        static inline void fft_start_reverse(float *dst_re, float *dst_im, size_t rank)
+        {
+            size_t items    = 1 << (rank - 3);
+
+            // Perform 4-element butterflies
+            ARCH_X86_ASM
+            (
+                /* Loop */
+                __ASM_EMIT(".align 16")
+                __ASM_EMIT("1:")
+
+                /* Load data to registers */
+                __ASM_EMIT("movups      0x00(%[dst_re]), %%xmm0")   /* xmm0 = r0 r1 r2 r3 */
+                __ASM_EMIT("movups      0x10(%[dst_re]), %%xmm4")   /* xmm4 = r4 r5 r6 r7 */
+                __ASM_EMIT("movups      0x00(%[dst_im]), %%xmm2")   /* xmm2 = i0 i1 i2 i3 */
+                __ASM_EMIT("movups      0x10(%[dst_im]), %%xmm6")   /* xmm6 = i4 i5 i6 i7 */
+
+                /* 1st-order 4x butterfly */
+                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0 r1 r2 r3 */
+                __ASM_EMIT("movaps      %%xmm2, %%xmm3")            /* xmm3 = i0 i1 i2 i3 */
+                __ASM_EMIT("shufps      $0x88, %%xmm4, %%xmm0")     /* xmm0 = r0 r2 r4 r6 */
+                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm2")     /* xmm2 = i0 i2 i4 i6 */
+                __ASM_EMIT("shufps      $0xdd, %%xmm4, %%xmm1")     /* xmm1 = r1 r3 r5 r7 */
+                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm3")     /* xmm3 = i1 i3 i5 i7 */
+
+                __ASM_EMIT("movaps      %%xmm0, %%xmm4")            /* xmm4 = r0 r2 r4 r6 */
+                __ASM_EMIT("movaps      %%xmm2, %%xmm6")            /* xmm5 = i0 i2 i4 i6 */
+                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0+r1 r2+r3 r4+r5 r6+r7 = r0' r2' r4' r6' */
+                __ASM_EMIT("addps       %%xmm3, %%xmm2")            /* xmm2 = i0+i1 i2+i3 i4+i5 i6+i7 = i0' i2' i4' i6' */
+                __ASM_EMIT("subps       %%xmm1, %%xmm4")            /* xmm4 = r0-r1 r2-r3 r4-r5 r6-r7 = r1' r3' r5' r7' */
+                __ASM_EMIT("subps       %%xmm3, %%xmm6")            /* xmm6 = i0-i1 i2-i3 i4-i5 i6-i7 = i1' i3' i5' i7' */
+
+                /* 2nd-order 4x butterfly */
+                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0' r2' r4' r6' */
+                __ASM_EMIT("movaps      %%xmm2, %%xmm3")            /* xmm3 = i0' i2' i4' i6' */
+                __ASM_EMIT("shufps      $0x88, %%xmm4, %%xmm0")     /* xmm0 = r0' r4' r1' r5' */
+                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm1")     /* xmm1 = r2' r6' i3' i7' */
+                __ASM_EMIT("shufps      $0xdd, %%xmm4, %%xmm3")     /* xmm3 = i2' i6' r3' r7' */
+                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm2")     /* xmm2 = i0' i4' i1' i5' */
+
+                __ASM_EMIT("movaps      %%xmm0, %%xmm4")            /* xmm4 = r0' r4' r1' r5' */
+                __ASM_EMIT("movaps      %%xmm2, %%xmm6")            /* xmm5 = i0' i4' i1' i5' */
+                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0'+r2' r4'+r6' r1'+i3' r5'+i7' = r0" r4" r3" r7" */
+                __ASM_EMIT("addps       %%xmm3, %%xmm2")            /* xmm2 = i0'+i2' i4'+i6' i1'+i3' i5'+i7' = i0" i4" i1" i5" */
+                __ASM_EMIT("subps       %%xmm1, %%xmm4")            /* xmm4 = r0'-r2' r4'-r6' r1'-i3' r5'-i7' = r2" r6" r1" r5" */
+                __ASM_EMIT("subps       %%xmm3, %%xmm6")            /* xmm6 = i0'-i2' i4'-i6' i1'-i3' i5'-i7' = i2" i6" i3" i7" */
+
+                /* Reorder and store */
+                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0" r4" r3" r7" */
+                __ASM_EMIT("movaps      %%xmm2, %%xmm3")            /* xmm3 = i0" i4" i1" i5" */
+                __ASM_EMIT("shufps      $0x88, %%xmm4, %%xmm0")     /* xmm0 = r0" r3" r2" r1" */
+                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm2")     /* xmm2 = i0" i1" i2" i3" */
+                __ASM_EMIT("shufps      $0xdd, %%xmm4, %%xmm1")     /* xmm1 = r4" r7" r6" r5" */
+                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm3")     /* xmm3 = i4" i5" i6" i7" */
+                __ASM_EMIT("shufps      $0x6c, %%xmm0, %%xmm0")     /* xmm0 = r0" r1" r2" r3" */
+                __ASM_EMIT("shufps      $0x6c, %%xmm1, %%xmm1")     /* xmm1 = r4" r5" r6" r7" */
+
+                __ASM_EMIT("movups      %%xmm0, 0x00(%[dst_re])")
+                __ASM_EMIT("movups      %%xmm1, 0x10(%[dst_re])")
+                __ASM_EMIT("movups      %%xmm2, 0x00(%[dst_im])")
+                __ASM_EMIT("movups      %%xmm3, 0x10(%[dst_im])")
+
+                /* Move pointers */
+                __ASM_EMIT("add     $0x20, %[dst_re]")
+                __ASM_EMIT("add     $0x20, %[dst_im]")
+
+                /* Repeat cycle */
+                __ASM_EMIT("dec     %[items]")
+                __ASM_EMIT("jnz     1b")
+                __ASM_EMIT("2:")
+                : [dst_re] "+r"(dst_re), [dst_im] "+r"(dst_im), [items] "+r"(items)
+                :
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2"
+            );
+        }
+
+        static inline void packed_fft_start_direct(float *dst, size_t rank)
+        {
+            size_t items    = 1 << (rank - 3);
+
+            // Perform 4-element butterflies
+            ARCH_X86_ASM
+            (
+                /* Loop */
+                __ASM_EMIT(".align 16")
+                __ASM_EMIT("1:")
+
+                /* Load data to registers */
+                __ASM_EMIT("movups      0x00(%[dst]), %%xmm0")      /* xmm0 = r0 i0 r1 i1 */
+                __ASM_EMIT("movups      0x10(%[dst]), %%xmm2")      /* xmm2 = r2 i2 r3 i3 */
+                __ASM_EMIT("movups      0x20(%[dst]), %%xmm4")      /* xmm4 = r4 i4 r5 i5 */
+                __ASM_EMIT("movups      0x30(%[dst]), %%xmm6")      /* xmm6 = r6 i6 r7 i7 */
+
+                /* 1st-order 4x butterfly */
+                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0 i0 r1 i1 */
+                __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = r4 i4 r5 i5 */
+                __ASM_EMIT("shufps      $0x44, %%xmm2, %%xmm0")     /* xmm0 = r0 i0 r2 i2 */
+                __ASM_EMIT("shufps      $0x44, %%xmm6, %%xmm4")     /* xmm4 = r4 i4 r6 i6 */
+                __ASM_EMIT("shufps      $0xee, %%xmm2, %%xmm1")     /* xmm1 = r1 i1 r3 i3 */
+                __ASM_EMIT("shufps      $0xee, %%xmm6, %%xmm5")     /* xmm5 = r5 i5 r7 i7 */
+
+                __ASM_EMIT("movaps      %%xmm0, %%xmm2")            /* xmm2 = r0 i0 r2 i2 */
+                __ASM_EMIT("movaps      %%xmm4, %%xmm6")            /* xmm6 = r4 i4 r6 i6 */
+                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0+r1 i0+i1 r2+r3 i2+i3 = r0' i0' r2' i2' */
+                __ASM_EMIT("addps       %%xmm5, %%xmm4")            /* xmm4 = r4+r5 i4+i5 r6+r7 i6+i7 = r4' i4' r6' i6' */
+                __ASM_EMIT("subps       %%xmm1, %%xmm2")            /* xmm2 = r0-r1 i0-i1 r2-r3 i2-i3 = r1' i1' r3' i3' */
+                __ASM_EMIT("subps       %%xmm5, %%xmm6")            /* xmm6 = r4-r5 i4-i5 r6-r7 i6-i7 = r5' i5' r7' i7' */
+
+                /* 2nd-order 4x butterfly */
+                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0' i0' r2' i2' */
+                __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = r4' i4' r6' i6' */
+                __ASM_EMIT("shufps      $0x44, %%xmm2, %%xmm0")     /* xmm0 = r0' i0' r1' i1' */
+                __ASM_EMIT("shufps      $0x44, %%xmm6, %%xmm4")     /* xmm4 = r4' i4' r5' i5' */
+                __ASM_EMIT("shufps      $0xbe, %%xmm2, %%xmm1")     /* xmm1 = r2' i2' i3' r3' */
+                __ASM_EMIT("shufps      $0xbe, %%xmm6, %%xmm5")     /* xmm5 = r6' i6' i7' r7' */
+
+                __ASM_EMIT("movaps      %%xmm0, %%xmm2")            /* xmm2 = r0' i0' r1' i1' */
+                __ASM_EMIT("movaps      %%xmm4, %%xmm6")            /* xmm6 = r4' i4' r5' i5' */
+                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0'+r2' i0'+i2' r1'+i3' i1'+r3' = r0" i0" r1" i3" */
+                __ASM_EMIT("addps       %%xmm5, %%xmm4")            /* xmm4 = r4'+r6' i4'+i6' r5'+i7' i5'+r7' = r4" i4" r5" i7" */
+                __ASM_EMIT("subps       %%xmm1, %%xmm2")            /* xmm2 = r0'-r2' i0'-i2' r1'-i3' i1'-r3' = r2" i2" r3" i1" */
+                __ASM_EMIT("subps       %%xmm5, %%xmm6")            /* xmm6 = r4'-r6' i4'-i6' r5'-i7' i5'-r7' = r6" i6" r7" i5" */
+
+                /* Reorder and store */
+                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0" i0" r1" i3" */
+                __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = r4" i4" r5" i7" */
+                __ASM_EMIT("shufps      $0x88, %%xmm2, %%xmm0")     /* xmm0 = r0" r1" r2" r3" */
+                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm4")     /* xmm4 = r4" r5" r6" r7" */
+                __ASM_EMIT("shufps      $0xdd, %%xmm2, %%xmm1")     /* xmm1 = i0" i3" i2" i1" */
+                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm5")     /* xmm5 = i4" i7" i6" i5" */
+                __ASM_EMIT("shufps      $0x6c, %%xmm1, %%xmm1")     /* xmm1 = i0" i1" i2" i3" */
+                __ASM_EMIT("shufps      $0x6c, %%xmm5, %%xmm5")     /* xmm5 = i4" i5" i6" i7" */
+
+                __ASM_EMIT("movups      %%xmm0, 0x00(%[dst])")
+                __ASM_EMIT("movups      %%xmm1, 0x10(%[dst])")
+                __ASM_EMIT("movups      %%xmm4, 0x20(%[dst])")
+                __ASM_EMIT("movups      %%xmm5, 0x30(%[dst])")
+
+                /* Move pointers and repeat cycle */
+                __ASM_EMIT("add         $0x40, %[dst]")
+                __ASM_EMIT("dec         %[items]")
+                __ASM_EMIT("jnz         1b")
+
+                : [dst] "+r"(dst), [items] "+r"(items)
+                :
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm4", "%xmm5", "%xmm6"
+            );
+        }
+
+        static inline void packed_fft_start_reverse(float *dst, size_t rank)
+        {
+            size_t items    = 1 << (rank - 3);
+
+            // Perform 4-element butterflies
+            ARCH_X86_ASM
+            (
+                /* Loop */
+                __ASM_EMIT(".align 16")
+                __ASM_EMIT("1:")
+
+                /* Load data to registers */
+                __ASM_EMIT("movups      0x00(%[dst]), %%xmm0")      /* xmm0 = r0 i0 r1 i1 */
+                __ASM_EMIT("movups      0x10(%[dst]), %%xmm2")      /* xmm2 = r2 i2 r3 i3 */
+                __ASM_EMIT("movups      0x20(%[dst]), %%xmm4")      /* xmm4 = r4 i4 r5 i5 */
+                __ASM_EMIT("movups      0x30(%[dst]), %%xmm6")      /* xmm6 = r6 i6 r7 i7 */
+
+                /* 1st-order 4x butterfly */
+                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0 i0 r1 i1 */
+                __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = r4 i4 r5 i5 */
+                __ASM_EMIT("shufps      $0x44, %%xmm2, %%xmm0")     /* xmm0 = r0 i0 r2 i2 */
+                __ASM_EMIT("shufps      $0x44, %%xmm6, %%xmm4")     /* xmm4 = r4 i4 r6 i6 */
+                __ASM_EMIT("shufps      $0xee, %%xmm2, %%xmm1")     /* xmm1 = r1 i1 r3 i3 */
+                __ASM_EMIT("shufps      $0xee, %%xmm6, %%xmm5")     /* xmm5 = r5 i5 r7 i7 */
+
+                __ASM_EMIT("movaps      %%xmm0, %%xmm2")            /* xmm2 = r0 i0 r2 i2 */
+                __ASM_EMIT("movaps      %%xmm4, %%xmm6")            /* xmm6 = r4 i4 r6 i6 */
+                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0+r1 i0+i1 r2+r3 i2+i3 = r0' i0' r2' i2' */
+                __ASM_EMIT("addps       %%xmm5, %%xmm4")            /* xmm4 = r4+r5 i4+i5 r6+r7 i6+i7 = r4' i4' r6' i6' */
+                __ASM_EMIT("subps       %%xmm1, %%xmm2")            /* xmm2 = r0-r1 i0-i1 r2-r3 i2-i3 = r1' i1' r3' i3' */
+                __ASM_EMIT("subps       %%xmm5, %%xmm6")            /* xmm6 = r4-r5 i4-i5 r6-r7 i6-i7 = r5' i5' r7' i7' */
+
+                /* 2nd-order 4x butterfly */
+                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0' i0' r2' i2' */
+                __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = r4' i4' r6' i6' */
+                __ASM_EMIT("shufps      $0x44, %%xmm2, %%xmm0")     /* xmm0 = r0' i0' r1' i1' */
+                __ASM_EMIT("shufps      $0xbe, %%xmm2, %%xmm1")     /* xmm1 = r2' i2' i3' r3' */
+                __ASM_EMIT("shufps      $0x44, %%xmm6, %%xmm4")     /* xmm4 = r4' i4' r5' i5' */
+                __ASM_EMIT("shufps      $0xbe, %%xmm6, %%xmm5")     /* xmm5 = r6' i6' i7' r7' */
+
+                __ASM_EMIT("movaps      %%xmm0, %%xmm2")            /* xmm2 = r0' i0' r1' i1' */
+                __ASM_EMIT("movaps      %%xmm4, %%xmm6")            /* xmm6 = r4' i4' r5' i5' */
+                __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = r0'+r2' i0'+i2' r1'+i3' i1'+r3' = r0" i0" r3" i1" */
+                __ASM_EMIT("addps       %%xmm5, %%xmm4")            /* xmm4 = r4'+r6' i4'+i6' r5'+i7' i5'+r7' = r4" i4" r7" i5" */
+                __ASM_EMIT("subps       %%xmm1, %%xmm2")            /* xmm2 = r0'-r2' i0'-i2' r1'-i3' i1'-r3' = r2" i2" r1" i3" */
+                __ASM_EMIT("subps       %%xmm5, %%xmm6")            /* xmm6 = r4'-r6' i4'-i6' r5'-i7' i5'-r7' = r6" i6" r5" i7" */
+
+                /* Reorder and store */
+                __ASM_EMIT("movaps      %%xmm0, %%xmm1")            /* xmm1 = r0" i0" r3" i1" */
+                __ASM_EMIT("movaps      %%xmm4, %%xmm5")            /* xmm5 = r4" i4" r7" i5" */
+                __ASM_EMIT("shufps      $0x88, %%xmm2, %%xmm0")     /* xmm0 = r0" r3" r2" r1" */
+                __ASM_EMIT("shufps      $0x88, %%xmm6, %%xmm4")     /* xmm4 = r4" r7" r6" r5" */
+                __ASM_EMIT("shufps      $0xdd, %%xmm2, %%xmm1")     /* xmm1 = i0" i1" i2" i3" */
+                __ASM_EMIT("shufps      $0xdd, %%xmm6, %%xmm5")     /* xmm5 = i4" i5" i6" i7" */
+                __ASM_EMIT("shufps      $0x6c, %%xmm0, %%xmm0")     /* xmm0 = r0" r1" r2" r3" */
+                __ASM_EMIT("shufps      $0x6c, %%xmm4, %%xmm4")     /* xmm4 = r4" r5" r6" r7" */
+
+                __ASM_EMIT("movups      %%xmm0, 0x00(%[dst])")
+                __ASM_EMIT("movups      %%xmm1, 0x10(%[dst])")
+                __ASM_EMIT("movups      %%xmm4, 0x20(%[dst])")
+                __ASM_EMIT("movups      %%xmm5, 0x30(%[dst])")
+
+                /* Move pointers and repeat cycle */
+                __ASM_EMIT("add         $0x40, %[dst]")
+                __ASM_EMIT("dec         %[items]")
+                __ASM_EMIT("jnz         1b")
+
+                : [dst] "+r"(dst), [items] "+r"(items)
+                :
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm4", "%xmm5", "%xmm6"
+            );
+        }
+    } /* namespace sse */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_SSE_FFT_START_H_ */
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_DSP_ARCH_X86_SSE_FFTPLAN_H_
+#define PRIVATE_DSP_ARCH_X86_SSE_FFTPLAN_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_SSE_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_SSE_IMPL */
+
+namespace lsp
+{
+    namespace sse
+    {
+        /*
+         * The plan replaces the bit-reversal part of the in-place scramble with the
+         * precomputed list of swapped pairs, the rest of the transform is performed
+         * by the same kernels as the in-place direct_fft() and reverse_fft(). These
+         * kernels use their own twiddle factor tables, so the twiddle factors stored
+         * in the plan are not used. Transforms of rank below 3 are too small for the
+         * kernels and are computed by the scalar code on the scrambled data, the
+         * reverse one as the direct transform with swapped real and imaginary parts.
+         */
+        static inline void fft_plan_swap(const dsp::fft_plan_t *plan, float *re, float *im)
+        {
+            const uint32_t *sw  = plan->swap;
+            for (size_t i=0; i<plan->nswap; ++i, sw += 2)
+            {
+                const size_t a  = sw[0];
+                const size_t b  = sw[1];
+                float t         = re[a];
+                re[a]           = re[b];
+                re[b]           = t;
+                t               = im[a];
+                im[a]           = im[b];
+                im[b]           = t;
+            }
+        }
+
+        static inline void fft_plan_packed_swap(const dsp::fft_plan_t *plan, float *data)
+        {
+            const uint32_t *sw  = plan->swap;
+            for (size_t i=0; i<plan->nswap; ++i, sw += 2)
+            {
+                float *a        = &data[sw[0] * 2];
+                float *b        = &data[sw[1] * 2];
+                float t_re      = a[0];
+                float t_im      = a[1];
+                a[0]            = b[0];
+                a[1]            = b[1];
+                b[0]            = t_re;
+                b[1]            = t_im;
+            }
+        }
+
+        static inline void fft_plan_packed_conj(float *data, size_t count, float k)
+        {
+            for (size_t i=0; i<count*2; i += 2)
+            {
+                data[i]        *= k;
+                data[i+1]      *= -k;
+            }
+        }
+
+        void fft_plan_direct(const dsp::fft_plan_t *plan, float *re, float *im)
+        {
+            const size_t rank   = plan->rank;
+            fft_plan_swap(plan, re, im);
+
+            if (rank < 3)
+            {
+                direct_fft(re, im, re, im, rank);
+                return;
+            }
+
+            fft_start_direct(re, im, rank);
+            for (size_t i=2; i < rank; ++i)
+                butterfly_direct(re, im, i, 1 << (rank - i - 1));
+        }
+
+        void fft_plan_reverse(const dsp::fft_plan_t *plan, float *re, float *im)
+        {
+            const size_t rank   = plan->rank;
+            fft_plan_swap(plan, re, im);
+
+            if (rank < 3)
+            {
+                const float k   = 1.0f / (1 << rank);
+                direct_fft(im, re, im, re, rank);
+                dsp::mul_k2(re, k, 1 << rank);
+                dsp::mul_k2(im, k, 1 << rank);
+                return;
+            }
+
+            fft_start_reverse(re, im, rank);
+            for (size_t i=2; i < rank; ++i)
+                butterfly_reverse(re, im, i, 1 << (rank - i - 1));
+            dsp::normalize_fft2(re, im, rank);
+        }
+
+        void fft_plan_packed_direct(const dsp::fft_plan_t *plan, float *data)
+        {
+            const size_t rank   = plan->rank;
+            fft_plan_packed_swap(plan, data);
+
+            if (rank < 3)
+            {
+                packed_direct_fft(data, data, rank);
+                return;
+            }
+
+            packed_fft_start_direct(data, rank);
+            for (size_t i=2; i < rank; ++i)
+                packed_butterfly_direct(data, i, 1 << (rank - i - 1));
+            packed_fft_repack(data, rank);
+        }
+
+        void fft_plan_packed_reverse(const dsp::fft_plan_t *plan, float *data)
+        {
+            const size_t rank   = plan->rank;
+            fft_plan_packed_swap(plan, data);
+
+            if (rank < 3)
+            {
+                fft_plan_packed_conj(data, 1 << rank, 1.0f);
+                packed_direct_fft(data, data, rank);
+                fft_plan_packed_conj(data, 1 << rank, 1.0f / (1 << rank));
+                return;
+            }
+
+            packed_fft_start_reverse(data, rank);
+            for (size_t i=2; i < rank; ++i)
+                packed_butterfly_reverse(data, i, 1 << (rank - i - 1));
+            packed_fft_repack_normalize(data, rank);
+        }
+    } /* namespace sse */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_SSE_FFTPLAN_H_ */
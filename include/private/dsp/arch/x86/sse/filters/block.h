@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 10 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_X86_SSE_FILTERS_BLOCK_H_
+#define PRIVATE_DSP_ARCH_X86_SSE_FILTERS_BLOCK_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_SSE_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_SSE_IMPL */
+
+namespace lsp
+{
+    namespace sse
+    {
+        /*
+         * Layout of the biquad_block_t structure:
+         *   +0x000  h[8][8]
+         *   +0x100  q[8][8]
+         *   +0x200  p[2][8]
+         *   +0x240  a[2][8]
+         *   +0x280  d[8]
+         *   +0x2a0  x1
+         */
+        #define BIQUAD_BLOCK_MAC(j) \
+            __ASM_EMIT("movss           " #j "*4(%[src]), %%xmm3")          /* xmm3     = s[j] */ \
+            __ASM_EMIT("shufps          $0x00, %%xmm3, %%xmm3") \
+            __ASM_EMIT("movaps          " #j "*0x20+0x000(%[f]), %%xmm4")   /* xmm4     = h[j][0:3] */ \
+            __ASM_EMIT("movaps          " #j "*0x20+0x010(%[f]), %%xmm5")   /* xmm5     = h[j][4:7] */ \
+            __ASM_EMIT("mulps           %%xmm3, %%xmm4") \
+            __ASM_EMIT("mulps           %%xmm3, %%xmm5") \
+            __ASM_EMIT("mulps           " #j "*0x20+0x100(%[f]), %%xmm3")   /* xmm3     = q[j]*s[j] */ \
+            __ASM_EMIT("addps           %%xmm4, %%xmm0")                    /* xmm0     = y[0:3] + h[j][0:3]*s[j] */ \
+            __ASM_EMIT("addps           %%xmm5, %%xmm1")                    /* xmm1     = y[4:7] + h[j][4:7]*s[j] */ \
+            __ASM_EMIT("addps           %%xmm3, %%xmm2")                    /* xmm2     = z + q[j]*s[j] */
+
+        static void biquad_block_core(float *dst, const float *src, size_t blocks, dsp::biquad_block_t *f)
+        {
+            ARCH_X86_ASM
+            (
+                __ASM_EMIT("movaps          0x280(%[f]), %%xmm7")               /* xmm7     = d0 d1 d0 d1 */
+
+                __ASM_EMIT("1:")
+                __ASM_EMIT("xorps           %%xmm0, %%xmm0")                    /* xmm0     = 0 */
+                __ASM_EMIT("xorps           %%xmm1, %%xmm1")                    /* xmm1     = 0 */
+                __ASM_EMIT("xorps           %%xmm2, %%xmm2")                    /* xmm2     = 0 */
+                /* Contribution of input samples */
+                BIQUAD_BLOCK_MAC(0)
+                BIQUAD_BLOCK_MAC(1)
+                BIQUAD_BLOCK_MAC(2)
+                BIQUAD_BLOCK_MAC(3)
+                BIQUAD_BLOCK_MAC(4)
+                BIQUAD_BLOCK_MAC(5)
+                BIQUAD_BLOCK_MAC(6)
+                BIQUAD_BLOCK_MAC(7)
+                /* Contribution of the state */
+                __ASM_EMIT("movaps          %%xmm7, %%xmm3")
+                __ASM_EMIT("movaps          %%xmm7, %%xmm6")
+                __ASM_EMIT("shufps          $0x00, %%xmm3, %%xmm3")             /* xmm3     = d0 */
+                __ASM_EMIT("shufps          $0x55, %%xmm6, %%xmm6")             /* xmm6     = d1 */
+                __ASM_EMIT("movaps          0x200(%[f]), %%xmm4")               /* xmm4     = p[0][0:3] */
+                __ASM_EMIT("movaps          0x210(%[f]), %%xmm5")               /* xmm5     = p[0][4:7] */
+                __ASM_EMIT("movaps          0x240(%[f]), %%xmm7")               /* xmm7     = a[0] */
+                __ASM_EMIT("mulps           %%xmm3, %%xmm4")
+                __ASM_EMIT("mulps           %%xmm3, %%xmm5")
+                __ASM_EMIT("mulps           %%xmm3, %%xmm7")
+                __ASM_EMIT("addps           %%xmm4, %%xmm0")
+                __ASM_EMIT("addps           %%xmm5, %%xmm1")
+                __ASM_EMIT("addps           %%xmm7, %%xmm2")
+                __ASM_EMIT("movaps          0x220(%[f]), %%xmm4")               /* xmm4     = p[1][0:3] */
+                __ASM_EMIT("movaps          0x230(%[f]), %%xmm5")               /* xmm5     = p[1][4:7] */
+                __ASM_EMIT("movaps          0x260(%[f]), %%xmm7")               /* xmm7     = a[1] */
+                __ASM_EMIT("mulps           %%xmm6, %%xmm4")
+                __ASM_EMIT("mulps           %%xmm6, %%xmm5")
+                __ASM_EMIT("mulps           %%xmm6, %%xmm7")
+                __ASM_EMIT("addps           %%xmm4, %%xmm0")                    /* xmm0     = y[0:3] */
+                __ASM_EMIT("addps           %%xmm5, %%xmm1")                    /* xmm1     = y[4:7] */
+                __ASM_EMIT("addps           %%xmm2, %%xmm7")                    /* xmm7     = d0' d1' d0' d1' */
+                __ASM_EMIT("movups          %%xmm0, 0x00(%[dst])")
+                __ASM_EMIT("movups          %%xmm1, 0x10(%[dst])")
+                __ASM_EMIT("add             $0x20, %[src]")
+                __ASM_EMIT("add             $0x20, %[dst]")
+                __ASM_EMIT64("dec           %[count]")
+                __ASM_EMIT32("decl          %[count]")
+                __ASM_EMIT("jnz             1b")
+
+                __ASM_EMIT("movaps          %%xmm7, 0x280(%[f])")
+                __ASM_EMIT("movaps          %%xmm7, 0x290(%[f])")
+
+                : [dst] "+r" (dst), [src] "+r" (src),
+                  [count] X86_PGREG (blocks)
+                : [f] "r" (f)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+            );
+        }
+
+        #undef BIQUAD_BLOCK_MAC
+
+        static void biquad_block_tail(float *dst, const float *src, size_t count, dsp::biquad_block_t *f)
+        {
+            float d0        = f->d[0];
+            float d1        = f->d[1];
+
+            for (size_t i=0; i<count; ++i)
+            {
+                float s         = src[i];
+                float s2        = f->x1.b0*s + d0;
+                float p1        = f->x1.b1*s + f->x1.a1*s2;
+                float p2        = f->x1.b2*s + f->x1.a2*s2;
+
+                dst[i]          = s2;
+                d0              = d1 + p1;
+                d1              = p2;
+            }
+
+            for (size_t i=0; i<8; i += 2)
+            {
+                f->d[i]         = d0;
+                f->d[i+1]       = d1;
+            }
+        }
+
+        void biquad_block_process(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n)
+        {
+            const size_t blocks = count / LSP_DSP_BIQUAD_BLOCK_SIZE;
+            const size_t off    = blocks * LSP_DSP_BIQUAD_BLOCK_SIZE;
+
+            for (size_t i=0; i<n; ++i, ++f)
+            {
+                if (blocks > 0)
+                    biquad_block_core(dst, src, blocks, f);
+                if (off < count)
+                    biquad_block_tail(&dst[off], &src[off], count - off, f);
+
+                // Next filters in the chain are applied to the destination buffer
+                src             = dst;
+            }
+        }
+    } /* namespace sse */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_SSE_FILTERS_BLOCK_H_ */
@@ -552,6 +552,7 @@ namespace lsp
                 __ASM_EMIT64("movups    0x10(%[d]), %%xmm6")                        // xmm6     = d0
                 __ASM_EMIT64("movups    0x30(%[d]), %%xmm7")                        // xmm7     = d1
                 __ASM_EMIT("mov         %[X_F], %[f]")
+                __ASM_EMIT("add         $0x280, %[f]")                              // f       += 4, second group is delayed by 4 samples
 
                 // Process first 3 steps
                 __ASM_EMIT(".align 16")
@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 7 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_X86_SSE_FILTERS_MULTICHANNEL_H_
+#define PRIVATE_DSP_ARCH_X86_SSE_FILTERS_MULTICHANNEL_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_SSE_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_SSE_IMPL */
+
+namespace lsp
+{
+    namespace sse
+    {
+        /*
+         * The context of the 4-lane filter:
+         *   +0x00  b0[4]
+         *   +0x10  b1[4]
+         *   +0x20  b2[4]
+         *   +0x30  a1[4]
+         *   +0x40  a2[4]
+         *   +0x50  d0[4]
+         *   +0x60  d1[4]
+         */
+        #define BIQUAD_MC4_CTX_SIZE     28
+
+        #define BIQUAD_MC4_STEP \
+            __ASM_EMIT("movaps          %%xmm0, %%xmm1")                    /* xmm1     = s */ \
+            __ASM_EMIT("movaps          %%xmm0, %%xmm2")                    /* xmm2     = s */ \
+            __ASM_EMIT("mulps           0x00(%[ctx]), %%xmm0")              /* xmm0     = b0*s */ \
+            __ASM_EMIT("mulps           0x10(%[ctx]), %%xmm1")              /* xmm1     = b1*s */ \
+            __ASM_EMIT("mulps           0x20(%[ctx]), %%xmm2")              /* xmm2     = b2*s */ \
+            __ASM_EMIT("addps           %%xmm6, %%xmm0")                    /* xmm0     = b0*s + d0 = s2 */ \
+            __ASM_EMIT("addps           %%xmm7, %%xmm1")                    /* xmm1     = b1*s + d1 */ \
+            __ASM_EMIT("movaps          %%xmm0, %%xmm6")                    /* xmm6     = s2 */ \
+            __ASM_EMIT("movaps          %%xmm0, %%xmm7")                    /* xmm7     = s2 */ \
+            __ASM_EMIT("mulps           0x30(%[ctx]), %%xmm6")              /* xmm6     = a1*s2 */ \
+            __ASM_EMIT("mulps           0x40(%[ctx]), %%xmm7")              /* xmm7     = a2*s2 */ \
+            __ASM_EMIT("addps           %%xmm1, %%xmm6")                    /* xmm6     = b1*s + a1*s2 + d1 = d0' */ \
+            __ASM_EMIT("addps           %%xmm2, %%xmm7")                    /* xmm7     = b2*s + a2*s2 = d1' */
+
+        #define BIQUAD_MC_LOAD_PTR(idx, array) \
+            __ASM_EMIT32("mov           " #idx "*4(%[" array "]), %[ptr]") \
+            __ASM_EMIT64("mov           " #idx "*8(%[" array "]), %[ptr]")
+
+        /*
+         * Process 4 interleaved channels, the distance between frames is stride bytes
+         */
+        static void biquad_mc4_core(float *dst, const float *src, size_t count, size_t stride, float *ctx)
+        {
+            ARCH_X86_ASM
+            (
+                __ASM_EMIT64("test          %[count], %[count]")
+                __ASM_EMIT32("cmpl          $0, %[count]")
+                __ASM_EMIT("jz              2f")
+                __ASM_EMIT("movaps          0x50(%[ctx]), %%xmm6")              /* xmm6     = d0 */
+                __ASM_EMIT("movaps          0x60(%[ctx]), %%xmm7")              /* xmm7     = d1 */
+
+                __ASM_EMIT("1:")
+                __ASM_EMIT("movups          (%[src]), %%xmm0")                  /* xmm0     = s */
+                BIQUAD_MC4_STEP
+                __ASM_EMIT("movups          %%xmm0, (%[dst])")                  /* *dst     = s2 */
+                __ASM_EMIT("add             %[stride], %[src]")
+                __ASM_EMIT("add             %[stride], %[dst]")
+                __ASM_EMIT64("dec           %[count]")
+                __ASM_EMIT32("decl          %[count]")
+                __ASM_EMIT("jnz             1b")
+
+                __ASM_EMIT("movaps          %%xmm6, 0x50(%[ctx])")
+                __ASM_EMIT("movaps          %%xmm7, 0x60(%[ctx])")
+                __ASM_EMIT("2:")
+
+                : [dst] "+r" (dst), [src] "+r" (src),
+                  [count] X86_PGREG (count)
+                : [ctx] "r" (ctx), [stride] "r" (stride)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2",
+                  "%xmm6", "%xmm7"
+            );
+        }
+
+        /*
+         * Process 4 planar channels
+         */
+        static void biquad_mc4_planar_core(float * const *dst, const float * const *src, size_t count, float *ctx)
+        {
+            IF_ARCH_X86(
+                size_t off;
+                float *ptr;
+            );
+
+            ARCH_X86_ASM
+            (
+                __ASM_EMIT64("test          %[count], %[count]")
+                __ASM_EMIT32("cmpl          $0, %[count]")
+                __ASM_EMIT("jz              2f")
+                __ASM_EMIT("xor             %[off], %[off]")
+                __ASM_EMIT("movaps          0x50(%[ctx]), %%xmm6")              /* xmm6     = d0 */
+                __ASM_EMIT("movaps          0x60(%[ctx]), %%xmm7")              /* xmm7     = d1 */
+
+                __ASM_EMIT("1:")
+                /* Gather samples of all channels */
+                BIQUAD_MC_LOAD_PTR(0, "src")
+                __ASM_EMIT("movss           (%[ptr], %[off]), %%xmm0")          /* xmm0     = s0 0 0 0 */
+                BIQUAD_MC_LOAD_PTR(1, "src")
+                __ASM_EMIT("movss           (%[ptr], %[off]), %%xmm1")          /* xmm1     = s1 0 0 0 */
+                BIQUAD_MC_LOAD_PTR(2, "src")
+                __ASM_EMIT("movss           (%[ptr], %[off]), %%xmm2")          /* xmm2     = s2 0 0 0 */
+                BIQUAD_MC_LOAD_PTR(3, "src")
+                __ASM_EMIT("movss           (%[ptr], %[off]), %%xmm3")          /* xmm3     = s3 0 0 0 */
+                __ASM_EMIT("unpcklps        %%xmm1, %%xmm0")                    /* xmm0     = s0 s1 0 0 */
+                __ASM_EMIT("unpcklps        %%xmm3, %%xmm2")                    /* xmm2     = s2 s3 0 0 */
+                __ASM_EMIT("movlhps         %%xmm2, %%xmm0")                    /* xmm0     = s0 s1 s2 s3 */
+                BIQUAD_MC4_STEP
+                /* Scatter samples to all channels */
+                BIQUAD_MC_LOAD_PTR(0, "dst")
+                __ASM_EMIT("movss           %%xmm0, (%[ptr], %[off])")
+                __ASM_EMIT("shufps          $0x39, %%xmm0, %%xmm0")             /* xmm0     = r1 r2 r3 r0 */
+                BIQUAD_MC_LOAD_PTR(1, "dst")
+                __ASM_EMIT("movss           %%xmm0, (%[ptr], %[off])")
+                __ASM_EMIT("shufps          $0x39, %%xmm0, %%xmm0")             /* xmm0     = r2 r3 r0 r1 */
+                BIQUAD_MC_LOAD_PTR(2, "dst")
+                __ASM_EMIT("movss           %%xmm0, (%[ptr], %[off])")
+                __ASM_EMIT("shufps          $0x39, %%xmm0, %%xmm0")             /* xmm0     = r3 r0 r1 r2 */
+                BIQUAD_MC_LOAD_PTR(3, "dst")
+                __ASM_EMIT("movss           %%xmm0, (%[ptr], %[off])")
+                __ASM_EMIT("add             $4, %[off]")
+                __ASM_EMIT64("dec           %[count]")
+                __ASM_EMIT32("decl          %[count]")
+                __ASM_EMIT("jnz             1b")
+
+                __ASM_EMIT("movaps          %%xmm6, 0x50(%[ctx])")
+                __ASM_EMIT("movaps          %%xmm7, 0x60(%[ctx])")
+                __ASM_EMIT("2:")
+
+                : [off] "=&r" (off), [ptr] "=&r" (ptr),
+                  [count] X86_PGREG (count)
+                : [dst] "r" (dst), [src] "r" (src), [ctx] "r" (ctx)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm6", "%xmm7"
+            );
+        }
+
+        #undef BIQUAD_MC4_STEP
+        #undef BIQUAD_MC_LOAD_PTR
+
+        static inline void biquad_mc4_ctx_load(float *ctx, const float *f, const float *d, size_t lanes)
+        {
+            for (size_t i=0; i<5; ++i, f += lanes)
+                for (size_t j=0; j<4; ++j)
+                    *(ctx++)        = f[j];
+            for (size_t j=0; j<4; ++j)
+            {
+                ctx[j]          = d[j];
+                ctx[j + 4]      = d[j + lanes];
+            }
+        }
+
+        static inline void biquad_mc4_ctx_store(float *d, const float *ctx, size_t lanes)
+        {
+            for (size_t j=0; j<4; ++j)
+            {
+                d[j]            = ctx[j + 20];
+                d[j + lanes]    = ctx[j + 24];
+            }
+        }
+
+        static void biquad_process_mc_interleaved(float *dst, const float *src, float *d, size_t count, const float *f, size_t lanes, size_t n)
+        {
+            float ctx[BIQUAD_MC4_CTX_SIZE] __lsp_aligned16;
+
+            for (size_t k=0; k<n; ++k, src = dst)
+            {
+                for (size_t j=0; j<lanes; j += 4)
+                {
+                    biquad_mc4_ctx_load(ctx, &f[j], &d[j], lanes);
+                    biquad_mc4_core(&dst[j], &src[j], count, lanes * sizeof(float), ctx);
+                    biquad_mc4_ctx_store(&d[j], ctx, lanes);
+                }
+
+                f              += lanes * 5;
+                d              += lanes * 2;
+            }
+        }
+
+        static void biquad_process_mc_planar(float * const *dst, const float * const *src, float *d, size_t count, const float *f, size_t lanes, size_t n)
+        {
+            float ctx[BIQUAD_MC4_CTX_SIZE] __lsp_aligned16;
+
+            for (size_t k=0; k<n; ++k, src = dst)
+            {
+                for (size_t j=0; j<lanes; j += 4)
+                {
+                    biquad_mc4_ctx_load(ctx, &f[j], &d[j], lanes);
+                    biquad_mc4_planar_core(&dst[j], &src[j], count, ctx);
+                    biquad_mc4_ctx_store(&d[j], ctx, lanes);
+                }
+
+                f              += lanes * 5;
+                d              += lanes * 2;
+            }
+        }
+
+        void biquad_process_mc4(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n)
+        {
+            biquad_process_mc_interleaved(dst, src, d, count, f->b0, 4, n);
+        }
+
+        void biquad_process_mc8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n)
+        {
+            biquad_process_mc_interleaved(dst, src, d, count, f->b0, 8, n);
+        }
+
+        void biquad_process_mc16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n)
+        {
+            biquad_process_mc_interleaved(dst, src, d, count, f->b0, 16, n);
+        }
+
+        void biquad_process_mc4_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n)
+        {
+            biquad_process_mc_planar(dst, src, d, count, f->b0, 4, n);
+        }
+
+        void biquad_process_mc8_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n)
+        {
+            biquad_process_mc_planar(dst, src, d, count, f->b0, 8, n);
+        }
+
+        void biquad_process_mc16_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n)
+        {
+            biquad_process_mc_planar(dst, src, d, count, f->b0, 16, n);
+        }
+    } /* namespace sse */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_SSE_FILTERS_MULTICHANNEL_H_ */
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_X86_SSE_GOERTZEL_H_
+#define PRIVATE_DSP_ARCH_X86_SSE_GOERTZEL_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_SSE_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_SSE_IMPL */
+
+namespace lsp
+{
+    namespace sse
+    {
+        /*
+         * The bins are processed by groups, the state of the group is kept in registers
+         * while all samples are processed. The sample is broadcasted to all lanes.
+         */
+        void goertzel_bank(float *state, const float *coef, const float *src, size_t bins, size_t count)
+        {
+            float *s1       = state;
+            float *s2       = &state[bins];
+            size_t i        = 0;
+
+            if (count == 0)
+                return;
+
+            // 8 bins
+            for ( ; (i + 8) <= bins; i += 8)
+            {
+                const float *x  = src;
+                size_t n        = count;
+
+                ARCH_X86_ASM
+                (
+                    __ASM_EMIT("movups          0x00(%[s1]), %%xmm0")       // xmm0 = a
+                    __ASM_EMIT("movups          0x10(%[s1]), %%xmm1")
+                    __ASM_EMIT("movups          0x00(%[s2]), %%xmm2")       // xmm2 = b
+                    __ASM_EMIT("movups          0x10(%[s2]), %%xmm3")
+                    __ASM_EMIT("movups          0x00(%[k]), %%xmm4")        // xmm4 = k
+                    __ASM_EMIT("movups          0x10(%[k]), %%xmm5")
+                    __ASM_EMIT("1:")
+                    __ASM_EMIT("movss           (%[x]), %%xmm6")
+                    __ASM_EMIT("shufps          $0x00, %%xmm6, %%xmm6")     // xmm6 = x
+                    __ASM_EMIT("movaps          %%xmm6, %%xmm7")
+                    __ASM_EMIT("subps           %%xmm2, %%xmm6")            // xmm6 = x - b
+                    __ASM_EMIT("subps           %%xmm3, %%xmm7")
+                    __ASM_EMIT("movaps          %%xmm0, %%xmm2")            // xmm2 = b' = a
+                    __ASM_EMIT("movaps          %%xmm1, %%xmm3")
+                    __ASM_EMIT("mulps           %%xmm4, %%xmm0")            // xmm0 = k*a
+                    __ASM_EMIT("mulps           %%xmm5, %%xmm1")
+                    __ASM_EMIT("add             $0x04, %[x]")
+                    __ASM_EMIT("addps           %%xmm6, %%xmm0")            // xmm0 = a' = x - b + k*a
+                    __ASM_EMIT("addps           %%xmm7, %%xmm1")
+                    __ASM_EMIT32("decl          %[n]")
+                    __ASM_EMIT64("dec           %[n]")
+                    __ASM_EMIT("jnz             1b")
+                    __ASM_EMIT("movups          %%xmm0, 0x00(%[s1])")
+                    __ASM_EMIT("movups          %%xmm1, 0x10(%[s1])")
+                    __ASM_EMIT("movups          %%xmm2, 0x00(%[s2])")
+                    __ASM_EMIT("movups          %%xmm3, 0x10(%[s2])")
+                    : [x] "+r" (x), [n] X86_PGREG (n)
+                    : [s1] "r" (&s1[i]), [s2] "r" (&s2[i]), [k] "r" (&coef[i])
+                    : "cc", "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                      "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+                );
+            }
+
+            // 4 bins
+            if ((i + 4) <= bins)
+            {
+                const float *x  = src;
+                size_t n        = count;
+
+                ARCH_X86_ASM
+                (
+                    __ASM_EMIT("movups          0x00(%[s1]), %%xmm0")       // xmm0 = a
+                    __ASM_EMIT("movups          0x00(%[s2]), %%xmm2")       // xmm2 = b
+                    __ASM_EMIT("movups          0x00(%[k]), %%xmm4")        // xmm4 = k
+                    __ASM_EMIT("1:")
+                    __ASM_EMIT("movss           (%[x]), %%xmm6")
+                    __ASM_EMIT("shufps          $0x00, %%xmm6, %%xmm6")     // xmm6 = x
+                    __ASM_EMIT("subps           %%xmm2, %%xmm6")            // xmm6 = x - b
+                    __ASM_EMIT("movaps          %%xmm0, %%xmm2")            // xmm2 = b' = a
+                    __ASM_EMIT("mulps           %%xmm4, %%xmm0")            // xmm0 = k*a
+                    __ASM_EMIT("add             $0x04, %[x]")
+                    __ASM_EMIT("addps           %%xmm6, %%xmm0")            // xmm0 = a' = x - b + k*a
+                    __ASM_EMIT32("decl          %[n]")
+                    __ASM_EMIT64("dec           %[n]")
+                    __ASM_EMIT("jnz             1b")
+                    __ASM_EMIT("movups          %%xmm0, 0x00(%[s1])")
+                    __ASM_EMIT("movups          %%xmm2, 0x00(%[s2])")
+                    : [x] "+r" (x), [n] X86_PGREG (n)
+                    : [s1] "r" (&s1[i]), [s2] "r" (&s2[i]), [k] "r" (&coef[i])
+                    : "cc", "memory",
+                      "%xmm0", "%xmm2", "%xmm4", "%xmm6"
+                );
+                i += 4;
+            }
+
+            // Remaining bins
+            for ( ; i < bins; ++i)
+            {
+                float a         = s1[i];
+                float b         = s2[i];
+                const float k   = coef[i];
+
+                for (size_t j=0; j<count; ++j)
+                {
+                    float c         = src[j] - b + k * a;
+                    b               = a;
+                    a               = c;
+                }
+
+                s1[i]           = a;
+                s2[i]           = b;
+            }
+        }
+
+        /*
+         * The group of 4 bins is kept in registers, the rotation factors are
+         * copied to the aligned buffer and used as memory operands.
+         */
+        void sdft_bank(float *state, const float *coef, const float *src, const float *old, size_t bins, size_t count)
+        {
+            float c[24] __lsp_aligned16;
+            float *s_re         = state;
+            float *s_im         = &state[bins];
+            const float *z_re   = coef;
+            const float *z_im   = &coef[bins];
+            const float *zn_re  = &coef[bins*2];
+            const float *zn_im  = &coef[bins*3];
+            size_t i            = 0;
+
+            if (count == 0)
+                return;
+
+            for ( ; (i + 4) <= bins; i += 4)
+            {
+                for (size_t j=0; j<4; ++j)
+                {
+                    c[j]            = s_re[i + j];
+                    c[j + 4]        = s_im[i + j];
+                    c[j + 8]        = z_re[i + j];
+                    c[j + 12]       = z_im[i + j];
+                    c[j + 16]       = zn_re[i + j];
+                    c[j + 20]       = zn_im[i + j];
+                }
+
+                const float *x  = src;
+                const float *o  = old;
+                size_t n        = count;
+
+                ARCH_X86_ASM
+                (
+                    __ASM_EMIT("movaps          0x00(%[c]), %%xmm0")        // xmm0 = sr
+                    __ASM_EMIT("movaps          0x10(%[c]), %%xmm1")        // xmm1 = si
+                    __ASM_EMIT("1:")
+                    __ASM_EMIT("movss           (%[o]), %%xmm2")
+                    __ASM_EMIT("movss           (%[x]), %%xmm3")
+                    __ASM_EMIT("shufps          $0x00, %%xmm2, %%xmm2")     // xmm2 = o
+                    __ASM_EMIT("shufps          $0x00, %%xmm3, %%xmm3")     // xmm3 = x
+                    __ASM_EMIT("movaps          %%xmm2, %%xmm4")
+                    __ASM_EMIT("mulps           0x40(%[c]), %%xmm2")        // xmm2 = znr*o
+                    __ASM_EMIT("mulps           0x50(%[c]), %%xmm4")        // xmm4 = zni*o
+                    __ASM_EMIT("subps           %%xmm2, %%xmm3")            // xmm3 = x - znr*o
+                    __ASM_EMIT("subps           %%xmm4, %%xmm1")            // xmm1 = ti = si - zni*o
+                    __ASM_EMIT("addps           %%xmm3, %%xmm0")            // xmm0 = tr = sr + x - znr*o
+                    __ASM_EMIT("movaps          %%xmm0, %%xmm2")            // xmm2 = tr
+                    __ASM_EMIT("movaps          %%xmm1, %%xmm3")            // xmm3 = ti
+                    __ASM_EMIT("mulps           0x20(%[c]), %%xmm0")        // xmm0 = zr*tr
+                    __ASM_EMIT("mulps           0x30(%[c]), %%xmm3")        // xmm3 = zi*ti
+                    __ASM_EMIT("mulps           0x30(%[c]), %%xmm2")        // xmm2 = zi*tr
+                    __ASM_EMIT("mulps           0x20(%[c]), %%xmm1")        // xmm1 = zr*ti
+                    __ASM_EMIT("add             $0x04, %[x]")
+                    __ASM_EMIT("add             $0x04, %[o]")
+                    __ASM_EMIT("subps           %%xmm3, %%xmm0")            // xmm0 = sr' = zr*tr - zi*ti
+                    __ASM_EMIT("addps           %%xmm2, %%xmm1")            // xmm1 = si' = zr*ti + zi*tr
+                    __ASM_EMIT32("decl          %[n]")
+                    __ASM_EMIT64("dec           %[n]")
+                    __ASM_EMIT("jnz             1b")
+                    __ASM_EMIT("movaps          %%xmm0, 0x00(%[c])")
+                    __ASM_EMIT("movaps          %%xmm1, 0x10(%[c])")
+                    : [x] "+r" (x), [o] "+r" (o), [n] X86_PGREG (n)
+                    : [c] "r" (c)
+                    : "cc", "memory",
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                      "%xmm4"
+                );
+
+                for (size_t j=0; j<4; ++j)
+                {
+                    s_re[i + j]     = c[j];
+                    s_im[i + j]     = c[j + 4];
+                }
+            }
+
+            // Remaining bins
+            for ( ; i < bins; ++i)
+            {
+                float a_re      = s_re[i];
+                float a_im      = s_im[i];
+
+                for (size_t j=0; j<count; ++j)
+                {
+                    float t_re      = a_re + (src[j] - zn_re[i] * old[j]);
+                    float t_im      = a_im - zn_im[i] * old[j];
+                    a_re            = z_re[i] * t_re - z_im[i] * t_im;
+                    a_im            = z_re[i] * t_im + z_im[i] * t_re;
+                }
+
+                s_re[i]         = a_re;
+                s_im[i]         = a_im;
+            }
+        }
+    } /* namespace sse */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_SSE_GOERTZEL_H_ */
@@ -1251,6 +1251,74 @@ namespace lsp
             );
         }
 
+        void pcomplex_modarg_fast(float *mod, float *arg, const float *src, size_t count)
+        {
+            ARCH_X86_ASM
+            (
+                // x4 blocks
+                __ASM_EMIT32("subl          $4, %[count]")
+                __ASM_EMIT64("sub           $4, %[count]")
+                __ASM_EMIT  ("jb            2f")
+                __ASM_EMIT  ("1:")
+                __ASM_EMIT  ("movups        0x00(%[src]), %%xmm0")      /* xmm0 = r0 i0 r1 i1 */
+                __ASM_EMIT  ("movups        0x10(%[src]), %%xmm2")      /* xmm2 = r2 i2 r3 i3 */
+                __ASM_EMIT  ("movaps        %%xmm0, %%xmm1")
+                __ASM_EMIT  ("shufps        $0x88, %%xmm2, %%xmm0")     /* xmm0 = r0 r1 r2 r3 */
+                __ASM_EMIT  ("shufps        $0xdd, %%xmm2, %%xmm1")     /* xmm1 = i0 i1 i2 i3 */
+                COMPLEX_MOD_FAST_X4
+                COMPLEX_ATAN2_FAST_X4
+                __ASM_EMIT  ("movups        %%xmm6, 0x00(%[mod])")
+                __ASM_EMIT  ("movups        %%xmm0, 0x00(%[arg])")
+                __ASM_EMIT  ("add           $0x20, %[src]")
+                __ASM_EMIT  ("add           $0x10, %[mod]")
+                __ASM_EMIT  ("add           $0x10, %[arg]")
+                __ASM_EMIT32("subl          $4, %[count]")
+                __ASM_EMIT64("sub           $4, %[count]")
+                __ASM_EMIT  ("jae           1b")
+                __ASM_EMIT  ("2:")
+                // Tail: 1x-3x block
+                __ASM_EMIT32("addl          $4, %[count]")
+                __ASM_EMIT64("add           $4, %[count]")
+                __ASM_EMIT  ("jle           10f")
+                __ASM_EMIT32("testl         $1, %[count]")
+                __ASM_EMIT64("test          $1, %[count]")
+                __ASM_EMIT  ("jz            4f")
+                __ASM_EMIT  ("movlps        0x00(%[src]), %%xmm0")      /* xmm0 = r0 i0 */
+                __ASM_EMIT  ("add           $8, %[src]")
+                __ASM_EMIT  ("4:")
+                __ASM_EMIT32("testl         $2, %[count]")
+                __ASM_EMIT64("test          $2, %[count]")
+                __ASM_EMIT  ("jz            6f")
+                __ASM_EMIT  ("movups        0x00(%[src]), %%xmm2")      /* xmm2 = r1 i1 r2 i2 */
+                __ASM_EMIT  ("6:")
+                __ASM_EMIT  ("movaps        %%xmm0, %%xmm1")
+                __ASM_EMIT  ("shufps        $0x88, %%xmm2, %%xmm0")     /* xmm0 = r0 ? r1 r2 */
+                __ASM_EMIT  ("shufps        $0xdd, %%xmm2, %%xmm1")     /* xmm1 = i0 ? i1 i2 */
+                COMPLEX_MOD_FAST_X4
+                COMPLEX_ATAN2_FAST_X4
+                __ASM_EMIT32("testl         $1, %[count]")
+                __ASM_EMIT64("test          $1, %[count]")
+                __ASM_EMIT  ("jz            8f")
+                __ASM_EMIT  ("movss         %%xmm6, 0x00(%[mod])")
+                __ASM_EMIT  ("movss         %%xmm0, 0x00(%[arg])")
+                __ASM_EMIT  ("add           $4, %[mod]")
+                __ASM_EMIT  ("add           $4, %[arg]")
+                __ASM_EMIT  ("8:")
+                __ASM_EMIT32("testl         $2, %[count]")
+                __ASM_EMIT64("test          $2, %[count]")
+                __ASM_EMIT  ("jz            10f")
+                __ASM_EMIT  ("movhps        %%xmm6, 0x00(%[mod])")
+                __ASM_EMIT  ("movhps        %%xmm0, 0x00(%[arg])")
+                __ASM_EMIT  ("10:")
+
+                : [mod] "+r" (mod), [arg] "+r" (arg), [src] "+r" (src),
+                  [count] X86_PGREG (count)
+                : [CC] "o" (complex_atan2_const)
+                : "cc", "memory",
+                  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                  "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+            );
+        }
     } /* namespace sse */
 } /* namespace lsp */
 
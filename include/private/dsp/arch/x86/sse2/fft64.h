@@ -0,0 +1,399 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_DSP_ARCH_X86_SSE2_FFT64_H_
+#define PRIVATE_DSP_ARCH_X86_SSE2_FFT64_H_
+
+#ifndef PRIVATE_DSP_ARCH_X86_SSE2_IMPL
+    #error "This header should not be included directly"
+#endif /* PRIVATE_DSP_ARCH_X86_SSE2_IMPL */
+
+namespace lsp
+{
+    namespace sse2
+    {
+        #define FFT64_SCRAMBLE(name, type) \
+            static void name(type *dst_re, type *dst_im, const type *src_re, const type *src_im, size_t rank) \
+            { \
+                const size_t items  = size_t(1) << rank; \
+                \
+                if ((dst_re != src_re) && (dst_im != src_im)) \
+                { \
+                    for (size_t i=0; i<items; ++i) \
+                    { \
+                        size_t j        = reverse_bits(uint32_t(i), rank); \
+                        dst_re[i]       = src_re[j]; \
+                        dst_im[i]       = src_im[j]; \
+                    } \
+                    return; \
+                } \
+                \
+                /* Copy data first and then perform swaps */ \
+                for (size_t i=0; i<items; ++i) \
+                { \
+                    dst_re[i]       = src_re[i]; \
+                    dst_im[i]       = src_im[i]; \
+                } \
+                \
+                for (size_t i=1; i<(items - 1); ++i) \
+                { \
+                    size_t j        = reverse_bits(uint32_t(i), rank); \
+                    if (i >= j) \
+                        continue; \
+                    \
+                    type re         = dst_re[i]; \
+                    type im         = dst_im[i]; \
+                    dst_re[i]       = dst_re[j]; \
+                    dst_im[i]       = dst_im[j]; \
+                    dst_re[j]       = re; \
+                    dst_im[j]       = im; \
+                } \
+            }
+
+        #define FFT64_START(name, type, op1, op2) \
+            static void name(type *dst_re, type *dst_im, size_t rank) \
+            { \
+                for (size_t i=0, n=size_t(1) << rank; i<n; i += 4) \
+                { \
+                    type s0_re      = dst_re[i+0] + dst_re[i+1]; \
+                    type s1_re      = dst_re[i+0] - dst_re[i+1]; \
+                    type s2_re      = dst_re[i+2] + dst_re[i+3]; \
+                    type s3_re      = dst_re[i+2] - dst_re[i+3]; \
+                    \
+                    type s0_im      = dst_im[i+0] + dst_im[i+1]; \
+                    type s1_im      = dst_im[i+0] - dst_im[i+1]; \
+                    type s2_im      = dst_im[i+2] + dst_im[i+3]; \
+                    type s3_im      = dst_im[i+2] - dst_im[i+3]; \
+                    \
+                    dst_re[i+0]     = s0_re + s2_re; \
+                    dst_re[i+1]     = s1_re op1 s3_im; \
+                    dst_re[i+2]     = s0_re - s2_re; \
+                    dst_re[i+3]     = s1_re op2 s3_im; \
+                    \
+                    dst_im[i+0]     = s0_im + s2_im; \
+                    dst_im[i+1]     = s1_im op2 s3_re; \
+                    dst_im[i+2]     = s0_im - s2_im; \
+                    dst_im[i+3]     = s1_im op1 s3_re; \
+                } \
+            }
+
+        FFT64_SCRAMBLE(fft64_scramble, double)
+        FFT64_SCRAMBLE(fft64_scramble_mp, float)
+        FFT64_START(fft64_start_direct, double, +, -)
+        FFT64_START(fft64_start_reverse, double, -, +)
+        FFT64_START(fft64_start_direct_mp, float, +, -)
+        FFT64_START(fft64_start_reverse_mp, float, -, +)
+
+        #undef FFT64_SCRAMBLE
+        #undef FFT64_START
+
+        /*
+         * Transforms of rank 1 and less, the 'type' is float or double
+         */
+        #define FFT64_SMALL(name, type) \
+            static bool name(type *dst_re, type *dst_im, const type *src_re, const type *src_im, size_t rank, type k) \
+            { \
+                if (rank > 1) \
+                    return false; \
+                \
+                if (rank == 1) \
+                { \
+                    type s1_re      = src_re[1]; \
+                    type s1_im      = src_im[1]; \
+                    dst_re[1]       = (src_re[0] - s1_re) * k; \
+                    dst_im[1]       = (src_im[0] - s1_im) * k; \
+                    dst_re[0]       = (src_re[0] + s1_re) * k; \
+                    dst_im[0]       = (src_im[0] + s1_im) * k; \
+                } \
+                else \
+                { \
+                    dst_re[0]       = src_re[0]; \
+                    dst_im[0]       = src_im[0]; \
+                } \
+                \
+                return true; \
+            }
+
+        FFT64_SMALL(fft64_small, double)
+        FFT64_SMALL(fft64_small_mp, float)
+
+        #undef FFT64_SMALL
+
+        /**
+         * Compute the initial twiddle factors and the rotation step of the butterfly
+         * stage in double precision
+         *
+         * @param tw destination buffer: real parts of initial twiddle factors, imaginary parts
+         *   of initial twiddle factors, the real part of the rotation step twice and the imaginary
+         *   part of the rotation step twice, (lanes*2 + 4) elements
+         * @param n number of butterflies in the block
+         * @param lanes number of twiddle factors processed at once
+         */
+        static inline void fft64_stage_twiddle(double *tw, size_t n, size_t lanes)
+        {
+            const double k  = M_PI / double(n);
+
+            for (size_t i=0; i<lanes; ++i)
+            {
+                tw[i]           = cos(k * i);
+                tw[i + lanes]   = sin(k * i);
+            }
+            tw[lanes*2]     = cos(k * lanes);
+            tw[lanes*2 + 1] = tw[lanes*2];
+            tw[lanes*2 + 2] = sin(k * lanes);
+            tw[lanes*2 + 3] = tw[lanes*2 + 2];
+        }
+
+    /*
+     * Butterflies of one stage in double precision, 2 butterflies per iteration:
+     *   c    = w * b
+     *   c_re = w_re * b_re +- w_im * b_im
+     *   c_im = w_re * b_im -+ w_im * b_re
+     *   a'   = a + c
+     *   b'   = a - c
+     */
+    #define FFT64_BUTTERFLY_F64(op1, op2) \
+        __ASM_EMIT("1:") \
+        __ASM_EMIT("movapd      0x00 + %[tw], %%xmm6")              /* xmm6 = w_re */ \
+        __ASM_EMIT("movapd      0x10 + %[tw], %%xmm7")              /* xmm7 = w_im */ \
+        __ASM_EMIT("mov         %[n], %[k]") \
+        __ASM_EMIT("2:") \
+        __ASM_EMIT("movupd      (%[a_re], %[nb]), %%xmm2")          /* xmm2 = b_re */ \
+        __ASM_EMIT("movupd      (%[a_im], %[nb]), %%xmm3")          /* xmm3 = b_im */ \
+        __ASM_EMIT("movapd      %%xmm2, %%xmm4")                    /* xmm4 = b_re */ \
+        __ASM_EMIT("movapd      %%xmm3, %%xmm5")                    /* xmm5 = b_im */ \
+        __ASM_EMIT("mulpd       %%xmm6, %%xmm2")                    /* xmm2 = w_re * b_re */ \
+        __ASM_EMIT("mulpd       %%xmm6, %%xmm3")                    /* xmm3 = w_re * b_im */ \
+        __ASM_EMIT("mulpd       %%xmm7, %%xmm4")                    /* xmm4 = w_im * b_re */ \
+        __ASM_EMIT("mulpd       %%xmm7, %%xmm5")                    /* xmm5 = w_im * b_im */ \
+        __ASM_EMIT(op1 "        %%xmm5, %%xmm2")                    /* xmm2 = c_re = w_re * b_re +- w_im * b_im */ \
+        __ASM_EMIT(op2 "        %%xmm4, %%xmm3")                    /* xmm3 = c_im = w_re * b_im -+ w_im * b_re */ \
+        __ASM_EMIT("movupd      (%[a_re]), %%xmm0")                 /* xmm0 = a_re */ \
+        __ASM_EMIT("movupd      (%[a_im]), %%xmm1")                 /* xmm1 = a_im */ \
+        __ASM_EMIT("movapd      %%xmm0, %%xmm4")                    /* xmm4 = a_re */ \
+        __ASM_EMIT("movapd      %%xmm1, %%xmm5")                    /* xmm5 = a_im */ \
+        __ASM_EMIT("subpd       %%xmm2, %%xmm0")                    /* xmm0 = a_re - c_re */ \
+        __ASM_EMIT("subpd       %%xmm3, %%xmm1")                    /* xmm1 = a_im - c_im */ \
+        __ASM_EMIT("addpd       %%xmm4, %%xmm2")                    /* xmm2 = a_re + c_re */ \
+        __ASM_EMIT("addpd       %%xmm5, %%xmm3")                    /* xmm3 = a_im + c_im */ \
+        __ASM_EMIT("movupd      %%xmm2, (%[a_re])") \
+        __ASM_EMIT("movupd      %%xmm3, (%[a_im])") \
+        __ASM_EMIT("movupd      %%xmm0, (%[a_re], %[nb])") \
+        __ASM_EMIT("movupd      %%xmm1, (%[a_im], %[nb])") \
+        __ASM_EMIT("add         $0x10, %[a_re]") \
+        __ASM_EMIT("add         $0x10, %[a_im]") \
+        __ASM_EMIT("sub         $2, %[k]") \
+        __ASM_EMIT("jz          3f") \
+        /* Rotate w vector */ \
+        __ASM_EMIT("movapd      %%xmm6, %%xmm2")                    /* xmm2 = w_re */ \
+        __ASM_EMIT("movapd      %%xmm7, %%xmm3")                    /* xmm3 = w_im */ \
+        __ASM_EMIT("mulpd       0x20 + %[tw], %%xmm6")              /* xmm6 = w_re * dw_re */ \
+        __ASM_EMIT("mulpd       0x30 + %[tw], %%xmm3")              /* xmm3 = w_im * dw_im */ \
+        __ASM_EMIT("mulpd       0x30 + %[tw], %%xmm2")              /* xmm2 = w_re * dw_im */ \
+        __ASM_EMIT("mulpd       0x20 + %[tw], %%xmm7")              /* xmm7 = w_im * dw_re */ \
+        __ASM_EMIT("subpd       %%xmm3, %%xmm6")                    /* xmm6 = w_re * dw_re - w_im * dw_im */ \
+        __ASM_EMIT("addpd       %%xmm2, %%xmm7")                    /* xmm7 = w_re * dw_im + w_im * dw_re */ \
+        __ASM_EMIT("jmp         2b") \
+        /* Skip the second half of the block */ \
+        __ASM_EMIT("3:") \
+        __ASM_EMIT("add         %[nb], %[a_re]") \
+        __ASM_EMIT("add         %[nb], %[a_im]") \
+        __ASM_EMIT("cmp         %[a_end], %[a_re]") \
+        __ASM_EMIT("jb          1b")
+
+    /*
+     * Butterflies of one stage in mixed precision, 4 butterflies per iteration.
+     * The twiddle factors are rotated in double precision and converted to float
+     * before the multiplication, the state of rotation is kept at offset 0x60 of tw.
+     */
+    #define FFT64_BUTTERFLY_MP(op1, op2) \
+        __ASM_EMIT("1:") \
+        __ASM_EMIT("movapd      0x00 + %[tw], %%xmm0")              /* xmm0 = w_re[0..1] */ \
+        __ASM_EMIT("movapd      0x10 + %[tw], %%xmm1")              /* xmm1 = w_re[2..3] */ \
+        __ASM_EMIT("movapd      0x20 + %[tw], %%xmm2")              /* xmm2 = w_im[0..1] */ \
+        __ASM_EMIT("movapd      0x30 + %[tw], %%xmm3")              /* xmm3 = w_im[2..3] */ \
+        __ASM_EMIT("movapd      %%xmm0, 0x60 + %[tw]") \
+        __ASM_EMIT("movapd      %%xmm1, 0x70 + %[tw]") \
+        __ASM_EMIT("movapd      %%xmm2, 0x80 + %[tw]") \
+        __ASM_EMIT("movapd      %%xmm3, 0x90 + %[tw]") \
+        __ASM_EMIT("mov         %[n], %[k]") \
+        __ASM_EMIT("2:") \
+        __ASM_EMIT("cvtpd2ps    0x60 + %[tw], %%xmm4")              /* xmm4 = w_re[0..1] */ \
+        __ASM_EMIT("cvtpd2ps    0x70 + %[tw], %%xmm6")              /* xmm6 = w_re[2..3] */ \
+        __ASM_EMIT("cvtpd2ps    0x80 + %[tw], %%xmm5")              /* xmm5 = w_im[0..1] */ \
+        __ASM_EMIT("cvtpd2ps    0x90 + %[tw], %%xmm7")              /* xmm7 = w_im[2..3] */ \
+        __ASM_EMIT("movlhps     %%xmm6, %%xmm4")                    /* xmm4 = w_re */ \
+        __ASM_EMIT("movlhps     %%xmm7, %%xmm5")                    /* xmm5 = w_im */ \
+        __ASM_EMIT("movups      (%[a_re], %[nb]), %%xmm2")          /* xmm2 = b_re */ \
+        __ASM_EMIT("movups      (%[a_im], %[nb]), %%xmm3")          /* xmm3 = b_im */ \
+        __ASM_EMIT("movaps      %%xmm2, %%xmm6")                    /* xmm6 = b_re */ \
+        __ASM_EMIT("movaps      %%xmm3, %%xmm7")                    /* xmm7 = b_im */ \
+        __ASM_EMIT("mulps       %%xmm4, %%xmm2")                    /* xmm2 = w_re * b_re */ \
+        __ASM_EMIT("mulps       %%xmm4, %%xmm3")                    /* xmm3 = w_re * b_im */ \
+        __ASM_EMIT("mulps       %%xmm5, %%xmm6")                    /* xmm6 = w_im * b_re */ \
+        __ASM_EMIT("mulps       %%xmm5, %%xmm7")                    /* xmm7 = w_im * b_im */ \
+        __ASM_EMIT(op1 "        %%xmm7, %%xmm2")                    /* xmm2 = c_re = w_re * b_re +- w_im * b_im */ \
+        __ASM_EMIT(op2 "        %%xmm6, %%xmm3")                    /* xmm3 = c_im = w_re * b_im -+ w_im * b_re */ \
+        __ASM_EMIT("movups      (%[a_re]), %%xmm0")                 /* xmm0 = a_re */ \
+        __ASM_EMIT("movups      (%[a_im]), %%xmm1")                 /* xmm1 = a_im */ \
+        __ASM_EMIT("movaps      %%xmm0, %%xmm4")                    /* xmm4 = a_re */ \
+        __ASM_EMIT("movaps      %%xmm1, %%xmm5")                    /* xmm5 = a_im */ \
+        __ASM_EMIT("subps       %%xmm2, %%xmm0")                    /* xmm0 = a_re - c_re */ \
+        __ASM_EMIT("subps       %%xmm3, %%xmm1")                    /* xmm1 = a_im - c_im */ \
+        __ASM_EMIT("addps       %%xmm4, %%xmm2")                    /* xmm2 = a_re + c_re */ \
+        __ASM_EMIT("addps       %%xmm5, %%xmm3")                    /* xmm3 = a_im + c_im */ \
+        __ASM_EMIT("movups      %%xmm2, (%[a_re])") \
+        __ASM_EMIT("movups      %%xmm3, (%[a_im])") \
+        __ASM_EMIT("movups      %%xmm0, (%[a_re], %[nb])") \
+        __ASM_EMIT("movups      %%xmm1, (%[a_im], %[nb])") \
+        __ASM_EMIT("add         $0x10, %[a_re]") \
+        __ASM_EMIT("add         $0x10, %[a_im]") \
+        __ASM_EMIT("sub         $4, %[k]") \
+        __ASM_EMIT("jz          3f") \
+        /* Rotate w vector in double precision */ \
+        __ASM_EMIT("movapd      0x60 + %[tw], %%xmm0")              /* xmm0 = w_re[0..1] */ \
+        __ASM_EMIT("movapd      0x70 + %[tw], %%xmm1")              /* xmm1 = w_re[2..3] */ \
+        __ASM_EMIT("movapd      0x80 + %[tw], %%xmm2")              /* xmm2 = w_im[0..1] */ \
+        __ASM_EMIT("movapd      0x90 + %[tw], %%xmm3")              /* xmm3 = w_im[2..3] */ \
+        __ASM_EMIT("movapd      %%xmm0, %%xmm4")                    /* xmm4 = w_re[0..1] */ \
+        __ASM_EMIT("movapd      %%xmm1, %%xmm5")                    /* xmm5 = w_re[2..3] */ \
+        __ASM_EMIT("movapd      %%xmm2, %%xmm6")                    /* xmm6 = w_im[0..1] */ \
+        __ASM_EMIT("movapd      %%xmm3, %%xmm7")                    /* xmm7 = w_im[2..3] */ \
+        __ASM_EMIT("mulpd       0x40 + %[tw], %%xmm0")              /* xmm0 = w_re[0..1] * dw_re */ \
+        __ASM_EMIT("mulpd       0x40 + %[tw], %%xmm1")              /* xmm1 = w_re[2..3] * dw_re */ \
+        __ASM_EMIT("mulpd       0x50 + %[tw], %%xmm6")              /* xmm6 = w_im[0..1] * dw_im */ \
+        __ASM_EMIT("mulpd       0x50 + %[tw], %%xmm7")              /* xmm7 = w_im[2..3] * dw_im */ \
+        __ASM_EMIT("mulpd       0x50 + %[tw], %%xmm4")              /* xmm4 = w_re[0..1] * dw_im */ \
+        __ASM_EMIT("mulpd       0x50 + %[tw], %%xmm5")              /* xmm5 = w_re[2..3] * dw_im */ \
+        __ASM_EMIT("mulpd       0x40 + %[tw], %%xmm2")              /* xmm2 = w_im[0..1] * dw_re */ \
+        __ASM_EMIT("mulpd       0x40 + %[tw], %%xmm3")              /* xmm3 = w_im[2..3] * dw_re */ \
+        __ASM_EMIT("subpd       %%xmm6, %%xmm0")                    /* xmm0 = w_re[0..1] * dw_re - w_im[0..1] * dw_im */ \
+        __ASM_EMIT("subpd       %%xmm7, %%xmm1")                    /* xmm1 = w_re[2..3] * dw_re - w_im[2..3] * dw_im */ \
+        __ASM_EMIT("addpd       %%xmm4, %%xmm2")                    /* xmm2 = w_re[0..1] * dw_im + w_im[0..1] * dw_re */ \
+        __ASM_EMIT("addpd       %%xmm5, %%xmm3")                    /* xmm3 = w_re[2..3] * dw_im + w_im[2..3] * dw_re */ \
+        __ASM_EMIT("movapd      %%xmm0, 0x60 + %[tw]") \
+        __ASM_EMIT("movapd      %%xmm1, 0x70 + %[tw]") \
+        __ASM_EMIT("movapd      %%xmm2, 0x80 + %[tw]") \
+        __ASM_EMIT("movapd      %%xmm3, 0x90 + %[tw]") \
+        __ASM_EMIT("jmp         2b") \
+        /* Skip the second half of the block */ \
+        __ASM_EMIT("3:") \
+        __ASM_EMIT("add         %[nb], %[a_re]") \
+        __ASM_EMIT("add         %[nb], %[a_im]") \
+        __ASM_EMIT("cmp         %[a_end], %[a_re]") \
+        __ASM_EMIT("jb          1b")
+
+    #define FFT64_BUTTERFLY_FUNC(name, type, lanes, BODY, op1, op2) \
+        static void name(type *dst_re, type *dst_im, size_t rank) \
+        { \
+            double tw[lanes*2 + 4 + 8] __lsp_aligned16; \
+            const size_t items  = size_t(1) << rank; \
+            const type *a_end   = &dst_re[items]; \
+            \
+            for (size_t n=4; n < items; n <<= 1) \
+            { \
+                fft64_stage_twiddle(tw, n, lanes); \
+                type *a_re          = dst_re; \
+                type *a_im          = dst_im; \
+                size_t nb           = n * sizeof(type); \
+                size_t k; \
+                \
+                ARCH_X86_ASM \
+                ( \
+                    BODY(op1, op2) \
+                    : [a_re] "+r" (a_re), [a_im] "+r" (a_im), \
+                      [k] "=&r" (k) \
+                    : [nb] "r" (nb), [n] X86_GREG (n), \
+                      [a_end] X86_GREG (a_end), \
+                      [tw] "o" (tw) \
+                    : "cc", "memory", \
+                      "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+                      "%xmm4", "%xmm5", "%xmm6", "%xmm7" \
+                ); \
+            } \
+        }
+
+        FFT64_BUTTERFLY_FUNC(fft64_butterfly_direct, double, 2, FFT64_BUTTERFLY_F64, "addpd", "subpd")
+        FFT64_BUTTERFLY_FUNC(fft64_butterfly_reverse, double, 2, FFT64_BUTTERFLY_F64, "subpd", "addpd")
+        FFT64_BUTTERFLY_FUNC(fft64_butterfly_direct_mp, float, 4, FFT64_BUTTERFLY_MP, "addps", "subps")
+        FFT64_BUTTERFLY_FUNC(fft64_butterfly_reverse_mp, float, 4, FFT64_BUTTERFLY_MP, "subps", "addps")
+
+    #undef FFT64_BUTTERFLY_FUNC
+    #undef FFT64_BUTTERFLY_MP
+    #undef FFT64_BUTTERFLY_F64
+
+        void direct_fft_f64(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank)
+        {
+            if (fft64_small(dst_re, dst_im, src_re, src_im, rank, 1.0))
+                return;
+
+            fft64_scramble(dst_re, dst_im, src_re, src_im, rank);
+            fft64_start_direct(dst_re, dst_im, rank);
+            fft64_butterfly_direct(dst_re, dst_im, rank);
+        }
+
+        void reverse_fft_f64(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank)
+        {
+            if (fft64_small(dst_re, dst_im, src_re, src_im, rank, 0.5))
+                return;
+
+            fft64_scramble(dst_re, dst_im, src_re, src_im, rank);
+            fft64_start_reverse(dst_re, dst_im, rank);
+            fft64_butterfly_reverse(dst_re, dst_im, rank);
+
+            // Update amplitudes
+            const size_t items  = size_t(1) << rank;
+            const double k      = 1.0 / double(items);
+            for (size_t i=0; i<items; ++i)
+            {
+                dst_re[i]          *= k;
+                dst_im[i]          *= k;
+            }
+        }
+
+        void direct_fft_mp(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
+        {
+            if (fft64_small_mp(dst_re, dst_im, src_re, src_im, rank, 1.0f))
+                return;
+
+            fft64_scramble_mp(dst_re, dst_im, src_re, src_im, rank);
+            fft64_start_direct_mp(dst_re, dst_im, rank);
+            fft64_butterfly_direct_mp(dst_re, dst_im, rank);
+        }
+
+        void reverse_fft_mp(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
+        {
+            if (fft64_small_mp(dst_re, dst_im, src_re, src_im, rank, 0.5f))
+                return;
+
+            fft64_scramble_mp(dst_re, dst_im, src_re, src_im, rank);
+            fft64_start_reverse_mp(dst_re, dst_im, rank);
+            fft64_butterfly_reverse_mp(dst_re, dst_im, rank);
+            // Update amplitudes
+            const float k       = 1.0f / float(size_t(1) << rank);
+            dsp::mul_k2(dst_re, k, size_t(1) << rank);
+            dsp::mul_k2(dst_im, k, size_t(1) << rank);
+        }
+    } /* namespace sse2 */
+} /* namespace lsp */
+
+#endif /* PRIVATE_DSP_ARCH_X86_SSE2_FFT64_H_ */
@@ -62,12 +62,23 @@ namespace lsp
     #include <private/dsp/arch/generic/search.h>
 
     #include <private/dsp/arch/generic/filters/static.h>
+    #include <private/dsp/arch/generic/filters/block.h>
     #include <private/dsp/arch/generic/filters/dynamic.h>
+    #include <private/dsp/arch/generic/filters/multichannel.h>
     #include <private/dsp/arch/generic/filters/transform.h>
     #include <private/dsp/arch/generic/filters/transfer.h>
 
     #include <private/dsp/arch/generic/fft.h>
+    #include <private/dsp/arch/generic/fft64.h>
+    #include <private/dsp/arch/generic/rfft.h>
     #include <private/dsp/arch/generic/fastconv.h>
+    #include <private/dsp/arch/generic/stft.h>
+    #include <private/dsp/arch/generic/fftn.h>
+    #include <private/dsp/arch/generic/fftplan.h>
+    #include <private/dsp/arch/generic/goertzel.h>
+    #include <private/dsp/arch/generic/cqt.h>
+    #include <private/dsp/arch/generic/pconv.h>
+    #include <private/dsp/arch/generic/hconv.h>
     #include <private/dsp/arch/generic/float.h>
     #include <private/dsp/arch/generic/resampling.h>
     #include <private/dsp/arch/generic/msmatrix.h>
@@ -300,6 +311,16 @@ namespace lsp
             EXPORT1(packed_direct_fft);
             EXPORT1(reverse_fft);
             EXPORT1(packed_reverse_fft);
+            EXPORT1(packed_direct_fft_windowed);
+            EXPORT1(packed_reverse_fft_add);
+            EXPORT1(real_direct_fft);
+            EXPORT1(packed_real_direct_fft);
+            EXPORT1(real_reverse_fft);
+            EXPORT1(packed_real_reverse_fft);
+            EXPORT1(direct_fft_f64);
+            EXPORT1(reverse_fft_f64);
+            EXPORT1(direct_fft_mp);
+            EXPORT1(reverse_fft_mp);
             EXPORT1(normalize_fft3);
             EXPORT1(normalize_fft2);
             EXPORT1(center_fft);
@@ -310,6 +331,65 @@ namespace lsp
             EXPORT1(fastconv_parse_apply);
             EXPORT1(fastconv_restore);
             EXPORT1(fastconv_apply);
+            EXPORT1(fastconv_mac_n);
+
+            EXPORT1(stft_window);
+            EXPORT1(stft_buffer_size);
+            EXPORT1(stft_init);
+            EXPORT1(stft_reset);
+            EXPORT1(stft_process);
+
+            EXPORT1(fftn_buffer_size);
+            EXPORT1(fftn_init);
+            EXPORT1(fftn_direct);
+            EXPORT1(fftn_reverse);
+
+            EXPORT1(fft_plan_buffer_size);
+            EXPORT1(fft_plan_init);
+            EXPORT1(fft_plan_footprint);
+            EXPORT1(fft_plan_direct);
+            EXPORT1(fft_plan_reverse);
+            EXPORT1(fft_plan_packed_direct);
+            EXPORT1(fft_plan_packed_reverse);
+
+            EXPORT1(goertzel_bank);
+            EXPORT1(sdft_bank);
+            EXPORT1(goertzel_buffer_size);
+            EXPORT1(goertzel_init);
+            EXPORT1(goertzel_reset);
+            EXPORT1(goertzel_process);
+            EXPORT1(goertzel_spectrum);
+            EXPORT1(sdft_buffer_size);
+            EXPORT1(sdft_init);
+            EXPORT1(sdft_reset);
+            EXPORT1(sdft_process);
+            EXPORT1(sdft_spectrum);
+            EXPORT1(cqt_kernel_apply);
+            EXPORT1(cqt_kernel_buffer_size);
+            EXPORT1(cqt_kernel_init);
+            EXPORT1(cqt_kernel_match);
+            EXPORT1(cqt_process);
+
+            EXPORT1(pconv_buffer_size);
+            EXPORT1(pconv_init);
+            EXPORT1(pconv_reset);
+            EXPORT1(pconv_process);
+            EXPORT1(pconv_swap_buffer_size);
+            EXPORT1(pconv_swap_init);
+            EXPORT1(pconv_swap_prepare);
+            EXPORT1(pconv_pool_size);
+            EXPORT1(pconv_pool_start);
+            EXPORT1(pconv_pool_stop);
+            EXPORT1(pconv_mt_buffer_size);
+            EXPORT1(pconv_mt_init);
+            EXPORT1(pconv_mt_destroy);
+
+            EXPORT1(hconv_calibrate);
+            EXPORT1(hconv_rank);
+            EXPORT1(hconv_buffer_size);
+            EXPORT1(hconv_init);
+            EXPORT1(hconv_reset);
+            EXPORT1(hconv_process);
 
             EXPORT1(complex_mul2);
             EXPORT1(complex_mul3);
@@ -319,9 +399,11 @@ namespace lsp
             EXPORT1(complex_rcp1);
             EXPORT1(complex_rcp2);
             EXPORT1(complex_cvt2modarg);
+            EXPORT1(complex_cvt2modarg_fast);
             EXPORT1(complex_cvt2reim);
             EXPORT1(complex_mod);
             EXPORT1(complex_arg);
+            EXPORT1(complex_arg_fast);
 
             EXPORT1(pcomplex_mul2);
             EXPORT1(pcomplex_mul3);
@@ -336,6 +418,7 @@ namespace lsp
             EXPORT1(pcomplex_mod);
             EXPORT1(pcomplex_arg);
             EXPORT1(pcomplex_modarg);
+            EXPORT1(pcomplex_modarg_fast);
 
             EXPORT1(pcomplex_c2r_add2);
             EXPORT1(pcomplex_c2r_sub2);
@@ -362,11 +445,31 @@ namespace lsp
             EXPORT1(biquad_process_x2);
             EXPORT1(biquad_process_x4);
             EXPORT1(biquad_process_x8);
+            EXPORT1(biquad_process_x16);
 
             EXPORT1(dyn_biquad_process_x1);
             EXPORT1(dyn_biquad_process_x2);
             EXPORT1(dyn_biquad_process_x4);
             EXPORT1(dyn_biquad_process_x8);
+            EXPORT1(dyn_biquad_process_x16);
+
+            EXPORT1(ramp_biquad_process_x1);
+            EXPORT1(ramp_biquad_process_x2);
+            EXPORT1(ramp_biquad_process_x4);
+            EXPORT1(ramp_biquad_process_x8);
+            EXPORT1(ramp_biquad_process_x16);
+
+            EXPORT1(dyn_bilinear_biquad_process_x8);
+
+            EXPORT1(biquad_block_init);
+            EXPORT1(biquad_block_process);
+
+            EXPORT1(biquad_process_mc4);
+            EXPORT1(biquad_process_mc8);
+            EXPORT1(biquad_process_mc16);
+            EXPORT1(biquad_process_mc4_planar);
+            EXPORT1(biquad_process_mc8_planar);
+            EXPORT1(biquad_process_mc16_planar);
 
             EXPORT1(filter_transfer_calc_ri);
             EXPORT1(filter_transfer_apply_ri);
@@ -598,6 +701,7 @@ namespace lsp
             EXPORT1(unit_vector_p1pv);
 
             EXPORT1(convolve);
+            EXPORT1(convolve_multi);
 
             EXPORT1(base64_enc);
             EXPORT1(base64_dec);
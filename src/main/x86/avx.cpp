@@ -58,11 +58,19 @@
         #include <private/dsp/arch/x86/avx/search/minmax.h>
 
         #include <private/dsp/arch/x86/avx/fft.h>
+        #include <private/dsp/arch/x86/avx/fft64.h>
         #include <private/dsp/arch/x86/avx/pfft.h>
+        #include <private/dsp/arch/x86/avx/fftplan.h>
+        #include <private/dsp/arch/x86/avx/rfft.h>
         #include <private/dsp/arch/x86/avx/fastconv.h>
+        #include <private/dsp/arch/x86/avx/fftn.h>
+        #include <private/dsp/arch/x86/avx/goertzel.h>
+        #include <private/dsp/arch/x86/avx/cqt.h>
 
         #include <private/dsp/arch/x86/avx/filters/static.h>
+        #include <private/dsp/arch/x86/avx/filters/block.h>
         #include <private/dsp/arch/x86/avx/filters/dynamic.h>
+        #include <private/dsp/arch/x86/avx/filters/multichannel.h>
         #include <private/dsp/arch/x86/avx/filters/transform.h>
         #include <private/dsp/arch/x86/avx/filters/transfer.h>
 
@@ -276,6 +284,8 @@
                 CEXPORT1(favx, complex_mod);
                 CEXPORT1(favx, complex_rcp1);
                 CEXPORT1(favx, complex_rcp2);
+                CEXPORT1(favx, complex_arg_fast);
+                CEXPORT1(favx, complex_cvt2modarg_fast);
 
                 CEXPORT1(favx, pcomplex_mul2);
                 CEXPORT1(favx, pcomplex_mul3);
@@ -285,6 +295,7 @@
                 CEXPORT1(favx, pcomplex_mod);
                 CEXPORT1(favx, pcomplex_rcp1);
                 CEXPORT1(favx, pcomplex_rcp2);
+                CEXPORT1(favx, pcomplex_modarg_fast);
 
                 CEXPORT1(favx, pcomplex_r2c);
                 CEXPORT1(favx, pcomplex_r2c_add2);
@@ -298,11 +309,22 @@
                 CEXPORT1(favx, biquad_process_x2);
                 CEXPORT1(favx, biquad_process_x4);
                 EXPORT2_X64(biquad_process_x8, x64_biquad_process_x8);
+                CEXPORT1(favx, biquad_process_x16);
 
                 CEXPORT1(favx, dyn_biquad_process_x1);
                 CEXPORT1(favx, dyn_biquad_process_x2);
                 CEXPORT1(favx, dyn_biquad_process_x4);
                 EXPORT2_X64(dyn_biquad_process_x8, x64_dyn_biquad_process_x8);
+                CEXPORT1(favx, dyn_biquad_process_x16);
+
+                EXPORT2_X64(dyn_bilinear_biquad_process_x8, x64_dyn_bilinear_biquad_process_x8);
+
+                CEXPORT1(favx, biquad_block_process);
+
+                CEXPORT1(favx, biquad_process_mc8);
+                CEXPORT1(favx, biquad_process_mc16);
+                CEXPORT1(favx, biquad_process_mc8_planar);
+                CEXPORT1(favx, biquad_process_mc16_planar);
 
                 CEXPORT1(favx, bilinear_transform_x1);
                 CEXPORT1(favx, bilinear_transform_x2);
@@ -348,11 +370,32 @@
 
                 CEXPORT1(favx, packed_direct_fft);
                 CEXPORT1(favx, packed_reverse_fft);
+                CEXPORT1(favx, packed_direct_fft_windowed);
+                CEXPORT1(favx, packed_reverse_fft_add);
+                CEXPORT1(favx, real_direct_fft);
+                CEXPORT1(favx, packed_real_direct_fft);
+                CEXPORT1(favx, real_reverse_fft);
+                CEXPORT1(favx, packed_real_reverse_fft);
+                CEXPORT1(favx, direct_fft_f64);
+                CEXPORT1(favx, reverse_fft_f64);
+                CEXPORT1(favx, direct_fft_mp);
+                CEXPORT1(favx, reverse_fft_mp);
+                CEXPORT1(favx, fft_plan_direct);
+                CEXPORT1(favx, fft_plan_reverse);
+                CEXPORT1(favx, fft_plan_packed_direct);
+                CEXPORT1(favx, fft_plan_packed_reverse);
+                CEXPORT1(favx, goertzel_bank);
+                CEXPORT1(favx, sdft_bank);
+                CEXPORT1(favx, cqt_kernel_apply);
 
                 CEXPORT1(favx, fastconv_parse);
                 CEXPORT1(favx, fastconv_restore);
                 CEXPORT1(favx, fastconv_apply);
                 CEXPORT1(favx, fastconv_parse_apply);
+                CEXPORT1(favx, fastconv_mac_n);
+
+                CEXPORT2_X64(favx, fftn_direct, x64_fftn_direct);
+                CEXPORT2_X64(favx, fftn_reverse, x64_fftn_reverse);
 
                 CEXPORT1(favx, filter_transfer_calc_ri);
                 CEXPORT1(favx, filter_transfer_apply_ri);
@@ -391,6 +434,7 @@
                 CEXPORT1(favx, downsample_8x);
 
                 CEXPORT1(favx, convolve);
+                CEXPORT1(favx, convolve_multi);
 
                 CEXPORT1(favx, lin_inter_set);
                 CEXPORT1(favx, lin_inter_mul2);
@@ -455,12 +499,15 @@
                     CEXPORT2(favx, complex_mod, complex_mod_fma3);
                     CEXPORT2(favx, complex_rcp1, complex_rcp1_fma3);
                     CEXPORT2(favx, complex_rcp2, complex_rcp2_fma3);
+                    CEXPORT2(favx, complex_arg_fast, complex_arg_fast_fma3);
+                    CEXPORT2(favx, complex_cvt2modarg_fast, complex_cvt2modarg_fast_fma3);
 
                     CEXPORT2(favx, pcomplex_mul2, pcomplex_mul2_fma3);
                     CEXPORT2(favx, pcomplex_mul3, pcomplex_mul3_fma3);
                     CEXPORT2(favx, pcomplex_div2, pcomplex_div2_fma3);
                     CEXPORT2(favx, pcomplex_rdiv2, pcomplex_rdiv2_fma3);
                     CEXPORT2(favx, pcomplex_div3, pcomplex_div3_fma3);
+                    CEXPORT2(favx, pcomplex_modarg_fast, pcomplex_modarg_fast_fma3);
 
                     if (!below_zen3)
                     {
@@ -471,11 +518,28 @@
                     CEXPORT2(favx, reverse_fft, reverse_fft_fma3);
                     CEXPORT2(favx, packed_direct_fft, packed_direct_fft_fma3);
                     CEXPORT2(favx, packed_reverse_fft, packed_reverse_fft_fma3);
+                    CEXPORT2(favx, packed_direct_fft_windowed, packed_direct_fft_windowed_fma3);
+                    CEXPORT2(favx, packed_reverse_fft_add, packed_reverse_fft_add_fma3);
+                    CEXPORT2(favx, real_direct_fft, real_direct_fft_fma3);
+                    CEXPORT2(favx, packed_real_direct_fft, packed_real_direct_fft_fma3);
+                    CEXPORT2(favx, real_reverse_fft, real_reverse_fft_fma3);
+                    CEXPORT2(favx, packed_real_reverse_fft, packed_real_reverse_fft_fma3);
+                    CEXPORT2(favx, direct_fft_f64, direct_fft_f64_fma3);
+                    CEXPORT2(favx, reverse_fft_f64, reverse_fft_f64_fma3);
+                    CEXPORT2(favx, direct_fft_mp, direct_fft_mp_fma3);
+                    CEXPORT2(favx, reverse_fft_mp, reverse_fft_mp_fma3);
+                    CEXPORT2(favx, fft_plan_direct, fft_plan_direct_fma3);
+                    CEXPORT2(favx, fft_plan_reverse, fft_plan_reverse_fma3);
+                    CEXPORT2(favx, fft_plan_packed_direct, fft_plan_packed_direct_fma3);
+                    CEXPORT2(favx, fft_plan_packed_reverse, fft_plan_packed_reverse_fma3);
 
                     CEXPORT2(favx, fastconv_parse, fastconv_parse_fma3);
                     CEXPORT2(favx, fastconv_restore, fastconv_restore_fma3);
                     CEXPORT2(favx, fastconv_apply, fastconv_apply_fma3);
                     CEXPORT2(favx, fastconv_parse_apply, fastconv_parse_apply_fma3);
+                    CEXPORT2(favx, fastconv_mac_n, fastconv_mac_n_fma3);
+
+                    CEXPORT2(favx, cqt_kernel_apply, cqt_kernel_apply_fma3);
 
                     CEXPORT2(favx, filter_transfer_calc_ri, filter_transfer_calc_ri_fma3);
                     CEXPORT2(favx, filter_transfer_apply_ri, filter_transfer_apply_ri_fma3);
@@ -483,6 +547,7 @@
                     CEXPORT2(favx, filter_transfer_apply_pc, filter_transfer_apply_pc_fma3);
 
                     CEXPORT2(favx, convolve, convolve_fma3);
+                    CEXPORT2(favx, convolve_multi, convolve_multi_fma3);
 
                     CEXPORT2(favx, axis_apply_lin1, axis_apply_lin1_fma3);
 
@@ -490,11 +555,22 @@
                     CEXPORT2(favx, biquad_process_x2, biquad_process_x2_fma3);
                     CEXPORT2(favx, biquad_process_x4, biquad_process_x4_fma3);
                     CEXPORT2(ffma, biquad_process_x8, biquad_process_x8_fma3);
+                    CEXPORT2(ffma, biquad_process_x16, biquad_process_x16_fma3);
 
                     CEXPORT2(ffma, dyn_biquad_process_x1, dyn_biquad_process_x1_fma3);
                     CEXPORT2(favx, dyn_biquad_process_x2, dyn_biquad_process_x2_fma3);
                     CEXPORT2(favx, dyn_biquad_process_x4, dyn_biquad_process_x4_fma3);
                     CEXPORT2(ffma, dyn_biquad_process_x8, dyn_biquad_process_x8_fma3);
+                    CEXPORT2(ffma, dyn_biquad_process_x16, dyn_biquad_process_x16_fma3);
+
+                    CEXPORT2_X64(ffma, dyn_bilinear_biquad_process_x8, x64_dyn_bilinear_biquad_process_x8_fma3);
+
+                    CEXPORT2(favx, biquad_block_process, biquad_block_process_fma3);
+
+                    CEXPORT2(favx, biquad_process_mc8, biquad_process_mc8_fma3);
+                    CEXPORT2(favx, biquad_process_mc16, biquad_process_mc16_fma3);
+                    CEXPORT2(favx, biquad_process_mc8_planar, biquad_process_mc8_planar_fma3);
+                    CEXPORT2(favx, biquad_process_mc16_planar, biquad_process_mc16_planar_fma3);
                 }
             }
 
@@ -42,8 +42,15 @@
 
     #define PRIVATE_DSP_ARCH_X86_AVX512_IMPL
         #include <private/dsp/arch/x86/avx512/complex.h>
+        #include <private/dsp/arch/x86/avx512/convolution.h>
         #include <private/dsp/arch/x86/avx512/copy.h>
         #include <private/dsp/arch/x86/avx512/dynamics.h>
+        #include <private/dsp/arch/x86/avx512/fastconv.h>
+        #include <private/dsp/arch/x86/avx512/fft.h>
+        #include <private/dsp/arch/x86/avx512/fftplan.h>
+        #include <private/dsp/arch/x86/avx512/filters/dynamic.h>
+        #include <private/dsp/arch/x86/avx512/filters/multichannel.h>
+        #include <private/dsp/arch/x86/avx512/filters/static.h>
         #include <private/dsp/arch/x86/avx512/float.h>
         #include <private/dsp/arch/x86/avx512/graphics/axis.h>
         #include <private/dsp/arch/x86/avx512/msmatrix.h>
@@ -242,10 +249,13 @@
                 CEXPORT1(vl, complex_div3);
                 CEXPORT1(vl, complex_rcp1);
                 CEXPORT1(vl, complex_rcp2);
+                CEXPORT1(vl, complex_arg_fast);
+                CEXPORT1(vl, complex_cvt2modarg_fast);
 
                 CEXPORT1(vl, pcomplex_mul2);
                 CEXPORT1(vl, pcomplex_mul3);
                 CEXPORT1(vl, pcomplex_mod);
+                CEXPORT1(vl, pcomplex_modarg_fast);
                 CEXPORT1(vl, pcomplex_div2);
                 CEXPORT1(vl, pcomplex_rdiv2);
                 CEXPORT1(vl, pcomplex_div3);
@@ -257,6 +267,24 @@
                 CEXPORT1(vl, pcomplex_r2c_div2);
                 CEXPORT1(vl, pcomplex_c2r);
 
+                CEXPORT1(vl, direct_fft);
+                CEXPORT1(vl, reverse_fft);
+                CEXPORT1(vl, fft_plan_direct);
+                CEXPORT1(vl, fft_plan_reverse);
+
+                CEXPORT1(vl, biquad_process_x16);
+                CEXPORT1(vl, dyn_biquad_process_x16);
+                CEXPORT1(vl, biquad_process_mc16);
+
+                CEXPORT1(vl, fastconv_parse);
+                CEXPORT1(vl, fastconv_parse_apply);
+                CEXPORT1(vl, fastconv_restore);
+                CEXPORT1(vl, fastconv_apply);
+                CEXPORT1(vl, fastconv_mac_n);
+
+                CEXPORT1(vl, convolve);
+                CEXPORT2_X64(vl, convolve, x64_convolve);
+
                 CEXPORT1(vl, lr_to_ms);
                 CEXPORT1(vl, lr_to_mid);
                 CEXPORT1(vl, lr_to_side);
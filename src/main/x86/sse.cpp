@@ -57,7 +57,10 @@
         #include <private/dsp/arch/x86/sse/smath.h>
 
         #include <private/dsp/arch/x86/sse/fft.h>
+        #include <private/dsp/arch/x86/sse/fftplan.h>
         #include <private/dsp/arch/x86/sse/fastconv.h>
+        #include <private/dsp/arch/x86/sse/cqt.h>
+        #include <private/dsp/arch/x86/sse/goertzel.h>
         #include <private/dsp/arch/x86/sse/graphics.h>
         #include <private/dsp/arch/x86/sse/msmatrix.h>
         #include <private/dsp/arch/x86/sse/resampling.h>
@@ -68,7 +71,9 @@
         #include <private/dsp/arch/x86/sse/convolution.h>
 
         #include <private/dsp/arch/x86/sse/filters/static.h>
+        #include <private/dsp/arch/x86/sse/filters/block.h>
         #include <private/dsp/arch/x86/sse/filters/dynamic.h>
+        #include <private/dsp/arch/x86/sse/filters/multichannel.h>
         #include <private/dsp/arch/x86/sse/filters/transform.h>
         #include <private/dsp/arch/x86/sse/filters/transfer.h>
 
@@ -286,6 +291,12 @@
                 EXPORT1(normalize_fft3);
                 EXPORT1(packed_direct_fft);
                 EXPORT1(packed_reverse_fft);
+                EXPORT1(packed_direct_fft_windowed);
+                EXPORT1(packed_reverse_fft_add);
+                EXPORT1(fft_plan_direct);
+                EXPORT1(fft_plan_reverse);
+                EXPORT1(fft_plan_packed_direct);
+                EXPORT1(fft_plan_packed_reverse);
         //            EXPORT1(center_fft);
         //            EXPORT1(combine_fft);
 
@@ -294,6 +305,10 @@
                 EXPORT1(fastconv_restore);
                 EXPORT1(fastconv_apply);
 
+                EXPORT1(goertzel_bank);
+                EXPORT1(sdft_bank);
+                EXPORT1(cqt_kernel_apply);
+
                 EXPORT1(complex_mul2);
                 EXPORT1(complex_mul3);
                 EXPORT1(complex_div2);
@@ -302,6 +317,8 @@
                 EXPORT1(complex_rcp1);
                 EXPORT1(complex_rcp2);
                 EXPORT1(complex_mod);
+                EXPORT1(complex_arg_fast);
+                EXPORT1(complex_cvt2modarg_fast);
 
                 EXPORT1(pcomplex_mul2);
                 EXPORT1(pcomplex_mul3);
@@ -313,6 +330,7 @@
                 EXPORT1(pcomplex_r2c);
                 EXPORT1(pcomplex_c2r);
                 EXPORT1(pcomplex_mod);
+                EXPORT1(pcomplex_modarg_fast);
         //            EXPORT1(complex_cvt2modarg);
         //            EXPORT1(complex_cvt2reim);
 
@@ -340,6 +358,15 @@
                 EXPORT1(dyn_biquad_process_x4);
                 EXPORT1(dyn_biquad_process_x8);
 
+                EXPORT1(biquad_block_process);
+
+                EXPORT1(biquad_process_mc4);
+                EXPORT1(biquad_process_mc8);
+                EXPORT1(biquad_process_mc16);
+                EXPORT1(biquad_process_mc4_planar);
+                EXPORT1(biquad_process_mc8_planar);
+                EXPORT1(biquad_process_mc16_planar);
+
                 EXPORT1(filter_transfer_calc_ri);
                 EXPORT1(filter_transfer_apply_ri);
                 EXPORT1(filter_transfer_calc_pc);
@@ -492,6 +519,7 @@
                 EXPORT1(cull_triangle_raw);
 
                 EXPORT1(convolve);
+                EXPORT1(convolve_multi);
 
                 EXPORT1(lin_inter_set);
                 EXPORT1(lin_inter_mul2);
@@ -44,6 +44,8 @@
     #define PRIVATE_DSP_ARCH_X86_SSE2_IMPL
         #include <private/dsp/arch/x86/sse2/dynamics.h>
 
+        #include <private/dsp/arch/x86/sse2/fft64.h>
+
         #include <private/dsp/arch/x86/sse2/float.h>
 
         #include <private/dsp/arch/x86/sse2/search/iminmax.h>
@@ -123,6 +125,11 @@
                 EXPORT1(powvx1);
                 EXPORT1(powvx2);
 
+                EXPORT1(direct_fft_f64);
+                EXPORT1(reverse_fft_f64);
+                EXPORT1(direct_fft_mp);
+                EXPORT1(reverse_fft_mp);
+
                 EXPORT1(min_index);
                 EXPORT1(max_index);
                 EXPORT1(minmax_index);
@@ -33,23 +33,41 @@ namespace lsp
     namespace generic
     {
         void complex_mod(float *dst_mod, const float *src_re, const float *src_im, size_t count);
+        void complex_cvt2modarg(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count);
+        void complex_arg(float *dst, const float *re, const float *im, size_t count);
+        void pcomplex_modarg(float *mod, float *arg, const float *src, size_t count);
+        void complex_cvt2modarg_fast(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count);
+        void complex_arg_fast(float *dst, const float *re, const float *im, size_t count);
+        void pcomplex_modarg_fast(float *mod, float *arg, const float *src, size_t count);
     }
 
     IF_ARCH_X86(
         namespace sse
         {
             void complex_mod(float *dst_mod, const float *src_re, const float *src_im, size_t count);
+            void complex_cvt2modarg_fast(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count);
+            void complex_arg_fast(float *dst, const float *re, const float *im, size_t count);
+            void pcomplex_modarg_fast(float *mod, float *arg, const float *src, size_t count);
         }
 
         namespace avx
         {
             void complex_mod(float *dst_mod, const float *src_re, const float *src_im, size_t count);
             void complex_mod_fma3(float *dst_mod, const float *src_re, const float *src_im, size_t count);
+            void complex_cvt2modarg_fast(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count);
+            void complex_cvt2modarg_fast_fma3(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count);
+            void complex_arg_fast(float *dst, const float *re, const float *im, size_t count);
+            void complex_arg_fast_fma3(float *dst, const float *re, const float *im, size_t count);
+            void pcomplex_modarg_fast(float *mod, float *arg, const float *src, size_t count);
+            void pcomplex_modarg_fast_fma3(float *mod, float *arg, const float *src, size_t count);
         }
 
         namespace avx512
         {
             void complex_mod(float *dst_mod, const float *src_re, const float *src_im, size_t count);
+            void complex_cvt2modarg_fast(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count);
+            void complex_arg_fast(float *dst, const float *re, const float *im, size_t count);
+            void pcomplex_modarg_fast(float *mod, float *arg, const float *src, size_t count);
         }
     )
 
@@ -68,6 +86,8 @@ namespace lsp
     )
 
     typedef void (* complex_mod_t)(float *dst_mod, const float *src_re, const float *src_im, size_t count);
+    typedef void (* complex_modarg_t)(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count);
+    typedef void (* pcomplex_modarg_t)(float *mod, float *arg, const float *src, size_t count);
 }
 
 //-----------------------------------------------------------------------------
@@ -88,20 +108,48 @@ PTEST_BEGIN("dsp.complex", mod, 5, 1000)
         );
     }
 
+    void call(const char *label, float *dst, const float *src, size_t count, complex_modarg_t modarg)
+    {
+        if (!PTEST_SUPPORTED(modarg))
+            return;
+
+        char buf[80];
+        sprintf(buf, "%s x %d", label, int(count));
+        printf("Testing %s numbers...\n", buf);
+
+        PTEST_LOOP(buf,
+            modarg(dst, &dst[count], src, &src[count], count);
+        );
+    }
+
+    void call(const char *label, float *dst, const float *src, size_t count, pcomplex_modarg_t modarg)
+    {
+        if (!PTEST_SUPPORTED(modarg))
+            return;
+
+        char buf[80];
+        sprintf(buf, "%s x %d", label, int(count));
+        printf("Testing %s numbers...\n", buf);
+
+        PTEST_LOOP(buf,
+            modarg(dst, &dst[count], src, count);
+        );
+    }
+
     PTEST_MAIN
     {
         size_t buf_size = 1 << MAX_RANK;
         uint8_t *data   = NULL;
-        float *out      = alloc_aligned<float>(data, buf_size * 6, 64);
-        float *in       = &out[buf_size];
+        float *out      = alloc_aligned<float>(data, buf_size * 8, 64);
+        float *in       = &out[buf_size*2];
         float *backup   = &in[buf_size*2];
 
-        for (size_t i=0; i < buf_size*3; ++i)
+        for (size_t i=0; i < buf_size*4; ++i)
             out[i]          = randf(-1.0f, 1.0f);
-        dsp::copy(backup, out, buf_size * 3);
+        dsp::copy(backup, out, buf_size * 4);
 
         #define CALL(func) \
-            dsp::copy(out, backup, buf_size * 3); \
+            dsp::copy(out, backup, buf_size * 4); \
             call(#func, out, in, count, func)
 
         for (size_t i=MIN_RANK; i <= MAX_RANK; ++i)
@@ -115,8 +163,31 @@ PTEST_BEGIN("dsp.complex", mod, 5, 1000)
             IF_ARCH_X86(CALL(avx512::complex_mod));
             IF_ARCH_ARM(CALL(neon_d32::complex_mod));
             IF_ARCH_AARCH64(CALL(asimd::complex_mod));
+            PTEST_SEPARATOR;
 
+            CALL(generic::complex_cvt2modarg);
+            CALL(generic::complex_cvt2modarg_fast);
+            IF_ARCH_X86(CALL(sse::complex_cvt2modarg_fast));
+            IF_ARCH_X86(CALL(avx::complex_cvt2modarg_fast));
+            IF_ARCH_X86(CALL(avx::complex_cvt2modarg_fast_fma3));
+            IF_ARCH_X86(CALL(avx512::complex_cvt2modarg_fast));
             PTEST_SEPARATOR;
+
+            CALL(generic::complex_arg);
+            CALL(generic::complex_arg_fast);
+            IF_ARCH_X86(CALL(sse::complex_arg_fast));
+            IF_ARCH_X86(CALL(avx::complex_arg_fast));
+            IF_ARCH_X86(CALL(avx::complex_arg_fast_fma3));
+            IF_ARCH_X86(CALL(avx512::complex_arg_fast));
+            PTEST_SEPARATOR;
+
+            CALL(generic::pcomplex_modarg);
+            CALL(generic::pcomplex_modarg_fast);
+            IF_ARCH_X86(CALL(sse::pcomplex_modarg_fast));
+            IF_ARCH_X86(CALL(avx::pcomplex_modarg_fast));
+            IF_ARCH_X86(CALL(avx::pcomplex_modarg_fast_fma3));
+            IF_ARCH_X86(CALL(avx512::pcomplex_modarg_fast));
+            PTEST_SEPARATOR2;
         }
 
         free_aligned(data);
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 1 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define MIN_RANK        10
+#define MAX_RANK        16
+#define BINS_PER_OCTAVE 24
+#define SAMPLE_RATE     48000
+
+namespace lsp
+{
+    namespace generic
+    {
+        void cqt_kernel_apply(float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void cqt_kernel_apply(float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins);
+        }
+
+        namespace avx
+        {
+            void cqt_kernel_apply(float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins);
+            void cqt_kernel_apply_fma3(float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins);
+        }
+    )
+
+    typedef void (* cqt_kernel_apply_t)(float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins);
+}
+
+//-----------------------------------------------------------------------------
+// Performance test for the constant-Q transform
+PTEST_BEGIN("dsp.fft", cqt, 5, 1000)
+
+    void call(const char *label, float *dst, const float *src, const dsp::cqt_kernel_t *k, cqt_kernel_apply_t func)
+    {
+        if (!PTEST_SUPPORTED(func))
+            return;
+
+        char buf[80];
+        sprintf(buf, "%s x %d", label, int(k->bins));
+        printf("Testing %s bins ...\n", buf);
+
+        PTEST_LOOP(buf,
+            func(dst, src, k->kernel, k->band, k->bins);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        const size_t count  = 1 << MAX_RANK;
+        const size_t ksize  = dsp::cqt_kernel_buffer_size(MIN_RANK, BINS_PER_OCTAVE, SAMPLE_RATE, 0.0f) +
+                              dsp::cqt_kernel_buffer_size(MAX_RANK, BINS_PER_OCTAVE, SAMPLE_RATE, 0.0f);
+        uint8_t *data       = NULL;
+        float *src          = alloc_aligned<float>(data, count * 4 + ksize, 64);
+        float *tmp          = &src[count];
+        float *dst          = &tmp[count * 2];
+        float *buf          = &dst[count];
+
+        for (size_t i=0; i < count; ++i)
+            src[i]              = randf(-1.0f, 1.0f);
+
+        for (size_t rank=MIN_RANK; rank<=MAX_RANK; rank += 2)
+        {
+            dsp::cqt_kernel_t k;
+            if (!dsp::cqt_kernel_init(&k, buf, rank, BINS_PER_OCTAVE, SAMPLE_RATE, 0.0f))
+                continue;
+
+            char label[80];
+            sprintf(label, "packed_real_direct_fft x %d", int(1 << rank));
+            printf("Testing %s ...\n", label);
+            PTEST_LOOP(label,
+                dsp::packed_real_direct_fft(tmp, src, rank);
+            );
+
+            sprintf(label, "cqt_process x %d", int(1 << rank));
+            printf("Testing %s ...\n", label);
+            PTEST_LOOP(label,
+                dsp::cqt_process(&k, dst, src, tmp);
+            );
+            PTEST_SEPARATOR;
+
+            call("generic::cqt_kernel_apply", dst, tmp, &k, generic::cqt_kernel_apply);
+            IF_ARCH_X86(call("sse::cqt_kernel_apply", dst, tmp, &k, sse::cqt_kernel_apply));
+            IF_ARCH_X86(call("avx::cqt_kernel_apply", dst, tmp, &k, avx::cqt_kernel_apply));
+            IF_ARCH_X86(call("avx::cqt_kernel_apply_fma3", dst, tmp, &k, avx::cqt_kernel_apply_fma3));
+            PTEST_SEPARATOR2;
+        }
+
+        free_aligned(data);
+    }
+PTEST_END
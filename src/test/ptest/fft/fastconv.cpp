@@ -70,6 +70,17 @@ namespace lsp
             void fastconv_parse_fma3(float *dst, const float *src, size_t rank);
             void fastconv_parse_apply_fma3(float *dst, float *tmp, const float *c, const float *src, size_t rank);
         }
+
+        namespace avx512
+        {
+            void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+            void reverse_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+            void complex_mul3(float *dst_re, float *dst_im, const float *src1_re, const float *src1_im, const float *src2_re, const float *src2_im, size_t count);
+            void add2(float *dst, const float *src, size_t count);
+
+            void fastconv_parse(float *dst, const float *src, size_t rank);
+            void fastconv_parse_apply(float *dst, float *tmp, const float *c, const float *src, size_t rank);
+        }
     )
 
     IF_ARCH_ARM(
@@ -199,6 +210,8 @@ PTEST_BEGIN("dsp.fft", fastconv, 10, 1000)
                     avx::direct_fft, avx::complex_mul3, avx::reverse_fft, avx::add2);
                 call("avx::fft_fma3", out, tmp, tmp2, conv, in, cv, rank,
                     avx::direct_fft_fma3, avx::complex_mul3_fma3, avx::reverse_fft_fma3, avx::add2);
+                call("avx512::fft", out, tmp, tmp2, conv, in, cv, rank,
+                    avx512::direct_fft, avx512::complex_mul3, avx512::reverse_fft, avx512::add2);
 
                 call("sse::fastconv_fft", out, tmp, conv, in, cv, rank,
                     sse::fastconv_parse, sse::fastconv_parse_apply);
@@ -206,6 +219,8 @@ PTEST_BEGIN("dsp.fft", fastconv, 10, 1000)
                     avx::fastconv_parse, avx::fastconv_parse_apply);
                 call("avx::fastconv_fft_fma3", out, tmp, conv, in, cv, rank,
                     avx::fastconv_parse_fma3, avx::fastconv_parse_apply_fma3);
+                call("avx512::fastconv_fft", out, tmp, conv, in, cv, rank,
+                    avx512::fastconv_parse, avx512::fastconv_parse_apply);
             )
 
             IF_ARCH_ARM(
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 10 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define MIN_RANK    8
+#define MAX_RANK    12
+#define PARTS       16
+
+namespace lsp
+{
+    namespace generic
+    {
+        void fastconv_parse(float *dst, const float *src, size_t rank);
+        void fastconv_restore(float *dst, float *src, size_t rank);
+        void fastconv_apply(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+        void fastconv_mac_n(float *dst, const float * const *spectra, const float * const *kernels, size_t n, size_t rank);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void fastconv_parse(float *dst, const float *src, size_t rank);
+            void fastconv_restore(float *dst, float *src, size_t rank);
+            void fastconv_apply(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+        }
+
+        namespace avx
+        {
+            void fastconv_parse(float *dst, const float *src, size_t rank);
+            void fastconv_restore(float *dst, float *src, size_t rank);
+            void fastconv_apply(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+            void fastconv_mac_n(float *dst, const float * const *spectra, const float * const *kernels, size_t n, size_t rank);
+
+            void fastconv_parse_fma3(float *dst, const float *src, size_t rank);
+            void fastconv_restore_fma3(float *dst, float *src, size_t rank);
+            void fastconv_apply_fma3(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+            void fastconv_mac_n_fma3(float *dst, const float * const *spectra, const float * const *kernels, size_t n, size_t rank);
+        }
+
+        namespace avx512
+        {
+            void fastconv_parse(float *dst, const float *src, size_t rank);
+            void fastconv_restore(float *dst, float *src, size_t rank);
+            void fastconv_apply(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+            void fastconv_mac_n(float *dst, const float * const *spectra, const float * const *kernels, size_t n, size_t rank);
+        }
+    )
+
+    IF_ARCH_ARM(
+        namespace neon_d32
+        {
+            void fastconv_parse(float *dst, const float *src, size_t rank);
+            void fastconv_restore(float *dst, float *src, size_t rank);
+            void fastconv_apply(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+        }
+    )
+
+    IF_ARCH_AARCH64(
+        namespace asimd
+        {
+            void fastconv_parse(float *dst, const float *src, size_t rank);
+            void fastconv_restore(float *dst, float *src, size_t rank);
+            void fastconv_apply(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+        }
+    )
+
+    typedef void (* fastconv_parse_t)(float *dst, const float *src, size_t rank);
+    typedef void (* fastconv_restore_t)(float *dst, float *src, size_t rank);
+    typedef void (* fastconv_apply_t)(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+    typedef void (* fastconv_mac_n_t)(float *dst, const float * const *spectra, const float * const *kernels, size_t n, size_t rank);
+}
+
+//-----------------------------------------------------------------------------
+// Performance test for the frequency-domain delay line: the sum of products of PARTS
+// partitions computed by separate fastconv_apply() calls and by fastconv_mac_n()
+PTEST_BEGIN("dsp.fft", fastconv_mac, 10, 1000)
+
+    void call(
+            const char *label,
+            float *out, float *tmp, float *spec, float *kern, const float *in, size_t rank,
+            fastconv_parse_t parse, fastconv_restore_t restore, fastconv_apply_t apply, fastconv_mac_n_t mac
+        )
+    {
+        if (!(PTEST_SUPPORTED(parse) && PTEST_SUPPORTED(restore) && PTEST_SUPPORTED(apply)))
+            return;
+
+        const size_t fc = 2 << rank;
+        const float *vs[PARTS], *vk[PARTS];
+
+        // Prepare data
+        for (size_t i=0; i<PARTS; ++i)
+        {
+            parse(&spec[fc * i], &in[i << (rank - 1)], rank);
+            parse(&kern[fc * i], &in[(i + PARTS) << (rank - 1)], rank);
+            vs[i]       = &spec[fc * i];
+            vk[i]       = &kern[fc * i];
+        }
+        dsp::fill_zero(out, 1 << rank);
+
+        char buf[80];
+        sprintf(buf, "%s x %d", label, int(1 << rank));
+        printf("Testing %s samples (rank = %d, %d partitions)...\n", buf, int(rank), int(PARTS));
+
+        if (mac == NULL)
+        {
+            PTEST_LOOP(buf,
+                for (size_t i=0; i<PARTS; ++i)
+                    apply(out, tmp, vs[i], vk[i], rank);
+            );
+        }
+        else
+        {
+            if (!PTEST_SUPPORTED(mac))
+                return;
+
+            PTEST_LOOP(buf,
+                mac(tmp, vs, vk, PARTS, rank);
+                restore(out, tmp, rank);
+            );
+        }
+    }
+
+    PTEST_MAIN
+    {
+        size_t fft_size = 1 << MAX_RANK;
+        size_t alloc    = fft_size * PARTS      // in size
+                        + fft_size * 2 * PARTS  // spectra size
+                        + fft_size * 2 * PARTS  // kernels size
+                        + fft_size * 2          // tmp size
+                        + fft_size;             // out size
+
+        uint8_t *data   = NULL;
+        float *in       = alloc_aligned<float>(data, alloc, 64);
+        float *spec     = &in[fft_size * PARTS];
+        float *kern     = &spec[fft_size * 2 * PARTS];
+        float *tmp      = &kern[fft_size * 2 * PARTS];
+        float *out      = &tmp[fft_size * 2];
+
+        for (size_t i=0; i < fft_size * PARTS; ++i)
+            in[i]           = randf(-1.0f, 1.0f);
+
+        #define CALL(label, parse, restore, apply, mac) \
+            call(label, out, tmp, spec, kern, in, rank, parse, restore, apply, mac)
+
+        for (size_t rank=MIN_RANK; rank <= MAX_RANK; ++rank)
+        {
+            CALL("generic::fastconv_apply", generic::fastconv_parse, generic::fastconv_restore, generic::fastconv_apply, NULL);
+            CALL("generic::fastconv_mac_n", generic::fastconv_parse, generic::fastconv_restore, generic::fastconv_apply, generic::fastconv_mac_n);
+            IF_ARCH_X86(CALL("sse::fastconv_apply", sse::fastconv_parse, sse::fastconv_restore, sse::fastconv_apply, NULL));
+            IF_ARCH_X86(CALL("sse::fastconv_mac_n", sse::fastconv_parse, sse::fastconv_restore, sse::fastconv_apply, generic::fastconv_mac_n));
+            IF_ARCH_X86(CALL("avx::fastconv_apply", avx::fastconv_parse, avx::fastconv_restore, avx::fastconv_apply, NULL));
+            IF_ARCH_X86(CALL("avx::fastconv_mac_n", avx::fastconv_parse, avx::fastconv_restore, avx::fastconv_apply, avx::fastconv_mac_n));
+            IF_ARCH_X86(CALL("avx::fastconv_apply_fma3", avx::fastconv_parse_fma3, avx::fastconv_restore_fma3, avx::fastconv_apply_fma3, NULL));
+            IF_ARCH_X86(CALL("avx::fastconv_mac_n_fma3", avx::fastconv_parse_fma3, avx::fastconv_restore_fma3, avx::fastconv_apply_fma3, avx::fastconv_mac_n_fma3));
+            IF_ARCH_X86(CALL("avx512::fastconv_apply", avx512::fastconv_parse, avx512::fastconv_restore, avx512::fastconv_apply, NULL));
+            IF_ARCH_X86(CALL("avx512::fastconv_mac_n", avx512::fastconv_parse, avx512::fastconv_restore, avx512::fastconv_apply, avx512::fastconv_mac_n));
+            IF_ARCH_ARM(CALL("neon_d32::fastconv_apply", neon_d32::fastconv_parse, neon_d32::fastconv_restore, neon_d32::fastconv_apply, NULL));
+            IF_ARCH_ARM(CALL("neon_d32::fastconv_mac_n", neon_d32::fastconv_parse, neon_d32::fastconv_restore, neon_d32::fastconv_apply, generic::fastconv_mac_n));
+            IF_ARCH_AARCH64(CALL("asimd::fastconv_apply", asimd::fastconv_parse, asimd::fastconv_restore, asimd::fastconv_apply, NULL));
+            IF_ARCH_AARCH64(CALL("asimd::fastconv_mac_n", asimd::fastconv_parse, asimd::fastconv_restore, asimd::fastconv_apply, generic::fastconv_mac_n));
+            PTEST_SEPARATOR;
+        }
+
+        #undef CALL
+
+        free_aligned(data);
+    }
+PTEST_END
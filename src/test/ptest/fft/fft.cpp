@@ -26,7 +26,7 @@
 #include <lsp-plug.in/test-fw/ptest.h>
 
 #define MIN_RANK 8
-#define MAX_RANK 16
+#define MAX_RANK 22
 
 namespace lsp
 {
@@ -51,6 +51,11 @@ namespace lsp
             void packed_direct_fft(float *dst, const float *src, size_t rank);
             void packed_direct_fft_fma3(float *dst, const float *src, size_t rank);
         }
+
+        namespace avx512
+        {
+            void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        }
     )
 
     IF_ARCH_ARM(
@@ -134,6 +139,7 @@ PTEST_BEGIN("dsp.fft", fft, 10, 1000)
             IF_ARCH_X86(CALL1(sse::direct_fft));
             IF_ARCH_X86(CALL1(avx::direct_fft));
             IF_ARCH_X86(CALL1(avx::direct_fft_fma3));
+            IF_ARCH_X86(CALL1(avx512::direct_fft));
             IF_ARCH_ARM(CALL1(neon_d32::direct_fft));
             IF_ARCH_AARCH64(CALL1(asimd::direct_fft));
 
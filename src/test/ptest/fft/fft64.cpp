@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define MIN_RANK 8
+#define MAX_RANK 20
+
+namespace lsp
+{
+    namespace generic
+    {
+        void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        void direct_fft_mp(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        void direct_fft_f64(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+    }
+
+    IF_ARCH_X86(
+        namespace sse2
+        {
+            void direct_fft_mp(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+            void direct_fft_f64(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+        }
+
+        namespace avx
+        {
+            void direct_fft_fma3(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+            void direct_fft_mp(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+            void direct_fft_mp_fma3(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+            void direct_fft_f64(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+            void direct_fft_f64_fma3(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+        }
+    )
+
+    IF_ARCH_AARCH64(
+        namespace asimd
+        {
+            void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        }
+    )
+
+    typedef void (* direct_fft_t) (float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+    typedef void (* direct_fft_f64_t) (double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+}
+
+//-----------------------------------------------------------------------------
+// Performance test for double and mixed precision FFT
+PTEST_BEGIN("dsp.fft", fft64, 10, 1000)
+
+    void call(const char *label, float *fft_re, float *fft_im, const float *sig_re, const float *sig_im, size_t rank, direct_fft_t fft)
+    {
+        if (!PTEST_SUPPORTED(fft))
+            return;
+
+        char buf[80];
+        sprintf(buf, "%s x %d", label, int(1 << rank));
+        printf("Testing %s samples (rank = %d) ...\n", buf, int(rank));
+
+        PTEST_LOOP(buf,
+            fft(fft_re, fft_im, sig_re, sig_im, rank);
+        )
+    }
+
+    void call(const char *label, double *fft_re, double *fft_im, const double *sig_re, const double *sig_im, size_t rank, direct_fft_f64_t fft)
+    {
+        if (!PTEST_SUPPORTED(fft))
+            return;
+
+        char buf[80];
+        sprintf(buf, "%s x %d", label, int(1 << rank));
+        printf("Testing %s samples (rank = %d) ...\n", buf, int(rank));
+
+        PTEST_LOOP(buf,
+            fft(fft_re, fft_im, sig_re, sig_im, rank);
+        )
+    }
+
+    PTEST_MAIN
+    {
+        size_t fft_size = 1 << MAX_RANK;
+
+        uint8_t *data   = NULL;
+        uint8_t *data64 = NULL;
+
+        float *sig_re   = alloc_aligned<float>(data, fft_size * 4, 64);
+        float *sig_im   = &sig_re[fft_size];
+        float *fft_re   = &sig_im[fft_size];
+        float *fft_im   = &fft_re[fft_size];
+
+        double *xsig_re = alloc_aligned<double>(data64, fft_size * 4, 64);
+        double *xsig_im = &xsig_re[fft_size];
+        double *xfft_re = &xsig_im[fft_size];
+        double *xfft_im = &xfft_re[fft_size];
+
+        for (size_t i=0; i < fft_size; ++i)
+        {
+            sig_re[i]       = randf(0.0f, 1.0f);
+            sig_im[i]       = 0.0f;
+            xsig_re[i]      = sig_re[i];
+            xsig_im[i]      = 0.0;
+        }
+
+        #define CALL1(func) \
+            call(#func, fft_re, fft_im, sig_re, sig_im, i, func)
+        #define CALL2(func) \
+            call(#func, xfft_re, xfft_im, xsig_re, xsig_im, i, func)
+
+        for (size_t i=MIN_RANK; i <= MAX_RANK; ++i)
+        {
+            CALL1(generic::direct_fft);
+            IF_ARCH_X86(CALL1(avx::direct_fft_fma3));
+            IF_ARCH_AARCH64(CALL1(asimd::direct_fft));
+
+            CALL1(generic::direct_fft_mp);
+            IF_ARCH_X86(CALL1(sse2::direct_fft_mp));
+            IF_ARCH_X86(CALL1(avx::direct_fft_mp));
+            IF_ARCH_X86(CALL1(avx::direct_fft_mp_fma3));
+
+            CALL2(generic::direct_fft_f64);
+            IF_ARCH_X86(CALL2(sse2::direct_fft_f64));
+            IF_ARCH_X86(CALL2(avx::direct_fft_f64));
+            IF_ARCH_X86(CALL2(avx::direct_fft_f64_fma3));
+            PTEST_SEPARATOR;
+        }
+
+        free_aligned(data);
+        free_aligned(data64);
+    }
+PTEST_END
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 7 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define MAX_SIZE    0x2000
+
+//-----------------------------------------------------------------------------
+// Performance test for FFT of arbitrary size compared to the zero-padded power-of-two FFT
+PTEST_BEGIN("dsp.fft", fftn, 10, 1000)
+
+    void call_fftn(float *dst, const float *src, float *buf, size_t count)
+    {
+        dsp::fftn_t plan;
+        if (!dsp::fftn_init(&plan, buf, count))
+            return;
+
+        char label[80];
+        sprintf(label, "fftn_direct x %d", int(count));
+        printf("Testing %s samples ...\n", label);
+
+        PTEST_LOOP(label,
+            dsp::fftn_direct(&plan, dst, src);
+        )
+    }
+
+    void call_pfft(float *dst, const float *src, size_t rank)
+    {
+        char label[80];
+        sprintf(label, "packed_direct_fft x %d", int(1 << rank));
+        printf("Testing %s samples ...\n", label);
+
+        PTEST_LOOP(label,
+            dsp::packed_direct_fft(dst, src, rank);
+        )
+    }
+
+    PTEST_MAIN
+    {
+        static const size_t sizes[] = { 480, 960, 1000, 1920, 3840, 1021 };
+
+        uint8_t *data   = NULL;
+        float *src      = alloc_aligned<float>(data, MAX_SIZE * 12, 64);
+        float *dst      = &src[MAX_SIZE * 2];
+        float *buf      = &dst[MAX_SIZE * 2];
+
+        for (size_t i=0; i < MAX_SIZE * 2; ++i)
+            src[i]          = randf(-1.0f, 1.0f);
+
+        for (size_t i=0; i<sizeof(sizes)/sizeof(size_t); ++i)
+        {
+            size_t count    = sizes[i];
+            size_t rank     = 0;
+            while ((size_t(1) << rank) < count)
+                ++rank;
+
+            call_fftn(dst, src, buf, count);
+            call_pfft(dst, src, rank);
+            PTEST_SEPARATOR;
+        }
+
+        free_aligned(data);
+    }
+PTEST_END
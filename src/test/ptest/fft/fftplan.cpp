@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define MIN_RANK    8
+#define MAX_RANK    16
+
+namespace lsp
+{
+    namespace generic
+    {
+        void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        void packed_direct_fft(float *dst, const float *src, size_t rank);
+        void fft_plan_direct(const dsp::fft_plan_t *plan, float *re, float *im);
+        void fft_plan_packed_direct(const dsp::fft_plan_t *plan, float *data);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+            void packed_direct_fft(float *dst, const float *src, size_t rank);
+            void fft_plan_direct(const dsp::fft_plan_t *plan, float *re, float *im);
+            void fft_plan_packed_direct(const dsp::fft_plan_t *plan, float *data);
+        }
+
+        namespace avx
+        {
+            void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+            void packed_direct_fft(float *dst, const float *src, size_t rank);
+            void fft_plan_direct(const dsp::fft_plan_t *plan, float *re, float *im);
+            void fft_plan_packed_direct(const dsp::fft_plan_t *plan, float *data);
+
+            void direct_fft_fma3(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+            void packed_direct_fft_fma3(float *dst, const float *src, size_t rank);
+            void fft_plan_direct_fma3(const dsp::fft_plan_t *plan, float *re, float *im);
+            void fft_plan_packed_direct_fma3(const dsp::fft_plan_t *plan, float *data);
+        }
+
+        namespace avx512
+        {
+            void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+            void fft_plan_direct(const dsp::fft_plan_t *plan, float *re, float *im);
+        }
+    )
+
+    typedef void (* direct_fft_t)(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+    typedef void (* packed_direct_fft_t)(float *dst, const float *src, size_t rank);
+    typedef void (* fft_plan_direct_t)(const dsp::fft_plan_t *plan, float *re, float *im);
+    typedef void (* fft_plan_packed_direct_t)(const dsp::fft_plan_t *plan, float *data);
+}
+
+//-----------------------------------------------------------------------------
+// Performance test for the in-place FFT plan compared to the in-place FFT functions
+PTEST_BEGIN("dsp.fft", fftplan, 5, 1000)
+
+    void call(const char *label, const char *plan_label, float *re, float *im, const dsp::fft_plan_t *plan,
+        direct_fft_t fft, fft_plan_direct_t plan_fft)
+    {
+        if ((!PTEST_SUPPORTED(fft)) || (!PTEST_SUPPORTED(plan_fft)))
+            return;
+
+        char buf[80];
+        size_t rank = plan->rank;
+        sprintf(buf, "%s x %d", label, int(1 << rank));
+        printf("Testing %s samples ...\n", buf);
+        PTEST_LOOP(buf,
+            fft(re, im, re, im, rank);
+        )
+
+        sprintf(buf, "%s x %d", plan_label, int(1 << rank));
+        printf("Testing %s samples ...\n", buf);
+        PTEST_LOOP(buf,
+            plan_fft(plan, re, im);
+        )
+    }
+
+    void call(const char *label, const char *plan_label, float *dst, const dsp::fft_plan_t *plan,
+        packed_direct_fft_t fft, fft_plan_packed_direct_t plan_fft)
+    {
+        if ((!PTEST_SUPPORTED(fft)) || (!PTEST_SUPPORTED(plan_fft)))
+            return;
+
+        char buf[80];
+        size_t rank = plan->rank;
+        sprintf(buf, "%s x %d", label, int(1 << rank));
+        printf("Testing %s samples ...\n", buf);
+        PTEST_LOOP(buf,
+            fft(dst, dst, rank);
+        )
+
+        sprintf(buf, "%s x %d", plan_label, int(1 << rank));
+        printf("Testing %s samples ...\n", buf);
+        PTEST_LOOP(buf,
+            plan_fft(plan, dst);
+        )
+    }
+
+    PTEST_MAIN
+    {
+        size_t count    = 1 << MAX_RANK;
+        size_t plan_size= dsp::fft_plan_buffer_size(MAX_RANK);
+        uint8_t *data   = NULL;
+        float *re       = alloc_aligned<float>(data, count * 4 + plan_size * 2, 64);
+        float *im       = &re[count];
+        float *dst      = &im[count];
+        float *split    = &dst[count * 2];
+        float *packed   = &split[plan_size];
+
+        for (size_t i=0; i < count * 4; ++i)
+            re[i]           = randf(-1.0f, 1.0f);
+
+        #define CALL1(func, plan_func) \
+            call(#func, #plan_func, re, im, &split_plan, func, plan_func)
+        #define CALL2(func, plan_func) \
+            call(#func, #plan_func, dst, &packed_plan, func, plan_func)
+
+        for (size_t rank=MIN_RANK; rank<=MAX_RANK; ++rank)
+        {
+            dsp::fft_plan_t split_plan, packed_plan;
+            dsp::fft_plan_init(&split_plan, split, rank, false);
+            dsp::fft_plan_init(&packed_plan, packed, rank, true);
+
+            CALL1(generic::direct_fft, generic::fft_plan_direct);
+            IF_ARCH_X86(CALL1(sse::direct_fft, sse::fft_plan_direct));
+            IF_ARCH_X86(CALL1(avx::direct_fft, avx::fft_plan_direct));
+            IF_ARCH_X86(CALL1(avx::direct_fft_fma3, avx::fft_plan_direct_fma3));
+            IF_ARCH_X86(CALL1(avx512::direct_fft, avx512::fft_plan_direct));
+            PTEST_SEPARATOR;
+
+            CALL2(generic::packed_direct_fft, generic::fft_plan_packed_direct);
+            IF_ARCH_X86(CALL2(sse::packed_direct_fft, sse::fft_plan_packed_direct));
+            IF_ARCH_X86(CALL2(avx::packed_direct_fft, avx::fft_plan_packed_direct));
+            IF_ARCH_X86(CALL2(avx::packed_direct_fft_fma3, avx::fft_plan_packed_direct_fma3));
+            PTEST_SEPARATOR2;
+        }
+
+        free_aligned(data);
+    }
+PTEST_END
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define RANK        10
+#define MAX_BINS    64
+#define HOP         64
+
+namespace lsp
+{
+    namespace generic
+    {
+        void goertzel_bank(float *state, const float *coef, const float *src, size_t bins, size_t count);
+        void sdft_bank(float *state, const float *coef, const float *src, const float *old, size_t bins, size_t count);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void goertzel_bank(float *state, const float *coef, const float *src, size_t bins, size_t count);
+            void sdft_bank(float *state, const float *coef, const float *src, const float *old, size_t bins, size_t count);
+        }
+
+        namespace avx
+        {
+            void goertzel_bank(float *state, const float *coef, const float *src, size_t bins, size_t count);
+            void sdft_bank(float *state, const float *coef, const float *src, const float *old, size_t bins, size_t count);
+        }
+    )
+
+    typedef void (* goertzel_bank_t)(float *state, const float *coef, const float *src, size_t bins, size_t count);
+    typedef void (* sdft_bank_t)(float *state, const float *coef, const float *src, const float *old, size_t bins, size_t count);
+}
+
+//-----------------------------------------------------------------------------
+// Performance test for the bank of Goertzel filters and the sliding DFT compared
+// to the FFT of the whole block
+PTEST_BEGIN("dsp.fft", goertzel, 5, 1000)
+
+    void call(const char *label, float *state, const float *coef, const float *src, size_t bins, goertzel_bank_t func)
+    {
+        if (!PTEST_SUPPORTED(func))
+            return;
+
+        char buf[80];
+        sprintf(buf, "%s x %d bins", label, int(bins));
+        printf("Testing %s ...\n", buf);
+
+        dsp::fill_zero(state, bins * 2);
+        PTEST_LOOP(buf,
+            func(state, coef, src, bins, 1 << RANK);
+        );
+    }
+
+    void call(const char *label, float *state, const float *coef, const float *src, size_t bins, sdft_bank_t func)
+    {
+        if (!PTEST_SUPPORTED(func))
+            return;
+
+        char buf[80];
+        sprintf(buf, "%s x %d bins", label, int(bins));
+        printf("Testing %s ...\n", buf);
+
+        dsp::fill_zero(state, bins * 2);
+        PTEST_LOOP(buf,
+            func(state, coef, src, src, bins, 1 << RANK);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        size_t count    = 1 << RANK;
+        uint8_t *data   = NULL;
+        float *src      = alloc_aligned<float>(data, count * 4 + MAX_BINS * 6, 64);
+        float *dst      = &src[count];
+        float *state    = &dst[count * 2];
+        float *coef     = &state[MAX_BINS * 2];
+
+        for (size_t i=0; i < count; ++i)
+            src[i]          = randf(-1.0f, 1.0f);
+
+        // The reference: FFT of the whole block of samples
+        char buf[80];
+        sprintf(buf, "packed_real_direct_fft x %d", int(count));
+        printf("Testing %s ...\n", buf);
+        PTEST_LOOP(buf,
+            dsp::packed_real_direct_fft(dst, src, RANK);
+        );
+
+        // The reference for tracking: FFT of the sliding window at each hop
+        sprintf(buf, "packed_real_direct_fft x %d, hop %d", int(count), int(HOP));
+        printf("Testing %s ...\n", buf);
+        PTEST_LOOP(buf,
+            for (size_t i=0; i < count; i += HOP)
+                dsp::packed_real_direct_fft(dst, src, RANK);
+        );
+        PTEST_SEPARATOR2;
+
+        for (size_t bins=1; bins <= MAX_BINS; bins <<= 2)
+        {
+            // Rotation factors z of bins k/count, z^count = 1
+            for (size_t i=0; i < bins; ++i)
+            {
+                float w             = (2.0 * M_PI * (i + 1)) / count;
+                coef[i]             = cosf(w);
+                coef[i + bins]      = sinf(w);
+                coef[i + bins*2]    = 1.0f;
+                coef[i + bins*3]    = 0.0f;
+            }
+
+            call("generic::goertzel_bank", state, coef, src, bins, generic::goertzel_bank);
+            IF_ARCH_X86(call("sse::goertzel_bank", state, coef, src, bins, sse::goertzel_bank));
+            IF_ARCH_X86(call("avx::goertzel_bank", state, coef, src, bins, avx::goertzel_bank));
+            PTEST_SEPARATOR;
+
+            call("generic::sdft_bank", state, coef, src, bins, generic::sdft_bank);
+            IF_ARCH_X86(call("sse::sdft_bank", state, coef, src, bins, sse::sdft_bank));
+            IF_ARCH_X86(call("avx::sdft_bank", state, coef, src, bins, avx::sdft_bank));
+            PTEST_SEPARATOR2;
+        }
+
+        free_aligned(data);
+    }
+PTEST_END
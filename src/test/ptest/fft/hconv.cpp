@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 28 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define IR_LENGTH       48000
+#define BLOCK_SIZE      0x100
+#define MAX_RANK        12
+
+//-----------------------------------------------------------------------------
+// Performance test for the zero-latency convolution of the 1-second impulse response at 48 kHz
+PTEST_BEGIN("dsp.fft", hconv, 10, 100)
+
+    void call(float *dst, const float *src, const float *ir, size_t rank, const char *note)
+    {
+        const size_t size   = dsp::hconv_buffer_size(IR_LENGTH, rank, MAX_RANK);
+        uint8_t *data       = NULL;
+        float *buf          = alloc_aligned<float>(data, size, 64);
+        if (buf == NULL)
+            return;
+
+        dsp::hconv_t conv;
+        if (dsp::hconv_init(&conv, buf, ir, IR_LENGTH, rank, MAX_RANK))
+        {
+            char label[80];
+            sprintf(label, "hconv rank=%d head=%d%s", int(rank), int(conv.block), note);
+            printf("Testing %s, %d samples per block ...\n", label, int(BLOCK_SIZE));
+
+            PTEST_LOOP(label,
+                dsp::hconv_process(&conv, dst, src, BLOCK_SIZE);
+            )
+        }
+
+        free_aligned(data);
+    }
+
+    PTEST_MAIN
+    {
+        uint8_t *data   = NULL;
+        float *ir       = alloc_aligned<float>(data, IR_LENGTH + BLOCK_SIZE * 2 + LSP_DSP_HCONV_CALIBRATE_SIZE, 64);
+        float *tmp      = &ir[IR_LENGTH];
+        float *src      = &tmp[LSP_DSP_HCONV_CALIBRATE_SIZE];
+        float *dst      = &src[BLOCK_SIZE];
+
+        for (size_t i=0; i < IR_LENGTH + BLOCK_SIZE; ++i)
+            ir[i]           = randf(-1.0f, 1.0f);
+
+        dsp::hconv_costs_t costs;
+        dsp::hconv_calibrate(&costs, tmp);
+        const size_t best   = dsp::hconv_rank(&costs, IR_LENGTH, MAX_RANK);
+
+        for (size_t rank=LSP_DSP_PCONV_RANK_MIN; rank<=10; ++rank)
+            call(dst, src, ir, rank, (rank == best) ? " (estimated)" : "");
+
+        free_aligned(data);
+    }
+PTEST_END
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 9 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define IR_LENGTH       (96000 * 10)
+#define BLOCK_SIZE      0x1000
+#define RANK            8
+#define ASYNC_RANK      11
+#define THREADS         2
+
+//-----------------------------------------------------------------------------
+// Performance test for the partitioned convolution of the 10-second impulse response at 96 kHz
+PTEST_BEGIN("dsp.fft", pconv, 10, 10)
+
+    void call(float *dst, const float *src, const float *ir, size_t max_rank, dsp::pconv_pool_t *pool = NULL)
+    {
+        const size_t size   = (pool != NULL) ?
+            dsp::pconv_mt_buffer_size(IR_LENGTH, RANK, max_rank, ASYNC_RANK) :
+            dsp::pconv_buffer_size(IR_LENGTH, RANK, max_rank);
+        uint8_t *data       = NULL;
+        float *buf          = alloc_aligned<float>(data, size, 64);
+        if (buf == NULL)
+            return;
+
+        dsp::pconv_t conv;
+        const bool res      = (pool != NULL) ?
+            dsp::pconv_mt_init(&conv, buf, pool, ir, IR_LENGTH, RANK, max_rank, ASYNC_RANK) :
+            dsp::pconv_init(&conv, buf, ir, IR_LENGTH, RANK, max_rank);
+        if (res)
+        {
+            char label[80];
+            sprintf(label, "pconv rank=%d max_rank=%d levels=%d%s", int(RANK), int(max_rank), int(conv.nlevels),
+                (pool != NULL) ? " async" : "");
+            printf("Testing %s, %d samples per block ...\n", label, int(BLOCK_SIZE));
+
+            PTEST_LOOP(label,
+                dsp::pconv_process(&conv, dst, src, BLOCK_SIZE);
+            )
+
+            if (pool != NULL)
+                dsp::pconv_mt_destroy(&conv);
+        }
+
+        free_aligned(data);
+    }
+
+    PTEST_MAIN
+    {
+        static const size_t max_ranks[] = { 8, 10, 12, 14, 16 };
+
+        uint8_t *data   = NULL;
+        float *ir       = alloc_aligned<float>(data, IR_LENGTH + BLOCK_SIZE * 2, 64);
+        float *src      = &ir[IR_LENGTH];
+        float *dst      = &src[BLOCK_SIZE];
+
+        for (size_t i=0; i < IR_LENGTH + BLOCK_SIZE; ++i)
+            ir[i]           = randf(-1.0f, 1.0f);
+
+        for (size_t i=0; i<sizeof(max_ranks)/sizeof(size_t); ++i)
+            call(dst, src, ir, max_ranks[i]);
+
+        // Levels of ASYNC_RANK and above are computed by worker threads
+        uint8_t *pdata  = NULL;
+        dsp::pconv_pool_t *pool = reinterpret_cast<dsp::pconv_pool_t *>(
+            alloc_aligned<uint8_t>(pdata, dsp::pconv_pool_size(), LSP_DSP_PCONV_POOL_ALIGN));
+        if ((pool != NULL) && (dsp::pconv_pool_start(pool, THREADS)))
+        {
+            PTEST_SEPARATOR;
+            for (size_t i=0; i<sizeof(max_ranks)/sizeof(size_t); ++i)
+                call(dst, src, ir, max_ranks[i], pool);
+            dsp::pconv_pool_stop(pool);
+        }
+        free_aligned(pdata);
+
+        free_aligned(data);
+    }
+PTEST_END
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 26 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define BUF_SIZE        1024
+#define MAX_LENGTH      256
+
+namespace lsp
+{
+    namespace generic
+    {
+        void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+        }
+
+        namespace avx
+        {
+            void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+            void convolve_fma3(float *dst, const float *src, const float *conv, size_t length, size_t count);
+        }
+
+        namespace avx512
+        {
+            void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+        }
+    )
+
+    IF_ARCH_X86_64(
+        namespace avx512
+        {
+            void x64_convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+        }
+    )
+
+    IF_ARCH_ARM(
+        namespace neon_d32
+        {
+            void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+        }
+    )
+
+    IF_ARCH_AARCH64(
+        namespace asimd
+        {
+            void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+        }
+    )
+
+    typedef void (* convolve_t)(float *dst, const float *src, const float *conv, size_t length, size_t count);
+}
+
+//-----------------------------------------------------------------------------
+// Performance test for direct convolution with short FIR kernels
+PTEST_BEGIN("dsp.filters", convolve, 5, 1000)
+
+    void call(const char *label, float *out, const float *in, const float *conv, size_t length, convolve_t func)
+    {
+        if (!PTEST_SUPPORTED(func))
+            return;
+
+        char buf[80];
+        sprintf(buf, "%s %d x %d", label, int(BUF_SIZE), int(length));
+        printf("Testing %s convolution ...\n", buf);
+
+        PTEST_LOOP(buf,
+            func(out, in, conv, length, BUF_SIZE);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        size_t out_size = BUF_SIZE + MAX_LENGTH;
+        uint8_t *data   = NULL;
+        float *out      = alloc_aligned<float>(data, out_size + BUF_SIZE + MAX_LENGTH, 64);
+        float *in       = &out[out_size];
+        float *conv     = &in[BUF_SIZE];
+
+        for (size_t i=0; i < BUF_SIZE; ++i)
+            in[i]           = randf(-1.0f, 1.0f);
+        for (size_t i=0; i < MAX_LENGTH; ++i)
+            conv[i]         = randf(-1.0f, 1.0f);
+
+        #define CALL(length, func) \
+            dsp::fill_zero(out, out_size); \
+            call(#func, out, in, conv, length, func)
+
+        for (size_t length=16; length <= MAX_LENGTH; length <<= 1)
+        {
+            CALL(length, generic::convolve);
+            IF_ARCH_X86(CALL(length, sse::convolve));
+            IF_ARCH_X86(CALL(length, avx::convolve));
+            IF_ARCH_X86(CALL(length, avx::convolve_fma3));
+            IF_ARCH_X86(CALL(length, avx512::convolve));
+            IF_ARCH_X86_64(CALL(length, avx512::x64_convolve));
+            IF_ARCH_ARM(CALL(length, neon_d32::convolve));
+            IF_ARCH_AARCH64(CALL(length, asimd::convolve));
+
+            PTEST_SEPARATOR;
+        }
+
+        free_aligned(data);
+    }
+
+PTEST_END
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 27 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define BUF_SIZE        1024
+#define MAX_LENGTH      256
+#define KERNELS         16
+
+namespace lsp
+{
+    namespace generic
+    {
+        void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+        void convolve_multi(float * const *dst, const float *src, const float * const *conv, size_t length, size_t count, size_t n);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+            void convolve_multi(float * const *dst, const float *src, const float * const *conv, size_t length, size_t count, size_t n);
+        }
+
+        namespace avx
+        {
+            void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+            void convolve_fma3(float *dst, const float *src, const float *conv, size_t length, size_t count);
+            void convolve_multi(float * const *dst, const float *src, const float * const *conv, size_t length, size_t count, size_t n);
+            void convolve_multi_fma3(float * const *dst, const float *src, const float * const *conv, size_t length, size_t count, size_t n);
+        }
+    )
+
+    IF_ARCH_AARCH64(
+        namespace asimd
+        {
+            void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+        }
+    )
+
+    typedef void (* convolve_t)(float *dst, const float *src, const float *conv, size_t length, size_t count);
+    typedef void (* convolve_multi_t)(float * const *dst, const float *src, const float * const *conv, size_t length, size_t count, size_t n);
+}
+
+//-----------------------------------------------------------------------------
+// Performance test for direct convolution of one signal with multiple kernels
+PTEST_BEGIN("dsp.filters", convolve_multi, 5, 1000)
+
+    void call_single(const char *label, float * const *dst, const float *src, const float * const *conv, size_t length, convolve_t func)
+    {
+        if (!PTEST_SUPPORTED(func))
+            return;
+
+        char buf[80];
+        sprintf(buf, "%s %d x %d x %d", label, int(BUF_SIZE), int(length), int(KERNELS));
+        printf("Testing %s convolution ...\n", buf);
+
+        PTEST_LOOP(buf,
+            for (size_t i=0; i<KERNELS; ++i)
+                func(dst[i], src, conv[i], length, BUF_SIZE);
+        );
+    }
+
+    void call_multi(const char *label, float * const *dst, const float *src, const float * const *conv, size_t length, convolve_multi_t func)
+    {
+        if (!PTEST_SUPPORTED(func))
+            return;
+
+        char buf[80];
+        sprintf(buf, "%s %d x %d x %d", label, int(BUF_SIZE), int(length), int(KERNELS));
+        printf("Testing %s convolution ...\n", buf);
+
+        PTEST_LOOP(buf,
+            func(dst, src, conv, length, BUF_SIZE, KERNELS);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        size_t out_size = BUF_SIZE + MAX_LENGTH;
+        uint8_t *data   = NULL;
+        float *out      = alloc_aligned<float>(data, (out_size + MAX_LENGTH) * KERNELS + BUF_SIZE, 64);
+        float *conv     = &out[out_size * KERNELS];
+        float *in       = &conv[MAX_LENGTH * KERNELS];
+        float *vd[KERNELS];
+        const float *vc[KERNELS];
+
+        for (size_t i=0; i < BUF_SIZE; ++i)
+            in[i]           = randf(-1.0f, 1.0f);
+        for (size_t i=0; i < MAX_LENGTH * KERNELS; ++i)
+            conv[i]         = randf(-1.0f, 1.0f);
+        for (size_t i=0; i < KERNELS; ++i)
+        {
+            vd[i]           = &out[i * out_size];
+            vc[i]           = &conv[i * MAX_LENGTH];
+        }
+
+        #define CALL_SINGLE(length, func) \
+            dsp::fill_zero(out, out_size * KERNELS); \
+            call_single(#func, vd, in, vc, length, func)
+
+        #define CALL_MULTI(length, func) \
+            dsp::fill_zero(out, out_size * KERNELS); \
+            call_multi(#func, vd, in, vc, length, func)
+
+        for (size_t length=16; length <= MAX_LENGTH; length <<= 1)
+        {
+            CALL_SINGLE(length, generic::convolve);
+            CALL_MULTI(length, generic::convolve_multi);
+            IF_ARCH_X86(CALL_SINGLE(length, sse::convolve));
+            IF_ARCH_X86(CALL_MULTI(length, sse::convolve_multi));
+            IF_ARCH_X86(CALL_SINGLE(length, avx::convolve));
+            IF_ARCH_X86(CALL_MULTI(length, avx::convolve_multi));
+            IF_ARCH_X86(CALL_SINGLE(length, avx::convolve_fma3));
+            IF_ARCH_X86(CALL_MULTI(length, avx::convolve_multi_fma3));
+            IF_ARCH_AARCH64(CALL_SINGLE(length, asimd::convolve));
+
+            PTEST_SEPARATOR;
+        }
+
+        free_aligned(data);
+    }
+
+PTEST_END
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 14 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define MIN_RANK        8
+#define MAX_RANK        14
+
+namespace lsp
+{
+    namespace generic
+    {
+        void bilinear_transform_x8(dsp::biquad_x8_t *bf, const dsp::f_cascade_t *bc, float kf, size_t count);
+        void dyn_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+        void dyn_bilinear_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::f_cascade_t *bc, const float *kf);
+    }
+
+    IF_ARCH_X86_64(
+        namespace avx
+        {
+            void x64_bilinear_transform_x8(dsp::biquad_x8_t *bf, const dsp::f_cascade_t *bc, float kf, size_t count);
+            void x64_dyn_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+            void dyn_biquad_process_x8_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+            void x64_dyn_bilinear_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::f_cascade_t *bc, const float *kf);
+            void x64_dyn_bilinear_biquad_process_x8_fma3(float *dst, const float *src, float *d, size_t count, const dsp::f_cascade_t *bc, const float *kf);
+        }
+    )
+
+    typedef void (* bilinear_transform_x8_t)(dsp::biquad_x8_t *bf, const dsp::f_cascade_t *bc, float kf, size_t count);
+    typedef void (* dyn_biquad_process_x8_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+    typedef void (* dyn_bilinear_biquad_process_x8_t)(float *dst, const float *src, float *d, size_t count, const dsp::f_cascade_t *bc, const float *kf);
+
+    static const dsp::f_cascade_t test_c =
+    {
+        { 1, 2, 1, 0  },
+        { 1, 0.5, 1, 0 }
+    };
+}
+
+//-----------------------------------------------------------------------------
+// Performance test for the bilinear transform fused with the dynamic filter processing
+PTEST_BEGIN("dsp.filters", dyn_bilinear, 5, 1000)
+
+    void call(const char *label, float *dst, const float *src, size_t count,
+        const dsp::f_cascade_t *bc, const float *kf, dsp::biquad_x8_t *bf,
+        bilinear_transform_x8_t transform, dyn_biquad_process_x8_t process)
+    {
+        if (!PTEST_SUPPORTED(transform))
+            return;
+        if (!PTEST_SUPPORTED(process))
+            return;
+
+        char buf[80];
+        sprintf(buf, "%s x %d", label, int(count));
+        printf("Testing %s samples ...\n", buf);
+
+        float d[16] __lsp_aligned64;
+        for (size_t i=0; i<16; ++i)
+            d[i]        = 0.0f;
+
+        // The single frequency shift for the whole matrix is the best case for the transform
+        PTEST_LOOP(buf,
+            transform(bf, bc, kf[0], count + 7);
+            process(dst, src, d, count, bf);
+        );
+    }
+
+    void call(const char *label, float *dst, const float *src, size_t count,
+        const dsp::f_cascade_t *bc, const float *kf, dyn_bilinear_biquad_process_x8_t process)
+    {
+        if (!PTEST_SUPPORTED(process))
+            return;
+
+        char buf[80];
+        sprintf(buf, "%s x %d", label, int(count));
+        printf("Testing %s samples ...\n", buf);
+
+        float d[16] __lsp_aligned64;
+        for (size_t i=0; i<16; ++i)
+            d[i]        = 0.0f;
+
+        PTEST_LOOP(buf,
+            process(dst, src, d, count, bc, kf);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        size_t count    = 1 << MAX_RANK;
+        size_t rows     = count + 7;
+
+        uint8_t *data   = NULL;
+        float *src      = alloc_aligned<float>(data, count * 2 + rows + rows * (sizeof(dsp::f_cascade_t) * 8 + sizeof(dsp::biquad_x8_t)) / sizeof(float), 64);
+        float *dst      = &src[count];
+        float *kf       = &dst[count];
+        dsp::f_cascade_t *bc    = reinterpret_cast<dsp::f_cascade_t *>(&kf[(rows + 0x0f) & ~size_t(0x0f)]);
+        dsp::biquad_x8_t *bf    = reinterpret_cast<dsp::biquad_x8_t *>(&bc[rows * 8]);
+
+        for (size_t i=0; i<count; ++i)
+            src[i]          = float(rand()) / RAND_MAX;
+        for (size_t i=0; i<rows; ++i)
+            kf[i]           = 0.5f + float(i) / rows;
+        for (size_t i=0; i<rows * 8; ++i)
+            bc[i]           = test_c;
+
+        #define CALL2(transform, process) \
+            call(#transform " + " #process, dst, src, n, bc, kf, bf, transform, process)
+        #define CALL1(process) \
+            call(#process, dst, src, n, bc, kf, process)
+
+        for (size_t i=MIN_RANK; i <= MAX_RANK; i += 2)
+        {
+            size_t n        = 1 << i;
+
+            CALL2(generic::bilinear_transform_x8, generic::dyn_biquad_process_x8);
+            CALL1(generic::dyn_bilinear_biquad_process_x8);
+            IF_ARCH_X86_64(CALL2(avx::x64_bilinear_transform_x8, avx::x64_dyn_biquad_process_x8));
+            IF_ARCH_X86_64(CALL1(avx::x64_dyn_bilinear_biquad_process_x8));
+            IF_ARCH_X86_64(CALL2(avx::x64_bilinear_transform_x8, avx::dyn_biquad_process_x8_fma3));
+            IF_ARCH_X86_64(CALL1(avx::x64_dyn_bilinear_biquad_process_x8_fma3));
+            PTEST_SEPARATOR;
+        }
+
+        free_aligned(data);
+    }
+
+PTEST_END
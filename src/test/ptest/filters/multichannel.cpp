@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 7 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define FTEST_BUF_SIZE  0x200
+#define MAX_CHANNELS    16
+#define BANKS           2
+
+namespace lsp
+{
+    namespace generic
+    {
+        void biquad_process_x2(float *dst, const float *src, size_t count, dsp::biquad_t *f);
+
+        void biquad_process_mc4(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n);
+        void biquad_process_mc8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+        void biquad_process_mc16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+        void biquad_process_mc4_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n);
+        void biquad_process_mc8_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+        void biquad_process_mc16_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void biquad_process_x2(float *dst, const float *src, size_t count, dsp::biquad_t *f);
+
+            void biquad_process_mc4(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n);
+            void biquad_process_mc8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+            void biquad_process_mc16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+            void biquad_process_mc4_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n);
+            void biquad_process_mc8_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+            void biquad_process_mc16_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+        }
+
+        namespace avx
+        {
+            void biquad_process_x2_fma3(float *dst, const float *src, size_t count, dsp::biquad_t *f);
+
+            void biquad_process_mc8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+            void biquad_process_mc8_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+            void biquad_process_mc16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+            void biquad_process_mc16_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+            void biquad_process_mc8_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+            void biquad_process_mc8_planar_fma3(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+            void biquad_process_mc16_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+            void biquad_process_mc16_planar_fma3(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+        }
+
+        namespace avx512
+        {
+            void biquad_process_mc16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+        }
+    )
+
+    IF_ARCH_AARCH64(
+        namespace asimd
+        {
+            void biquad_process_x2(float *dst, const float *src, size_t count, dsp::biquad_t *f);
+        }
+    )
+
+    typedef void (* biquad_process_t)(float *dst, const float *src, size_t count, dsp::biquad_t *f);
+    typedef void (* biquad_process_mc4_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n);
+    typedef void (* biquad_process_mc8_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+    typedef void (* biquad_process_mc16_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+    typedef void (* biquad_process_mc4_planar_t)(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n);
+    typedef void (* biquad_process_mc8_planar_t)(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+    typedef void (* biquad_process_mc16_planar_t)(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+
+    static dsp::biquad_x1_t bq_normal = {
+        1.0, 2.0, 1.0,
+        -2.0, -1.0,
+        0.0, 0.0, 0.0
+    };
+}
+
+//-----------------------------------------------------------------------------
+// Performance test for multi-channel biquad processing
+PTEST_BEGIN("dsp.filters", multichannel, 10, 1000)
+
+    void process_x2(const char *text, float * const *out, const float * const *in, size_t channels, size_t count, biquad_process_t process)
+    {
+        if (!PTEST_SUPPORTED(process))
+            return;
+
+        char buf[80];
+        snprintf(buf, sizeof(buf), "%s x%d", text, int(channels));
+        printf("Testing %s filters on %d channels of %d samples ...\n", text, int(channels), int(count));
+
+        dsp::biquad_t f[MAX_CHANNELS] __lsp_aligned64;
+        for (size_t j=0; j<channels; ++j)
+        {
+            for (size_t i=0; i<BANKS; ++i)
+            {
+                f[j].x2.b0[i]   = bq_normal.b0;
+                f[j].x2.b1[i]   = bq_normal.b1;
+                f[j].x2.b2[i]   = bq_normal.b2;
+                f[j].x2.a1[i]   = bq_normal.a1;
+                f[j].x2.a2[i]   = bq_normal.a2;
+                f[j].x2.p[i]    = 0.0f;
+            }
+            dsp::fill_zero(f[j].d, LSP_DSP_BIQUAD_D_ITEMS);
+        }
+
+        PTEST_LOOP(buf,
+            for (size_t j=0; j<channels; ++j)
+                process(out[j], in[j], count, &f[j]);
+        );
+    }
+
+    void init_banks(float *f, size_t lanes)
+    {
+        for (size_t k=0; k<BANKS; ++k, f += lanes * 5)
+        {
+            for (size_t j=0; j<lanes; ++j)
+            {
+                f[j]            = bq_normal.b0;
+                f[j + lanes]    = bq_normal.b1;
+                f[j + lanes*2]  = bq_normal.b2;
+                f[j + lanes*3]  = bq_normal.a1;
+                f[j + lanes*4]  = bq_normal.a2;
+            }
+        }
+    }
+
+    void process_mc(const char *text, float *out, const float *in, size_t lanes, size_t count, void *process)
+    {
+        if (!PTEST_SUPPORTED(process))
+            return;
+
+        printf("Testing %s filters on %d interleaved channels of %d samples ...\n", text, int(lanes), int(count));
+
+        float f[MAX_CHANNELS * 5 * BANKS] __lsp_aligned64;
+        float d[MAX_CHANNELS * 2 * BANKS] __lsp_aligned64;
+        init_banks(f, lanes);
+        dsp::fill_zero(d, lanes * 2 * BANKS);
+
+        switch (lanes)
+        {
+            case 4:
+                PTEST_LOOP(text,
+                    reinterpret_cast<biquad_process_mc4_t>(process)(out, in, d, count, reinterpret_cast<dsp::biquad_x4_t *>(f), BANKS);
+                );
+                break;
+            case 8:
+                PTEST_LOOP(text,
+                    reinterpret_cast<biquad_process_mc8_t>(process)(out, in, d, count, reinterpret_cast<dsp::biquad_x8_t *>(f), BANKS);
+                );
+                break;
+            default:
+                PTEST_LOOP(text,
+                    reinterpret_cast<biquad_process_mc16_t>(process)(out, in, d, count, reinterpret_cast<dsp::biquad_x16_t *>(f), BANKS);
+                );
+                break;
+        }
+    }
+
+    void process_mc_planar(const char *text, float * const *out, const float * const *in, size_t lanes, size_t count, void *process)
+    {
+        if (!PTEST_SUPPORTED(process))
+            return;
+
+        printf("Testing %s filters on %d planar channels of %d samples ...\n", text, int(lanes), int(count));
+
+        float f[MAX_CHANNELS * 5 * BANKS] __lsp_aligned64;
+        float d[MAX_CHANNELS * 2 * BANKS] __lsp_aligned64;
+        init_banks(f, lanes);
+        dsp::fill_zero(d, lanes * 2 * BANKS);
+
+        switch (lanes)
+        {
+            case 4:
+                PTEST_LOOP(text,
+                    reinterpret_cast<biquad_process_mc4_planar_t>(process)(out, in, d, count, reinterpret_cast<dsp::biquad_x4_t *>(f), BANKS);
+                );
+                break;
+            case 8:
+                PTEST_LOOP(text,
+                    reinterpret_cast<biquad_process_mc8_planar_t>(process)(out, in, d, count, reinterpret_cast<dsp::biquad_x8_t *>(f), BANKS);
+                );
+                break;
+            default:
+                PTEST_LOOP(text,
+                    reinterpret_cast<biquad_process_mc16_planar_t>(process)(out, in, d, count, reinterpret_cast<dsp::biquad_x16_t *>(f), BANKS);
+                );
+                break;
+        }
+    }
+
+    PTEST_MAIN
+    {
+        void *data          = NULL;
+        float *buf          = alloc_aligned<float>(data, FTEST_BUF_SIZE * MAX_CHANNELS * 2, 64);
+        float *out          = buf;
+        float *in           = &out[FTEST_BUF_SIZE * MAX_CHANNELS];
+        float *vout[MAX_CHANNELS];
+        const float *vin[MAX_CHANNELS];
+
+        for (size_t i=0; i<FTEST_BUF_SIZE * MAX_CHANNELS; ++i)
+        {
+            in[i]               = (i % 1) ? 1.0f : -1.0f;
+            out[i]              = 0.0f;
+        }
+        for (size_t j=0; j<MAX_CHANNELS; ++j)
+        {
+            vout[j]             = &out[j * FTEST_BUF_SIZE];
+            vin[j]              = &in[j * FTEST_BUF_SIZE];
+        }
+
+        #define CALL_X2(func, lanes) \
+            process_x2(#func, vout, vin, lanes, FTEST_BUF_SIZE, func)
+        #define CALL(func, lanes) \
+            process_mc(#func, out, in, lanes, FTEST_BUF_SIZE, reinterpret_cast<void *>(func))
+        #define CALL_P(func, lanes) \
+            process_mc_planar(#func, vout, vin, lanes, FTEST_BUF_SIZE, reinterpret_cast<void *>(func))
+
+        CALL_X2(generic::biquad_process_x2, 4);
+        IF_ARCH_X86(CALL_X2(sse::biquad_process_x2, 4));
+        IF_ARCH_X86(CALL_X2(avx::biquad_process_x2_fma3, 4));
+        IF_ARCH_AARCH64(CALL_X2(asimd::biquad_process_x2, 4));
+        CALL(generic::biquad_process_mc4, 4);
+        IF_ARCH_X86(CALL(sse::biquad_process_mc4, 4));
+        CALL_P(generic::biquad_process_mc4_planar, 4);
+        IF_ARCH_X86(CALL_P(sse::biquad_process_mc4_planar, 4));
+        PTEST_SEPARATOR;
+
+        CALL_X2(generic::biquad_process_x2, 8);
+        IF_ARCH_X86(CALL_X2(sse::biquad_process_x2, 8));
+        IF_ARCH_X86(CALL_X2(avx::biquad_process_x2_fma3, 8));
+        IF_ARCH_AARCH64(CALL_X2(asimd::biquad_process_x2, 8));
+        CALL(generic::biquad_process_mc8, 8);
+        IF_ARCH_X86(CALL(sse::biquad_process_mc8, 8));
+        IF_ARCH_X86(CALL(avx::biquad_process_mc8, 8));
+        IF_ARCH_X86(CALL(avx::biquad_process_mc8_fma3, 8));
+        CALL_P(generic::biquad_process_mc8_planar, 8);
+        IF_ARCH_X86(CALL_P(sse::biquad_process_mc8_planar, 8));
+        IF_ARCH_X86(CALL_P(avx::biquad_process_mc8_planar, 8));
+        IF_ARCH_X86(CALL_P(avx::biquad_process_mc8_planar_fma3, 8));
+        PTEST_SEPARATOR;
+
+        CALL_X2(generic::biquad_process_x2, 16);
+        IF_ARCH_X86(CALL_X2(sse::biquad_process_x2, 16));
+        IF_ARCH_X86(CALL_X2(avx::biquad_process_x2_fma3, 16));
+        IF_ARCH_AARCH64(CALL_X2(asimd::biquad_process_x2, 16));
+        CALL(generic::biquad_process_mc16, 16);
+        IF_ARCH_X86(CALL(sse::biquad_process_mc16, 16));
+        IF_ARCH_X86(CALL(avx::biquad_process_mc16, 16));
+        IF_ARCH_X86(CALL(avx::biquad_process_mc16_fma3, 16));
+        IF_ARCH_X86(CALL(avx512::biquad_process_mc16, 16));
+        CALL_P(generic::biquad_process_mc16_planar, 16);
+        IF_ARCH_X86(CALL_P(sse::biquad_process_mc16_planar, 16));
+        IF_ARCH_X86(CALL_P(avx::biquad_process_mc16_planar, 16));
+        IF_ARCH_X86(CALL_P(avx::biquad_process_mc16_planar_fma3, 16));
+        PTEST_SEPARATOR;
+
+        free_aligned(data);
+    }
+
+PTEST_END
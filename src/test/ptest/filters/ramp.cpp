@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 12 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define MIN_RANK        8
+#define MAX_RANK        14
+#define MAX_LANES       16
+
+namespace lsp
+{
+    /* The layout of all filter banks is the same: b0, b1, b2, a1 and a2 rows of coefficients, then padding */
+    typedef void (* ramp_biquad_process_t)(float *dst, const float *src, float *d, size_t count, const float *start, const float *end, float *buf);
+    typedef void (* dyn_biquad_process_t)(float *dst, const float *src, float *d, size_t count, const float *f);
+
+    static const float bq_start[]   = { 0.2f, 0.4f, 0.2f, 0.5f, -0.3f };
+    static const float bq_end[]     = { 0.6f, -0.4f, 0.1f, -0.2f, -0.1f };
+}
+
+//-----------------------------------------------------------------------------
+// Performance test for the dynamic filter with interpolated coefficients: the ramp
+// versus the filter applied to the explicitly built array of per-sample filters
+PTEST_BEGIN("dsp.filters", ramp, 5, 1000)
+
+    void init_bank(float *f, const float *bq, size_t lanes, size_t size)
+    {
+        for (size_t i=0; i<5; ++i)
+            for (size_t j=0; j<lanes; ++j)
+                f[i*lanes + j]  = bq[i];
+        for (size_t i=lanes*5; i<size; ++i)
+            f[i]            = 0.0f;
+    }
+
+    void interpolate(float *dst, const float *start, const float *end, size_t lanes, size_t size, size_t count)
+    {
+        const size_t rows   = count + lanes - 1;
+        const float k       = 1.0f / count;
+
+        for (size_t r=0; r<rows; ++r, dst += size)
+        {
+            for (size_t j=0; j<lanes; ++j)
+            {
+                float t         = (ssize_t(r) - ssize_t(j)) * k;
+                t               = lsp_limit(t, 0.0f, 1.0f);
+                for (size_t i=0; i<5; ++i)
+                    dst[i*lanes + j]    = start[i*lanes + j] + (end[i*lanes + j] - start[i*lanes + j]) * t;
+            }
+            for (size_t i=lanes*5; i<size; ++i)
+                dst[i]          = 0.0f;
+        }
+    }
+
+    void call(const char *label, float *dst, const float *src, size_t count,
+        size_t lanes, size_t size, float *f, ramp_biquad_process_t process)
+    {
+        char buf[80];
+        sprintf(buf, "%s x %d", label, int(count));
+        printf("Testing %s samples ...\n", buf);
+
+        float d[LSP_DSP_BIQUAD16_D_ITEMS] __lsp_aligned64;
+        float fs[MAX_LANES * 5] __lsp_aligned64;
+        float fe[MAX_LANES * 5] __lsp_aligned64;
+        for (size_t i=0; i<LSP_DSP_BIQUAD16_D_ITEMS; ++i)
+            d[i]        = 0.0f;
+        init_bank(fs, bq_start, lanes, lanes * 5);
+        init_bank(fe, bq_end, lanes, lanes * 5);
+
+        PTEST_LOOP(buf,
+            process(dst, src, d, count, fs, fe, f);
+        );
+    }
+
+    void call(const char *label, float *dst, const float *src, size_t count,
+        size_t lanes, size_t size, float *f, dyn_biquad_process_t process)
+    {
+        char buf[80];
+        sprintf(buf, "%s x %d", label, int(count));
+        printf("Testing %s samples ...\n", buf);
+
+        float d[LSP_DSP_BIQUAD16_D_ITEMS] __lsp_aligned64;
+        float fs[MAX_LANES * 5] __lsp_aligned64;
+        float fe[MAX_LANES * 5] __lsp_aligned64;
+        for (size_t i=0; i<LSP_DSP_BIQUAD16_D_ITEMS; ++i)
+            d[i]        = 0.0f;
+        init_bank(fs, bq_start, lanes, lanes * 5);
+        init_bank(fe, bq_end, lanes, lanes * 5);
+
+        // The array of filters is built for each sample of the ramp and then processed
+        PTEST_LOOP(buf,
+            interpolate(f, fs, fe, lanes, size, count);
+            process(dst, src, d, count, f);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        size_t count    = 1 << MAX_RANK;
+        size_t rows     = count + MAX_LANES - 1;
+
+        uint8_t *data   = NULL;
+        float *src      = alloc_aligned<float>(data, count * 2 + rows * sizeof(dsp::biquad_x16_t) / sizeof(float), 64);
+        float *dst      = &src[count];
+        float *f        = &dst[count];
+
+        for (size_t i=0; i<count; ++i)
+            src[i]          = float(rand()) / RAND_MAX;
+
+        #define CALL(lanes) \
+            call("ramp_biquad_process_x" #lanes, dst, src, n, lanes, sizeof(dsp::biquad_x##lanes##_t) / sizeof(float), f, \
+                reinterpret_cast<ramp_biquad_process_t>(dsp::ramp_biquad_process_x##lanes)); \
+            call("interpolate + dyn_biquad_process_x" #lanes, dst, src, n, lanes, sizeof(dsp::biquad_x##lanes##_t) / sizeof(float), f, \
+                reinterpret_cast<dyn_biquad_process_t>(dsp::dyn_biquad_process_x##lanes)); \
+            PTEST_SEPARATOR;
+
+        for (size_t i=MIN_RANK; i <= MAX_RANK; i += 2)
+        {
+            size_t n        = 1 << i;
+
+            CALL(1);
+            CALL(2);
+            CALL(4);
+            CALL(8);
+            CALL(16);
+            PTEST_SEPARATOR2;
+        }
+
+        free_aligned(data);
+    }
+
+PTEST_END
@@ -33,6 +33,10 @@ namespace lsp
         void biquad_process_x2(float *dst, const float *src, size_t count, dsp::biquad_t *f);
         void biquad_process_x4(float *dst, const float *src, size_t count, dsp::biquad_t *f);
         void biquad_process_x8(float *dst, const float *src, size_t count, dsp::biquad_t *f);
+        void biquad_process_x16(float *dst, const float *src, size_t count, dsp::biquad16_t *f);
+
+        void biquad_block_init(dsp::biquad_block_t *dst, const dsp::biquad_x1_t *src, size_t n);
+        void biquad_block_process(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n);
     }
 
     IF_ARCH_X86(
@@ -42,6 +46,8 @@ namespace lsp
             void biquad_process_x2(float *dst, const float *src, size_t count, dsp::biquad_t *f);
             void biquad_process_x4(float *dst, const float *src, size_t count, dsp::biquad_t *f);
             void biquad_process_x8(float *dst, const float *src, size_t count, dsp::biquad_t *f);
+
+            void biquad_block_process(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n);
         }
 
         namespace sse3
@@ -62,6 +68,17 @@ namespace lsp
 
             void x64_biquad_process_x8(float *dst, const float *src, size_t count, dsp::biquad_t *f);
             void biquad_process_x8_fma3(float *dst, const float *src, size_t count, dsp::biquad_t *f);
+
+            void biquad_process_x16(float *dst, const float *src, size_t count, dsp::biquad16_t *f);
+            void biquad_process_x16_fma3(float *dst, const float *src, size_t count, dsp::biquad16_t *f);
+
+            void biquad_block_process(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n);
+            void biquad_block_process_fma3(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n);
+        }
+
+        namespace avx512
+        {
+            void biquad_process_x16(float *dst, const float *src, size_t count, dsp::biquad16_t *f);
         }
     )
 
@@ -86,6 +103,8 @@ namespace lsp
     )
 
     typedef void (* biquad_process_t)(float *dst, const float *src, size_t count, dsp::biquad_t *f);
+    typedef void (* biquad16_process_t)(float *dst, const float *src, size_t count, dsp::biquad16_t *f);
+    typedef void (* biquad_block_process_t)(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n);
 
     static dsp::biquad_x1_t bq_normal = {
         1.0, 2.0, 1.0,
@@ -121,6 +140,25 @@ PTEST_BEGIN("dsp.filters", static, 10, 1000)
         );
     }
 
+    void process_8xblock(const char *text, float *out, const float *in, size_t count, biquad_block_process_t process)
+    {
+        if (!PTEST_SUPPORTED(process))
+            return;
+
+        printf("Testing %s static filters on input buffer of %d samples ...\n", text, int(count));
+
+        dsp::biquad_x1_t bq[8];
+        dsp::biquad_block_t f[8] __lsp_aligned64;
+
+        for (size_t i=0; i<8; ++i)
+            bq[i]           = bq_normal;
+        generic::biquad_block_init(f, bq, 8);
+
+        PTEST_LOOP(text,
+            process(out, in, count, f, 8);
+        );
+    }
+
     void process_4x2(const char *text, float *out, const float *in, size_t count, biquad_process_t process)
     {
         if (!PTEST_SUPPORTED(process))
@@ -203,6 +241,57 @@ PTEST_BEGIN("dsp.filters", static, 10, 1000)
         );
     }
 
+    void process_2x8(const char *text, float *out, const float *in, size_t count, biquad_process_t process)
+    {
+        if (!PTEST_SUPPORTED(process))
+            return;
+        printf("Testing %s static filters on input buffer of %d samples ...\n", text, int(count));
+
+        dsp::biquad_t f __lsp_aligned64;
+        // Filters x 8
+        for (size_t i=0; i<8; ++i)
+        {
+            f.x8.b0[i]     = bq_normal.b0;
+            f.x8.b1[i]     = bq_normal.b1;
+            f.x8.b2[i]     = bq_normal.b2;
+            f.x8.a1[i]     = bq_normal.a1;
+            f.x8.a2[i]     = bq_normal.a2;
+        }
+
+        for (size_t i=0; i<8; ++i)
+            f.d[i]          = 0.0f;
+
+        PTEST_LOOP(text,
+            process(out, in, count, &f);
+            process(out, out, count, &f);
+        );
+    }
+
+    void process_1x16(const char *text, float *out, const float *in, size_t count, biquad16_process_t process)
+    {
+        if (!PTEST_SUPPORTED(process))
+            return;
+        printf("Testing %s static filters on input buffer of %d samples ...\n", text, int(count));
+
+        dsp::biquad16_t f __lsp_aligned64;
+        // Filters x 16
+        for (size_t i=0; i<16; ++i)
+        {
+            f.x16.b0[i]    = bq_normal.b0;
+            f.x16.b1[i]    = bq_normal.b1;
+            f.x16.b2[i]    = bq_normal.b2;
+            f.x16.a1[i]    = bq_normal.a1;
+            f.x16.a2[i]    = bq_normal.a2;
+        }
+
+        for (size_t i=0; i<LSP_DSP_BIQUAD16_D_ITEMS; ++i)
+            f.d[i]          = 0.0f;
+
+        PTEST_LOOP(text,
+            process(out, in, count, &f);
+        );
+    }
+
     PTEST_MAIN
     {
         float *out          = new float[FTEST_BUF_SIZE];
@@ -222,6 +311,12 @@ PTEST_BEGIN("dsp.filters", static, 10, 1000)
         IF_ARCH_AARCH64(process_8x1("asimd::biquad_process_x1 x8", out, in, FTEST_BUF_SIZE, asimd::biquad_process_x1));
         PTEST_SEPARATOR;
 
+        process_8xblock("generic::biquad_block_process x8", out, in, FTEST_BUF_SIZE, generic::biquad_block_process);
+        IF_ARCH_X86(process_8xblock("sse::biquad_block_process x8", out, in, FTEST_BUF_SIZE, sse::biquad_block_process));
+        IF_ARCH_X86(process_8xblock("avx::biquad_block_process x8", out, in, FTEST_BUF_SIZE, avx::biquad_block_process));
+        IF_ARCH_X86(process_8xblock("avx::biquad_block_process_fma3 x8", out, in, FTEST_BUF_SIZE, avx::biquad_block_process_fma3));
+        PTEST_SEPARATOR;
+
         process_4x2("generic::biquad_process_x2 x4", out, in, FTEST_BUF_SIZE, generic::biquad_process_x2);
         IF_ARCH_X86(process_4x2("sse::biquad_process_x2 x4", out, in, FTEST_BUF_SIZE, sse::biquad_process_x2));
         IF_ARCH_X86(process_4x2("avx::biquad_process_x2 x4", out, in, FTEST_BUF_SIZE, avx::biquad_process_x2));
@@ -247,6 +342,15 @@ PTEST_BEGIN("dsp.filters", static, 10, 1000)
         IF_ARCH_AARCH64(process_1x8("asimd::biquad_process_x8 x1", out, in, FTEST_BUF_SIZE, asimd::biquad_process_x8));
         PTEST_SEPARATOR;
 
+        process_2x8("generic::biquad_process_x8 x2", out, in, FTEST_BUF_SIZE, generic::biquad_process_x8);
+        IF_ARCH_X86(process_2x8("avx::x64_biquad_process_x8 x2", out, in, FTEST_BUF_SIZE, avx::x64_biquad_process_x8));
+        IF_ARCH_X86(process_2x8("avx::biquad_process_x8_fma3 x2", out, in, FTEST_BUF_SIZE, avx::biquad_process_x8_fma3));
+        process_1x16("generic::biquad_process_x16 x1", out, in, FTEST_BUF_SIZE, generic::biquad_process_x16);
+        IF_ARCH_X86(process_1x16("avx::biquad_process_x16 x1", out, in, FTEST_BUF_SIZE, avx::biquad_process_x16));
+        IF_ARCH_X86(process_1x16("avx::biquad_process_x16_fma3 x1", out, in, FTEST_BUF_SIZE, avx::biquad_process_x16_fma3));
+        IF_ARCH_X86(process_1x16("avx512::biquad_process_x16 x1", out, in, FTEST_BUF_SIZE, avx512::biquad_process_x16));
+        PTEST_SEPARATOR;
+
         delete [] out;
         delete [] in;
     }
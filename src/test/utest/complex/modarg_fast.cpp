@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 3 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define MOD_TOLERANCE       4e-4f
+#define ARG_TOLERANCE       2e-5f
+
+namespace lsp
+{
+    namespace generic
+    {
+        void complex_cvt2modarg_fast(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count);
+        void complex_arg_fast(float *dst, const float *re, const float *im, size_t count);
+        void pcomplex_modarg_fast(float *mod, float *arg, const float *src, size_t count);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void complex_cvt2modarg_fast(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count);
+            void complex_arg_fast(float *dst, const float *re, const float *im, size_t count);
+            void pcomplex_modarg_fast(float *mod, float *arg, const float *src, size_t count);
+        }
+
+        namespace avx
+        {
+            void complex_cvt2modarg_fast(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count);
+            void complex_cvt2modarg_fast_fma3(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count);
+            void complex_arg_fast(float *dst, const float *re, const float *im, size_t count);
+            void complex_arg_fast_fma3(float *dst, const float *re, const float *im, size_t count);
+            void pcomplex_modarg_fast(float *mod, float *arg, const float *src, size_t count);
+            void pcomplex_modarg_fast_fma3(float *mod, float *arg, const float *src, size_t count);
+        }
+
+        namespace avx512
+        {
+            void complex_cvt2modarg_fast(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count);
+            void complex_arg_fast(float *dst, const float *re, const float *im, size_t count);
+            void pcomplex_modarg_fast(float *mod, float *arg, const float *src, size_t count);
+        }
+    )
+}
+
+typedef void (* complex_modarg_t)(float *dst_mod, float *dst_arg, const float *src_re, const float *src_im, size_t count);
+typedef void (* complex_arg_t)(float *dst, const float *re, const float *im, size_t count);
+typedef void (* pcomplex_modarg_t)(float *mod, float *arg, const float *src, size_t count);
+
+UTEST_BEGIN("dsp.complex", modarg_fast)
+
+    void init_source(float *re, float *im, size_t count)
+    {
+        // Cover all octants, the axes and the zero
+        for (size_t i=0; i<count; ++i)
+        {
+            switch (i % 11)
+            {
+                case 3:     re[i] = 0.0f;  break;
+                case 7:     im[i] = 0.0f;  break;
+                case 9:     re[i] = 0.0f; im[i] = 0.0f; break;
+                case 10:    re[i] = -re[i]; im[i] = 0.0f; break;
+                default:    break;
+            }
+            if (i & 1)
+                re[i]   = -re[i];
+            if (i & 2)
+                im[i]   = -im[i];
+        }
+    }
+
+    ssize_t check_mod(const float *mod, const float *re, const float *im, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            double m    = sqrt(double(re[i]) * re[i] + double(im[i]) * im[i]);
+            if (fabs(mod[i] - m) > MOD_TOLERANCE * m)
+                return i;
+        }
+        return -1;
+    }
+
+    ssize_t check_arg(const float *arg, const float *re, const float *im, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            // The argument of zero is zero, the difference should be checked
+            // with respect to the wrap at +/- PI
+            double a    = ((re[i] == 0.0f) && (im[i] == 0.0f)) ? 0.0 : atan2(im[i], re[i]);
+            double d    = fabs(arg[i] - a);
+            if (lsp_min(d, 2.0 * M_PI - d) > ARG_TOLERANCE)
+                return i;
+        }
+        return -1;
+    }
+
+    void call(const char *text, size_t align, complex_modarg_t func)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        UTEST_FOREACH(count, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+                32, 33, 37, 48, 49, 64, 65, 0x3f, 100, 999, 0x1fff)
+        {
+            for (size_t mask=0; mask <= 0x0f; ++mask)
+            {
+                printf("Testing %s on input buffer of %d numbers, mask=0x%x...\n", text, int(count), int(mask));
+
+                FloatBuffer src_re(count, align, mask & 0x01);
+                FloatBuffer src_im(count, align, mask & 0x02);
+                init_source(src_re, src_im, count);
+                FloatBuffer dst_mod(count, align, mask & 0x04);
+                FloatBuffer dst_arg(count, align, mask & 0x08);
+
+                // Call functions
+                func(dst_mod, dst_arg, src_re, src_im, count);
+
+                UTEST_ASSERT_MSG(src_re.valid(), "Source buffer RE corrupted");
+                UTEST_ASSERT_MSG(src_im.valid(), "Source buffer IM corrupted");
+                UTEST_ASSERT_MSG(dst_mod.valid(), "Destination buffer MOD corrupted");
+                UTEST_ASSERT_MSG(dst_arg.valid(), "Destination buffer ARG corrupted");
+
+                // Compare buffers
+                ssize_t idx_mod = check_mod(dst_mod, src_re, src_im, count);
+                ssize_t idx_arg = check_arg(dst_arg, src_re, src_im, count);
+                if ((idx_mod >= 0) || (idx_arg >= 0))
+                {
+                    src_re.dump("src_re  ");
+                    src_im.dump("src_im  ");
+                    dst_mod.dump("dst_mod ");
+                    dst_arg.dump("dst_arg ");
+                    UTEST_FAIL_MSG("Output of functions for test '%s' differs at index mod=%d, arg=%d",
+                        text, int(idx_mod), int(idx_arg));
+                }
+            }
+        }
+    }
+
+    void call(const char *text, size_t align, complex_arg_t func)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        UTEST_FOREACH(count, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+                32, 33, 37, 48, 49, 64, 65, 0x3f, 100, 999, 0x1fff)
+        {
+            for (size_t mask=0; mask <= 0x07; ++mask)
+            {
+                printf("Testing %s on input buffer of %d numbers, mask=0x%x...\n", text, int(count), int(mask));
+
+                FloatBuffer src_re(count, align, mask & 0x01);
+                FloatBuffer src_im(count, align, mask & 0x02);
+                init_source(src_re, src_im, count);
+                FloatBuffer dst(count, align, mask & 0x04);
+
+                // Call functions
+                func(dst, src_re, src_im, count);
+
+                UTEST_ASSERT_MSG(src_re.valid(), "Source buffer RE corrupted");
+                UTEST_ASSERT_MSG(src_im.valid(), "Source buffer IM corrupted");
+                UTEST_ASSERT_MSG(dst.valid(), "Destination buffer corrupted");
+
+                // Compare buffers
+                ssize_t idx = check_arg(dst, src_re, src_im, count);
+                if (idx >= 0)
+                {
+                    src_re.dump("src_re");
+                    src_im.dump("src_im");
+                    dst.dump("dst   ");
+                    UTEST_FAIL_MSG("Output of functions for test '%s' differs at index %d", text, int(idx));
+                }
+            }
+        }
+    }
+
+    void call(const char *text, size_t align, pcomplex_modarg_t func)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        UTEST_FOREACH(count, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+                32, 33, 37, 48, 49, 64, 65, 0x3f, 100, 999, 0x1fff)
+        {
+            for (size_t mask=0; mask <= 0x07; ++mask)
+            {
+                printf("Testing %s on input buffer of %d numbers, mask=0x%x...\n", text, int(count), int(mask));
+
+                FloatBuffer src_re(count, align, true);
+                FloatBuffer src_im(count, align, true);
+                init_source(src_re, src_im, count);
+                FloatBuffer src(count*2, align, mask & 0x01);
+                for (size_t i=0; i<count; ++i)
+                {
+                    src[i*2]        = src_re[i];
+                    src[i*2 + 1]    = src_im[i];
+                }
+                FloatBuffer dst_mod(count, align, mask & 0x02);
+                FloatBuffer dst_arg(count, align, mask & 0x04);
+
+                // Call functions
+                func(dst_mod, dst_arg, src, count);
+
+                UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+                UTEST_ASSERT_MSG(dst_mod.valid(), "Destination buffer MOD corrupted");
+                UTEST_ASSERT_MSG(dst_arg.valid(), "Destination buffer ARG corrupted");
+
+                // Compare buffers
+                ssize_t idx_mod = check_mod(dst_mod, src_re, src_im, count);
+                ssize_t idx_arg = check_arg(dst_arg, src_re, src_im, count);
+                if ((idx_mod >= 0) || (idx_arg >= 0))
+                {
+                    src_re.dump("src_re  ");
+                    src_im.dump("src_im  ");
+                    dst_mod.dump("dst_mod ");
+                    dst_arg.dump("dst_arg ");
+                    UTEST_FAIL_MSG("Output of functions for test '%s' differs at index mod=%d, arg=%d",
+                        text, int(idx_mod), int(idx_arg));
+                }
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        #define CALL(func, align) \
+            call(#func, align, func)
+
+        CALL(generic::complex_cvt2modarg_fast, 16);
+        IF_ARCH_X86(CALL(sse::complex_cvt2modarg_fast, 16));
+        IF_ARCH_X86(CALL(avx::complex_cvt2modarg_fast, 32));
+        IF_ARCH_X86(CALL(avx::complex_cvt2modarg_fast_fma3, 32));
+        IF_ARCH_X86(CALL(avx512::complex_cvt2modarg_fast, 64));
+
+        CALL(generic::complex_arg_fast, 16);
+        IF_ARCH_X86(CALL(sse::complex_arg_fast, 16));
+        IF_ARCH_X86(CALL(avx::complex_arg_fast, 32));
+        IF_ARCH_X86(CALL(avx::complex_arg_fast_fma3, 32));
+        IF_ARCH_X86(CALL(avx512::complex_arg_fast, 64));
+
+        CALL(generic::pcomplex_modarg_fast, 16);
+        IF_ARCH_X86(CALL(sse::pcomplex_modarg_fast, 16));
+        IF_ARCH_X86(CALL(avx::pcomplex_modarg_fast, 32));
+        IF_ARCH_X86(CALL(avx::pcomplex_modarg_fast_fma3, 32));
+        IF_ARCH_X86(CALL(avx512::pcomplex_modarg_fast, 64));
+    }
+
+UTEST_END
@@ -41,6 +41,18 @@ namespace lsp
             void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
             void convolve_fma3(float *dst, const float *src, const float *conv, size_t length, size_t count);
         }
+
+        namespace avx512
+        {
+            void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+        }
+    )
+
+    IF_ARCH_X86_64(
+        namespace avx512
+        {
+            void x64_convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+        }
     )
 
     IF_ARCH_ARM(
@@ -135,6 +147,8 @@ UTEST_BEGIN("dsp", convolve)
         IF_ARCH_X86(CALL(sse::convolve, 16));
         IF_ARCH_X86(CALL(avx::convolve, 32));
         IF_ARCH_X86(CALL(avx::convolve_fma3, 32));
+        IF_ARCH_X86(CALL(avx512::convolve, 64));
+        IF_ARCH_X86_64(CALL(avx512::x64_convolve, 64));
         IF_ARCH_ARM(CALL(neon_d32::convolve, 16));
         IF_ARCH_AARCH64(CALL(asimd::convolve, 16));
     }
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 27 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define MAX_KERNELS     8
+
+namespace lsp
+{
+    namespace generic
+    {
+        void convolve_multi(float * const *dst, const float *src, const float * const *conv, size_t length, size_t count, size_t n);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void convolve_multi(float * const *dst, const float *src, const float * const *conv, size_t length, size_t count, size_t n);
+        }
+
+        namespace avx
+        {
+            void convolve_multi(float * const *dst, const float *src, const float * const *conv, size_t length, size_t count, size_t n);
+            void convolve_multi_fma3(float * const *dst, const float *src, const float * const *conv, size_t length, size_t count, size_t n);
+        }
+    )
+
+    typedef void (* convolve_multi_t)(float * const *dst, const float *src, const float * const *conv, size_t length, size_t count, size_t n);
+}
+
+UTEST_BEGIN("dsp", convolve_multi)
+    void call(const char *label, size_t align, convolve_multi_t func)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        UTEST_FOREACH(count, 0, 1, 3, 4, 5, 8, 16, 33, 64, 0x81)
+        {
+            FloatBuffer src(count, align, false);
+
+            UTEST_FOREACH(length, 0, 1, 3, 4, 7, 16, 33, 64)
+            {
+                UTEST_FOREACH(n, 0, 1, 3, MAX_KERNELS)
+                {
+                    printf("Testing %s convolution length=%d on buffer count=%d for %d convolutions\n",
+                        label, int(length), int(count), int(n));
+
+                    size_t clen = (count + length > 0) ? count + length - 1 : 0;
+                    FloatBuffer conv(length * MAX_KERNELS, align, false);
+                    FloatBuffer dst1(clen * MAX_KERNELS, align, false);
+                    FloatBuffer dst2(dst1);
+                    const float *vc[MAX_KERNELS];
+                    float *vd[MAX_KERNELS];
+
+                    // Reference: separate convolution with each kernel
+                    for (size_t i=0; i<n; ++i)
+                    {
+                        vc[i]       = &conv[i * length];
+                        vd[i]       = &dst2[i * clen];
+                        float *d    = &dst1[i * clen];
+                        for (size_t j=0; j<count; ++j)
+                            for (size_t k=0; k<length; ++k)
+                                d[j + k]   += src[j] * vc[i][k];
+                    }
+
+                    func(vd, src, vc, length, count, n);
+
+                    UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+                    UTEST_ASSERT_MSG(conv.valid(), "Convolution buffer corrupted");
+                    UTEST_ASSERT_MSG(dst1.valid(), "Destination buffer 1 corrupted");
+                    UTEST_ASSERT_MSG(dst2.valid(), "Destination buffer 2 corrupted");
+
+                    // Compare buffers
+                    if (!dst1.equals_relative(dst2, 1e-5))
+                    {
+                        src.dump("src ");
+                        conv.dump("conv");
+                        dst1.dump("dst1");
+                        dst2.dump("dst2");
+                        UTEST_FAIL_MSG("Output of functions for test '%s' differs", label);
+                    }
+                }
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        #define CALL(func, align) \
+            call(#func, align, func)
+
+        CALL(generic::convolve_multi, 16);
+        IF_ARCH_X86(CALL(sse::convolve_multi, 16));
+        IF_ARCH_X86(CALL(avx::convolve_multi, 32));
+        IF_ARCH_X86(CALL(avx::convolve_multi_fma3, 32));
+    }
+
+UTEST_END;
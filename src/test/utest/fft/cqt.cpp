@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 1 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define TOLERANCE       1e-4
+#define MAX_BINS        67
+#define SPECTRUM_SIZE   0x200
+#define SAMPLE_RATE     48000
+
+namespace lsp
+{
+    namespace generic
+    {
+        void cqt_kernel_apply(float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void cqt_kernel_apply(float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins);
+        }
+
+        namespace avx
+        {
+            void cqt_kernel_apply(float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins);
+            void cqt_kernel_apply_fma3(float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins);
+        }
+    )
+
+    typedef void (* cqt_kernel_apply_t)(float *dst, const float *src, const float *kernel, const uint32_t *band, size_t bins);
+}
+
+UTEST_BEGIN("dsp.fft", cqt)
+
+    void call(const char *label, size_t align, cqt_kernel_apply_t func)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        uint32_t band[MAX_BINS * 2];
+
+        for (size_t bins=1; bins<=MAX_BINS; bins += (bins < 20) ? 1 : 7)
+        {
+            printf("Testing %s on %d bins...\n", label, int(bins));
+
+            // Bands of all lengths at arbitrary positions of the spectrum
+            size_t nonzero  = 0;
+            for (size_t i=0; i<bins; ++i)
+            {
+                size_t count    = (i * 13 + bins) % 71;
+                band[i*2]       = (i * 37 + bins * 5) % (SPECTRUM_SIZE - count);
+                band[i*2 + 1]   = count;
+                nonzero        += count;
+            }
+
+            FloatBuffer src(SPECTRUM_SIZE * 2, align, false);
+            FloatBuffer kernel(nonzero * 2, align, false);
+            FloatBuffer dst1(bins * 2, align, false);
+            FloatBuffer dst2(dst1);
+
+            generic::cqt_kernel_apply(dst1, src, kernel, band, bins);
+            func(dst2, src, kernel, band, bins);
+
+            UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+            UTEST_ASSERT_MSG(kernel.valid(), "Kernel buffer corrupted");
+            UTEST_ASSERT_MSG(dst1.valid(), "Destination buffer 1 corrupted");
+            UTEST_ASSERT_MSG(dst2.valid(), "Destination buffer 2 corrupted");
+
+            if (!dst1.equals_absolute(dst2, TOLERANCE))
+            {
+                dst1.dump("dst1");
+                dst2.dump("dst2");
+                UTEST_FAIL_MSG("Output of functions for test '%s' differs at element %d",
+                    label, int(dst1.last_diff()));
+            }
+        }
+    }
+
+    void test_kernel(size_t rank, size_t bins_per_octave, float fmin)
+    {
+        const size_t n  = 1 << rank;
+        const size_t sz = dsp::cqt_kernel_buffer_size(rank, bins_per_octave, SAMPLE_RATE, fmin);
+        UTEST_ASSERT(sz > 0);
+
+        FloatBuffer buf(sz, 64, true);
+        FloatBuffer src(n + 2, 16, true);
+        dsp::cqt_kernel_t k;
+
+        UTEST_ASSERT(dsp::cqt_kernel_init(&k, buf, rank, bins_per_octave, SAMPLE_RATE, fmin));
+        UTEST_ASSERT(dsp::cqt_kernel_match(&k, rank, bins_per_octave, SAMPLE_RATE, fmin));
+        UTEST_ASSERT(!dsp::cqt_kernel_match(&k, rank + 1, bins_per_octave, SAMPLE_RATE, fmin));
+        UTEST_ASSERT(!dsp::cqt_kernel_match(&k, rank, bins_per_octave, SAMPLE_RATE * 2, fmin));
+        UTEST_ASSERT(k.bins > 0);
+        UTEST_ASSERT((fmin <= 0.0f) || (float_equals_relative(k.freqs[0], fmin)));
+        UTEST_ASSERT(k.freqs[k.bins - 1] < SAMPLE_RATE * 0.5f);
+        UTEST_ASSERT(k.freqs[k.bins - 1] * powf(2.0f, 1.0f / bins_per_octave) >= SAMPLE_RATE * 0.5f * 0.9999f);
+
+        printf("Testing constant-Q transform for rank=%d, bins per octave=%d, fmin=%.2f: %d bins, %d non-zero elements\n",
+            int(rank), int(bins_per_octave), k.fmin, int(k.bins), int(k.nonzero));
+
+        FloatBuffer dst(k.bins * 2, 16, true);
+
+        // The transform of the sine wave at the frequency of the bin: amplitude of 0.5, the phase
+        // referenced to the last sample, low leakage into the bins one octave away
+        for (size_t i=0; i<k.bins; i += (i < bins_per_octave) ? 1 : 5)
+        {
+            const double f      = k.freqs[i] / double(SAMPLE_RATE);
+            if (f > 0.4)
+                break;
+            const double phase  = 0.1 * (i % 30) - 1.5;
+
+            for (size_t j=0; j<n; ++j)
+                src[j]              = cos(2.0 * M_PI * f * (ssize_t(j) - ssize_t(n - 1)) + phase);
+            dsp::cqt_process(&k, dst, src, src);
+
+            UTEST_ASSERT_MSG(buf.valid(), "Kernel buffer corrupted");
+            UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+            UTEST_ASSERT_MSG(dst.valid(), "Destination buffer corrupted");
+
+            const float re      = dst[i*2];
+            const float im      = dst[i*2 + 1];
+            const float a       = sqrtf(re * re + im * im);
+            const float p       = atan2f(im, re);
+
+            UTEST_ASSERT_MSG(float_equals_absolute(a, 0.5f, 5e-3f),
+                "Invalid amplitude of bin %d (%.2f Hz): %f", int(i), k.freqs[i], a);
+            UTEST_ASSERT_MSG(float_equals_absolute(p, phase, 1e-2f),
+                "Invalid phase of bin %d (%.2f Hz): %f, expected %f", int(i), k.freqs[i], p, phase);
+
+            for (ssize_t j = ssize_t(i) - bins_per_octave; j <= ssize_t(i + bins_per_octave); j += bins_per_octave * 2)
+            {
+                if ((j < 0) || (j >= ssize_t(k.bins)))
+                    continue;
+                const size_t n  = size_t(j) * 2;
+                const float l   = sqrtf(dst[n] * dst[n] + dst[n + 1] * dst[n + 1]);
+                UTEST_ASSERT_MSG(l < 5e-3f,
+                    "Leakage of bin %d (%.2f Hz) into bin %d (%.2f Hz): %f", int(i), k.freqs[i], int(j), k.freqs[size_t(j)], l);
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        // Validation of parameters
+        dsp::cqt_kernel_t k;
+        UTEST_ASSERT(dsp::cqt_kernel_buffer_size(3, 12, SAMPLE_RATE, 0.0f) == 0);
+        UTEST_ASSERT(dsp::cqt_kernel_buffer_size(12, 0, SAMPLE_RATE, 0.0f) == 0);
+        UTEST_ASSERT(dsp::cqt_kernel_buffer_size(12, 12, 0, 0.0f) == 0);
+        UTEST_ASSERT(dsp::cqt_kernel_buffer_size(12, 12, SAMPLE_RATE, 20.0f) == 0);
+        UTEST_ASSERT(dsp::cqt_kernel_buffer_size(12, 12, SAMPLE_RATE, SAMPLE_RATE * 0.5f) == 0);
+        UTEST_ASSERT(!dsp::cqt_kernel_init(&k, NULL, 12, 12, SAMPLE_RATE, 20.0f));
+
+        // Sparse matrix multiplication
+        call("generic::cqt_kernel_apply", 16, generic::cqt_kernel_apply);
+        IF_ARCH_X86(call("sse::cqt_kernel_apply", 16, sse::cqt_kernel_apply));
+        IF_ARCH_X86(call("avx::cqt_kernel_apply", 32, avx::cqt_kernel_apply));
+        IF_ARCH_X86(call("avx::cqt_kernel_apply_fma3", 32, avx::cqt_kernel_apply_fma3));
+
+        // Transform
+        test_kernel(10, 12, 0.0f);
+        test_kernel(12, 12, 0.0f);
+        test_kernel(12, 24, 1000.0f);
+        test_kernel(14, 24, 0.0f);
+        test_kernel(14, 48, 440.0f);
+        test_kernel(16, 36, 55.0f);
+    }
+
+UTEST_END
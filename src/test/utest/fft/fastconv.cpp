@@ -24,9 +24,11 @@
 #include <lsp-plug.in/test-fw/utest.h>
 #include <lsp-plug.in/test-fw/FloatBuffer.h>
 
-#define MIN_RANK    6
-#define MAX_RANK    12
-#define TOLERANCE   5e-2
+#define MIN_RANK        6
+#define MAX_RANK        12
+#define TOLERANCE       5e-2
+#define MIN_MAC_RANK    3
+#define MAX_MAC_N       20
 
 namespace lsp
 {
@@ -36,6 +38,7 @@ namespace lsp
         void fastconv_parse_apply(float *dst, float *tmp, const float *c, const float *src, size_t rank);
         void fastconv_restore(float *dst, float *src, size_t rank);
         void fastconv_apply(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+        void fastconv_mac_n(float *dst, const float * const *spectra, const float * const *kernels, size_t n, size_t rank);
     }
 
     IF_ARCH_X86(
@@ -58,6 +61,18 @@ namespace lsp
             void fastconv_parse_apply_fma3(float *dst, float *tmp, const float *c, const float *src, size_t rank);
             void fastconv_restore_fma3(float *dst, float *src, size_t rank);
             void fastconv_apply_fma3(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+
+            void fastconv_mac_n(float *dst, const float * const *spectra, const float * const *kernels, size_t n, size_t rank);
+            void fastconv_mac_n_fma3(float *dst, const float * const *spectra, const float * const *kernels, size_t n, size_t rank);
+        }
+
+        namespace avx512
+        {
+            void fastconv_parse(float *dst, const float *src, size_t rank);
+            void fastconv_parse_apply(float *dst, float *tmp, const float *c, const float *src, size_t rank);
+            void fastconv_restore(float *dst, float *src, size_t rank);
+            void fastconv_apply(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+            void fastconv_mac_n(float *dst, const float * const *spectra, const float * const *kernels, size_t n, size_t rank);
         }
     )
 
@@ -90,6 +105,8 @@ typedef void (* fastconv_restore_t)(float *dst, float *src, size_t rank);
 
 typedef void (* fastconv_apply_t)(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
 
+typedef void (* fastconv_mac_n_t)(float *dst, const float * const *spectra, const float * const *kernels, size_t n, size_t rank);
+
 UTEST_BEGIN("dsp.fft", fastconv)
 
     // This is long-time test, raise time limit for it to one second
@@ -109,7 +126,7 @@ UTEST_BEGIN("dsp.fft", fastconv)
         {
             for (size_t mask=0; mask <= 0x07; ++mask)
             {
-                printf("Testing '%s' for FFT rank=%d, mask=0x%x\n", label, rank, mask);
+                printf("Testing '%s' for FFT rank=%d, mask=0x%x\n", label, int(rank), int(mask));
 
                 FloatBuffer src(1 << (rank-1), align, mask & 0x01);
                 FloatBuffer fc1(1 << (rank+1), align, mask & 0x02);
@@ -164,7 +181,7 @@ UTEST_BEGIN("dsp.fft", fastconv)
         {
             for (size_t mask=0; mask <= 0x3f; ++mask)
             {
-                printf("Testing '%s' for FFT rank=%d, mask=0x%x\n", label, rank, mask);
+                printf("Testing '%s' for FFT rank=%d, mask=0x%x\n", label, int(rank), int(mask));
 
                 FloatBuffer src1(1 << (rank-1), align, mask & 0x01);
                 FloatBuffer src2(1 << (rank-1), align, mask & 0x02);
@@ -241,7 +258,7 @@ UTEST_BEGIN("dsp.fft", fastconv)
         {
             for (size_t mask=0; mask <= 0x1f; ++mask)
             {
-                printf("Testing '%s' for FFT rank=%d, mask=0x%x\n", label, rank, mask);
+                printf("Testing '%s' for FFT rank=%d, mask=0x%x\n", label, int(rank), int(mask));
 
                 FloatBuffer src1(1 << (rank-1), align, mask & 0x01);
                 FloatBuffer src2(1 << (rank-1), align, mask & 0x02);
@@ -297,26 +314,105 @@ UTEST_BEGIN("dsp.fft", fastconv)
         }
     }
 
+    void call_mac(const char *label, size_t align,
+            fastconv_parse_t parse,
+            fastconv_restore_t restore,
+            fastconv_apply_t apply,
+            fastconv_mac_n_t mac
+        )
+    {
+        static const size_t counts[] = { 0, 1, 3, 8, 9, 20 };
+
+        if (!UTEST_SUPPORTED(parse))
+            return;
+        if (!UTEST_SUPPORTED(restore))
+            return;
+        if (!UTEST_SUPPORTED(apply))
+            return;
+        if (!UTEST_SUPPORTED(mac))
+            return;
+
+        for (size_t rank=MIN_MAC_RANK; rank<=MAX_RANK; rank ++)
+        {
+            for (size_t ci=0; ci < sizeof(counts)/sizeof(size_t); ++ci)
+            {
+                const size_t n  = counts[ci];
+                const size_t fc = 1 << (rank+1);
+                printf("Testing '%s' for FFT rank=%d, n=%d\n", label, int(rank), int(n));
+
+                FloatBuffer src(1 << (rank-1), align, false);
+                FloatBuffer fa(fc * MAX_MAC_N, align, false);
+                FloatBuffer fb(fc * MAX_MAC_N, align, false);
+                FloatBuffer spec(fc, align, false);
+                FloatBuffer tmp(fc, align, false);
+                FloatBuffer dst1(1 << rank, align, false);
+                FloatBuffer dst2(1 << rank, align, false);
+                const float *va[MAX_MAC_N], *vb[MAX_MAC_N];
+
+                // Reference: sum of results of fastconv_apply of each pair
+                dsp::fill_zero(dst1, dst1.size());
+                for (size_t i=0; i<n; ++i)
+                {
+                    src.randomize_sign();
+                    parse(&fa[fc * i], src, rank);
+                    src.randomize_sign();
+                    parse(&fb[fc * i], src, rank);
+                    va[i]           = &fa[fc * i];
+                    vb[i]           = &fb[fc * i];
+                    apply(dst1, tmp, va[i], vb[i], rank);
+                }
+
+                mac(spec, va, vb, n, rank);
+                UTEST_ASSERT_MSG(spec.valid(), "Buffer SPEC corrupted");
+                UTEST_ASSERT_MSG(fa.valid(), "Buffer FA corrupted");
+                UTEST_ASSERT_MSG(fb.valid(), "Buffer FB corrupted");
+                restore(dst2, spec, rank);
+                UTEST_ASSERT_MSG(dst2.valid(), "Buffer DST2 corrupted");
+
+                // Compare buffers
+                if (!dst1.equals_adaptive(dst2, TOLERANCE))
+                {
+                    dst1.dump("dst1");
+                    dst2.dump("dst2");
+
+                    ssize_t diff = dst2.last_diff();
+                    UTEST_FAIL_MSG("DST1 differs DST2 for test '%s' at sample %d (%.5f vs %.5f), rank=%d, n=%d",
+                            label, int(diff), dst1.get(diff), dst2.get(diff), int(rank), int(n));
+                }
+            }
+        }
+    }
+
     UTEST_MAIN
     {
         // Do tests
         IF_ARCH_X86(call_pr("sse::fastconv_parse + sse::fastconv_restore", 16, sse::fastconv_parse, sse::fastconv_restore));
         IF_ARCH_X86(call_pr("avx::fastconv_parse + avx::fastconv_restore", 32, avx::fastconv_parse, avx::fastconv_restore));
         IF_ARCH_X86(call_pr("avx::fastconv_parse_fma3 + avx::fastconv_restore_fma3", 32, avx::fastconv_parse_fma3, avx::fastconv_restore_fma3));
+        IF_ARCH_X86(call_pr("avx512::fastconv_parse + avx512::fastconv_restore", 64, avx512::fastconv_parse, avx512::fastconv_restore));
         IF_ARCH_ARM(call_pr("neon_d32::fastconv_parse + neon_d32::fastconv_restore", 16, neon_d32::fastconv_parse, neon_d32::fastconv_restore));
         IF_ARCH_AARCH64(call_pr("asimd::fastconv_parse + asimd::fastconv_restore", 16, asimd::fastconv_parse, asimd::fastconv_restore));
 
         IF_ARCH_X86(call_pa("sse::fastconv_parse + sse::fastconv_apply", 16, sse::fastconv_parse, sse::fastconv_apply));
         IF_ARCH_X86(call_pa("avx::fastconv_parse + avx::fastconv_apply", 32, avx::fastconv_parse, avx::fastconv_apply));
         IF_ARCH_X86(call_pa("avx::fastconv_parse_fma3 + avx::fastconv_apply_fma3", 32, avx::fastconv_parse_fma3, avx::fastconv_apply_fma3));
+        IF_ARCH_X86(call_pa("avx512::fastconv_parse + avx512::fastconv_apply", 64, avx512::fastconv_parse, avx512::fastconv_apply));
         IF_ARCH_ARM(call_pa("neon_d32::fastconv_parse + neon_d32::fastconv_apply", 16, neon_d32::fastconv_parse, neon_d32::fastconv_apply));
         IF_ARCH_AARCH64(call_pa("asimd::fastconv_parse + asimd::fastconv_apply", 16, asimd::fastconv_parse, asimd::fastconv_apply));
 
         IF_ARCH_X86(call_pap("sse::fastconv_parse + sse::fastconv_parse_apply", 16, sse::fastconv_parse, sse::fastconv_parse_apply));
         IF_ARCH_X86(call_pap("avx::fastconv_parse + avx::fastconv_parse_apply", 32, avx::fastconv_parse, avx::fastconv_parse_apply));
         IF_ARCH_X86(call_pap("avx::fastconv_parse_fma3 + avx::fastconv_parse_apply_fma3", 32, avx::fastconv_parse_fma3, avx::fastconv_parse_apply_fma3));
+        IF_ARCH_X86(call_pap("avx512::fastconv_parse + avx512::fastconv_parse_apply", 64, avx512::fastconv_parse, avx512::fastconv_parse_apply));
         IF_ARCH_ARM(call_pap("neon_d32::fastconv_parse + neon_d32::fastconv_parse_apply", 16, neon_d32::fastconv_parse, neon_d32::fastconv_parse_apply));
         IF_ARCH_AARCH64(call_pap("asimd::fastconv_parse + asimd::fastconv_parse_apply", 16, asimd::fastconv_parse, asimd::fastconv_parse_apply));
+        call_mac("generic::fastconv_mac_n", 16, generic::fastconv_parse, generic::fastconv_restore, generic::fastconv_apply, generic::fastconv_mac_n);
+        IF_ARCH_X86(call_mac("sse + generic::fastconv_mac_n", 16, sse::fastconv_parse, sse::fastconv_restore, sse::fastconv_apply, generic::fastconv_mac_n));
+        IF_ARCH_X86(call_mac("avx::fastconv_mac_n", 32, avx::fastconv_parse, avx::fastconv_restore, avx::fastconv_apply, avx::fastconv_mac_n));
+        IF_ARCH_X86(call_mac("avx::fastconv_mac_n_fma3", 32, avx::fastconv_parse_fma3, avx::fastconv_restore_fma3, avx::fastconv_apply_fma3, avx::fastconv_mac_n_fma3));
+        IF_ARCH_X86(call_mac("avx512::fastconv_mac_n", 64, avx512::fastconv_parse, avx512::fastconv_restore, avx512::fastconv_apply, avx512::fastconv_mac_n));
+        IF_ARCH_ARM(call_mac("neon_d32 + generic::fastconv_mac_n", 16, neon_d32::fastconv_parse, neon_d32::fastconv_restore, neon_d32::fastconv_apply, generic::fastconv_mac_n));
+        IF_ARCH_AARCH64(call_mac("asimd + generic::fastconv_mac_n", 16, asimd::fastconv_parse, asimd::fastconv_restore, asimd::fastconv_apply, generic::fastconv_mac_n));
     }
 UTEST_END;
 
@@ -25,6 +25,9 @@
 #include <lsp-plug.in/test-fw/FloatBuffer.h>
 
 #define TOLERANCE       5e-2
+#define MAX_RANK        16
+#define MAX_EXT_RANK    20
+#define EXT_TOLERANCE   1e-3
 
 namespace lsp
 {
@@ -49,6 +52,12 @@ namespace lsp
             void direct_fft_fma3(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
             void reverse_fft_fma3(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
         }
+
+        namespace avx512
+        {
+            void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+            void reverse_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        }
     )
 
     IF_ARCH_ARM(
@@ -74,6 +83,29 @@ UTEST_BEGIN("dsp.fft", fft)
 
     UTEST_TIMELIMIT(30)
 
+    // Large transforms are compared by the energy of the difference since
+    // the rounding errors are spread among all the samples
+    bool equals(FloatBuffer &a, FloatBuffer &b, size_t rank)
+    {
+        if (rank <= MAX_RANK)
+            return a.equals_adaptive(b, TOLERANCE);
+
+        double e_diff = 0.0, e_sig = 0.0;
+        for (size_t i=0, n=a.size(); i<n; ++i)
+        {
+            double d    = double(a[i]) - double(b[i]);
+            e_diff     += d * d;
+            e_sig      += double(a[i]) * double(a[i]);
+        }
+
+        if (e_diff <= e_sig * (EXT_TOLERANCE * EXT_TOLERANCE))
+            return true;
+
+        // Locate the differing sample for the report
+        a.equals_relative(b, EXT_TOLERANCE);
+        return false;
+    }
+
     void call(const char *label, size_t align, fft_t func1, fft_t func2)
     {
         if (!UTEST_SUPPORTED(func1))
@@ -83,10 +115,12 @@ UTEST_BEGIN("dsp.fft", fft)
 
         for (int same=0; same<2; ++same)
         {
-            for (size_t rank=6; rank<=16; ++rank)
+            for (size_t rank=6; rank<=MAX_EXT_RANK; ++rank)
             {
                 size_t count = 1 << rank;
-                for (size_t mask=0; mask <= 0x0f; ++mask)
+                // Large ranks are tested with aligned buffers only to save the time
+                size_t max_mask = (rank <= MAX_RANK) ? 0x0f : 0x00;
+                for (size_t mask=0; mask <= max_mask; ++mask)
                 {
                     FloatBuffer src_re(count, align, mask & 0x01);
                     FloatBuffer src_im(count, align, mask & 0x02);
@@ -121,7 +155,7 @@ UTEST_BEGIN("dsp.fft", fft)
                     UTEST_ASSERT_MSG(dst2_im.valid(), "Destination buffer 2 IM corrupted");
 
                     // Compare buffers
-                    if ((!dst1_re.equals_adaptive(dst2_re, TOLERANCE)) || (!dst1_im.equals_adaptive(dst2_im, TOLERANCE)))
+                    if ((!equals(dst1_re, dst2_re, rank)) || (!equals(dst1_im, dst2_im, rank)))
                     {
                         src_re.dump("src_re ");
                         src_im.dump("src_im ");
@@ -160,6 +194,8 @@ UTEST_BEGIN("dsp.fft", fft)
         IF_ARCH_X86(CALL(generic::reverse_fft, avx::reverse_fft, 32));
         IF_ARCH_X86(CALL(generic::direct_fft, avx::direct_fft_fma3, 32));
         IF_ARCH_X86(CALL(generic::reverse_fft, avx::reverse_fft_fma3, 32));
+        IF_ARCH_X86(CALL(generic::direct_fft, avx512::direct_fft, 64));
+        IF_ARCH_X86(CALL(generic::reverse_fft, avx512::reverse_fft, 64));
 
         IF_ARCH_ARM(CALL(generic::direct_fft, neon_d32::direct_fft, 16));
         IF_ARCH_ARM(CALL(generic::reverse_fft, neon_d32::reverse_fft, 16));
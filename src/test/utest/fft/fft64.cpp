@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define MAX_DFT_RANK    10
+#define MAX_RANK        20
+#define F64_TOLERANCE   1e-10
+#define MP_TOLERANCE    1e-3
+
+namespace lsp
+{
+    namespace generic
+    {
+        void direct_fft_f64(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+        void reverse_fft_f64(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+        void direct_fft_mp(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        void reverse_fft_mp(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+    }
+
+    IF_ARCH_X86(
+        namespace sse2
+        {
+            void direct_fft_f64(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+            void reverse_fft_f64(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+            void direct_fft_mp(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+            void reverse_fft_mp(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        }
+
+        namespace avx
+        {
+            void direct_fft_f64(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+            void reverse_fft_f64(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+            void direct_fft_mp(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+            void reverse_fft_mp(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+
+            void direct_fft_f64_fma3(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+            void reverse_fft_f64_fma3(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+            void direct_fft_mp_fma3(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+            void reverse_fft_mp_fma3(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        }
+    )
+}
+
+typedef void (* fft_f64_t)(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank);
+typedef void (* fft_mp_t)(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+
+UTEST_BEGIN("dsp.fft", fft64)
+
+    UTEST_TIMELIMIT(60)
+
+    void randomize(double *dst, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+            dst[i]      = randf(-1.0f, 1.0f) + randf(-1.0f, 1.0f) * 1e-7;
+    }
+
+    // Relative error of the energy of the difference between two signals
+    double error(const double *a_re, const double *a_im, const double *b_re, const double *b_im, size_t count)
+    {
+        double e_diff = 0.0, e_sig = 0.0;
+        for (size_t i=0; i<count; ++i)
+        {
+            double d_re = a_re[i] - b_re[i];
+            double d_im = a_im[i] - b_im[i];
+            e_diff     += d_re * d_re + d_im * d_im;
+            e_sig      += b_re[i] * b_re[i] + b_im[i] * b_im[i];
+        }
+
+        return (e_sig > 0.0) ? sqrt(e_diff / e_sig) : sqrt(e_diff);
+    }
+
+    double error(const float *a_re, const float *a_im, const double *b_re, const double *b_im, size_t count)
+    {
+        double e_diff = 0.0, e_sig = 0.0;
+        for (size_t i=0; i<count; ++i)
+        {
+            double d_re = a_re[i] - b_re[i];
+            double d_im = a_im[i] - b_im[i];
+            e_diff     += d_re * d_re + d_im * d_im;
+            e_sig      += b_re[i] * b_re[i] + b_im[i] * b_im[i];
+        }
+
+        return (e_sig > 0.0) ? sqrt(e_diff / e_sig) : sqrt(e_diff);
+    }
+
+    void dft(double *dst_re, double *dst_im, const double *src_re, const double *src_im, size_t rank, bool direct)
+    {
+        size_t count    = 1 << rank;
+        long double k   = (direct ? -2.0L : 2.0L) * M_PI / count;
+        long double n   = (direct) ? 1.0L : 1.0L / count;
+
+        for (size_t i=0; i<count; ++i)
+        {
+            long double re = 0.0L, im = 0.0L;
+            for (size_t j=0; j<count; ++j)
+            {
+                long double a   = k * ((i * j) & (count - 1));
+                long double c   = cosl(a), s = sinl(a);
+                re             += src_re[j] * c - src_im[j] * s;
+                im             += src_re[j] * s + src_im[j] * c;
+            }
+            dst_re[i]       = re * n;
+            dst_im[i]       = im * n;
+        }
+    }
+
+    void test_dft(const char *label, fft_f64_t func, bool direct)
+    {
+        for (size_t rank=0; rank<=MAX_DFT_RANK; ++rank)
+        {
+            size_t count = 1 << rank;
+            printf("Testing '%s' against DFT for rank=%d...\n", label, int(rank));
+
+            FloatBuffer buf(count * 8, 64, true);
+            double *src_re  = buf.data<double>();
+            double *src_im  = &src_re[count];
+            double *dst_re  = &src_im[count];
+            double *dst_im  = &dst_re[count];
+            randomize(src_re, count * 2);
+
+            dft(dst_re, dst_im, src_re, src_im, rank, direct);
+            func(src_re, src_im, src_re, src_im, rank);
+
+            UTEST_ASSERT_MSG(buf.valid(), "Buffer corrupted");
+            double e = error(src_re, src_im, dst_re, dst_im, count);
+            if (e > F64_TOLERANCE)
+                UTEST_FAIL_MSG("Output of '%s' differs from DFT for rank=%d, error=%g", label, int(rank), e);
+        }
+    }
+
+    void call(const char *label, size_t align, fft_f64_t func1, fft_f64_t func2)
+    {
+        if (!UTEST_SUPPORTED(func1))
+            return;
+        if (!UTEST_SUPPORTED(func2))
+            return;
+
+        for (int same=0; same<2; ++same)
+        {
+            for (size_t rank=0; rank<=MAX_RANK; ++rank)
+            {
+                size_t count = 1 << rank;
+                printf("Testing '%s' for rank=%d, same=%s...\n", label, int(rank), (same) ? "true" : "false");
+
+                FloatBuffer buf(count * 12 + 2, align, true);
+                double *src_re  = reinterpret_cast<double *>(&buf[2]);
+                double *src_im  = &src_re[count];
+                double *dst1_re = &src_im[count];
+                double *dst1_im = &dst1_re[count];
+                double *dst2_re = &dst1_im[count];
+                double *dst2_im = &dst2_re[count];
+                randomize(src_re, count * 2);
+
+                if (same)
+                {
+                    for (size_t i=0; i<count; ++i)
+                    {
+                        dst1_re[i]  = dst2_re[i]    = src_re[i];
+                        dst1_im[i]  = dst2_im[i]    = src_im[i];
+                    }
+                    func1(dst1_re, dst1_im, dst1_re, dst1_im, rank);
+                    func2(dst2_re, dst2_im, dst2_re, dst2_im, rank);
+                }
+                else
+                {
+                    func1(dst1_re, dst1_im, src_re, src_im, rank);
+                    func2(dst2_re, dst2_im, src_re, src_im, rank);
+                }
+
+                UTEST_ASSERT_MSG(buf.valid(), "Buffer corrupted");
+                double e = error(dst2_re, dst2_im, dst1_re, dst1_im, count);
+                if (e > F64_TOLERANCE)
+                    UTEST_FAIL_MSG("Output of '%s' differs for rank=%d, error=%g", label, int(rank), e);
+            }
+        }
+    }
+
+    void call(const char *label, size_t align, fft_mp_t func1, fft_mp_t func2)
+    {
+        if (!UTEST_SUPPORTED(func1))
+            return;
+        if (!UTEST_SUPPORTED(func2))
+            return;
+
+        for (int same=0; same<2; ++same)
+        {
+            for (size_t rank=0; rank<=MAX_RANK; ++rank)
+            {
+                size_t count = 1 << rank;
+                printf("Testing '%s' for rank=%d, same=%s...\n", label, int(rank), (same) ? "true" : "false");
+
+                FloatBuffer src_re(count, align, false);
+                FloatBuffer src_im(count, align, true);
+                FloatBuffer dst1_re(count, align, true);
+                FloatBuffer dst1_im(count, align, false);
+                FloatBuffer dst2_re(dst1_re);
+                FloatBuffer dst2_im(dst1_im);
+
+                if (same)
+                {
+                    dsp::copy(dst1_re, src_re, count);
+                    dsp::copy(dst1_im, src_im, count);
+                    dsp::copy(dst2_re, src_re, count);
+                    dsp::copy(dst2_im, src_im, count);
+                    func1(dst1_re, dst1_im, dst1_re, dst1_im, rank);
+                    func2(dst2_re, dst2_im, dst2_re, dst2_im, rank);
+                }
+                else
+                {
+                    func1(dst1_re, dst1_im, src_re, src_im, rank);
+                    func2(dst2_re, dst2_im, src_re, src_im, rank);
+                }
+
+                UTEST_ASSERT_MSG(src_re.valid(), "Source buffer RE corrupted");
+                UTEST_ASSERT_MSG(src_im.valid(), "Source buffer IM corrupted");
+                UTEST_ASSERT_MSG(dst1_re.valid(), "Destination buffer 1 RE corrupted");
+                UTEST_ASSERT_MSG(dst1_im.valid(), "Destination buffer 1 IM corrupted");
+                UTEST_ASSERT_MSG(dst2_re.valid(), "Destination buffer 2 RE corrupted");
+                UTEST_ASSERT_MSG(dst2_im.valid(), "Destination buffer 2 IM corrupted");
+
+                // Compare buffers
+                if ((!dst1_re.equals_adaptive(dst2_re, MP_TOLERANCE)) || (!dst1_im.equals_adaptive(dst2_im, MP_TOLERANCE)))
+                {
+                    src_re.dump("src_re ");
+                    src_im.dump("src_im ");
+                    dst1_re.dump("dst1_re");
+                    dst1_im.dump("dst1_im");
+                    dst2_re.dump("dst2_re");
+                    dst2_im.dump("dst2_im");
+                    UTEST_FAIL_MSG("Output of functions for test '%s' differs", label);
+                }
+            }
+        }
+    }
+
+    void test_precision()
+    {
+        size_t count    = 1 << MAX_RANK;
+        printf("Testing precision of transforms for rank=%d...\n", int(MAX_RANK));
+
+        FloatBuffer buf(count * 8, 64, true);
+        FloatBuffer src_re(count, 64, true);
+        FloatBuffer src_im(count, 64, true);
+        FloatBuffer dst_re(count, 64, true);
+        FloatBuffer dst_im(count, 64, true);
+
+        double *x_re    = buf.data<double>();
+        double *x_im    = &x_re[count];
+        double *y_re    = &x_im[count];
+        double *y_im    = &y_re[count];
+
+        for (size_t i=0; i<count; ++i)
+        {
+            x_re[i]         = src_re[i];
+            x_im[i]         = src_im[i];
+        }
+
+        // The round trip in double precision should be almost lossless
+        generic::direct_fft_f64(y_re, y_im, x_re, x_im, MAX_RANK);
+        generic::reverse_fft_f64(y_re, y_im, y_re, y_im, MAX_RANK);
+        double e = error(y_re, y_im, x_re, x_im, count);
+        printf("  double precision round trip error: %g\n", e);
+        UTEST_ASSERT_MSG(e < F64_TOLERANCE, "Round trip error of double precision FFT is too high: %g", e);
+
+        // The mixed precision should provide less error than the single precision
+        generic::direct_fft_f64(y_re, y_im, x_re, x_im, MAX_RANK);
+        generic::direct_fft(dst_re, dst_im, src_re, src_im, MAX_RANK);
+        double e_sp = error(dst_re, dst_im, y_re, y_im, count);
+        generic::direct_fft_mp(dst_re, dst_im, src_re, src_im, MAX_RANK);
+        double e_mp = error(dst_re, dst_im, y_re, y_im, count);
+
+        printf("  single precision error: %g, mixed precision error: %g\n", e_sp, e_mp);
+        UTEST_ASSERT_MSG(e_mp < e_sp, "Mixed precision error %g is not less than single precision error %g", e_mp, e_sp);
+    }
+
+    UTEST_MAIN
+    {
+        test_dft("generic::direct_fft_f64", generic::direct_fft_f64, true);
+        test_dft("generic::reverse_fft_f64", generic::reverse_fft_f64, false);
+        test_precision();
+
+        #define CALL(generic, func, align) \
+            call(#func, align, generic, func)
+
+        IF_ARCH_X86(CALL(generic::direct_fft_f64, sse2::direct_fft_f64, 16));
+        IF_ARCH_X86(CALL(generic::reverse_fft_f64, sse2::reverse_fft_f64, 16));
+        IF_ARCH_X86(CALL(generic::direct_fft_mp, sse2::direct_fft_mp, 16));
+        IF_ARCH_X86(CALL(generic::reverse_fft_mp, sse2::reverse_fft_mp, 16));
+
+        IF_ARCH_X86(CALL(generic::direct_fft_f64, avx::direct_fft_f64, 32));
+        IF_ARCH_X86(CALL(generic::reverse_fft_f64, avx::reverse_fft_f64, 32));
+        IF_ARCH_X86(CALL(generic::direct_fft_mp, avx::direct_fft_mp, 32));
+        IF_ARCH_X86(CALL(generic::reverse_fft_mp, avx::reverse_fft_mp, 32));
+        IF_ARCH_X86(CALL(generic::direct_fft_f64, avx::direct_fft_f64_fma3, 32));
+        IF_ARCH_X86(CALL(generic::reverse_fft_f64, avx::reverse_fft_f64_fma3, 32));
+        IF_ARCH_X86(CALL(generic::direct_fft_mp, avx::direct_fft_mp_fma3, 32));
+        IF_ARCH_X86(CALL(generic::reverse_fft_mp, avx::reverse_fft_mp_fma3, 32));
+    }
+
+UTEST_END
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 7 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define TOLERANCE       1e-4
+
+namespace lsp
+{
+    namespace generic
+    {
+        void fftn_direct(const dsp::fftn_t *plan, float *dst, const float *src);
+        void fftn_reverse(const dsp::fftn_t *plan, float *dst, const float *src);
+    }
+
+    IF_ARCH_X86_64(
+        namespace avx
+        {
+            void x64_fftn_direct(const dsp::fftn_t *plan, float *dst, const float *src);
+            void x64_fftn_reverse(const dsp::fftn_t *plan, float *dst, const float *src);
+        }
+    )
+
+    typedef void (* fftn_func_t)(const dsp::fftn_t *plan, float *dst, const float *src);
+}
+
+namespace
+{
+    // Reference DFT computed with double precision
+    void dft(double *dst, const float *src, size_t count, double sg)
+    {
+        for (size_t k=0; k<count; ++k)
+        {
+            double re = 0.0, im = 0.0;
+            for (size_t n=0; n<count; ++n)
+            {
+                double a    = (-2.0 * sg * M_PI * ((k * n) % count)) / count;
+                double c    = cos(a), s = sin(a);
+                re         += src[n*2] * c - src[n*2 + 1] * s;
+                im         += src[n*2] * s + src[n*2 + 1] * c;
+            }
+            dst[k*2]        = re;
+            dst[k*2 + 1]    = im;
+        }
+    }
+}
+
+UTEST_BEGIN("dsp.fft", fftn)
+
+    // The error is estimated relatively to the energy of the signal since
+    // the rounding errors are spread among all the samples
+    double error(const float *a, const double *b, size_t count, double norm)
+    {
+        double e_diff = 0.0, e_sig = 0.0;
+        for (size_t i=0; i<count*2; ++i)
+        {
+            double ref  = b[i] * norm;
+            double d    = double(a[i]) - ref;
+            e_diff     += d * d;
+            e_sig      += ref * ref;
+        }
+
+        return (e_sig > 0.0) ? sqrt(e_diff / e_sig) : sqrt(e_diff);
+    }
+
+    void test_size(const char *label, fftn_func_t direct, fftn_func_t reverse, size_t count)
+    {
+        printf("Testing '%s' for count=%d...\n", label, int(count));
+
+        FloatBuffer buf(dsp::fftn_buffer_size(count), 64, true);
+        FloatBuffer src(count * 2, 16, true);
+        FloatBuffer dst(count * 2, 16, true);
+        FloatBuffer rev(count * 2, 16, true);
+        FloatBuffer inplace(src);
+        double *ref = new double[count * 2];
+
+        dsp::fftn_t plan;
+        UTEST_ASSERT(dsp::fftn_init(&plan, buf, count));
+
+        // Direct transform
+        direct(&plan, dst, src);
+        UTEST_ASSERT_MSG(buf.valid(), "Plan buffer corrupted");
+        UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+        UTEST_ASSERT_MSG(dst.valid(), "Destination buffer corrupted");
+
+        dft(ref, src, count, 1.0);
+        double e = error(dst, ref, count, 1.0);
+        if (e > TOLERANCE)
+        {
+            delete [] ref;
+            UTEST_FAIL_MSG("Direct transform '%s' of size %d has too large error: %g", label, int(count), e);
+        }
+
+        // Reverse transform
+        reverse(&plan, rev, src);
+        UTEST_ASSERT_MSG(buf.valid(), "Plan buffer corrupted");
+        UTEST_ASSERT_MSG(rev.valid(), "Reverse buffer corrupted");
+
+        dft(ref, src, count, -1.0);
+        e = error(rev, ref, count, 1.0 / count);
+        delete [] ref;
+        if (e > TOLERANCE)
+            UTEST_FAIL_MSG("Reverse transform '%s' of size %d has too large error: %g", label, int(count), e);
+
+        // In-place round trip
+        direct(&plan, inplace, inplace);
+        UTEST_ASSERT_MSG(inplace.valid(), "In-place buffer corrupted");
+        UTEST_ASSERT_MSG(inplace.equals_adaptive(dst, TOLERANCE), "In-place direct transform of size %d differs", int(count));
+        reverse(&plan, inplace, inplace);
+        UTEST_ASSERT_MSG(inplace.valid(), "In-place buffer corrupted");
+        UTEST_ASSERT_MSG(inplace.equals_absolute(src, 1e-4), "Round trip of size %d differs", int(count));
+    }
+
+    void call(const char *label, fftn_func_t direct, fftn_func_t reverse)
+    {
+        static const size_t sizes[] =
+        {
+            // Mixed radix
+            48, 60, 64, 96, 120, 240, 343, 441, 480, 500, 720, 960, 1000, 1920, 2048, 4800,
+            // Bluestein
+            11, 13, 97, 121, 1021, 2310
+        };
+
+        if (!UTEST_SUPPORTED(direct))
+            return;
+        if (!UTEST_SUPPORTED(reverse))
+            return;
+
+        for (size_t count=1; count <= 40; ++count)
+            test_size(label, direct, reverse, count);
+        for (size_t i=0; i<sizeof(sizes)/sizeof(size_t); ++i)
+            test_size(label, direct, reverse, sizes[i]);
+    }
+
+    UTEST_MAIN
+    {
+        dsp::fftn_t plan;
+        UTEST_ASSERT(!dsp::fftn_init(&plan, NULL, 0));
+
+        call("generic", generic::fftn_direct, generic::fftn_reverse);
+        IF_ARCH_X86_64(call("avx", avx::x64_fftn_direct, avx::x64_fftn_reverse));
+    }
+
+UTEST_END
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define TOLERANCE       5e-2
+#define MAX_RANK        16
+
+namespace lsp
+{
+    namespace generic
+    {
+        void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        void packed_direct_fft(float *dst, const float *src, size_t rank);
+
+        void fft_plan_direct(const dsp::fft_plan_t *plan, float *re, float *im);
+        void fft_plan_reverse(const dsp::fft_plan_t *plan, float *re, float *im);
+        void fft_plan_packed_direct(const dsp::fft_plan_t *plan, float *data);
+        void fft_plan_packed_reverse(const dsp::fft_plan_t *plan, float *data);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void fft_plan_direct(const dsp::fft_plan_t *plan, float *re, float *im);
+            void fft_plan_reverse(const dsp::fft_plan_t *plan, float *re, float *im);
+            void fft_plan_packed_direct(const dsp::fft_plan_t *plan, float *data);
+            void fft_plan_packed_reverse(const dsp::fft_plan_t *plan, float *data);
+        }
+
+        namespace avx
+        {
+            void fft_plan_direct(const dsp::fft_plan_t *plan, float *re, float *im);
+            void fft_plan_reverse(const dsp::fft_plan_t *plan, float *re, float *im);
+            void fft_plan_packed_direct(const dsp::fft_plan_t *plan, float *data);
+            void fft_plan_packed_reverse(const dsp::fft_plan_t *plan, float *data);
+
+            void fft_plan_direct_fma3(const dsp::fft_plan_t *plan, float *re, float *im);
+            void fft_plan_reverse_fma3(const dsp::fft_plan_t *plan, float *re, float *im);
+            void fft_plan_packed_direct_fma3(const dsp::fft_plan_t *plan, float *data);
+            void fft_plan_packed_reverse_fma3(const dsp::fft_plan_t *plan, float *data);
+        }
+
+        namespace avx512
+        {
+            void fft_plan_direct(const dsp::fft_plan_t *plan, float *re, float *im);
+            void fft_plan_reverse(const dsp::fft_plan_t *plan, float *re, float *im);
+        }
+    )
+
+    typedef void (* fft_plan_split_t)(const dsp::fft_plan_t *plan, float *re, float *im);
+    typedef void (* fft_plan_packed_t)(const dsp::fft_plan_t *plan, float *data);
+}
+
+UTEST_BEGIN("dsp.fft", fftplan)
+
+    void test_split(const char *direct_label, const char *reverse_label, fft_plan_split_t direct, fft_plan_split_t reverse, size_t rank)
+    {
+        size_t count    = 1 << rank;
+        printf("Testing '%s' and '%s' for rank=%d...\n", direct_label, reverse_label, int(rank));
+
+        FloatBuffer buf(dsp::fft_plan_buffer_size(rank), 64, true);
+        FloatBuffer src_re(count, 64, true);
+        FloatBuffer src_im(count, 64, true);
+        FloatBuffer dst1_re(count, 64, true);
+        FloatBuffer dst1_im(count, 64, true);
+        FloatBuffer dst2_re(src_re);
+        FloatBuffer dst2_im(src_im);
+
+        dsp::fft_plan_t plan;
+        UTEST_ASSERT(dsp::fft_plan_init(&plan, buf, rank, false));
+        UTEST_ASSERT(dsp::fft_plan_footprint(&plan) <= sizeof(dsp::fft_plan_t) + buf.size() * sizeof(float));
+
+        // Direct transform
+        generic::direct_fft(dst1_re, dst1_im, src_re, src_im, rank);
+        direct(&plan, dst2_re, dst2_im);
+
+        UTEST_ASSERT_MSG(buf.valid(), "Plan buffer corrupted");
+        UTEST_ASSERT_MSG(dst2_re.valid(), "Destination buffer RE corrupted");
+        UTEST_ASSERT_MSG(dst2_im.valid(), "Destination buffer IM corrupted");
+        if ((!dst1_re.equals_adaptive(dst2_re, TOLERANCE)) || (!dst1_im.equals_adaptive(dst2_im, TOLERANCE)))
+        {
+            dst1_re.dump("dst1_re");
+            dst2_re.dump("dst2_re");
+            dst1_im.dump("dst1_im");
+            dst2_im.dump("dst2_im");
+            UTEST_FAIL_MSG("Output of '%s' for rank=%d differs", direct_label, int(rank));
+        }
+
+        // Reverse transform
+        reverse(&plan, dst2_re, dst2_im);
+        UTEST_ASSERT_MSG(buf.valid(), "Plan buffer corrupted");
+        if ((!src_re.equals_adaptive(dst2_re, TOLERANCE)) || (!src_im.equals_adaptive(dst2_im, TOLERANCE)))
+        {
+            src_re.dump("src_re ");
+            dst2_re.dump("dst2_re");
+            src_im.dump("src_im ");
+            dst2_im.dump("dst2_im");
+            UTEST_FAIL_MSG("Output of '%s' for rank=%d does not restore the signal", reverse_label, int(rank));
+        }
+    }
+
+    void test_packed(const char *direct_label, const char *reverse_label, fft_plan_packed_t direct, fft_plan_packed_t reverse, size_t rank)
+    {
+        size_t count    = 1 << rank;
+        printf("Testing '%s' and '%s' for rank=%d...\n", direct_label, reverse_label, int(rank));
+
+        FloatBuffer buf(dsp::fft_plan_buffer_size(rank), 64, true);
+        FloatBuffer src(count * 2, 64, true);
+        FloatBuffer dst1(count * 2, 64, true);
+        FloatBuffer dst2(src);
+
+        dsp::fft_plan_t plan;
+        UTEST_ASSERT(dsp::fft_plan_init(&plan, buf, rank, true));
+        UTEST_ASSERT(dsp::fft_plan_footprint(&plan) <= sizeof(dsp::fft_plan_t) + buf.size() * sizeof(float));
+
+        // Direct transform
+        generic::packed_direct_fft(dst1, src, rank);
+        direct(&plan, dst2);
+
+        UTEST_ASSERT_MSG(buf.valid(), "Plan buffer corrupted");
+        UTEST_ASSERT_MSG(dst2.valid(), "Destination buffer corrupted");
+        if (!dst1.equals_adaptive(dst2, TOLERANCE))
+        {
+            dst1.dump("dst1");
+            dst2.dump("dst2");
+            UTEST_FAIL_MSG("Output of '%s' for rank=%d differs", direct_label, int(rank));
+        }
+
+        // Reverse transform
+        reverse(&plan, dst2);
+        UTEST_ASSERT_MSG(buf.valid(), "Plan buffer corrupted");
+        if (!src.equals_adaptive(dst2, TOLERANCE))
+        {
+            src.dump("src ");
+            dst2.dump("dst2");
+            UTEST_FAIL_MSG("Output of '%s' for rank=%d does not restore the signal", reverse_label, int(rank));
+        }
+    }
+
+    void call_split(const char *direct_label, const char *reverse_label, fft_plan_split_t direct, fft_plan_split_t reverse)
+    {
+        if ((!UTEST_SUPPORTED(direct)) || (!UTEST_SUPPORTED(reverse)))
+            return;
+        for (size_t rank=0; rank<=MAX_RANK; ++rank)
+            test_split(direct_label, reverse_label, direct, reverse, rank);
+    }
+
+    void call_packed(const char *direct_label, const char *reverse_label, fft_plan_packed_t direct, fft_plan_packed_t reverse)
+    {
+        if ((!UTEST_SUPPORTED(direct)) || (!UTEST_SUPPORTED(reverse)))
+            return;
+        for (size_t rank=0; rank<=MAX_RANK; ++rank)
+            test_packed(direct_label, reverse_label, direct, reverse, rank);
+    }
+
+    UTEST_MAIN
+    {
+        dsp::fft_plan_t plan;
+        UTEST_ASSERT(!dsp::fft_plan_init(&plan, NULL, 32, false));
+
+        #define CALL_SPLIT(direct, reverse) \
+            call_split(#direct, #reverse, direct, reverse)
+        #define CALL_PACKED(direct, reverse) \
+            call_packed(#direct, #reverse, direct, reverse)
+
+        CALL_SPLIT(generic::fft_plan_direct, generic::fft_plan_reverse);
+        CALL_PACKED(generic::fft_plan_packed_direct, generic::fft_plan_packed_reverse);
+
+        IF_ARCH_X86(CALL_SPLIT(sse::fft_plan_direct, sse::fft_plan_reverse));
+        IF_ARCH_X86(CALL_PACKED(sse::fft_plan_packed_direct, sse::fft_plan_packed_reverse));
+        IF_ARCH_X86(CALL_SPLIT(avx::fft_plan_direct, avx::fft_plan_reverse));
+        IF_ARCH_X86(CALL_PACKED(avx::fft_plan_packed_direct, avx::fft_plan_packed_reverse));
+        IF_ARCH_X86(CALL_SPLIT(avx::fft_plan_direct_fma3, avx::fft_plan_reverse_fma3));
+        IF_ARCH_X86(CALL_PACKED(avx::fft_plan_packed_direct_fma3, avx::fft_plan_packed_reverse_fma3));
+        IF_ARCH_X86(CALL_SPLIT(avx512::fft_plan_direct, avx512::fft_plan_reverse));
+    }
+
+UTEST_END
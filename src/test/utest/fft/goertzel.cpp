@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 29 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define TOLERANCE       1e-3
+#define MAX_BINS        67
+#define MAX_SAMPLES     257
+#define SIGNAL_LENGTH   0x3000
+#define SDFT_LENGTH     0x400
+
+namespace lsp
+{
+    namespace generic
+    {
+        void goertzel_bank(float *state, const float *coef, const float *src, size_t bins, size_t count);
+        void sdft_bank(float *state, const float *coef, const float *src, const float *old, size_t bins, size_t count);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void goertzel_bank(float *state, const float *coef, const float *src, size_t bins, size_t count);
+            void sdft_bank(float *state, const float *coef, const float *src, const float *old, size_t bins, size_t count);
+        }
+
+        namespace avx
+        {
+            void goertzel_bank(float *state, const float *coef, const float *src, size_t bins, size_t count);
+            void sdft_bank(float *state, const float *coef, const float *src, const float *old, size_t bins, size_t count);
+        }
+    )
+
+    typedef void (* goertzel_bank_t)(float *state, const float *coef, const float *src, size_t bins, size_t count);
+    typedef void (* sdft_bank_t)(float *state, const float *coef, const float *src, const float *old, size_t bins, size_t count);
+}
+
+UTEST_BEGIN("dsp.fft", goertzel)
+
+    // Reference DFT of the signal at specified frequency, the phase is referenced to the last sample
+    void dft(double &re, double &im, const float *src, size_t count, double f, ssize_t ref)
+    {
+        re      = 0.0;
+        im      = 0.0;
+        for (size_t i=0; i<count; ++i)
+        {
+            double a    = -2.0 * M_PI * f * (ssize_t(i) - ref);
+            re         += src[i] * cos(a);
+            im         += src[i] * sin(a);
+        }
+    }
+
+    void call(const char *label, size_t align, goertzel_bank_t func)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        for (size_t bins=1; bins<=MAX_BINS; bins += (bins < 20) ? 1 : 7)
+        {
+            for (size_t count=0; count <= MAX_SAMPLES; count += (count < 16) ? 1 : 31)
+            {
+                printf("Testing %s on %d bins, %d samples...\n", label, int(bins), int(count));
+
+                FloatBuffer src(count, align, false);
+                FloatBuffer coef(bins, align, false);
+                FloatBuffer state1(bins * 2, align, false);
+                for (size_t i=0; i<bins; ++i)
+                    coef[i]         = 2.0f * cosf(M_PI * (i + 0.5f) / bins);
+                for (size_t i=0; i<bins*2; ++i)
+                    state1[i]       = randf(-1.0f, 1.0f);
+                FloatBuffer state2(state1);
+
+                generic::goertzel_bank(state1, coef, src, bins, count);
+                func(state2, coef, src, bins, count);
+
+                UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+                UTEST_ASSERT_MSG(coef.valid(), "Coefficient buffer corrupted");
+                UTEST_ASSERT_MSG(state1.valid(), "State buffer 1 corrupted");
+                UTEST_ASSERT_MSG(state2.valid(), "State buffer 2 corrupted");
+
+                if (!state1.equals_adaptive(state2, TOLERANCE))
+                {
+                    state1.dump("state1");
+                    state2.dump("state2");
+                    UTEST_FAIL_MSG("Output of functions for test '%s' differs at element %d",
+                        label, int(state1.last_diff()));
+                }
+            }
+        }
+    }
+
+    void call(const char *label, size_t align, sdft_bank_t func)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        for (size_t bins=1; bins<=MAX_BINS; bins += (bins < 20) ? 1 : 7)
+        {
+            for (size_t count=0; count <= MAX_SAMPLES; count += (count < 16) ? 1 : 31)
+            {
+                printf("Testing %s on %d bins, %d samples...\n", label, int(bins), int(count));
+
+                FloatBuffer src(count, align, false);
+                FloatBuffer old(count, align, false);
+                FloatBuffer coef(bins * 4, align, false);
+                FloatBuffer state1(bins * 2, align, false);
+                for (size_t i=0; i<bins; ++i)
+                {
+                    float w             = M_PI * (i + 0.5f) / bins;
+                    coef[i]             = cosf(w);
+                    coef[i + bins]      = sinf(w);
+                    coef[i + bins*2]    = cosf(w * 100.0f);
+                    coef[i + bins*3]    = sinf(w * 100.0f);
+                }
+                for (size_t i=0; i<bins*2; ++i)
+                    state1[i]       = randf(-1.0f, 1.0f);
+                FloatBuffer state2(state1);
+
+                generic::sdft_bank(state1, coef, src, old, bins, count);
+                func(state2, coef, src, old, bins, count);
+
+                UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+                UTEST_ASSERT_MSG(old.valid(), "Old source buffer corrupted");
+                UTEST_ASSERT_MSG(coef.valid(), "Coefficient buffer corrupted");
+                UTEST_ASSERT_MSG(state1.valid(), "State buffer 1 corrupted");
+                UTEST_ASSERT_MSG(state2.valid(), "State buffer 2 corrupted");
+
+                if (!state1.equals_adaptive(state2, TOLERANCE))
+                {
+                    state1.dump("state1");
+                    state2.dump("state2");
+                    UTEST_FAIL_MSG("Output of functions for test '%s' differs at element %d",
+                        label, int(state1.last_diff()));
+                }
+            }
+        }
+    }
+
+    void test_goertzel()
+    {
+        static const float freqs[] = { 0.0f, 0.01f, 0.0625f, 0.1234f, 0.25f, 0.3333f, 0.49f, 0.5f };
+        const size_t bins = sizeof(freqs) / sizeof(float);
+
+        printf("Testing goertzel_process...\n");
+
+        FloatBuffer buf(dsp::goertzel_buffer_size(bins), 64, true);
+        FloatBuffer src(SIGNAL_LENGTH, 16, false);
+        FloatBuffer re(bins, 16, true);
+        FloatBuffer im(bins, 16, true);
+
+        dsp::goertzel_t g;
+        UTEST_ASSERT(!dsp::goertzel_init(&g, buf, freqs, 0));
+        UTEST_ASSERT(dsp::goertzel_init(&g, buf, freqs, bins));
+
+        // The block is processed by parts, the state is reset after each block
+        for (size_t block=0; block<3; ++block)
+        {
+            const size_t length = 0x400 + block * 0x123;
+            const float *sig    = &src[block * 0x1000];
+
+            dsp::goertzel_reset(&g);
+            for (size_t off=0, step=1; off < length; step = (step * 7 + 3) % 97 + 1)
+            {
+                size_t to_do    = lsp_min(step, length - off);
+                dsp::goertzel_process(&g, &sig[off], to_do);
+                off            += to_do;
+            }
+            dsp::goertzel_spectrum(&g, re, im);
+
+            UTEST_ASSERT_MSG(buf.valid(), "Engine buffer corrupted");
+            UTEST_ASSERT_MSG(re.valid(), "Real part buffer corrupted");
+            UTEST_ASSERT_MSG(im.valid(), "Imaginary part buffer corrupted");
+
+            for (size_t i=0; i<bins; ++i)
+            {
+                double x_re, x_im;
+                dft(x_re, x_im, sig, length, freqs[i], length - 1);
+                double norm = sqrt(length) + sqrt(x_re * x_re + x_im * x_im);
+                if ((fabs(re[i] - x_re) > norm * TOLERANCE) || (fabs(im[i] - x_im) > norm * TOLERANCE))
+                    UTEST_FAIL_MSG("Bin %d of block %d differs: (%.5f, %.5f) vs (%.5f, %.5f)",
+                        int(i), int(block), re[i], im[i], x_re, x_im);
+            }
+        }
+    }
+
+    void test_sdft()
+    {
+        static const size_t k[] = { 0, 1, 7, 64, 100, 255, 511, 512 };
+        const size_t bins = sizeof(k) / sizeof(size_t);
+        float freqs[bins];
+        for (size_t i=0; i<bins; ++i)
+            freqs[i]        = float(k[i]) / SDFT_LENGTH;
+
+        printf("Testing sdft_process...\n");
+
+        FloatBuffer buf(dsp::sdft_buffer_size(bins, SDFT_LENGTH), 64, true);
+        FloatBuffer src(SIGNAL_LENGTH, 16, false);
+        FloatBuffer re(bins, 16, true);
+        FloatBuffer im(bins, 16, true);
+
+        dsp::sdft_t s;
+        UTEST_ASSERT(!dsp::sdft_init(&s, buf, freqs, 0, SDFT_LENGTH));
+        UTEST_ASSERT(!dsp::sdft_init(&s, buf, freqs, bins, 0));
+        UTEST_ASSERT(dsp::sdft_init(&s, buf, freqs, bins, SDFT_LENGTH));
+
+        for (size_t off=0, step=1; off < SIGNAL_LENGTH; step = (step * 7 + 3) % 397 + 1)
+        {
+            size_t to_do    = lsp_min(step, SIGNAL_LENGTH - off);
+            dsp::sdft_process(&s, &src[off], to_do);
+            off            += to_do;
+
+            // The spectrum should match the DFT of the last samples, missing samples are zeros
+            dsp::sdft_spectrum(&s, re, im);
+            UTEST_ASSERT_MSG(buf.valid(), "Engine buffer corrupted");
+
+            const size_t length = lsp_min(off, size_t(SDFT_LENGTH));
+            const float *sig    = &src[off - length];
+            for (size_t i=0; i<bins; ++i)
+            {
+                double x_re, x_im;
+                dft(x_re, x_im, sig, length, freqs[i], length - SDFT_LENGTH);
+                double norm = sqrt(SDFT_LENGTH) + sqrt(x_re * x_re + x_im * x_im);
+                if ((fabs(re[i] - x_re) > norm * TOLERANCE) || (fabs(im[i] - x_im) > norm * TOLERANCE))
+                    UTEST_FAIL_MSG("Bin %d at sample %d differs: (%.5f, %.5f) vs (%.5f, %.5f)",
+                        int(i), int(off), re[i], im[i], x_re, x_im);
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        #define CALL(func, align) \
+            call(#func, align, func)
+
+        IF_ARCH_X86(CALL(sse::goertzel_bank, 16));
+        IF_ARCH_X86(CALL(avx::goertzel_bank, 32));
+
+        IF_ARCH_X86(CALL(sse::sdft_bank, 16));
+        IF_ARCH_X86(CALL(avx::sdft_bank, 32));
+
+        test_goertzel();
+        test_sdft();
+    }
+
+UTEST_END
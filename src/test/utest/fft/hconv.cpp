@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 28 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define TOLERANCE       1e-3
+#define SIGNAL_LENGTH   0x4000
+
+UTEST_BEGIN("dsp.fft", hconv)
+
+    void test_convolver(size_t length, size_t rank, size_t max_rank)
+    {
+        printf("Testing hconv for length=%d, rank=%d, max_rank=%d...\n",
+            int(length), int(rank), int(max_rank));
+
+        const size_t size   = dsp::hconv_buffer_size(length, rank, max_rank);
+        UTEST_ASSERT(size > 0);
+
+        FloatBuffer buf(size, 64, true);
+        FloatBuffer ir(length, 16, true);
+        FloatBuffer src(SIGNAL_LENGTH, 16, true);
+        FloatBuffer dst(SIGNAL_LENGTH, 16, true);
+        FloatBuffer ref(SIGNAL_LENGTH, 16, true);
+
+        // Make the decaying impulse response and compute the reference output without latency
+        for (size_t i=0; i<length; ++i)
+            ir[i]           = (randf(-1.0f, 1.0f)) * expf(-4.0f * i / length);
+        for (size_t i=0; i<SIGNAL_LENGTH; ++i)
+        {
+            double s        = 0.0;
+            for (size_t j=0, n=lsp_min(length, i + 1); j<n; ++j)
+                s              += double(src[i - j]) * double(ir[j]);
+            ref[i]          = s;
+        }
+
+        dsp::hconv_t conv;
+        UTEST_ASSERT(dsp::hconv_init(&conv, buf, ir, length, rank, max_rank));
+        UTEST_ASSERT(conv.block == size_t(1 << (rank - 1)));
+
+        // Process the signal by blocks of varying size
+        for (size_t off=0, step=1; off < SIGNAL_LENGTH; step = (step * 7 + 3) % 293 + 1)
+        {
+            size_t to_do    = lsp_min(step, SIGNAL_LENGTH - off);
+            dsp::hconv_process(&conv, &dst[off], &src[off], to_do);
+            off            += to_do;
+        }
+
+        UTEST_ASSERT_MSG(buf.valid(), "Convolver buffer corrupted");
+        UTEST_ASSERT_MSG(dst.valid(), "Destination buffer corrupted");
+        for (size_t i=0; i<SIGNAL_LENGTH; ++i)
+        {
+            if (!float_equals_adaptive(dst[i], ref[i], TOLERANCE))
+                UTEST_FAIL_MSG("Output differs at sample %d (%.6f vs %.6f)", int(i), dst[i], ref[i]);
+        }
+
+        // In-place processing after reset
+        dsp::hconv_reset(&conv);
+        dsp::hconv_process(&conv, src, src, SIGNAL_LENGTH);
+        UTEST_ASSERT_MSG(src.valid(), "In-place buffer corrupted");
+        for (size_t i=0; i<SIGNAL_LENGTH; ++i)
+        {
+            if (!float_equals_adaptive(src[i], dst[i], TOLERANCE))
+                UTEST_FAIL_MSG("In-place output differs at sample %d (%.6f vs %.6f)", int(i), src[i], dst[i]);
+        }
+    }
+
+    void test_calibration()
+    {
+        dsp::hconv_costs_t costs;
+        uint8_t *data   = NULL;
+        float *buf      = alloc_aligned<float>(data, LSP_DSP_HCONV_CALIBRATE_SIZE, 64);
+        UTEST_ASSERT(buf != NULL);
+        lsp_finally { free_aligned(data); };
+
+        dsp::hconv_calibrate(&costs, buf);
+        for (size_t rank=LSP_DSP_PCONV_RANK_MIN; rank<=LSP_DSP_PCONV_RANK_MAX; ++rank)
+        {
+            printf("rank=%d: direct=%.3f ns, level=%.3f ns, part=%.3f ns per sample\n",
+                int(rank), costs.direct[rank], costs.level[rank], costs.part[rank]);
+            UTEST_ASSERT(costs.direct[rank] > 0.0f);
+            UTEST_ASSERT(costs.level[rank] > 0.0f);
+            UTEST_ASSERT(costs.part[rank] > 0.0f);
+        }
+
+        UTEST_ASSERT(dsp::hconv_rank(&costs, 0, 12) == 0);
+        UTEST_ASSERT(dsp::hconv_rank(&costs, 100, LSP_DSP_PCONV_RANK_MAX + 1) == 0);
+        UTEST_ASSERT(dsp::hconv_rank(&costs, 1, 12) == LSP_DSP_PCONV_RANK_MIN);
+
+        static const size_t lengths[] = { 10, 100, 1000, 10000, 100000 };
+        for (size_t i=0; i<sizeof(lengths)/sizeof(size_t); ++i)
+        {
+            const size_t rank = dsp::hconv_rank(&costs, lengths[i], 12);
+            printf("Estimated crossover for length=%d: rank=%d, head=%d samples\n",
+                int(lengths[i]), int(rank), int(1 << (rank - 1)));
+            UTEST_ASSERT((rank >= LSP_DSP_PCONV_RANK_MIN) && (rank <= 12));
+            test_convolver(lengths[i], rank, 12);
+        }
+    }
+
+    UTEST_MAIN
+    {
+        dsp::hconv_t conv;
+        FloatBuffer buf(0x1000, 64, true);
+        UTEST_ASSERT(dsp::hconv_buffer_size(0, 6, 8) == 0);
+        UTEST_ASSERT(dsp::hconv_buffer_size(100, 8, 6) == 0);
+        UTEST_ASSERT(dsp::hconv_buffer_size(100, LSP_DSP_PCONV_RANK_MIN - 1, 8) == 0);
+        UTEST_ASSERT(dsp::hconv_buffer_size(100, 8, LSP_DSP_PCONV_RANK_MAX + 1) == 0);
+        UTEST_ASSERT(!dsp::hconv_init(&conv, buf, buf, 0, 6, 8));
+        UTEST_ASSERT(!dsp::hconv_init(&conv, buf, buf, 100, 8, 6));
+
+        // The impulse response fits the head
+        test_convolver(1, 4, 4);
+        test_convolver(7, 4, 8);
+        test_convolver(32, 6, 6);
+
+        // The impulse response with the tail
+        test_convolver(33, 6, 6);
+        test_convolver(100, 4, 8);
+        test_convolver(1000, 5, 16);
+        test_convolver(3333, 6, 10);
+        test_convolver(5000, 8, 12);
+        test_convolver(12345, 7, 10);
+
+        // The crossover estimated from costs
+        test_calibration();
+    }
+
+UTEST_END
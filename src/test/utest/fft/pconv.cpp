@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 9 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define TOLERANCE       1e-3
+#define SIGNAL_LENGTH   0x4000
+
+UTEST_BEGIN("dsp.fft", pconv)
+
+    void test_convolver(size_t length, size_t rank, size_t max_rank, dsp::pconv_pool_t *pool = NULL, size_t async_rank = 0)
+    {
+        printf("Testing pconv for length=%d, rank=%d, max_rank=%d, async_rank=%d...\n",
+            int(length), int(rank), int(max_rank), int(async_rank));
+
+        const size_t size   = (pool != NULL) ?
+            dsp::pconv_mt_buffer_size(length, rank, max_rank, async_rank) :
+            dsp::pconv_buffer_size(length, rank, max_rank);
+        const size_t block  = 1 << (rank - 1);
+        UTEST_ASSERT(size > 0);
+
+        FloatBuffer buf(size, 64, true);
+        FloatBuffer ir(length, 16, true);
+        FloatBuffer src(SIGNAL_LENGTH, 16, true);
+        FloatBuffer dst(SIGNAL_LENGTH, 16, true);
+        FloatBuffer ref(SIGNAL_LENGTH, 16, true);
+
+        // Make the decaying impulse response and compute the reference output delayed by the block
+        for (size_t i=0; i<length; ++i)
+            ir[i]           = (randf(-1.0f, 1.0f)) * expf(-4.0f * i / length);
+        for (size_t i=0; i<SIGNAL_LENGTH; ++i)
+        {
+            double s        = 0.0;
+            if (i >= block)
+            {
+                for (size_t j=0, n=lsp_min(length, i - block + 1); j<n; ++j)
+                    s              += double(src[i - block - j]) * double(ir[j]);
+            }
+            ref[i]          = s;
+        }
+
+        dsp::pconv_t conv;
+        const bool res      = (pool != NULL) ?
+            dsp::pconv_mt_init(&conv, buf, pool, ir, length, rank, max_rank, async_rank) :
+            dsp::pconv_init(&conv, buf, ir, length, rank, max_rank);
+        UTEST_ASSERT(res);
+        UTEST_ASSERT(conv.block == block);
+
+        // Process the signal by blocks of varying size
+        for (size_t off=0, step=1; off < SIGNAL_LENGTH; step = (step * 7 + 3) % 293 + 1)
+        {
+            size_t to_do    = lsp_min(step, SIGNAL_LENGTH - off);
+            dsp::pconv_process(&conv, &dst[off], &src[off], to_do);
+            off            += to_do;
+        }
+
+        UTEST_ASSERT_MSG(buf.valid(), "Convolver buffer corrupted");
+        UTEST_ASSERT_MSG(dst.valid(), "Destination buffer corrupted");
+        for (size_t i=0; i<SIGNAL_LENGTH; ++i)
+        {
+            if (!float_equals_adaptive(dst[i], ref[i], TOLERANCE))
+                UTEST_FAIL_MSG("Output differs at sample %d (%.6f vs %.6f)", int(i), dst[i], ref[i]);
+        }
+
+        // In-place processing after reset
+        dsp::pconv_reset(&conv);
+        dsp::pconv_process(&conv, src, src, SIGNAL_LENGTH);
+        UTEST_ASSERT_MSG(src.valid(), "In-place buffer corrupted");
+        for (size_t i=0; i<SIGNAL_LENGTH; ++i)
+        {
+            if (!float_equals_adaptive(src[i], dst[i], TOLERANCE))
+                UTEST_FAIL_MSG("In-place output differs at sample %d (%.6f vs %.6f)", int(i), src[i], dst[i]);
+        }
+
+        if (pool != NULL)
+            dsp::pconv_mt_destroy(&conv);
+    }
+
+    void convolve(float *dst, const float *src, const float *ir, size_t length, size_t delay)
+    {
+        for (size_t i=0; i<SIGNAL_LENGTH; ++i)
+        {
+            double s        = 0.0;
+            if (i >= delay)
+            {
+                for (size_t j=0, n=lsp_min(length, i - delay + 1); j<n; ++j)
+                    s              += double(src[i - delay - j]) * double(ir[j]);
+            }
+            dst[i]          = s;
+        }
+    }
+
+    void test_swap(size_t length, size_t rank, size_t max_rank, size_t length2, size_t fade, size_t at)
+    {
+        printf("Testing pconv swap for length=%d, rank=%d, max_rank=%d, length2=%d, fade=%d, at=%d...\n",
+            int(length), int(rank), int(max_rank), int(length2), int(fade), int(at));
+
+        const size_t size   = dsp::pconv_swap_buffer_size(length, rank, max_rank);
+        const size_t block  = 1 << (rank - 1);
+        UTEST_ASSERT(size > 0);
+
+        FloatBuffer buf(size, 64, true);
+        FloatBuffer ir1(length, 16, true);
+        FloatBuffer ir2(length2, 16, true);
+        FloatBuffer src(SIGNAL_LENGTH, 16, true);
+        FloatBuffer dst(SIGNAL_LENGTH, 16, true);
+        FloatBuffer ref1(SIGNAL_LENGTH, 16, true);
+        FloatBuffer ref2(SIGNAL_LENGTH, 16, true);
+
+        for (size_t i=0; i<length; ++i)
+            ir1[i]          = (randf(-1.0f, 1.0f)) * expf(-4.0f * i / length);
+        for (size_t i=0; i<length2; ++i)
+            ir2[i]          = (randf(-1.0f, 1.0f)) * expf(-4.0f * i / length2);
+        convolve(ref1, src, ir1, length, block);
+        convolve(ref2, src, ir2, length2, block);
+
+        dsp::pconv_t conv;
+        UTEST_ASSERT(dsp::pconv_swap_init(&conv, buf, ir1, length, rank, max_rank));
+        UTEST_ASSERT(!dsp::pconv_swap_prepare(&conv, ir2, length + conv.levels[conv.nlevels - 1].parts * 0x10000, fade));
+
+        // Replace the impulse response after the specified number of samples
+        for (size_t off=0, step=1; off < SIGNAL_LENGTH; step = (step * 7 + 3) % 293 + 1)
+        {
+            if (off == at)
+            {
+                UTEST_ASSERT(dsp::pconv_swap_prepare(&conv, ir2, length2, fade));
+                UTEST_ASSERT(!dsp::pconv_swap_prepare(&conv, ir2, length2, fade));
+            }
+
+            size_t to_do    = lsp_min(step, SIGNAL_LENGTH - off);
+            if ((off < at) && (off + to_do > at))
+                to_do           = at - off;
+            dsp::pconv_process(&conv, &dst[off], &src[off], to_do);
+            off            += to_do;
+        }
+
+        UTEST_ASSERT_MSG(buf.valid(), "Convolver buffer corrupted");
+        UTEST_ASSERT_MSG(dst.valid(), "Destination buffer corrupted");
+
+        // The output of the new impulse response is computed from the next block boundary,
+        // the crossfade starts when all levels have contributed to it
+        const size_t start  = (at / block + 1) * block + conv.swap->latency;
+        UTEST_ASSERT(start + fade < SIGNAL_LENGTH);
+        for (size_t i=0; i<SIGNAL_LENGTH; ++i)
+        {
+            float v         = ref1[i];
+            if (i >= start + fade)
+                v               = ref2[i];
+            else if (i >= start)
+                v               = ref1[i] + (ref2[i] - ref1[i]) * float(i - start) / float(fade);
+
+            if (!float_equals_adaptive(dst[i], v, TOLERANCE))
+                UTEST_FAIL_MSG("Output differs at sample %d (%.6f vs %.6f)", int(i), dst[i], v);
+        }
+
+        // The slot should be free after the replacement
+        UTEST_ASSERT(dsp::pconv_swap_prepare(&conv, ir1, length, fade));
+    }
+
+    UTEST_MAIN
+    {
+        dsp::pconv_t conv;
+        FloatBuffer buf(0x1000, 64, true);
+        UTEST_ASSERT(dsp::pconv_buffer_size(0, 6, 8) == 0);
+        UTEST_ASSERT(dsp::pconv_buffer_size(100, 8, 6) == 0);
+        UTEST_ASSERT(dsp::pconv_buffer_size(100, LSP_DSP_PCONV_RANK_MIN - 1, 8) == 0);
+        UTEST_ASSERT(dsp::pconv_buffer_size(100, 8, LSP_DSP_PCONV_RANK_MAX + 1) == 0);
+        UTEST_ASSERT(!dsp::pconv_init(&conv, buf, buf, 0, 6, 8));
+        UTEST_ASSERT(!dsp::pconv_init(&conv, buf, buf, 100, 8, 6));
+
+        // Uniform partitioning
+        test_convolver(1, 4, 4);
+        test_convolver(7, 6, 6);
+        test_convolver(100, 6, 6);
+        test_convolver(1000, 8, 8);
+        test_convolver(3000, 10, 10);
+
+        // Non-uniform partitioning
+        test_convolver(100, 4, 8);
+        test_convolver(1000, 4, 8);
+        test_convolver(1000, 5, 16);
+        test_convolver(3333, 6, 10);
+        test_convolver(5000, 7, 12);
+        test_convolver(12345, 6, 10);
+
+        // Asynchronous levels
+        uint8_t *pdata = NULL;
+        uint8_t *pbuf = alloc_aligned<uint8_t>(pdata, dsp::pconv_pool_size() + LSP_DSP_PCONV_POOL_ALIGN, LSP_DSP_PCONV_POOL_ALIGN);
+        UTEST_ASSERT(pbuf != NULL);
+        lsp_finally { free_aligned(pdata); };
+        dsp::pconv_pool_t *pool = reinterpret_cast<dsp::pconv_pool_t *>(pbuf);
+        UTEST_ASSERT(!dsp::pconv_pool_start(pool, 0));
+        UTEST_ASSERT(!dsp::pconv_pool_start(reinterpret_cast<dsp::pconv_pool_t *>(&pbuf[LSP_DSP_PCONV_POOL_ALIGN / 2]), 2));
+        UTEST_ASSERT(dsp::pconv_pool_start(pool, 2));
+        UTEST_ASSERT(!dsp::pconv_mt_init(&conv, buf, NULL, buf, 100, 4, 8, 6));
+
+        test_convolver(100, 6, 6, pool, 6);
+        test_convolver(1000, 4, 8, pool, 5);
+        test_convolver(1000, 5, 16, pool, 7);
+        test_convolver(3333, 6, 10, pool, 8);
+        test_convolver(5000, 7, 12, pool, 8);
+        test_convolver(12345, 6, 10, pool, 9);
+        test_convolver(12345, 6, 10, pool, 11);
+
+        dsp::pconv_pool_stop(pool);
+
+        // Replacement of the impulse response
+        test_swap(100, 6, 6, 37, 0, 500);
+        test_swap(1000, 5, 8, 700, 512, 1234);
+        test_swap(3333, 6, 10, 3333, 1000, 2000);
+        test_swap(5000, 7, 12, 4000, 2048, 3000);
+    }
+
+UTEST_END
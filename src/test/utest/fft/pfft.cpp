@@ -25,6 +25,9 @@
 #include <lsp-plug.in/test-fw/FloatBuffer.h>
 
 #define TOLERANCE       5e-2
+#define MAX_RANK        16
+#define MAX_EXT_RANK    20
+#define EXT_TOLERANCE   1e-3
 
 namespace lsp
 {
@@ -72,6 +75,29 @@ typedef void (* packed_fft_t)(float *dst, const float *src, size_t rank);
 
 UTEST_BEGIN("dsp.fft", pfft)
 
+    // Large transforms are compared by the energy of the difference since
+    // the rounding errors are spread among all the samples
+    bool equals(FloatBuffer &a, FloatBuffer &b, size_t rank)
+    {
+        if (rank <= MAX_RANK)
+            return a.equals_adaptive(b, TOLERANCE);
+
+        double e_diff = 0.0, e_sig = 0.0;
+        for (size_t i=0, n=a.size(); i<n; ++i)
+        {
+            double d    = double(a[i]) - double(b[i]);
+            e_diff     += d * d;
+            e_sig      += double(a[i]) * double(a[i]);
+        }
+
+        if (e_diff <= e_sig * (EXT_TOLERANCE * EXT_TOLERANCE))
+            return true;
+
+        // Locate the differing sample for the report
+        a.equals_relative(b, EXT_TOLERANCE);
+        return false;
+    }
+
     void call(const char *label, size_t align, packed_fft_t func1, packed_fft_t func2)
     {
         if (!UTEST_SUPPORTED(func1))
@@ -81,10 +107,12 @@ UTEST_BEGIN("dsp.fft", pfft)
 
         for (int same=0; same < 2; ++same)
         {
-            for (size_t rank=6; rank<=16; ++rank)
+            for (size_t rank=6; rank<=MAX_EXT_RANK; ++rank)
             {
                 size_t count = 1 << (rank + 1);
-                for (size_t mask=0; mask <= 0x03; ++mask)
+                // Large ranks are tested with aligned buffers only to save the time
+                size_t max_mask = (rank <= MAX_RANK) ? 0x03 : 0x00;
+                for (size_t mask=0; mask <= max_mask; ++mask)
                 {
                     FloatBuffer src(count, align, mask & 0x01);
                     FloatBuffer dst1(count, align, mask & 0x02);
@@ -110,7 +138,7 @@ UTEST_BEGIN("dsp.fft", pfft)
                     UTEST_ASSERT_MSG(dst2.valid(), "Destination buffer 2 corrupted");
 
                     // Compare buffers
-                    if ((!dst1.equals_adaptive(dst2, TOLERANCE)))
+                    if (!equals(dst1, dst2, rank))
                     {
                         ssize_t diff = dst1.last_diff();
                         src.dump("src ");
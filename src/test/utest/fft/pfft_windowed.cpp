@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 6 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define TOLERANCE       5e-2
+#define MAX_RANK        16
+#define MAX_EXT_RANK    19
+#define EXT_TOLERANCE   1e-3
+
+namespace lsp
+{
+    namespace generic
+    {
+        void packed_direct_fft_windowed(float *dst, const float *src, const float *window, size_t rank);
+        void packed_reverse_fft_add(float *dst, float *src, const float *window, size_t rank);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void packed_direct_fft_windowed(float *dst, const float *src, const float *window, size_t rank);
+            void packed_reverse_fft_add(float *dst, float *src, const float *window, size_t rank);
+        }
+
+        namespace avx
+        {
+            void packed_direct_fft_windowed(float *dst, const float *src, const float *window, size_t rank);
+            void packed_reverse_fft_add(float *dst, float *src, const float *window, size_t rank);
+
+            void packed_direct_fft_windowed_fma3(float *dst, const float *src, const float *window, size_t rank);
+            void packed_reverse_fft_add_fma3(float *dst, float *src, const float *window, size_t rank);
+        }
+    )
+}
+
+typedef void (* packed_fft_windowed_t)(float *dst, const float *src, const float *window, size_t rank);
+typedef void (* packed_fft_add_t)(float *dst, float *src, const float *window, size_t rank);
+
+UTEST_BEGIN("dsp.fft", pfft_windowed)
+
+    // Large transforms are compared by the energy of the difference since
+    // the rounding errors are spread among all the samples
+    bool equals(FloatBuffer &a, FloatBuffer &b, size_t rank)
+    {
+        if (rank <= MAX_RANK)
+            return a.equals_adaptive(b, TOLERANCE);
+
+        double e_diff = 0.0, e_sig = 0.0;
+        for (size_t i=0, n=a.size(); i<n; ++i)
+        {
+            double d    = double(a[i]) - double(b[i]);
+            e_diff     += d * d;
+            e_sig      += double(a[i]) * double(a[i]);
+        }
+
+        if (e_diff <= e_sig * (EXT_TOLERANCE * EXT_TOLERANCE))
+            return true;
+
+        // Locate the differing sample for the report
+        a.equals_relative(b, EXT_TOLERANCE);
+        return false;
+    }
+
+    void compare(const char *label, FloatBuffer &src, FloatBuffer &dst1, FloatBuffer &dst2, size_t rank)
+    {
+        UTEST_ASSERT_MSG(dst1.valid(), "Destination buffer 1 corrupted");
+        UTEST_ASSERT_MSG(dst2.valid(), "Destination buffer 2 corrupted");
+
+        if (!equals(dst1, dst2, rank))
+        {
+            ssize_t diff = dst1.last_diff();
+            src.dump("src ");
+            dst1.dump("dst1");
+            dst2.dump("dst2");
+            UTEST_FAIL_MSG("Output of functions for test '%s' differs at sample %d (%.5f vs %.5f)",
+                    label, int(diff), dst1.get(diff), dst2.get(diff));
+        }
+    }
+
+    void call(const char *label, size_t align, packed_fft_windowed_t func1, packed_fft_windowed_t func2)
+    {
+        if (!UTEST_SUPPORTED(func1))
+            return;
+        if (!UTEST_SUPPORTED(func2))
+            return;
+
+        for (int same=0; same < 2; ++same)
+        {
+            for (size_t rank=0; rank<=MAX_EXT_RANK; ++rank)
+            {
+                size_t count = 1 << (rank + 1);
+                // Large ranks are tested with aligned buffers only to save the time
+                size_t max_mask = (rank <= MAX_RANK) ? 0x03 : 0x00;
+                for (size_t mask=0; mask <= max_mask; ++mask)
+                {
+                    FloatBuffer src(count, align, mask & 0x01);
+                    FloatBuffer wnd(1 << rank, align, mask & 0x01);
+                    FloatBuffer dst1(count, align, mask & 0x02);
+                    FloatBuffer dst2(dst1);
+
+                    printf("Testing '%s' for rank=%d, mask=0x%x, same=%s...\n", label, int(rank), int(mask), (same) ? "true" : "false");
+
+                    if (same)
+                    {
+                        dsp::copy(dst1, src, count);
+                        dsp::copy(dst2, src, count);
+                        func1(dst1, dst1, wnd, rank);
+                        func2(dst2, dst2, wnd, rank);
+                    }
+                    else
+                    {
+                        func1(dst1, src, wnd, rank);
+                        func2(dst2, src, wnd, rank);
+                    }
+
+                    UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+                    UTEST_ASSERT_MSG(wnd.valid(), "Window buffer corrupted");
+                    compare(label, src, dst1, dst2, rank);
+                }
+            }
+        }
+    }
+
+    void call(const char *label, size_t align, packed_fft_add_t func1, packed_fft_add_t func2)
+    {
+        if (!UTEST_SUPPORTED(func1))
+            return;
+        if (!UTEST_SUPPORTED(func2))
+            return;
+
+        for (size_t rank=0; rank<=MAX_EXT_RANK; ++rank)
+        {
+            size_t count = 1 << (rank + 1);
+            size_t max_mask = (rank <= MAX_RANK) ? 0x03 : 0x00;
+            for (size_t mask=0; mask <= max_mask; ++mask)
+            {
+                FloatBuffer src(count, align, mask & 0x01);
+                FloatBuffer wnd(1 << rank, align, mask & 0x01);
+                FloatBuffer tmp1(src);
+                FloatBuffer tmp2(src);
+                FloatBuffer dst1(count, align, mask & 0x02);
+                FloatBuffer dst2(dst1);
+
+                printf("Testing '%s' for rank=%d, mask=0x%x...\n", label, int(rank), int(mask));
+
+                func1(dst1, tmp1, wnd, rank);
+                func2(dst2, tmp2, wnd, rank);
+
+                UTEST_ASSERT_MSG(tmp1.valid(), "Source buffer 1 corrupted");
+                UTEST_ASSERT_MSG(tmp2.valid(), "Source buffer 2 corrupted");
+                UTEST_ASSERT_MSG(wnd.valid(), "Window buffer corrupted");
+                compare(label, src, dst1, dst2, rank);
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        #define CALL(generic, func, align) \
+            call(#func, align, generic, func)
+
+        // Do tests
+        IF_ARCH_X86(CALL(generic::packed_direct_fft_windowed, sse::packed_direct_fft_windowed, 16));
+        IF_ARCH_X86(CALL(generic::packed_reverse_fft_add, sse::packed_reverse_fft_add, 16));
+        IF_ARCH_X86(CALL(generic::packed_direct_fft_windowed, avx::packed_direct_fft_windowed, 32));
+        IF_ARCH_X86(CALL(generic::packed_reverse_fft_add, avx::packed_reverse_fft_add, 32));
+        IF_ARCH_X86(CALL(generic::packed_direct_fft_windowed, avx::packed_direct_fft_windowed_fma3, 32));
+        IF_ARCH_X86(CALL(generic::packed_reverse_fft_add, avx::packed_reverse_fft_add_fma3, 32));
+    }
+UTEST_END;
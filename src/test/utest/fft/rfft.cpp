@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 24 окт. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define TOLERANCE       5e-2
+#define MAX_RANK        16
+#define MAX_EXT_RANK    20
+#define EXT_TOLERANCE   1e-3
+
+namespace lsp
+{
+    namespace generic
+    {
+        void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+
+        void real_direct_fft(float *dst_re, float *dst_im, const float *src, size_t rank);
+        void packed_real_direct_fft(float *dst, const float *src, size_t rank);
+        void real_reverse_fft(float *dst, const float *src_re, const float *src_im, size_t rank);
+        void packed_real_reverse_fft(float *dst, const float *src, size_t rank);
+    }
+
+    IF_ARCH_X86(
+        namespace avx
+        {
+            void real_direct_fft(float *dst_re, float *dst_im, const float *src, size_t rank);
+            void packed_real_direct_fft(float *dst, const float *src, size_t rank);
+            void real_reverse_fft(float *dst, const float *src_re, const float *src_im, size_t rank);
+            void packed_real_reverse_fft(float *dst, const float *src, size_t rank);
+
+            void real_direct_fft_fma3(float *dst_re, float *dst_im, const float *src, size_t rank);
+            void packed_real_direct_fft_fma3(float *dst, const float *src, size_t rank);
+            void real_reverse_fft_fma3(float *dst, const float *src_re, const float *src_im, size_t rank);
+            void packed_real_reverse_fft_fma3(float *dst, const float *src, size_t rank);
+        }
+    )
+}
+
+typedef void (* real_direct_fft_t)(float *dst_re, float *dst_im, const float *src, size_t rank);
+typedef void (* packed_real_direct_fft_t)(float *dst, const float *src, size_t rank);
+typedef void (* real_reverse_fft_t)(float *dst, const float *src_re, const float *src_im, size_t rank);
+typedef void (* packed_real_reverse_fft_t)(float *dst, const float *src, size_t rank);
+
+UTEST_BEGIN("dsp.fft", rfft)
+
+    // Large transforms are compared by the energy of the difference since
+    // the rounding errors are spread among all the samples
+    bool equals(FloatBuffer &a, FloatBuffer &b, size_t rank)
+    {
+        if (rank <= MAX_RANK)
+            return a.equals_adaptive(b, TOLERANCE);
+
+        double e_diff = 0.0, e_sig = 0.0;
+        for (size_t i=0, n=a.size(); i<n; ++i)
+        {
+            double d    = double(a[i]) - double(b[i]);
+            e_diff     += d * d;
+            e_sig      += double(a[i]) * double(a[i]);
+        }
+
+        if (e_diff <= e_sig * (EXT_TOLERANCE * EXT_TOLERANCE))
+            return true;
+
+        // Locate the differing sample for the report
+        a.equals_relative(b, EXT_TOLERANCE);
+        return false;
+    }
+
+    void check_buffers(const char *label, FloatBuffer &src, FloatBuffer &dst1, FloatBuffer &dst2, size_t rank)
+    {
+        UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+        UTEST_ASSERT_MSG(dst1.valid(), "Destination buffer 1 corrupted");
+        UTEST_ASSERT_MSG(dst2.valid(), "Destination buffer 2 corrupted");
+
+        if (!equals(dst1, dst2, rank))
+        {
+            ssize_t diff = dst1.last_diff();
+            src.dump("src ");
+            dst1.dump("dst1");
+            dst2.dump("dst2");
+            UTEST_FAIL_MSG("Output of functions for test '%s' differs at sample %d (%.5f vs %.5f)",
+                    label, int(diff), dst1.get(diff), dst2.get(diff));
+        }
+    }
+
+    // Compare real FFT with the complex FFT
+    void test_reference()
+    {
+        for (size_t rank=0; rank<=MAX_EXT_RANK; ++rank)
+        {
+            size_t count    = 1 << rank;
+            size_t bins     = (count >> 1) + 1;
+
+            printf("Testing reference for rank=%d...\n", int(rank));
+
+            FloatBuffer src(count, 16, true);
+            FloatBuffer zero(count, 16, true);
+            FloatBuffer fft_re(count, 16, true);
+            FloatBuffer fft_im(count, 16, true);
+            FloatBuffer dst1(bins*2, 16, true);
+            FloatBuffer dst2(bins*2, 16, true);
+            FloatBuffer dst3(bins*2, 16, true);
+            FloatBuffer sig1(count, 16, true);
+            FloatBuffer sig2(count, 16, true);
+
+            // Compute reference spectrum
+            dsp::fill_zero(zero, count);
+            generic::direct_fft(fft_re, fft_im, src, zero, rank);
+            dsp::copy(&dst1[0], fft_re, bins);
+            dsp::copy(&dst1[bins], fft_im, bins);
+
+            // Compute spectrum of real signal
+            generic::real_direct_fft(&dst2[0], &dst2[bins], src, rank);
+            check_buffers("real_direct_fft", src, dst1, dst2, rank);
+
+            generic::packed_real_direct_fft(dst3, src, rank);
+            for (size_t i=0; i<bins; ++i)
+            {
+                dst2[i]         = dst3[i*2];
+                dst2[i + bins]  = dst3[i*2 + 1];
+            }
+            check_buffers("packed_real_direct_fft", src, dst1, dst2, rank);
+
+            // Restore the signal
+            dsp::copy(sig1, src, count);
+            generic::real_reverse_fft(sig2, &dst1[0], &dst1[bins], rank);
+            check_buffers("real_reverse_fft", src, sig1, sig2, rank);
+
+            generic::packed_real_reverse_fft(sig2, dst3, rank);
+            check_buffers("packed_real_reverse_fft", src, sig1, sig2, rank);
+        }
+    }
+
+    void call(const char *label, size_t align, real_direct_fft_t func1, real_direct_fft_t func2)
+    {
+        if (!UTEST_SUPPORTED(func1))
+            return;
+        if (!UTEST_SUPPORTED(func2))
+            return;
+
+        for (size_t rank=0; rank<=MAX_EXT_RANK; ++rank)
+        {
+            size_t count    = 1 << rank;
+            size_t bins     = (count >> 1) + 1;
+            for (size_t mask=0; mask <= 0x03; ++mask)
+            {
+                printf("Testing '%s' for rank=%d, mask=0x%x...\n", label, int(rank), int(mask));
+
+                FloatBuffer src(count, align, mask & 0x01);
+                FloatBuffer dst1(bins*2, align, mask & 0x02);
+                FloatBuffer dst2(dst1);
+
+                func1(&dst1[0], &dst1[bins], src, rank);
+                func2(&dst2[0], &dst2[bins], src, rank);
+
+                check_buffers(label, src, dst1, dst2, rank);
+            }
+        }
+    }
+
+    void call(const char *label, size_t align, packed_real_direct_fft_t func1, packed_real_direct_fft_t func2)
+    {
+        if (!UTEST_SUPPORTED(func1))
+            return;
+        if (!UTEST_SUPPORTED(func2))
+            return;
+
+        for (size_t rank=0; rank<=MAX_EXT_RANK; ++rank)
+        {
+            size_t count    = 1 << rank;
+            size_t bins     = (count >> 1) + 1;
+            for (size_t mask=0; mask <= 0x03; ++mask)
+            {
+                printf("Testing '%s' for rank=%d, mask=0x%x...\n", label, int(rank), int(mask));
+
+                FloatBuffer src(count, align, mask & 0x01);
+                FloatBuffer dst1(bins*2, align, mask & 0x02);
+                FloatBuffer dst2(dst1);
+
+                func1(dst1, src, rank);
+                func2(dst2, src, rank);
+
+                check_buffers(label, src, dst1, dst2, rank);
+            }
+        }
+    }
+
+    void call(const char *label, size_t align, real_reverse_fft_t func1, real_reverse_fft_t func2)
+    {
+        if (!UTEST_SUPPORTED(func1))
+            return;
+        if (!UTEST_SUPPORTED(func2))
+            return;
+
+        for (size_t rank=0; rank<=MAX_EXT_RANK; ++rank)
+        {
+            size_t count    = 1 << rank;
+            size_t bins     = (count >> 1) + 1;
+            for (size_t mask=0; mask <= 0x03; ++mask)
+            {
+                printf("Testing '%s' for rank=%d, mask=0x%x...\n", label, int(rank), int(mask));
+
+                FloatBuffer src(bins*2, align, mask & 0x01);
+                FloatBuffer dst1(count, align, mask & 0x02);
+                FloatBuffer dst2(dst1);
+
+                func1(dst1, &src[0], &src[bins], rank);
+                func2(dst2, &src[0], &src[bins], rank);
+
+                check_buffers(label, src, dst1, dst2, rank);
+            }
+        }
+    }
+
+    void call_packed_reverse(const char *label, size_t align, packed_real_reverse_fft_t func1, packed_real_reverse_fft_t func2)
+    {
+        if (!UTEST_SUPPORTED(func1))
+            return;
+        if (!UTEST_SUPPORTED(func2))
+            return;
+
+        for (size_t rank=0; rank<=MAX_EXT_RANK; ++rank)
+        {
+            size_t count    = 1 << rank;
+            size_t bins     = (count >> 1) + 1;
+            for (size_t mask=0; mask <= 0x03; ++mask)
+            {
+                printf("Testing '%s' for rank=%d, mask=0x%x...\n", label, int(rank), int(mask));
+
+                FloatBuffer src(bins*2, align, mask & 0x01);
+                FloatBuffer dst1(count, align, mask & 0x02);
+                FloatBuffer dst2(dst1);
+
+                func1(dst1, src, rank);
+                func2(dst2, src, rank);
+
+                check_buffers(label, src, dst1, dst2, rank);
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        #define CALL(generic, func, align) \
+            call(#func, align, generic, func)
+        #define CALL_PR(generic, func, align) \
+            call_packed_reverse(#func, align, generic, func)
+
+        // Test generic implementation against the complex FFT
+        test_reference();
+
+        // Test optimized implementations
+        IF_ARCH_X86(CALL(generic::real_direct_fft, avx::real_direct_fft, 32));
+        IF_ARCH_X86(CALL(generic::packed_real_direct_fft, avx::packed_real_direct_fft, 32));
+        IF_ARCH_X86(CALL(generic::real_reverse_fft, avx::real_reverse_fft, 32));
+        IF_ARCH_X86(CALL_PR(generic::packed_real_reverse_fft, avx::packed_real_reverse_fft, 32));
+        IF_ARCH_X86(CALL(generic::real_direct_fft, avx::real_direct_fft_fma3, 32));
+        IF_ARCH_X86(CALL(generic::packed_real_direct_fft, avx::packed_real_direct_fft_fma3, 32));
+        IF_ARCH_X86(CALL(generic::real_reverse_fft, avx::real_reverse_fft_fma3, 32));
+        IF_ARCH_X86(CALL_PR(generic::packed_real_reverse_fft, avx::packed_real_reverse_fft_fma3, 32));
+    }
+UTEST_END;
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 5 нояб. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define TOLERANCE       1e-3
+#define MIN_RANK        2
+#define MAX_RANK        12
+#define SIGNAL_LENGTH   0x4000
+
+namespace
+{
+    typedef struct frame_check_t
+    {
+        const float    *src;        // The source signal
+        const float    *window;     // The analysis window
+        float          *sig;        // Buffer for the windowed signal
+        float          *spec;       // Buffer for the reference spectrum
+        size_t          hop;        // Distance between frames
+        size_t          frames;     // Number of processed frames
+        size_t          errors;     // Number of invalid frames
+    } frame_check_t;
+
+    void check_frame(void *arg, float *frame, size_t rank)
+    {
+        frame_check_t *fc   = static_cast<frame_check_t *>(arg);
+        size_t count        = 1 << rank;
+        ssize_t last        = (fc->frames + 1) * fc->hop;
+
+        // Compute the reference spectrum of the last frame
+        for (size_t i=0; i<count; ++i)
+        {
+            ssize_t idx     = last - count + i;
+            fc->sig[i]      = (idx >= 0) ? fc->src[idx] * fc->window[i] : 0.0f;
+        }
+        lsp::dsp::packed_real_direct_fft(fc->spec, fc->sig, rank);
+
+        for (size_t i=0, n=count + 2; i<n; ++i)
+        {
+            if (!lsp::float_equals_adaptive(frame[i], fc->spec[i], TOLERANCE))
+            {
+                ++fc->errors;
+                break;
+            }
+        }
+
+        ++fc->frames;
+    }
+}
+
+UTEST_BEGIN("dsp.fft", stft)
+
+    void test_window(const char *label, dsp::stft_window_t window, float param, size_t hop_div)
+    {
+        for (size_t rank=MIN_RANK; rank<=MAX_RANK; ++rank)
+        {
+            size_t count    = 1 << rank;
+            size_t hop      = count / hop_div;
+
+            printf("Testing '%s' for rank=%d, hop=%d...\n", label, int(rank), int(hop));
+
+            FloatBuffer buf(dsp::stft_buffer_size(rank), 64, true);
+            FloatBuffer src(SIGNAL_LENGTH, 16, true);
+            FloatBuffer dst(SIGNAL_LENGTH, 16, true);
+            FloatBuffer inplace(src);
+            FloatBuffer sig(count, 16, true);
+            FloatBuffer spec(count + 2, 16, true);
+
+            dsp::stft_t st;
+            UTEST_ASSERT(dsp::stft_init(&st, buf, rank, hop, window, param));
+
+            // Analysis: check the spectrum of each frame
+            frame_check_t fc;
+            fc.src          = src;
+            fc.window       = st.wa;
+            fc.sig          = sig;
+            fc.spec         = spec;
+            fc.hop          = hop;
+            fc.frames       = 0;
+            fc.errors       = 0;
+
+            // Synthesis: the output should be the source delayed by the length of the frame.
+            // Process the signal by blocks of varying size
+            for (size_t off=0, step=1; off < SIGNAL_LENGTH; step = (step * 7 + 3) % 97 + 1)
+            {
+                size_t to_do    = lsp_min(step, SIGNAL_LENGTH - off);
+                dsp::stft_process(&st, &dst[off], &src[off], to_do, check_frame, &fc);
+                off            += to_do;
+            }
+
+            UTEST_ASSERT_MSG(buf.valid(), "Engine buffer corrupted");
+            UTEST_ASSERT_MSG(dst.valid(), "Destination buffer corrupted");
+            UTEST_ASSERT_MSG(fc.frames == SIGNAL_LENGTH / hop,
+                "Invalid number of frames: %d, expected %d", int(fc.frames), int(SIGNAL_LENGTH / hop));
+            UTEST_ASSERT_MSG(fc.errors == 0, "%d frames of %d have invalid spectrum", int(fc.errors), int(fc.frames));
+
+            for (size_t i=0; i<SIGNAL_LENGTH; ++i)
+            {
+                float v     = (i >= count) ? src[i - count] : 0.0f;
+                if (!float_equals_adaptive(dst[i], v, TOLERANCE))
+                    UTEST_FAIL_MSG("Output of '%s' differs at sample %d (%.6f vs %.6f)",
+                        label, int(i), dst[i], v);
+            }
+
+            // In-place processing without the frame function
+            dsp::stft_reset(&st);
+            dsp::stft_process(&st, inplace, inplace, SIGNAL_LENGTH, NULL, NULL);
+            UTEST_ASSERT_MSG(inplace.valid(), "In-place buffer corrupted");
+            for (size_t i=0; i<SIGNAL_LENGTH; ++i)
+            {
+                if (!float_equals_adaptive(inplace[i], dst[i], TOLERANCE))
+                    UTEST_FAIL_MSG("In-place output of '%s' differs at sample %d (%.6f vs %.6f)",
+                        label, int(i), inplace[i], dst[i]);
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        dsp::stft_t st;
+        FloatBuffer buf(dsp::stft_buffer_size(4), 64, true);
+        UTEST_ASSERT(!dsp::stft_init(&st, buf, 1, 1, dsp::STFT_WND_HANN, 0.0f));
+        UTEST_ASSERT(!dsp::stft_init(&st, buf, 4, 0, dsp::STFT_WND_HANN, 0.0f));
+        UTEST_ASSERT(!dsp::stft_init(&st, buf, 4, 3, dsp::STFT_WND_HANN, 0.0f));
+        UTEST_ASSERT(!dsp::stft_init(&st, buf, 4, 32, dsp::STFT_WND_HANN, 0.0f));
+
+        test_window("rectangular", dsp::STFT_WND_RECTANGULAR, 0.0f, 1);
+        test_window("rectangular", dsp::STFT_WND_RECTANGULAR, 0.0f, 2);
+        test_window("hann", dsp::STFT_WND_HANN, 0.0f, 2);
+        test_window("hann", dsp::STFT_WND_HANN, 0.0f, 4);
+        test_window("hamming", dsp::STFT_WND_HAMMING, 0.0f, 4);
+        test_window("blackman_harris", dsp::STFT_WND_BLACKMAN_HARRIS, 0.0f, 4);
+        test_window("kaiser", dsp::STFT_WND_KAISER, 8.0f, 4);
+    }
+
+UTEST_END
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 10 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define TOLERANCE       1e-3f
+#define MAX_FILTERS     4
+
+namespace lsp
+{
+    namespace generic
+    {
+        void biquad_process_x1(float *dst, const float *src, size_t count, dsp::biquad_t *f);
+
+        void biquad_block_init(dsp::biquad_block_t *dst, const dsp::biquad_x1_t *src, size_t n);
+        void biquad_block_process(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void biquad_block_process(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n);
+        }
+
+        namespace avx
+        {
+            void biquad_block_process(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n);
+            void biquad_block_process_fma3(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n);
+        }
+    )
+
+    typedef void (* biquad_block_process_t)(float *dst, const float *src, size_t count, dsp::biquad_block_t *f, size_t n);
+}
+
+UTEST_BEGIN("dsp.filters", block)
+
+    /*
+     * The first filter is the same 2 zero, 2 pole hi-pass filter as used by the test
+     * of static filters, other filters are peak filters with different parameters
+     */
+    void init_filter(dsp::biquad_x1_t *bq, size_t k)
+    {
+        if (k == 0)
+        {
+            bq->b0          = 0.992303491f;
+            bq->b1          = -1.98460698f;
+            bq->b2          = 0.992303491f;
+            bq->a1          = 1.98398674f;
+            bq->a2          = -0.985227287f;
+        }
+        else
+        {
+            float w         = M_PI * (0.02f + 0.15f * k);
+            float gain      = 0.25f + 0.75f * k;
+            float q         = 0.5f + 0.5f * k;
+            float alpha     = sinf(w) / (2.0f * q);
+            float A         = sqrtf(gain);
+            float c         = cosf(w);
+            float a0        = 1.0f / (1.0f + alpha / A);
+
+            bq->b0          = (1.0f + alpha * A) * a0;
+            bq->b1          = -2.0f * c * a0;
+            bq->b2          = (1.0f - alpha * A) * a0;
+            bq->a1          = 2.0f * c * a0;
+            bq->a2          = -(1.0f - alpha / A) * a0;
+        }
+        bq->p0          = 0.0f;
+        bq->p1          = 0.0f;
+        bq->p2          = 0.0f;
+    }
+
+    void validate(const char *label, FloatBuffer &ref, FloatBuffer &out)
+    {
+        UTEST_ASSERT_MSG(out.valid(), "Destination buffer corrupted");
+        if (!ref.equals_adaptive(out, TOLERANCE))
+        {
+            ref.dump("ref");
+            out.dump("out");
+            UTEST_FAIL_MSG("Output of function '%s' differs at sample %d: %.6f vs %.6f",
+                label, int(ref.last_diff()), ref.get_diff(), out.get_diff());
+        }
+    }
+
+    void call(const char *label, biquad_block_process_t func)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        UTEST_FOREACH(count, 0, 1, 3, 7, 8, 9, 16, 31, 0x40, 0x1ff, 0x400)
+        {
+            for (size_t n=1; n<=MAX_FILTERS; ++n)
+            {
+                printf("Testing %s for %d samples, %d filters...\n", label, int(count), int(n));
+
+                // Prepare filters
+                dsp::biquad_x1_t bq[MAX_FILTERS];
+                for (size_t k=0; k<n; ++k)
+                    init_filter(&bq[k], k);
+
+                void *pf = NULL;
+                dsp::biquad_block_t *f  = alloc_aligned<dsp::biquad_block_t>(pf, n, 64);
+                UTEST_ASSERT_MSG(f != NULL, "Out of memory");
+
+                // Compute the reference output
+                FloatBuffer src(count);
+                src.randomize_sign();
+                FloatBuffer ref(src);
+                dsp::biquad_t bf __lsp_aligned64;
+                for (size_t k=0; k<n; ++k)
+                {
+                    bf.x1           = bq[k];
+                    dsp::fill_zero(bf.d, LSP_DSP_BIQUAD_D_ITEMS);
+                    generic::biquad_process_x1(ref, ref, count, &bf);
+                }
+
+                // Process the data by two parts to check the state of the filter
+                size_t part     = (count * 3) / 7;
+                FloatBuffer dst(count);
+                generic::biquad_block_init(f, bq, n);
+                func(dst, src, part, f, n);
+                func(dst.data(part), src.data(part), count - part, f, n);
+                UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+                validate(label, ref, dst);
+
+                // Process the data in-place
+                FloatBuffer inplace(src);
+                generic::biquad_block_init(f, bq, n);
+                func(inplace, inplace, count, f, n);
+                validate(label, ref, inplace);
+
+                free_aligned(pf);
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        #define CALL(func) \
+            call(#func, func)
+
+        CALL(generic::biquad_block_process);
+        IF_ARCH_X86(CALL(sse::biquad_block_process));
+        IF_ARCH_X86(CALL(avx::biquad_block_process));
+        IF_ARCH_X86(CALL(avx::biquad_block_process_fma3));
+    }
+
+UTEST_END
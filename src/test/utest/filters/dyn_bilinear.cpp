@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 14 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define TOLERANCE           1e-5f
+#define CASCADE_FLOATS      (sizeof(dsp::f_cascade_t) / sizeof(float))
+#define BIQUAD_X8_FLOATS    (sizeof(dsp::biquad_x8_t) / sizeof(float))
+
+namespace lsp
+{
+    namespace generic
+    {
+        void bilinear_transform_x8(dsp::biquad_x8_t *bf, const dsp::f_cascade_t *bc, float kf, size_t count);
+        void dyn_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+        void dyn_bilinear_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::f_cascade_t *bc, const float *kf);
+    }
+
+    IF_ARCH_X86_64(
+        namespace avx
+        {
+            void x64_dyn_bilinear_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::f_cascade_t *bc, const float *kf);
+            void x64_dyn_bilinear_biquad_process_x8_fma3(float *dst, const float *src, float *d, size_t count, const dsp::f_cascade_t *bc, const float *kf);
+        }
+    )
+
+    typedef void (* dyn_bilinear_biquad_process_x8_t)(float *dst, const float *src, float *d, size_t count, const dsp::f_cascade_t *bc, const float *kf);
+}
+
+UTEST_BEGIN("dsp.filters", dyn_bilinear)
+
+    /*
+     * Fill the matrix of cascades with peak filters which change their gain
+     * and quality from row to row, and the frequency shift coefficients.
+     * Boost and cut filters alternate, so the gain of the whole chain stays bounded
+     */
+    void init_matrix(dsp::f_cascade_t *bc, float *kf, size_t rows)
+    {
+        for (size_t r=0; r<rows; ++r)
+        {
+            float x         = float(r) / rows;
+            kf[r]           = 0.5f + 4.0f * x;
+
+            for (size_t j=0; j<8; ++j, ++bc)
+            {
+                float A         = 1.1f + 0.05f * j + 0.2f * x;
+                float q         = 0.5f + 0.25f * ((r + j) % 4);
+                if (j & 1)
+                    A               = 1.0f / A;
+
+                bc->t[0]        = 1.0f;
+                bc->t[1]        = A / q;
+                bc->t[2]        = 1.0f;
+                bc->t[3]        = 0.0f;
+                bc->b[0]        = 1.0f;
+                bc->b[1]        = 1.0f / (A * q);
+                bc->b[2]        = 1.0f;
+                bc->b[3]        = 0.0f;
+            }
+        }
+    }
+
+    /*
+     * Compare the output with the reference, the error is measured relative to the peak
+     * value of the reference signal since the relative error of samples near zero crossings
+     * is meaningless
+     */
+    ssize_t compare(const float *ref, const float *dst, size_t count)
+    {
+        float peak      = 1.0f;
+        for (size_t i=0; i<count; ++i)
+            peak            = lsp_max(peak, fabsf(ref[i]));
+
+        const float eps = TOLERANCE * peak;
+        for (size_t i=0; i<count; ++i)
+        {
+            if (fabsf(ref[i] - dst[i]) > eps)
+                return i;
+        }
+
+        return -1;
+    }
+
+    void call(const char *label, dyn_bilinear_biquad_process_x8_t func)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        UTEST_FOREACH(count, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 15, 16, 0x1f, 0x40, 0x1ff)
+        {
+            printf("Testing %s for %d samples...\n", label, int(count));
+
+            // Two sequential calls with different matrices
+            size_t rows     = count + 7;
+            FloatBuffer bc1(rows * 8 * CASCADE_FLOATS, 64, true);
+            FloatBuffer bc2(rows * 8 * CASCADE_FLOATS, 64, true);
+            FloatBuffer kf1(rows);
+            FloatBuffer kf2(rows);
+            FloatBuffer bf(rows * BIQUAD_X8_FLOATS, 64, true);
+            init_matrix(bc1.data<dsp::f_cascade_t>(), kf1, rows);
+            init_matrix(bc2.data<dsp::f_cascade_t>(), kf2, rows);
+            for (size_t i=0; i<rows; ++i)
+                kf2[i]          = 5.0f - kf2[i];
+
+            FloatBuffer src(count * 2);
+            FloatBuffer ref(count * 2);
+            FloatBuffer dst(count * 2);
+            src.randomize_sign();
+
+            // Compute the reference: transform each row with it's own coefficient and apply the filter
+            FloatBuffer d1(LSP_DSP_BIQUAD_D_ITEMS);
+            FloatBuffer d2(LSP_DSP_BIQUAD_D_ITEMS);
+            d1.fill_zero();
+            d2.fill_zero();
+
+            dsp::biquad_x8_t *f = bf.data<dsp::biquad_x8_t>();
+            for (size_t i=0; i<rows; ++i)
+                generic::bilinear_transform_x8(&f[i], &bc1.data<dsp::f_cascade_t>()[i*8], kf1[i], 1);
+            generic::dyn_biquad_process_x8(ref, src, d1, count, f);
+            for (size_t i=0; i<rows; ++i)
+                generic::bilinear_transform_x8(&f[i], &bc2.data<dsp::f_cascade_t>()[i*8], kf2[i], 1);
+            generic::dyn_biquad_process_x8(ref.data(count), src.data(count), d1, count, f);
+
+            // Process the data
+            func(dst, src, d2, count, bc1.data<dsp::f_cascade_t>(), kf1);
+            func(dst.data(count), src.data(count), d2, count, bc2.data<dsp::f_cascade_t>(), kf2);
+
+            UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+            UTEST_ASSERT_MSG(dst.valid(), "Destination buffer corrupted");
+            UTEST_ASSERT_MSG(d2.valid(), "Filter memory corrupted");
+            UTEST_ASSERT_MSG(bc1.valid(), "Cascade matrix 1 corrupted");
+            UTEST_ASSERT_MSG(bc2.valid(), "Cascade matrix 2 corrupted");
+
+            ssize_t diff    = compare(ref, dst, count * 2);
+            if (diff >= 0)
+            {
+                ref.dump("ref");
+                dst.dump("dst");
+                UTEST_FAIL_MSG("Output of function '%s' differs at sample %d: %.6f vs %.6f",
+                    label, int(diff), ref[size_t(diff)], dst[size_t(diff)]);
+            }
+            if (compare(d1, d2, LSP_DSP_BIQUAD_D_ITEMS) >= 0)
+            {
+                d1.dump("d1");
+                d2.dump("d2");
+                UTEST_FAIL_MSG("Filter memory of function '%s' differs", label);
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        #define CALL(func) \
+            call(#func, func)
+
+        CALL(generic::dyn_bilinear_biquad_process_x8);
+        IF_ARCH_X86_64(CALL(avx::x64_dyn_bilinear_biquad_process_x8));
+        IF_ARCH_X86_64(CALL(avx::x64_dyn_bilinear_biquad_process_x8_fma3));
+    }
+
+UTEST_END
@@ -22,12 +22,14 @@
 #include <lsp-plug.in/common/types.h>
 #include <lsp-plug.in/dsp/dsp.h>
 #include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/stdlib/math.h>
 #include <lsp-plug.in/test-fw/utest.h>
 #include <lsp-plug.in/test-fw/helpers.h>
 #include <lsp-plug.in/test-fw/FloatBuffer.h>
 
 #define BUF_SIZE        1024
 #define TOLERANCE       1e-3f
+#define TOLERANCE_X16   1e-4f   /* relative to the RMS of the double-precision reference */
 
 namespace lsp
 {
@@ -37,6 +39,7 @@ namespace lsp
         void dyn_biquad_process_x2(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x2_t *f);
         void dyn_biquad_process_x4(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f);
         void dyn_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+        void dyn_biquad_process_x16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f);
     }
 
     IF_ARCH_X86(
@@ -66,6 +69,14 @@ namespace lsp
 
             void x64_dyn_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
             void dyn_biquad_process_x8_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+
+            void dyn_biquad_process_x16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f);
+            void dyn_biquad_process_x16_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f);
+        }
+
+        namespace avx512
+        {
+            void dyn_biquad_process_x16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f);
         }
     )
 
@@ -93,6 +104,7 @@ namespace lsp
     typedef void (* dyn_biquad_process_x2_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x2_t *f);
     typedef void (* dyn_biquad_process_x4_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f);
     typedef void (* dyn_biquad_process_x8_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+    typedef void (* dyn_biquad_process_x16_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f);
 
     static dsp::biquad_x1_t bq_normal =
     {
@@ -100,6 +112,15 @@ namespace lsp
         1.98398674f, -0.985227287f, // b1-b2
         0.0f, 0.0f, 0.0f // padding
     };
+
+    // The poles are at the radius of 0.9, so the rounding error of 16 cascades does not
+    // grow as much as for the poles close to the unit circle
+    static dsp::biquad_x1_t bq_x16 =
+    {
+        0.98f, -1.70f, 0.75f, // a0 - a2
+        1.7196f, -0.81f, // b1-b2
+        0.0f, 0.0f, 0.0f // padding
+    };
 }
 
 UTEST_BEGIN("dsp.filters", dynamic)
@@ -370,6 +391,99 @@ UTEST_BEGIN("dsp.filters", dynamic)
         }
     }
 
+    void call(const char *label, dyn_biquad_process_x16_t func)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        float d[LSP_DSP_BIQUAD16_D_ITEMS];
+
+        UTEST_FOREACH(count, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 0x1f, 0x40, 0x1ff)
+        {
+            printf("Testing %s on input buffer size=%d...\n", label, int(count));
+
+            FloatBuffer src(count);
+            FloatBuffer dst(count);
+            src.randomize_sign();
+
+            // Initialize filters, the gain of the filter varies between samples
+            void *p1 = NULL, *p2 = NULL;
+            dsp::biquad_x1_t *f1 = alloc_aligned<dsp::biquad_x1_t>(p1, count, 64);
+            dsp::biquad_x16_t *f2 = alloc_aligned<dsp::biquad_x16_t>(p2, count+15, 64);
+            UTEST_ASSERT_MSG(f1 != NULL, "Out of memory while allocating f1");
+            UTEST_ASSERT_MSG(f2 != NULL, "Out of memory while allocating f2");
+
+            for (size_t i=0; i<count; ++i)
+            {
+                float k     = 1.0f + 0.25f * sinf(i * 0.1f);
+                f1[i]       = bq_x16;
+                f1[i].b0   *= k;
+                f1[i].b1   *= k;
+                f1[i].b2   *= k;
+            }
+
+            // The j'th cascade processes i'th sample with the (i+j)'th filter bank
+            for (size_t i=0; i<(count+15); ++i)
+            {
+                for (size_t j=0; j<16; ++j)
+                {
+                    const dsp::biquad_x1_t *bq = ((i >= j) && (i < count + j)) ? &f1[i - j] : &bq_x16;
+                    f2[i].b0[j] = bq->b0;
+                    f2[i].b1[j] = bq->b1;
+                    f2[i].b2[j] = bq->b2;
+                    f2[i].a1[j] = bq->a1;
+                    f2[i].a2[j] = bq->a2;
+                }
+            }
+
+            // Compute the reference output with double precision
+            double *ref = new double[count + 1];
+            for (size_t i=0; i<count; ++i)
+                ref[i]      = src[i];
+            for (size_t j=0; j<16; ++j)
+            {
+                double d0 = 0.0, d1 = 0.0;
+                for (size_t i=0; i<count; ++i)
+                {
+                    const dsp::biquad_x1_t *bq = &f1[i];
+                    double s    = ref[i];
+                    double s2   = bq->b0*s + d0;
+                    d0          = d1 + bq->b1*s + bq->a1*s2;
+                    d1          = bq->b2*s + bq->a2*s2;
+                    ref[i]      = s2;
+                }
+            }
+
+            // Apply processing
+            dsp::fill_zero(d, LSP_DSP_BIQUAD16_D_ITEMS);
+            func(dst, src, d, count, f2);
+
+            // Perform validation, the error is measured relative to the RMS of the reference
+            UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+            UTEST_ASSERT_MSG(dst.valid(), "Destination buffer corrupted");
+
+            double rms = 0.0;
+            for (size_t i=0; i<count; ++i)
+                rms        += ref[i] * ref[i];
+            rms         = sqrt(rms / lsp_max(count, size_t(1)));
+
+            for (size_t i=0; i<count; ++i)
+            {
+                if (fabs(dst[i] - ref[i]) <= TOLERANCE_X16 * rms)
+                    continue;
+
+                src.dump("src");
+                dst.dump("dst");
+                UTEST_FAIL_MSG("Output of functions for test '%s' differs at sample %d: %.6f vs %.6f (rms=%.6f)",
+                        label, int(i), ref[i], dst[i], rms);
+            }
+
+            delete [] ref;
+            free_aligned(p1);
+            free_aligned(p2);
+        }
+    }
+
     UTEST_MAIN
     {
         #define CALL(func) \
@@ -404,6 +518,11 @@ UTEST_BEGIN("dsp.filters", dynamic)
         IF_ARCH_X86(CALL(avx::dyn_biquad_process_x8_fma3));
         IF_ARCH_ARM(CALL(neon_d32::dyn_biquad_process_x8));
         IF_ARCH_AARCH64(CALL(asimd::dyn_biquad_process_x8));
+
+        CALL(generic::dyn_biquad_process_x16);
+        IF_ARCH_X86(CALL(avx::dyn_biquad_process_x16));
+        IF_ARCH_X86(CALL(avx::dyn_biquad_process_x16_fma3));
+        IF_ARCH_X86(CALL(avx512::dyn_biquad_process_x16));
     }
 
 UTEST_END
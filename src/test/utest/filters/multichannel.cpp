@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 7 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define TOLERANCE       1e-4f
+#define MAX_CHANNELS    16
+#define MAX_BANKS       3
+
+namespace lsp
+{
+    namespace generic
+    {
+        void biquad_process_x1(float *dst, const float *src, size_t count, dsp::biquad_t *f);
+
+        void biquad_process_mc4(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n);
+        void biquad_process_mc8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+        void biquad_process_mc16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+        void biquad_process_mc4_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n);
+        void biquad_process_mc8_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+        void biquad_process_mc16_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void biquad_process_mc4(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n);
+            void biquad_process_mc8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+            void biquad_process_mc16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+            void biquad_process_mc4_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n);
+            void biquad_process_mc8_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+            void biquad_process_mc16_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+        }
+
+        namespace avx
+        {
+            void biquad_process_mc8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+            void biquad_process_mc8_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+            void biquad_process_mc16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+            void biquad_process_mc16_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+            void biquad_process_mc8_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+            void biquad_process_mc8_planar_fma3(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+            void biquad_process_mc16_planar(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+            void biquad_process_mc16_planar_fma3(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+        }
+
+        namespace avx512
+        {
+            void biquad_process_mc16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+        }
+    )
+
+    typedef void (* biquad_process_mc4_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n);
+    typedef void (* biquad_process_mc8_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+    typedef void (* biquad_process_mc16_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+    typedef void (* biquad_process_mc4_planar_t)(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x4_t *f, size_t n);
+    typedef void (* biquad_process_mc8_planar_t)(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x8_t *f, size_t n);
+    typedef void (* biquad_process_mc16_planar_t)(float * const *dst, const float * const *src, float *d, size_t count, const dsp::biquad_x16_t *f, size_t n);
+}
+
+UTEST_BEGIN("dsp.filters", multichannel)
+
+    /*
+     * Initialize the filter of j'th channel and k'th bank. Each channel gets the
+     * peak filter with its own frequency, gain and quality factor
+     */
+    void init_filter(dsp::biquad_x1_t *bq, size_t j, size_t k)
+    {
+        float w         = M_PI * (0.01f + 0.02f * j + 0.1f * k);
+        float gain      = 0.5f + 0.15f * ((j + k) % 7);
+        float q         = 0.5f + 0.25f * ((j * 3 + k) % 5);
+        float alpha     = sinf(w) / (2.0f * q);
+        float A         = sqrtf(gain);
+        float c         = cosf(w);
+        float a0        = 1.0f / (1.0f + alpha / A);
+
+        bq->b0          = (1.0f + alpha * A) * a0;
+        bq->b1          = -2.0f * c * a0;
+        bq->b2          = (1.0f - alpha * A) * a0;
+        bq->a1          = 2.0f * c * a0;
+        bq->a2          = -(1.0f - alpha / A) * a0;
+        bq->p0          = 0.0f;
+        bq->p1          = 0.0f;
+        bq->p2          = 0.0f;
+    }
+
+    /*
+     * Fill the multi-channel bank which has 'lanes' coefficients per row
+     */
+    void init_bank(float *f, size_t lanes, size_t k)
+    {
+        dsp::biquad_x1_t bq;
+        for (size_t j=0; j<lanes; ++j)
+        {
+            init_filter(&bq, j, k);
+            f[j]                = bq.b0;
+            f[j + lanes]        = bq.b1;
+            f[j + lanes*2]      = bq.b2;
+            f[j + lanes*3]      = bq.a1;
+            f[j + lanes*4]      = bq.a2;
+        }
+    }
+
+    /*
+     * Compute the reference output of j'th channel using the single biquad filter
+     */
+    void process_reference(float *dst, const float *src, size_t count, size_t j, size_t n)
+    {
+        dsp::biquad_t f __lsp_aligned64;
+
+        for (size_t k=0; k<n; ++k, src = dst)
+        {
+            init_filter(&f.x1, j, k);
+            dsp::fill_zero(f.d, LSP_DSP_BIQUAD_D_ITEMS);
+            generic::biquad_process_x1(dst, src, count, &f);
+        }
+    }
+
+    void validate(const char *label, FloatBuffer &ref, FloatBuffer &out, size_t j)
+    {
+        UTEST_ASSERT_MSG(out.valid(), "Destination buffer corrupted");
+        if (!ref.equals_adaptive(out, TOLERANCE))
+        {
+            ref.dump("ref");
+            out.dump("out");
+            UTEST_FAIL_MSG("Output of function '%s' for channel %d differs at sample %d: %.6f vs %.6f",
+                label, int(j), int(ref.last_diff()), ref.get_diff(), out.get_diff());
+        }
+    }
+
+    void call(const char *label, size_t lanes, void *func, bool planar)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        UTEST_FOREACH(count, 0, 1, 2, 3, 5, 8, 16, 31, 0x40, 0x1ff)
+        {
+            for (size_t n=1; n<=MAX_BANKS; ++n)
+            {
+                printf("Testing %s for %d frames, %d banks...\n", label, int(count), int(n));
+
+                // Prepare the filter banks and the memory
+                void *pf = NULL;
+                float *f    = alloc_aligned<float>(pf, lanes * 5 * n, 64);
+                UTEST_ASSERT_MSG(f != NULL, "Out of memory");
+                for (size_t k=0; k<n; ++k)
+                    init_bank(&f[lanes * 5 * k], lanes, k);
+
+                FloatBuffer d(lanes * 2 * n);
+                d.fill_zero();
+
+                // Prepare the source data and compute the reference output
+                FloatBuffer *src[MAX_CHANNELS], *ref[MAX_CHANNELS];
+                for (size_t j=0; j<lanes; ++j)
+                {
+                    src[j]      = new FloatBuffer(count);
+                    ref[j]      = new FloatBuffer(count);
+                    src[j]->randomize_sign();
+                    process_reference(ref[j]->data(), src[j]->data(), count, j, n);
+                }
+
+                if (planar)
+                {
+                    // Process the half of the data in-place
+                    const float *vs[MAX_CHANNELS];
+                    float *vd[MAX_CHANNELS];
+                    FloatBuffer *dst[MAX_CHANNELS];
+                    for (size_t j=0; j<lanes; ++j)
+                    {
+                        dst[j]      = (j & 1) ? new FloatBuffer(*src[j]) : new FloatBuffer(count);
+                        vs[j]       = (j & 1) ? dst[j]->data() : src[j]->data();
+                        vd[j]       = dst[j]->data();
+                    }
+
+                    // Process the data by two blocks to check the state of the filter
+                    size_t half     = count / 2;
+                    const float *ps[MAX_CHANNELS];
+                    float *pd[MAX_CHANNELS];
+                    for (size_t j=0; j<lanes; ++j)
+                    {
+                        ps[j]       = &vs[j][half];
+                        pd[j]       = &vd[j][half];
+                    }
+
+                    switch (lanes)
+                    {
+                        case 4:
+                            reinterpret_cast<biquad_process_mc4_planar_t>(func)(vd, vs, d, half, reinterpret_cast<dsp::biquad_x4_t *>(f), n);
+                            reinterpret_cast<biquad_process_mc4_planar_t>(func)(pd, ps, d, count - half, reinterpret_cast<dsp::biquad_x4_t *>(f), n);
+                            break;
+                        case 8:
+                            reinterpret_cast<biquad_process_mc8_planar_t>(func)(vd, vs, d, half, reinterpret_cast<dsp::biquad_x8_t *>(f), n);
+                            reinterpret_cast<biquad_process_mc8_planar_t>(func)(pd, ps, d, count - half, reinterpret_cast<dsp::biquad_x8_t *>(f), n);
+                            break;
+                        default:
+                            reinterpret_cast<biquad_process_mc16_planar_t>(func)(vd, vs, d, half, reinterpret_cast<dsp::biquad_x16_t *>(f), n);
+                            reinterpret_cast<biquad_process_mc16_planar_t>(func)(pd, ps, d, count - half, reinterpret_cast<dsp::biquad_x16_t *>(f), n);
+                            break;
+                    }
+
+                    for (size_t j=0; j<lanes; ++j)
+                    {
+                        UTEST_ASSERT_MSG(src[j]->valid(), "Source buffer corrupted");
+                        validate(label, *ref[j], *dst[j], j);
+                        delete dst[j];
+                    }
+                }
+                else
+                {
+                    // Interleave the source data
+                    FloatBuffer isrc(count * lanes);
+                    FloatBuffer idst(count * lanes);
+                    for (size_t i=0; i<count; ++i)
+                        for (size_t j=0; j<lanes; ++j)
+                            isrc[i*lanes + j]   = src[j]->get(i);
+
+                    // Process the data by two blocks to check the state of the filter
+                    size_t half     = count / 2;
+                    switch (lanes)
+                    {
+                        case 4:
+                            reinterpret_cast<biquad_process_mc4_t>(func)(idst, isrc, d, half, reinterpret_cast<dsp::biquad_x4_t *>(f), n);
+                            reinterpret_cast<biquad_process_mc4_t>(func)(idst.data(half * lanes), isrc.data(half * lanes), d, count - half, reinterpret_cast<dsp::biquad_x4_t *>(f), n);
+                            break;
+                        case 8:
+                            reinterpret_cast<biquad_process_mc8_t>(func)(idst, isrc, d, half, reinterpret_cast<dsp::biquad_x8_t *>(f), n);
+                            reinterpret_cast<biquad_process_mc8_t>(func)(idst.data(half * lanes), isrc.data(half * lanes), d, count - half, reinterpret_cast<dsp::biquad_x8_t *>(f), n);
+                            break;
+                        default:
+                            reinterpret_cast<biquad_process_mc16_t>(func)(idst, isrc, d, half, reinterpret_cast<dsp::biquad_x16_t *>(f), n);
+                            reinterpret_cast<biquad_process_mc16_t>(func)(idst.data(half * lanes), isrc.data(half * lanes), d, count - half, reinterpret_cast<dsp::biquad_x16_t *>(f), n);
+                            break;
+                    }
+
+                    UTEST_ASSERT_MSG(isrc.valid(), "Source buffer corrupted");
+                    UTEST_ASSERT_MSG(idst.valid(), "Destination buffer corrupted");
+
+                    // Deinterleave the destination data and validate
+                    for (size_t j=0; j<lanes; ++j)
+                    {
+                        FloatBuffer out(count);
+                        for (size_t i=0; i<count; ++i)
+                            out[i]          = idst[i*lanes + j];
+                        validate(label, *ref[j], out, j);
+                    }
+                }
+
+                UTEST_ASSERT_MSG(d.valid(), "Filter memory corrupted");
+
+                for (size_t j=0; j<lanes; ++j)
+                {
+                    delete src[j];
+                    delete ref[j];
+                }
+                free_aligned(pf);
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        #define CALL(func, lanes, planar) \
+            call(#func, lanes, reinterpret_cast<void *>(func), planar)
+
+        CALL(generic::biquad_process_mc4, 4, false);
+        CALL(generic::biquad_process_mc8, 8, false);
+        CALL(generic::biquad_process_mc16, 16, false);
+        CALL(generic::biquad_process_mc4_planar, 4, true);
+        CALL(generic::biquad_process_mc8_planar, 8, true);
+        CALL(generic::biquad_process_mc16_planar, 16, true);
+
+        IF_ARCH_X86(CALL(sse::biquad_process_mc4, 4, false));
+        IF_ARCH_X86(CALL(sse::biquad_process_mc8, 8, false));
+        IF_ARCH_X86(CALL(sse::biquad_process_mc16, 16, false));
+        IF_ARCH_X86(CALL(sse::biquad_process_mc4_planar, 4, true));
+        IF_ARCH_X86(CALL(sse::biquad_process_mc8_planar, 8, true));
+        IF_ARCH_X86(CALL(sse::biquad_process_mc16_planar, 16, true));
+
+        IF_ARCH_X86(CALL(avx::biquad_process_mc8, 8, false));
+        IF_ARCH_X86(CALL(avx::biquad_process_mc8_fma3, 8, false));
+        IF_ARCH_X86(CALL(avx::biquad_process_mc16, 16, false));
+        IF_ARCH_X86(CALL(avx::biquad_process_mc16_fma3, 16, false));
+        IF_ARCH_X86(CALL(avx::biquad_process_mc8_planar, 8, true));
+        IF_ARCH_X86(CALL(avx::biquad_process_mc8_planar_fma3, 8, true));
+        IF_ARCH_X86(CALL(avx::biquad_process_mc16_planar, 16, true));
+        IF_ARCH_X86(CALL(avx::biquad_process_mc16_planar_fma3, 16, true));
+
+        IF_ARCH_X86(CALL(avx512::biquad_process_mc16, 16, false));
+    }
+
+UTEST_END
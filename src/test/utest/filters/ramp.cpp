@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2023 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2023 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-dsp-lib
+ * Created on: 12 дек. 2023 г.
+ *
+ * lsp-dsp-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-dsp-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-dsp-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/helpers.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+
+#define TOLERANCE       1e-3f
+#define MAX_LANES       16
+
+namespace lsp
+{
+    namespace generic
+    {
+        void dyn_biquad_process_x1(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x1_t *f);
+        void dyn_biquad_process_x2(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x2_t *f);
+        void dyn_biquad_process_x4(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f);
+        void dyn_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+        void dyn_biquad_process_x16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f);
+
+        void ramp_biquad_process_x1(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x1_t *start, const dsp::biquad_x1_t *end, dsp::biquad_x1_t *buf);
+        void ramp_biquad_process_x2(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x2_t *start, const dsp::biquad_x2_t *end, dsp::biquad_x2_t *buf);
+        void ramp_biquad_process_x4(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *start, const dsp::biquad_x4_t *end, dsp::biquad_x4_t *buf);
+        void ramp_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *start, const dsp::biquad_x8_t *end, dsp::biquad_x8_t *buf);
+        void ramp_biquad_process_x16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *start, const dsp::biquad_x16_t *end, dsp::biquad_x16_t *buf);
+    }
+
+    IF_ARCH_X86(
+        namespace sse
+        {
+            void dyn_biquad_process_x1(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x1_t *f);
+            void dyn_biquad_process_x2(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x2_t *f);
+            void dyn_biquad_process_x4(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f);
+            void dyn_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+        }
+
+        namespace sse3
+        {
+            void x64_dyn_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+        }
+
+        namespace avx
+        {
+            void dyn_biquad_process_x1(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x1_t *f);
+            void dyn_biquad_process_x1_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x1_t *f);
+            void dyn_biquad_process_x2(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x2_t *f);
+            void dyn_biquad_process_x2_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x2_t *f);
+            void dyn_biquad_process_x4(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f);
+            void dyn_biquad_process_x4_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f);
+            void x64_dyn_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+            void dyn_biquad_process_x8_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+            void dyn_biquad_process_x16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f);
+            void dyn_biquad_process_x16_fma3(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f);
+        }
+
+        namespace avx512
+        {
+            void dyn_biquad_process_x16(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f);
+        }
+    )
+
+    IF_ARCH_ARM(
+        namespace neon_d32
+        {
+            void dyn_biquad_process_x1(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x1_t *f);
+            void dyn_biquad_process_x2(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x2_t *f);
+            void dyn_biquad_process_x4(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f);
+            void dyn_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+        }
+    )
+
+    IF_ARCH_AARCH64(
+        namespace asimd
+        {
+            void dyn_biquad_process_x1(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x1_t *f);
+            void dyn_biquad_process_x2(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x2_t *f);
+            void dyn_biquad_process_x4(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f);
+            void dyn_biquad_process_x8(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+        }
+    )
+
+    typedef void (* dyn_biquad_process_x1_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x1_t *f);
+    typedef void (* dyn_biquad_process_x2_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x2_t *f);
+    typedef void (* dyn_biquad_process_x4_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x4_t *f);
+    typedef void (* dyn_biquad_process_x8_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x8_t *f);
+    typedef void (* dyn_biquad_process_x16_t)(float *dst, const float *src, float *d, size_t count, const dsp::biquad_x16_t *f);
+
+    /* The layout of all filter banks is the same: b0, b1, b2, a1 and a2 rows of coefficients, then padding */
+    typedef void (* ramp_biquad_process_t)(float *dst, const float *src, float *d, size_t count, const float *start, const float *end, float *buf);
+}
+
+UTEST_BEGIN("dsp.filters", ramp)
+
+    /*
+     * Initialize the peak filter of j'th cascade at the beginning (k = 0) or at the end (k = 1) of the ramp
+     */
+    void init_filter(dsp::biquad_x1_t *bq, size_t j, size_t k)
+    {
+        float w         = M_PI * (0.01f + 0.03f * j + 0.2f * k);
+        float gain      = (k > 0) ? 0.25f + 0.25f * (j % 5) : 2.0f + 0.5f * (j % 3);
+        float q         = 0.5f + 0.25f * ((j + k) % 4);
+        float alpha     = sinf(w) / (2.0f * q);
+        float A         = sqrtf(gain);
+        float c         = cosf(w);
+        float a0        = 1.0f / (1.0f + alpha / A);
+
+        bq->b0          = (1.0f + alpha * A) * a0;
+        bq->b1          = -2.0f * c * a0;
+        bq->b2          = (1.0f - alpha * A) * a0;
+        bq->a1          = 2.0f * c * a0;
+        bq->a2          = -(1.0f - alpha / A) * a0;
+        bq->p0          = 0.0f;
+        bq->p1          = 0.0f;
+        bq->p2          = 0.0f;
+    }
+
+    /*
+     * Fill the filter bank of 'lanes' cascades
+     */
+    void init_bank(float *f, size_t lanes, size_t size, size_t k)
+    {
+        dsp::biquad_x1_t bq;
+        for (size_t j=0; j<lanes; ++j)
+        {
+            init_filter(&bq, j, k);
+            f[j]                = bq.b0;
+            f[j + lanes]        = bq.b1;
+            f[j + lanes*2]      = bq.b2;
+            f[j + lanes*3]      = bq.a1;
+            f[j + lanes*4]      = bq.a2;
+        }
+        for (size_t i=lanes*5; i<size; ++i)
+            f[i]                = 0.0f;
+    }
+
+    /*
+     * Compute the reference output of the j'th cascade using the explicit array of
+     * interpolated filters, k1 and k2 define the start and the end of the ramp
+     */
+    void process_reference(float *dst, const float *src, float *d, size_t count, size_t j, size_t k1, size_t k2)
+    {
+        dsp::biquad_x1_t s, e;
+        init_filter(&s, j, k1);
+        init_filter(&e, j, k2);
+
+        void *p = NULL;
+        dsp::biquad_x1_t *f = alloc_aligned<dsp::biquad_x1_t>(p, lsp_max(count, size_t(1)), 64);
+        UTEST_ASSERT_MSG(f != NULL, "Out of memory");
+
+        const float kt = 1.0f / count;
+        for (size_t i=0; i<count; ++i)
+        {
+            float t         = i * kt;
+            f[i].b0         = s.b0 + (e.b0 - s.b0) * t;
+            f[i].b1         = s.b1 + (e.b1 - s.b1) * t;
+            f[i].b2         = s.b2 + (e.b2 - s.b2) * t;
+            f[i].a1         = s.a1 + (e.a1 - s.a1) * t;
+            f[i].a2         = s.a2 + (e.a2 - s.a2) * t;
+            f[i].p0         = 0.0f;
+            f[i].p1         = 0.0f;
+            f[i].p2         = 0.0f;
+        }
+
+        generic::dyn_biquad_process_x1(dst, src, d, count, f);
+        free_aligned(p);
+    }
+
+    void call(const char *label, size_t lanes, size_t size, ramp_biquad_process_t func)
+    {
+        UTEST_FOREACH(count, 0, 1, 2, 3, 5, 8, 16, 31, 37, 0x40, 0x41, 0x60, 0x1ff, 0x400)
+        {
+            printf("Testing %s for %d samples...\n", label, int(count));
+
+            FloatBuffer fs(size, 64, true);
+            FloatBuffer fe(size, 64, true);
+            FloatBuffer buf((LSP_DSP_RAMP_BIQUAD_CHUNK + lanes - 1) * size, 64, true);
+            init_bank(fs, lanes, size, 0);
+            init_bank(fe, lanes, size, 1);
+
+            FloatBuffer src(count * 2);
+            FloatBuffer ref(count * 2);
+            FloatBuffer dst(count * 2);
+            src.randomize_sign();
+
+            // Compute the reference: ramp from the start to the end filter, then back
+            float rd[2];
+            for (size_t j=0; j<lanes; ++j)
+            {
+                rd[0]           = 0.0f;
+                rd[1]           = 0.0f;
+                process_reference(ref, (j > 0) ? ref.data() : src.data(), rd, count, j, 0, 1);
+                process_reference(ref.data(count), (j > 0) ? ref.data(count) : src.data(count), rd, count, j, 1, 0);
+            }
+
+            // Process the data
+            FloatBuffer d(LSP_DSP_BIQUAD16_D_ITEMS);
+            d.fill_zero();
+            func(dst, src, d, count, fs, fe, buf);
+            func(dst.data(count), src.data(count), d, count, fe, fs, buf);
+
+            UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+            UTEST_ASSERT_MSG(dst.valid(), "Destination buffer corrupted");
+            UTEST_ASSERT_MSG(d.valid(), "Filter memory corrupted");
+            UTEST_ASSERT_MSG(fs.valid(), "Start filter corrupted");
+            UTEST_ASSERT_MSG(fe.valid(), "End filter corrupted");
+            UTEST_ASSERT_MSG(buf.valid(), "Filter buffer corrupted");
+
+            if (!ref.equals_adaptive(dst, TOLERANCE))
+            {
+                ref.dump("ref");
+                dst.dump("dst");
+                UTEST_FAIL_MSG("Output of function '%s' differs at sample %d: %.6f vs %.6f",
+                    label, int(ref.last_diff()), ref.get_diff(), dst.get_diff());
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        // The ramp is implemented once and processes the data with the dispatched
+        // dynamic filter, so replace the dispatched function with each implementation
+        #define CALL(func, lanes) \
+            if (UTEST_SUPPORTED(func)) \
+            { \
+                dyn_biquad_process_x##lanes##_t saved = dsp::dyn_biquad_process_x##lanes; \
+                dsp::dyn_biquad_process_x##lanes = func; \
+                call(#func, lanes, sizeof(dsp::biquad_x##lanes##_t) / sizeof(float), \
+                    reinterpret_cast<ramp_biquad_process_t>(generic::ramp_biquad_process_x##lanes)); \
+                dsp::dyn_biquad_process_x##lanes = saved; \
+            }
+
+        CALL(generic::dyn_biquad_process_x1, 1);
+        CALL(generic::dyn_biquad_process_x2, 2);
+        CALL(generic::dyn_biquad_process_x4, 4);
+        CALL(generic::dyn_biquad_process_x8, 8);
+        CALL(generic::dyn_biquad_process_x16, 16);
+
+        IF_ARCH_X86(CALL(sse::dyn_biquad_process_x1, 1));
+        IF_ARCH_X86(CALL(sse::dyn_biquad_process_x2, 2));
+        IF_ARCH_X86(CALL(sse::dyn_biquad_process_x4, 4));
+        IF_ARCH_X86(CALL(sse::dyn_biquad_process_x8, 8));
+
+        IF_ARCH_X86_64(CALL(sse3::x64_dyn_biquad_process_x8, 8));
+
+        IF_ARCH_X86(CALL(avx::dyn_biquad_process_x1, 1));
+        IF_ARCH_X86(CALL(avx::dyn_biquad_process_x1_fma3, 1));
+        IF_ARCH_X86(CALL(avx::dyn_biquad_process_x2, 2));
+        IF_ARCH_X86(CALL(avx::dyn_biquad_process_x2_fma3, 2));
+        IF_ARCH_X86(CALL(avx::dyn_biquad_process_x4, 4));
+        IF_ARCH_X86(CALL(avx::dyn_biquad_process_x4_fma3, 4));
+        IF_ARCH_X86_64(CALL(avx::x64_dyn_biquad_process_x8, 8));
+        IF_ARCH_X86(CALL(avx::dyn_biquad_process_x8_fma3, 8));
+        IF_ARCH_X86(CALL(avx::dyn_biquad_process_x16, 16));
+        IF_ARCH_X86(CALL(avx::dyn_biquad_process_x16_fma3, 16));
+
+        IF_ARCH_X86(CALL(avx512::dyn_biquad_process_x16, 16));
+
+        IF_ARCH_ARM(CALL(neon_d32::dyn_biquad_process_x1, 1));
+        IF_ARCH_ARM(CALL(neon_d32::dyn_biquad_process_x2, 2));
+        IF_ARCH_ARM(CALL(neon_d32::dyn_biquad_process_x4, 4));
+        IF_ARCH_ARM(CALL(neon_d32::dyn_biquad_process_x8, 8));
+
+        IF_ARCH_AARCH64(CALL(asimd::dyn_biquad_process_x1, 1));
+        IF_ARCH_AARCH64(CALL(asimd::dyn_biquad_process_x2, 2));
+        IF_ARCH_AARCH64(CALL(asimd::dyn_biquad_process_x4, 4));
+        IF_ARCH_AARCH64(CALL(asimd::dyn_biquad_process_x8, 8));
+    }
+
+UTEST_END
@@ -21,6 +21,7 @@
 
 #include <lsp-plug.in/common/types.h>
 #include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
 #include <lsp-plug.in/test-fw/utest.h>
 #include <lsp-plug.in/test-fw/helpers.h>
 #include <lsp-plug.in/test-fw/FloatBuffer.h>
@@ -28,6 +29,7 @@
 #define BUF_SIZE        1024
 #define BUF_STEP        16
 #define TOLERANCE       1e-3f
+#define TOLERANCE_X16   1e-4f   /* relative to the RMS of the reference signal */
 
 namespace lsp
 {
@@ -37,6 +39,7 @@ namespace lsp
         void biquad_process_x2(float *dst, const float *src, size_t count, dsp::biquad_t *f);
         void biquad_process_x4(float *dst, const float *src, size_t count, dsp::biquad_t *f);
         void biquad_process_x8(float *dst, const float *src, size_t count, dsp::biquad_t *f);
+        void biquad_process_x16(float *dst, const float *src, size_t count, dsp::biquad16_t *f);
     }
 
     IF_ARCH_X86(
@@ -66,6 +69,14 @@ namespace lsp
 
             void x64_biquad_process_x8(float *dst, const float *src, size_t count, dsp::biquad_t *f);
             void biquad_process_x8_fma3(float *dst, const float *src, size_t count, dsp::biquad_t *f);
+
+            void biquad_process_x16(float *dst, const float *src, size_t count, dsp::biquad16_t *f);
+            void biquad_process_x16_fma3(float *dst, const float *src, size_t count, dsp::biquad16_t *f);
+        }
+
+        namespace avx512
+        {
+            void biquad_process_x16(float *dst, const float *src, size_t count, dsp::biquad16_t *f);
         }
     )
 
@@ -90,6 +101,7 @@ namespace lsp
     )
 
     typedef void (* biquad_process_t)(float *dst, const float *src, size_t count, dsp::biquad_t *f);
+    typedef void (* biquad16_process_t)(float *dst, const float *src, size_t count, dsp::biquad16_t *f);
 }
 
 UTEST_BEGIN("dsp.filters", static)
@@ -192,6 +204,85 @@ UTEST_BEGIN("dsp.filters", static)
         }
     }
 
+    void call_x16(const char *label, biquad16_process_t func)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        dsp::biquad16_t f __lsp_aligned64;
+
+        // Initialize biquad filter, the poles are at the radius of 0.9, so the rounding
+        // error of 16 cascades does not grow as much as for the poles close to the unit circle
+        dsp::biquad_x1_t x1;
+        x1.b0       = 0.98f;
+        x1.b1       = -1.70f;
+        x1.b2       = 0.75f;
+        x1.a1       = 1.7196f;
+        x1.a2       = -0.81f;
+
+        dsp::biquad_x16_t *x16 = &f.x16;
+        for (size_t i=0; i<16; ++i)
+        {
+            x16->b0[i]  = x1.b0;
+            x16->b1[i]  = x1.b1;
+            x16->b2[i]  = x1.b2;
+            x16->a1[i]  = x1.a1;
+            x16->a2[i]  = x1.a2;
+        }
+
+        UTEST_FOREACH(count, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 0x1f, 0x40, 0x1ff)
+        {
+            FloatBuffer src(count);
+            FloatBuffer dst(count);
+            src.randomize_sign();
+
+            printf("Testing %s on input buffer size=%d...\n", label, int(count));
+
+            // Compute the reference output with double precision
+            double *ref = new double[count + 1];
+            for (size_t i=0; i<count; ++i)
+                ref[i]      = src[i];
+            for (size_t j=0; j<16; ++j)
+            {
+                double d0 = 0.0, d1 = 0.0;
+                for (size_t i=0; i<count; ++i)
+                {
+                    double s    = ref[i];
+                    double s2   = x1.b0*s + d0;
+                    d0          = d1 + x1.b1*s + x1.a1*s2;
+                    d1          = x1.b2*s + x1.a2*s2;
+                    ref[i]      = s2;
+                }
+            }
+
+            // Apply processing
+            dsp::fill_zero(f.d, LSP_DSP_BIQUAD16_D_ITEMS);
+            func(dst, src, count, &f);
+
+            // Perform validation, the error is measured relative to the RMS of the reference
+            UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+            UTEST_ASSERT_MSG(dst.valid(), "Destination buffer corrupted");
+
+            double rms = 0.0;
+            for (size_t i=0; i<count; ++i)
+                rms        += ref[i] * ref[i];
+            rms         = sqrt(rms / lsp_max(count, size_t(1)));
+
+            for (size_t i=0; i<count; ++i)
+            {
+                if (fabs(dst[i] - ref[i]) <= TOLERANCE_X16 * rms)
+                    continue;
+
+                src.dump("src");
+                dst.dump("dst");
+                UTEST_FAIL_MSG("Output of functions for test '%s' differs at sample %d: %.6f vs %.6f (rms=%.6f)",
+                        label, int(i), ref[i], dst[i], rms);
+            }
+
+            delete [] ref;
+        }
+    }
+
     void call(const char *label, const dsp::biquad_t *bq, biquad_process_t func1, biquad_process_t func2)
     {
         if (!UTEST_SUPPORTED(func1))
@@ -240,6 +331,60 @@ UTEST_BEGIN("dsp.filters", static)
         }
     }
 
+    void call_x16(const char *label, const dsp::biquad16_t *bq, biquad16_process_t func1, biquad16_process_t func2)
+    {
+        if (!UTEST_SUPPORTED(func1))
+            return;
+        if (!UTEST_SUPPORTED(func2))
+            return;
+
+        printf("Testing %s on buffer size %d...\n", label, BUF_SIZE);
+
+        dsp::biquad16_t f1 = *bq, f2 = *bq;
+
+        FloatBuffer src(BUF_SIZE);
+        FloatBuffer dst1(BUF_SIZE);
+        FloatBuffer dst2(BUF_SIZE);
+
+        for (size_t i=0; i<BUF_SIZE; i += BUF_STEP)
+        {
+            size_t count = BUF_SIZE - i;
+            if (count > BUF_STEP)
+                count = BUF_STEP;
+            func1(dst1.data(i), src.data(i), count, &f1);
+            func2(dst2.data(i), src.data(i), count, &f2);
+        }
+
+        UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+        UTEST_ASSERT_MSG(dst1.valid(), "Destination buffer 1 corrupted");
+        UTEST_ASSERT_MSG(dst2.valid(), "Destination buffer 2 corrupted");
+
+        // The error is measured relative to the RMS of the output signal
+        double rms = 0.0;
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            rms        += dst1[i] * dst1[i];
+        const float tolerance = TOLERANCE_X16 * sqrt(rms / BUF_SIZE);
+
+        for (size_t i=0; i<BUF_SIZE; ++i)
+        {
+            if (float_equals_absolute(dst1[i], dst2[i], tolerance))
+                continue;
+
+            src.dump("src");
+            dst1.dump("dst1");
+            dst2.dump("dst2");
+            UTEST_FAIL_MSG("Output of functions for test '%s' differs at sample %d: %.6f vs %.6f",
+                    label, int(i), dst1[i], dst2[i]);
+        }
+
+        for (size_t j=0; j<LSP_DSP_BIQUAD16_D_ITEMS; ++j)
+        {
+            if (float_equals_absolute(f1.d[j], f2.d[j], tolerance))
+                continue;
+            UTEST_FAIL_MSG("Filter memory items #%d for test '%s' differ: %.6f vs %.6f",
+                    int(j), label, f1.d[j], f2.d[j]);
+        }
+    }
 
     UTEST_MAIN
     {
@@ -276,6 +421,15 @@ UTEST_BEGIN("dsp.filters", static)
         IF_ARCH_ARM(CALL(neon_d32::biquad_process_x8, 8));
         IF_ARCH_AARCH64(CALL(asimd::biquad_process_x8, 8));
 
+        #undef CALL
+        #define CALL(func) \
+            call_x16(#func, func)
+
+        CALL(generic::biquad_process_x16);
+        IF_ARCH_X86(CALL(avx::biquad_process_x16));
+        IF_ARCH_X86(CALL(avx::biquad_process_x16_fma3));
+        IF_ARCH_X86(CALL(avx512::biquad_process_x16));
+
         #undef CALL
         #define CALL(generic, func) \
             call(#func, &bq, generic, func)
@@ -411,6 +565,30 @@ UTEST_BEGIN("dsp.filters", static)
         IF_ARCH_X86(CALL(generic::biquad_process_x8, avx::biquad_process_x8_fma3));
         IF_ARCH_ARM(CALL(generic::biquad_process_x8, neon_d32::biquad_process_x8));
         IF_ARCH_AARCH64(CALL(generic::biquad_process_x8, asimd::biquad_process_x8));
+
+        // Prepare 32 zero, 32 pole filter with the poles at the radius of 0.9 and
+        // the zeros at the radius of 0.95
+        dsp::biquad16_t bq16 __lsp_aligned64;
+        dsp::biquad_x16_t *x16 = &bq16.x16;
+        dsp::fill_zero(bq16.d, LSP_DSP_BIQUAD16_D_ITEMS);
+
+        for (size_t i=0; i<16; ++i)
+        {
+            const float w   = 0.2f + 0.05f * i;
+            x16->b0[i]  = 1.0f;
+            x16->b1[i]  = -1.9f * cosf(w);
+            x16->b2[i]  = 0.9025f;
+            x16->a1[i]  = 1.8f * cosf(w);
+            x16->a2[i]  = -0.81f;
+        }
+
+        #undef CALL
+        #define CALL(generic, func) \
+            call_x16(#func, &bq16, generic, func)
+
+        IF_ARCH_X86(CALL(generic::biquad_process_x16, avx::biquad_process_x16));
+        IF_ARCH_X86(CALL(generic::biquad_process_x16, avx::biquad_process_x16_fma3));
+        IF_ARCH_X86(CALL(generic::biquad_process_x16, avx512::biquad_process_x16));
     }
 
 UTEST_END
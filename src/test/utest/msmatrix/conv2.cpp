@@ -85,7 +85,7 @@ UTEST_BEGIN("dsp.msmatrix", conv2)
             return;
 
         UTEST_FOREACH(count, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
-                32, 64, 65, 100, 999, 0xfff)
+                16, 17, 24, 31, 32, 33, 48, 63, 64, 65, 100, 999, 0xfff)
         {
             for (size_t mask=0; mask <= 0x0f; ++mask)
             {
@@ -100,7 +100,7 @@ UTEST_BEGIN("dsp.msmatrix", conv2)
 
                 // Call functions
                 func1(dst1A, dst1B, srcA, srcB, count);
-                func1(dst2A, dst2B, srcA, srcB, count);
+                func2(dst2A, dst2B, srcA, srcB, count);
 
                 UTEST_ASSERT_MSG(srcA.valid(), "Source buffer A corrupted");
                 UTEST_ASSERT_MSG(srcB.valid(), "Source buffer A corrupted");